@@ -0,0 +1,466 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#include "Standard.h"
+#include "InputBufferedFile.h"
+#include "KWContinuous.h"
+#include "KWClass.h"
+#include "KWClassDomain.h"
+#include "KWObject.h"
+#include "KWTupleTableLoader.h"
+#include "KWFrequencyVector.h"
+#include "KWDiscretizerMODL.h"
+#include "KWGrouperMODL.h"
+#include "KWDataGrid.h"
+#include "KWDataGridCosts.h"
+#include "KWDataGridOptimizer.h"
+#include "KWArtificialDataset.h"
+#include "KWFileSorter.h"
+#include "KWChunkSorterTask.h"
+#include "KWKeySampleExtractorTask.h"
+#include "KWSortedChunkBuilderTask.h"
+#include "KWKeySizeEvaluatorTask.h"
+
+#include "benchmark/benchmark.h"
+
+// Benchmarks des noyaux de calcul de Khiops, sur des donnees synthetiques
+// Chaque benchmark prepare ses donnees hors de la boucle de mesure, puis mesure un seul noyau.
+// Les donnees aleatoires sont generees avec une graine fixe, pour que les mesures soient comparables
+// d'une version a l'autre.
+// Les resultats au format JSON sont produits par la cible run_bench (cf. bench/CMakeLists.txt)
+
+namespace
+{
+/////////////////////////////////////////////////////////////////////////////
+// Services de creation des donnees synthetiques
+
+// Creation d'un fichier artificiel de nLineNumber lignes et nFieldNumber champs, avec une cle en premier champ
+void CreateArtificialDataset(KWArtificialDataset* artificialDataset, int nLineNumber, int nFieldNumber)
+{
+	require(artificialDataset != NULL);
+	require(nLineNumber > 0);
+	require(nFieldNumber > 0);
+
+	artificialDataset->SetLineNumber(nLineNumber);
+	artificialDataset->SetFieldNumber(nFieldNumber);
+	artificialDataset->SetAscendingSort(false);
+	artificialDataset->SetFileName(artificialDataset->BuildFileName());
+	artificialDataset->CreateDataset();
+}
+
+// Creation d'une table d'effectifs aleatoire, dont la distribution cible depend de l'index de ligne
+// pour qu'il y ait une structure a detecter par les algorithmes de partitionnement
+// Si bDecreasingFrequencies est vrai, les lignes sont triees par effectif decroissant, comme
+// l'attendent les groupeurs
+void CreateFrequencyTable(KWFrequencyTable* kwftTable, int nSourceNumber, int nTargetNumber, int nTotalFrequency,
+			  boolean bDecreasingFrequencies)
+{
+	IntVector* ivFrequencies;
+	int nSource;
+	int nTarget;
+	int nSourceFrequency;
+	int nI;
+
+	require(kwftTable != NULL);
+	require(nSourceNumber > 0);
+	require(nTargetNumber > 1);
+	require(nTotalFrequency >= nSourceNumber);
+
+	SetRandomSeed(1);
+	kwftTable->SetFrequencyVectorNumber(nSourceNumber);
+	for (nSource = 0; nSource < nSourceNumber; nSource++)
+	{
+		ivFrequencies = cast(KWDenseFrequencyVector*, kwftTable->GetFrequencyVectorAt(nSource))->GetFrequencyVector();
+		ivFrequencies->SetSize(nTargetNumber);
+
+		// Effectif de la ligne, uniforme ou selon une loi de Zipf
+		if (bDecreasingFrequencies)
+			nSourceFrequency = max(1, (int)(nTotalFrequency / (2.0 * (nSource + 1))));
+		else
+			nSourceFrequency = nTotalFrequency / nSourceNumber;
+
+		// Repartition selon une classe cible majoritaire qui change par tranches de lignes
+		for (nI = 0; nI < nSourceFrequency; nI++)
+		{
+			if (RandomDouble() < 0.7)
+				nTarget = (nSource * 4 / nSourceNumber) % nTargetNumber;
+			else
+				nTarget = RandomInt(nTargetNumber - 1);
+			ivFrequencies->UpgradeAt(nTarget, 1);
+		}
+	}
+	kwftTable->SetInitialValueNumber(nSourceNumber);
+	kwftTable->SetGranularizedValueNumber(nSourceNumber);
+}
+
+// Creation d'un tableau d'objets d'une classe de test ayant quatre attributs Symbol et quatre attributs Continuous,
+// avec des valeurs aleatoires parmi nValueNumber valeurs possibles
+// La classe est inseree dans le domaine courant, et doit etre detruite par l'appelant
+KWClass* CreateTestObjects(int nObjectNumber, int nValueNumber, ObjectArray* oaObjects)
+{
+	const ALString sClassName = "BenchmarkClass";
+	KWClass* kwcClass;
+	KWObject* kwoObject;
+	KWAttribute* attribute;
+	int nObject;
+	int i;
+	ALString sTmp;
+
+	require(nObjectNumber > 0);
+	require(nValueNumber > 0);
+	require(oaObjects != NULL);
+	require(KWClassDomain::GetCurrentDomain()->LookupClass(sClassName) == NULL);
+
+	// Creation de la classe
+	kwcClass = KWClass::CreateClass(sClassName, 0, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, NULL);
+	KWClassDomain::GetCurrentDomain()->InsertClass(kwcClass);
+	kwcClass->Compile();
+
+	// Creation des objets avec des valeurs aleatoires
+	SetRandomSeed(1);
+	for (nObject = 0; nObject < nObjectNumber; nObject++)
+	{
+		kwoObject = KWObject::CreateObject(kwcClass, (longint)nObject + 1);
+		for (i = 0; i < kwcClass->GetLoadedDenseAttributeNumber(); i++)
+		{
+			attribute = kwcClass->GetLoadedDenseAttributeAt(i);
+			if (attribute->GetType() == KWType::Continuous)
+				kwoObject->SetContinuousValueAt(attribute->GetLoadIndex(),
+								(Continuous)RandomInt(nValueNumber - 1));
+			else if (attribute->GetType() == KWType::Symbol)
+				kwoObject->SetSymbolValueAt(attribute->GetLoadIndex(),
+							    Symbol(sTmp + "V" + IntToString(RandomInt(nValueNumber - 1))));
+		}
+		oaObjects->Add(kwoObject);
+	}
+	return kwcClass;
+}
+
+// Destruction des objets et de la classe de test
+void DeleteTestObjects(KWClass* kwcClass, ObjectArray* oaObjects)
+{
+	require(kwcClass != NULL);
+	require(oaObjects != NULL);
+
+	oaObjects->DeleteAll();
+	KWClassDomain::GetCurrentDomain()->DeleteClass(kwcClass->GetName());
+}
+
+// Creation d'une grille bivariee supervisee de test, avec deux variables numeriques d'intervalles
+// de largeur unitaire et deux valeurs cibles dont la distribution depend de la seconde variable
+// On n'utilise pas KWDataGrid::CreateTestDataGrid, dont les attributs template ne sont pas valides
+KWDataGrid* CreateTestDataGrid(int nPartNumber, int nInstanceNumber)
+{
+	KWDataGrid* dataGrid;
+	KWDGAttribute* attribute;
+	KWDGPart* part;
+	ObjectArray oaParts;
+	KWDGCell* cell;
+	int nAttribute;
+	int nPart;
+	int nInstance;
+	int nTargetValue;
+	Continuous cValue;
+	ALString sTmp;
+
+	require(nPartNumber > 0);
+	require(nInstanceNumber > 0);
+
+	// Creation de la grille et de ses valeurs cibles
+	dataGrid = new KWDataGrid;
+	dataGrid->Initialize(2, 2);
+	dataGrid->SetTargetValueAt(0, Symbol("T1"));
+	dataGrid->SetTargetValueAt(1, Symbol("T2"));
+
+	// Creation des attributs et de leurs intervalles
+	for (nAttribute = 0; nAttribute < dataGrid->GetAttributeNumber(); nAttribute++)
+	{
+		attribute = dataGrid->GetAttributeAt(nAttribute);
+		attribute->SetAttributeName(sTmp + "Att" + IntToString(nAttribute + 1));
+		attribute->SetAttributeType(KWType::Continuous);
+		attribute->SetInitialValueNumber(nInstanceNumber);
+		attribute->SetGranularizedValueNumber(nInstanceNumber);
+		for (nPart = 0; nPart < nPartNumber; nPart++)
+		{
+			part = attribute->AddPart();
+			if (nPart == 0)
+				part->GetInterval()->SetLowerBound(KWDGInterval::GetMinLowerBound());
+			else
+				part->GetInterval()->SetLowerBound((Continuous)nPart);
+			if (nPart == nPartNumber - 1)
+				part->GetInterval()->SetUpperBound(KWDGInterval::GetMaxUpperBound());
+			else
+				part->GetInterval()->SetUpperBound((Continuous)(nPart + 1));
+		}
+	}
+
+	// Ajout d'instances aleatoires
+	SetRandomSeed(1);
+	dataGrid->SetCellUpdateMode(true);
+	dataGrid->BuildIndexingStructure();
+	oaParts.SetSize(dataGrid->GetAttributeNumber());
+	for (nInstance = 0; nInstance < nInstanceNumber; nInstance++)
+	{
+		cValue = 0;
+		for (nAttribute = 0; nAttribute < dataGrid->GetAttributeNumber(); nAttribute++)
+		{
+			attribute = dataGrid->GetAttributeAt(nAttribute);
+			cValue = (Continuous)(nPartNumber * RandomDouble());
+			oaParts.SetAt(nAttribute, attribute->LookupContinuousPart(cValue));
+		}
+		nTargetValue = RandomDouble() * nPartNumber < cValue ? 1 : 0;
+		cell = dataGrid->LookupCell(&oaParts);
+		if (cell == NULL)
+			cell = dataGrid->AddCell(&oaParts);
+		cell->UpgradeTargetFrequencyAt(nTargetValue, 1);
+	}
+	dataGrid->SetCellUpdateMode(false);
+	dataGrid->DeleteIndexingStructure();
+	ensure(dataGrid->Check());
+	return dataGrid;
+}
+
+// Recherche du premier attribut d'un type donne
+const ALString& LookupFirstAttributeName(const KWClass* kwcClass, int nType)
+{
+	KWAttribute* attribute;
+
+	require(kwcClass != NULL);
+
+	attribute = kwcClass->GetHeadAttribute();
+	while (attribute != NULL)
+	{
+		if (attribute->GetType() == nType)
+			return attribute->GetName();
+		kwcClass->GetNextAttribute(attribute);
+	}
+	assert(false);
+	return kwcClass->GetName();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Lecture de fichier
+
+// Parsing de tous les champs d'un fichier par InputBufferedFile
+void BM_InputBufferedFileGetNextField(benchmark::State& state)
+{
+	KWArtificialDataset artificialDataset;
+	InputBufferedFile inputFile;
+	longint lFilePos;
+	boolean bOk;
+	boolean bLineTooLong;
+	char* sField;
+	int nFieldLength;
+	int nFieldError;
+	longint lFileSize;
+	longint lFieldNumber;
+
+	CreateArtificialDataset(&artificialDataset, (int)state.range(0), 10);
+	inputFile.SetFileName(artificialDataset.GetFileName());
+	inputFile.SetFieldSeparator(artificialDataset.GetFieldSeparator());
+	inputFile.SetBufferSize(InputBufferedFile::nDefaultBufferSize);
+	lFileSize = 0;
+	lFieldNumber = 0;
+	for (auto _ : state)
+	{
+		bOk = inputFile.Open();
+		lFileSize = inputFile.GetFileSize();
+		lFilePos = 0;
+		while (bOk and lFilePos < inputFile.GetFileSize())
+		{
+			bOk = inputFile.FillOuterLines(lFilePos, bLineTooLong);
+			while (bOk and not inputFile.IsBufferEnd())
+			{
+				inputFile.GetNextField(sField, nFieldLength, nFieldError, bLineTooLong);
+				lFieldNumber++;
+			}
+			lFilePos = inputFile.GetPositionInFile();
+		}
+		inputFile.Close();
+		if (not bOk)
+			state.SkipWithError("Error while reading file");
+	}
+	state.SetBytesProcessed(state.iterations() * lFileSize);
+	state.SetItemsProcessed(lFieldNumber);
+	artificialDataset.DeleteDataset();
+}
+BENCHMARK(BM_InputBufferedFileGetNextField)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Conversion de chaines de caracteres en Continuous
+void BM_StringToContinuous(benchmark::State& state)
+{
+	StringVector svValues;
+	Continuous cSum;
+	int i;
+
+	SetRandomSeed(1);
+	for (i = 0; i < state.range(0); i++)
+		svValues.Add(KWContinuous::ContinuousToString(RandomDouble() * pow(10.0, RandomInt(12) - 6)));
+	for (auto _ : state)
+	{
+		cSum = 0;
+		for (i = 0; i < svValues.GetSize(); i++)
+			cSum += KWContinuous::StringToContinuous(svValues.GetAt(i));
+		benchmark::DoNotOptimize(cSum);
+	}
+	state.SetItemsProcessed(state.iterations() * svValues.GetSize());
+}
+BENCHMARK(BM_StringToContinuous)->Arg(100000);
+
+/////////////////////////////////////////////////////////////////////////////
+// Preparation des donnees
+
+// Alimentation d'une table de tuples bivariee, Symbol et Continuous
+void BM_TupleTableLoaderBivariate(benchmark::State& state)
+{
+	ObjectArray oaObjects;
+	KWClass* kwcClass;
+	KWTupleTableLoader tupleTableLoader;
+	KWTupleTable tupleTable;
+
+	kwcClass = CreateTestObjects((int)state.range(0), (int)state.range(1), &oaObjects);
+	tupleTableLoader.SetInputClass(kwcClass);
+	tupleTableLoader.SetInputDatabaseObjects(&oaObjects);
+	for (auto _ : state)
+		tupleTableLoader.LoadBivariate(LookupFirstAttributeName(kwcClass, KWType::Symbol),
+					       LookupFirstAttributeName(kwcClass, KWType::Continuous), &tupleTable);
+	state.SetItemsProcessed(state.iterations() * oaObjects.GetSize());
+	tupleTable.CleanAll();
+	tupleTableLoader.RemoveAllInputs();
+	DeleteTestObjects(kwcClass, &oaObjects);
+}
+BENCHMARK(BM_TupleTableLoaderBivariate)->Args({100000, 100})->Args({100000, 10000})->Unit(benchmark::kMillisecond);
+
+// Discretisation MODL supervisee
+void BM_DiscretizerMODL(benchmark::State& state)
+{
+	KWDiscretizerMODL discretizerMODL;
+	KWFrequencyTable kwftSource;
+	KWFrequencyTable* kwftTarget;
+
+	CreateFrequencyTable(&kwftSource, (int)state.range(0), 2, (int)state.range(0) * 10, false);
+	for (auto _ : state)
+	{
+		discretizerMODL.Discretize(&kwftSource, kwftTarget);
+		delete kwftTarget;
+	}
+	state.SetItemsProcessed(state.iterations() * kwftSource.GetFrequencyVectorNumber());
+}
+BENCHMARK(BM_DiscretizerMODL)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// Groupage MODL supervise
+void BM_GrouperMODL(benchmark::State& state)
+{
+	KWGrouperMODL grouperMODL;
+	KWFrequencyTable kwftSource;
+	KWFrequencyTable* kwftTarget;
+	IntVector* ivGroups;
+
+	CreateFrequencyTable(&kwftSource, (int)state.range(0), 2, (int)state.range(0) * 10, true);
+	for (auto _ : state)
+	{
+		grouperMODL.Group(&kwftSource, kwftTarget, ivGroups);
+		delete kwftTarget;
+		delete ivGroups;
+	}
+	state.SetItemsProcessed(state.iterations() * kwftSource.GetFrequencyVectorNumber());
+}
+BENCHMARK(BM_GrouperMODL)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// Optimisation d'une grille bivariee supervisee
+void BM_DataGridOptimizer(benchmark::State& state)
+{
+	KWDataGrid* dataGrid;
+	KWDataGrid optimizedDataGrid;
+	KWDataGridClassificationCosts dataGridCosts;
+	KWDataGridOptimizer dataGridOptimizer;
+	double dCost;
+
+	dataGrid = CreateTestDataGrid((int)state.range(0), (int)state.range(1));
+	dataGridCosts.InitializeDefaultCosts(dataGrid);
+	dataGridOptimizer.SetDataGridCosts(&dataGridCosts);
+	for (auto _ : state)
+	{
+		dCost = dataGridOptimizer.OptimizeDataGrid(dataGrid, &optimizedDataGrid);
+		benchmark::DoNotOptimize(dCost);
+	}
+	state.SetItemsProcessed(state.iterations() * dataGrid->GetCellNumber());
+	delete dataGrid;
+}
+BENCHMARK(BM_DataGridOptimizer)->Args({10, 10000})->Args({30, 30000})->Unit(benchmark::kMillisecond);
+
+/////////////////////////////////////////////////////////////////////////////
+// Utilitaires de gestion des donnees
+
+// Declaration des drivers de fichiers et des taches paralleles utilisees par le tri, et initialisation
+// des ressources du driver sequentiel, si ce n'est pas deja fait
+void RegisterFileSorterTasks()
+{
+	static boolean bTasksRegistered = false;
+
+	if (not bTasksRegistered)
+	{
+		bTasksRegistered = true;
+		SystemFileDriverCreator::RegisterExternalDrivers();
+		PLParallelTask::RegisterTask(new KWChunkSorterTask);
+		PLParallelTask::RegisterTask(new KWKeySampleExtractorTask);
+		PLParallelTask::RegisterTask(new KWSortedChunkBuilderTask);
+		PLParallelTask::RegisterTask(new KWKeySizeEvaluatorTask);
+		PLParallelTask::GetDriver()->MasterInitializeResourceSystem();
+	}
+}
+
+// Tri d'un fichier selon une cle, par KWChunkSorterTask via KWFileSorter
+void BM_FileSorter(benchmark::State& state)
+{
+	KWArtificialDataset artificialDataset;
+	KWFileSorter fileSorter;
+	boolean bOk;
+
+	// Creation d'un fichier a trier, selon les specifications des tests du tri
+	RegisterFileSorterTasks();
+	artificialDataset.SpecifySortDataset();
+	artificialDataset.SetLineNumber((int)state.range(0));
+	artificialDataset.SetFileName(artificialDataset.BuildFileName());
+	artificialDataset.CreateDataset();
+
+	// Parametrage du tri
+	fileSorter.SetInputFileName(artificialDataset.GetFileName());
+	fileSorter.SetInputHeaderLineUsed(artificialDataset.GetHeaderLineUsed());
+	fileSorter.SetInputFieldSeparator(artificialDataset.GetFieldSeparator());
+	fileSorter.SetOutputFileName(artificialDataset.GetFileName() + ".sort");
+	fileSorter.SetOutputHeaderLineUsed(artificialDataset.GetHeaderLineUsed());
+	fileSorter.SetOutputFieldSeparator(artificialDataset.GetFieldSeparator());
+	artificialDataset.ExportKeyAttributeNames(fileSorter.GetKeyAttributeNames());
+	artificialDataset.ExportNativeFieldNames(fileSorter.GetNativeFieldNames());
+
+	// Tri, avec suivi de progression comme lors des traitements standard
+	TaskProgression::Start();
+	for (auto _ : state)
+	{
+		bOk = fileSorter.Sort(false);
+		if (not bOk)
+			state.SkipWithError("Error while sorting file");
+		FileService::RemoveFile(fileSorter.GetOutputFileName());
+	}
+	TaskProgression::Stop();
+	state.SetItemsProcessed(state.iterations() * artificialDataset.GetLineNumber());
+	artificialDataset.DeleteDataset();
+}
+BENCHMARK(BM_FileSorter)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+// Lancement des benchmarks, puis nettoyage des taches et drivers eventuellement declares
+int main(int argc, char** argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	PLParallelTask::DeleteAllTasks();
+	SystemFileDriverCreator::UnregisterDrivers();
+	return 0;
+}
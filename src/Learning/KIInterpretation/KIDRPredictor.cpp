@@ -317,6 +317,7 @@ KIDRClassifierContribution::KIDRClassifierContribution()
 	oaInstanceProbabilities = NULL;
 	contributionComputingMethod = NormalizedOddsRatio;
 	bSortInstanceProbas = false;
+	nSortedInstanceProbaNumber = 0;
 }
 
 KIDRClassifierContribution::~KIDRClassifierContribution() {}
@@ -345,6 +346,9 @@ Continuous KIDRClassifierContribution::GetContributionValueAt(int rank) const
 	assert(oaInstanceProbabilities != NULL);
 	assert(oaInstanceProbabilities->GetSize() > 0);
 
+	// Tri partiel jusqu'au rang demande
+	SortInstanceProbasUpToRank(rank);
+
 	KIPartitionedAttributeProbas* attributeProbas =
 	    cast(KIPartitionedAttributeProbas*, oaInstanceProbabilities->GetAt(rank));
 	return attributeProbas->cContributionImportanceValue;
@@ -355,6 +359,9 @@ Symbol KIDRClassifierContribution::GetContributionNameAt(int rank) const
 	assert(oaInstanceProbabilities != NULL);
 	assert(oaInstanceProbabilities->GetSize() > 0);
 
+	// Tri partiel jusqu'au rang demande
+	SortInstanceProbasUpToRank(rank);
+
 	KIPartitionedAttributeProbas* attributeProbas =
 	    cast(KIPartitionedAttributeProbas*, oaInstanceProbabilities->GetAt(rank));
 	StringObject* soVariableName =
@@ -368,6 +375,9 @@ Symbol KIDRClassifierContribution::GetContributionPartitionAt(int rank) const
 	assert(oaInstanceProbabilities != NULL);
 	assert(oaInstanceProbabilities->GetSize() > 0);
 
+	// Tri partiel jusqu'au rang demande
+	SortInstanceProbasUpToRank(rank);
+
 	KIPartitionedAttributeProbas* attributeProbas =
 	    cast(KIPartitionedAttributeProbas*, oaInstanceProbabilities->GetAt(rank));
 
@@ -407,9 +417,8 @@ void KIDRClassifierContribution::ComputeContribution(const KWObject* kwoObject)
 	int nClassNumber;
 	KWDRIntervalBounds discretizationRuleRef;
 	KWDRValueGroups groupingRuleRef;
-	IntVector ivModalityIndexes;
 
-	ivModalityIndexes.SetSize(oaPartitionedPredictiveAttributeNames.GetSize());
+	ivInstanceModalityIndexes.SetSize(oaPartitionedPredictiveAttributeNames.GetSize());
 
 	// Parcours des variables contribuant au predicteur
 	// On va memoriser, pour chaque variable predictive, l'index de la partie (valeur variable partionnee) pour
@@ -450,9 +459,13 @@ void KIDRClassifierContribution::ComputeContribution(const KWObject* kwoObject)
 		assert(nModalityIndex != -1);
 
 		// Memorisation de la valeur de la modalite pour la variable et l'individu
-		ivModalityIndexes.SetAt(nAttributeIndex, nModalityIndex);
+		ivInstanceModalityIndexes.SetAt(nAttributeIndex, nModalityIndex);
 	}
 
+	// Calcul une seule fois du vecteur de scores de l'individu, dont on deduit ensuite les scores
+	// sans chaque variable par soustraction
+	ComputeScoreVectorLj(&ivInstanceModalityIndexes, &cvInstanceScoreVector);
+
 	sContributionClass = GetOperandAt(2)->GetSymbolConstant();
 
 	if (sContributionClass == PREDICTED_CLASS_LABEL)
@@ -472,15 +485,12 @@ void KIDRClassifierContribution::ComputeContribution(const KWObject* kwoObject)
 			Continuous cMaxGain = 0;
 			Continuous cPriorProba;
 
-			// Calcul du vecteur de scores de l'individu
-			ContinuousVector* cvScoreVector = ComputeScoreVectorLj(&ivModalityIndexes);
-
 			for (int nIndex = 0; nIndex < oaModelProbabilities.GetSize(); nIndex++)
 			{
 				KITargetValueProbas* targetValueProbas =
 				    cast(KITargetValueProbas*, oaModelProbabilities.GetAt(nIndex));
 
-				cInitialScore = ComputeScoreFromScoreVector(cvScoreVector, nIndex);
+				cInitialScore = ComputeScoreFromScoreVector(&cvInstanceScoreVector, nIndex);
 
 				cPriorProba = exp(targetValueProbas->cProbaApriori);
 
@@ -491,19 +501,25 @@ void KIDRClassifierContribution::ComputeContribution(const KWObject* kwoObject)
 				if (cGain > cMaxGain)
 					sContributionClass = targetValueProbas->sTargetValue;
 			}
-
-			delete cvScoreVector;
 		}
 	}
 
-	if (oaInstanceProbabilities != NULL)
-		oaInstanceProbabilities->DeleteAll();
-	else
+	if (oaInstanceProbabilities == NULL)
 	{
 		oaInstanceProbabilities = new ObjectArray;
 		oaInstanceProbabilities->SetCompareFunction(KICompareContributionImportanceValue);
 	}
-	oaInstanceProbabilities->SetSize(oaPartitionedPredictiveAttributeNames.GetSize());
+
+	// Les objets de stockage des contributions sont reutilises d'un individu a l'autre
+	// (leur ordre peut avoir ete modifie par le tri, mais ils sont tous reinitialises ci-dessous)
+	if (oaInstanceProbabilities->GetSize() != oaPartitionedPredictiveAttributeNames.GetSize())
+	{
+		oaInstanceProbabilities->DeleteAll();
+		for (nAttributeIndex = 0; nAttributeIndex < oaPartitionedPredictiveAttributeNames.GetSize();
+		     nAttributeIndex++)
+			oaInstanceProbabilities->Add(new KIPartitionedAttributeProbas);
+	}
+	nSortedInstanceProbaNumber = 0;
 
 	// Extraction de l'index de la classe cible dans le tableau des probas
 	sClassIndex = cast(StringObject*, odClassNamesIndexes.Lookup(sContributionClass));
@@ -516,61 +532,124 @@ void KIDRClassifierContribution::ComputeContribution(const KWObject* kwoObject)
 	// Parcours des variables contribuant au classifieur
 	for (nAttributeIndex = 0; nAttributeIndex < oaPartitionedPredictiveAttributeNames.GetSize(); nAttributeIndex++)
 	{
-		partitionedAttributeProbas = new KIPartitionedAttributeProbas;
+		partitionedAttributeProbas =
+		    cast(KIPartitionedAttributeProbas*, oaInstanceProbabilities->GetAt(nAttributeIndex));
 
 		partitionedAttributeProbas->iAttributeIndex = nAttributeIndex;
-		partitionedAttributeProbas->iModalityIndex = ivModalityIndexes.GetAt(nAttributeIndex);
+		partitionedAttributeProbas->iModalityIndex = ivInstanceModalityIndexes.GetAt(nAttributeIndex);
 
 		// Calcul de l'indicateur d'importance
 
 		if (contributionComputingMethod == NormalizedOddsRatio)
-			cImportanceValue = ComputeNormalizedOddsRatio(nAttributeIndex, nClassIndex, &ivModalityIndexes,
-								      nDatabaseSize, nClassNumber);
+			cImportanceValue = ComputeNormalizedOddsRatio(
+			    nAttributeIndex, nClassIndex, &ivInstanceModalityIndexes, nDatabaseSize, nClassNumber);
 		else if (contributionComputingMethod == ImportanceValue)
 			cImportanceValue = ComputeImportanceValue(nAttributeIndex, nClassIndex,
-								  ivModalityIndexes.GetAt(nAttributeIndex));
+								  ivInstanceModalityIndexes.GetAt(nAttributeIndex));
 		else if (contributionComputingMethod == WeightOfEvidence)
-			cImportanceValue = ComputeWeightOfEvidence(nAttributeIndex, nClassIndex, &ivModalityIndexes,
-								   nDatabaseSize, nClassNumber);
+			cImportanceValue = ComputeWeightOfEvidence(
+			    nAttributeIndex, nClassIndex, &ivInstanceModalityIndexes, nDatabaseSize, nClassNumber);
 		else if (contributionComputingMethod == InformationDifference)
 			cImportanceValue = ComputeInformationDifference(
-			    nAttributeIndex, nClassIndex, &ivModalityIndexes, nDatabaseSize, nClassNumber);
+			    nAttributeIndex, nClassIndex, &ivInstanceModalityIndexes, nDatabaseSize, nClassNumber);
 		else if (contributionComputingMethod == DifferenceProbabilities)
 			cImportanceValue =
-			    ComputeDifferenceProbabilities(nAttributeIndex, nClassIndex, &ivModalityIndexes);
+			    ComputeDifferenceProbabilities(nAttributeIndex, nClassIndex, &ivInstanceModalityIndexes);
 		else if (contributionComputingMethod == ModalityProbability)
 			cImportanceValue = ComputeModalityProbability(nAttributeIndex, nClassIndex,
-								      ivModalityIndexes.GetAt(nAttributeIndex));
+								      ivInstanceModalityIndexes.GetAt(nAttributeIndex));
 		else if (contributionComputingMethod == BayesDistance)
 			cImportanceValue = ComputeBayesDistance(nAttributeIndex, nClassIndex,
-								ivModalityIndexes.GetAt(nAttributeIndex));
+								ivInstanceModalityIndexes.GetAt(nAttributeIndex));
 		else if (contributionComputingMethod == Kullback)
-			cImportanceValue = ComputeKullback(nAttributeIndex, nClassIndex, &ivModalityIndexes,
+			cImportanceValue = ComputeKullback(nAttributeIndex, nClassIndex, &ivInstanceModalityIndexes,
 							   nDatabaseSize, nClassNumber);
 		else if (contributionComputingMethod == LogModalityProbability)
-			cImportanceValue = ComputeLogModalityProbability(nAttributeIndex, nClassIndex,
-									 ivModalityIndexes.GetAt(nAttributeIndex));
+			cImportanceValue = ComputeLogModalityProbability(
+			    nAttributeIndex, nClassIndex, ivInstanceModalityIndexes.GetAt(nAttributeIndex));
 		else if (contributionComputingMethod == LogImportanceValue)
 			cImportanceValue = ComputeLogImportanceValue(nAttributeIndex, nClassIndex,
-								     ivModalityIndexes.GetAt(nAttributeIndex));
+								     ivInstanceModalityIndexes.GetAt(nAttributeIndex));
 		else if (contributionComputingMethod == BayesDistanceWithoutPrior)
-			cImportanceValue = ComputeBayesDistanceWithoutPrior(nAttributeIndex, nClassIndex,
-									    ivModalityIndexes.GetAt(nAttributeIndex));
+			cImportanceValue = ComputeBayesDistanceWithoutPrior(
+			    nAttributeIndex, nClassIndex, ivInstanceModalityIndexes.GetAt(nAttributeIndex));
 		else if (contributionComputingMethod == Shapley)
-			cImportanceValue =
-			    ComputeShapley(nAttributeIndex, nClassIndex, ivModalityIndexes.GetAt(nAttributeIndex));
+			cImportanceValue = ComputeShapley(nAttributeIndex, nClassIndex,
+							  ivInstanceModalityIndexes.GetAt(nAttributeIndex));
 
 		// Memorisation de la proba (valeur d'importance)
 		assert(cImportanceValue != -1);
 		partitionedAttributeProbas->cContributionImportanceValue = cImportanceValue;
-
-		// Insertion du vecteur dans le tableau
-		oaInstanceProbabilities->SetAt(nAttributeIndex, partitionedAttributeProbas);
 	}
 
-	// si demande, tri selon la proba a posteriori
-	if (bSortInstanceProbas)
-		oaInstanceProbabilities->Sort();
+	// Si demande, le tri selon la proba a posteriori est effectue a la demande, uniquement jusqu'aux
+	// rangs effectivement consultes (cf. SortInstanceProbasUpToRank)
+}
+
+void KIDRClassifierContribution::SortInstanceProbasUpToRank(int nRank) const
+{
+	int nSize;
+	int nSelectionMaxRank;
+	int nIndex;
+	int nBestIndex;
+	Object* oBest;
+	Object* oCandidate;
+
+	require(oaInstanceProbabilities != NULL);
+	require(0 <= nRank and nRank < oaInstanceProbabilities->GetSize());
+
+	// Arret si pas de tri demande ou si le rang est deja trie
+	if (not bSortInstanceProbas or nRank < nSortedInstanceProbaNumber)
+		return;
+
+	// Rang maximum pour lequel la selection rang par rang (en O(K) par rang) reste moins couteuse
+	// que le tri de la fin du tableau (en O(K log(K)))
+	nSize = oaInstanceProbabilities->GetSize();
+	nSelectionMaxRank = 1;
+	while ((1 << nSelectionMaxRank) < nSize)
+		nSelectionMaxRank++;
+
+	// Selection du meilleur element restant pour chaque nouveau rang, dans le cas usuel ou
+	// seules les premieres contributions sont exploitees
+	if (nRank < nSelectionMaxRank)
+	{
+		while (nSortedInstanceProbaNumber <= nRank)
+		{
+			nBestIndex = nSortedInstanceProbaNumber;
+			oBest = oaInstanceProbabilities->GetAt(nBestIndex);
+			for (nIndex = nBestIndex + 1; nIndex < nSize; nIndex++)
+			{
+				oCandidate = oaInstanceProbabilities->GetAt(nIndex);
+				if (KICompareContributionImportanceValue(&oCandidate, &oBest) < 0)
+				{
+					nBestIndex = nIndex;
+					oBest = oCandidate;
+				}
+			}
+
+			// Echange avec le premier element non trie
+			oaInstanceProbabilities->SetAt(nBestIndex,
+						       oaInstanceProbabilities->GetAt(nSortedInstanceProbaNumber));
+			oaInstanceProbabilities->SetAt(nSortedInstanceProbaNumber, oBest);
+			nSortedInstanceProbaNumber++;
+		}
+	}
+	// Sinon, tri de la fin du tableau non encore triee
+	else
+	{
+		oaSortWorkingArray.SetCompareFunction(KICompareContributionImportanceValue);
+		oaSortWorkingArray.SetSize(nSize - nSortedInstanceProbaNumber);
+		for (nIndex = nSortedInstanceProbaNumber; nIndex < nSize; nIndex++)
+			oaSortWorkingArray.SetAt(nIndex - nSortedInstanceProbaNumber,
+						 oaInstanceProbabilities->GetAt(nIndex));
+		oaSortWorkingArray.Sort();
+		for (nIndex = nSortedInstanceProbaNumber; nIndex < nSize; nIndex++)
+			oaInstanceProbabilities->SetAt(nIndex,
+						       oaSortWorkingArray.GetAt(nIndex - nSortedInstanceProbaNumber));
+		oaSortWorkingArray.SetSize(0);
+		nSortedInstanceProbaNumber = nSize;
+	}
+	ensure(nRank < nSortedInstanceProbaNumber);
 }
 
 Continuous KIDRClassifierContribution::ComputeImportanceValue(int nAttributeIndex, int nTargetClassIndex,
@@ -594,7 +673,6 @@ Continuous KIDRClassifierContribution::ComputeWeightOfEvidence(int nAttributeInd
 							       IntVector* ivModalityIndexes, int nDatabaseSize,
 							       int nTargetValuesNumber) const
 {
-	ContinuousVector* cvScoreVector;
 	Continuous cInitialScore;
 	Continuous cScoreWithoutOneVariable;
 	// Continuous cImportanceValue;
@@ -604,15 +682,14 @@ Continuous KIDRClassifierContribution::ComputeWeightOfEvidence(int nAttributeInd
 	Continuous cImportanceValueCorrected;
 	Continuous cRatioCorrected;
 
-	// Calcul du score initial p(C|X)
-	cvScoreVector = ComputeScoreVectorLj(ivModalityIndexes);
-	cInitialScore = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	// Calcul du score initial p(C|X), a partir du vecteur de scores de l'individu
+	cInitialScore = ComputeScoreFromScoreVector(&cvInstanceScoreVector, nTargetClassIndex);
 
 	// Calcul du score sans prendre en compte la variable explicative p(C|X\X_i)
-	cvScoreVector = ComputeScoreVectorLjWithoutOneVariable(ivModalityIndexes, nAttributeIndex);
-	cScoreWithoutOneVariable = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	ComputeScoreVectorLjWithoutOneVariable(&cvInstanceScoreVector, ivModalityIndexes, nAttributeIndex,
+					       &cvInstanceScoreVectorWithoutOneVariable);
+	cScoreWithoutOneVariable =
+	    ComputeScoreFromScoreVector(&cvInstanceScoreVectorWithoutOneVariable, nTargetClassIndex);
 
 	// AjoutVincent 10/2009 - Correction de Laplace pour que P>0 et P<1
 	// Prise en compte d'un epsilon de Laplace
@@ -662,7 +739,6 @@ Continuous KIDRClassifierContribution::ComputeInformationDifference(int nAttribu
 								    IntVector* ivModalityIndexes, int nDatabaseSize,
 								    int nTargetValuesNumber) const
 {
-	ContinuousVector* cvScoreVector;
 	Continuous cInitialScore;
 	Continuous cScoreWithoutOneVariable;
 	// Continuous cImportanceValue;
@@ -670,15 +746,14 @@ Continuous KIDRClassifierContribution::ComputeInformationDifference(int nAttribu
 	Continuous cScoreWithoutOneVariableCorrected;
 	Continuous cImportanceValueCorrected;
 
-	// Calcul du score initial p(C|X)
-	cvScoreVector = ComputeScoreVectorLj(ivModalityIndexes);
-	cInitialScore = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	// Calcul du score initial p(C|X), a partir du vecteur de scores de l'individu
+	cInitialScore = ComputeScoreFromScoreVector(&cvInstanceScoreVector, nTargetClassIndex);
 
 	// Calcul du score sans prendre en compte la variable explicative p(C|X\X_i)
-	cvScoreVector = ComputeScoreVectorLjWithoutOneVariable(ivModalityIndexes, nAttributeIndex);
-	cScoreWithoutOneVariable = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	ComputeScoreVectorLjWithoutOneVariable(&cvInstanceScoreVector, ivModalityIndexes, nAttributeIndex,
+					       &cvInstanceScoreVectorWithoutOneVariable);
+	cScoreWithoutOneVariable =
+	    ComputeScoreFromScoreVector(&cvInstanceScoreVectorWithoutOneVariable, nTargetClassIndex);
 
 	// AjoutVincent 10/2009 - Correction de Laplace pour que P>0 et P<1
 	// Prise en compte d'un epsilon de Laplace
@@ -710,20 +785,18 @@ Continuous KIDRClassifierContribution::ComputeDifferenceProbabilities(
     int nAttributeIndex, int nTargetClassIndex,
     IntVector* ivModalityIndexes) const //, int nDatabaseSize, int nTargetValuesNumber)
 {
-	ContinuousVector* cvScoreVector;
 	Continuous cInitialScore;
 	Continuous cScoreWithoutOneVariable;
 	Continuous cImportanceValue;
 
-	// Calcul du score initial p(C|X)
-	cvScoreVector = ComputeScoreVectorLj(ivModalityIndexes);
-	cInitialScore = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	// Calcul du score initial p(C|X), a partir du vecteur de scores de l'individu
+	cInitialScore = ComputeScoreFromScoreVector(&cvInstanceScoreVector, nTargetClassIndex);
 
 	// Calcul du score sans prendre en compte la variable explicative p(C|X\X_i)
-	cvScoreVector = ComputeScoreVectorLjWithoutOneVariable(ivModalityIndexes, nAttributeIndex);
-	cScoreWithoutOneVariable = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	ComputeScoreVectorLjWithoutOneVariable(&cvInstanceScoreVector, ivModalityIndexes, nAttributeIndex,
+					       &cvInstanceScoreVectorWithoutOneVariable);
+	cScoreWithoutOneVariable =
+	    ComputeScoreFromScoreVector(&cvInstanceScoreVectorWithoutOneVariable, nTargetClassIndex);
 
 	// Calcul de l'indicateur Weight of Evidence
 	cImportanceValue = cInitialScore - cScoreWithoutOneVariable;
@@ -922,22 +995,20 @@ Continuous KIDRClassifierContribution::ComputeKullback(int nAttributeIndex, int
 						       IntVector* ivModalityIndexes, int nDatabaseSize,
 						       int nTargetValuesNumber) const
 {
-	ContinuousVector* cvScoreVector;
 	Continuous cInitialScore;
 	Continuous cScoreWithoutOneVariable;
 	Continuous cImportanceValue;
 	Continuous cInitialScoreCorrected;
 	Continuous cScoreWithoutOneVariableCorrected;
 
-	// Calcul du score initial p(C|X)
-	cvScoreVector = ComputeScoreVectorLj(ivModalityIndexes);
-	cInitialScore = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	// Calcul du score initial p(C|X), a partir du vecteur de scores de l'individu
+	cInitialScore = ComputeScoreFromScoreVector(&cvInstanceScoreVector, nTargetClassIndex);
 
 	// Calcul du score sans prendre en compte la variable explicative p(C|X\X_i)
-	cvScoreVector = ComputeScoreVectorLjWithoutOneVariable(ivModalityIndexes, nAttributeIndex);
-	cScoreWithoutOneVariable = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	ComputeScoreVectorLjWithoutOneVariable(&cvInstanceScoreVector, ivModalityIndexes, nAttributeIndex,
+					       &cvInstanceScoreVectorWithoutOneVariable);
+	cScoreWithoutOneVariable =
+	    ComputeScoreFromScoreVector(&cvInstanceScoreVectorWithoutOneVariable, nTargetClassIndex);
 
 	// AjoutVincent 10/2009 - Correction de Laplace pour que P>0 et P<1
 	// Prise en compte d'un epsilon de Laplace
@@ -1023,7 +1094,6 @@ Continuous KIDRClassifierContribution::ComputeNormalizedOddsRatio(int nAttribute
 								  IntVector* ivModalityIndexes, int nDatabaseSize,
 								  int nTargetValuesNumber) const
 {
-	ContinuousVector* cvScoreVector;
 	Continuous cInitialScore;
 	Continuous cScoreWithoutOneVariable;
 	Continuous cInitialScoreCorrected;
@@ -1031,15 +1101,14 @@ Continuous KIDRClassifierContribution::ComputeNormalizedOddsRatio(int nAttribute
 	Continuous cImportanceValueCorrected;
 	Continuous cRatioCorrected;
 
-	// Calcul du score initial p(C|X)
-	cvScoreVector = ComputeScoreVectorLj(ivModalityIndexes);
-	cInitialScore = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	// Calcul du score initial p(C|X), a partir du vecteur de scores de l'individu
+	cInitialScore = ComputeScoreFromScoreVector(&cvInstanceScoreVector, nTargetClassIndex);
 
 	// Calcul du score sans prendre en compte la variable explicative p(C|X\X_i)
-	cvScoreVector = ComputeScoreVectorLjWithoutOneVariable(ivModalityIndexes, nAttributeIndex);
-	cScoreWithoutOneVariable = ComputeScoreFromScoreVector(cvScoreVector, nTargetClassIndex);
-	delete cvScoreVector;
+	ComputeScoreVectorLjWithoutOneVariable(&cvInstanceScoreVector, ivModalityIndexes, nAttributeIndex,
+					       &cvInstanceScoreVectorWithoutOneVariable);
+	cScoreWithoutOneVariable =
+	    ComputeScoreFromScoreVector(&cvInstanceScoreVectorWithoutOneVariable, nTargetClassIndex);
 
 	// Commentaires sur ce code voir fonction "Weight of Evidence"
 	// on calcule le odd ratio entre P(C|X) et (P(C|X) prive de la variable
@@ -1060,17 +1129,18 @@ Continuous KIDRClassifierContribution::ComputeNormalizedOddsRatio(int nAttribute
 	return cImportanceValueCorrected;
 }
 
-ContinuousVector* KIDRClassifierContribution::ComputeScoreVectorLj(IntVector* ivModalityIndexes) const
+void KIDRClassifierContribution::ComputeScoreVectorLj(const IntVector* ivModalityIndexes,
+						      ContinuousVector* cvScoreVector) const
 {
-	ContinuousVector* cvScore;
 	int nClassIndex;
 	int nAttributeIndex;
+	Continuous cScore;
 
 	require(oaModelProbabilities.GetSize() > 0);
 	require(ivModalityIndexes != NULL);
+	require(cvScoreVector != NULL);
 
-	cvScore = new ContinuousVector;
-	cvScore->SetSize(oaModelProbabilities.GetSize());
+	cvScoreVector->SetSize(oaModelProbabilities.GetSize());
 
 	// Parcours des classes
 	for (nClassIndex = 0; nClassIndex < oaModelProbabilities.GetSize(); nClassIndex++)
@@ -1081,63 +1151,49 @@ ContinuousVector* KIDRClassifierContribution::ComputeScoreVectorLj(IntVector* iv
 		assert(targetValueProbas->oaProbasAposteriori->GetSize() == ivModalityIndexes->GetSize());
 
 		// Initialisation du score au log de la proba a priori
-		cvScore->SetAt(nClassIndex, targetValueProbas->cProbaApriori);
+		cScore = targetValueProbas->cProbaApriori;
 
 		// Parcours des variables
 		for (nAttributeIndex = 0; nAttributeIndex < ivModalityIndexes->GetSize(); nAttributeIndex++)
 		{
-			cvScore->SetAt(nClassIndex,
-				       cvScore->GetAt(nClassIndex) +
-					   (cvVariableWeights.GetAt(nAttributeIndex) *
-					    ExtractLogPosteriorProba(nClassIndex, nAttributeIndex,
-								     ivModalityIndexes->GetAt(nAttributeIndex))));
+			cScore += cvVariableWeights.GetAt(nAttributeIndex) *
+				  ExtractLogPosteriorProba(nClassIndex, nAttributeIndex,
+							   ivModalityIndexes->GetAt(nAttributeIndex));
 		}
+		cvScoreVector->SetAt(nClassIndex, cScore);
 	}
-
-	return cvScore;
 }
 
-ContinuousVector* KIDRClassifierContribution::ComputeScoreVectorLjWithoutOneVariable(IntVector* ivModalityIndexes,
-										     int nVariableIndex) const
+void KIDRClassifierContribution::ComputeScoreVectorLjWithoutOneVariable(const ContinuousVector* cvFullScoreVector,
+									const IntVector* ivModalityIndexes,
+									int nVariableIndex,
+									ContinuousVector* cvScoreVector) const
 {
-	ContinuousVector* cvScore;
 	int nClassIndex;
-	int nAttributeIndex;
+	int nModalityIndex;
+	Continuous cVariableWeight;
 
 	require(oaModelProbabilities.GetSize() > 0);
+	require(cvFullScoreVector != NULL);
+	require(cvFullScoreVector->GetSize() == oaModelProbabilities.GetSize());
 	require(ivModalityIndexes != NULL);
+	require(0 <= nVariableIndex and nVariableIndex < ivModalityIndexes->GetSize());
+	require(cvScoreVector != NULL);
 
-	cvScore = new ContinuousVector;
-	cvScore->SetSize(oaModelProbabilities.GetSize());
+	cvScoreVector->SetSize(oaModelProbabilities.GetSize());
 
-	// Parcours des classes
+	// Le terme de la variable a exclure est retire du score complet, ce qui evite de re-sommer
+	// les termes de toutes les autres variables
+	nModalityIndex = ivModalityIndexes->GetAt(nVariableIndex);
+	cVariableWeight = cvVariableWeights.GetAt(nVariableIndex);
 	for (nClassIndex = 0; nClassIndex < oaModelProbabilities.GetSize(); nClassIndex++)
-	{
-		// Extraction du vecteur de probabilites pour la classe en cours
-		KITargetValueProbas* targetValueProbas =
-		    cast(KITargetValueProbas*, oaModelProbabilities.GetAt(nClassIndex));
-		assert(targetValueProbas->oaProbasAposteriori->GetSize() == ivModalityIndexes->GetSize());
-
-		// Initialisation du score au log de la proba a priori
-		cvScore->SetAt(nClassIndex, targetValueProbas->cProbaApriori);
-
-		// Parcours des variables
-		for (nAttributeIndex = 0; nAttributeIndex < ivModalityIndexes->GetSize(); nAttributeIndex++)
-		{
-			// Cas ou il ne s'agit pas de la variable a exclure
-			if (nAttributeIndex != nVariableIndex)
-				cvScore->SetAt(nClassIndex, cvScore->GetAt(nClassIndex) +
-								cvVariableWeights.GetAt(nAttributeIndex) *
-								    ExtractLogPosteriorProba(
-									nClassIndex, nAttributeIndex,
-									ivModalityIndexes->GetAt(nAttributeIndex)));
-		}
-	}
-
-	return cvScore;
+		cvScoreVector->SetAt(nClassIndex,
+				     cvFullScoreVector->GetAt(nClassIndex) -
+					 cVariableWeight *
+					     ExtractLogPosteriorProba(nClassIndex, nVariableIndex, nModalityIndex));
 }
 
-Continuous KIDRClassifierContribution::ComputeScoreFromScoreVector(ContinuousVector* cvScoreVector,
+Continuous KIDRClassifierContribution::ComputeScoreFromScoreVector(const ContinuousVector* cvScoreVector,
 								   int nReferenceClassIndex) const
 {
 	Continuous cScore;
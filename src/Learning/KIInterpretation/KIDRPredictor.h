@@ -237,10 +237,20 @@ protected:
 	Continuous ComputeShapley(const int nAttributeIndex, const int nTargetClassIndex,
 				  const int nModalityIndex) const;
 
-	ContinuousVector* ComputeScoreVectorLjWithoutOneVariable(IntVector* ivModalityIndexes,
-								 int nVariableIndex) const;
-	ContinuousVector* ComputeScoreVectorLj(IntVector* ivModalityIndexes) const;
-	Continuous ComputeScoreFromScoreVector(ContinuousVector* cvScoreVector, int nReferenceClassIndex) const;
+	/// Calcul du vecteur de scores par classe (log proba a priori plus somme ponderee des log probas
+	/// conditionnelles), dans un vecteur fourni par l'appelant
+	void ComputeScoreVectorLj(const IntVector* ivModalityIndexes, ContinuousVector* cvScoreVector) const;
+
+	/// Calcul du vecteur de scores par classe sans une variable, par soustraction de son terme au vecteur
+	/// de scores complet (en O(C) au lieu de O(K*C))
+	void ComputeScoreVectorLjWithoutOneVariable(const ContinuousVector* cvFullScoreVector,
+						    const IntVector* ivModalityIndexes, int nVariableIndex,
+						    ContinuousVector* cvScoreVector) const;
+	Continuous ComputeScoreFromScoreVector(const ContinuousVector* cvScoreVector, int nReferenceClassIndex) const;
+
+	/// Tri des contributions de l'individu, si demande, jusqu'au rang donne inclus: par selection pour
+	/// les premiers rangs, puis par tri de la fin du tableau au dela
+	void SortInstanceProbasUpToRank(int nRank) const;
 
 	/// Extraction de la log proba a priori de la classe donnee
 	Continuous ExtractLogPriorProba(int nClassIndex) const;
@@ -254,6 +264,18 @@ protected:
 	mutable boolean bSortInstanceProbas;
 
 	ContributionComputingMethod contributionComputingMethod;
+
+	// Buffers de travail pour l'individu en cours, reutilises d'un individu a l'autre:
+	// index de partie par variable, vecteur de scores complet et vecteur de scores sans une variable
+	mutable IntVector ivInstanceModalityIndexes;
+	mutable ContinuousVector cvInstanceScoreVector;
+	mutable ContinuousVector cvInstanceScoreVectorWithoutOneVariable;
+
+	// Nombre de contributions deja triees en tete du tableau oaInstanceProbabilities
+	mutable int nSortedInstanceProbaNumber;
+
+	// Tableau de travail pour le tri de la fin du tableau des contributions
+	mutable ObjectArray oaSortWorkingArray;
 };
 
 class KIDRContributionValueAt : public KWDerivationRule
@@ -3,21 +3,6 @@
 // at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
 
 #include "JSONTokenizer.h"
-DISABLE_WARNING_PUSH
-DISABLE_WARNING_UNUSED_FUNCTION
-#include "JsonLex.inc"
-DISABLE_WARNING_POP
-
-/* Declaration du lexer utilise */
-void jsonerror(char const* fmt);
-
-#define json_STATIC
-
-/* default jsonerror for YACC and LEX */
-void jsonerror(char const* fmt)
-{
-	cout << "Error " << fmt << endl;
-}
 
 // Initialisation des variables globales
 ALString JSONTokenizer::sErrorFamily;
@@ -26,6 +11,18 @@ ALString JSONTokenizer::sLocalFileName;
 FILE* JSONTokenizer::fJSON = NULL;
 int JSONTokenizer::nLastToken = 0;
 boolean JSONTokenizer::bForceAnsi = false;
+char* JSONTokenizer::sBuffer = NULL;
+int JSONTokenizer::nBufferSize = 0;
+int JSONTokenizer::nBufferLength = 0;
+int JSONTokenizer::nBufferPos = 0;
+boolean JSONTokenizer::bEndOfFile = false;
+int JSONTokenizer::nLineIndex = 0;
+ALString JSONTokenizer::sTokenString;
+const char* JSONTokenizer::sTokenChars = NULL;
+int JSONTokenizer::nTokenLength = 0;
+boolean JSONTokenizer::bIsTokenStringView = false;
+double JSONTokenizer::dTokenNumber = 0;
+boolean JSONTokenizer::bTokenBoolean = false;
 
 void JSONTokenizer::SetForceAnsi(boolean bValue)
 {
@@ -51,14 +48,18 @@ boolean JSONTokenizer::OpenForRead(const ALString& sErrorFamilyName, const ALStr
 	if (bOk)
 		bOk = FileService::OpenInputBinaryFile(sLocalFileName, fJSON);
 
-	// Parametrage du parser genere par flex
+	// Initialisation du buffer de lecture
 	if (bOk)
 	{
 		sErrorFamily = sErrorFamilyName;
 		sFileName = sInputFileName;
 		nLastToken = -1;
-		jsonlineno = 1;
-		jsonrestart(fJSON);
+		nLineIndex = 1;
+		nBufferSize = nInitialBufferSize;
+		sBuffer = NewCharArray(nBufferSize + 1);
+		nBufferLength = 0;
+		nBufferPos = 0;
+		bEndOfFile = false;
 	}
 	return IsOpened();
 }
@@ -84,8 +85,13 @@ boolean JSONTokenizer::Close()
 
 	require(IsOpened());
 
-	// Nettoyage du lexer
-	jsonlex_destroy();
+	// Liberation du buffer de lecture
+	DeleteCharArray(sBuffer);
+	sBuffer = NULL;
+	nBufferSize = 0;
+	nBufferLength = 0;
+	nBufferPos = 0;
+	bEndOfFile = false;
 
 	// Fermeture du fichier
 	bOk = FileService::CloseInputBinaryFile(sFileName, fJSON);
@@ -97,9 +103,12 @@ boolean JSONTokenizer::Close()
 	sErrorFamily = "";
 	sFileName = "";
 	fJSON = NULL;
-	sJsonTokenString = "";
-	cJsonTokenDouble = 0;
-	bJsonTokenBoolean = false;
+	sTokenString = "";
+	sTokenChars = NULL;
+	nTokenLength = 0;
+	bIsTokenStringView = false;
+	dTokenNumber = 0;
+	bTokenBoolean = false;
 	nLastToken = 0;
 	return bOk;
 }
@@ -145,7 +154,7 @@ int JSONTokenizer::ReadNextToken()
 	require(IsOpened());
 
 	// Lecture du token
-	nLastToken = jsonlex();
+	nLastToken = ScanNextToken();
 	return nLastToken;
 }
 
@@ -158,28 +167,35 @@ int JSONTokenizer::GetLastToken()
 int JSONTokenizer::GetCurrentLineIndex()
 {
 	require(IsOpened());
-	return jsonlineno;
+	return nLineIndex;
 }
 
 const ALString& JSONTokenizer::GetTokenStringValue()
 {
 	require(IsOpened());
 	require(nLastToken == String or nLastToken == Error);
-	return sJsonTokenString;
+
+	// Construction de la valeur si necessaire
+	if (bIsTokenStringView)
+	{
+		memcpy(sTokenString.GetBufferSetLength(nTokenLength), sTokenChars, nTokenLength);
+		bIsTokenStringView = false;
+	}
+	return sTokenString;
 }
 
 double JSONTokenizer::GetTokenNumberValue()
 {
 	require(IsOpened());
 	require(nLastToken == Number);
-	return cJsonTokenDouble;
+	return dTokenNumber;
 }
 
 boolean JSONTokenizer::GetTokenBooleanValue()
 {
 	require(IsOpened());
 	require(nLastToken == Boolean);
-	return bJsonTokenBoolean;
+	return bTokenBoolean;
 }
 
 void JSONTokenizer::TestReadJsonFile(int argc, char** argv)
@@ -218,24 +234,22 @@ void JSONTokenizer::TestReadJsonFile(int argc, char** argv)
 			nToken = 1;
 			while (nToken != 0)
 			{
-				nToken = jsonlex();
+				nToken = ReadNextToken();
 				if (nToken == String)
 				{
-					sCString.GetBufferSetLength(0);
-					JsonToCString(sJsonTokenString, sCString);
-					cout << " \"" << sCString << "\"";
+					cout << " \"" << GetTokenStringValue() << "\"";
 				}
 				else if (nToken == Number)
 				{
-					cout << " " << cJsonTokenDouble;
+					cout << " " << GetTokenNumberValue();
 				}
 				else if (nToken == Boolean)
 				{
-					cout << " " << bJsonTokenBoolean;
+					cout << " " << GetTokenBooleanValue();
 				}
 				else if (nToken == Error)
 				{
-					cout << "<ERROR line " << GetCurrentLineIndex() << ": " << sJsonTokenString
+					cout << "<ERROR line " << GetCurrentLineIndex() << ": " << GetTokenStringValue()
 					     << " > " << endl;
 					break;
 				}
@@ -488,7 +502,7 @@ boolean JSONTokenizer::ReadStringValue(ALString& sValue)
 	// Lecture de la valeur
 	bOk = bOk and ReadExpectedToken(String);
 	if (bOk)
-		sValue = GetTokenStringValue();
+		CopyTokenStringValue(sValue);
 	else
 		sValue = "";
 	return bOk;
@@ -602,7 +616,7 @@ boolean JSONTokenizer::ReadKey(const ALString& sKey)
 	bOk = bOk and ReadExpectedToken(String);
 	if (bOk)
 	{
-		if (sKey != GetTokenStringValue())
+		if (not IsTokenStringEqual(sKey))
 		{
 			AddParseError(sTmp + "Read key \"" + GetTokenStringValue() + "\" instead of expected \"" +
 				      sKey + "\"");
@@ -841,9 +855,280 @@ const ALString JSONTokenizer::GetLastTokenValue()
 	return sValue;
 }
 
-void JSONTokenizer::AppendSubString(ALString& sString, const char* sAddedString, int nBegin, int nLength)
+int JSONTokenizer::ScanNextToken()
+{
+	int nChar;
+
+	require(IsOpened());
+
+	// Saut des blancs, en comptant les lignes
+	while (true)
+	{
+		if (nBufferPos == nBufferLength and not FillBuffer())
+			return 0;
+		nChar = (unsigned char)sBuffer[nBufferPos];
+		if (nChar == ' ' or nChar == '\t' or nChar == '\r')
+			nBufferPos++;
+		else if (nChar == '\n')
+		{
+			nLineIndex++;
+			nBufferPos++;
+		}
+		else
+			break;
+	}
+
+	// Analyse du token selon son premier caractere
+	switch (nChar)
+	{
+	case '{':
+	case '}':
+	case '[':
+	case ']':
+	case ',':
+	case ':':
+		nBufferPos++;
+		return nChar;
+	case '"':
+		return ScanString();
+	case 't':
+		bTokenBoolean = true;
+		return ScanKeyword("true", Boolean);
+	case 'f':
+		bTokenBoolean = false;
+		return ScanKeyword("false", Boolean);
+	case 'n':
+		return ScanKeyword("null", Null);
+	default:
+		if (nChar == '-' or isdigit(nChar))
+			return ScanNumber();
+		else
+			return ScanErrorChar();
+	}
+}
+
+int JSONTokenizer::ScanString()
+{
+	int nOffset;
+	int nChar;
+	int nNewLineNumber;
+	boolean bWithEscape;
+	int i;
+
+	require(sBuffer[nBufferPos] == '"');
+
+	// Recherche de la fin de la chaine, en validant les sequences d'echappement
+	nOffset = 1;
+	nNewLineNumber = 0;
+	bWithEscape = false;
+	while (true)
+	{
+		nChar = PeekChar(nOffset);
+		if (nChar == '"')
+			break;
+		else if (nChar == -1)
+			return ScanErrorChar();
+		else if (nChar == '\\')
+		{
+			bWithEscape = true;
+			nChar = PeekChar(nOffset + 1);
+			if (nChar == 'u')
+			{
+				for (i = 2; i < 6; i++)
+				{
+					if (not isxdigit(PeekChar(nOffset + i)))
+						return ScanErrorChar();
+				}
+				nOffset += 6;
+			}
+			else if (nChar == '"' or nChar == '\\' or nChar == '/' or nChar == 'b' or nChar == 'f' or
+				 nChar == 'n' or nChar == 'r' or nChar == 't')
+				nOffset += 2;
+			else
+				return ScanErrorChar();
+		}
+		else
+		{
+			if (nChar == '\n')
+				nNewLineNumber++;
+			nOffset++;
+		}
+	}
+
+	// Memorisation de la chaine sous forme de vue sur le buffer, puis consommation de la chaine
+	sTokenChars = &sBuffer[nBufferPos + 1];
+	nTokenLength = nOffset - 1;
+	bIsTokenStringView = true;
+	nBufferPos += nOffset + 1;
+	nLineIndex += nNewLineNumber;
+
+	// Conversion si necessaire, apres avoir remplace le '"' de fin par '\0'
+	if (bWithEscape or bForceAnsi)
+	{
+		sBuffer[nBufferPos - 1] = '\0';
+		JsonToCString(sTokenChars, sTokenString);
+		bIsTokenStringView = false;
+
+		// On force la conversion vers l'ansi si necessaire
+		if (bForceAnsi)
+		{
+			ALString sTokenStringCopy = sTokenString;
+			JSONFile::CStringToCAnsiString(sTokenStringCopy, sTokenString);
+		}
+	}
+	return String;
+}
+
+int JSONTokenizer::ScanNumber()
+{
+	int nLength;
+	char cEndChar;
+
+	require(PeekChar(0) == '-' or isdigit(PeekChar(0)));
+
+	// Reconnaissance de la plus longue sequence correspondant a un nombre JSON
+	// (-?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?)
+	nLength = 0;
+	if (PeekChar(nLength) == '-')
+		nLength++;
+	if (PeekChar(nLength) == '0')
+		nLength++;
+	else if (isdigit(PeekChar(nLength)))
+	{
+		while (isdigit(PeekChar(nLength)))
+			nLength++;
+	}
+	else
+		return ScanErrorChar();
+	if (PeekChar(nLength) == '.' and isdigit(PeekChar(nLength + 1)))
+	{
+		nLength += 2;
+		while (isdigit(PeekChar(nLength)))
+			nLength++;
+	}
+	if (PeekChar(nLength) == 'e' or PeekChar(nLength) == 'E')
+	{
+		if ((PeekChar(nLength + 1) == '+' or PeekChar(nLength + 1) == '-') and isdigit(PeekChar(nLength + 2)))
+			nLength += 2;
+		else if (isdigit(PeekChar(nLength + 1)))
+			nLength++;
+		while (isdigit(PeekChar(nLength)))
+			nLength++;
+	}
+
+	// Conversion directe depuis le buffer, en terminant temporairement le nombre par '\0'
+	cEndChar = sBuffer[nBufferPos + nLength];
+	sBuffer[nBufferPos + nLength] = '\0';
+	dTokenNumber = KWContinuous::StringToContinuous(&sBuffer[nBufferPos]);
+	sBuffer[nBufferPos + nLength] = cEndChar;
+	nBufferPos += nLength;
+	return Number;
+}
+
+int JSONTokenizer::ScanKeyword(const char* sKeyword, int nToken)
 {
+	int nLength;
 	int i;
+
+	require(sKeyword != NULL);
+	require(sBuffer[nBufferPos] == sKeyword[0]);
+
+	// Verification du mot cle
+	nLength = (int)strlen(sKeyword);
+	for (i = 1; i < nLength; i++)
+	{
+		if (PeekChar(i) != sKeyword[i])
+			return ScanErrorChar();
+	}
+	nBufferPos += nLength;
+	return nToken;
+}
+
+int JSONTokenizer::ScanErrorChar()
+{
+	require(nBufferPos < nBufferLength);
+
+	// La valeur du token est le caractere courant
+	sTokenString = sBuffer[nBufferPos];
+	bIsTokenStringView = false;
+	nBufferPos++;
+	return Error;
+}
+
+inline int JSONTokenizer::PeekChar(int nOffset)
+{
+	require(nOffset >= 0);
+
+	// Completion du buffer si necessaire
+	while (nBufferPos + nOffset >= nBufferLength)
+	{
+		if (not FillBuffer())
+			return -1;
+	}
+	return (unsigned char)sBuffer[nBufferPos + nOffset];
+}
+
+boolean JSONTokenizer::FillBuffer()
+{
+	char* sNewBuffer;
+	int nReadLength;
+
+	require(IsOpened());
+
+	if (bEndOfFile)
+		return false;
+
+	// On ramene les caracteres non analyses en debut de buffer
+	if (nBufferPos > 0)
+	{
+		memmove(sBuffer, &sBuffer[nBufferPos], nBufferLength - nBufferPos);
+		nBufferLength -= nBufferPos;
+		nBufferPos = 0;
+	}
+
+	// On double la taille du buffer s'il est plein
+	if (nBufferLength == nBufferSize)
+	{
+		sNewBuffer = NewCharArray(2 * nBufferSize + 1);
+		memcpy(sNewBuffer, sBuffer, nBufferLength);
+		DeleteCharArray(sBuffer);
+		sBuffer = sNewBuffer;
+		nBufferSize *= 2;
+	}
+
+	// Lecture de nouveaux caracteres
+	nReadLength = (int)fread(&sBuffer[nBufferLength], sizeof(char), nBufferSize - nBufferLength, fJSON);
+	if (nReadLength <= 0)
+	{
+		bEndOfFile = true;
+		return false;
+	}
+	nBufferLength += nReadLength;
+	return true;
+}
+
+boolean JSONTokenizer::IsTokenStringEqual(const ALString& sValue)
+{
+	require(nLastToken == String or nLastToken == Error);
+
+	if (bIsTokenStringView)
+		return sValue.GetLength() == nTokenLength and memcmp((const char*)sValue, sTokenChars, nTokenLength) == 0;
+	else
+		return sValue == sTokenString;
+}
+
+void JSONTokenizer::CopyTokenStringValue(ALString& sValue)
+{
+	require(nLastToken == String or nLastToken == Error);
+
+	if (bIsTokenStringView)
+		memcpy(sValue.GetBufferSetLength(nTokenLength), sTokenChars, nTokenLength);
+	else
+		sValue = sTokenString;
+}
+
+void JSONTokenizer::AppendSubString(ALString& sString, const char* sAddedString, int nBegin, int nLength)
+{
 	int nStringLength;
 
 	require(sAddedString != NULL);
@@ -851,16 +1136,9 @@ void JSONTokenizer::AppendSubString(ALString& sString, const char* sAddedString,
 	require(nLength >= 0);
 	require(nBegin + nLength <= (int)strlen(sAddedString));
 
-	// Reservation de la place necessaire
+	// Reservation de la place necessaire et ajout des caracteres
 	nStringLength = sString.GetLength();
-	sString.GetBufferSetLength(nStringLength + nLength);
-
-	// Ajout des caracteres
-	for (i = nBegin; i < nBegin + nLength; i++)
-	{
-		sString.SetAt(nStringLength, sAddedString[i]);
-		nStringLength++;
-	}
+	memcpy(sString.GetBufferSetLength(nStringLength + nLength) + nStringLength, sAddedString + nBegin, nLength);
 }
 
 void JSONTokenizer::AddParseError(const ALString& sLabel)
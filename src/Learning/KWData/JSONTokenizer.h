@@ -13,6 +13,9 @@
 
 //////////////////////////////////////////////////////
 // Parser de fichier JSON pour en extraire les tokens
+// Le fichier est lu par grands blocs dans un buffer, analyse directement sans passer
+// par un lexer genere: les chaines sans caractere d'echappement ne sont pas recopiees,
+// mais gardees sous forme de vue sur le buffer jusqu'a la lecture du token suivant
 // Attention: les methodes sont toutes statiques
 class JSONTokenizer : public Object
 {
@@ -68,6 +71,7 @@ public:
 	static int GetCurrentLineIndex();
 
 	// Acces a la valeur associee a un token
+	// La valeur chaine de caracteres n'est construite qu'a la demande
 	static const ALString& GetTokenStringValue();
 	static double GetTokenNumberValue();
 	static boolean GetTokenBooleanValue();
@@ -137,6 +141,30 @@ protected:
 	// Valeur du dernier token entre parenthese si le token est associe a une valeur, vide sinon
 	static const ALString GetLastTokenValue();
 
+	// Analyse du prochain token a partir du buffer
+	static int ScanNextToken();
+	static int ScanString();
+	static int ScanNumber();
+	static int ScanKeyword(const char* sKeyword, int nToken);
+
+	// Positionnement d'un token erreur sur le caractere courant, qui est consomme
+	static int ScanErrorChar();
+
+	// Acces au caractere situe a un decalage donne de la position courante du buffer,
+	// en completant le buffer si necessaire; renvoie -1 en fin de fichier
+	static int PeekChar(int nOffset);
+
+	// Ajout de nouveaux caracteres du fichier dans le buffer, en conservant ceux a partir
+	// de la position courante, qui sont ramenes en debut de buffer
+	// Renvoie false si aucun caractere n'a pu etre ajoute (fin de fichier)
+	static boolean FillBuffer();
+
+	// Test d'egalite entre la valeur chaine du dernier token et une chaine
+	static boolean IsTokenStringEqual(const ALString& sValue);
+
+	// Recopie de la valeur chaine du dernier token
+	static void CopyTokenStringValue(ALString& sValue);
+
 	// Ajout d'une sous partie d'une chaine
 	static void AppendSubString(ALString& sString, const char* sAddedString, int nBegin, int nLength);
 
@@ -155,6 +183,30 @@ protected:
 	// Type du dernier token, pour les assertions
 	static int nLastToken;
 
+	// Buffer de lecture, dont les caracteres non encore analyses sont entre nBufferPos et nBufferLength
+	// Un caractere supplementaire est reserve en fin de buffer pour pouvoir terminer un token par '\0'
+	static char* sBuffer;
+	static int nBufferSize;
+	static int nBufferLength;
+	static int nBufferPos;
+	static boolean bEndOfFile;
+
+	// Taille initiale du buffer, qui est agrandi si un token ne tient pas dans le buffer
+	static const int nInitialBufferSize = 1024 * 1024;
+
+	// Numero de la ligne courante
+	static int nLineIndex;
+
+	// Valeurs du dernier token
+	// Pour une chaine sans caractere d'echappement, la valeur est une vue (sTokenChars, nTokenLength)
+	// sur le buffer, valide jusqu'a la lecture du token suivant
+	static ALString sTokenString;
+	static const char* sTokenChars;
+	static int nTokenLength;
+	static boolean bIsTokenStringView;
+	static double dTokenNumber;
+	static boolean bTokenBoolean;
+
 	// Parametrage de la conversion vers l'ansi
 	static boolean bForceAnsi;
 };
@@ -2565,6 +2565,7 @@ KWDataItem* KWClass::LookupDataItem(const ALString& sDataItemName) const
 
 void KWClass::InitializeAllRandomRuleParameters()
 {
+	const KWDRRandom refRandomRule;
 	KWAttribute* attribute;
 	KWDerivationRule* rule;
 	int nRuleRankInAttribute;
@@ -2579,25 +2580,26 @@ void KWClass::InitializeAllRandomRuleParameters()
 		nRuleRankInAttribute = 1;
 		rule = attribute->GetDerivationRule();
 		if (rule != NULL)
-			InitializeRandomRuleParameters(rule, attribute->GetName(), nRuleRankInAttribute);
+			InitializeRandomRuleParameters(&refRandomRule, rule, attribute->GetName(),
+						       nRuleRankInAttribute);
 		GetNextAttribute(attribute);
 	}
 }
 
-void KWClass::InitializeRandomRuleParameters(KWDerivationRule* rule, const ALString& sAttributeName,
-					     int& nRuleRankInAttribute)
+void KWClass::InitializeRandomRuleParameters(const KWDRRandom* refRandomRule, KWDerivationRule* rule,
+					     const ALString& sAttributeName, int& nRuleRankInAttribute)
 {
-	const KWDRRandom refRandomRule;
 	KWDRRandom* randomRule;
 	KWDerivationRuleOperand* operand;
 	int i;
 
+	require(refRandomRule != NULL);
 	require(rule != NULL);
 	require(sAttributeName != "");
 	require(nRuleRankInAttribute > 0);
 
 	// Parametrage de la regle si c'est une regle de type Random
-	if (rule->GetName() == refRandomRule.GetName())
+	if (rule->GetName() == refRandomRule->GetName())
 	{
 		randomRule = cast(KWDRRandom*, rule);
 		randomRule->InitializeRandomParameters(GetName(), sAttributeName, nRuleRankInAttribute);
@@ -2610,8 +2612,8 @@ void KWClass::InitializeRandomRuleParameters(KWDerivationRule* rule, const ALStr
 		{
 			operand = rule->GetOperandAt(i);
 			if (operand->GetOrigin() == KWDerivationRuleOperand::OriginRule)
-				InitializeRandomRuleParameters(operand->GetDerivationRule(), sAttributeName,
-							       nRuleRankInAttribute);
+				InitializeRandomRuleParameters(refRandomRule, operand->GetDerivationRule(),
+							       sAttributeName, nRuleRankInAttribute);
 		}
 	}
 }
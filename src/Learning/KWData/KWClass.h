@@ -11,6 +11,7 @@ class KWClass;
 class KWObject;
 class KWClassDomain;
 class KWDerivationRule;
+class KWDRRandom;
 
 #include "Standard.h"
 #include "ALString.h"
@@ -508,8 +509,9 @@ protected:
 
 	// Parametrage d'une regle si elle est de type random, avec propagation a ses operandes
 	// L'entier nRuleRankInAttribute est incremente a chaque nouvelle regle Random rencontree
-	void InitializeRandomRuleParameters(KWDerivationRule* rule, const ALString& sAttributeName,
-					    int& nRuleRankInAttribute);
+	// La regle Random de reference est passee en parametre pour ne pas la reconstruire a chaque appel
+	void InitializeRandomRuleParameters(const KWDRRandom* refRandomRule, KWDerivationRule* rule,
+					    const ALString& sAttributeName, int& nRuleRankInAttribute);
 
 	// Verification de l'integrite de la classe en ce qui concerne sa composition
 	// Il ne doit pas y avoir de cycle dans le graphe des utilisation entre classes par composition
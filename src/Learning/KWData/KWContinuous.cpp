@@ -715,18 +715,49 @@ inline int KWContinuous::ComputeExponent(Continuous cValue)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+// Table des paires de chiffres de "00" a "99", pour ecrire les chiffres deux par deux
+static const char sDigitPairs[] = "0001020304050607080910111213141516171819"
+				  "2021222324252627282930313233343536373839"
+				  "4041424344454647484950515253545556575859"
+				  "6061626364656667686970717273747576777879"
+				  "8081828384858687888990919293949596979899";
+
 const char* const KWContinuous::ContinuousToString(Continuous cValue)
 {
 	char* sBuffer = StandardGetBuffer();
 
+	ContinuousToCharArray(cValue, sBuffer);
+	return sBuffer;
+}
+
+int KWContinuous::ContinuousToCharArray(Continuous cValue, char* sBuffer)
+{
+	const int nDigitNumber = 10;
+	char sDigits[nDigitNumber];
+	int nOffset;
+	int nExponent;
+	double dMantissa;
+	longint lLongMantissa;
+	int nHighPart;
+	int nLowPart;
+	int nSignificantDigitNumber;
+	int i;
+
+	require(sBuffer != NULL);
+	require(GetDigitNumber() == nDigitNumber);
+
+	// Valeur manquante
 	if (cValue == KWContinuous::GetMissingValue())
 	{
 		sBuffer[0] = '\0';
+		return 0;
 	}
+	// Valeur nulle
 	else if (cValue == 0)
 	{
 		sBuffer[0] = '0';
 		sBuffer[1] = '\0';
+		return 1;
 	}
 #ifdef _WIN32
 	else if (_isnan(cValue))
@@ -738,219 +769,164 @@ const char* const KWContinuous::ContinuousToString(Continuous cValue)
 		sBuffer[1] = 'a';
 		sBuffer[2] = 'N';
 		sBuffer[3] = '\0';
+		return 3;
 	}
+
+	// Traitement des nombre negatifs
+	nOffset = 0;
+	if (cValue < 0)
+	{
+		sBuffer[0] = '-';
+		nOffset++;
+		cValue = -cValue;
+	}
+
+	// Recherche de l'exposant
+	nExponent = ComputeExponent(cValue);
+
+	// Cas des valeurs trop grandes
+	if (nExponent >= 100)
+	{
+		memcpy(&sBuffer[nOffset], "1e+100", 7);
+		return nOffset + 6;
+	}
+	// Cas des valeurs trop petites, sans signe
+	else if (nExponent < -100)
+	{
+		sBuffer[0] = '0';
+		sBuffer[1] = '\0';
+		return 1;
+	}
+
+	// Normalisation de la precision de la mantisse
+	// On normalise par la puissance de l'exposant avant prendre en compte les decimales
+	// selon la precision souhaitee
+	if (nExponent >= nDigitNumber - 1)
+		dMantissa = cValue * dNegativePower10[nExponent - nDigitNumber + 1];
 	else
+		dMantissa = cValue * dPositivePower10[-nExponent + nDigitNumber - 1];
+
+	// On doit passer par un longint pour avoir 10 decimales
+	lLongMantissa = (longint)(dMantissa + 0.5);
+
+	// Correction de l'exposant si necessaire
+	if (lLongMantissa >= 10000000000.0)
+	{
+		nExponent++;
+		lLongMantissa /= 10;
+	}
+	assert(1000000000 <= lLongMantissa and lLongMantissa < 10000000000.0);
+
+	// Ecriture des 10 chiffres de la mantisse par paires de chiffres, en passant par des int
+	// plus efficaces pour les calculs: les deux premiers chiffres, puis les huit suivants
+	nHighPart = (int)(lLongMantissa / 100000000);
+	nLowPart = (int)(lLongMantissa % 100000000);
+	sDigits[0] = sDigitPairs[2 * nHighPart];
+	sDigits[1] = sDigitPairs[2 * nHighPart + 1];
+	for (i = nDigitNumber - 2; i >= 2; i -= 2)
+	{
+		sDigits[i] = sDigitPairs[2 * (nLowPart % 100)];
+		sDigits[i + 1] = sDigitPairs[2 * (nLowPart % 100) + 1];
+		nLowPart /= 100;
+	}
+
+	// Nombre de chiffres significatifs, sans les zeros de fin
+	nSignificantDigitNumber = nDigitNumber;
+	while (nSignificantDigitNumber > 1 and sDigits[nSignificantDigitNumber - 1] == '0')
+		nSignificantDigitNumber--;
+
+	// Cas d'un petit exposant negatif: "0.", zeros du debut, puis chiffres de la mantisse
+	if (-4 <= nExponent and nExponent < 0)
 	{
-		const int nStartMantissa = 20;
-		int nEndMantissa;
-		int nOffset = 0;
-		int nExponent;
-		double dMantissa;
-		longint lLongMantissa;
-		int nMantissa;
-		int i;
-		int nPointOffset;
-
-		// Traitement des nombre negatifs
-		if (cValue < 0)
+		sBuffer[nOffset] = '0';
+		sBuffer[nOffset + 1] = '.';
+		nOffset += 2;
+		for (i = nExponent + 1; i < 0; i++)
 		{
-			sBuffer[0] = '-';
+			sBuffer[nOffset] = '0';
 			nOffset++;
-			cValue = -cValue;
 		}
-		else
-			sBuffer[0] = '\0';
-
-		// Recherche de l'exposant
-		nExponent = ComputeExponent(cValue);
-
-		// Cas des valeurs trop grandes
-		if (nExponent >= 100)
+		memcpy(&sBuffer[nOffset], sDigits, nSignificantDigitNumber);
+		nOffset += nSignificantDigitNumber;
+	}
+	// Cas d'un petit exposant positif: partie entiere, puis partie decimale eventuelle
+	else if (0 <= nExponent and nExponent < nDigitNumber)
+	{
+		memcpy(&sBuffer[nOffset], sDigits, nExponent + 1);
+		nOffset += nExponent + 1;
+		if (nSignificantDigitNumber > nExponent + 1)
 		{
-			if (sBuffer[0] == '-')
-			{
-				sBuffer[1] = '1';
-				sBuffer[2] = 'e';
-				sBuffer[3] = '+';
-				sBuffer[4] = '1';
-				sBuffer[5] = '0';
-				sBuffer[6] = '0';
-				sBuffer[7] = '\0';
-			}
-			else
-			{
-				sBuffer[0] = '1';
-				sBuffer[1] = 'e';
-				sBuffer[2] = '+';
-				sBuffer[3] = '1';
-				sBuffer[4] = '0';
-				sBuffer[5] = '0';
-				sBuffer[6] = '\0';
-			}
+			sBuffer[nOffset] = '.';
+			nOffset++;
+			memcpy(&sBuffer[nOffset], &sDigits[nExponent + 1], nSignificantDigitNumber - nExponent - 1);
+			nOffset += nSignificantDigitNumber - nExponent - 1;
 		}
-		// Cas des valeurs trop petites
-		else if (nExponent < -100)
+	}
+	// Cas avec exposant
+	else
+	{
+		// Premier chiffre de la mantisse, suivi si necessaire d'un '.' et des chiffres suivants
+		sBuffer[nOffset] = sDigits[0];
+		nOffset++;
+		if (nSignificantDigitNumber > 1)
 		{
-			sBuffer[0] = '0';
-			sBuffer[1] = '\0';
+			sBuffer[nOffset] = '.';
+			nOffset++;
+			memcpy(&sBuffer[nOffset], &sDigits[1], nSignificantDigitNumber - 1);
+			nOffset += nSignificantDigitNumber - 1;
+		}
+
+		// Ecriture de l'exposant, sur au moins deux chiffres
+		sBuffer[nOffset] = 'e';
+		nOffset++;
+		if (nExponent < 0)
+		{
+			sBuffer[nOffset] = '-';
+			nExponent = -nExponent;
 		}
-		// Cas standard
 		else
+			sBuffer[nOffset] = '+';
+		nOffset++;
+		assert(nExponent < 200);
+		if (nExponent >= 100)
 		{
-			// Normalisation de la precision de la mantisse
-			// On normalise par la puissance de l'exposant avant prendre en compte les decimales
-			// selon la precision souhaitee
-			if (nExponent >= GetDigitNumber() - 1)
-				dMantissa = cValue * dNegativePower10[nExponent - GetDigitNumber() + 1];
-			else
-				dMantissa = cValue * dPositivePower10[-nExponent + GetDigitNumber() - 1];
-
-			// On doit passer par un longint pour avoir 10 decimales
-			lLongMantissa = (longint)(dMantissa + 0.5);
-
-			// Correction de l'exposant si necessaire
-			if (lLongMantissa >= 10000000000.0)
-			{
-				nExponent++;
-				lLongMantissa /= 10;
-			}
-
-			// Ecriture de la mantisse a l'envers, plus loin dans le buffer
-			// On repasse par des int, plus efficace pour les calcul,
-			// en traitant d'abord la premiere decimale, puis les suivantes
-			i = nStartMantissa;
-			sBuffer[i] = '0' + lLongMantissa % 10;
-			i++;
-			assert(lLongMantissa / 10 <= 1000000000.0);
-			nMantissa = (int)(lLongMantissa / 10);
-			do
-			{
-				sBuffer[i] = '0' + nMantissa % 10;
-				i++;
-				nMantissa /= 10;
-			} while (nMantissa > 0);
-			nEndMantissa = i - 1;
-
-			// Inversion de l'ecriture de la mantisse pour un petit exposant negatif
-			if (-4 <= nExponent and nExponent < 0)
-			{
-				// Header '0.'
-				sBuffer[nOffset] = '0';
-				nOffset++;
-				sBuffer[nOffset] = '.';
-				nOffset++;
-
-				// Ecriture des zero du debut de la mantisse
-				for (i = nExponent + 1; i < 0; i++)
-				{
-					sBuffer[nOffset] = '0';
-					nOffset++;
-				}
-
-				// Ecriture du reste de la mantisse
-				for (i = 0; i < GetDigitNumber(); i++)
-				{
-					sBuffer[nOffset] = sBuffer[nEndMantissa - i];
-					nOffset++;
-				}
-
-				// Supression des zeros de fin
-				while (sBuffer[nOffset - 1] == '0')
-					nOffset--;
-				assert(sBuffer[nOffset - 1] != '.');
-
-				// Fin du buffer
-				sBuffer[nOffset] = '\0';
-			}
-			// Inversion de l'ecriture de la mantisse pour un petit exposant positif
-			else if (0 <= nExponent and nExponent < GetDigitNumber())
-			{
-				// Ecriture de la mantisse, avec un point decimal
-				nPointOffset = nEndMantissa - nExponent - 1;
-				for (i = nEndMantissa; i >= nStartMantissa; i--)
-				{
-					// Insertion du point
-					if (i == nPointOffset)
-					{
-						sBuffer[nOffset] = '.';
-						nOffset++;
-
-						// On passe a -1 pour indiquer qu'un point a etet ecrit
-						nPointOffset = -1;
-					}
-
-					// Ajout d'une decimale
-					sBuffer[nOffset] = sBuffer[i];
-					nOffset++;
-				}
-
-				// Supression des zeros de fin
-				if (nPointOffset == -1)
-				{
-					while (sBuffer[nOffset - 1] == '0')
-						nOffset--;
-					if (sBuffer[nOffset - 1] == '.')
-						nOffset--;
-				}
+			sBuffer[nOffset] = '1';
+			nOffset++;
+		}
+		sBuffer[nOffset] = sDigitPairs[2 * (nExponent % 100)];
+		sBuffer[nOffset + 1] = sDigitPairs[2 * (nExponent % 100) + 1];
+		nOffset += 2;
+	}
 
-				// Fin du buffer
-				sBuffer[nOffset] = '\0';
-			}
-			// Inversion de l'ecriture de la mantisse dans les cas avec exposant
-			else
-			{
-				// Premier chifre de la mantisse, suivi d'un '.'
-				sBuffer[nOffset] = sBuffer[nEndMantissa];
-				nOffset++;
-				sBuffer[nOffset] = '.';
-				nOffset++;
+	// Fin du buffer
+	assert(nOffset < nMaxContinuousStringLength);
+	sBuffer[nOffset] = '\0';
+	return nOffset;
+}
 
-				// Ecriture du reste de la mantisse
-				for (i = nEndMantissa - 1; i >= nStartMantissa; i--)
-				{
-					sBuffer[nOffset] = sBuffer[i];
-					nOffset++;
-				}
+void KWContinuous::AppendContinuous(ALString& sOutput, Continuous cValue)
+{
+	char sBuffer[nMaxContinuousStringLength];
 
-				// Supression des zeros de fin
-				while (sBuffer[nOffset - 1] == '0')
-					nOffset--;
-				if (sBuffer[nOffset - 1] == '.')
-					nOffset--;
+	ContinuousToCharArray(cValue, sBuffer);
+	sOutput += sBuffer;
+}
 
-				// Ajout de l'exposant
-				sBuffer[nOffset] = 'e';
-				nOffset++;
+void KWContinuous::AppendContinuousVector(ALString& sOutput, const ContinuousVector* cvValues, char cSeparator)
+{
+	char sBuffer[nMaxContinuousStringLength];
+	int i;
 
-				// Ecriture de l'exposant
-				if (nExponent < 0)
-				{
-					sBuffer[nOffset] = '-';
-					nOffset++;
-					nExponent = -nExponent;
-				}
-				else
-				{
-					sBuffer[nOffset] = '+';
-					nOffset++;
-				}
-				assert(nExponent < 200);
-				if (nExponent >= 100)
-				{
-					sBuffer[nOffset] = '1';
-					nOffset++;
-				}
-				sBuffer[nOffset] = '0' + (nExponent % 100) / 10;
-				nOffset++;
-				sBuffer[nOffset] = '0' + (nExponent % 10);
-				nOffset++;
+	require(cvValues != NULL);
+	require(cSeparator != '\0');
 
-				// Fin du buffer
-				sBuffer[nOffset] = '\0';
-			}
-		}
+	for (i = 0; i < cvValues->GetSize(); i++)
+	{
+		if (i > 0)
+			sOutput += cSeparator;
+		ContinuousToCharArray(cvValues->GetAt(i), sBuffer);
+		sOutput += sBuffer;
 	}
-	return sBuffer;
 }
 
 Continuous KWContinuous::DoubleToContinuous(double dValue)
@@ -2258,6 +2234,7 @@ void KWContinuous::TestPerformanceContinuousToString(int nMaxLowerBaseValue, dou
 void KWContinuous::TestContinuousToString()
 {
 	ContinuousVector cvValues;
+	ALString sValues;
 	int i;
 	Continuous cValue;
 	Continuous cBaseValue;
@@ -2325,6 +2302,11 @@ void KWContinuous::TestContinuousToString()
 		cout << "\n";
 	}
 
+	// Conversion en bloc des valeurs de base
+	sValues = "";
+	AppendContinuousVector(sValues, &cvValues, ' ');
+	cout << "Values\t" << sValues << "\n";
+
 	// Affichage des puissances positives
 	cValue = 0.123456789012345;
 	for (i = 0; i <= 105; i++)
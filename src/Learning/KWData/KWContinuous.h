@@ -37,6 +37,20 @@ public:
 	// avec les stream, ne pas utiliser directement la valeur Continuous)
 	static const char* const ContinuousToString(Continuous cValue);
 
+	// Conversion vers une chaine de caracteres dans un buffer fourni par l'appelant, de taille
+	// au moins nMaxContinuousStringLength, sans passer par le buffer partage de ContinuousToString
+	// Renvoie la longueur de la chaine ecrite, terminee par '\0'
+	static int ContinuousToCharArray(Continuous cValue, char* sBuffer);
+
+	// Taille max d'un buffer de conversion d'un Continuous en chaine de caracteres
+	static const int nMaxContinuousStringLength = 32;
+
+	// Ajout de la conversion d'une valeur en fin de chaine de caracteres
+	static void AppendContinuous(ALString& sOutput, Continuous cValue);
+
+	// Ajout en bloc de la conversion des valeurs d'un vecteur, separees par un caractere
+	static void AppendContinuousVector(ALString& sOutput, const ContinuousVector* cvValues, char cSeparator);
+
 	// Conversion depuis une chaine de caractere
 	// En cas de probleme, la conversion se fait au mieux
 	//     chaine vide ou probleme de conversion: MissingValue
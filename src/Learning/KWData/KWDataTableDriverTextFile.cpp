@@ -552,10 +552,11 @@ KWObject* KWDataTableDriverTextFile::Read()
 				// Cas des blocs d'attributs Continuous
 				else if (attributeBlock->GetType() == KWType::Continuous)
 				{
-					// Lecture et alimentation d'un bloc de valeurs
+					// Lecture et alimentation d'un bloc de valeurs, compacte si possible
 					cvbValue = KWContinuousValueBlock::BuildBlockFromField(
 					    attributeBlock->GetLoadedAttributesIndexedKeyBlock(), sField,
 					    attributeBlock->GetContinuousDefaultValue(), bValueBlockOk, sMessage);
+					cvbValue = KWContinuousValueBlock::Compact(cvbValue);
 					kwoObject->SetContinuousValueBlockAt(liLoadIndex, cvbValue);
 				}
 
@@ -628,11 +629,18 @@ void KWDataTableDriverTextFile::Write(const KWObject* kwoObject)
 	ALString sValueBlockField;
 	int nFieldIndex;
 	ALString sTimeZoneAwareLabel;
+	char sContinuousBuffer[KWContinuous::nMaxContinuousStringLength];
+	int nContinuousLength;
+	boolean bContinuousWithoutDoubleQuote;
 
 	require(inputBuffer == NULL);
 	require(outputBuffer != NULL);
 	require(bWriteMode);
 
+	// Les valeurs numeriques peuvent etre ecrites directement, sans recherche de double-quotes,
+	// si le separateur de champ ne fait pas partie des caracteres utilises pour les nombres
+	bContinuousWithoutDoubleQuote = strchr("0123456789.+-eNa", cFieldSeparator) == NULL;
+
 	// Parcours de tous les dataItems Loaded
 	lRecordIndex++;
 	nFieldIndex = 0;
@@ -653,8 +661,20 @@ void KWDataTableDriverTextFile::Write(const KWObject* kwoObject)
 			{
 				if (nFieldIndex > 0)
 					outputBuffer->Write(cFieldSeparator);
-				sValue = kwoObject->ValueToString(attribute);
-				outputBuffer->WriteField(sValue);
+
+				// Cas des valeurs numeriques, converties dans un buffer local
+				if (attribute->GetType() == KWType::Continuous and bContinuousWithoutDoubleQuote)
+				{
+					nContinuousLength = KWContinuous::ContinuousToCharArray(
+					    kwoObject->GetContinuousValueAt(attribute->GetLoadIndex()), sContinuousBuffer);
+					outputBuffer->Write(sContinuousBuffer, nContinuousLength);
+				}
+				// Cas general
+				else
+				{
+					sValue = kwoObject->ValueToString(attribute);
+					outputBuffer->WriteField(sValue);
+				}
 				nFieldIndex++;
 			}
 		}
@@ -22,15 +22,70 @@ void KWIndexedCKeyBlock::Clean()
 {
 	nkdKeyIndexes.RemoveAll();
 	oaKeyIndexes.DeleteAll();
+	ivKeyHashTable.SetSize(0);
 }
 
 boolean KWIndexedCKeyBlock::IndexKeys()
 {
-	// Rien a faire dans le cas categoriel
-	// Les cles sont deja dans leur dictionnaire
+	int nTableSize;
+	int nMask;
+	int nKey;
+	int nPosition;
+
+	// Les cles sont deja dans leur dictionnaire, indexe par Symbol
+	// On calcule en plus une table de hashage par valeur des cles, pour la lecture des champs
+	ivKeyHashTable.SetSize(0);
+	if (GetKeyNumber() > 0)
+	{
+		// Taille de la table: puissance de 2 au moins double du nombre de cles
+		nTableSize = 2;
+		while (nTableSize < 2 * GetKeyNumber())
+			nTableSize *= 2;
+		nMask = nTableSize - 1;
+		ivKeyHashTable.SetSize(nTableSize);
+
+		// Insertion des cles avec sondage lineaire
+		for (nKey = 0; nKey < GetKeyNumber(); nKey++)
+		{
+			nPosition = HashValue(GetKeyAt(nKey).GetValue()) & nMask;
+			while (ivKeyHashTable.GetAt(nPosition) != 0)
+				nPosition = (nPosition + 1) & nMask;
+			ivKeyHashTable.SetAt(nPosition, nKey + 1);
+		}
+	}
 	return true;
 }
 
+int KWIndexedCKeyBlock::GetKeyIndexFromString(const char* sKey) const
+{
+	int nMask;
+	int nPosition;
+	int nKeyIndex;
+
+	require(sKey != NULL);
+
+	// Cas sans cle
+	if (GetKeyNumber() == 0)
+		return -1;
+	// Passage par un Symbol si les cles ne sont pas indexees
+	else if (ivKeyHashTable.GetSize() == 0)
+		return GetKeyIndex(Symbol(sKey));
+	// Recherche dans la table de hashage, qui contient toujours des cases vides
+	else
+	{
+		nMask = ivKeyHashTable.GetSize() - 1;
+		nPosition = HashValue(sKey) & nMask;
+		while (ivKeyHashTable.GetAt(nPosition) != 0)
+		{
+			nKeyIndex = ivKeyHashTable.GetAt(nPosition) - 1;
+			if (strcmp(GetKeyAt(nKeyIndex).GetValue(), sKey) == 0)
+				return nKeyIndex;
+			nPosition = (nPosition + 1) & nMask;
+		}
+		return -1;
+	}
+}
+
 void KWIndexedCKeyBlock::AddKey(const Symbol& sKey)
 {
 	KWKeyIndex* keyIndex;
@@ -47,6 +102,9 @@ void KWIndexedCKeyBlock::AddKey(const Symbol& sKey)
 	// Ajout dans les containeurs
 	oaKeyIndexes.Add(keyIndex);
 	nkdKeyIndexes.SetAt(sKey.GetNumericKey(), keyIndex);
+
+	// Invalidation de l'indexation des cles
+	ivKeyHashTable.SetSize(0);
 }
 
 void KWIndexedCKeyBlock::Write(ostream& ost) const
@@ -73,7 +131,8 @@ void KWIndexedCKeyBlock::Write(ostream& ost) const
 longint KWIndexedCKeyBlock::GetUsedMemory() const
 {
 	return sizeof(KWIndexedCKeyBlock) + GetKeyNumber() * sizeof(KWKeyIndex) + oaKeyIndexes.GetUsedMemory() -
-	       sizeof(ObjectArray) + nkdKeyIndexes.GetUsedMemory() - sizeof(NumericKeyDictionary);
+	       sizeof(ObjectArray) + nkdKeyIndexes.GetUsedMemory() - sizeof(NumericKeyDictionary) +
+	       ivKeyHashTable.GetUsedMemory() - sizeof(IntVector);
 }
 
 const ALString KWIndexedCKeyBlock::GetClassLabel() const
@@ -200,6 +259,8 @@ void KWIndexedCKeyBlock::Test()
 				nKeyIndex = indexedKeyBlock.GetKeyIndex(svTestKeys.GetAt(nKey));
 				lTotal += nKeyIndex;
 				assert(indexedKeyBlock.GetKeyAt(nKeyIndex) == svTestKeys.GetAt(nKey));
+				assert(indexedKeyBlock.GetKeyIndexFromString(svTestKeys.GetAt(nKey).GetValue()) ==
+				       nKeyIndex);
 			}
 		}
 		timer.Stop();
@@ -59,6 +59,8 @@ public:
 	void Clean() override;
 
 	// Indexation des cles pour preparer l'acces efficace
+	// Construit une table de hashage des cles par leur valeur chaine de caracteres,
+	// permettant l'acces aux index de cle lors de la lecture des champs sans creation de Symbol
 	boolean IndexKeys() override;
 
 	//////////////////////////////////////////////////////////////////
@@ -66,6 +68,7 @@ public:
 
 	// Ajout d'une cle (ne doit pas etre presente ni vide)
 	// Les cles doivent etre inserees dans le bon ordre
+	// L'ajout d'une cle invalide l'indexation des cles
 	void AddKey(const Symbol& sKey);
 
 	// Test de presence d'une cle
@@ -83,6 +86,11 @@ public:
 	// Acces aux cles par index (entre 0 et KeyNumber)
 	Symbol& GetKeyAt(int nIndex) const;
 
+	// Acces a l'index associe a une cle donnee sous forme chaine de caracteres (-1 si cle absente)
+	// Evite la creation d'un Symbol pour chaque cle lue, notamment pour les cles absentes du bloc
+	// Methode efficace si les cles ont ete indexees, sinon passage par un Symbol
+	int GetKeyIndexFromString(const char* sKey) const;
+
 	////////////////////////////////////////////////////////////////
 	// Services divers
 
@@ -109,6 +117,12 @@ protected:
 	// Tableau et dictionnaire des paires (index, cles) contenant des KWKeyIndex
 	ObjectArray oaKeyIndexes;
 	NumericKeyDictionary nkdKeyIndexes;
+
+	// Table de hashage a adressage ouvert des cles par leur valeur chaine de caracteres, calculee lors de
+	// l'indexation des cles, et vide sinon
+	// La taille de la table est une puissance de 2 au moins double du nombre de cles, et chaque case contient
+	// l'index de la cle plus un, ou 0 pour une case vide
+	IntVector ivKeyHashTable;
 };
 
 //////////////////////////////////////////////////////////////////
@@ -4,6 +4,11 @@
 
 #include "KWObject.h"
 
+boolean KWObject::bValueVectorRecycling = false;
+int KWObject::nRecycledValueVectorNumber = 0;
+int KWObject::nRecycledValueVectorSizes[KWObject::nMaxRecycledValueVectorNumber];
+KWObject::ObjectValues KWObject::recycledValueVectors[KWObject::nMaxRecycledValueVectorNumber];
+
 KWObject::KWObject(const KWClass* kwcNew, longint lIndex)
 {
 	require(kwcNew != NULL);
@@ -1878,63 +1883,130 @@ KWObject::ObjectValues KWObject::NewValueVector(int nSize)
 
 	require(nSize > 0);
 
-	// Cas mono-block
-	if (nSize <= nBlockSize)
+	// Recherche d'un vecteur de meme taille en attente de recyclage, en partant du plus recent
+	for (i = nRecycledValueVectorNumber - 1; i >= 0; i--)
 	{
-		newValues.attributeValues = (KWValue*)NewMemoryBlock(nSize * sizeof(KWValue));
+		if (nRecycledValueVectorSizes[i] == nSize)
+		{
+			newValues = recycledValueVectors[i];
+
+			// On comble le trou avec le dernier vecteur de la pile
+			nRecycledValueVectorNumber--;
+			recycledValueVectors[i] = recycledValueVectors[nRecycledValueVectorNumber];
+			nRecycledValueVectorSizes[i] = nRecycledValueVectorSizes[nRecycledValueVectorNumber];
 
-		// Initialisation des valeurs a 0 (compatible avec KWType)
-		memset(newValues.attributeValues, 0, nSize * sizeof(KWValue));
+			// Reinitialisation des valeurs
+			ResetValueVector(newValues, nSize);
+			return newValues;
+		}
 	}
+
+	// Cas mono-block
+	if (nSize <= nBlockSize)
+		newValues.attributeValues = (KWValue*)NewMemoryBlock(nSize * sizeof(KWValue));
 	// Cas multi-block
 	else
 	{
 		nBlockNumber = (nSize - 1) / nBlockSize + 1;
 		newValues.attributeValueArrays = (KWValue**)NewMemoryBlock(nBlockNumber * sizeof(KWValue*));
 		for (i = nBlockNumber - 2; i >= 0; i--)
-		{
 			newValues.attributeValueArrays[i] = (KWValue*)NewMemoryBlock(nBlockSize * sizeof(KWValue));
-			memset(newValues.attributeValueArrays[i], 0, nBlockSize * sizeof(KWValue));
-		}
 		if (nSize % nBlockSize > 0)
-		{
 			newValues.attributeValueArrays[nBlockNumber - 1] =
 			    (KWValue*)NewMemoryBlock((nSize % nBlockSize) * sizeof(KWValue));
-			memset(newValues.attributeValueArrays[nBlockNumber - 1], 0,
-			       (nSize % nBlockSize) * sizeof(KWValue));
-		}
 		else
-		{
 			newValues.attributeValueArrays[nBlockNumber - 1] =
 			    (KWValue*)NewMemoryBlock(nBlockSize * sizeof(KWValue));
-			memset(newValues.attributeValueArrays[nBlockNumber - 1], 0, nBlockSize * sizeof(KWValue));
-		}
 	}
 
+	// Initialisation des valeurs a 0
+	ResetValueVector(newValues, nSize);
+
 	ensure(newValues.attributeValues != NULL);
 	return newValues;
 }
 
 void KWObject::DeleteValueVector(ObjectValues valuesToDelete, int nSize)
+{
+	require(valuesToDelete.attributeValues != NULL);
+	require(nSize > 0);
+
+	// Memorisation pour recyclage si possible, liberation sinon
+	if (bValueVectorRecycling and nRecycledValueVectorNumber < nMaxRecycledValueVectorNumber)
+	{
+		recycledValueVectors[nRecycledValueVectorNumber] = valuesToDelete;
+		nRecycledValueVectorSizes[nRecycledValueVectorNumber] = nSize;
+		nRecycledValueVectorNumber++;
+	}
+	else
+		FreeValueVector(valuesToDelete, nSize);
+}
+
+void KWObject::ResetValueVector(ObjectValues valuesToReset, int nSize)
+{
+	int nBlockNumber;
+	int i;
+
+	require(valuesToReset.attributeValues != NULL);
+	require(nSize > 0);
+
+	// Cas mono-block
+	if (nSize <= nBlockSize)
+		memset(valuesToReset.attributeValues, 0, nSize * sizeof(KWValue));
+	// Cas multi-block
+	else
+	{
+		nBlockNumber = (nSize - 1) / nBlockSize + 1;
+		for (i = nBlockNumber - 2; i >= 0; i--)
+			memset(valuesToReset.attributeValueArrays[i], 0, nBlockSize * sizeof(KWValue));
+		if (nSize % nBlockSize > 0)
+			memset(valuesToReset.attributeValueArrays[nBlockNumber - 1], 0,
+			       (nSize % nBlockSize) * sizeof(KWValue));
+		else
+			memset(valuesToReset.attributeValueArrays[nBlockNumber - 1], 0, nBlockSize * sizeof(KWValue));
+	}
+}
+
+void KWObject::FreeValueVector(ObjectValues valuesToFree, int nSize)
 {
 	int i;
 	int nBlockNumber;
 
-	require(valuesToDelete.attributeValues != NULL);
+	require(valuesToFree.attributeValues != NULL);
 	require(nSize > 0);
 
 	// Desallocation
 	if (nSize <= nBlockSize)
 	{
-		DeleteMemoryBlock(valuesToDelete.attributeValues);
+		DeleteMemoryBlock(valuesToFree.attributeValues);
 	}
 	else
 	{
 		nBlockNumber = (nSize - 1) / nBlockSize + 1;
 		for (i = nBlockNumber - 1; i >= 0; i--)
-			DeleteMemoryBlock(valuesToDelete.attributeValueArrays[i]);
-		DeleteMemoryBlock(valuesToDelete.attributeValueArrays);
+			DeleteMemoryBlock(valuesToFree.attributeValueArrays[i]);
+		DeleteMemoryBlock(valuesToFree.attributeValueArrays);
+	}
+}
+
+void KWObject::SetValueVectorRecycling(boolean bValue)
+{
+	// Liberation des vecteurs en attente de recyclage lors de la desactivation
+	if (not bValue)
+	{
+		while (nRecycledValueVectorNumber > 0)
+		{
+			nRecycledValueVectorNumber--;
+			FreeValueVector(recycledValueVectors[nRecycledValueVectorNumber],
+					nRecycledValueVectorSizes[nRecycledValueVectorNumber]);
+		}
 	}
+	bValueVectorRecycling = bValue;
+}
+
+boolean KWObject::GetValueVectorRecycling()
+{
+	return bValueVectorRecycling;
 }
 
 int KWObjectCompareCreationIndex(const void* elem1, const void* elem2)
@@ -192,6 +192,16 @@ public:
 	// Des sous-objet inclus sont egalement crees
 	static KWObject* CreateObject(KWClass* refClass, longint lObjectIndex);
 
+	// Recyclage des vecteurs de valeurs des objets detruits, pour les reutiliser lors de la creation
+	// des objets suivants de meme taille, sans passer par l'allocateur (utile lors des lectures
+	// enregistrement par enregistrement, notamment pour les classes de grande taille dont les
+	// vecteurs multi-blocs sont alloues par le systeme)
+	// Seuls les objets effectivement detruits alimentent le recyclage: les objets conserves par
+	// l'appelant ne sont pas concernes
+	// Par defaut: false; la desactivation libere les vecteurs en attente de recyclage
+	static void SetValueVectorRecycling(boolean bValue);
+	static boolean GetValueVectorRecycling();
+
 	// Fonction de test de la classe KWObject
 	static void Test();
 
@@ -293,6 +303,19 @@ protected:
 	ObjectValues NewValueVector(int nSize);
 	void DeleteValueVector(ObjectValues valuesToDelete, int nSize);
 
+	// Initialisation des valeurs a 0 (compatible avec KWType)
+	static void ResetValueVector(ObjectValues valuesToReset, int nSize);
+
+	// Liberation effective d'un vecteur de valeurs
+	static void FreeValueVector(ObjectValues valuesToFree, int nSize);
+
+	// Vecteurs de valeurs en attente de recyclage, geres en pile, avec leur taille
+	static const int nMaxRecycledValueVectorNumber = 64;
+	static boolean bValueVectorRecycling;
+	static int nRecycledValueVectorNumber;
+	static int nRecycledValueVectorSizes[nMaxRecycledValueVectorNumber];
+	static ObjectValues recycledValueVectors[nMaxRecycledValueVectorNumber];
+
 	// Acces a une valeur par index
 	// Une valeur peut etre une valeur dense ou un block
 	KWValue& GetAt(int nValueIndex) const;
@@ -414,10 +437,11 @@ inline Continuous KWObject::ComputeContinuousValueAt(KWLoadIndex liLoadIndex) co
 			attributeBlock = kwcClass->GetAttributeBlockAtLoadIndex(liLoadIndex);
 			assert(attributeBlock->GetDerivationRule() != NULL);
 
-			// Derivation
+			// Derivation, avec stockage du bloc sous forme compacte si possible
 			cvbValue = attributeBlock->GetDerivationRule()->ComputeContinuousValueBlockResult(
 			    this, attributeBlock->GetLoadedAttributesIndexedKeyBlock());
 			check(cvbValue);
+			cvbValue = KWContinuousValueBlock::Compact(cvbValue);
 			GetAt(liLoadIndex.GetDenseIndex()).SetContinuousValueBlock(cvbValue);
 
 			// Verification de la valeur de l'attribut derive
@@ -1007,10 +1031,11 @@ inline KWContinuousValueBlock* KWObject::ComputeContinuousValueBlockAt(KWLoadInd
 		attributeBlock = kwcClass->GetAttributeBlockAtLoadIndex(liLoadIndex);
 		assert(attributeBlock->GetDerivationRule() != NULL);
 
-		// Derivation
+		// Derivation, avec stockage du bloc sous forme compacte si possible
 		cvbValue = attributeBlock->GetDerivationRule()->ComputeContinuousValueBlockResult(
 		    this, attributeBlock->GetLoadedAttributesIndexedKeyBlock());
 		check(cvbValue);
+		cvbValue = KWContinuousValueBlock::Compact(cvbValue);
 		GetAt(liLoadIndex.GetDenseIndex()).SetContinuousValueBlock(cvbValue);
 
 		// Verification de la valeur de l'attribut derive
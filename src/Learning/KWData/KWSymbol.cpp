@@ -47,8 +47,9 @@ longint Symbol::GetAllSymbolsUsedMemory()
 longint Symbol::GetUsedMemoryPerSymbol()
 {
 	longint lUsedMemory;
-	// On compte la taille pour le Symbol, plus un pointeur dans la table de hashage du dictionnairee de symboles
-	lUsedMemory = sizeof(KWSymbolDataPtr) + sizeof(KWSymbolData);
+	// On compte la taille pour le Symbol, plus un emplacement dans la table de hashage du dictionnaire de symboles
+	// (pointeur, valeur de hashage et octet de controle)
+	lUsedMemory = sizeof(KWSymbolDataPtr) + sizeof(UINT) + 1 + sizeof(KWSymbolData);
 	return lUsedMemory;
 }
 
@@ -475,7 +476,6 @@ KWSymbolData* KWSymbolData::InitStarValue()
 	KWSymbolDataStarValue.lRefCount = 1;
 	KWSymbolDataStarValue.nHashValue = 0;
 	KWSymbolDataStarValue.nLength = nStarValueLength;
-	KWSymbolDataStarValue.pNext = NULL;
 	assert(strlen(sStar) == nStarValueLength);
 	assert(nStarValueLength < KWSymbolData::nMinStringSize);
 	memcpy(&(KWSymbolDataStarValue.cFirstStringChar), sStar, nStarValueLength);
@@ -517,7 +517,10 @@ inline void KWSymbolData::DeleteSymbolData(KWSymbolData* pSymbolData)
 
 KWSymbolDictionary::KWSymbolDictionary()
 {
+	pGroupBlocks = NULL;
+	nGroupNumber = 0;
 	m_nCount = 0;
+	nDeletedSlotNumber = 0;
 }
 
 UINT KWSymbolDictionary::HashKey(const char* key) const
@@ -525,75 +528,106 @@ UINT KWSymbolDictionary::HashKey(const char* key) const
 	UINT nHash = 0;
 	while (*key)
 		nHash = (nHash << 5) + nHash + *key++;
+
+	// Melange final des bits, pour que les bits de poids faible utilises pour l'adressage des groupes
+	// et les 7 bits des octets de controle soient bien repartis
+	nHash ^= nHash >> 16;
+	nHash *= 0x85ebca6b;
+	nHash ^= nHash >> 13;
+	nHash *= 0xc2b2ae35;
+	nHash ^= nHash >> 16;
 	return nHash;
 }
 
-void KWSymbolDictionary::InitHashTable(int nHashSize)
+int KWSymbolDictionary::ComputeGroupNumber(int nSymbolNumber)
 {
-	assert(m_nCount == 0);
-	assert(nHashSize > 0);
+	const int nMaxGroupNumber = INT_MAX / (2 * nGroupSize);
+	int nNewGroupNumber;
+
+	require(nSymbolNumber >= 0);
+
+	// Recherche de la plus petite puissance de 2 permettant un taux de remplissage d'au plus 7/8
+	nNewGroupNumber = 1;
+	while (nNewGroupNumber < nMaxGroupNumber and (nNewGroupNumber * (longint)nGroupSize * 7) / 8 < nSymbolNumber)
+		nNewGroupNumber *= 2;
+	return nNewGroupNumber;
+}
 
-	pvSymbolDatas.SetSize(nHashSize);
+void KWSymbolDictionary::InitHashTable(int nNewGroupNumber)
+{
+	int nBlockNumber;
+	int nBlock;
+	int nBlockGroupNumber;
+	int nGroup;
+
+	require(pGroupBlocks == NULL);
+	require(nNewGroupNumber > 0);
+	require((nNewGroupNumber & (nNewGroupNumber - 1)) == 0);
+
+	// Allocation des blocs de groupes
+	nBlockNumber = (nNewGroupNumber + nGroupBlockSize - 1) / nGroupBlockSize;
+	pGroupBlocks = new SlotGroup*[nBlockNumber];
+	for (nBlock = 0; nBlock < nBlockNumber; nBlock++)
+	{
+		nBlockGroupNumber = nNewGroupNumber - nBlock * nGroupBlockSize;
+		if (nBlockGroupNumber > nGroupBlockSize)
+			nBlockGroupNumber = nGroupBlockSize;
+		pGroupBlocks[nBlock] = new SlotGroup[nBlockGroupNumber];
+
+		// Initialisation de tous les emplacements a vide
+		for (nGroup = 0; nGroup < nBlockGroupNumber; nGroup++)
+			pGroupBlocks[nBlock][nGroup].lControls = 0x0101010101010101ULL * cEmptyControl;
+	}
+	nGroupNumber = nNewGroupNumber;
+	nDeletedSlotNumber = 0;
 }
 
-void KWSymbolDictionary::ReinitHashTable(int nNewHashSize)
+void KWSymbolDictionary::ReinitHashTable(int nNewGroupNumber)
 {
 	boolean bDisplay = false;
 	Timer timer;
-	int i;
-	int nHashPosition;
-	KWSymbolDataPtr pSymbolData;
-	KWSymbolDataPtr pSymbolDataNext;
-	KWSymbolDataPtr pAllSymbolDatas;
+	SlotGroup** pOldGroupBlocks;
+	int nOldGroupNumber;
+	int nGroup;
+	int nIndex;
+	SlotGroup* group;
+	unsigned long long lFullMask;
+
+	require(nNewGroupNumber > 0);
+	require(GetCount() <= (nNewGroupNumber * (longint)nGroupSize * 7) / 8);
 
 	// Affichage du debut de la methode
 	if (bDisplay)
 	{
-		cout << "Symbol ReinitHashTable (" << GetCount() << "," << GetHashTableSize() << ")";
-		cout << " -> " << nNewHashSize << ": " << flush;
+		cout << "Symbol ReinitHashTable (" << GetCount() << "," << GetSlotNumber() << ")";
+		cout << " -> " << nNewGroupNumber * nGroupSize << ": " << flush;
 		timer.Start();
 	}
 
-	// Memorisation de tous les symboles dans une liste chainee
-	pAllSymbolDatas = NULL;
-	for (i = 0; i < pvSymbolDatas.GetSize(); i++)
+	// Creation d'une nouvelle table, en memorisant l'ancienne
+	pOldGroupBlocks = pGroupBlocks;
+	nOldGroupNumber = nGroupNumber;
+	pGroupBlocks = NULL;
+	InitHashTable(nNewGroupNumber);
+
+	// On reinsere tous les symboles dans la nouvelle table, en reutilisant leur valeur de hashage
+	for (nGroup = 0; nGroup < nOldGroupNumber; nGroup++)
 	{
-		// Acces au symbole courant
-		pSymbolData = (KWSymbolDataPtr)pvSymbolDatas.GetAt(i);
-		if (pSymbolData != NULL)
+		group = &pOldGroupBlocks[nGroup >> nGroupBlockSizeLog2][nGroup & (nGroupBlockSize - 1)];
+		lFullMask = ~MatchEmptyOrDeleted(group->lControls) & 0x8080808080808080ULL;
+		while (lFullMask != 0)
 		{
-			// On met a NULL la position correspondante
-			pvSymbolDatas.SetAt(i, NULL);
-
-			// On recherche le dernier symbole chaine
-			pSymbolDataNext = pSymbolData;
-			while (pSymbolDataNext->pNext != NULL)
-				pSymbolDataNext = pSymbolDataNext->pNext;
-
-			// On chaine avec la liste de tous les symboles
-			pSymbolDataNext->pNext = pAllSymbolDatas;
-			pAllSymbolDatas = pSymbolData;
+			nIndex = GetFirstMatchIndex(lFullMask);
+			InsertSymbolData(group->symbolDatas[nIndex], group->nHashes[nIndex]);
+			lFullMask &= lFullMask - 1;
 		}
 	}
 
-	// Retaillage de la table de hashage
-	pvSymbolDatas.SetSize(nNewHashSize);
-
-	// On reinsere tous les symbole dans la nouvelle taille de hashage
-	pSymbolData = pAllSymbolDatas;
-	while (pSymbolData != NULL)
-	{
-		// Sauvegarde du suivant
-		pSymbolDataNext = pSymbolData->pNext;
-
-		// Reconversion de pSymbolData, vers la nouvelle table de hashage
-		nHashPosition = pSymbolData->nHashValue % nNewHashSize;
-		pSymbolData->pNext = (KWSymbolDataPtr)pvSymbolDatas.GetAt(nHashPosition);
-		pvSymbolDatas.SetAt(nHashPosition, pSymbolData);
-
-		// Passage au suivant
-		pSymbolData = pSymbolDataNext;
-	}
+	// Destruction de l'ancienne table
+	for (nGroup = 0; nGroup < nOldGroupNumber; nGroup += nGroupBlockSize)
+		delete[] pOldGroupBlocks[nGroup >> nGroupBlockSizeLog2];
+	if (pOldGroupBlocks != NULL)
+		delete[] pOldGroupBlocks;
 
 	// Affichage de la fin de la methode
 	if (bDisplay)
@@ -603,6 +637,20 @@ void KWSymbolDictionary::ReinitHashTable(int nNewHashSize)
 	}
 }
 
+void KWSymbolDictionary::DeleteHashTable()
+{
+	int nGroup;
+
+	// Destruction des blocs de groupes
+	for (nGroup = 0; nGroup < nGroupNumber; nGroup += nGroupBlockSize)
+		delete[] pGroupBlocks[nGroup >> nGroupBlockSizeLog2];
+	if (pGroupBlocks != NULL)
+		delete[] pGroupBlocks;
+	pGroupBlocks = NULL;
+	nGroupNumber = 0;
+	nDeletedSlotNumber = 0;
+}
+
 void KWSymbolDictionary::ShowAllocErrorMessage(KWSymbolDataPtr symbolData, int nMessageIndex)
 {
 	const int nMaxMessageNumber = 20;
@@ -625,9 +673,10 @@ void KWSymbolDictionary::RemoveAll()
 {
 	boolean bShowAllocErrorMessages;
 	ALString sUserName;
-	int nHashPosition;
+	int nGroup;
+	SlotGroup* group;
+	unsigned long long lFullMask;
 	KWSymbolDataPtr pSymbolData;
-	KWSymbolDataPtr pSymbolDataNext;
 	int nMessageIndex;
 
 	// Recherche des variables d'environnement
@@ -645,14 +694,15 @@ void KWSymbolDictionary::RemoveAll()
 	// d'erreur fatale A reactiver si necessaire
 	bShowAllocErrorMessages = false;
 
-	// Nettoyage des cles de la table de hashage
+	// Nettoyage des symboles de la table de hashage
 	nMessageIndex = 0;
-	for (nHashPosition = 0; nHashPosition < pvSymbolDatas.GetSize(); nHashPosition++)
+	for (nGroup = 0; nGroup < nGroupNumber; nGroup++)
 	{
-		for (pSymbolData = (KWSymbolDataPtr)pvSymbolDatas.GetAt(nHashPosition); pSymbolData != NULL;)
+		group = GetGroupAt(nGroup);
+		lFullMask = ~MatchEmptyOrDeleted(group->lControls) & 0x8080808080808080ULL;
+		while (lFullMask != 0)
 		{
-			// Sauvegarde du suivant
-			pSymbolDataNext = pSymbolData->pNext;
+			pSymbolData = group->symbolDatas[GetFirstMatchIndex(lFullMask)];
 
 			// Affichage des informations sur le symbole non libere
 			if (bShowAllocErrorMessages)
@@ -667,7 +717,7 @@ void KWSymbolDictionary::RemoveAll()
 			debug(assert(m_nCount >= 0));
 
 			// Passage au suivant
-			pSymbolData = pSymbolDataNext;
+			lFullMask &= lFullMask - 1;
 		}
 	}
 
@@ -682,8 +732,8 @@ void KWSymbolDictionary::RemoveAll()
 		}
 	}
 
-	// Reinitialisation du tableau de symbole
-	pvSymbolDatas.SetSize(0);
+	// Reinitialisation de la table de symboles
+	DeleteHashTable();
 	m_nCount = 0;
 }
 
@@ -695,36 +745,94 @@ KWSymbolDictionary::~KWSymbolDictionary()
 
 KWSymbolDataPtr KWSymbolDictionary::GetSymbolDataAt(const char* key, UINT& nHash) const
 {
-	KWSymbolDataPtr pSymbolData;
-	int nHashPosition;
+	SlotGroup* group;
+	int nGroupMask;
+	int nGroup;
+	int nProbe;
+	int nIndex;
+	unsigned long long lMatchMask;
 
 	require(key != NULL);
 
+	// Calcul de la cle, independante de la taille de la table de hashage
+	nHash = HashKey(key);
+
 	// Cas particulier d'un dictionnaire vide
-	if (pvSymbolDatas.GetSize() == 0)
+	if (nGroupNumber == 0)
 	{
 		assert(m_nCount == 0);
-
-		// Calcul de sa cle par rapport a la premiere taille de dictionnaire
-		nHash = HashKey(key);
 		return NULL;
 	}
 
-	// Calcul de la cle par rapport a la taille courante de la table de hashage
-	nHash = HashKey(key);
-
-	// Regarde si la cle existe
-	nHashPosition = nHash % GetHashTableSize();
-	for (pSymbolData = (KWSymbolDataPtr)pvSymbolDatas.GetAt(nHashPosition); pSymbolData != NULL;
-	     pSymbolData = pSymbolData->pNext)
+	// Parcours des groupes selon la sequence de recherche de la cle
+	nGroupMask = nGroupNumber - 1;
+	nGroup = (int)(nHash >> 7) & nGroupMask;
+	nProbe = 0;
+	while (true)
 	{
-		assert(pSymbolData->GetString() != NULL);
+		group = GetGroupAt(nGroup);
+
+		// Test des emplacements dont l'octet de controle correspond a la cle
+		lMatchMask = MatchControl(group->lControls, nHash & 0x7F);
+		while (lMatchMask != 0)
+		{
+			nIndex = GetFirstMatchIndex(lMatchMask);
+			if (group->nHashes[nIndex] == nHash)
+			{
+				assert(group->symbolDatas[nIndex]->GetString() != NULL);
+
+				// Test de la valeur exacte de la string
+				if (strcmp(group->symbolDatas[nIndex]->GetString(), key) == 0)
+					return group->symbolDatas[nIndex];
+			}
+			lMatchMask &= lMatchMask - 1;
+		}
+
+		// Arret si le groupe contient un emplacement vide
+		if (MatchEmpty(group->lControls) != 0)
+			return NULL;
 
-		// Test de la valeur exacte de la string
-		if (strcmp(pSymbolData->GetString(), key) == 0)
-			return pSymbolData;
+		// Passage au groupe suivant
+		nProbe++;
+		assert(nProbe < nGroupNumber);
+		nGroup = (nGroup + nProbe) & nGroupMask;
 	}
-	return NULL;
+}
+
+void KWSymbolDictionary::InsertSymbolData(KWSymbolDataPtr symbolData, UINT nHash)
+{
+	SlotGroup* group;
+	int nGroupMask;
+	int nGroup;
+	int nProbe;
+	int nIndex;
+	unsigned long long lAvailableMask;
+
+	require(symbolData != NULL);
+	require(nGroupNumber > 0);
+
+	// Recherche du premier groupe de la sequence de recherche ayant un emplacement disponible
+	nGroupMask = nGroupNumber - 1;
+	nGroup = (int)(nHash >> 7) & nGroupMask;
+	nProbe = 0;
+	group = GetGroupAt(nGroup);
+	lAvailableMask = MatchEmptyOrDeleted(group->lControls);
+	while (lAvailableMask == 0)
+	{
+		nProbe++;
+		assert(nProbe < nGroupNumber);
+		nGroup = (nGroup + nProbe) & nGroupMask;
+		group = GetGroupAt(nGroup);
+		lAvailableMask = MatchEmptyOrDeleted(group->lControls);
+	}
+
+	// Memorisation du symbole dans le premier emplacement disponible du groupe
+	nIndex = GetFirstMatchIndex(lAvailableMask);
+	if (((group->lControls >> (8 * nIndex)) & 0xFF) == cDeletedControl)
+		nDeletedSlotNumber--;
+	SetControlAt(group, nIndex, nHash & 0x7F);
+	group->nHashes[nIndex] = nHash;
+	group->symbolDatas[nIndex] = symbolData;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -739,7 +847,6 @@ KWSymbolDataPtr KWSymbolDictionary::Lookup(const char* key) const
 KWSymbolDataPtr KWSymbolDictionary::AsSymbol(const char* key, int nLength)
 {
 	UINT nHash;
-	int nHashPosition;
 	KWSymbolDataPtr pSymbolData;
 
 	require(key != NULL);
@@ -748,11 +855,15 @@ KWSymbolDataPtr KWSymbolDictionary::AsSymbol(const char* key, int nLength)
 	pSymbolData = GetSymbolDataAt(key, nHash);
 	if (pSymbolData == NULL)
 	{
-		if (pvSymbolDatas.GetSize() == 0)
+		if (nGroupNumber == 0)
 		{
 			assert(m_nCount == 0);
-			InitHashTable(DictionaryGetNextTableSize(1));
+			InitHashTable(ComputeGroupNumber(1));
 		}
+		// Retaillage dynamique si le taux de remplissage, y compris les emplacements liberes, devient trop grand
+		// Si les emplacements liberes sont nombreux, il suffit de reconstruire la table a taille identique
+		else if (m_nCount + nDeletedSlotNumber >= (GetSlotNumber() * (longint)7) / 8)
+			ReinitHashTable(ComputeGroupNumber(2 * (m_nCount + 1)));
 
 		// Creation d'un nouveau Symbol
 		pSymbolData = KWSymbolData::NewSymbolData(key, nLength);
@@ -761,89 +872,113 @@ KWSymbolDataPtr KWSymbolDictionary::AsSymbol(const char* key, int nLength)
 		assert(m_nCount > 0);
 
 		// Ajout dans la table de hashage
-		nHashPosition = nHash % GetHashTableSize();
-		pSymbolData->pNext = (KWSymbolDataPtr)pvSymbolDatas.GetAt(nHashPosition);
-		pvSymbolDatas.SetAt(nHashPosition, pSymbolData);
-
-		// Retaillage dynamique
-		if (GetCount() > GetHashTableSize() / 2 and GetHashTableSize() < INT_MAX)
-			ReinitHashTable(DictionaryGetNextTableSize(2 * min(GetHashTableSize(), INT_MAX / 2)));
+		InsertSymbolData(pSymbolData, nHash);
 	}
 	return pSymbolData;
 }
 
 void KWSymbolDictionary::RemoveSymbol(KWSymbolDataPtr symbolData)
 {
-	KWSymbolDataPtr pHeadSymbolData;
-	KWSymbolDataPtr pSymbolDataPrev;
-	int nHashPosition;
+	SlotGroup* group;
+	int nGroupMask;
+	int nGroup;
+	int nProbe;
+	int nIndex;
+	unsigned long long lMatchMask;
 
 	require(symbolData != NULL);
 	require(Lookup(symbolData->GetString()) == symbolData);
 
-	// Recherche du premier element de la table de hashage correspondant a la cle
-	nHashPosition = symbolData->nHashValue % GetHashTableSize();
-	pHeadSymbolData = (KWSymbolDataPtr)pvSymbolDatas.GetAt(nHashPosition);
+	// Recherche de l'emplacement du symbole, selon la sequence de recherche de sa valeur de hashage
+	group = NULL;
+	nGroupMask = nGroupNumber - 1;
+	nGroup = (int)(symbolData->nHashValue >> 7) & nGroupMask;
+	nProbe = 0;
+	nIndex = -1;
+	while (true)
+	{
+		group = GetGroupAt(nGroup);
+		lMatchMask = MatchControl(group->lControls, symbolData->nHashValue & 0x7F);
+		while (lMatchMask != 0)
+		{
+			nIndex = GetFirstMatchIndex(lMatchMask);
+			if (group->symbolDatas[nIndex] == symbolData)
+				break;
+			lMatchMask &= lMatchMask - 1;
+		}
+		if (lMatchMask != 0)
+			break;
 
-	// Cas de la tete de liste
-	if (pHeadSymbolData == symbolData)
-		pvSymbolDatas.SetAt(nHashPosition, pHeadSymbolData->pNext);
-	// Cas hors tete de liste
+		// Passage au groupe suivant
+		nProbe++;
+		assert(nProbe < nGroupNumber);
+		nGroup = (nGroup + nProbe) & nGroupMask;
+	}
+	assert(group->symbolDatas[nIndex] == symbolData);
+
+	// Liberation de l'emplacement
+	// Si le groupe contient deja un emplacement vide, aucune recherche ne se poursuit au dela de ce groupe,
+	// et l'emplacement peut redevenir vide. Sinon, on le marque comme libere pour ne pas interrompre
+	// les recherches des autres symboles.
+	if (MatchEmpty(group->lControls) != 0)
+		SetControlAt(group, nIndex, cEmptyControl);
 	else
 	{
-		// Parcours de la liste pour rechercher l'element
-		pSymbolDataPrev = pHeadSymbolData;
-		while (pSymbolDataPrev->pNext != symbolData)
-			pSymbolDataPrev = pSymbolDataPrev->pNext;
-
-		// Rechainage en derefencant l'element a supprimer
-		pSymbolDataPrev->pNext = pSymbolDataPrev->pNext->pNext;
+		SetControlAt(group, nIndex, cDeletedControl);
+		nDeletedSlotNumber++;
 	}
+	group->symbolDatas[nIndex] = NULL;
 
-	// Supression de l'element dereference de la table de hashage
+	// Supression du symbole
 	KWSymbolData::DeleteSymbolData(symbolData);
 	m_nCount--;
 	assert(m_nCount >= 0);
 
 	// Retaillage dynamique pour recuperer la memoire inutilisee
-	if (GetCount() > 20 and GetCount() < GetHashTableSize() / 8)
-		ReinitHashTable(DictionaryGetNextTableSize(2 * GetCount()));
+	if (GetCount() > 20 and GetCount() < GetSlotNumber() / 16)
+		ReinitHashTable(ComputeGroupNumber(2 * GetCount()));
 }
 
 void KWSymbolDictionary::GetNextSymbolData(POSITION& rNextPosition, KWSymbolDataPtr& sSymbol) const
 {
-	KWSymbolDataPtr pSymbolDataRet;
-	int nBucket;
-	KWSymbolDataPtr pSymbolDataNext;
+	int nSlot;
+	int nNextSlot;
+	SlotGroup* group;
 
-	require(pvSymbolDatas.GetSize() != 0);
+	require(nGroupNumber != 0);
 	require(rNextPosition != NULL);
 
-	pSymbolDataRet = (KWSymbolDataPtr)rNextPosition;
-	assert(pSymbolDataRet != NULL);
+	// La position est l'index de l'emplacement plus un, pour ne pas confondre le premier emplacement avec NULL
+	if (rNextPosition == BEFORE_START_POSITION)
+		nSlot = 0;
+	else
+		nSlot = (int)((longint)rNextPosition - 1);
 
-	if (pSymbolDataRet == (KWSymbolDataPtr)BEFORE_START_POSITION)
+	// Recherche du Symbol courant, a partir de la position
+	group = NULL;
+	while (nSlot < GetSlotNumber())
 	{
-		// Recherche du premier Symbol
-		for (nBucket = 0; nBucket < pvSymbolDatas.GetSize(); nBucket++)
-			if ((pSymbolDataRet = (KWSymbolDataPtr)pvSymbolDatas.GetAt(nBucket)) != NULL)
-				break;
-		assert(pSymbolDataRet != NULL);
+		group = GetGroupAt(nSlot / nGroupSize);
+		if (((group->lControls >> (8 * (nSlot % nGroupSize))) & 0x80) == 0)
+			break;
+		nSlot++;
 	}
+	assert(nSlot < GetSlotNumber());
+	sSymbol = group->symbolDatas[nSlot % nGroupSize];
 
 	// Recherche du Symbol suivant
-	if ((pSymbolDataNext = pSymbolDataRet->pNext) == NULL)
+	nNextSlot = nSlot + 1;
+	while (nNextSlot < GetSlotNumber())
 	{
-		// Passage au prochain bucket
-		for (nBucket = (pSymbolDataRet->nHashValue % GetHashTableSize()) + 1; nBucket < pvSymbolDatas.GetSize();
-		     nBucket++)
-			if ((pSymbolDataNext = (KWSymbolDataPtr)pvSymbolDatas.GetAt(nBucket)) != NULL)
-				break;
+		group = GetGroupAt(nNextSlot / nGroupSize);
+		if (((group->lControls >> (8 * (nNextSlot % nGroupSize))) & 0x80) == 0)
+			break;
+		nNextSlot++;
 	}
-	rNextPosition = (POSITION)pSymbolDataNext;
-
-	// Initialisation du resultat
-	sSymbol = pSymbolDataRet;
+	if (nNextSlot < GetSlotNumber())
+		rNextPosition = (POSITION)((longint)nNextSlot + 1);
+	else
+		rNextPosition = NULL;
 }
 
 longint KWSymbolDictionary::GetUsedMemory() const
@@ -854,14 +989,15 @@ longint KWSymbolDictionary::GetUsedMemory() const
 
 	// Initialisation de la taille memoire utilisee
 	lUsedMemory = sizeof(KWSymbolDictionary);
-	lUsedMemory += pvSymbolDatas.GetSize() * sizeof(void*);
+	lUsedMemory += nGroupNumber * (longint)sizeof(SlotGroup);
+	lUsedMemory += ((nGroupNumber + nGroupBlockSize - 1) / nGroupBlockSize) * (longint)sizeof(SlotGroup*);
 
 	// A jout de la memoire pour tous les symbols
 	current = GetStartPosition();
 	while (current != NULL)
 	{
 		GetNextSymbolData(current, sElement);
-		lUsedMemory += sizeof(KWSymbolDataPtr) + sizeof(KWSymbolData) + sElement->GetLength();
+		lUsedMemory += sizeof(KWSymbolData) + sElement->GetLength();
 	}
 	return lUsedMemory;
 }
@@ -908,6 +1044,7 @@ void KWSymbolDictionary::Test()
 	int nI;
 	int nMaxSize;
 	int nNbIter;
+	int nFoundNumber;
 	clock_t tStartClock;
 	clock_t tStopClock;
 
@@ -933,6 +1070,27 @@ void KWSymbolDictionary::Test()
 		     << "): " << (sdTest.Lookup(svArray.GetAt(nI)) != NULL) << "\n";
 	}
 
+	//
+	cout << "\tInsertion of 10000 KWSymbolDataPtrs, and removal of one out of two\n";
+	for (nI = 0; nI < 10000; nI++)
+	{
+		sPerf = IntToString(nI);
+		sdTest.AsSymbol(sPerf, sPerf.GetLength());
+	}
+	for (nI = 0; nI < 10000; nI += 2)
+	{
+		sPerf = IntToString(nI);
+		sdTest.RemoveSymbol(sdTest.Lookup(sPerf));
+	}
+	nFoundNumber = 0;
+	for (nI = 0; nI < 10000; nI++)
+	{
+		sPerf = IntToString(nI);
+		if (sdTest.Lookup(sPerf) != NULL)
+			nFoundNumber++;
+	}
+	cout << "\t\tCount: " << sdTest.GetCount() << ", found: " << nFoundNumber << "\n";
+
 	/////
 	cout << "Performance test\n";
 	nMaxSize = AcquireRangedInt("Max number of inserted strings (Random)", 1, 30000, 1000);
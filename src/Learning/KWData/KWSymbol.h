@@ -371,11 +371,8 @@ protected:
 	// Compteur de reference, de grande taille pour ne pas etre limite a la taille des int
 	unsigned long long int lRefCount;
 
-	// Pointeur vers le symbole suivant, en cas de collision
-	KWSymbolData* pNext;
-
 	// Valeur de hashage, dependant de la valeur de la chaine de caracteres, independante de la taille de table de
-	// hashage
+	// hashage, permettant de retrouver directement l'emplacement du symbole dans le dictionnaire
 	UINT nHashValue;
 
 	// Taille de la chaine de caractere correspondant a la valeur du Symbol
@@ -403,7 +400,7 @@ typedef KWSymbolData* KWSymbolDataPtr;
 
 ///////////////////////////////////////////////////////////////////////////
 // Dictionaire de KWSymbolData
-// Inspire directement de ObjectDictionary
+// Table de hashage a adressage ouvert, optimisee pour les tres grands nombres de symboles
 // Les valeurs de Symbol servent a la fois de cle et de valeur dans le
 // dictionnaire. Ce sont des objets KWSymbolDataPtr, directement integres
 // dans le dictionnaire. Leur unicite correspond a l'unicite des Symbols
@@ -450,14 +447,49 @@ protected:
 	////////////////////////////////////////////////////////////////////
 	//// Implementation
 protected:
-	// Taille de la table de hashage
-	int GetHashTableSize() const;
+	// Table de hashage a adressage ouvert, inspiree des "swiss tables"
+	// Les emplacements sont regroupes par groupes de nGroupSize. Chaque groupe memorise un octet de controle
+	// par emplacement, ainsi que la valeur de hashage et le pointeur vers les donnees de chaque symbole.
+	// Les octets de controle d'un groupe sont stockes dans un mot de 64 bits, ce qui permet de tester
+	// tous les emplacements du groupe en parallele par des operations bit a bit:
+	//  . emplacement vide: cEmptyControl
+	//  . emplacement libere: cDeletedControl
+	//  . emplacement utilise: 7 bits de poids faible de la valeur de hashage
+	// Une recherche parcourt les groupes selon une sequence quadratique, jusqu'a trouver la cle
+	// ou un groupe comportant un emplacement vide. Les valeurs de hashage des emplacements sont
+	// comparees avant les chaines de caracteres, et permettent les retaillages sans recalcul.
+	// Les groupes sont alloues par blocs de taille bornee, comme dans les MemVector, pour eviter
+	// les allocations de tres grande taille.
+	static const int nGroupSize = 8;
+	struct SlotGroup
+	{
+		unsigned long long lControls;
+		UINT nHashes[nGroupSize];
+		KWSymbolDataPtr symbolDatas[nGroupSize];
+	};
+
+	// Nombre de groupes par bloc, pour des blocs d'au plus MemSegmentByteSize octets
+	static const int nGroupBlockSizeLog2 = 9;
+	static const int nGroupBlockSize = 1 << nGroupBlockSizeLog2;
+
+	// Nombre total d'emplacements
+	int GetSlotNumber() const;
+
+	// Nombre de groupes necessaires pour stocker un nombre de symboles, en respectant le taux de
+	// remplissage maximum de la table (7/8)
+	static int ComputeGroupNumber(int nSymbolNumber);
 
 	// Initialisation de la table de hashage
-	void InitHashTable(int hashSize);
+	void InitHashTable(int nNewGroupNumber);
 
 	// Pour le retaillage dynamique, preservant le contenu
-	void ReinitHashTable(int nNewHashSize);
+	void ReinitHashTable(int nNewGroupNumber);
+
+	// Destruction de la table de hashage, sans destruction des symboles
+	void DeleteHashTable();
+
+	// Acces a un groupe
+	SlotGroup* GetGroupAt(int nGroup) const;
 
 	// Fonction de hashage
 	UINT HashKey(const char* key) const;
@@ -465,12 +497,29 @@ protected:
 	// Recherche par cle
 	KWSymbolDataPtr GetSymbolDataAt(const char* key, UINT& nHash) const;
 
+	// Insertion d'un symbole, suppose absent de la table, dans le premier emplacement disponible
+	void InsertSymbolData(KWSymbolDataPtr symbolData, UINT nHash);
+
+	// Operations bit a bit sur les octets de controle d'un groupe
+	// Les masques resultat comportent le bit de poids fort de chaque octet selectionne
+	static unsigned long long MatchControl(unsigned long long lControls, int nControl);
+	static unsigned long long MatchEmpty(unsigned long long lControls);
+	static unsigned long long MatchEmptyOrDeleted(unsigned long long lControls);
+	static int GetFirstMatchIndex(unsigned long long lMatchMask);
+	static void SetControlAt(SlotGroup* group, int nIndex, int nControl);
+
+	// Octets de controle speciaux
+	static const int cEmptyControl = 0x80;
+	static const int cDeletedControl = 0xFE;
+
 	// Affichage d'un message d'erreur lie a un Symbol non libere en fin de programme
 	void ShowAllocErrorMessage(KWSymbolDataPtr symbolData, int nMessageIndex);
 
 	// Variables
-	PointerVector pvSymbolDatas;
+	SlotGroup** pGroupBlocks;
+	int nGroupNumber;
 	int m_nCount;
+	int nDeletedSlotNumber;
 	friend class Symbol;
 	friend union KWValue;
 };
@@ -588,9 +637,62 @@ inline POSITION KWSymbolDictionary::GetStartPosition() const
 	return (m_nCount == 0) ? NULL : BEFORE_START_POSITION;
 }
 
-inline int KWSymbolDictionary::GetHashTableSize() const
+inline int KWSymbolDictionary::GetSlotNumber() const
+{
+	return nGroupNumber * nGroupSize;
+}
+
+inline KWSymbolDictionary::SlotGroup* KWSymbolDictionary::GetGroupAt(int nGroup) const
+{
+	require(0 <= nGroup and nGroup < nGroupNumber);
+	return &pGroupBlocks[nGroup >> nGroupBlockSizeLog2][nGroup & (nGroupBlockSize - 1)];
+}
+
+inline unsigned long long KWSymbolDictionary::MatchControl(unsigned long long lControls, int nControl)
 {
-	return pvSymbolDatas.GetSize();
+	const unsigned long long lLsbs = 0x0101010101010101ULL;
+	const unsigned long long lMsbs = 0x8080808080808080ULL;
+	unsigned long long lXor;
+
+	// Les octets egaux a l'octet de controle deviennent nuls, et sont detectes par soustraction
+	// Il peut y avoir des faux positifs, elimines ensuite par comparaison des valeurs de hashage
+	lXor = lControls ^ (lLsbs * (unsigned long long)nControl);
+	return (lXor - lLsbs) & ~lXor & lMsbs;
+}
+
+inline unsigned long long KWSymbolDictionary::MatchEmpty(unsigned long long lControls)
+{
+	const unsigned long long lMsbs = 0x8080808080808080ULL;
+
+	// Seuls les octets vides ont leur bit de poids fort a 1 et leur bit de rang 1 a 0
+	return lControls & ~(lControls << 6) & lMsbs;
+}
+
+inline unsigned long long KWSymbolDictionary::MatchEmptyOrDeleted(unsigned long long lControls)
+{
+	const unsigned long long lMsbs = 0x8080808080808080ULL;
+
+	// Seuls les octets des emplacements utilises ont leur bit de poids fort a 0
+	return lControls & lMsbs;
+}
+
+inline int KWSymbolDictionary::GetFirstMatchIndex(unsigned long long lMatchMask)
+{
+	require(lMatchMask != 0);
+
+	// Isolation du bit de poids faible, ramene au debut de son octet, puis multiplication par une
+	// constante dont l'octet de poids fort du produit est l'index de l'octet
+	return (int)((((lMatchMask & (~lMatchMask + 1)) >> 7) * 0x0001020304050607ULL) >> 56);
+}
+
+inline void KWSymbolDictionary::SetControlAt(SlotGroup* group, int nIndex, int nControl)
+{
+	require(group != NULL);
+	require(0 <= nIndex and nIndex < nGroupSize);
+	require(0 <= nControl and nControl < 256);
+
+	group->lControls = (group->lControls & ~(0xFFULL << (8 * nIndex))) |
+			   ((unsigned long long)nControl << (8 * nIndex));
 }
 
 ////////////////////////////////////////////////////////////
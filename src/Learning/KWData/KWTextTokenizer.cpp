@@ -129,6 +129,10 @@ void KWTextTokenizer::CumulateTokenFrequencies(const ObjectArray* oaTokens)
 		// Ajout de l'effectif du token
 		UpgradeTokenFrequency(token->GetToken(), token->GetFrequency());
 	}
+
+	// Nettoyage en mode flux
+	if (gdSpecificTokens == NULL)
+		StreamCleanTokenDictionary(gdCollectedTokens, GetMaxCollectedTokenNumber());
 }
 
 void KWTextTokenizer::ExportTokens(ObjectArray* oaTokenFrequencies) const
@@ -658,7 +662,7 @@ void KWTextTokenizer::UpgradeTokenFrequency(const ALString& sToken, longint lFre
 
 	// Incrementation de son effectif dans le cas sans token specifique
 	if (gdSpecificTokens == NULL)
-		cast(LongintDictionary*, gdCollectedTokens)->UpgradeAt(sToken, 1);
+		cast(LongintDictionary*, gdCollectedTokens)->UpgradeAt(sToken, lFrequency);
 	// Et dans le cas avec token specifique
 	else
 	{
@@ -666,14 +670,14 @@ void KWTextTokenizer::UpgradeTokenFrequency(const ALString& sToken, longint lFre
 		nSpecificTokenIndex = (int)cast(LongintDictionary*, gdSpecificTokens)->Lookup(sToken);
 
 		// Prise en compte si necessaire
-		if (nSpecificTokenIndex > 0)
+		if (nSpecificTokenIndex > 0 and lFrequency > 0)
 		{
 			// Memorisation la premiere fois
 			if (lvSpecificTokenFrequencies.GetAt(nSpecificTokenIndex) == 0)
 				ivUsedSpecificTokenIndexes.Add(nSpecificTokenIndex);
 
 			// Incrementation de l'effectif
-			lvSpecificTokenFrequencies.UpgradeAt(nSpecificTokenIndex, 1);
+			lvSpecificTokenFrequencies.UpgradeAt(nSpecificTokenIndex, lFrequency);
 		}
 	}
 }
@@ -855,6 +859,7 @@ KWTextNgramTokenizer::KWTextNgramTokenizer()
 	assert(gdCollectedTokens != NULL);
 	delete gdCollectedTokens;
 	gdCollectedTokens = new LongintNumericKeyDictionary;
+	nSpecificNgramTableBitNumber = 0;
 }
 
 KWTextNgramTokenizer::~KWTextNgramTokenizer() {}
@@ -898,6 +903,9 @@ void KWTextNgramTokenizer::SetSpecificTokens(const ObjectArray* oaTokens)
 		}
 		assert(gdSpecificTokens->GetCount() == oaTokens->GetSize());
 	}
+
+	// Construction de la table de hashage des ngrams specifiques
+	BuildSpecificNgramTable();
 }
 
 void KWTextNgramTokenizer::ExportFrequentTokens(ObjectArray* oaTokenFrequencies, int nMaxTokenNumber) const
@@ -1024,6 +1032,10 @@ void KWTextNgramTokenizer::CumulateTokenFrequencies(const ObjectArray* oaTokens)
 		lEncodedNgram = NgramToLongint(token->GetToken());
 		UpgradeNgramTokenFrequency(lEncodedNgram, token->GetFrequency());
 	}
+
+	// Nettoyage en mode flux
+	if (gdSpecificTokens == NULL)
+		StreamCleanTokenDictionary(gdCollectedTokens, GetMaxCollectedTokenNumber());
 }
 
 void KWTextNgramTokenizer::SetDeploymentTokens(const StringVector* svDeploymentTokens)
@@ -1073,6 +1085,20 @@ void KWTextNgramTokenizer::SetDeploymentTokens(const StringVector* svDeploymentT
 		// Dimensionnement du vecteur d'effectifs
 		lvSpecificTokenFrequencies.SetSize(svDeploymentTokens->GetSize() + 1);
 	}
+
+	// Construction de la table de hashage des ngrams specifiques
+	BuildSpecificNgramTable();
+}
+
+longint KWTextNgramTokenizer::GetUsedMemory() const
+{
+	longint lUsedMemory;
+
+	lUsedMemory = KWTextTokenizer::GetUsedMemory();
+	lUsedMemory += sizeof(KWTextNgramTokenizer) - sizeof(KWTextTokenizer);
+	lUsedMemory += lvSpecificNgramTableKeys.GetUsedMemory() - sizeof(LongintVector);
+	lUsedMemory += ivSpecificNgramTableIndexes.GetUsedMemory() - sizeof(IntVector);
+	return lUsedMemory;
 }
 
 const ALString KWTextNgramTokenizer::GetClassLabel() const
@@ -1096,6 +1122,9 @@ void KWTextNgramTokenizer::Test()
 	LongintDictionary ldOutputWordFrequencies;
 	LongintDictionary ldOutputTokenFrequencies;
 	ObjectArray oaTokens;
+	KWTextNgramTokenizer specificTokenizer;
+	ObjectArray oaSpecificTokens;
+	boolean bOk;
 	Timer timer;
 	ALString sTmp;
 
@@ -1148,6 +1177,30 @@ void KWTextNgramTokenizer::Test()
 	// Test de tokenization en ngrams
 	tokenizer.TokenizeString("Bonjour, tout le monde!!!");
 	tokenizer.DisplayTokens(cout);
+
+	// Test de coherence entre la collecte de tous les ngrams et celle de ngrams specifiques, en prenant
+	// la moitie des ngrams collectes, et en les cumulant deux fois
+	tokenizer.CleanCollectedTokens();
+	tokenizer.TokenizeStringVector(&svTextValues);
+	tokenizer.ExportTokens(&oaTokens);
+	FilterTokenArray(&oaTokens, oaTokens.GetSize() / 2);
+	specificTokenizer.SetSpecificTokens(&oaTokens);
+	specificTokenizer.TokenizeStringVector(&svTextValues);
+	specificTokenizer.CumulateTokenFrequencies(&oaTokens);
+	specificTokenizer.ExportTokens(&oaSpecificTokens);
+	bOk = oaSpecificTokens.GetSize() == oaTokens.GetSize();
+	for (i = 0; i < oaTokens.GetSize(); i++)
+	{
+		if (not bOk)
+			break;
+		bOk = cast(KWTokenFrequency*, oaSpecificTokens.GetAt(i))->GetToken() ==
+			  cast(KWTokenFrequency*, oaTokens.GetAt(i))->GetToken() and
+		      cast(KWTokenFrequency*, oaSpecificTokens.GetAt(i))->GetFrequency() ==
+			  2 * cast(KWTokenFrequency*, oaTokens.GetAt(i))->GetFrequency();
+	}
+	cout << "Specific ngrams (" << oaTokens.GetSize() << "): " << BooleanToString(bOk) << "\n";
+	oaTokens.DeleteAll();
+	oaSpecificTokens.DeleteAll();
 }
 
 void KWTextNgramTokenizer::TokenizeText(const char* sText, int nTextLength)
@@ -1157,6 +1210,7 @@ void KWTextNgramTokenizer::TokenizeText(const char* sText, int nTextLength)
 	int nMaxUsableNgramLength;
 	longint lEncodedNgram;
 	char* sEncodedNgramBytes;
+	int nSpecificTokenIndex;
 	int n;
 	int i;
 	debug(static int nMethodCallIndex = 0);
@@ -1185,6 +1239,39 @@ void KWTextNgramTokenizer::TokenizeText(const char* sText, int nTextLength)
 	// Acces a la memoire du longint lEncodedNgram sous forme d'un tableau de bytes
 	sEncodedNgramBytes = (char*)&lEncodedNgram;
 
+	// Analyse de la chaine pour en extraire tous les ngrams, dans le cas de tokens specifiques
+	// On ne s'interesse qu'aux ngrams specifiques, en arretant l'extension des ngrams a une position donnee
+	// des que le ngram courant n'est plus prefixe d'un ngram specifique
+	if (gdSpecificTokens != NULL)
+	{
+		sCurrentStringValue = sText;
+		for (n = 0; n < nTextLength; n++)
+		{
+			lEncodedNgram = 0;
+			nMaxUsableNgramLength = min(GetMaxNgramLength(), nTextLength - n);
+			for (i = 0; i < nMaxUsableNgramLength; i++)
+			{
+				sEncodedNgramBytes[i] = sCurrentStringValue[i];
+				assert(lEncodedNgram == SubNgramToLongint(sText, n, i + 1));
+
+				// Recherche du ngram dans la table des ngrams specifiques
+				nSpecificTokenIndex = LookupSpecificNgram(lEncodedNgram);
+				if (nSpecificTokenIndex == -1)
+					break;
+
+				// Incrementation de l'effectif s'il s'agit d'un ngram specifique
+				if (nSpecificTokenIndex > 0)
+				{
+					if (lvSpecificTokenFrequencies.GetAt(nSpecificTokenIndex) == 0)
+						ivUsedSpecificTokenIndexes.Add(nSpecificTokenIndex);
+					lvSpecificTokenFrequencies.UpgradeAt(nSpecificTokenIndex, 1);
+				}
+			}
+			sCurrentStringValue++;
+		}
+		return;
+	}
+
 	// Analyse de la chaine pour en extraire tous les ngrams
 	sCurrentStringValue = sText;
 	for (n = 0; n < nTextLength; n++)
@@ -1240,26 +1327,128 @@ void KWTextNgramTokenizer::UpgradeNgramTokenFrequency(longint lEncodedNgram, lon
 
 	// Incrementation de son effectif dans le cas sans token specifique
 	if (gdSpecificTokens == NULL)
-		cast(LongintNumericKeyDictionary*, gdCollectedTokens)->UpgradeAt(lEncodedNgram, 1);
+		cast(LongintNumericKeyDictionary*, gdCollectedTokens)->UpgradeAt(lEncodedNgram, lFrequency);
 	// Et dans le cas avec token specifique
 	else
 	{
 		// Recherche de l'index du token specifique
-		nSpecificTokenIndex = (int)cast(LongintNumericKeyDictionary*, gdSpecificTokens)->Lookup(lEncodedNgram);
+		nSpecificTokenIndex = LookupSpecificNgram(lEncodedNgram);
+		assert(max(nSpecificTokenIndex, 0) ==
+		       (int)cast(LongintNumericKeyDictionary*, gdSpecificTokens)->Lookup(lEncodedNgram));
 
 		// Prise en compte si necessaire
-		if (nSpecificTokenIndex > 0)
+		if (nSpecificTokenIndex > 0 and lFrequency > 0)
 		{
 			// Memorisation la premiere fois
 			if (lvSpecificTokenFrequencies.GetAt(nSpecificTokenIndex) == 0)
 				ivUsedSpecificTokenIndexes.Add(nSpecificTokenIndex);
 
 			// Incrementation de l'effectif
-			lvSpecificTokenFrequencies.UpgradeAt(nSpecificTokenIndex, 1);
+			lvSpecificTokenFrequencies.UpgradeAt(nSpecificTokenIndex, lFrequency);
 		}
 	}
 }
 
+void KWTextNgramTokenizer::BuildSpecificNgramTable()
+{
+	const LongintNumericKeyDictionary* lnkdSpecificTokens;
+	POSITION position;
+	NUMERIC numericKey;
+	longint lValue;
+	longint lEncodedNgram;
+	longint lPrefixNgram;
+	char* sPrefixNgramBytes;
+	int nEntryNumber;
+	int nTableSize;
+	int i;
+
+	// Nettoyage
+	lvSpecificNgramTableKeys.SetSize(0);
+	ivSpecificNgramTableIndexes.SetSize(0);
+	nSpecificNgramTableBitNumber = 0;
+
+	// Construction si tokens specifiques
+	if (gdSpecificTokens != NULL)
+	{
+		lnkdSpecificTokens = cast(const LongintNumericKeyDictionary*, gdSpecificTokens);
+
+		// Calcul d'un majorant du nombre de ngrams et de prefixes a inserer, en sommant les longueurs des ngrams
+		nEntryNumber = 0;
+		position = lnkdSpecificTokens->GetStartPosition();
+		while (position != NULL)
+		{
+			lnkdSpecificTokens->GetNextAssoc(position, numericKey, lValue);
+			lEncodedNgram = numericKey.ToLongint();
+			for (i = 0; i < GetMaxNgramLength(); i++)
+			{
+				if (((char*)&lEncodedNgram)[i] != '\0')
+					nEntryNumber++;
+			}
+		}
+
+		// Dimensionnement de la table pour les ngrams et leurs prefixes, avec un taux de remplissage
+		// d'au plus 50%
+		nTableSize = 2;
+		nSpecificNgramTableBitNumber = 1;
+		while (nTableSize < 2 * nEntryNumber)
+		{
+			nTableSize *= 2;
+			nSpecificNgramTableBitNumber++;
+		}
+		lvSpecificNgramTableKeys.SetSize(nTableSize);
+		ivSpecificNgramTableIndexes.SetSize(nTableSize);
+
+		// Insertion des ngrams specifiques
+		position = lnkdSpecificTokens->GetStartPosition();
+		while (position != NULL)
+		{
+			lnkdSpecificTokens->GetNextAssoc(position, numericKey, lValue);
+			InsertSpecificNgram(numericKey.ToLongint(), (int)lValue);
+		}
+
+		// Insertion de leurs prefixes stricts, en les marquant avec l'index 0 s'ils ne sont pas deja presents
+		position = lnkdSpecificTokens->GetStartPosition();
+		while (position != NULL)
+		{
+			lnkdSpecificTokens->GetNextAssoc(position, numericKey, lValue);
+			lEncodedNgram = numericKey.ToLongint();
+
+			// Prefixes obtenus en ne gardant que les premiers bytes du ngram encode
+			lPrefixNgram = 0;
+			sPrefixNgramBytes = (char*)&lPrefixNgram;
+			for (i = 0; i < GetMaxNgramLength() - 1; i++)
+			{
+				sPrefixNgramBytes[i] = ((char*)&lEncodedNgram)[i];
+				if (lPrefixNgram == lEncodedNgram)
+					break;
+				if (LookupSpecificNgram(lPrefixNgram) == -1)
+					InsertSpecificNgram(lPrefixNgram, 0);
+			}
+		}
+	}
+}
+
+void KWTextNgramTokenizer::InsertSpecificNgram(longint lEncodedNgram, int nSpecificTokenIndex)
+{
+	int nMask;
+	int nPosition;
+
+	require(lEncodedNgram != 0);
+	require(nSpecificTokenIndex >= 0);
+	require(lvSpecificNgramTableKeys.GetSize() > 0);
+
+	// Recherche d'une case vide par sondage lineaire
+	nMask = lvSpecificNgramTableKeys.GetSize() - 1;
+	nPosition = GetSpecificNgramTablePosition(lEncodedNgram);
+	while (lvSpecificNgramTableKeys.GetAt(nPosition) != 0)
+	{
+		assert(lvSpecificNgramTableKeys.GetAt(nPosition) != lEncodedNgram);
+		nPosition = (nPosition + 1) & nMask;
+	}
+	lvSpecificNgramTableKeys.SetAt(nPosition, lEncodedNgram);
+	ivSpecificNgramTableIndexes.SetAt(nPosition, nSpecificTokenIndex);
+}
+
 longint KWTextNgramTokenizer::NgramToLongint(const ALString& sNgramBytes)
 {
 	longint lEncodedNgram;
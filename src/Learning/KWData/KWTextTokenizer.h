@@ -83,6 +83,9 @@ public:
 
 	// Prise en compte des effectifs d'un tableau de tokens pour mettre a jour les effectifs globaux des tokens
 	// collectes
+	// En mode flux (MaxCollectedTokenNumber > 0), les tokens collectes sont ensuite nettoyes comme apres
+	// l'analyse d'un texte, ce qui permet de fusionner les tokens collectes par plusieurs tokenizers (par exemple
+	// ceux des esclaves) en restant dans la limite du nombre max de tokens
 	virtual void CumulateTokenFrequencies(const ObjectArray* oaTokens);
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -339,6 +342,9 @@ public:
 	// Taille max des ngrams prise en compte
 	static int GetMaxNgramLength();
 
+	// Memoire utilisee
+	longint GetUsedMemory() const override;
+
 	// Libelles utilisateurs
 	const ALString GetClassLabel() const override;
 
@@ -354,6 +360,40 @@ protected:
 	// Mise a jour de l'effectif d'un token de type ngrams
 	void UpgradeNgramTokenFrequency(longint lEncodedNgram, longint lFrequency);
 
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Table de hashage des ngrams specifiques
+	// Dans le cas de tokens specifiques (deuxieme passe de collecte ou deploiement), la tokenisation
+	// passe par une table de hashage a adressage ouvert, plus compacte et plus rapide que le dictionnaire
+	// des tokens specifiques, qui est conserve pour l'export des tokens
+	// La table contient les ngrams specifiques, ainsi que tous leurs prefixes: lors de l'extension
+	// d'un ngram byte par byte a une position donnee du texte, on peut ainsi s'arreter des qu'un ngram n'est
+	// pas prefixe d'un ngram specifique, ce qui evite la plupart des recherches pour les longueurs de ngrams
+	// les plus grandes
+
+	// Construction de la table a partir du dictionnaire des tokens specifiques, ou nettoyage si pas de
+	// tokens specifiques
+	void BuildSpecificNgramTable();
+
+	// Recherche d'un ngram dans la table
+	// Renvoie l'index du token specifique (a partir de 1) si le ngram est specifique, 0 s'il n'est que
+	// prefixe d'un ngram specifique, et -1 sinon
+	int LookupSpecificNgram(longint lEncodedNgram) const;
+
+	// Insertion d'un ngram dans la table, avec un index de token specifique ou 0 pour un prefixe
+	void InsertSpecificNgram(longint lEncodedNgram, int nSpecificTokenIndex);
+
+	// Position initiale d'un ngram dans la table, par hashage multiplicatif
+	int GetSpecificNgramTablePosition(longint lEncodedNgram) const;
+
+	// Cles de la table: ngrams encodes en longint, 0 pour une case vide (aucun ngram n'est encode par 0)
+	LongintVector lvSpecificNgramTableKeys;
+
+	// Index de token specifique par case de la table
+	IntVector ivSpecificNgramTableIndexes;
+
+	// Nombre de bits de la taille de la table, qui est une puissance de 2
+	int nSpecificNgramTableBitNumber;
+
 	//////////////////////////////////////////////////////////////////////////////////////////
 	// Gestion optimisee des ngrams
 	// En convertissant des ngrams de bytes en longint, on peut obtenir des optimisations
@@ -453,3 +493,32 @@ inline int KWTextNgramTokenizer::GetMaxNgramLength()
 {
 	return 8;
 }
+
+inline int KWTextNgramTokenizer::LookupSpecificNgram(longint lEncodedNgram) const
+{
+	int nMask;
+	int nPosition;
+	longint lKey;
+
+	require(lEncodedNgram != 0);
+	require(lvSpecificNgramTableKeys.GetSize() > 0);
+
+	// Sondage lineaire jusqu'a trouver le ngram ou une case vide, la table n'etant jamais pleine
+	nMask = lvSpecificNgramTableKeys.GetSize() - 1;
+	nPosition = GetSpecificNgramTablePosition(lEncodedNgram);
+	while (true)
+	{
+		lKey = lvSpecificNgramTableKeys.GetAt(nPosition);
+		if (lKey == lEncodedNgram)
+			return ivSpecificNgramTableIndexes.GetAt(nPosition);
+		else if (lKey == 0)
+			return -1;
+		nPosition = (nPosition + 1) & nMask;
+	}
+}
+
+inline int KWTextNgramTokenizer::GetSpecificNgramTablePosition(longint lEncodedNgram) const
+{
+	return (int)(((unsigned long long int)lEncodedNgram * 11400714819323198485ULL) >>
+		     (64 - nSpecificNgramTableBitNumber));
+}
@@ -16,7 +16,7 @@ void* KWValueBlock::GenericAllocValueBlock(int nSize)
 	void* pValueBlockMemory;
 	int nSegmentNumber;
 
-	require(nSize >= 0);
+	require(0 <= nSize and nSize <= nValueNumberMask);
 
 	// Cas mono-segment: le bloc entier peut tenir dans un segment memoire
 	if (nSize <= nSegmentSize)
@@ -118,7 +118,8 @@ KWValueBlock::~KWValueBlock()
 	KWValueIndexPair* valueIndexPairs;
 
 	// Desallocation des segments de paire (valeur, index) dans le cas de tableaux de grande taille
-	if (nValueNumber > nSegmentSize)
+	// (les blocs compacts sont toujours stockes dans un seul bloc memoire)
+	if (nValueNumber > nSegmentSize and not IsCompact())
 	{
 		nSegmentNumber = (nValueNumber - 1) / nSegmentSize + 1;
 		for (i = nSegmentNumber - 1; i >= 0; i--)
@@ -129,6 +130,64 @@ KWValueBlock::~KWValueBlock()
 	}
 }
 
+void* KWValueBlock::GenericAllocCompactValueBlock(int nSize, int nValueSize, int nIndexSize, int nBaseSparseIndex)
+{
+	KWValueBlock* newValueBlock;
+	int nMemorySize;
+	void* pValueBlockMemory;
+
+	require(0 < nSize and nSize <= nSegmentSize);
+	require(nValueSize == sizeof(float));
+	require(nIndexSize == 1 or nIndexSize == 2 or nIndexSize == 4);
+	require(nBaseSparseIndex >= 0);
+
+	// Creation du bloc memoire, en un seul morceau
+	nMemorySize = 2 * sizeof(int) + nSize * (nValueSize + nIndexSize);
+	assert(nMemorySize <= MemSegmentByteSize);
+	pValueBlockMemory = NewMemoryBlock(nMemorySize);
+	memset(pValueBlockMemory, 0, nMemorySize * sizeof(char));
+
+	// Parametrage du nombre de valeurs, de la taille des ecarts d'index et de l'index de base
+	newValueBlock = (KWValueBlock*)pValueBlockMemory;
+	newValueBlock->nValueNumber = nSize | (nIndexSize << nCompactIndexSizeShift);
+	*(int*)&newValueBlock->cStartBlock = nBaseSparseIndex;
+	ensure(newValueBlock->IsCompact());
+	ensure(newValueBlock->GetValueNumber() == nSize);
+	ensure(newValueBlock->GetCompactIndexSize() == nIndexSize);
+	return pValueBlockMemory;
+}
+
+void KWValueBlock::SetCompactAttributeSparseIndexAt(int nValueIndex, int nSparseIndex)
+{
+	char* pIndexes;
+	int nIndexOffset;
+
+	require(IsCompact());
+	require(0 <= nValueIndex and nValueIndex < GetValueNumber());
+	require(nSparseIndex >= *(int*)&cStartBlock);
+
+	// Calcul de l'ecart a l'index de base
+	nIndexOffset = nSparseIndex - *(int*)&cStartBlock;
+
+	// Memorisation selon la taille des ecarts d'index, qui suivent le vecteur des valeurs
+	pIndexes = &cStartBlock + sizeof(int) + GetValueNumber() * sizeof(float);
+	switch (GetCompactIndexSize())
+	{
+	case 1:
+		assert(nIndexOffset <= UCHAR_MAX);
+		((unsigned char*)pIndexes)[nValueIndex] = (unsigned char)nIndexOffset;
+		break;
+	case 2:
+		assert(nIndexOffset <= USHRT_MAX);
+		((unsigned short*)pIndexes)[nValueIndex] = (unsigned short)nIndexOffset;
+		break;
+	default:
+		((int*)pIndexes)[nValueIndex] = nIndexOffset;
+		break;
+	}
+	ensure(GetCompactAttributeSparseIndexAt(nValueIndex) == nSparseIndex);
+}
+
 int KWValueBlock::GetValueIndexAtAttributeSparseIndex(int nAttributeSparseIndex) const
 {
 	int nLeft;
@@ -739,7 +798,7 @@ void KWValueBlock::WriteIntValue(ALString& sOutputField, int nValue)
 
 void KWValueBlock::WriteContinuousValue(ALString& sOutputField, Continuous cValue)
 {
-	sOutputField += KWContinuous::ContinuousToString(cValue);
+	KWContinuous::AppendContinuous(sOutputField, cValue);
 }
 
 void KWValueBlock::WriteSymbolValue(ALString& sOutputField, const Symbol& sValue)
@@ -996,6 +1055,59 @@ int KWContinuousValueBlock::WriteFieldPart(const KWIndexedKeyBlock* indexedKeyBl
 	return nWrittenValueNumber;
 }
 
+KWContinuousValueBlock* KWContinuousValueBlock::Compact(KWContinuousValueBlock* valueBlock)
+{
+	KWContinuousValueBlock* compactValueBlock;
+	void* pValueBlockMemory;
+	float* fValues;
+	int nSize;
+	int nIndexRange;
+	int nIndexSize;
+	int i;
+	Continuous cValue;
+
+	require(valueBlock != NULL);
+
+	// Pas de compactage si deja compact, trop petit ou trop grand pour un seul bloc memoire
+	nSize = valueBlock->GetValueNumber();
+	if (valueBlock->IsCompact() or nSize < nCompactMinValueNumber or nSize > nSegmentSize)
+		return valueBlock;
+
+	// Pas de compactage si une des valeurs n'est pas representable exactement en float
+	for (i = 0; i < nSize; i++)
+	{
+		cValue = valueBlock->GetValueAt(i);
+		if ((Continuous)(float)cValue != cValue)
+			return valueBlock;
+	}
+
+	// Taille des ecarts d'index, selon l'ecart entre le dernier et le premier index
+	nIndexRange = valueBlock->GetAttributeSparseIndexAt(nSize - 1) - valueBlock->GetAttributeSparseIndexAt(0);
+	if (nIndexRange <= UCHAR_MAX)
+		nIndexSize = 1;
+	else if (nIndexRange <= USHRT_MAX)
+		nIndexSize = 2;
+	else
+		nIndexSize = 4;
+
+	// Creation du bloc compact, en utilisant le "placement new" comme dans NewValueBlock
+	pValueBlockMemory = GenericAllocCompactValueBlock(nSize, sizeof(float), nIndexSize,
+							  valueBlock->GetAttributeSparseIndexAt(0));
+	compactValueBlock = new (pValueBlockMemory) KWContinuousValueBlock;
+
+	// Recopie des index et des valeurs
+	fValues = (float*)compactValueBlock->GetCompactValues();
+	for (i = 0; i < nSize; i++)
+	{
+		compactValueBlock->SetCompactAttributeSparseIndexAt(i, valueBlock->GetAttributeSparseIndexAt(i));
+		fValues[i] = (float)valueBlock->GetValueAt(i);
+	}
+	assert(compactValueBlock->GetUsedMemory() < valueBlock->GetUsedMemory());
+	delete valueBlock;
+	ensure(compactValueBlock->Check());
+	return compactValueBlock;
+}
+
 KWContinuousValueBlock* KWContinuousValueBlock::ConcatValueBlocks(const KWContinuousValueBlock* sourceValueBlock1,
 								  const KWContinuousValueBlock* sourceValueBlock2)
 {
@@ -1073,6 +1185,7 @@ void KWContinuousValueBlock::Test()
 	KWIndexedCKeyBlock indexedKeyBlock;
 	KWContinuousValueDictionary valueDictionary;
 	KWContinuousValueBlock* continuousValueBlock;
+	KWContinuousValueBlock* standardValueBlock;
 	boolean bOk;
 	ALString sExternalField;
 	StringVector svExternalFields;
@@ -1084,6 +1197,7 @@ void KWContinuousValueBlock::Test()
 	Continuous cValue;
 	Continuous cDefaultValue;
 	int nFound;
+	int nIndexStep;
 
 	// Creation des cles
 	for (i = 0; i < nKeyNumber; i++)
@@ -1180,6 +1294,47 @@ void KWContinuousValueBlock::Test()
 			cout << "\terror: " << sMessage << endl;
 	}
 	delete continuousValueBlock;
+
+	// Codage compact, pour des ecarts d'index de taille croissante
+	cout << "Compact block\n";
+	for (nIndexStep = 1; nIndexStep <= 100000; nIndexStep *= 100)
+	{
+		continuousValueBlock = NewValueBlock(nMaxValueNumber);
+		for (i = 0; i < nMaxValueNumber; i++)
+		{
+			continuousValueBlock->SetAttributeSparseIndexAt(i, 1 + i * nIndexStep);
+			continuousValueBlock->SetValueAt(i, i + 1);
+		}
+		standardValueBlock = continuousValueBlock->Clone();
+		continuousValueBlock = Compact(continuousValueBlock);
+		cout << "\tIndex step " << nIndexStep;
+		cout << "\tcompact: " << BooleanToString(continuousValueBlock->IsCompact());
+		cout << "\tmemory: " << standardValueBlock->GetUsedMemory() << " -> "
+		     << continuousValueBlock->GetUsedMemory() << endl;
+		cout << "\t" << *continuousValueBlock;
+
+		// Verification de la coherence des acces avec ceux du bloc standard
+		for (i = 0; i <= (nMaxValueNumber + 1) * nIndexStep; i++)
+		{
+			assert(continuousValueBlock->GetValueIndexAtAttributeSparseIndex(i) ==
+			       standardValueBlock->GetValueIndexAtAttributeSparseIndex(i));
+			assert(continuousValueBlock->GetValueAtAttributeSparseIndex(i, cDefaultValue) ==
+			       standardValueBlock->GetValueAtAttributeSparseIndex(i, cDefaultValue));
+		}
+		delete standardValueBlock;
+		delete continuousValueBlock;
+	}
+
+	// Pas de codage compact si une valeur n'est pas representable en float
+	continuousValueBlock = NewValueBlock(nMaxValueNumber);
+	for (i = 0; i < nMaxValueNumber; i++)
+	{
+		continuousValueBlock->SetAttributeSparseIndexAt(i, i);
+		continuousValueBlock->SetValueAt(i, i + 0.1);
+	}
+	continuousValueBlock = Compact(continuousValueBlock);
+	cout << "\tNon integer values\tcompact: " << BooleanToString(continuousValueBlock->IsCompact()) << endl;
+	delete continuousValueBlock;
 }
 
 void KWContinuousValueBlock::TestPerformance()
@@ -1288,10 +1443,15 @@ KWContinuousValueBlock* KWContinuousValueBlock::BuildCKeyBlockFromField(const KW
 	require(indexedKeyBlock != NULL);
 	require(sInputField != NULL);
 
+	// Lecture rapide dans le cas standard de cles triees
+	resultValueBlock = BuildSortedCKeyBlockFromField(indexedKeyBlock, sInputField, cDefaultValue, bOk, sMessage);
+	if (resultValueBlock != NULL)
+		return resultValueBlock;
+
 	// Reinitialisation de la taille du message sans le desallouer
 	sMessage.GetBufferSetLength(0);
 
-	// Boucle de lecture des paires (cle, valeur)
+	// Boucle de lecture des paires (cle, valeur), avec un dictionnaire pour gerer les cles dans un ordre quelconque
 	nOffset = 0;
 	bOk = true;
 	while (bOk and sInputField[nOffset] != '\0')
@@ -1377,6 +1537,117 @@ KWContinuousValueBlock* KWContinuousValueBlock::BuildCKeyBlockFromField(const KW
 	return resultValueBlock;
 }
 
+KWContinuousValueBlock* KWContinuousValueBlock::BuildSortedCKeyBlockFromField(const KWIndexedCKeyBlock* indexedKeyBlock,
+									      const char* sInputField,
+									      Continuous cDefaultValue, boolean& bOk,
+									      ALString& sMessage)
+{
+	KWContinuousValueBlock* resultValueBlock;
+	KWContinuousValueSparseVector valueSparseVector;
+	int nOffset;
+	ALString sKey;
+	ALString sLastKey;
+	boolean bFirstKey;
+	int nSparseIndex;
+	boolean bExistingValue;
+	ALString sValue;
+	Continuous cValue;
+	int nFieldError;
+	int nError;
+
+	require(indexedKeyBlock != NULL);
+	require(sInputField != NULL);
+
+	// Reinitialisation de la taille du message sans le desallouer
+	sMessage.GetBufferSetLength(0);
+
+	// Boucle de lecture des paires (cle, valeur)
+	bFirstKey = true;
+	nOffset = 0;
+	bOk = true;
+	while (bOk and sInputField[nOffset] != '\0')
+	{
+		// Lecture d'un caractere blanc
+		bOk = ReadBlankSeparator(sInputField, nOffset, nFieldError);
+		if (not bOk)
+			sMessage = BuildErrorMessage(GetFieldErrorLabel(nFieldError), sKey, sInputField, nOffset);
+
+		// Lecture de la cle
+		if (bOk and sInputField[nOffset] != '\0')
+		{
+			bOk = ReadCKey(sInputField, nOffset, sKey, nFieldError);
+			if (not bOk)
+				sMessage =
+				    BuildErrorMessage(GetFieldErrorLabel(nFieldError), sKey, sInputField, nOffset);
+		}
+
+		// Lecture de la valeur si elle existe
+		bExistingValue = false;
+		if (bOk and sInputField[nOffset] != '\0')
+		{
+			if (sInputField[nOffset] == ':')
+			{
+				// On saute le caractere ':'
+				nOffset++;
+
+				// Lecture de la valeur continue sous forme chaine de caracteres
+				bOk = ReadContinuousValue(sInputField, nOffset, sValue, nFieldError);
+
+				// Erreur de valeur
+				if (not bOk)
+					sMessage = BuildErrorMessage(GetFieldErrorLabel(nFieldError), sKey, sInputField,
+								     nOffset);
+				else
+					bExistingValue = true;
+			}
+		}
+
+		// Traitement de la paire cle valeur
+		if (bOk)
+		{
+			// Abandon si la cle n'est pas strictement superieure a la precedente, ce qui couvre
+			// le cas des cles utilisees plusieurs fois
+			if (not bFirstKey and strcmp(sKey, sLastKey) <= 0)
+				return NULL;
+			bFirstKey = false;
+			sLastKey = sKey;
+
+			// Si cle a conserver, memorisation de la valeur
+			nSparseIndex = indexedKeyBlock->GetKeyIndexFromString(sKey);
+			if (nSparseIndex != -1)
+			{
+				// Conversion de la valeur si presente
+				if (bExistingValue)
+				{
+					nError = KWContinuous::StringToContinuousError(sValue, cValue);
+					bOk = (nError == KWContinuous::NoError);
+					if (not bOk)
+						sMessage = BuildErrorMessage(KWContinuous::ErrorLabel(nError), sKey,
+									     sInputField, nOffset);
+				}
+				//  Sinon, on prend 1, comme dans SVMLight
+				else
+					cValue = 1;
+
+				// Memorisation si ok et valeur utile
+				if (bOk and cValue != cDefaultValue)
+					valueSparseVector.AddValueAt(nSparseIndex, cValue);
+			}
+		}
+	}
+
+	// Si Ok, on extrait la representation dense
+	// Les cles du champ et celles du bloc etant triees selon le meme ordre, les index sparse sont
+	// dans le bon ordre et le tri n'est pas necessaire
+	if (bOk)
+		resultValueBlock = BuildBlockFromSparseValueVector(&valueSparseVector);
+	// Sinon, on renvoie un bloc vide
+	else
+		resultValueBlock = NewValueBlock(0);
+	ensure(resultValueBlock->Check());
+	return resultValueBlock;
+}
+
 KWContinuousValueBlock* KWContinuousValueBlock::BuildNKeyBlockFromField(const KWIndexedNKeyBlock* indexedKeyBlock,
 									const char* sInputField,
 									Continuous cDefaultValue, boolean& bOk,
@@ -1944,10 +2215,15 @@ KWSymbolValueBlock* KWSymbolValueBlock::BuildCKeyBlockFromField(const KWIndexedC
 	require(indexedKeyBlock != NULL);
 	require(sInputField != NULL);
 
+	// Lecture rapide dans le cas standard de cles triees
+	resultValueBlock = BuildSortedCKeyBlockFromField(indexedKeyBlock, sInputField, sDefaultValue, bOk, sMessage);
+	if (resultValueBlock != NULL)
+		return resultValueBlock;
+
 	// Reinitialisation de la taille du message sans le desallouer
 	sMessage.GetBufferSetLength(0);
 
-	// Boucle de lecture des paire (cle, valeur)
+	// Boucle de lecture des paire (cle, valeur), avec un dictionnaire pour gerer les cles dans un ordre quelconque
 	nOffset = 0;
 	bOk = true;
 	while (bOk and sInputField[nOffset] != '\0')
@@ -2025,6 +2301,106 @@ KWSymbolValueBlock* KWSymbolValueBlock::BuildCKeyBlockFromField(const KWIndexedC
 	return resultValueBlock;
 }
 
+KWSymbolValueBlock* KWSymbolValueBlock::BuildSortedCKeyBlockFromField(const KWIndexedCKeyBlock* indexedKeyBlock,
+								      const char* sInputField,
+								      const Symbol& sDefaultValue, boolean& bOk,
+								      ALString& sMessage)
+{
+	KWSymbolValueBlock* resultValueBlock;
+	KWSymbolValueSparseVector valueSparseVector;
+	int nOffset;
+	ALString sKey;
+	ALString sLastKey;
+	boolean bFirstKey;
+	int nSparseIndex;
+	boolean bExistingValue;
+	ALString sValue;
+	Symbol sValueSymbol;
+	const Symbol sValueSymbol1 = Symbol("1");
+	int nFieldError;
+
+	require(indexedKeyBlock != NULL);
+	require(sInputField != NULL);
+
+	// Reinitialisation de la taille du message sans le desallouer
+	sMessage.GetBufferSetLength(0);
+
+	// Boucle de lecture des paire (cle, valeur)
+	bFirstKey = true;
+	nOffset = 0;
+	bOk = true;
+	while (bOk and sInputField[nOffset] != '\0')
+	{
+		// Lecture d'un caractere blanc
+		bOk = ReadBlankSeparator(sInputField, nOffset, nFieldError);
+		if (not bOk)
+			sMessage = BuildErrorMessage(GetFieldErrorLabel(nFieldError), sKey, sInputField, nOffset);
+
+		// Lecture de la cle
+		if (bOk and sInputField[nOffset] != '\0')
+		{
+			bOk = ReadCKey(sInputField, nOffset, sKey, nFieldError);
+			if (not bOk)
+				sMessage =
+				    BuildErrorMessage(GetFieldErrorLabel(nFieldError), sKey, sInputField, nOffset);
+		}
+
+		// Lecture de la valeur si elle existe
+		bExistingValue = false;
+		if (bOk and sInputField[nOffset] != '\0')
+		{
+			if (sInputField[nOffset] == ':')
+			{
+				// On saute le caractere ':'
+				nOffset++;
+
+				// Lecture de la valeur Symbol sous forme chaine de caracteres
+				bOk = ReadSymbolValue(sInputField, nOffset, sValue, nFieldError);
+
+				// Erreur de valeur
+				if (not bOk)
+					sMessage = BuildErrorMessage(GetFieldErrorLabel(nFieldError), sKey, sInputField,
+								     nOffset);
+				else
+					bExistingValue = true;
+			}
+		}
+
+		// Traitement de la paire cle valeur
+		if (bOk)
+		{
+			// Abandon si la cle n'est pas strictement superieure a la precedente
+			if (not bFirstKey and strcmp(sKey, sLastKey) <= 0)
+				return NULL;
+			bFirstKey = false;
+			sLastKey = sKey;
+
+			// Si cle a conserver, memorisation de la valeur
+			nSparseIndex = indexedKeyBlock->GetKeyIndexFromString(sKey);
+			if (nSparseIndex != -1)
+			{
+				// Conversion et memorisation si valeur utile ("1" si non specifiee, comme dans
+				// SVMLight)
+				if (bExistingValue)
+					sValueSymbol = Symbol(sValue);
+				else
+					sValueSymbol = sValueSymbol1;
+				if (sValueSymbol != sDefaultValue)
+					valueSparseVector.AddValueAt(nSparseIndex, sValueSymbol);
+			}
+		}
+	}
+
+	// Si Ok, on extrait la representation dense, sans tri necessaire des index sparse
+	if (bOk)
+		resultValueBlock = BuildBlockFromSparseValueVector(&valueSparseVector);
+	// Sinon, on renvoie un bloc vide
+	else
+		resultValueBlock = NewValueBlock(0);
+	ensure(resultValueBlock->Check());
+	return resultValueBlock;
+}
+
 KWSymbolValueBlock* KWSymbolValueBlock::BuildNKeyBlockFromField(const KWIndexedNKeyBlock* indexedKeyBlock,
 								const char* sInputField, const Symbol& sDefaultValue,
 								boolean& bOk, ALString& sMessage)
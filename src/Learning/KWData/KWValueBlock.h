@@ -73,9 +73,13 @@ public:
 	// (entre 0 et ValueNumber)
 
 	// Acces a l'index de chargement sparse de la variable associee a un index de valeur
+	// La modification n'est possible que pour un bloc non compact
 	int GetAttributeSparseIndexAt(int nValueIndex) const;
 	void SetAttributeSparseIndexAt(int nValueIndex, int nSparseIndex);
 
+	// Indique si le bloc utilise le codage compact, en lecture seule (cf. KWContinuousValueBlock::Compact)
+	boolean IsCompact() const;
+
 	///////////////////////////////////////////////////////////////////
 	// Acces aux valeurs du bloc par index d'attribut
 	// (entre 0 et LastAttributeSparseIndex inclus)
@@ -279,6 +283,37 @@ protected:
 	static const int nElementSize = (int)sizeof(KWValueIndexPair);
 	static const int nSegmentSize = (int)((MemSegmentByteSize - sizeof(int)) / nElementSize);
 
+	/////////////////////////////////////////////////////////////////////////////////
+	// Codage compact d'un bloc, en lecture seule
+	//
+	// Un bloc compact est stocke en un seul bloc memoire, avec apres le nombre de valeurs:
+	//  . l'index sparse de la premiere valeur (int), servant de base aux index suivants
+	//  . le vecteur des valeurs, dans un type de taille reduite (par exemple float pour les Continuous)
+	//  . le vecteur des ecarts des index sparse a l'index de base, sur 1, 2 ou 4 octets selon l'ecart max
+	// On garde ainsi un acces direct en O(1) aux index et aux valeurs, et donc la recherche dichotomique
+	//
+	// La taille des ecarts d'index est memorisee dans les bits de poids fort de nValueNumber, nuls dans le
+	// cas standard: un bloc compact a alors un nValueNumber brut superieur a nSegmentSize, ce qui permet de
+	// ne pas penaliser l'acces aux blocs standards mono-segment, les plus frequents
+
+	// Decalage des bits de taille des ecarts d'index, et masque du nombre de valeurs
+	static const int nCompactIndexSizeShift = 28;
+	static const int nValueNumberMask = (1 << nCompactIndexSizeShift) - 1;
+
+	// Taille des ecarts d'index d'un bloc compact (0 si bloc standard)
+	int GetCompactIndexSize() const;
+
+	// Acces a l'index sparse d'un bloc compact
+	int GetCompactAttributeSparseIndexAt(int nValueIndex) const;
+
+	// Acces au debut du vecteur de valeurs d'un bloc compact
+	const void* GetCompactValues() const;
+
+	// Creation d'un bloc compact, dont les index et les valeurs sont a initialiser par l'appelant
+	// en utilisant GetCompactValues (valeurs) et SetCompactAttributeSparseIndexAt (index)
+	static void* GenericAllocCompactValueBlock(int nSize, int nValueSize, int nIndexSize, int nBaseSparseIndex);
+	void SetCompactAttributeSparseIndexAt(int nValueIndex, int nSparseIndex);
+
 	// Nombre de valeurs du bloc
 	int nValueNumber;
 
@@ -346,6 +381,16 @@ public:
 	// Ecriture d'un bloc de valeurs
 	void WriteField(const KWIndexedKeyBlock* indexedKeyBlock, ALString& sOutputField) const;
 
+	// Conversion d'un bloc au codage compact, pour reduire l'empreinte memoire des blocs conserves dans
+	// les KWObject, typiquement les blocs issus de l'analyse de textes avec de nombreuses valeurs entieres
+	// Les valeurs sont stockees en float, et les index sparse sous forme d'ecarts a l'index de la premiere valeur
+	// Le codage est sans perte: un bloc n'est compacte que si toutes ses valeurs sont representables
+	// exactement en float et si le gain memoire le justifie
+	// Le bloc compact est en lecture seule, et s'utilise de facon transparente via les methodes d'acces
+	// Memoire: renvoie soit le bloc en entree s'il n'est pas compacte, soit un nouveau bloc compact,
+	// le bloc en entree etant alors detruit
+	static KWContinuousValueBlock* Compact(KWContinuousValueBlock* valueBlock);
+
 	///////////////////////////////////////////////////////////////////////////
 	// Services pour la gestion des DataTableSliceSet, ou un bloc de valeurs
 	// peut etre decoupe sur plusieurs troncon, en sous-bloc contigus selon
@@ -390,6 +435,18 @@ protected:
 							       const char* sInputField, Continuous cDefaultValue,
 							       boolean& bOk, ALString& sMessage);
 
+	// Lecture rapide d'un champ texte dans le cas de VarKey categorielles, en une seule passe, sans creation
+	// de Symbol ni d'objet par paire (cle, valeur), et avec des index de cles directement dans le bon ordre
+	// Methode applicable uniquement si les cles du champ sont triees par ordre strictement croissant, ce qui
+	// est le cas des champs ecrits par Khiops
+	// Renvoie NULL sinon, avant tout diagnostic sur la partie du champ qui n'est pas triee
+	static KWContinuousValueBlock* BuildSortedCKeyBlockFromField(const KWIndexedCKeyBlock* indexedKeyBlock,
+								     const char* sInputField, Continuous cDefaultValue,
+								     boolean& bOk, ALString& sMessage);
+
+	// Nombre minimum de valeurs d'un bloc pour son codage compact
+	static const int nCompactMinValueNumber = 8;
+
 	// Constructeur prive
 	KWContinuousValueBlock();
 };
@@ -492,6 +549,12 @@ protected:
 							   const char* sInputField, const Symbol& sDefaultValue,
 							   boolean& bOk, ALString& sMessage);
 
+	// Lecture rapide d'un champ texte dans le cas de VarKey categorielles, si les cles du champ sont triees
+	// (cf. KWContinuousValueBlock::BuildSortedCKeyBlockFromField)
+	static KWSymbolValueBlock* BuildSortedCKeyBlockFromField(const KWIndexedCKeyBlock* indexedKeyBlock,
+								 const char* sInputField, const Symbol& sDefaultValue,
+								 boolean& bOk, ALString& sMessage);
+
 	// Constructeur prive
 	KWSymbolValueBlock();
 };
@@ -584,20 +647,24 @@ inline KWValueBlock::KWValueBlock()
 
 inline int KWValueBlock::GetValueNumber() const
 {
-	return nValueNumber;
+	return nValueNumber & nValueNumberMask;
 }
 
 inline int KWValueBlock::GetAttributeSparseIndexAt(int nValueIndex) const
 {
-	require(0 <= nValueIndex and nValueIndex < nValueNumber);
-	return (
-	    nValueNumber <= nSegmentSize
-		? ((KWValueIndexPair*)&cStartBlock)[nValueIndex].nIndex
-		: ((KWValueIndexPair**)&cStartBlock)[nValueIndex / nSegmentSize][nValueIndex % nSegmentSize].nIndex);
+	require(0 <= nValueIndex and nValueIndex < GetValueNumber());
+	if (nValueNumber <= nSegmentSize)
+		return ((KWValueIndexPair*)&cStartBlock)[nValueIndex].nIndex;
+	else if (nValueNumber > nValueNumberMask)
+		return GetCompactAttributeSparseIndexAt(nValueIndex);
+	else
+		return ((KWValueIndexPair**)&cStartBlock)[nValueIndex / nSegmentSize][nValueIndex % nSegmentSize]
+		    .nIndex;
 }
 
 inline void KWValueBlock::SetAttributeSparseIndexAt(int nValueIndex, int nSparseIndex)
 {
+	require(not IsCompact());
 	require(0 <= nValueIndex and nValueIndex < nValueNumber);
 	require(0 <= nSparseIndex);
 	if (nValueNumber <= nSegmentSize)
@@ -607,9 +674,50 @@ inline void KWValueBlock::SetAttributeSparseIndexAt(int nValueIndex, int nSparse
 		    nSparseIndex;
 }
 
+inline boolean KWValueBlock::IsCompact() const
+{
+	return nValueNumber > nValueNumberMask;
+}
+
 inline longint KWValueBlock::GetUsedMemory() const
 {
-	return sizeof(int) + nValueNumber * sizeof(KWValueIndexPair);
+	if (IsCompact())
+		return 2 * sizeof(int) + GetValueNumber() * ((longint)sizeof(float) + GetCompactIndexSize());
+	else
+		return sizeof(int) + nValueNumber * sizeof(KWValueIndexPair);
+}
+
+inline int KWValueBlock::GetCompactIndexSize() const
+{
+	return nValueNumber >> nCompactIndexSizeShift;
+}
+
+inline const void* KWValueBlock::GetCompactValues() const
+{
+	require(IsCompact());
+	return &cStartBlock + sizeof(int);
+}
+
+inline int KWValueBlock::GetCompactAttributeSparseIndexAt(int nValueIndex) const
+{
+	const char* pIndexes;
+	int nBaseSparseIndex;
+
+	require(IsCompact());
+	require(0 <= nValueIndex and nValueIndex < GetValueNumber());
+
+	// Les ecarts d'index suivent le vecteur des valeurs, stockees sur des float
+	nBaseSparseIndex = *(const int*)&cStartBlock;
+	pIndexes = &cStartBlock + sizeof(int) + GetValueNumber() * sizeof(float);
+	switch (GetCompactIndexSize())
+	{
+	case 1:
+		return nBaseSparseIndex + ((const unsigned char*)pIndexes)[nValueIndex];
+	case 2:
+		return nBaseSparseIndex + ((const unsigned short*)pIndexes)[nValueIndex];
+	default:
+		return nBaseSparseIndex + ((const int*)pIndexes)[nValueIndex];
+	}
 }
 
 // Classe KWContinuousValueBlock
@@ -634,15 +742,19 @@ inline KWContinuousValueBlock::~KWContinuousValueBlock() {}
 
 inline Continuous KWContinuousValueBlock::GetValueAt(int nValueIndex) const
 {
-	require(0 <= nValueIndex and nValueIndex < nValueNumber);
-	return (nValueNumber <= nSegmentSize
-		    ? ((KWValueIndexPair*)&cStartBlock)[nValueIndex].value.GetContinuous()
-		    : ((KWValueIndexPair**)&cStartBlock)[nValueIndex / nSegmentSize][nValueIndex % nSegmentSize]
-			  .value.GetContinuous());
+	require(0 <= nValueIndex and nValueIndex < GetValueNumber());
+	if (nValueNumber <= nSegmentSize)
+		return ((KWValueIndexPair*)&cStartBlock)[nValueIndex].value.GetContinuous();
+	else if (nValueNumber > nValueNumberMask)
+		return (Continuous)((const float*)GetCompactValues())[nValueIndex];
+	else
+		return ((KWValueIndexPair**)&cStartBlock)[nValueIndex / nSegmentSize][nValueIndex % nSegmentSize]
+		    .value.GetContinuous();
 }
 
 inline void KWContinuousValueBlock::SetValueAt(int nValueIndex, Continuous cValue)
 {
+	require(not IsCompact());
 	require(0 <= nValueIndex and nValueIndex < nValueNumber);
 	if (nValueNumber <= nSegmentSize)
 		((KWValueIndexPair*)&cStartBlock)[nValueIndex].value.SetContinuous(cValue);
@@ -239,12 +239,13 @@ public:
 	void SetAttributeSubset(KWAttributeSubsetStats* attributeSubsetStats);
 	KWAttributeSubsetStats* GetAttributeSubset();
 
-	///////////////////////////////////////////////////////////////////////////////
-	///// Implementation
-protected:
 	// Reimplementation des methodes virtuelles
 	void SerializeObject(PLSerializer* serializer, const Object* o) const override;
 	void DeserializeObject(PLSerializer* serializer, Object* o) const override;
+
+	///////////////////////////////////////////////////////////////////////////////
+	///// Implementation
+protected:
 	Object* Create() const override;
 };
 
@@ -262,11 +263,12 @@ public:
 	void SetAttributePair(KWAttributePairStats* attributeSubsetStats);
 	KWAttributePairStats* GetAttributePair();
 
-	///////////////////////////////////////////////////////////////////////////////
-	///// Implementation
-protected:
 	// Reimplementation des methodes virtuelles
 	void SerializeObject(PLSerializer* serializer, const Object* o) const override;
 	void DeserializeObject(PLSerializer* serializer, Object* o) const override;
+
+	///////////////////////////////////////////////////////////////////////////////
+	///// Implementation
+protected:
 	Object* Create() const override;
 };
@@ -10,6 +10,7 @@
 #include "KWDataPreparationUnivariateTask.h"
 #include "KWDataPreparationBivariateTask.h"
 #include "KDDataPreparationAttributeCreationTask.h"
+#include "KWDataPreparationCache.h"
 
 KWClassStats::KWClassStats()
 {
@@ -64,6 +65,11 @@ boolean KWClassStats::ComputeStats()
 	KWDatabaseSlicerTask databaseSlicerTask;
 	KWDataPreparationUnivariateTask univariateDataPreparationTask;
 	KWDataPreparationBivariateTask bivariateDataPreparationTask;
+	KWDataPreparationCache preparationCache;
+	boolean bUsePreparationCache;
+	boolean bLoadedFromPreparationCache;
+	ObjectArray oaCachedAttributeStats;
+	ObjectArray oaCachedAttributePairStats;
 	ObjectDictionary odUnivariateAttributeStats;
 	ObjectDictionary* odTreeInputAttributeStats;
 	longint lRecordNumber;
@@ -99,6 +105,10 @@ boolean KWClassStats::ComputeStats()
 	assert(timerTotal.GetElapsedTime() == 0);
 	timerTotal.Start();
 
+	// Initialisation du cache des resultats de preparation, avant toute modification du domaine
+	bUsePreparationCache = preparationCache.Initialize(GetLearningSpec(), attributePairSpec);
+	bLoadedFromPreparationCache = false;
+
 	// Collecte du nombre d'enregistrements et des valeurs cibles
 	nDatabaseObjectNumber = 0;
 	lRecordNumber = 0;
@@ -268,9 +278,27 @@ boolean KWClassStats::ComputeStats()
 	bOk = bOk and not TaskProgression::IsInterruptionRequested();
 	if (bOk)
 	{
-		// La tache gere sa propre progression
-		bOk = univariateDataPreparationTask.CollectPreparationStats(
-		    GetLearningSpec(), &tupleTableLoader, dataTableSliceSet, &odUnivariateAttributeStats);
+		// Recherche des resultats de preparation dans le cache
+		if (bUsePreparationCache)
+			bLoadedFromPreparationCache = preparationCache.Load(GetLearningSpec(), &oaCachedAttributeStats,
+									    &oaCachedAttributePairStats);
+
+		// Reprise des preparations univariees du cache
+		if (bLoadedFromPreparationCache)
+		{
+			AddSimpleMessage("Data preparation results read from cache file " +
+					 preparationCache.GetCacheFileName());
+			for (i = 0; i < oaCachedAttributeStats.GetSize(); i++)
+			{
+				attributeStats = cast(KWAttributeStats*, oaCachedAttributeStats.GetAt(i));
+				odUnivariateAttributeStats.SetAt(attributeStats->GetAttributeName(), attributeStats);
+			}
+			oaCachedAttributeStats.RemoveAll();
+		}
+		// Sinon, la tache gere sa propre progression
+		else
+			bOk = univariateDataPreparationTask.CollectPreparationStats(
+			    GetLearningSpec(), &tupleTableLoader, dataTableSliceSet, &odUnivariateAttributeStats);
 
 		// On range les statistiques par attributs dans le meme ordre que dans la classe initiale
 		if (bOk)
@@ -322,10 +350,21 @@ boolean KWClassStats::ComputeStats()
 		// qui peuvent utiliser les variables de type texte
 		UseUnivariateBasicSelectionCosts(true);
 
-		// La tache gere sa propre progression
-		bIsStatsComputed = true;
-		bOk = bivariateDataPreparationTask.CollectPreparationPairStats(
-		    GetLearningSpec(), this, &tupleTableLoader, dataTableSliceSet, &oaAttributePairStats);
+		// Reprise des preparations bivariees du cache
+		if (bLoadedFromPreparationCache)
+		{
+			oaAttributePairStats.CopyFrom(&oaCachedAttributePairStats);
+			oaCachedAttributePairStats.RemoveAll();
+			for (i = 0; i < oaAttributePairStats.GetSize(); i++)
+				cast(KWAttributePairStats*, oaAttributePairStats.GetAt(i))->SetClassStats(this);
+		}
+		// Sinon, la tache gere sa propre progression
+		else
+		{
+			bIsStatsComputed = true;
+			bOk = bivariateDataPreparationTask.CollectPreparationPairStats(
+			    GetLearningSpec(), this, &tupleTableLoader, dataTableSliceSet, &oaAttributePairStats);
+		}
 
 		// Collecte des resultats dans le tableau de toutes les stats de preparation
 		oaAllPreparedStats.InsertObjectArrayAt(oaAllPreparedStats.GetSize(), &oaAttributePairStats);
@@ -391,6 +430,18 @@ boolean KWClassStats::ComputeStats()
 		RestoreUnivariateSelectionCosts(GetLearningSpec()->GetTextConstructionUsedByTrees());
 	}
 
+	// Memorisation des resultats de preparation dans le cache
+	assert(oaCachedAttributeStats.GetSize() == 0);
+	oaCachedAttributePairStats.DeleteAll();
+	if (bOk and bUsePreparationCache and not bLoadedFromPreparationCache and
+	    not TaskProgression::IsInterruptionRequested())
+	{
+		oaCachedAttributeStats.CopyFrom(&oaAttributeStats);
+		oaCachedAttributeStats.InsertObjectArrayAt(oaCachedAttributeStats.GetSize(), &oaTextAttributeStats);
+		preparationCache.Save(&oaCachedAttributeStats, &oaAttributePairStats);
+		oaCachedAttributeStats.RemoveAll();
+	}
+
 	// Temps final
 	timerTotal.Stop();
 
@@ -23,6 +23,12 @@ void KWDRRegisterDataGridRules()
 ///////////////////////////////////////////////////////////////
 // Classe KWDRDataGrid
 
+const ALString KWDRDataGrid::sIntervalBoundsStructureName = "IntervalBounds";
+const ALString KWDRDataGrid::sContinuousValueSetStructureName = "ValueSet";
+const ALString KWDRDataGrid::sValueGroupsStructureName = "ValueGroups";
+const ALString KWDRDataGrid::sSymbolValueSetStructureName = "ValueSetC";
+const ALString KWDRDataGrid::sFrequenciesStructureName = "Frequencies";
+
 KWDRDataGrid::KWDRDataGrid()
 {
 	SetName("DataGrid");
@@ -222,10 +228,6 @@ void KWDRDataGrid::ImportDataGridStats(const KWDataGridStats* dataGridStats, boo
 
 void KWDRDataGrid::ExportDataGridStats(KWDataGridStats* dataGridStats) const
 {
-	const KWDRIntervalBounds intervalBoundsRefRule;
-	const KWDRValueGroups valueGroupsRefRule;
-	const KWDRContinuousValueSet continuousValueSetRefRule;
-	const KWDRSymbolValueSet symbolValueSetRefRule;
 	const ALString sAttributePrefix = "Var";
 	KWDerivationRuleOperand* operand;
 	KWDRFrequencies* frequenciesRule;
@@ -317,7 +319,7 @@ void KWDRDataGrid::ExportDataGridStats(KWDataGridStats* dataGridStats) const
 		// Creation d'un attribut de grille en fonction de type de l'operande
 		// Cas d'une discretisation
 		attributePartition = NULL;
-		if (operand->GetStructureName() == intervalBoundsRefRule.GetStructureName())
+		if (operand->GetStructureName() == sIntervalBoundsStructureName)
 		{
 			const KWDRIntervalBounds* intervalBoundsRule;
 			KWDGSAttributeDiscretization* attributeDiscretization;
@@ -335,7 +337,7 @@ void KWDRDataGrid::ExportDataGridStats(KWDataGridStats* dataGridStats) const
 			attributePartition->SetGranularizedValueNumber(nTotalFrequency);
 		}
 		// Cas d'un ensemble de valeurs continues
-		else if (operand->GetStructureName() == continuousValueSetRefRule.GetStructureName())
+		else if (operand->GetStructureName() == sContinuousValueSetStructureName)
 		{
 			const KWDRContinuousValueSet* continuousValueSetRule;
 			KWDGSAttributeContinuousValues* attributeContinuousValues;
@@ -353,7 +355,7 @@ void KWDRDataGrid::ExportDataGridStats(KWDataGridStats* dataGridStats) const
 			attributePartition->SetGranularizedValueNumber(nTotalFrequency);
 		}
 		// Cas d'un groupement de valeurs
-		else if (operand->GetStructureName() == valueGroupsRefRule.GetStructureName())
+		else if (operand->GetStructureName() == sValueGroupsStructureName)
 		{
 			KWDRValueGroups* valueGroupsRule;
 			KWDGSAttributeGrouping* attributeGrouping;
@@ -371,7 +373,7 @@ void KWDRDataGrid::ExportDataGridStats(KWDataGridStats* dataGridStats) const
 			attributePartition->SetGranularizedValueNumber(valueGroupsRule->GetTotalPartValueNumber());
 		}
 		// Cas d'un ensemble de valeurs symboliques
-		else if (operand->GetStructureName() == symbolValueSetRefRule.GetStructureName())
+		else if (operand->GetStructureName() == sSymbolValueSetStructureName)
 		{
 			const KWDRSymbolValueSet* symbolValueSetRule;
 			KWDGSAttributeSymbolValues* attributeSymbolValues;
@@ -428,7 +430,6 @@ void KWDRDataGrid::ExportDataGridStats(KWDataGridStats* dataGridStats) const
 int KWDRDataGrid::GetUncheckedAttributeNumber() const
 {
 	int nUncheckedAttributeNumber;
-	KWDRFrequencies frequenciesRule;
 	int nOperand;
 	KWDerivationRuleOperand* operand;
 
@@ -440,7 +441,7 @@ int KWDRDataGrid::GetUncheckedAttributeNumber() const
 
 		// On arrete quand on a trouve le premier operande de type Frequencies
 		if (operand->GetType() == KWType::Structure and
-		    operand->GetStructureName() == frequenciesRule.GetStructureName())
+		    operand->GetStructureName() == sFrequenciesStructureName)
 		{
 			nUncheckedAttributeNumber = nOperand;
 			break;
@@ -497,11 +498,6 @@ Object* KWDRDataGrid::ComputeStructureResult(const KWObject* kwoObject) const
 boolean KWDRDataGrid::CheckOperandsFamily(const KWDerivationRule* ruleFamily) const
 {
 	boolean bOk = true;
-	KWDRIntervalBounds intervalBoundsRule;
-	KWDRContinuousValueSet continuousValueSetRule;
-	KWDRValueGroups valueGroupsRule;
-	KWDRSymbolValueSet symbolValueSetRule;
-	KWDRFrequencies frequenciesRule;
 	int nAttributeNumber;
 	int nAttribute;
 	int nOperand;
@@ -564,16 +560,16 @@ boolean KWDRDataGrid::CheckOperandsFamily(const KWDerivationRule* ruleFamily) co
 			assert(operand->GetDerivationRule() != NULL);
 
 			// Verification d'une structure de partition univariee
-			if (operand->GetStructureName() != intervalBoundsRule.GetName() and
-			    operand->GetStructureName() != valueGroupsRule.GetName() and
-			    operand->GetStructureName() != continuousValueSetRule.GetName() and
-			    operand->GetStructureName() != symbolValueSetRule.GetName())
+			if (operand->GetStructureName() != sIntervalBoundsStructureName and
+			    operand->GetStructureName() != sValueGroupsStructureName and
+			    operand->GetStructureName() != sContinuousValueSetStructureName and
+			    operand->GetStructureName() != sSymbolValueSetStructureName)
 			{
 				bOk = false;
 				AddError(sTmp + "Incorrect structure(" + operand->GetStructureName() +
 					 ") for operand " + IntToString(nOperand + 1) + " (must be " +
-					 intervalBoundsRule.GetName() + " or " + valueGroupsRule.GetName() + " or " +
-					 continuousValueSetRule.GetName() + " or " + symbolValueSetRule.GetName() +
+					 sIntervalBoundsStructureName + " or " + sValueGroupsStructureName + " or " +
+					 sContinuousValueSetStructureName + " or " + sSymbolValueSetStructureName +
 					 ")");
 				break;
 			}
@@ -589,11 +585,11 @@ boolean KWDRDataGrid::CheckOperandsFamily(const KWDerivationRule* ruleFamily) co
 		assert(operand->GetDerivationRule() != NULL);
 
 		// Verification d'une structure de type effectifs
-		if (operand->GetStructureName() != frequenciesRule.GetName())
+		if (operand->GetStructureName() != sFrequenciesStructureName)
 		{
 			bOk = false;
 			AddError(sTmp + "Incorrect structure(" + operand->GetStructureName() + ") for operand " +
-				 IntToString(nAttributeNumber + 1) + "(must be " + frequenciesRule.GetName() + ")");
+				 IntToString(nAttributeNumber + 1) + "(must be " + sFrequenciesStructureName + ")");
 		}
 		else
 		{
@@ -724,12 +720,12 @@ boolean KWDRDataGrid::CheckOperandsFamily(const KWDerivationRule* ruleFamily) co
 				break;
 			}
 			// Verification d'une structure de type effectifs
-			else if (operand->GetStructureName() != frequenciesRule.GetName())
+			else if (operand->GetStructureName() != sFrequenciesStructureName)
 			{
 				bOk = false;
 				AddError(sTmp + "Incorrect structure(" + operand->GetStructureName() +
 					 ") for operand " + IntToString(nOperand + 1) + "(must be " +
-					 frequenciesRule.GetName() + ")");
+					 sFrequenciesStructureName + ")");
 			}
 			// Verification de la taille du vecteur d'effectif
 			else
@@ -762,17 +758,17 @@ boolean KWDRDataGrid::CheckOperandsFamily(const KWDerivationRule* ruleFamily) co
 						// Traitement de chaque type de partition
 						nValueNumber = 0;
 						if (univariatePartition->GetStructureName() !=
-						    intervalBoundsRule.GetName())
+						    sIntervalBoundsStructureName)
 							nValueNumber = nTotalFrequency;
 						else if (univariatePartition->GetStructureName() !=
-							 continuousValueSetRule.GetName())
+							 sContinuousValueSetStructureName)
 							nValueNumber = nTotalFrequency;
 						else if (univariatePartition->GetStructureName() !=
-							 valueGroupsRule.GetName())
+							 sValueGroupsStructureName)
 							nValueNumber = cast(KWDRValueGroups*, univariatePartition)
 									   ->ComputeTotalPartValueNumber();
 						else if (univariatePartition->GetStructureName() !=
-							 symbolValueSetRule.GetName())
+							 sSymbolValueSetStructureName)
 							nValueNumber = cast(KWDRSymbolValueSet*, univariatePartition)
 									   ->GetValueNumber();
 
@@ -819,18 +815,14 @@ boolean KWDRDataGrid::CheckOperandsFamily(const KWDerivationRule* ruleFamily) co
 boolean KWDRDataGrid::SilentCheckUnivariatePartitionOperand(const KWDerivationRuleOperand* operand) const
 {
 	boolean bOk;
-	KWDRIntervalBounds intervalBoundsRule;
-	KWDRContinuousValueSet continuousValueSetRule;
-	KWDRValueGroups valueGroupsRule;
-	KWDRSymbolValueSet symbolValueSetRule;
 
 	require(operand != NULL);
 
 	bOk = operand->GetType() == KWType::Structure and operand->GetDerivationRule() != NULL and
-	      (operand->GetStructureName() != valueGroupsRule.GetName() or
-	       operand->GetStructureName() != continuousValueSetRule.GetName() or
-	       operand->GetStructureName() != symbolValueSetRule.GetName() or
-	       operand->GetStructureName() != symbolValueSetRule.GetName());
+	      (operand->GetStructureName() != sValueGroupsStructureName or
+	       operand->GetStructureName() != sContinuousValueSetStructureName or
+	       operand->GetStructureName() != sSymbolValueSetStructureName or
+	       operand->GetStructureName() != sSymbolValueSetStructureName);
 	return bOk;
 }
 
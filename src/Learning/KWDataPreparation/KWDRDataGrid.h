@@ -133,6 +133,16 @@ public:
 	// Calcul de l'effectif total de la grille, en mode non checke (renvoie -1 si erreur)
 	int ComputeUncheckedTotalFrequency() const;
 
+	// Noms des structures des operandes de la grille (partitions univariees et effectifs)
+	// Ils sont memorises une fois pour toutes, ce qui evite de construire des regles de reference
+	// a chaque verification ou export d'une grille, couteux lors du chargement des dictionnaires
+	// de modeles comportant de tres nombreuses grilles
+	static const ALString sIntervalBoundsStructureName;
+	static const ALString sContinuousValueSetStructureName;
+	static const ALString sValueGroupsStructureName;
+	static const ALString sSymbolValueSetStructureName;
+	static const ALString sFrequenciesStructureName;
+
 	//////////////////////////////////////////////////////
 	// Redefinition des methodes standard
 
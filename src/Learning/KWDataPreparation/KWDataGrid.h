@@ -1506,6 +1506,9 @@ public:
 	void SetTargetFrequencyAt(int nTarget, int nFrequency);
 	void UpgradeTargetFrequencyAt(int nTarget, int nDeltaFrequency);
 
+	// Acces direct au vecteur des effectifs par classe cible, pour les calculs de cout
+	const IntVector* GetTargetFrequencies() const;
+
 	// Mise a jour du contenu d'une cellule en prenant en compte le contenu d'une autre cellule
 	void AddFrequenciesFrom(const KWDGCell* cell);
 	void RemoveFrequenciesFrom(const KWDGCell* cell);
@@ -2476,6 +2479,11 @@ inline int KWDGCell::GetTargetValueNumber() const
 	return ivFrequencyVector.GetSize();
 }
 
+inline const IntVector* KWDGCell::GetTargetFrequencies() const
+{
+	return &ivFrequencyVector;
+}
+
 inline int KWDGCell::GetTargetFrequencyAt(int nTarget) const
 {
 	require(0 <= nTarget and nTarget < GetTargetValueNumber());
@@ -1268,26 +1268,12 @@ double KWDataGridClassificationCosts::ComputePartUnionCost(const KWDGPart* part1
 double KWDataGridClassificationCosts::ComputeCellCost(const KWDGCell* cell) const
 {
 	double dCellCost;
-	int nTargetValueNumber;
-	int nFrequency;
-	int nCellFrequency;
-	int i;
 
 	require(cell != NULL);
 	require(cell->GetTargetValueNumber() >= 1);
 
 	// Cout de codage des instances de la ligne et de la loi multinomiale de la ligne
-	dCellCost = 0;
-	nCellFrequency = 0;
-	nTargetValueNumber = cell->GetTargetValueNumber();
-	for (i = 0; i < nTargetValueNumber; i++)
-	{
-		nFrequency = cell->GetTargetFrequencyAt(i);
-		dCellCost -= KWStat::LnFactorial(nFrequency);
-		nCellFrequency += nFrequency;
-	}
-	dCellCost += KWStat::LnFactorial(nCellFrequency + nTargetValueNumber - 1);
-	dCellCost -= KWStat::LnFactorial(nTargetValueNumber - 1);
+	dCellCost = KWStat::LnMultinomialCellCost(cell->GetTargetFrequencies(), cell->GetTargetValueNumber());
 	return dCellCost;
 }
 // CH IV Begin
@@ -0,0 +1,404 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#include "KWDataPreparationCache.h"
+#include "KDDataPreparationAttributeCreationTask.h"
+#include "KWSTDatabaseTextFile.h"
+#include "KWMTDatabaseTextFile.h"
+
+const char* KWDataPreparationCache::sCacheFileHeader = "KhiopsDataPreparationCache";
+
+KWDataPreparationCache::KWDataPreparationCache() {}
+
+KWDataPreparationCache::~KWDataPreparationCache() {}
+
+boolean KWDataPreparationCache::IsEnabled()
+{
+	return GetPreparationCacheDirectory() != "";
+}
+
+boolean KWDataPreparationCache::Initialize(const KWLearningSpec* learningSpec,
+					   const KWAttributePairsSpec* attributePairsSpec)
+{
+	KWDatabase* database;
+	ObjectArray oaUsedFileSpecs;
+	FileSpec* fileSpec;
+	ObjectArray* oaSpecificAttributePairs;
+	KWAttributePairName* attributePairName;
+	ostringstream ossKey;
+	int i;
+
+	require(learningSpec != NULL);
+	require(learningSpec->Check());
+	require(attributePairsSpec != NULL);
+
+	// Reinitialisation
+	sKey = "";
+	sCacheFileName = "";
+
+	// Pas de cache s'il n'est pas actif
+	if (not IsEnabled())
+		return false;
+
+	// Pas de cache si des arbres sont a construire, leur construction n'etant pas memorisee
+	if (KDDataPreparationAttributeCreationTask::GetGlobalCreationTask() != NULL and
+	    KDDataPreparationAttributeCreationTask::GetGlobalCreationTask()->GetMaxCreatedAttributeNumber() > 0)
+		return false;
+
+	// Pas de cache si la base n'est pas issue de fichiers, ou si ses instances sont selectionnees par marquage
+	database = learningSpec->GetDatabase();
+	if (database->GetTechnologyName() == "" or database->GetMarkedInstances()->GetSize() > 0)
+		return false;
+
+	// Version de l'outil, et mode de compilation qui impacte le format de serialisation
+	ossKey << "Version\t" << GetLearningVersion() << "\n";
+	debug(ossKey << "Debug\n");
+
+	// Parametres d'apprentissage
+	ossKey << "Target\t" << learningSpec->GetTargetAttributeName() << "\t"
+	       << learningSpec->GetMainTargetModality() << "\n";
+	ossKey << "Initial variables\t" << learningSpec->GetInitialAttributeNumber() << "\n";
+	ossKey << "Construction\t" << learningSpec->GetMultiTableConstruction() << "\t"
+	       << learningSpec->GetTextConstruction() << "\t" << learningSpec->GetTrees() << "\t"
+	       << learningSpec->GetAttributePairs() << "\n";
+	ossKey << *cast(KWLearningSpec*, learningSpec)->GetPreprocessingSpec();
+
+	// Parametres des paires de variables
+	ossKey << *attributePairsSpec;
+	oaSpecificAttributePairs = cast(KWAttributePairsSpec*, attributePairsSpec)->GetSpecificAttributePairs();
+	for (i = 0; i < oaSpecificAttributePairs->GetSize(); i++)
+	{
+		attributePairName = cast(KWAttributePairName*, oaSpecificAttributePairs->GetAt(i));
+		ossKey << "Pair\t" << attributePairName->GetFirstName() << "\t" << attributePairName->GetSecondName()
+		       << "\n";
+	}
+
+	// Specification de la base
+	ossKey << "Database\t" << database->GetTechnologyName() << "\t" << database->GetDatabaseName() << "\n";
+	ossKey << "Sample\t" << database->GetSampleNumberPercentage() << "\t" << database->GetSamplingMode() << "\n";
+	ossKey << "Selection\t" << database->GetSelectionAttribute() << "\t" << database->GetSelectionValue() << "\n";
+	if (database->GetTechnologyName() == "Single table text file")
+		ossKey << "Format\t" << cast(KWSTDatabaseTextFile*, database)->GetHeaderLineUsed() << "\t"
+		       << (int)cast(KWSTDatabaseTextFile*, database)->GetFieldSeparator() << "\n";
+	else if (database->GetTechnologyName() == "Multiple table text file")
+		ossKey << "Format\t" << cast(KWMTDatabaseTextFile*, database)->GetHeaderLineUsed() << "\t"
+		       << (int)cast(KWMTDatabaseTextFile*, database)->GetFieldSeparator() << "\n";
+
+	// Empreinte des fichiers de la base
+	database->ExportUsedFileSpecs(&oaUsedFileSpecs);
+	for (i = 0; i < oaUsedFileSpecs.GetSize(); i++)
+	{
+		fileSpec = cast(FileSpec*, oaUsedFileSpecs.GetAt(i));
+		ossKey << "File\t" << fileSpec->GetLabel() << "\t" << fileSpec->GetFilePathName() << "\t"
+		       << ComputeFileFingerprint(fileSpec->GetFilePathName()) << "\n";
+	}
+	oaUsedFileSpecs.DeleteAll();
+
+	// Dictionnaires de la preparation
+	ossKey << *learningSpec->GetClass()->GetDomain();
+
+	// Memorisation de la cle et du nom du fichier de cache associe
+	sKey = ossKey.str().c_str();
+	sCacheFileName = FileService::BuildFilePathName(
+	    GetPreparationCacheDirectory(),
+	    ALString("Preparation_") + IntToString((int)((unsigned int)HashValue(sKey) >> 1)) + "_" +
+		IntToString(sKey.GetLength()) + ".cache");
+	return true;
+}
+
+boolean KWDataPreparationCache::IsInitialized() const
+{
+	return sKey != "";
+}
+
+const ALString& KWDataPreparationCache::GetCacheFileName() const
+{
+	require(IsInitialized());
+	return sCacheFileName;
+}
+
+boolean KWDataPreparationCache::Load(KWLearningSpec* learningSpec, ObjectArray* oaAttributeStats,
+				     ObjectArray* oaAttributePairStats)
+{
+	boolean bOk;
+	FILE* fFile;
+	char sHeaderLine[256];
+	ALString sHeader;
+	ALString sExpectedHeader;
+	char* sFileKey;
+	int nPayloadSize;
+	CharVector cvPayload;
+	PLSerializer serializer;
+	PLShared_AttributeStats sharedAttributeStats;
+	PLShared_AttributePairStats sharedAttributePairStats;
+	KWAttributeStats* attributeStats;
+	KWAttributePairStats* attributePairStats;
+	int nNumber;
+	int i;
+
+	require(IsInitialized());
+	require(learningSpec != NULL);
+	require(oaAttributeStats != NULL and oaAttributeStats->GetSize() == 0);
+	require(oaAttributePairStats != NULL and oaAttributePairStats->GetSize() == 0);
+
+	// Arret si pas de fichier de cache
+	if (not FileService::FileExists(sCacheFileName))
+		return false;
+
+	// Les problemes d'acces au cache ne sont pas bloquants
+	Global::SetErrorAsWarningMode(true);
+	fFile = NULL;
+	bOk = FileService::OpenInputBinaryFile(sCacheFileName, fFile);
+
+	// Lecture et verification de l'entete, qui contient la taille de la cle et du contenu serialise
+	nPayloadSize = 0;
+	if (bOk)
+	{
+		bOk = fgets(sHeaderLine, sizeof(sHeaderLine), fFile) != NULL;
+		if (bOk)
+		{
+			sHeader = sHeaderLine;
+			sHeader.TrimRight();
+			sExpectedHeader = ALString(sCacheFileHeader) + "\t" + IntToString(sKey.GetLength()) + "\t";
+			bOk = sHeader.Left(sExpectedHeader.GetLength()) == sExpectedHeader;
+		}
+		if (bOk)
+		{
+			nPayloadSize = StringToInt(sHeader.Mid(sExpectedHeader.GetLength()));
+			bOk = nPayloadSize > 0;
+		}
+	}
+
+	// Verification de la cle
+	if (bOk)
+	{
+		sFileKey = NewCharArray(sKey.GetLength());
+		bOk = fread(sFileKey, 1, sKey.GetLength(), fFile) == (size_t)sKey.GetLength() and
+		      memcmp(sFileKey, (const char*)sKey, sKey.GetLength()) == 0;
+		DeleteCharArray(sFileKey);
+	}
+
+	// Lecture du contenu serialise
+	if (bOk)
+		bOk = ReadCharVector(fFile, nPayloadSize, &cvPayload);
+	if (fFile != NULL)
+		FileService::CloseInputBinaryFile(sCacheFileName, fFile);
+	Global::SetErrorAsWarningMode(false);
+
+	// Deserialisation des resultats de preparation
+	if (bOk)
+	{
+		serializer.ImportBuffer(&cvPayload);
+		serializer.OpenForRead(NULL);
+
+		// Statistiques univariees
+		nNumber = serializer.GetInt();
+		for (i = 0; i < nNumber; i++)
+		{
+			attributeStats = new KWAttributeStats;
+			sharedAttributeStats.DeserializeObject(&serializer, attributeStats);
+			attributeStats->SetLearningSpec(learningSpec);
+			oaAttributeStats->Add(attributeStats);
+		}
+
+		// Statistiques bivariees
+		nNumber = serializer.GetInt();
+		for (i = 0; i < nNumber; i++)
+		{
+			attributePairStats = new KWAttributePairStats;
+			sharedAttributePairStats.DeserializeObject(&serializer, attributePairStats);
+			attributePairStats->SetLearningSpec(learningSpec);
+			oaAttributePairStats->Add(attributePairStats);
+		}
+		serializer.Close();
+	}
+	return bOk;
+}
+
+boolean KWDataPreparationCache::Save(const ObjectArray* oaAttributeStats,
+				     const ObjectArray* oaAttributePairStats) const
+{
+	boolean bOk;
+	PLSerializer serializer;
+	PLShared_AttributeStats sharedAttributeStats;
+	PLShared_AttributePairStats sharedAttributePairStats;
+	CharVector cvPayload;
+	FILE* fFile;
+	ALString sHeader;
+	int i;
+
+	require(IsInitialized());
+	require(oaAttributeStats != NULL);
+	require(oaAttributePairStats != NULL);
+
+	// Serialisation des resultats de preparation
+	serializer.OpenForWrite(NULL);
+	serializer.PutInt(oaAttributeStats->GetSize());
+	for (i = 0; i < oaAttributeStats->GetSize(); i++)
+		sharedAttributeStats.SerializeObject(&serializer, oaAttributeStats->GetAt(i));
+	serializer.PutInt(oaAttributePairStats->GetSize());
+	for (i = 0; i < oaAttributePairStats->GetSize(); i++)
+		sharedAttributePairStats.SerializeObject(&serializer, oaAttributePairStats->GetAt(i));
+	serializer.Close();
+	serializer.ExportBuffer(&cvPayload);
+
+	// Les problemes d'acces au cache ne sont pas bloquants
+	Global::SetErrorAsWarningMode(true);
+
+	// Ecriture du fichier: entete, cle puis contenu serialise
+	fFile = NULL;
+	bOk = FileService::MakeDirectories(GetPreparationCacheDirectory());
+	if (bOk)
+		bOk = FileService::OpenOutputBinaryFile(sCacheFileName, fFile);
+	if (bOk)
+	{
+		sHeader = ALString(sCacheFileHeader) + "\t" + IntToString(sKey.GetLength()) + "\t" +
+			  IntToString(cvPayload.GetSize()) + "\n";
+		bOk = fwrite((const char*)sHeader, 1, sHeader.GetLength(), fFile) == (size_t)sHeader.GetLength();
+		bOk = bOk and fwrite((const char*)sKey, 1, sKey.GetLength(), fFile) == (size_t)sKey.GetLength();
+		bOk = bOk and WriteCharVector(fFile, &cvPayload);
+		bOk = FileService::CloseOutputBinaryFile(sCacheFileName, fFile) and bOk;
+
+		// Pas de fichier partiel dans le cache
+		if (not bOk)
+			FileService::RemoveFile(sCacheFileName);
+	}
+	if (not bOk)
+		AddWarning("Unable to write data preparation cache file " + sCacheFileName);
+	Global::SetErrorAsWarningMode(false);
+	return bOk;
+}
+
+const ALString KWDataPreparationCache::GetClassLabel() const
+{
+	return "Data preparation cache";
+}
+
+const ALString KWDataPreparationCache::GetObjectLabel() const
+{
+	return sCacheFileName;
+}
+
+const ALString KWDataPreparationCache::ComputeFileFingerprint(const ALString& sFileURI)
+{
+	ALString sFingerprint;
+	InputBufferedFile inputFile;
+	longint lFileSize;
+	longint lModificationTime;
+	longint lBeginPos;
+	int nHashValue;
+	int nSample;
+	boolean bOk;
+
+	// Taille du fichier
+	lFileSize = PLRemoteFileService::GetFileSize(sFileURI);
+
+	// Date de modification pour les fichiers locaux
+	lModificationTime = 0;
+	if (FileService::IsLocalURI(sFileURI))
+		lModificationTime = FileService::GetFileModificationTime(FileService::GetURIFilePathName(sFileURI));
+
+	// Valeur de hash d'un echantillon de blocs, repartis uniformement du debut a la fin du fichier
+	nHashValue = 0;
+	inputFile.SetFileName(sFileURI);
+	inputFile.SetUTF8BomManagement(false);
+	inputFile.SetBufferSize(InputBufferedFile::GetMinBufferSize());
+	bOk = lFileSize > 0 and inputFile.Open();
+	if (bOk)
+	{
+		for (nSample = 0; nSample < nFingerprintSampleNumber; nSample++)
+		{
+			lBeginPos = 0;
+			if (lFileSize > inputFile.GetBufferSize())
+				lBeginPos =
+				    (lFileSize - inputFile.GetBufferSize()) * nSample / (nFingerprintSampleNumber - 1);
+			bOk = inputFile.FillBytes(lBeginPos);
+			if (not bOk)
+				break;
+			nHashValue = UpdateBufferHashValue(nHashValue, inputFile.GetCache(),
+							   inputFile.GetBufferStartInCache(),
+							   inputFile.GetCurrentBufferSize());
+		}
+		inputFile.Close();
+	}
+	sFingerprint = ALString(LongintToString(lFileSize)) + "\t" + LongintToString(lModificationTime) + "\t" +
+		       IntToString(nHashValue);
+	return sFingerprint;
+}
+
+int KWDataPreparationCache::UpdateBufferHashValue(int nHashValue, const CharVector* cvBuffer, int nBegin,
+						  int nLength)
+{
+	unsigned int nHash;
+	int i;
+
+	require(cvBuffer != NULL);
+	require(0 <= nBegin and nBegin + nLength <= cvBuffer->GetSize());
+
+	nHash = (unsigned int)nHashValue;
+	for (i = nBegin; i < nBegin + nLength; i++)
+	{
+		nHash += (unsigned char)cvBuffer->GetAt(i);
+		nHash += (nHash << 10);
+		nHash ^= (nHash >> 6);
+	}
+	nHash += (nHash << 3);
+	nHash ^= (nHash >> 11);
+	nHash += (nHash << 15);
+	return (int)nHash;
+}
+
+boolean KWDataPreparationCache::WriteCharVector(FILE* fFile, const CharVector* cvBuffer)
+{
+	boolean bOk = true;
+	char* sChunk;
+	int nChunkSize;
+	int nPos;
+
+	require(fFile != NULL);
+	require(cvBuffer != NULL);
+
+	// Ecriture par morceaux de la taille d'un bloc
+	sChunk = NewCharArray(InputBufferedFile::GetMinBufferSize());
+	for (nPos = 0; nPos < cvBuffer->GetSize(); nPos += nChunkSize)
+	{
+		nChunkSize = cvBuffer->GetSize() - nPos;
+		if (nChunkSize > InputBufferedFile::GetMinBufferSize())
+			nChunkSize = InputBufferedFile::GetMinBufferSize();
+		cvBuffer->ExportBuffer(nPos, nChunkSize, sChunk);
+		bOk = fwrite(sChunk, 1, nChunkSize, fFile) == (size_t)nChunkSize;
+		if (not bOk)
+			break;
+	}
+	DeleteCharArray(sChunk);
+	return bOk;
+}
+
+boolean KWDataPreparationCache::ReadCharVector(FILE* fFile, int nSize, CharVector* cvBuffer)
+{
+	boolean bOk = true;
+	char* sChunk;
+	int nChunkSize;
+	int nPos;
+
+	require(fFile != NULL);
+	require(nSize >= 0);
+	require(cvBuffer != NULL);
+
+	// Lecture par morceaux de la taille d'un bloc
+	cvBuffer->SetSize(nSize);
+	sChunk = NewCharArray(InputBufferedFile::GetMinBufferSize());
+	for (nPos = 0; nPos < nSize; nPos += nChunkSize)
+	{
+		nChunkSize = nSize - nPos;
+		if (nChunkSize > InputBufferedFile::GetMinBufferSize())
+			nChunkSize = InputBufferedFile::GetMinBufferSize();
+		bOk = fread(sChunk, 1, nChunkSize, fFile) == (size_t)nChunkSize;
+		if (not bOk)
+			break;
+		cvBuffer->ImportBuffer(nPos, nChunkSize, sChunk);
+	}
+	DeleteCharArray(sChunk);
+	return bOk;
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#pragma once
+
+class KWDataPreparationCache;
+
+#include "KWLearningSpec.h"
+#include "KWAttributePairsSpec.h"
+#include "KWAttributeStats.h"
+#include "KWAttributeSubsetStats.h"
+#include "PLSerializer.h"
+#include "InputBufferedFile.h"
+#include "KWVersion.h"
+
+/////////////////////////////////////////////////////////////////////////////////
+// Classe KWDataPreparationCache
+// Cache sur disque des resultats de preparation des donnees (KWAttributeStats et KWAttributePairStats)
+// Le cache est active par le parametre expert KhiopsPreparationCacheDirectory (cf. GetPreparationCacheDirectory),
+// qui indique le repertoire des fichiers de cache.
+// Une preparation est identifiee par une cle construite a partir de tout ce dont elle depend:
+//   . version de l'outil
+//   . parametres d'apprentissage: cible, pretraitements, familles de construction, paires de variables
+//   . specification de la base: technologie, echantillonnage, selection
+//   . empreinte des fichiers de la base: taille, date de modification et valeur de hash d'un echantillon de blocs
+//   . dictionnaires de la preparation
+// Chaque fichier de cache memorise sa cle en entete, ce qui permet de verifier la correspondance exacte
+// au chargement, independamment des eventuelles collisions sur le nom du fichier
+class KWDataPreparationCache : public Object
+{
+public:
+	// Constructeur
+	KWDataPreparationCache();
+	~KWDataPreparationCache();
+
+	// Indique si le cache est actif
+	static boolean IsEnabled();
+
+	// Initialisation du cache pour une preparation, en calculant sa cle et le nom du fichier de cache associe
+	// Doit etre appele avant toute modification du domaine de la preparation
+	// Renvoie false si la preparation ne peut etre mise en cache: cache inactif, base sans fichier,
+	// instances selectionnees par marquage (comme en cross-validation) ou construction d'arbres demandee
+	boolean Initialize(const KWLearningSpec* learningSpec, const KWAttributePairsSpec* attributePairsSpec);
+	boolean IsInitialized() const;
+
+	// Nom du fichier de cache, disponible apres initialisation
+	const ALString& GetCacheFileName() const;
+
+	// Chargement des resultats de preparation s'ils sont presents dans le cache avec la meme cle
+	// En sortie, les tableaux contiennent les KWAttributeStats (variables natives, construites ou de type texte)
+	// et les KWAttributePairStats, parametres avec le learningSpec, et appartenant a l'appelant
+	// Renvoie false si la preparation n'est pas disponible dans le cache
+	boolean Load(KWLearningSpec* learningSpec, ObjectArray* oaAttributeStats, ObjectArray* oaAttributePairStats);
+
+	// Sauvegarde des resultats de preparation dans le cache
+	// Les erreurs d'ecriture sont signalees par un warning, le cache n'etant qu'une optimisation
+	boolean Save(const ObjectArray* oaAttributeStats, const ObjectArray* oaAttributePairStats) const;
+
+	// Libelles utilisateur
+	const ALString GetClassLabel() const override;
+	const ALString GetObjectLabel() const override;
+
+	///////////////////////////////////////////////////////////////////////////////
+	///// Implementation
+protected:
+	// Empreinte d'un fichier: taille, date de modification s'il est local, et valeur de hash
+	// d'un echantillon de blocs repartis uniformement dans le fichier
+	static const ALString ComputeFileFingerprint(const ALString& sFileURI);
+
+	// Mise a jour d'une valeur de hash (Jenkins one at a time) avec une partie d'un vecteur de caracteres
+	static int UpdateBufferHashValue(int nHashValue, const CharVector* cvBuffer, int nBegin, int nLength);
+
+	// Ecriture et lecture d'un vecteur de caracteres dans un fichier binaire ouvert
+	static boolean WriteCharVector(FILE* fFile, const CharVector* cvBuffer);
+	static boolean ReadCharVector(FILE* fFile, int nSize, CharVector* cvBuffer);
+
+	// Nombre de blocs de l'echantillon utilise pour l'empreinte des fichiers
+	static const int nFingerprintSampleNumber = 8;
+
+	// Entete des fichiers de cache
+	static const char* sCacheFileHeader;
+
+	// Cle de la preparation
+	ALString sKey;
+
+	// Nom du fichier de cache
+	ALString sCacheFileName;
+};
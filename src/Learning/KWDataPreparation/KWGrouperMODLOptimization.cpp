@@ -1514,6 +1514,8 @@ void KWGrouperMODL::FastPostOptimizeGroupsWithGarbage(KWFrequencyTable* kwftSour
 	IntVector ivModalityIndexes;
 	IntVector ivGroupIndexes;
 	DoubleVector dvGroupCosts;
+	IntVector ivModalityFrequencies;
+	IntVector ivGroupFrequencies;
 	int nModality;
 	int nGroup;
 	int n1;
@@ -1587,6 +1589,17 @@ void KWGrouperMODL::FastPostOptimizeGroupsWithGarbage(KWFrequencyTable* kwftSour
 	for (nGroup = 0; nGroup < nGroupNumber; nGroup++)
 		dvGroupCosts.SetAt(nGroup, ComputeGroupCost(kwftTarget->GetFrequencyVectorAt(nGroup)));
 
+	// Memorisation des effectifs des modalites et des groupes
+	// Leur calcul peut etre couteux (vecteurs d'effectifs creux de la post-optimisation des grilles),
+	// alors qu'ils sont testes pour chaque deplacement evalue: on les maintient de facon incrementale
+	ivModalityFrequencies.SetSize(nModalityNumber);
+	for (nModality = 0; nModality < nModalityNumber; nModality++)
+		ivModalityFrequencies.SetAt(nModality,
+					    kwftSource->GetFrequencyVectorAt(nModality)->ComputeTotalFrequency());
+	ivGroupFrequencies.SetSize(nGroupNumber);
+	for (nGroup = 0; nGroup < nGroupNumber; nGroup++)
+		ivGroupFrequencies.SetAt(nGroup, kwftTarget->GetFrequencyVectorAt(nGroup)->ComputeTotalFrequency());
+
 	// Tant qu'il y a amelioration, on continue a chercher le premier
 	// deplacement interessant de modalites entre groupes
 	bContinue = true;
@@ -1660,14 +1673,14 @@ void KWGrouperMODL::FastPostOptimizeGroupsWithGarbage(KWFrequencyTable* kwftSour
 
 					// Variation du nombre de groupes suite a ce deplacement
 					// Cas ou le groupe devient vide apres le depart de la modalite
-					if (kwftTarget->GetFrequencyVectorAt(nOutGroup)->ComputeTotalFrequency() ==
-					    kwftSource->GetFrequencyVectorAt(nModality)->ComputeTotalFrequency())
+					if (ivGroupFrequencies.GetAt(nOutGroup) ==
+					    ivModalityFrequencies.GetAt(nModality))
 					{
 						bLastModality = true;
 						nNewTrueGroupNumber--;
 					}
 					// Cas d'une modalite qui arrive dans un groupe qui etait vide
-					if (kwftTarget->GetFrequencyVectorAt(nInGroup)->ComputeTotalFrequency() == 0)
+					if (ivGroupFrequencies.GetAt(nInGroup) == 0)
 						// Incrementation du nombre de groupes
 						nNewTrueGroupNumber++;
 
@@ -1831,7 +1844,7 @@ void KWGrouperMODL::FastPostOptimizeGroupsWithGarbage(KWFrequencyTable* kwftSour
 
 				// Variation du nombre de groupes
 				// Cas ou l'arrivee de la modalite remplit un groupe qui etait vide
-				if (kwftTarget->GetFrequencyVectorAt(nBestInGroup)->ComputeTotalFrequency() == 0)
+				if (ivGroupFrequencies.GetAt(nBestInGroup) == 0)
 				{
 					nTrueGroupNumber++;
 				}
@@ -1841,6 +1854,12 @@ void KWGrouperMODL::FastPostOptimizeGroupsWithGarbage(KWFrequencyTable* kwftSour
 						   kwftSource->GetFrequencyVectorAt(nModality));
 				RemoveFrequencyVector(kwftTarget->GetFrequencyVectorAt(nOutGroup),
 						      kwftSource->GetFrequencyVectorAt(nModality));
+				ivGroupFrequencies.UpgradeAt(nBestInGroup, ivModalityFrequencies.GetAt(nModality));
+				ivGroupFrequencies.UpgradeAt(nOutGroup, -ivModalityFrequencies.GetAt(nModality));
+				assert(ivGroupFrequencies.GetAt(nOutGroup) ==
+				       kwftTarget->GetFrequencyVectorAt(nOutGroup)->ComputeTotalFrequency());
+				assert(ivGroupFrequencies.GetAt(nBestInGroup) ==
+				       kwftTarget->GetFrequencyVectorAt(nBestInGroup)->ComputeTotalFrequency());
 				assert(fabs(ComputeGroupCost(kwftTarget->GetFrequencyVectorAt(nOutGroup)) -
 					    dvGroupCosts.GetAt(nOutGroup)) < dEpsilon);
 				assert(fabs(ComputeGroupCost(kwftTarget->GetFrequencyVectorAt(nBestInGroup)) -
@@ -1848,7 +1867,7 @@ void KWGrouperMODL::FastPostOptimizeGroupsWithGarbage(KWFrequencyTable* kwftSour
 
 				// Variation du nombre de groupes
 				// Cas ou le depart de la modalite laisse un groupe vide
-				if (kwftTarget->GetFrequencyVectorAt(nOutGroup)->ComputeTotalFrequency() == 0)
+				if (ivGroupFrequencies.GetAt(nOutGroup) == 0)
 				{
 					assert(bBestLastModality);
 					nTrueGroupNumber--;
@@ -156,6 +156,9 @@ boolean KWLearningSpec::ComputeTargetStats(const KWTupleTable* tupleTable)
 	// Memorisation du nombre d'instances
 	nInstanceNumber = tupleTable->GetTotalFrequency();
 
+	// Dimensionnement de la table des logarithmes de factorielle utilisee dans les couts MODL
+	KWStat::ReserveLnFactorialTable(nInstanceNumber);
+
 	// Pas de calcul de la cas non supervise
 	if (GetTargetAttributeName() == "")
 	{
@@ -4,7 +4,9 @@
 
 #include "KWStat.h"
 
-DoubleVector KWStat::dvLnFactorial;
+double* KWStat::dLnFactorialTable = NULL;
+double* KWStat::dLnFactorialTableBuffer = NULL;
+int KWStat::nLnFactorialTableSize = 0;
 
 DoubleVector KWStat::dvLnBell;
 
@@ -379,35 +381,72 @@ double KWStat::InvStudent(double dProb, int ndf)
 	return dLowerX;
 }
 
-double KWStat::LnFactorial(int nValue)
+void KWStat::ReserveLnFactorialTable(int nMaxValue)
 {
+	int nSize;
+
+	require(nMaxValue >= 0);
+
+	// Calcul de la taille de la table, entre sa taille par defaut et sa taille max
+	nSize = nMaxValue + 1;
+	if (nSize < nLnFactorialTableDefaultSize)
+		nSize = nLnFactorialTableDefaultSize;
+	if (nSize > nLnFactorialTableMaxSize)
+		nSize = nLnFactorialTableMaxSize;
+
+	// Extension de la table si necessaire
+	if (nSize > nLnFactorialTableSize)
+		ComputeLnFactorialTable(nSize);
+	ensure(nLnFactorialTableSize > nMaxValue or nLnFactorialTableSize == nLnFactorialTableMaxSize);
+}
+
+double KWStat::SumLnFactorial(const IntVector* ivFrequencies)
+{
+	double dSum;
+	int nFrequency;
 	int i;
 
-	require(nValue >= 0);
+	require(ivFrequencies != NULL);
 
-	// Renvoie de la valeur tabulee si possible
-	if (nValue < nLnFactorialTableSize)
-	{
-		// Calcul si necessaire du tableau des valeurs des factorielles
-		if (dvLnFactorial.GetSize() == 0)
-		{
-			// Taillage du vecteur des valeurs
-			dvLnFactorial.SetSize(nLnFactorialTableSize);
+	// Initialisation de la table si necessaire
+	if (nLnFactorialTableSize == 0)
+		ComputeLnFactorialTable(nLnFactorialTableDefaultSize);
 
-			// Calcul des valeurs
-			for (i = 1; i < nLnFactorialTableSize; i++)
-			{
-				dvLnFactorial.SetAt(i, dvLnFactorial.GetAt(i - 1) + log(1.0 * i));
-			}
-		}
-		assert(fabs(dvLnFactorial.GetAt(nValue) - LnGamma(nValue + 1)) < (nValue + 1) * 1e-9);
-		assert(nValue < 60 or
-		       fabs(dvLnFactorial.GetAt(nValue) - LnGammaRamanujan(nValue + 1)) < (nValue + 1) * 1e-9);
-		return dvLnFactorial.GetAt(nValue);
+	// Somme des valeurs, par acces direct a la table quand c'est possible
+	// On garde une sommation sequentielle, pour que les couts ne dependent pas de la facon de les calculer
+	dSum = 0;
+	for (i = 0; i < ivFrequencies->GetSize(); i++)
+	{
+		nFrequency = ivFrequencies->GetAt(i);
+		assert(nFrequency >= 0);
+		if (nFrequency < nLnFactorialTableSize)
+			dSum += dLnFactorialTable[nFrequency];
+		else
+			dSum += ComputeLnFactorial(nFrequency);
 	}
-	// Sinon, utilisation de la loi Gamma
-	else
-		return LnGamma(nValue + 1);
+	return dSum;
+}
+
+double KWStat::LnMultinomialCellCost(const IntVector* ivFrequencies, int nValueNumber)
+{
+	double dCost;
+	int nCellFrequency;
+	int i;
+
+	require(ivFrequencies != NULL);
+	require(nValueNumber >= 1);
+
+	// Effectif total de la cellule
+	nCellFrequency = 0;
+	for (i = 0; i < ivFrequencies->GetSize(); i++)
+		nCellFrequency += ivFrequencies->GetAt(i);
+
+	// Cout de codage des instances de la cellule et de la loi multinomiale de la cellule
+	// L'ordre des operations est celui d'un calcul par appels unitaires a LnFactorial
+	dCost = -SumLnFactorial(ivFrequencies);
+	dCost += LnFactorial(nCellFrequency + nValueNumber - 1);
+	dCost -= LnFactorial(nValueNumber - 1);
+	return dCost;
 }
 
 // Pour les explications sur le calcul des nombre de Bell generalises, se
@@ -592,6 +631,95 @@ void KWStat::ComputeLnStarAndC0MaxTables()
 	}
 }
 
+// Classe technique de liberation de la table des logarithmes de factorielle en fin de programme
+class KWStatLnFactorialTableCleaner
+{
+public:
+	~KWStatLnFactorialTableCleaner()
+	{
+		KWStat::DeleteLnFactorialTable();
+	}
+};
+static KWStatLnFactorialTableCleaner lnFactorialTableCleaner;
+
+void KWStat::ComputeLnFactorialTable(int nSize)
+{
+	const int nCacheLineDoubleNumber = 8;
+	double* dNewTableBuffer;
+	double* dNewTable;
+	int nOffset;
+	int i;
+
+	require(nSize > nLnFactorialTableSize);
+	require(nSize <= nLnFactorialTableMaxSize);
+
+	// Allocation d'un nouveau tableau, aligne sur une ligne de cache (64 octets)
+	dNewTableBuffer = new double[nSize + nCacheLineDoubleNumber];
+	nOffset = (int)(((size_t)dNewTableBuffer / sizeof(double)) % nCacheLineDoubleNumber);
+	if (nOffset > 0)
+		nOffset = nCacheLineDoubleNumber - nOffset;
+	dNewTable = &dNewTableBuffer[nOffset];
+
+	// Recopie des valeurs deja calculees
+	for (i = 0; i < nLnFactorialTableSize; i++)
+		dNewTable[i] = dLnFactorialTable[i];
+
+	// Calcul des nouvelles valeurs
+	if (nLnFactorialTableSize == 0)
+		dNewTable[0] = 0;
+	for (i = max(1, nLnFactorialTableSize); i < nSize; i++)
+	{
+		dNewTable[i] = dNewTable[i - 1] + log(1.0 * i);
+		assert(i % 1000 != 0 or fabs(dNewTable[i] - LnGamma(i + 1)) < (i + 1) * 1e-9);
+		assert(i % 1000 != 0 or i < 60 or fabs(dNewTable[i] - LnGammaRamanujan(i + 1)) < (i + 1) * 1e-9);
+	}
+
+	// Remplacement de la table
+	if (dLnFactorialTableBuffer != NULL)
+		delete[] dLnFactorialTableBuffer;
+	dLnFactorialTableBuffer = dNewTableBuffer;
+	dLnFactorialTable = dNewTable;
+	nLnFactorialTableSize = nSize;
+}
+
+void KWStat::DeleteLnFactorialTable()
+{
+	if (dLnFactorialTableBuffer != NULL)
+		delete[] dLnFactorialTableBuffer;
+	dLnFactorialTableBuffer = NULL;
+	dLnFactorialTable = NULL;
+	nLnFactorialTableSize = 0;
+}
+
+double KWStat::ComputeLnFactorial(int nValue)
+{
+	int nSize;
+
+	require(nValue >= nLnFactorialTableSize);
+
+	// Initialisation de la table a sa taille par defaut
+	if (nLnFactorialTableSize == 0)
+		ComputeLnFactorialTable(nLnFactorialTableDefaultSize);
+
+	// Extension de la table par doublement de taille, dans la limite de sa taille max
+	if (nLnFactorialTableSize <= nValue and nValue < nLnFactorialTableMaxSize)
+	{
+		nSize = 2 * nLnFactorialTableSize;
+		if (nSize < nValue + 1)
+			nSize = nValue + 1;
+		if (nSize > nLnFactorialTableMaxSize)
+			nSize = nLnFactorialTableMaxSize;
+		ComputeLnFactorialTable(nSize);
+	}
+
+	// Renvoie de la valeur tabulee si possible
+	if (nValue < nLnFactorialTableSize)
+		return dLnFactorialTable[nValue];
+	// Sinon, utilisation de la loi Gamma
+	else
+		return LnGamma(nValue + 1);
+}
+
 void KWStat::ComputeLnBellTable()
 {
 	int nMaxSize = nLnBellTableMaxN * nLnBellTableMaxN;
@@ -903,6 +1031,7 @@ void KWStat::Test()
 	double dResult;
 	int j;
 	IntVector ivC0Max;
+	IntVector ivFrequencies;
 
 	// Table des Student
 	if (not bSkipIt)
@@ -932,6 +1061,28 @@ void KWStat::Test()
 		cout << dResult << endl;
 	}
 
+	// Log(Factorielle) sur des vecteurs d'effectifs, a comparer avec des appels unitaires
+	if (not bSkipIt)
+	{
+		cout << "Log(Factorielle) on frequency vectors\n";
+		ivFrequencies.Add(0);
+		ivFrequencies.Add(1);
+		ivFrequencies.Add(17);
+		ivFrequencies.Add(1000);
+		ivFrequencies.Add(200000);
+		dResult = 0;
+		for (i = 0; i < ivFrequencies.GetSize(); i++)
+			dResult += LnFactorial(ivFrequencies.GetAt(i));
+		cout << "Sum\t" << SumLnFactorial(&ivFrequencies) << "\t" << dResult << "\t"
+		     << BooleanToString(SumLnFactorial(&ivFrequencies) == dResult) << endl;
+		dResult = -dResult + LnFactorial(201018 + ivFrequencies.GetSize() - 1) -
+			  LnFactorial(ivFrequencies.GetSize() - 1);
+		cout << "Multinomial\t" << LnMultinomialCellCost(&ivFrequencies, ivFrequencies.GetSize()) << "\t"
+		     << dResult << "\t"
+		     << BooleanToString(LnMultinomialCellCost(&ivFrequencies, ivFrequencies.GetSize()) == dResult)
+		     << endl;
+	}
+
 	// LnBell
 	if (not bSkipIt)
 	{
@@ -63,8 +63,22 @@ public:
 	static double InvStudent(double dProb, int ndf);
 
 	// Logarithme de factorielle
+	// Les valeurs sont lues dans une table, etendue a la demande jusqu'a une taille max
 	static double LnFactorial(int nValue);
 
+	// Extension de la table des logarithmes de factorielle pour couvrir toutes les valeurs jusqu'a nMaxValue,
+	// typiquement le nombre d'instances, dans la limite de la taille max de la table
+	static void ReserveLnFactorialTable(int nMaxValue);
+
+	// Somme des logarithmes de factorielle des effectifs d'un vecteur
+	static double SumLnFactorial(const IntVector* ivFrequencies);
+
+	// Cout de codage d'une loi multinomiale sur un vecteur d'effectifs d'une cellule, pour nValueNumber valeurs
+	// Cout de la distribution des effectifs (prior) plus terme de multinome de la distribution effective:
+	//   ln((N+K-1)!/(N!(K-1)!)) + ln(N!/(n1!...nK!)) = ln((N+K-1)!) - ln((K-1)!) - somme_k ln(nk!)
+	// Les couts sont bit a bit identiques a ceux obtenus par appels unitaires a LnFactorial
+	static double LnMultinomialCellCost(const IntVector* ivFrequencies, int nValueNumber);
+
 	// Logarithme du nombre de Bell "generalise"
 	// Nombre de partition de n elements en k classes (eventuellements vides)
 	static double LnBell(int n, int k);
@@ -104,6 +118,14 @@ protected:
 	///////////////////////////////////////////////////////////////
 	// Methodes internes
 
+	// Calcul de la table des logarithme de factorielle pour une taille donnee, et liberation de la table
+	// Les valeurs sont calculees par sommes cumulees, et restent identiques quand la table est etendue
+	static void ComputeLnFactorialTable(int nSize);
+	static void DeleteLnFactorialTable();
+
+	// Calcul du logarithme de factorielle pour une valeur hors de la table courante
+	static double ComputeLnFactorial(int nValue);
+
 	// Calcul du nombre de Bell generalise
 	static void ComputeLnBellTable();
 	static double ComputeLnBellValue(int n, int k);
@@ -137,8 +159,15 @@ protected:
 	static void ComputeLnStarAndC0MaxTables();
 
 	// Tableau des valeurs de la fonction logarithme de factorielle
-	static DoubleVector dvLnFactorial;
-	static const int nLnFactorialTableSize = 128000;
+	// On utilise un tableau contigu aligne sur une ligne de cache plutot qu'un DoubleVector, pour un acces
+	// direct sans calcul d'index de bloc dans les boucles des couts MODL
+	// La table est initialisee avec une taille par defaut, et peut etre etendue jusqu'a une taille max
+	static double* dLnFactorialTable;
+	static double* dLnFactorialTableBuffer;
+	static int nLnFactorialTableSize;
+	static const int nLnFactorialTableDefaultSize = 128000;
+	static const int nLnFactorialTableMaxSize = 1 << 21;
+	friend class KWStatLnFactorialTableCleaner;
 
 	// Tableau des valeurs de la fonction logarithme de Bell
 	static DoubleVector dvLnBell;
@@ -152,3 +181,18 @@ protected:
 	// Tableau des valeurs de la somme finie exacte somme_{n=1}^Max 2^{-log_2*(n)}
 	static DoubleVector dvC0Max;
 };
+
+//////////////////////////////////////////////////////////
+// Methodes en inline
+
+inline double KWStat::LnFactorial(int nValue)
+{
+	require(nValue >= 0);
+
+	// Renvoie de la valeur tabulee si possible
+	if (nValue < nLnFactorialTableSize)
+		return dLnFactorialTable[nValue];
+	// Sinon, calcul avec extension de la table si possible
+	else
+		return ComputeLnFactorial(nValue);
+}
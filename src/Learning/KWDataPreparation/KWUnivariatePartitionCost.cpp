@@ -439,9 +439,6 @@ double KWMODLDiscretizationCosts::ComputePartCost(const KWFrequencyVector* part)
 
 	IntVector* ivFrequencyVector;
 	double dCost;
-	int nFrequency;
-	int nIntervalFrequency;
-	int i;
 
 	require(part != NULL);
 	require(nClassValueNumber > 1);
@@ -450,16 +447,7 @@ double KWMODLDiscretizationCosts::ComputePartCost(const KWFrequencyVector* part)
 	ivFrequencyVector = cast(KWDenseFrequencyVector*, part)->GetFrequencyVector();
 
 	// Cout de codage des instances de la ligne et de la loi multinomiale de la ligne
-	dCost = 0;
-	nIntervalFrequency = 0;
-	for (i = 0; i < ivFrequencyVector->GetSize(); i++)
-	{
-		nFrequency = ivFrequencyVector->GetAt(i);
-		dCost -= KWStat::LnFactorial(nFrequency);
-		nIntervalFrequency += nFrequency;
-	}
-	dCost += KWStat::LnFactorial(nIntervalFrequency + nClassValueNumber - 1);
-	dCost -= KWStat::LnFactorial(nClassValueNumber - 1);
+	dCost = KWStat::LnMultinomialCellCost(ivFrequencyVector, nClassValueNumber);
 	return dCost;
 }
 
@@ -690,9 +678,6 @@ double KWMODLGroupingCosts::ComputePartCost(const KWFrequencyVector* part) const
 
 	IntVector* ivFrequencyVector;
 	double dCost;
-	int nFrequency;
-	int nIntervalFrequency;
-	int i;
 
 	require(part != NULL);
 	require(nClassValueNumber > 1);
@@ -701,16 +686,7 @@ double KWMODLGroupingCosts::ComputePartCost(const KWFrequencyVector* part) const
 	ivFrequencyVector = cast(KWDenseFrequencyVector*, part)->GetFrequencyVector();
 
 	// Cout de codage des instances de la ligne et de la loi multinomiale de la ligne
-	dCost = 0;
-	nIntervalFrequency = 0;
-	for (i = 0; i < ivFrequencyVector->GetSize(); i++)
-	{
-		nFrequency = ivFrequencyVector->GetAt(i);
-		dCost -= KWStat::LnFactorial(nFrequency);
-		nIntervalFrequency += nFrequency;
-	}
-	dCost += KWStat::LnFactorial(nIntervalFrequency + nClassValueNumber - 1);
-	dCost -= KWStat::LnFactorial(nClassValueNumber - 1);
+	dCost = KWStat::LnMultinomialCellCost(ivFrequencyVector, nClassValueNumber);
 	return dCost;
 }
 
@@ -9,6 +9,7 @@
 KWChunkSorterTask::KWChunkSorterTask()
 {
 	bIsInputHeaderLineUsed = false;
+	bInputBlockCompression = false;
 	buckets = NULL;
 	nCurrentBucketIndexToSort = 0;
 	lSortedLinesNumber = 0;
@@ -28,6 +29,7 @@ KWChunkSorterTask::KWChunkSorterTask()
 	// Variables partagees
 	DeclareSharedParameter(&shared_bHeaderLineUsed);
 	DeclareSharedParameter(&shared_bOnlyOneBucket);
+	DeclareSharedParameter(&shared_bInputBlockCompression);
 	DeclareSharedParameter(&shared_ivKeyFieldIndexes);
 	DeclareSharedParameter(&shared_lBucketSize);
 	DeclareSharedParameter(&shared_cInputSeparator);
@@ -69,6 +71,16 @@ const IntVector* KWChunkSorterTask::GetConstKeyFieldIndexes() const
 	return shared_ivKeyFieldIndexes.GetConstIntVector();
 }
 
+void KWChunkSorterTask::SetInputBlockCompression(boolean bValue)
+{
+	bInputBlockCompression = bValue;
+}
+
+boolean KWChunkSorterTask::GetInputBlockCompression() const
+{
+	return bInputBlockCompression;
+}
+
 void KWChunkSorterTask::SetOutputFieldSeparator(char cValue)
 {
 	shared_cOutputSeparator.SetValue(cValue);
@@ -321,6 +333,7 @@ boolean KWChunkSorterTask::MasterInitialize()
 	lSortedLinesNumber = 0;
 	shared_bHeaderLineUsed = bIsInputHeaderLineUsed;
 	shared_bOnlyOneBucket = buckets->GetBucketNumber() == 1;
+	shared_bInputBlockCompression = bInputBlockCompression;
 	shared_lBucketSize = lBucketSize;
 	return true;
 }
@@ -526,6 +539,7 @@ boolean KWChunkSorterTask::SlaveProcess()
 			// utilisateur)
 			if (not shared_bOnlyOneBucket)
 				inputFile->SetUTF8BomManagement(false);
+			inputFile->SetBlockCompression(shared_bInputBlockCompression);
 
 			// Stockage du buffer
 			oaBufferedFiles.Add(inputFile);
@@ -563,9 +577,9 @@ boolean KWChunkSorterTask::SlaveProcess()
 				PLRemoteFileService::RemoveFile(inputFile->GetFileName());
 		}
 
-		if (shared_bOnlyOneBucket and input_svFileNames.GetConstStringVector()->GetSize() > 0)
-			lOneBucketFileSize =
-			    PLRemoteFileService::GetFileSize(input_svFileNames.GetConstStringVector()->GetAt(0));
+		// Taille du fichier, decompresse le cas echeant
+		if (bOk and shared_bOnlyOneBucket and oaBufferedFiles.GetSize() > 0)
+			lOneBucketFileSize = cast(InputBufferedFile*, oaBufferedFiles.GetAt(0))->GetFileSize();
 	}
 
 	if (bOk)
@@ -45,6 +45,11 @@ public:
 	IntVector* GetKeyFieldIndexes();
 	const IntVector* GetConstKeyFieldIndexes() const;
 
+	// Fichiers des buckets compresses par blocs (par defaut: false)
+	// Cf. KWSortedChunkBuilderTask::SetBucketCompression
+	void SetInputBlockCompression(boolean bValue);
+	boolean GetInputBlockCompression() const;
+
 	////////////////////////////////////////////////////////////////////////
 	// Specification du fichier trie en sortie
 
@@ -127,6 +132,7 @@ protected:
 
 	// Specification de la tache
 	boolean bIsInputHeaderLineUsed;
+	boolean bInputBlockCompression;
 	KWSortBuckets* buckets;
 	longint lLineNumber;
 	longint lKeySize;
@@ -163,6 +169,7 @@ protected:
 	PLShared_IntVector shared_ivKeyFieldIndexes; // Index des champs de la cle
 	PLShared_Boolean shared_bHeaderLineUsed;
 	PLShared_Boolean shared_bOnlyOneBucket;
+	PLShared_Boolean shared_bInputBlockCompression;
 	PLShared_Longint shared_lBucketSize;
 	PLShared_Char shared_cOutputSeparator; // Separateur du fichier de sortie
 	PLShared_Char shared_cInputSeparator;  // Separetur du fichier d'entree
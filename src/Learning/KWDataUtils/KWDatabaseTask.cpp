@@ -952,8 +952,10 @@ boolean KWDatabaseTask::SlaveProcessExploitDatabase()
 		else
 			rootDriver = shared_sourceDatabase.GetSTDatabase()->GetDriver();
 
-		// Parcours des objets sources
+		// Parcours des objets sources, en recyclant les vecteurs de valeurs des objets detruits
+		// d'un enregistrement a l'autre
 		Global::ActivateErrorFlowControl();
+		KWObject::SetValueVectorRecycling(true);
 		while (not sourceDatabase->IsEnd())
 		{
 			// Suivi de la tache
@@ -1001,6 +1003,7 @@ boolean KWDatabaseTask::SlaveProcessExploitDatabase()
 				break;
 			}
 		}
+		KWObject::SetValueVectorRecycling(false);
 		Global::DesactivateErrorFlowControl();
 	}
 
@@ -33,6 +33,7 @@
 // chunks.
 
 const longint KWFileSorter::lChunkSizeLimit = (longint)INT_MAX;
+boolean KWFileSorter::bChunkCompression = false;
 
 KWFileSorter::KWFileSorter()
 {
@@ -353,10 +354,13 @@ boolean KWFileSorter::Sort(boolean bDisplayUserMessage)
 					bOk = sNewFileName != "";
 					if (bOk)
 					{
-						// Concatenation
+						// Concatenation, avec decompression des chunks le cas echeant pour
+						// obtenir un fichier standard a redecouper
 						concatenater.SetFileName(sNewFileName);
+						concatenater.SetInputBlockCompression(bChunkCompression);
 						bOk = concatenater.Concatenate(overweightBucket->GetChunkFileNames(),
 									       this, true);
+						concatenater.SetInputBlockCompression(false);
 					}
 					else
 					{
@@ -398,6 +402,9 @@ boolean KWFileSorter::Sort(boolean bDisplayUserMessage)
 				parallelSorter.SetInputFieldSeparator(cInputFieldSeparator);
 				parallelSorter.SetInputHeaderLineUsed(bInputHeaderLineUsed);
 				parallelSorter.SetOutputFieldSeparator(cOutputFieldSeparator);
+
+				// Les chunks sont compresses s'ils sont issus d'un decoupage, et non du fichier initial
+				parallelSorter.SetInputBlockCompression(bChunkCompression and nSplitNumber > 0);
 				bOk = parallelSorter.Sort();
 				bIsInterruptedByUser = parallelSorter.IsTaskInterruptedByUser();
 				if (bTrace)
@@ -703,6 +710,7 @@ KWSortBuckets* KWFileSorter::SplitDatabase(int nChunkSizeMin, int nChunkSize, KW
 		chunksBuilder.SetFileURI(sFileURI);
 		chunksBuilder.SetInputFieldSeparator(cFieldSeparator);
 		chunksBuilder.SetHeaderLineUsed(bIsHeaderLineUsed);
+		chunksBuilder.SetBucketCompression(bChunkCompression);
 		sortedBuckets = new KWSortBuckets;
 
 		// Initialization des buckets a partir des splits
@@ -755,6 +763,16 @@ boolean KWFileSorter::IsInMemorySort(longint lKeySize, longint lLineNumber, long
 	return bIsInMemory;
 }
 
+void KWFileSorter::SetChunkCompression(boolean bValue)
+{
+	bChunkCompression = bValue;
+}
+
+boolean KWFileSorter::GetChunkCompression()
+{
+	return bChunkCompression;
+}
+
 const ALString KWFileSorter::GetClassLabel() const
 {
 	return "File sorter";
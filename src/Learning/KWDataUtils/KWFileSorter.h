@@ -68,6 +68,11 @@ public:
 	// Methode interruptible, retourne false si erreur ou interruption, true sinon
 	boolean Sort(boolean bDisplayUserMessage);
 
+	// Compression par blocs des fichiers temporaires des chunks, pour tous les tris (par defaut: false)
+	// Permet de reduire les entrees-sorties disque, au prix du temps de compression et decompression
+	static void SetChunkCompression(boolean bValue);
+	static boolean GetChunkCompression();
+
 	// Libelles utilisateurs
 	const ALString GetClassLabel() const override;
 	const ALString GetObjectLabel() const override;
@@ -147,6 +152,9 @@ protected:
 	// C'est la taille des CharVector : 2 Go - 1
 	static const longint lChunkSizeLimit;
 
+	// Compression des fichiers des chunks
+	static boolean bChunkCompression;
+
 	// Pour la taille de chunk qui est calculee (censee etre optimale), on essaye de construire des chunks
 	// plus petits. Car avec l'alogo de DeWitt on n'est pas certain d'avoir des chunks de la bonen taille et
 	// en cas de depassement, il faut redecouper les chunks ce qui est couteux, on prefere donc avoir des chunks
@@ -27,6 +27,7 @@ KWSortedChunkBuilderTask::KWSortedChunkBuilderTask()
 	DeclareSharedParameter(&shared_cInputFieldSeparator);
 	DeclareSharedParameter(&shared_lFileSize);
 	DeclareSharedParameter(&shared_lMaxSlaveBucketMemory);
+	DeclareSharedParameter(&shared_bBucketCompression);
 
 	DeclareTaskInput(&input_bLastRound);
 	DeclareTaskInput(&input_nBufferSize);
@@ -85,6 +86,16 @@ const IntVector* KWSortedChunkBuilderTask::GetConstKeyFieldIndexes() const
 	return shared_ivKeyFieldIndexes.GetConstIntVector();
 }
 
+void KWSortedChunkBuilderTask::SetBucketCompression(boolean bValue)
+{
+	shared_bBucketCompression = bValue;
+}
+
+boolean KWSortedChunkBuilderTask::GetBucketCompression() const
+{
+	return shared_bBucketCompression;
+}
+
 boolean KWSortedChunkBuilderTask::BuildSortedChunks(const KWSortBuckets* buckets)
 {
 	boolean bOk;
@@ -265,8 +276,13 @@ boolean KWSortedChunkBuilderTask::ComputeResourceRequirements()
 									      BufferedFile::nDefaultBufferSize);
 	ensure(GetResourceRequirements()->GetSlaveRequirement()->Check());
 
-	// Stockage des chunks sur les esclaves
-	GetResourceRequirements()->GetGlobalSlaveRequirement()->GetDisk()->Set(lInputFileSize);
+	// Stockage des chunks sur les esclaves, en prenant en compte le cas le pire des chunks incompressibles
+	// en mode compression
+	if (shared_bBucketCompression)
+		GetResourceRequirements()->GetGlobalSlaveRequirement()->GetDisk()->Set(
+		    BufferedFile::GetMaxBlockCompressedSize(lInputFileSize));
+	else
+		GetResourceRequirements()->GetGlobalSlaveRequirement()->GetDisk()->Set(lInputFileSize);
 
 	// Nombre de slaveProcess
 	nSlaveProcessNumber = (int)ceil(lInputFileSize * 1.0 / BufferedFile::nDefaultBufferSize);
@@ -475,9 +491,10 @@ boolean KWSortedChunkBuilderTask::MasterFinalize(boolean bProcessEndedCorrectly)
 	svChunkFileNames = NULL;
 
 	// Verification que la taille des buckets enregistree au long des slaveProcess est bien la bonne (par rapport a
-	// GetFileSize())
+	// GetFileSize()), sauf en mode compression ou les tailles sur disque sont celles des fichiers compresses
 	debug(; ALString sBucketID; Object * oElement; longint lComputeFileSize; StringVector * svBucketFiles;
-	      POSITION position = odIdBucketsSize_master.GetStartPosition(); while (position != NULL) {
+	      POSITION position = odIdBucketsSize_master.GetStartPosition();
+	      while (not shared_bBucketCompression and position != NULL) {
 		      odIdBucketsSize_master.GetNextAssoc(position, sBucketID, oElement);
 		      loBucketSize = cast(LongintObject*, oElement);
 		      svBucketFiles = cast(StringVector*, odBucketsFiles.Lookup(sBucketID));
@@ -860,6 +877,7 @@ boolean KWSortedChunkBuilderTask::WriteBucket(KWSortBucket* bucketToWrite)
 			output_svBucketIds.Add(bucketToWrite->GetId());
 			output_svBucketFilePath.Add(FileService::BuildLocalURI(sBucketFilePath));
 			bufferedFile.SetFileName(sBucketFilePath);
+			bufferedFile.SetBlockCompression(shared_bBucketCompression);
 			bOk = bufferedFile.Open();
 		}
 	}
@@ -867,6 +885,7 @@ boolean KWSortedChunkBuilderTask::WriteBucket(KWSortBucket* bucketToWrite)
 	{
 		// On ouvre le chunk deja ecrit
 		bufferedFile.SetFileName(bucketToWrite->GetOutputFileName());
+		bufferedFile.SetBlockCompression(shared_bBucketCompression);
 		bOk = bufferedFile.OpenForAppend();
 	}
 
@@ -883,8 +902,8 @@ boolean KWSortedChunkBuilderTask::WriteBucket(KWSortBucket* bucketToWrite)
 			lBucketSize = new LongintObject;
 			odIdBucketsSize_master.SetAt(bucketToWrite->GetId(), lBucketSize);
 		}
-		assert(lBucketSize->GetLongint() + bucketToWrite->GetChunk()->GetSize() ==
-		       PLRemoteFileService::GetFileSize(bufferedFile.GetFileName()));
+		assert(shared_bBucketCompression or lBucketSize->GetLongint() + bucketToWrite->GetChunk()->GetSize() ==
+							PLRemoteFileService::GetFileSize(bufferedFile.GetFileName()));
 
 		lBucketSize->SetLongint(lBucketSize->GetLongint() + bucketToWrite->GetChunk()->GetSize());
 
@@ -50,6 +50,11 @@ public:
 	IntVector* GetKeyFieldIndexes();
 	const IntVector* GetConstKeyFieldIndexes() const;
 
+	// Compression par blocs des fichiers des chunks (par defaut: false)
+	// Les fichiers des chunks sont alors a relire en mode compression (cf. BufferedFile::SetBlockCompression)
+	void SetBucketCompression(boolean bValue);
+	boolean GetBucketCompression() const;
+
 	/////////////////////////////////////////////////////
 	// Methode principale
 
@@ -145,6 +150,9 @@ protected:
 	// Taille memoire max pour la gestion memoire des buckets de chaque esclave
 	PLShared_Longint shared_lMaxSlaveBucketMemory;
 
+	// Compression par blocs des fichiers des chunks
+	PLShared_Boolean shared_bBucketCompression;
+
 	// Attributs du fichier d'entree
 	PLShared_String shared_sFileName;
 	PLShared_Boolean shared_bHeaderLineUsed;
@@ -46,6 +46,21 @@ void KWLearningProject::Start(int argc, char** argv)
 		PLParallelTask::SetTracerResources(3);
 		PLParallelTask::SetTracerMPIActive(true);
 	}
+
+	// Parametrage de la ligne de temps des taches paralleles
+	if (GetParallelTimelineFileName() != "")
+		PLParallelTask::SetTimelineFileName(GetParallelTimelineFileName());
+
+	// Parametrage de la calibration des exigences memoire des taches paralleles
+	if (GetParallelMemoryCalibrationFileName() != "")
+		RMTaskMemoryCalibration::SetProfileFileName(GetParallelMemoryCalibrationFileName());
+	if (GetParallelMemoryCalibrationMargin() >= 0)
+		RMTaskMemoryCalibration::SetSafetyMargin(GetParallelMemoryCalibrationMargin());
+
+	// Parametrage de la compression des fichiers temporaires de tri
+	if (GetTmpFileCompressionMode())
+		KWFileSorter::SetChunkCompression(true);
+
 	// Ajout du nom du host dans les logs
 	if (MemoryStatsManager::IsOpened())
 		MemoryStatsManager::AddLog(
@@ -363,6 +378,7 @@ void KWLearningProject::CloseLearningEnvironnement()
 
 	// Nettoyage des taches
 	PLParallelTask::DeleteAllTasks();
+	RMTaskMemoryCalibration::SetProfileFileName("");
 }
 
 KWLearningProblem* KWLearningProject::CreateLearningProblem()
@@ -35,6 +35,7 @@
 #include "KWChunkSorterTask.h"
 #include "KWKeySampleExtractorTask.h"
 #include "KWSortedChunkBuilderTask.h"
+#include "KWFileSorter.h"
 #include "KWKeySizeEvaluatorTask.h"
 #include "KWFileKeyExtractorTask.h"
 #include "KWDatabaseCheckTask.h"
@@ -129,6 +129,7 @@ void KWBenchmarkSpec::DeleteLearningSpec()
 		delete database;
 	learningSpec = NULL;
 	database = NULL;
+	svTargetValues.SetSize(0);
 }
 
 void KWBenchmarkSpec::ComputeBenchmarkStats()
@@ -140,6 +141,8 @@ void KWBenchmarkSpec::ComputeBenchmarkStats()
 	KWDescriptiveContinuousStats* targetContinuousStats;
 	KWDescriptiveSymbolStats* targetSymbolStats;
 	KWObject* kwoObject;
+	KWLoadIndex liTargetLoadIndex;
+	int i;
 	ALString sTmp;
 
 	require(IsLearningSpecValid());
@@ -189,6 +192,20 @@ void KWBenchmarkSpec::ComputeBenchmarkStats()
 	nDatabaseInstanceNumber = GetDatabase()->GetObjects()->GetSize();
 	database->AddMessage(sTmp + "Read records: " + IntToString(nDatabaseInstanceNumber));
 
+	// Memorisation des valeurs cibles dans le cas categoriel, ce qui permet ensuite de calculer
+	// les decoupages stratifies de chaque cross-validation sans relire la base
+	svTargetValues.SetSize(0);
+	if (GetLearningSpec()->GetTargetAttributeType() == KWType::Symbol)
+	{
+		liTargetLoadIndex = learningClass->LookupAttribute(GetTargetAttributeName())->GetLoadIndex();
+		svTargetValues.SetSize(nDatabaseInstanceNumber);
+		for (i = 0; i < nDatabaseInstanceNumber; i++)
+		{
+			kwoObject = cast(KWObject*, database->GetObjects()->GetAt(i));
+			svTargetValues.SetAt(i, kwoObject->GetSymbolValueAt(liTargetLoadIndex));
+		}
+	}
+
 	// Calcul des statistiques sur l'attribut cible
 	if (GetLearningSpec()->GetTargetAttributeType() == KWType::Continuous or
 	    GetLearningSpec()->GetTargetAttributeType() == KWType::Symbol)
@@ -321,12 +338,7 @@ void KWBenchmarkSpec::WriteLineReport(ostream& ost)
 void KWBenchmarkSpec::ComputeFoldIndexes(int nSeed, int nFoldNumber, boolean bStratified,
 					 IntVector* ivResultFoldIndexes)
 {
-	KWClass* learningClass;
-	KWDatabase* workingDatabase;
-	KWAttribute* attribute;
 	int i;
-	KWObject* kwoObject;
-	KWLoadIndex liTargetLoadIndex;
 	KWSortableContinuousSymbol* indexedTargetValueRandom;
 	ObjectArray oaIndexedTargetValues;
 	Symbol sModalityRef;
@@ -352,55 +364,24 @@ void KWBenchmarkSpec::ComputeFoldIndexes(int nSeed, int nFoldNumber, boolean bSt
 	else
 	{
 		assert(GetTargetAttributeType() == KWType::Symbol and bStratified);
+		assert(svTargetValues.GetSize() == GetDatabaseInstanceNumber());
 
 		////////////////////////////////////////////////////////////////////
-		// Recherche des index et valeurs cible de la base
-
-		// Preparation de la classe pour ne charger que l'attribut cible
-		learningClass = learningSpec->GetClass();
-		learningClass->SetAllAttributesLoaded(false);
-		attribute = learningClass->LookupAttribute(GetTargetAttributeName());
-		if (attribute != NULL)
-			attribute->SetLoaded(true);
-		learningClass->GetDomain()->Compile();
-
-		// Creation d'une base de travail
-		assert(database == learningSpec->GetDatabase());
-		workingDatabase = database->Clone();
-
-		// Reinitialisation des eventuels marquages d'instances dans la base
-		workingDatabase->GetMarkedInstances()->SetSize(0);
-
-		// Lecture de la base d'origine et transfert vers la base de travail
-		workingDatabase->SetVerboseMode(false);
-		workingDatabase->ReadAll();
-		assert(GetDatabaseInstanceNumber() == workingDatabase->GetObjects()->GetSize());
-		workingDatabase->SetVerboseMode(true);
+		// Recherche des valeurs cible de la base, memorisees lors du calcul des statistiques
 
 		// Memorisation dans un tableau des triplets (index, random value,valeur cible)
 		SetRandomSeed(nSeed);
-		liTargetLoadIndex = learningClass->LookupAttribute(GetTargetAttributeName())->GetLoadIndex();
-		oaIndexedTargetValues.SetSize(workingDatabase->GetObjects()->GetSize());
-		for (i = 0; i < workingDatabase->GetObjects()->GetSize(); i++)
+		oaIndexedTargetValues.SetSize(svTargetValues.GetSize());
+		for (i = 0; i < svTargetValues.GetSize(); i++)
 		{
-			kwoObject = cast(KWObject*, workingDatabase->GetObjects()->GetAt(i));
-
 			// Memorisation de l'index, de la valeur cible de l'objet et d'une valeur aleatoire
 			indexedTargetValueRandom = new KWSortableContinuousSymbol;
 			oaIndexedTargetValues.SetAt(i, indexedTargetValueRandom);
 			indexedTargetValueRandom->SetIndex(i);
-			indexedTargetValueRandom->SetSymbol(kwoObject->GetSymbolValueAt(liTargetLoadIndex));
+			indexedTargetValueRandom->SetSymbol(svTargetValues.GetAt(i));
 			indexedTargetValueRandom->SetSortValue(RandomDouble());
 		}
 
-		// Nettoyage
-		workingDatabase->DeleteAll();
-		delete workingDatabase;
-
-		// Restitution de l'etat initial de la classe
-		learningClass->SetAllAttributesLoaded(true);
-		learningClass->GetDomain()->Compile();
-
 		////////////////////////////////////////////////////////////////////
 		// Calcul de l'echantillonage stratifie
 
@@ -106,9 +106,10 @@ public:
 	// Les resultats sont memorises dans le vecteur d'index passe en parametres.
 	// Les index sont dans ranges dans l'ordre des instances du fichier et
 	// correspondent a numero de la partie (le premier index vaut 0).
-	// Les eventuels marquages d'instances dans la base sont prealablement reinitialises.
 	// Les index des enregistrements permettent d'associer les instance a leur index et
 	// de parametrer leur marquage dans la base
+	// Prerequis: les statistiques du benchmark doivent etre calculees; le cas stratifie exploite
+	// les valeurs cibles memorisees lors de ce calcul, sans relecture de la base
 	void ComputeFoldIndexes(int nSeed, int nFoldNumber, boolean bStratified, IntVector* ivResultFoldIndexes);
 
 	// Parametrage de la lecture d'une base de donnees en choisissant une partie
@@ -144,6 +145,10 @@ protected:
 	// via le marquage de la database
 	IntVector ivPhysicalRecordIndexes;
 
+	// Valeurs cibles des instances de la base dans le cas categoriel, memorisees lors du calcul des
+	// statistiques pour le decoupage stratifie des cross-validations
+	SymbolVector svTargetValues;
+
 	// Attributs de statistiques sur le benchmark
 	int nDatabaseInstanceNumber;
 	int nSymbolAttributeNumber;
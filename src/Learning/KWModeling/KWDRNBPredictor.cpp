@@ -497,15 +497,11 @@ KWDRNBClassifier::CheckOperandsCompletenessForTargetValues(const KWClass* kwcOwn
 	KWDRUnivariatePartition* univariatePartitionRule;
 	KWDRSymbolValueSet* symbolValueSetRule;
 	KWDRValueGroups* symbolValueGroupsRule;
-	KWDRSymbolValueSet refSymbolValueSetRule;
-	KWDRValueGroups refSymbolValueGroupsRule;
-	KWDRSymbolValueSet checkedSymbolValueSetRule;
 	int nValue;
 	Symbol sValue;
 	NumericKeyDictionary nkdCheckedValues;
 	int nGroup;
 	KWDRValueGroup* symbolValueGroupRule;
-	KWDRValueGroup checkedSymbolValueGroupRule;
 	ALString sTmp;
 
 	// Creation du message d'operand conditionel a son appartenance a un bloc
@@ -522,18 +518,20 @@ KWDRNBClassifier::CheckOperandsCompletenessForTargetValues(const KWClass* kwcOwn
 	assert(univariatePartitionRule->GetAttributeType() == KWType::Symbol);
 
 	// Test du type de partition cible: soit ensemble de valeurs, soit ensemble de groupes de valeurs
+	// On utilise les noms de structure memorises par les grilles, plutot que des regles de reference
+	// couteuses a construire pour chaque grille d'un classifieur
 	symbolValueSetRule = NULL;
 	symbolValueGroupsRule = NULL;
-	if (univariatePartitionRule->GetStructureName() == refSymbolValueSetRule.GetStructureName())
+	if (univariatePartitionRule->GetStructureName() == KWDRDataGrid::sSymbolValueSetStructureName)
 		symbolValueSetRule = cast(KWDRSymbolValueSet*, univariatePartitionRule);
-	else if (univariatePartitionRule->GetStructureName() == refSymbolValueGroupsRule.GetStructureName())
+	else if (univariatePartitionRule->GetStructureName() == KWDRDataGrid::sValueGroupsStructureName)
 		symbolValueGroupsRule = cast(KWDRValueGroups*, univariatePartitionRule);
 	else
 	{
 		AddError(sTmp + "Type of target partition for " + sDataGridIdentifierMessage + " (" +
 			 univariatePartitionRule->GetStructureName() + ") " + "should be " +
-			 refSymbolValueSetRule.GetStructureName() + " or " +
-			 refSymbolValueGroupsRule.GetStructureName());
+			 KWDRDataGrid::sSymbolValueSetStructureName + " or " +
+			 KWDRDataGrid::sValueGroupsStructureName);
 		bOk = false;
 	}
 	assert((symbolValueSetRule == NULL and symbolValueGroupsRule != NULL) or
@@ -542,6 +540,8 @@ KWDRNBClassifier::CheckOperandsCompletenessForTargetValues(const KWClass* kwcOwn
 	// Cas d'une grille definie par un ensemble de valeurs
 	if (symbolValueSetRule != NULL)
 	{
+		KWDRSymbolValueSet checkedSymbolValueSetRule;
+
 		// Memorisation des valeurs cibles, en les transferant vers une representation structuree
 		checkedSymbolValueSetRule.SetValueNumber(symbolValueSetRule->GetValueNumber());
 		if (not symbolValueSetRule->GetStructureInterface())
@@ -577,6 +577,8 @@ KWDRNBClassifier::CheckOperandsCompletenessForTargetValues(const KWClass* kwcOwn
 	// Cas d'une grille definie par un ensemble de groupes de valeurs
 	else if (symbolValueGroupsRule != NULL)
 	{
+		KWDRValueGroup checkedSymbolValueGroupRule;
+
 		// Rangement des valeurs cibles dans un dictionnaire
 		for (nValue = 0; nValue < refCheckedSymbolValueSetRule->GetValueNumber(); nValue++)
 		{
@@ -16,6 +16,9 @@ KWLearningBenchmark::KWLearningBenchmark()
 	bExperimentReport = true;
 	bRunReport = false;
 	bExportBenchmarkDatabases = false;
+	sharedClassStats = NULL;
+	sharedPreparationDomain = NULL;
+	dSharedPreprocessingComputingTime = 0;
 }
 
 KWLearningBenchmark::~KWLearningBenchmark()
@@ -24,6 +27,7 @@ KWLearningBenchmark::~KWLearningBenchmark()
 	oaPredictorSpecs.DeleteAll();
 	DeleteEvaluations();
 	DeleteCriterions();
+	DeleteSharedPreparation();
 }
 
 void KWLearningBenchmark::SetTargetAttributeType(int nValue)
@@ -191,23 +195,24 @@ void KWLearningBenchmark::Evaluate()
 				benchmarkSpec->ComputeFoldIndexes(nSeed, GetFoldNumber(), GetStratified(),
 								  &ivFoldIndexes);
 
-				// Evaluation des predicteurs
-				for (nPredictor = 0; nPredictor < GetPredictorSpecs()->GetSize(); nPredictor++)
+				// Boucle sur les parties de la cross-validation
+				// Les predicteurs sont evalues successivement sur chaque partie, ce qui leur permet
+				// de partager la preparation des donnees de la partie quand leur parametrage de
+				// preparation est identique (cf. BuildSharedPreparationKey)
+				for (nFold = 0; nFold < GetFoldNumber(); nFold++)
 				{
-					// Boucle sur les parties de la cross-validation
-					for (nFold = 0; nFold < GetFoldNumber(); nFold++)
+					// Export des base en apprentissage et test, si demande
+					if (GetExportBenchmarkDatabases())
 					{
-						// Export des base en apprentissage et test, si demande
-						// Uniquement pour le premier predicteur pour ne pas repeter l'operation
-						// inutilement
-						if (GetExportBenchmarkDatabases() and nPredictor == 0)
-						{
-							ExportBenchmarkDatabase(benchmarkSpec, nValidation, nFold, true,
-										&ivFoldIndexes);
-							ExportBenchmarkDatabase(benchmarkSpec, nValidation, nFold,
-										false, &ivFoldIndexes);
-						}
+						ExportBenchmarkDatabase(benchmarkSpec, nValidation, nFold, true,
+									&ivFoldIndexes);
+						ExportBenchmarkDatabase(benchmarkSpec, nValidation, nFold, false,
+									&ivFoldIndexes);
+					}
 
+					// Evaluation des predicteurs
+					for (nPredictor = 0; nPredictor < GetPredictorSpecs()->GetSize(); nPredictor++)
+					{
 						// Evaluation unitaire
 						EvaluateExperiment(nBenchmark, nPredictor, nValidation, nFold,
 								   &ivFoldIndexes);
@@ -217,6 +222,9 @@ void KWLearningBenchmark::Evaluate()
 							break;
 					}
 
+					// Nettoyage de la preparation partagee de la partie
+					DeleteSharedPreparation();
+
 					// Arret si interruption demandee
 					if (TaskProgression::IsInterruptionRequested())
 						break;
@@ -859,6 +867,7 @@ void KWLearningBenchmark::EvaluateExperiment(int nBenchmark, int nPredictor, int
 	ALString sMainLabel;
 	int nTotalExperimentNumber;
 	int nExperimentIndex;
+	ALString sPreparationKey;
 	double dTotalComputingTime;
 	double dPreprocessingComputingTime;
 	clock_t tBegin;
@@ -898,9 +907,9 @@ void KWLearningBenchmark::EvaluateExperiment(int nBenchmark, int nPredictor, int
 	TaskProgression::DisplayMainLabel(sMainLabel);
 	nTotalExperimentNumber = GetBenchmarkSpecs()->GetSize() * GetPredictorSpecs()->GetSize() *
 				 GetCrossValidationNumber() * GetFoldNumber();
-	nExperimentIndex = nBenchmark * GetCrossValidationNumber() * GetPredictorSpecs()->GetSize() * GetFoldNumber() +
-			   nValidation * GetPredictorSpecs()->GetSize() * GetFoldNumber() +
-			   nPredictor * GetFoldNumber() + nFold + 1;
+	nExperimentIndex = nBenchmark * GetCrossValidationNumber() * GetFoldNumber() * GetPredictorSpecs()->GetSize() +
+			   nValidation * GetFoldNumber() * GetPredictorSpecs()->GetSize() +
+			   nFold * GetPredictorSpecs()->GetSize() + nPredictor + 1;
 	TaskProgression::DisplayProgression((nExperimentIndex * 100) / nTotalExperimentNumber);
 
 	//////////////////////////////////////////////////////////
@@ -914,58 +923,92 @@ void KWLearningBenchmark::EvaluateExperiment(int nBenchmark, int nPredictor, int
 	// Parametrage des instances a garder en apprentissage
 	benchmarkSpec->ComputeDatabaseSelectedInstance(ivFoldIndexes, nFold, true);
 
-	// Creation d'un objet de calcul des stats
-	classStats = new KWClassStats;
-
 	// Parametrage du nombre initial d'attributs
 	learningSpec->SetInitialAttributeNumber(
 	    learningSpec->GetClass()->ComputeInitialAttributeNumber(GetTargetAttributeType() != KWType::None));
-
-	// Construction d'une classe avec de nouvelles variables si necessaire
 	initialDomain = KWClassDomain::GetCurrentDomain();
-	constructedClass =
-	    BuildLearningSpecConstructedClass(learningSpec, predictorSpec, classStats->GetMultiTableConstructionSpec(),
-					      classStats->GetTextConstructionSpec());
 
-	// On prend le domaine de construction comme domaine de travail
-	if (constructedClass != NULL)
+	// Reutilisation de la preparation du predicteur precedent si elle est partageable
+	sPreparationKey = BuildSharedPreparationKey(nBenchmark, nValidation, nFold, predictorSpec);
+	if (sPreparationKey != "" and sPreparationKey == sSharedPreparationKey)
 	{
-		KWClassDomain::SetCurrentDomain(constructedClass->GetDomain());
-		learningSpec->SetClass(constructedClass);
+		assert(sharedClassStats != NULL and sharedPreparationDomain != NULL);
+
+		// On reprend le domaine de travail et les statistiques de la preparation partagee
+		classStats = sharedClassStats;
+		KWClassDomain::SetCurrentDomain(sharedPreparationDomain);
+		learningSpec->SetClass(sharedPreparationDomain->LookupClass(learningSpec->GetClass()->GetName()));
+		assert(learningSpec->Check());
+
+		// Le temps de preprocessing est celui de la preparation partagee, compte dans le temps total
+		dPreprocessingComputingTime = dSharedPreprocessingComputingTime;
+		tBegin = clock() - (clock_t)(dPreprocessingComputingTime * CLOCKS_PER_SEC);
 	}
-	// Sinon, on change quand meme de domaine de travail (pour la creation potentielle de nouvelles variables)
+	// Sinon, calcul de la preparation
 	else
 	{
-		KWClassDomain::SetCurrentDomain(KWClassDomain::GetCurrentDomain()->Clone());
-		KWClassDomain::GetCurrentDomain()->Compile();
-		learningSpec->SetClass(
-		    KWClassDomain::GetCurrentDomain()->LookupClass(learningSpec->GetClass()->GetName()));
-	}
-	assert(learningSpec->Check());
+		// Nettoyage de la preparation partagee precedente
+		DeleteSharedPreparation();
 
-	// Prise en compte des specification de construction d'arbres
-	if (KDDataPreparationAttributeCreationTask::GetGlobalCreationTask())
-	{
-		// On recopie les specifications de creation d'attributs
-		KDDataPreparationAttributeCreationTask::GetGlobalCreationTask()->CopyAttributeCreationSpecFrom(
-		    predictorSpec->GetAttributeConstructionSpec()->GetAttributeCreationParameters());
+		// Creation d'un objet de calcul des stats
+		classStats = new KWClassStats;
 
-		// On recopie le nombre d'attributs a construire, qui est specifie dans au niveau au dessus
-		KDDataPreparationAttributeCreationTask::GetGlobalCreationTask()->SetMaxCreatedAttributeNumber(
-		    predictorSpec->GetAttributeConstructionSpec()->GetMaxTreeNumber());
-	}
+		// Construction d'une classe avec de nouvelles variables si necessaire
+		constructedClass = BuildLearningSpecConstructedClass(learningSpec, predictorSpec,
+								     classStats->GetMultiTableConstructionSpec(),
+								     classStats->GetTextConstructionSpec());
+
+		// On prend le domaine de construction comme domaine de travail
+		if (constructedClass != NULL)
+		{
+			KWClassDomain::SetCurrentDomain(constructedClass->GetDomain());
+			learningSpec->SetClass(constructedClass);
+		}
+		// Sinon, on change quand meme de domaine de travail
+		// (pour la creation potentielle de nouvelles variables)
+		else
+		{
+			KWClassDomain::SetCurrentDomain(KWClassDomain::GetCurrentDomain()->Clone());
+			KWClassDomain::GetCurrentDomain()->Compile();
+			learningSpec->SetClass(
+			    KWClassDomain::GetCurrentDomain()->LookupClass(learningSpec->GetClass()->GetName()));
+		}
+		assert(learningSpec->Check());
 
-	// Prise en compte des paires de variables demandees par le predicteur
-	predictorSpec->GetAttributeConstructionSpec()->GetAttributePairsSpec()->SetClassName(
-	    learningSpec->GetClass()->GetName());
-	classStats->SetAttributePairsSpec(predictorSpec->GetAttributeConstructionSpec()->GetAttributePairsSpec());
+		// Prise en compte des specification de construction d'arbres
+		if (KDDataPreparationAttributeCreationTask::GetGlobalCreationTask())
+		{
+			// On recopie les specifications de creation d'attributs
+			KDDataPreparationAttributeCreationTask::GetGlobalCreationTask()->CopyAttributeCreationSpecFrom(
+			    predictorSpec->GetAttributeConstructionSpec()->GetAttributeCreationParameters());
+
+			// On recopie le nombre d'attributs a construire, qui est specifie dans au niveau au dessus
+			KDDataPreparationAttributeCreationTask::GetGlobalCreationTask()->SetMaxCreatedAttributeNumber(
+			    predictorSpec->GetAttributeConstructionSpec()->GetMaxTreeNumber());
+		}
 
-	// Calcul des stats descriptives
-	tBegin = clock();
-	classStats->SetLearningSpec(learningSpec);
-	classStats->ComputeStats();
-	tPreprocessingEnd = clock();
-	dPreprocessingComputingTime = (double)(tPreprocessingEnd - tBegin) / CLOCKS_PER_SEC;
+		// Prise en compte des paires de variables demandees par le predicteur
+		predictorSpec->GetAttributeConstructionSpec()->GetAttributePairsSpec()->SetClassName(
+		    learningSpec->GetClass()->GetName());
+		classStats->SetAttributePairsSpec(
+		    predictorSpec->GetAttributeConstructionSpec()->GetAttributePairsSpec());
+
+		// Calcul des stats descriptives
+		tBegin = clock();
+		classStats->SetLearningSpec(learningSpec);
+		classStats->ComputeStats();
+		tPreprocessingEnd = clock();
+		dPreprocessingComputingTime = (double)(tPreprocessingEnd - tBegin) / CLOCKS_PER_SEC;
+
+		// Memorisation de la preparation pour les predicteurs suivants si elle est partageable
+		if (sPreparationKey != "")
+		{
+			sSharedPreparationKey = sPreparationKey;
+			sharedClassStats = classStats;
+			sharedPreparationDomain = KWClassDomain::GetCurrentDomain();
+			dSharedPreprocessingComputingTime = dPreprocessingComputingTime;
+		}
+	}
 
 	// Apprentissage
 	if (classStats->IsStatsComputed())
@@ -1036,18 +1079,59 @@ void KWLearningBenchmark::EvaluateExperiment(int nBenchmark, int nPredictor, int
 		}
 	}
 
-	// Restitution du domaine initial
+	// Restitution du domaine initial, en gardant le domaine de travail s'il est partage
 	if (initialDomain != KWClassDomain::GetCurrentDomain())
 	{
 		learningSpec->SetClass(initialDomain->LookupClass(learningSpec->GetClass()->GetName()));
-		delete KWClassDomain::GetCurrentDomain();
+		if (KWClassDomain::GetCurrentDomain() != sharedPreparationDomain)
+			delete KWClassDomain::GetCurrentDomain();
 		KWClassDomain::SetCurrentDomain(initialDomain);
 	}
 
-	// Nettoyage
+	// Nettoyage, en gardant les statistiques si elles sont partagees
 	predictorSpec->GetPredictor()->SetClassStats(NULL);
 	predictorSpec->GetPredictor()->SetLearningSpec(NULL);
-	delete classStats;
+	if (classStats != sharedClassStats)
+		delete classStats;
+}
+
+const ALString KWLearningBenchmark::BuildSharedPreparationKey(int nBenchmark, int nValidation, int nFold,
+							       KWPredictorSpec* predictorSpec) const
+{
+	KWAttributeConstructionSpec* constructionSpec;
+	ostringstream ossKey;
+	ALString sKey;
+
+	require(predictorSpec != NULL);
+
+	// Pas de partage en cas de construction de variables, de paires ou d'arbres, dont le resultat
+	// depend du parametrage propre a chaque predicteur
+	constructionSpec = predictorSpec->GetAttributeConstructionSpec();
+	if (constructionSpec->GetMaxConstructedAttributeNumber() > 0 or
+	    constructionSpec->GetMaxTextFeatureNumber() > 0 or constructionSpec->GetMaxTreeNumber() > 0 or
+	    constructionSpec->GetMaxAttributePairNumber() > 0)
+		return sKey;
+
+	// Sinon, la preparation ne depend que de la partie de la cross-validation et du preprocessing
+	ossKey << nBenchmark << "\t" << nValidation << "\t" << nFold << "\n";
+	ossKey << *predictorSpec->GetPreprocessingSpec();
+	sKey = ossKey.str().c_str();
+	return sKey;
+}
+
+void KWLearningBenchmark::DeleteSharedPreparation()
+{
+	// Le domaine partage ne doit plus etre le domaine courant
+	require(sharedPreparationDomain == NULL or KWClassDomain::GetCurrentDomain() != sharedPreparationDomain);
+
+	if (sharedClassStats != NULL)
+		delete sharedClassStats;
+	if (sharedPreparationDomain != NULL)
+		delete sharedPreparationDomain;
+	sharedClassStats = NULL;
+	sharedPreparationDomain = NULL;
+	sSharedPreparationKey = "";
+	dSharedPreprocessingComputingTime = 0;
 }
 
 KWClass* KWLearningBenchmark::BuildLearningSpecConstructedClass(KWLearningSpec* learningSpec,
@@ -214,6 +214,17 @@ protected:
 							   ObjectDictionary* odMultiTableConstructedAttributes,
 							   ObjectDictionary* odTextConstructedAttributes);
 
+	// Cle de partage de la preparation des donnees entre les predicteurs d'une meme partie de cross-validation
+	// Les predicteurs evalues successivement sur une partie avec la meme cle reutilisent le domaine de travail
+	// et les statistiques calculees pour le premier d'entre eux, sans relire la base
+	// Renvoie une cle vide si la preparation n'est pas partageable
+	// (construction de variables, d'arbres ou de paires)
+	virtual const ALString BuildSharedPreparationKey(int nBenchmark, int nValidation, int nFold,
+							 KWPredictorSpec* predictorSpec) const;
+
+	// Destruction de la preparation partagee courante
+	void DeleteSharedPreparation();
+
 	// Mise a jour des resultats d'evaluation sur tous les criteres
 	// en apprentissage et en test
 	// Cette methode est appelee par EvaluateExperiment(), d'abord en
@@ -266,4 +277,10 @@ protected:
 
 	// Parametrage des l'export des bases
 	boolean bExportBenchmarkDatabases;
+
+	// Preparation partagee entre predicteurs pour la partie de cross-validation courante
+	ALString sSharedPreparationKey;
+	KWClassStats* sharedClassStats;
+	KWClassDomain* sharedPreparationDomain;
+	double dSharedPreprocessingComputingTime;
 };
@@ -200,6 +200,20 @@ KWPredictorEvaluation* KWPredictor::Evaluate(KWDatabase* database)
 	require(IsTrained());
 	require(database != NULL);
 
+	// Creation des resultats d'evaluation selon le type de predicteur
+	predictorEvaluation = CreatePredictorEvaluation();
+
+	// Evaluation
+	predictorEvaluation->Evaluate(this, database);
+	return predictorEvaluation;
+}
+
+KWPredictorEvaluation* KWPredictor::CreatePredictorEvaluation() const
+{
+	KWPredictorEvaluation* predictorEvaluation;
+
+	require(IsTrained());
+
 	// Creation des resultats d'evaluation selon le type de predicteur
 	if (GetTargetAttributeType() == KWType::Symbol)
 		predictorEvaluation = new KWClassifierEvaluation;
@@ -210,9 +224,6 @@ KWPredictorEvaluation* KWPredictor::Evaluate(KWDatabase* database)
 		assert(GetTargetAttributeType() == KWType::None);
 		predictorEvaluation = new KWPredictorEvaluation;
 	}
-
-	// Evaluation
-	predictorEvaluation->Evaluate(this, database);
 	return predictorEvaluation;
 }
 
@@ -129,6 +129,11 @@ public:
 	// Memoire: l'objet rendu appartient a l'appelant
 	virtual KWPredictorEvaluation* Evaluate(KWDatabase* database);
 
+	// Creation d'un objet d'evaluation du predicteur, non encore evalue, selon le type de predicteur
+	// Cette methode peut etre redefinie pour specialiser les resultats d'evaluation
+	// Memoire: l'objet rendu appartient a l'appelant
+	virtual KWPredictorEvaluation* CreatePredictorEvaluation() const;
+
 	/////////////////////////////////////////////////////////////////////////
 	// Administration des predicteurs
 
@@ -35,13 +35,8 @@ void KWPredictorEvaluation::Evaluate(KWPredictor* predictor, KWDatabase* databas
 	require(KWType::IsPredictorType(predictor->GetTargetAttributeType()));
 	require(database->GetObjects()->GetSize() == 0);
 
-	// Initialisation des criteres d'evaluation
-	InitializeCriteria();
-
-	// Memorisation du contexte d'evaluation
-	sPredictorName = predictor->GetObjectLabel();
-	evaluationDatabaseSpec.CopyFrom(database);
-	SetLearningSpec(predictor->GetLearningSpec());
+	// Initialisation des criteres et memorisation du contexte d'evaluation
+	PrepareEvaluation(predictor, database);
 
 	// Personnalisation du dictionnaire de deploiement pour l'evaluation
 	trainedPredictor = predictor->GetTrainedPredictor();
@@ -91,6 +86,68 @@ void KWPredictorEvaluation::Evaluate(KWPredictor* predictor, KWDatabase* databas
 	delete evaluationDatabase;
 }
 
+void KWPredictorEvaluation::EvaluatePredictors(const ObjectArray* oaPredictors, KWDatabase* database,
+					       ObjectArray* oaPredictorEvaluations)
+{
+	KWPredictor* predictor;
+	KWPredictorEvaluation* predictorEvaluation;
+	KWPredictorEvaluationTask* predictorEvaluationTask;
+	StringVector svTaskNames;
+	ObjectArray oaGroupPredictors;
+	ObjectArray oaGroupEvaluations;
+	IntVector ivEvaluatedPredictors;
+	int nFirstEvaluation;
+	int i;
+	int j;
+
+	require(oaPredictors != NULL);
+	require(database != NULL);
+	require(database->GetObjects()->GetSize() == 0);
+	require(oaPredictorEvaluations != NULL);
+
+	// Creation des evaluations, et memorisation du type de tache sous-traitante de chaque evaluation
+	nFirstEvaluation = oaPredictorEvaluations->GetSize();
+	for (i = 0; i < oaPredictors->GetSize(); i++)
+	{
+		predictor = cast(KWPredictor*, oaPredictors->GetAt(i));
+		require(predictor->IsTrained());
+		require(KWType::IsPredictorType(predictor->GetTargetAttributeType()));
+		predictorEvaluation = predictor->CreatePredictorEvaluation();
+		oaPredictorEvaluations->Add(predictorEvaluation);
+		predictorEvaluationTask = predictorEvaluation->CreatePredictorEvaluationTask();
+		svTaskNames.Add(predictorEvaluationTask->GetTaskName());
+		delete predictorEvaluationTask;
+	}
+
+	// Evaluation par groupe de predicteurs de meme type de tache, dans l'ordre des predicteurs
+	ivEvaluatedPredictors.SetSize(oaPredictors->GetSize());
+	for (i = 0; i < oaPredictors->GetSize(); i++)
+	{
+		if (ivEvaluatedPredictors.GetAt(i) == 0)
+		{
+			// Constitution du groupe
+			oaGroupPredictors.SetSize(0);
+			oaGroupEvaluations.SetSize(0);
+			for (j = i; j < oaPredictors->GetSize(); j++)
+			{
+				if (ivEvaluatedPredictors.GetAt(j) == 0 and svTaskNames.GetAt(j) == svTaskNames.GetAt(i))
+				{
+					oaGroupPredictors.Add(oaPredictors->GetAt(j));
+					oaGroupEvaluations.Add(oaPredictorEvaluations->GetAt(nFirstEvaluation + j));
+					ivEvaluatedPredictors.SetAt(j, 1);
+				}
+			}
+
+			// Evaluation du groupe
+			EvaluatePredictorGroup(&oaGroupPredictors, database, &oaGroupEvaluations);
+
+			// Arret si interruption
+			if (TaskProgression::IsInterruptionRequested())
+				break;
+		}
+	}
+}
+
 void KWPredictorEvaluation::Initialize()
 {
 	KWDatabase emptyDatabase;
@@ -362,6 +419,340 @@ KWPredictorEvaluationTask* KWPredictorEvaluation::CreatePredictorEvaluationTask(
 	return new KWPredictorEvaluationTask;
 }
 
+void KWPredictorEvaluation::PrepareEvaluation(KWPredictor* predictor, KWDatabase* database)
+{
+	require(predictor != NULL);
+	require(database != NULL);
+
+	// Initialisation des criteres d'evaluation
+	InitializeCriteria();
+
+	// Memorisation du contexte d'evaluation
+	sPredictorName = predictor->GetObjectLabel();
+	evaluationDatabaseSpec.CopyFrom(database);
+	SetLearningSpec(predictor->GetLearningSpec());
+}
+
+void KWPredictorEvaluation::EvaluatePredictorGroup(const ObjectArray* oaPredictors, KWDatabase* database,
+						   const ObjectArray* oaPredictorEvaluations)
+{
+	boolean bOk = true;
+	KWPredictor* predictor;
+	KWPredictorEvaluation* predictorEvaluation;
+	KWLearningSpec currentLearningSpec;
+	KWClassDomain* currentDomain;
+	KWClassDomain* evaluationDomain;
+	KWClass* evaluationClass;
+	KWDatabase* evaluationDatabase;
+	KWPredictorEvaluationTask* predictorEvaluationTask;
+	StringVector svAttributePrefixes;
+	int i;
+
+	require(oaPredictors != NULL);
+	require(oaPredictors->GetSize() > 0);
+	require(oaPredictorEvaluations != NULL);
+	require(oaPredictorEvaluations->GetSize() == oaPredictors->GetSize());
+	require(database != NULL);
+
+	// Evaluation standard dans le cas d'un seul predicteur
+	if (oaPredictors->GetSize() == 1)
+	{
+		predictor = cast(KWPredictor*, oaPredictors->GetAt(0));
+		predictorEvaluation = cast(KWPredictorEvaluation*, oaPredictorEvaluations->GetAt(0));
+		predictorEvaluation->Evaluate(predictor, database);
+		return;
+	}
+
+	// Initialisation des criteres, memorisation du contexte d'evaluation et
+	// personnalisation des dictionnaires de deploiement pour l'evaluation
+	for (i = 0; i < oaPredictors->GetSize(); i++)
+	{
+		predictor = cast(KWPredictor*, oaPredictors->GetAt(i));
+		predictorEvaluation = cast(KWPredictorEvaluation*, oaPredictorEvaluations->GetAt(i));
+		predictorEvaluation->PrepareEvaluation(predictor, database);
+		predictor->GetTrainedPredictor()->PrepareDeploymentClass(true, true);
+	}
+
+	// Construction du domaine d'evaluation fusionne
+	evaluationDomain = BuildFusedEvaluationDomain(oaPredictors, &svAttributePrefixes);
+
+	// Evaluation separee des predicteurs si les dictionnaires ne sont pas fusionnables
+	if (evaluationDomain == NULL)
+	{
+		for (i = 0; i < oaPredictors->GetSize(); i++)
+		{
+			predictor = cast(KWPredictor*, oaPredictors->GetAt(i));
+			predictorEvaluation = cast(KWPredictorEvaluation*, oaPredictorEvaluations->GetAt(i));
+			predictor->GetTrainedPredictor()->PrepareDeploymentClass(true, false);
+			predictorEvaluation->Evaluate(predictor, database);
+			if (TaskProgression::IsInterruptionRequested())
+				break;
+		}
+		return;
+	}
+
+	// Changement du LearningSpec courant a celui du premier predicteur
+	predictor = cast(KWPredictor*, oaPredictors->GetAt(0));
+	currentLearningSpec.CopyFrom(predictor->GetLearningSpec());
+
+	// Mise en place du domaine d'evaluation et compilation
+	currentDomain = KWClassDomain::GetCurrentDomain();
+	KWClassDomain::SetCurrentDomain(evaluationDomain);
+	evaluationDomain->Compile();
+	evaluationClass =
+	    evaluationDomain->LookupClass(predictor->GetTrainedPredictor()->GetPredictorClass()->GetName());
+	check(evaluationClass);
+
+	// Clonage de la base d'evaluation, pour ne pas interagir avec les spec d'apprentissage en cours
+	evaluationDatabase = database->Clone();
+	evaluationDatabase->SetClassName(evaluationClass->GetName());
+
+	// Parametrage de la base et de la classe d'evaluation
+	predictor->GetLearningSpec()->SetDatabase(evaluationDatabase);
+	predictor->GetLearningSpec()->SetClass(evaluationClass);
+
+	// Lancement de la tache d'evaluation sous-traitante pour l'ensemble des predicteurs
+	predictorEvaluation = cast(KWPredictorEvaluation*, oaPredictorEvaluations->GetAt(0));
+	predictorEvaluationTask = predictorEvaluation->CreatePredictorEvaluationTask();
+	bOk = predictorEvaluationTask->EvaluatePredictors(oaPredictors, &svAttributePrefixes, evaluationDatabase,
+							  oaPredictorEvaluations);
+
+	// Restitution de l'etat initial
+	predictor->GetLearningSpec()->CopyFrom(&currentLearningSpec);
+	KWClassDomain::SetCurrentDomain(currentDomain);
+	for (i = 0; i < oaPredictors->GetSize(); i++)
+	{
+		predictor = cast(KWPredictor*, oaPredictors->GetAt(i));
+		predictorEvaluation = cast(KWPredictorEvaluation*, oaPredictorEvaluations->GetAt(i));
+		predictor->GetTrainedPredictor()->PrepareDeploymentClass(true, false);
+
+		// Reinitialisation en cas d'echec
+		if (bOk)
+			predictorEvaluation->bIsStatsComputed = true;
+		else
+			predictorEvaluation->Initialize();
+	}
+
+	// Nettoyage
+	delete predictorEvaluationTask;
+	delete evaluationDatabase;
+	evaluationDomain->DeleteAllClasses();
+	delete evaluationDomain;
+}
+
+KWClassDomain* KWPredictorEvaluation::BuildFusedEvaluationDomain(const ObjectArray* oaPredictors,
+								 StringVector* svAttributePrefixes)
+{
+	boolean bOk = true;
+	boolean bSilentMode;
+	KWClassDomain* fusedDomain;
+	KWTrainedPredictor* trainedPredictor;
+	ALString sAttributePrefix;
+	int nPredictor;
+
+	require(oaPredictors != NULL);
+	require(oaPredictors->GetSize() > 0);
+	require(svAttributePrefixes != NULL);
+
+	// Le domaine fusionne est initialise avec celui du premier predicteur, dont les attributs ne sont pas prefixes
+	trainedPredictor = cast(KWPredictor*, oaPredictors->GetAt(0))->GetTrainedPredictor();
+	fusedDomain = trainedPredictor->GetPredictorDomain()->Clone();
+	fusedDomain->SetName("Evaluation");
+	svAttributePrefixes->SetSize(0);
+	svAttributePrefixes->Add("");
+
+	// Ajout des attributs des autres predicteurs
+	for (nPredictor = 1; nPredictor < oaPredictors->GetSize(); nPredictor++)
+	{
+		trainedPredictor = cast(KWPredictor*, oaPredictors->GetAt(nPredictor))->GetTrainedPredictor();
+		bOk = ImportPredictorClass(fusedDomain, trainedPredictor, nPredictor, sAttributePrefix);
+		if (not bOk)
+			break;
+		svAttributePrefixes->Add(sAttributePrefix);
+	}
+
+	// Verification du domaine fusionne, sans message utilisateur
+	if (bOk)
+	{
+		bSilentMode = Global::GetSilentMode();
+		Global::SetSilentMode(true);
+		bOk = fusedDomain->Check();
+		Global::SetSilentMode(bSilentMode);
+	}
+
+	// Nettoyage si echec
+	if (not bOk)
+	{
+		fusedDomain->DeleteAllClasses();
+		delete fusedDomain;
+		fusedDomain = NULL;
+		svAttributePrefixes->SetSize(0);
+	}
+	return fusedDomain;
+}
+
+boolean KWPredictorEvaluation::ImportPredictorClass(KWClassDomain* fusedDomain,
+						    const KWTrainedPredictor* trainedPredictor, int nPredictor,
+						    ALString& sAttributePrefix)
+{
+	boolean bOk = true;
+	KWClass* fusedClass;
+	KWClassDomain* predictorDomain;
+	KWClass* predictorClass;
+	KWClass* kwcClass;
+	KWClass* fusedSecondaryClass;
+	KWAttribute* attribute;
+	KWAttribute* fusedAttribute;
+	ObjectArray oaDerivedAttributes;
+	ALString sPrefixedName;
+	boolean bCollision;
+	int i;
+	ostringstream osClass;
+	ostringstream osFusedClass;
+
+	require(fusedDomain != NULL);
+	require(fusedDomain->GetClassNumber() > 0);
+	require(trainedPredictor != NULL);
+	require(nPredictor > 0);
+
+	// On travaille sur une copie du domaine du predicteur, qui pourra etre modifiee
+	predictorDomain = trainedPredictor->GetPredictorDomain()->Clone();
+	predictorClass = predictorDomain->LookupClass(trainedPredictor->GetPredictorClass()->GetName());
+	check(predictorClass);
+
+	// Recherche de la classe principale du domaine fusionne, dont les classes secondaires sont communes
+	fusedClass = NULL;
+	for (i = 0; i < fusedDomain->GetClassNumber(); i++)
+	{
+		kwcClass = fusedDomain->GetClassAt(i);
+		if (predictorDomain->LookupClass(kwcClass->GetName()) == NULL or
+		    kwcClass->GetName() == predictorClass->GetName())
+		{
+			if (fusedClass != NULL)
+				bOk = false;
+			fusedClass = kwcClass;
+		}
+	}
+	bOk = bOk and fusedClass != NULL;
+
+	// Les classes secondaires doivent etre identiques
+	for (i = 0; i < predictorDomain->GetClassNumber(); i++)
+	{
+		if (not bOk)
+			break;
+		kwcClass = predictorDomain->GetClassAt(i);
+		if (kwcClass != predictorClass)
+		{
+			fusedSecondaryClass = fusedDomain->LookupClass(kwcClass->GetName());
+			bOk = fusedSecondaryClass != NULL and fusedSecondaryClass != fusedClass;
+			if (bOk)
+			{
+				osClass.str("");
+				osFusedClass.str("");
+				kwcClass->Write(osClass);
+				fusedSecondaryClass->Write(osFusedClass);
+				bOk = osClass.str() == osFusedClass.str();
+			}
+		}
+	}
+
+	// Alignement du nom de la classe du predicteur sur celui de la classe fusionnee
+	if (bOk and predictorClass->GetName() != fusedClass->GetName())
+		predictorDomain->RenameClass(predictorClass, fusedClass->GetName());
+
+	// Verification des attributs natifs et collecte des attributs derives
+	attribute = bOk ? predictorClass->GetHeadAttribute() : NULL;
+	while (attribute != NULL)
+	{
+		// Les attributs natifs doivent exister a l'identique dans la classe fusionnee
+		if (attribute->GetAnyDerivationRule() == NULL)
+		{
+			fusedAttribute = fusedClass->LookupAttribute(attribute->GetName());
+			bOk = fusedAttribute != NULL and fusedAttribute->GetAnyDerivationRule() == NULL and
+			      fusedAttribute->GetType() == attribute->GetType() and
+			      (fusedAttribute->GetAttributeBlock() == NULL) == (attribute->GetAttributeBlock() == NULL);
+			if (bOk and attribute->GetAttributeBlock() != NULL)
+				bOk = fusedAttribute->GetAttributeBlock()->GetName() ==
+				      attribute->GetAttributeBlock()->GetName();
+			if (bOk and KWType::IsRelation(attribute->GetType()))
+				bOk = fusedAttribute->GetClass()->GetName() == attribute->GetClass()->GetName();
+		}
+		// Les attributs derives sont a importer, sauf dans le cas des blocs qui ne sont pas geres
+		else
+		{
+			bOk = attribute->GetAttributeBlock() == NULL;
+			oaDerivedAttributes.Add(attribute);
+		}
+		if (not bOk)
+			break;
+		predictorClass->GetNextAttribute(attribute);
+	}
+
+	// Recherche d'un prefixe sans collision pour les attributs derives
+	if (bOk)
+	{
+		sAttributePrefix = ALString("P") + IntToString(nPredictor) + "_";
+		bCollision = true;
+		while (bCollision)
+		{
+			bCollision = false;
+			for (i = 0; i < oaDerivedAttributes.GetSize(); i++)
+			{
+				attribute = cast(KWAttribute*, oaDerivedAttributes.GetAt(i));
+				sPrefixedName = sAttributePrefix + attribute->GetName();
+				if (fusedClass->LookupAttribute(sPrefixedName) != NULL or
+				    fusedClass->LookupAttributeBlock(sPrefixedName) != NULL or
+				    predictorClass->LookupAttribute(sPrefixedName) != NULL or
+				    predictorClass->LookupAttributeBlock(sPrefixedName) != NULL)
+				{
+					bCollision = true;
+					sAttributePrefix += "_";
+					break;
+				}
+			}
+		}
+	}
+
+	// Renommage des attributs derives, propage dans les regles de derivation du predicteur,
+	// puis import dans la classe fusionnee
+	if (bOk)
+	{
+		for (i = 0; i < oaDerivedAttributes.GetSize(); i++)
+		{
+			attribute = cast(KWAttribute*, oaDerivedAttributes.GetAt(i));
+			predictorDomain->RenameAttribute(attribute, sAttributePrefix + attribute->GetName());
+		}
+		for (i = 0; i < oaDerivedAttributes.GetSize(); i++)
+		{
+			attribute = cast(KWAttribute*, oaDerivedAttributes.GetAt(i));
+			fusedAttribute = attribute->Clone();
+			if (KWType::IsRelation(attribute->GetType()) and attribute->GetClass() != NULL)
+				fusedAttribute->SetClass(fusedDomain->LookupClass(attribute->GetClass()->GetName()));
+			fusedClass->InsertAttribute(fusedAttribute);
+		}
+
+		// Les attributs natifs utilises ou charges par le predicteur le sont egalement dans la classe fusionnee
+		attribute = predictorClass->GetHeadAttribute();
+		while (attribute != NULL)
+		{
+			if (attribute->GetAnyDerivationRule() == NULL)
+			{
+				fusedAttribute = fusedClass->LookupAttribute(attribute->GetName());
+				if (attribute->GetUsed())
+					fusedAttribute->SetUsed(true);
+				if (attribute->GetLoaded())
+					fusedAttribute->SetLoaded(true);
+			}
+			predictorClass->GetNextAttribute(attribute);
+		}
+	}
+
+	// Nettoyage
+	predictorDomain->DeleteAllClasses();
+	delete predictorDomain;
+	return bOk;
+}
+
 int KWPredictorEvaluation::GetMainTargetModalityIndex() const
 {
 	if (GetLearningSpec()->IsTargetStatsComputed())
@@ -389,7 +780,7 @@ KWClassifierEvaluation::~KWClassifierEvaluation()
 	oaAllLiftCurveValues.DeleteAll();
 }
 
-void KWClassifierEvaluation::Evaluate(KWPredictor* predictor, KWDatabase* database)
+void KWClassifierEvaluation::PrepareEvaluation(KWPredictor* predictor, KWDatabase* database)
 {
 	int nTargetIndex;
 	KWTrainedClassifier* classifier;
@@ -405,7 +796,7 @@ void KWClassifierEvaluation::Evaluate(KWPredictor* predictor, KWDatabase* databa
 	}
 
 	// Appel a la methode ancetre
-	KWPredictorEvaluation::Evaluate(predictor, database);
+	KWPredictorEvaluation::PrepareEvaluation(predictor, database);
 }
 
 int KWClassifierEvaluation::GetTargetType() const
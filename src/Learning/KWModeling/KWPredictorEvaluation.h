@@ -10,6 +10,7 @@ class KWRegressorEvaluation;
 
 #include "KWLearningSpec.h"
 #include "KWPredictor.h"
+#include "KWTrainedPredictor.h"
 #include "KWDatabase.h"
 #include "KWDataGridStats.h"
 #include "KWPredictorEvaluationTask.h"
@@ -37,6 +38,17 @@ public:
 	// Evaluation d'un predicteur sur une base
 	virtual void Evaluate(KWPredictor* predictor, KWDatabase* database);
 
+	// Evaluation d'un ensemble de predicteurs appris sur une meme base, en minimisant le nombre de lectures
+	// Les predicteurs dont l'evaluation est sous-traitee au meme type de tache sont evalues simultanement
+	// en une seule lecture de la base, sur un dictionnaire d'evaluation fusionnant leurs dictionnaires de
+	// deploiement. Si les dictionnaires ne sont pas fusionnables (dictionnaires secondaires ou variables
+	// natives differents, variables derivees dans des blocs...), les predicteurs sont evalues separement.
+	// Chaque evaluation est a tester avec IsStatsComputed(), comme pour la methode Evaluate
+	// Memoire: les evaluations sont ajoutees au tableau en sortie dans l'ordre des predicteurs,
+	// et appartiennent a l'appelant
+	static void EvaluatePredictors(const ObjectArray* oaPredictors, KWDatabase* database,
+				       ObjectArray* oaPredictorEvaluations);
+
 	// Reinitialisation de la classe
 	virtual void Initialize();
 
@@ -115,6 +127,28 @@ protected:
 	// Cree un objet de tache parallele pour la sous-traitance de l'evaluation
 	virtual KWPredictorEvaluationTask* CreatePredictorEvaluationTask();
 
+	// Preparation d'une evaluation: reinitialisation des criteres et memorisation du contexte d'evaluation
+	// Methode a specialiser pour memoriser des informations du predicteur utiles a l'evaluation
+	virtual void PrepareEvaluation(KWPredictor* predictor, KWDatabase* database);
+
+	// Evaluation simultanee d'un groupe de predicteurs dont l'evaluation est sous-traitee au meme type de tache
+	static void EvaluatePredictorGroup(const ObjectArray* oaPredictors, KWDatabase* database,
+					   const ObjectArray* oaPredictorEvaluations);
+
+	// Construction d'un domaine d'evaluation fusionnant les domaines de deploiement des predicteurs, prealablement
+	// personnalises pour l'evaluation. La classe principale, nommee comme celle du premier predicteur, comporte
+	// les attributs natifs communs et les attributs derives de chaque predicteur, prefixes a partir du deuxieme
+	// Renvoie NULL si les domaines ne sont pas fusionnables
+	// Memoire: le domaine rendu appartient a l'appelant
+	static KWClassDomain* BuildFusedEvaluationDomain(const ObjectArray* oaPredictors,
+							 StringVector* svAttributePrefixes);
+
+	// Ajout des attributs de la classe d'un predicteur dans la classe principale d'un domaine fusionne,
+	// en recherchant un prefixe sans collision pour ses attributs derives
+	// Renvoie false si la classe du predicteur n'est pas compatible avec le domaine fusionne
+	static boolean ImportPredictorClass(KWClassDomain* fusedDomain, const KWTrainedPredictor* trainedPredictor,
+					    int nPredictor, ALString& sAttributePrefix);
+
 	// Reimplementation de la methode ancetre, pour ou interdire l'acces
 	// (et eviter la confusion avec GetEvaluationInstanceNumber())
 	int GetInstanceNumber() const;
@@ -150,9 +184,6 @@ public:
 	// Type de predicteur
 	int GetTargetType() const override;
 
-	// Evaluation d'un predicteur (classifieur) sur une base
-	void Evaluate(KWPredictor* predictor, KWDatabase* database) override;
-
 	// Reinitialisation de tous les criteres
 	void InitializeCriteria() override;
 
@@ -265,6 +296,9 @@ protected:
 	// Cree une instance de tache parallele pour la sous-traitance de l'evaluation du predicteur
 	KWPredictorEvaluationTask* CreatePredictorEvaluationTask() override;
 
+	// Preparation de l'evaluation, avec memorisation des modalites cibles du classifieur
+	void PrepareEvaluation(KWPredictor* predictor, KWDatabase* database) override;
+
 	// Reimplementation de la methode ancetre, pour permettre un calcul de l'index
 	// par rapport a la matrice de confusion
 	int GetMainTargetModalityIndex() const override;
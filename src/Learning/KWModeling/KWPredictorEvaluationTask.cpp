@@ -9,7 +9,10 @@
 
 KWPredictorEvaluationTask::KWPredictorEvaluationTask()
 {
-	predictorEvaluation = NULL;
+	kwcEvaluationClass = NULL;
+
+	// Declaration des variables partagees
+	DeclareSharedParameter(&shared_nPredictorNumber);
 }
 
 KWPredictorEvaluationTask::~KWPredictorEvaluationTask() {}
@@ -17,18 +20,55 @@ KWPredictorEvaluationTask::~KWPredictorEvaluationTask() {}
 boolean KWPredictorEvaluationTask::Evaluate(KWPredictor* predictor, KWDatabase* database,
 					    KWPredictorEvaluation* requesterPredictorEvaluation)
 {
-	boolean bOk;
+	ObjectArray oaPredictors;
+	StringVector svAttributePrefixes;
+	ObjectArray oaEvaluations;
 
 	require(predictor != NULL);
-	require(database != NULL);
 	require(requesterPredictorEvaluation != NULL);
-	require(predictor->IsTrained());
-	require(KWType::IsPredictorType(predictor->GetTargetAttributeType()));
+
+	// Evaluation d'un seul predicteur, dont les attributs ne sont pas prefixes
+	oaPredictors.Add(predictor);
+	svAttributePrefixes.Add("");
+	oaEvaluations.Add(requesterPredictorEvaluation);
+	return EvaluatePredictors(&oaPredictors, &svAttributePrefixes, database, &oaEvaluations);
+}
+
+boolean KWPredictorEvaluationTask::EvaluatePredictors(const ObjectArray* oaPredictors,
+						      const StringVector* svAttributePrefixes, KWDatabase* database,
+						      const ObjectArray* oaEvaluations)
+{
+	boolean bOk;
+	KWPredictor* predictor;
+	int nPredictor;
+
+	require(oaPredictors != NULL);
+	require(oaPredictors->GetSize() > 0);
+	require(svAttributePrefixes != NULL);
+	require(svAttributePrefixes->GetSize() == oaPredictors->GetSize());
+	require(oaEvaluations != NULL);
+	require(oaEvaluations->GetSize() == oaPredictors->GetSize());
+	require(database != NULL);
 	require(database->GetObjects()->GetSize() == 0);
+	require(KWClassDomain::GetCurrentDomain()->LookupClass(database->GetClassName()) != NULL);
+	require(KWClassDomain::GetCurrentDomain()->LookupClass(database->GetClassName())->IsCompiled());
+
+	// Memorisation du contexte d'evaluation
+	oaPredictorEvaluations.CopyFrom(oaEvaluations);
+	svPredictorAttributePrefixes.CopyFrom(svAttributePrefixes);
+	kwcEvaluationClass = KWClassDomain::GetCurrentDomain()->LookupClass(database->GetClassName());
 
 	// Intialiazation des variables necessaires pour l'evaluation
-	predictorEvaluation = requesterPredictorEvaluation;
-	InitializePredictorSharedVariables(predictor);
+	shared_nPredictorNumber = oaPredictors->GetSize();
+	for (nPredictor = 0; nPredictor < oaPredictors->GetSize(); nPredictor++)
+	{
+		predictor = cast(KWPredictor*, oaPredictors->GetAt(nPredictor));
+		assert(predictor->IsTrained());
+		assert(KWType::IsPredictorType(predictor->GetTargetAttributeType()));
+		assert(predictor->GetTargetAttributeType() ==
+		       cast(KWPredictor*, oaPredictors->GetAt(0))->GetTargetAttributeType());
+		InitializePredictorSharedVariables(nPredictor, predictor);
+	}
 
 	// On ne souhaite que les messages de fin de tache en cas d'arret
 	SetDisplaySpecificTaskMessage(false);
@@ -36,13 +76,17 @@ boolean KWPredictorEvaluationTask::Evaluate(KWPredictor* predictor, KWDatabase*
 	SetDisplayEndTaskMessage(true);
 
 	// Lancement de la tache
+	predictor = cast(KWPredictor*, oaPredictors->GetAt(0));
 	SetReusableDatabaseIndexer(predictor->GetLearningSpec()->GetDatabaseIndexer());
 	bOk = RunDatabaseTask(database);
 
 	// Verification de l'alimentation et nettoyage des variables partagees
 	assert(Check());
 	CleanPredictorSharedVariables();
-
+	shared_nPredictorNumber = 0;
+	oaPredictorEvaluations.RemoveAll();
+	svPredictorAttributePrefixes.SetSize(0);
+	kwcEvaluationClass = NULL;
 	return bOk;
 }
 
@@ -51,10 +95,21 @@ const ALString KWPredictorEvaluationTask::GetClassLabel() const
 	return "Evaluation";
 }
 
+KWPredictorEvaluation* KWPredictorEvaluationTask::GetPredictorEvaluationAt(int nPredictor) const
+{
+	return cast(KWPredictorEvaluation*, oaPredictorEvaluations.GetAt(nPredictor));
+}
+
 const ALString KWPredictorEvaluationTask::GetObjectLabel() const
 {
-	require(predictorEvaluation != NULL);
-	return predictorEvaluation->GetPredictorName();
+	ALString sTmp;
+
+	require(oaPredictorEvaluations.GetSize() > 0);
+
+	if (oaPredictorEvaluations.GetSize() == 1)
+		return GetPredictorEvaluationAt(0)->GetPredictorName();
+	else
+		return sTmp + IntToString(oaPredictorEvaluations.GetSize()) + " predictors";
 }
 
 const ALString KWPredictorEvaluationTask::GetTaskName() const
@@ -67,7 +122,7 @@ PLParallelTask* KWPredictorEvaluationTask::Create() const
 	return new KWPredictorEvaluationTask;
 }
 
-void KWPredictorEvaluationTask::InitializePredictorSharedVariables(KWPredictor* predictor)
+void KWPredictorEvaluationTask::InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor)
 {
 	// Les sous-classes ont besoin d'une implementation
 }
@@ -77,14 +132,41 @@ void KWPredictorEvaluationTask::CleanPredictorSharedVariables()
 	// Les sous-classes ont besoin d'une implementation
 }
 
+KWLoadIndex KWPredictorEvaluationTask::GetLoadIndex(int nPredictor, const KWAttribute* attribute) const
+{
+	KWLoadIndex liInvalid;
+	ALString sEvaluationAttributeName;
+	KWAttribute* evaluationAttribute;
+
+	require(kwcEvaluationClass != NULL);
+	require(0 <= nPredictor and nPredictor < svPredictorAttributePrefixes.GetSize());
+
+	if (attribute == NULL)
+		return liInvalid;
+	else
+	{
+		// Les attributs derives du predicteur sont prefixes dans la classe d'evaluation
+		sEvaluationAttributeName = attribute->GetName();
+		if (attribute->GetAnyDerivationRule() != NULL)
+			sEvaluationAttributeName =
+			    svPredictorAttributePrefixes.GetAt(nPredictor) + sEvaluationAttributeName;
+		evaluationAttribute = kwcEvaluationClass->LookupAttribute(sEvaluationAttributeName);
+		assert(evaluationAttribute != NULL and evaluationAttribute->GetType() == attribute->GetType());
+		assert(evaluationAttribute->GetLoaded() and evaluationAttribute->GetLoadIndex().IsValid());
+		return evaluationAttribute->GetLoadIndex();
+	}
+}
+
 boolean KWPredictorEvaluationTask::MasterAggregateResults()
 {
 	boolean bOk;
+	int nPredictor;
 
 	// Appel a la methode ancetre
 	bOk = KWDatabaseTask::MasterAggregateResults();
 
-	predictorEvaluation->lInstanceEvaluationNumber += output_lReadObjects;
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		GetPredictorEvaluationAt(nPredictor)->lInstanceEvaluationNumber += output_lReadObjects;
 
 	return bOk;
 }
@@ -97,7 +179,7 @@ boolean KWPredictorEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly
 	bOk = KWDatabaseTask::MasterFinalize(bProcessEndedCorrectly);
 
 	// Warning si la base est vide
-	if (bOk and predictorEvaluation->GetEvaluationInstanceNumber() == 0)
+	if (bOk and GetPredictorEvaluationAt(0)->GetEvaluationInstanceNumber() == 0)
 		AddWarning("Empty evaluation database");
 	return bOk;
 }
@@ -108,43 +190,40 @@ boolean KWPredictorEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly
 KWClassifierEvaluationTask::KWClassifierEvaluationTask()
 {
 	// Initialisation des variables du maitre
-	classifierEvaluation = NULL;
-	masterConfMatrixEvaluation = NULL;
-	masterAucEvaluation = NULL;
-	masterInstanceEvaluationSampler = NULL;
-	dMasterSamplingProb = -1.0;
-	nCurrentSample = -1;
+	nCurrentSlaveScoreHistograms = -1;
+	nMasterMaxScoreBinNumber = 0;
 	bIsAucEvaluated = false;
 
 	// Initialisation des variables de l'esclave
-	slaveInstanceEvaluationSampler = NULL;
-	slaveConfusionMatrixEvaluation = NULL;
+	nSlaveBufferedScoreNumber = 0;
 
 	// Initialisation des variables partagees
 	DeclareTaskInput(&input_bIsAucEvaluated);
 	DeclareSharedParameter(&shared_liTargetAttribute);
-	DeclareSharedParameter(&shared_liPredictionAttribute);
+	DeclareSharedParameter(&shared_livPredictionAttributes);
 	DeclareSharedParameter(&shared_livProbAttributes);
-	DeclareSharedParameter(&shared_nTargetValueNumber);
+	DeclareSharedParameter(&shared_ivTargetValueNumbers);
 	DeclareSharedParameter(&shared_svPredictedModalities);
-	DeclareSharedParameter(&shared_nSlaveInstanceEvaluationCapacity);
-	DeclareTaskOutput(&output_confusionMatrix);
-	DeclareTaskOutput(&output_dCompressionRate);
-	output_oaInstanceEvaluationSample = new PLShared_ObjectArray(new PLShared_ClassifierInstanceEvaluation);
-	DeclareTaskOutput(output_oaInstanceEvaluationSample);
-	DeclareTaskOutput(&output_lSeenInstanceEvaluationNumber);
+	DeclareSharedParameter(&shared_nSlaveMaxScoreBinNumber);
+	DeclareSharedParameter(&shared_nSlaveScoreBufferCapacity);
+	output_oaConfusionMatrices = new PLShared_ObjectArray(new PLShared_DataGridStats);
+	DeclareTaskOutput(output_oaConfusionMatrices);
+	DeclareTaskOutput(&output_dvCompressionRates);
+	output_oaScoreHistograms = new PLShared_ObjectArray(new PLShared_ScoreHistogram);
+	DeclareTaskOutput(output_oaScoreHistograms);
 }
 
 KWClassifierEvaluationTask::~KWClassifierEvaluationTask()
 {
-	assert(masterConfMatrixEvaluation == NULL);
-	assert(slaveConfusionMatrixEvaluation == NULL);
-	assert(masterAucEvaluation == NULL);
-	assert(masterInstanceEvaluationSampler == NULL);
-	assert(oaAllInstanceEvaluationSamples.GetSize() == 0);
+	assert(oaMasterConfMatrixEvaluations.GetSize() == 0);
+	assert(oaSlaveConfMatrixEvaluations.GetSize() == 0);
+	assert(oaMasterScoreHistograms.GetSize() == 0);
+	assert(oaAllSlaveScoreHistograms.GetSize() == 0);
+	assert(oaSlaveScoreHistograms.GetSize() == 0);
 
-	// Nettoyage du tableau de sortie des esclaves (force a etre en reference)
-	delete output_oaInstanceEvaluationSample;
+	// Nettoyage des tableaux de sortie des esclaves (force a etre en reference)
+	delete output_oaConfusionMatrices;
+	delete output_oaScoreHistograms;
 }
 
 const ALString KWClassifierEvaluationTask::GetTaskName() const
@@ -175,9 +254,11 @@ boolean KWClassifierEvaluationTask::ComputeResourceRequirements()
 	lEstimatedTotalObjectNumber =
 	    shared_sourceDatabase.GetPLDatabase()->GetDatabase()->GetSampleEstimatedObjectNumber();
 
-	// Estimation de la memoire totale necessaire pour le calcul de toutes les courbes de lift
+	// Estimation de la memoire totale necessaire pour le calcul exact de toutes les courbes de lift,
+	// dans le pire cas ou tous les scores sont distincts, pour l'ensemble des classifieurs
 	lMaxRequiredEvaluationMemory =
-	    lEstimatedTotalObjectNumber * ComputeInstanceEvaluationNecessaryMemory(shared_nTargetValueNumber) + lMB / 2;
+	    lEstimatedTotalObjectNumber * ComputeInstanceEvaluationNecessaryMemory(GetTotalTargetValueNumber()) +
+	    lMB / 2;
 
 	// Estimation de la memoire totale restante pour en donner au max la moitie au maitre
 	lRemainingMemory = RMResourceManager::GetRemainingAvailableMemory();
@@ -190,8 +271,8 @@ boolean KWClassifierEvaluationTask::ComputeResourceRequirements()
 
 	// Memoire Maitre: on demande un min et un max "raisonnable" permettant d'avoir une bonne
 	// estimation des courbes de lift, du critere d'AUC, et dans le pire cas un temps de calcul
-	// raisonnable. Ce ne serait pas raisonnable de trier des grands vecteurs de score pour gagner une
-	// precision negligeable par rapport a l'erreur statistique du calcul.
+	// raisonnable. Ce ne serait pas raisonnable de garder des histogrammes de tres grande taille pour gagner
+	// une precision negligeable par rapport a l'erreur statistique du calcul.
 	GetResourceRequirements()->GetMasterRequirement()->GetMemory()->UpgradeMin(
 	    min(32 * lMB, lMaxRequiredEvaluationMemory));
 	GetResourceRequirements()->GetMasterRequirement()->GetMemory()->UpgradeMax(lMaxMasterMemoryRequirement);
@@ -204,7 +285,7 @@ boolean KWClassifierEvaluationTask::ComputeResourceRequirements()
 	assert(GetResourceRequirements()->GetSlaveRequirement()->GetMemory()->Check());
 
 	// En priorite, on attribut la memoire au maitre, qui collecte
-	// l'ensemble des scores calcules par les esclaves
+	// les histogrammes des scores calcules par les esclaves
 	GetResourceRequirements()->SetMemoryAllocationPolicy(RMTaskResourceRequirement::masterPreferred);
 
 	return bOk;
@@ -214,92 +295,114 @@ boolean KWClassifierEvaluationTask::MasterInitialize()
 {
 	boolean bDisplay = false;
 	boolean bOk;
+	int nPredictor;
+	KWClassifierEvaluation* classifierEvaluation;
+	KWConfusionMatrixEvaluation* masterConfMatrixEvaluation;
+	int nTargetValueNumber;
 	int nTargetValue;
+	int nTotalTargetValueNumber;
 	longint lMasterGrantedMemory;
 	longint lMasterSelfMemory;
 	longint lSlaveGrantedMemory;
 	longint lSlaveSelfMemory;
+	int nSlaveMaxScoreBinNumber;
 	ALString sTmp;
 
-	require(masterConfMatrixEvaluation == NULL);
-	require(slaveConfusionMatrixEvaluation == NULL);
-	require(masterAucEvaluation == NULL);
-	require(masterInstanceEvaluationSampler == NULL);
+	require(oaMasterConfMatrixEvaluations.GetSize() == 0);
+	require(oaSlaveConfMatrixEvaluations.GetSize() == 0);
+	require(oaMasterScoreHistograms.GetSize() == 0);
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::MasterInitialize();
 
-	// Memorisation de la specialisation du rapport d'evaluation demandeur
-	classifierEvaluation = cast(KWClassifierEvaluation*, predictorEvaluation);
-	assert(classifierEvaluation->oaAllLiftCurveValues.GetSize() == 0);
+	// Index des valeurs cibles de chaque classifieur
+	ComputeTargetValueOffsets();
+	nTotalTargetValueNumber = GetTotalTargetValueNumber();
 
-	// Initialisation du service d'evaluation de la matrice de confusion
-	masterConfMatrixEvaluation = new KWConfusionMatrixEvaluation;
-	masterConfMatrixEvaluation->Initialize();
-	for (nTargetValue = 0; nTargetValue < shared_nTargetValueNumber; nTargetValue++)
-		masterConfMatrixEvaluation->AddPredictedTarget(shared_svPredictedModalities.GetAt(nTargetValue));
-
-	// Initialisation des courbes de lift pour l'ensemble des modalites
-	for (nTargetValue = 0; nTargetValue < shared_nTargetValueNumber; nTargetValue++)
+	// Initialisation par classifieur
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
 	{
-		// Arret et warning si le maximum de courbes est atteint
-		if (nTargetValue == nMaxLiftEvaluationNumber)
+		// Memorisation de la specialisation du rapport d'evaluation demandeur
+		classifierEvaluation = cast(KWClassifierEvaluation*, GetPredictorEvaluationAt(nPredictor));
+		assert(classifierEvaluation->oaAllLiftCurveValues.GetSize() == 0);
+		nTargetValueNumber = shared_ivTargetValueNumbers.GetAt(nPredictor);
+
+		// Initialisation du service d'evaluation de la matrice de confusion
+		masterConfMatrixEvaluation = new KWConfusionMatrixEvaluation;
+		masterConfMatrixEvaluation->Initialize();
+		for (nTargetValue = 0; nTargetValue < nTargetValueNumber; nTargetValue++)
+			masterConfMatrixEvaluation->AddPredictedTarget(
+			    shared_svPredictedModalities.GetAt(ivTargetValueOffsets.GetAt(nPredictor) + nTargetValue));
+		oaMasterConfMatrixEvaluations.Add(masterConfMatrixEvaluation);
+
+		// Initialisation des courbes de lift pour l'ensemble des modalites
+		for (nTargetValue = 0; nTargetValue < nTargetValueNumber; nTargetValue++)
 		{
-			AddWarning(sTmp + "The lift curves will be computed only for " +
-				   IntToString(nMaxLiftEvaluationNumber) + " values (among " +
-				   IntToString(shared_nTargetValueNumber) + ")");
-			break;
+			// Arret et warning si le maximum de courbes est atteint
+			if (nTargetValue == nMaxLiftEvaluationNumber)
+			{
+				classifierEvaluation->AddWarning(
+				    sTmp + "The lift curves will be computed only for " +
+				    IntToString(nMaxLiftEvaluationNumber) + " values (among " +
+				    IntToString(nTargetValueNumber) + ")");
+				break;
+			}
+			classifierEvaluation->oaAllLiftCurveValues.Add(new DoubleVector);
 		}
-		classifierEvaluation->oaAllLiftCurveValues.Add(new DoubleVector);
 	}
 
-	// Initialisation du compteur des echantillons d'evaluation des esclaves pour le calcul d'AUC et courbes de lift
-	nCurrentSample = 0;
+	// Initialisation du compteur des histogrammes de scores des esclaves pour le calcul d'AUC et courbes de lift
+	nCurrentSlaveScoreHistograms = 0;
 
-	// Initialisation du service de calcul de l'AUC
-	bIsAucEvaluated = shared_livProbAttributes.GetSize() > 0 and shared_nTargetValueNumber > 0;
-	masterAucEvaluation = new KWAucEvaluation;
-	masterAucEvaluation->SetTargetValueNumber(shared_nTargetValueNumber);
-
-	// Initialisation de l'echantillonneur du maitre et son proba
-	// Etat du RNG a 2^60 pour etre dans une plage differente des esclaves
-	dMasterSamplingProb = 1.0;
-	masterInstanceEvaluationSampler = new KWReservoirSampler;
-	masterInstanceEvaluationSampler->SetSamplerRandomSeed(1ll << 60);
+	// Initialisation des histogrammes de scores du maitre, pour toutes les valeurs cibles des classifieurs
+	// (les classifieurs sans valeur cible n'ont pas d'histogramme et ne calculent pas l'AUC)
+	bIsAucEvaluated = nTotalTargetValueNumber > 0;
+	if (bIsAucEvaluated)
+	{
+		for (nTargetValue = 0; nTargetValue < nTotalTargetValueNumber; nTargetValue++)
+			oaMasterScoreHistograms.Add(new KWScoreHistogram);
+	}
 
-	// Dimensionnement de la capacite de l'echantillonneur du maitre et du esclave
+	// Dimensionnement du nombre max de bins des histogrammes du maitre
 	lMasterGrantedMemory = GetMasterResourceGrant()->GetMemory();
 	lMasterSelfMemory =
 	    ComputeTaskSelfMemory(lMasterGrantedMemory, GetResourceRequirements()->GetMasterRequirement()->GetMemory(),
 				  &databaseTaskMasterMemoryRequirement);
-	masterInstanceEvaluationSampler->SetCapacity(
-	    ComputeSamplerCapacity(lMasterGrantedMemory, shared_nTargetValueNumber));
+	nMasterMaxScoreBinNumber = ComputeMaxScoreBinNumber(lMasterSelfMemory, nTotalTargetValueNumber);
 
-	// Dimensionnement de la capacite des echantillonneurs des esclaves
-	// En parallele: La capacite de l'echantillonneur est celle de memoire propre de cette sous-classe
-	//               C'est-a-dire en decomptant la memoire utilise par PLDatabaseTask
+	// Dimensionnement des histogrammes et des buffers de scores des esclaves
+	// En parallele: on utilise la memoire propre de cette sous-classe, c'est-a-dire en decomptant la
+	//               memoire utilise par PLDatabaseTask, partagee entre les buffers et les histogrammes
 	if (GetTaskResourceGrant()->GetSlaveNumber() > 1)
 	{
 		lSlaveGrantedMemory = GetTaskResourceGrant()->GetSlaveMemory();
 		lSlaveSelfMemory = ComputeTaskSelfMemory(lSlaveGrantedMemory,
 							 GetResourceRequirements()->GetSlaveRequirement()->GetMemory(),
 							 &databaseTaskSlaveMemoryRequirement);
-		shared_nSlaveInstanceEvaluationCapacity =
-		    ComputeSamplerCapacity(lSlaveGrantedMemory, shared_nTargetValueNumber);
+		nSlaveMaxScoreBinNumber = ComputeMaxScoreBinNumber(lSlaveSelfMemory / 2, nTotalTargetValueNumber);
+		shared_nSlaveMaxScoreBinNumber = min(nMasterMaxScoreBinNumber, nSlaveMaxScoreBinNumber);
+		shared_nSlaveScoreBufferCapacity =
+		    ComputeScoreBufferCapacity(lSlaveSelfMemory / 2, nTotalTargetValueNumber);
 	}
-	// En sequentiel : La capacite est la meme du maitre parce qu'ils partangent le meme espace de memoire
+	// En sequentiel : l'esclave partage l'espace memoire du maitre, et se contente d'histogrammes et de
+	// buffers de la meme taille que les histogrammes du maitre
 	else
-		shared_nSlaveInstanceEvaluationCapacity = masterInstanceEvaluationSampler->GetCapacity();
+	{
+		shared_nSlaveMaxScoreBinNumber = nMasterMaxScoreBinNumber;
+		shared_nSlaveScoreBufferCapacity = nMasterMaxScoreBinNumber;
+	}
 
 	// Trace de deboggage
 	if (bDisplay)
 	{
 		cout << "Master Initialized\n";
-		cout << "master      mem = " << LongintToHumanReadableString(lMasterGrantedMemory) << "\n";
-		cout << "master capacity = " << masterInstanceEvaluationSampler->GetCapacity() << "\n";
-		cout << "slave       mem = " << LongintToHumanReadableString(GetTaskResourceGrant()->GetSlaveMemory())
+		cout << "predictors        = " << GetPredictorNumber() << "\n";
+		cout << "master        mem = " << LongintToHumanReadableString(lMasterSelfMemory) << "\n";
+		cout << "master   max bins = " << nMasterMaxScoreBinNumber << "\n";
+		cout << "slave         mem = " << LongintToHumanReadableString(GetTaskResourceGrant()->GetSlaveMemory())
 		     << "\n";
-		cout << "slave capacity  =  " << shared_nSlaveInstanceEvaluationCapacity << "\n";
+		cout << "slave    max bins = " << shared_nSlaveMaxScoreBinNumber << "\n";
+		cout << "slave buffer size = " << shared_nSlaveScoreBufferCapacity << "\n";
 	}
 
 	ensure(Check());
@@ -313,9 +416,8 @@ boolean KWClassifierEvaluationTask::MasterPrepareTaskInput(double& dTaskPercent,
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::MasterPrepareTaskInput(dTaskPercent, bIsTaskFinished);
 
-	// Ajout d'une reference nulle pour l'echantillon d'evaluation de l'esclave en cours
-	oaAllInstanceEvaluationSamples.Add(NULL);
-	lvSeenInstanceEvaluationNumberPerSample.Add(-1);
+	// Ajout d'une reference nulle pour les histogrammes de scores de l'esclave en cours
+	oaAllSlaveScoreHistograms.Add(NULL);
 	input_bIsAucEvaluated = bIsAucEvaluated;
 	return bOk;
 }
@@ -323,42 +425,54 @@ boolean KWClassifierEvaluationTask::MasterPrepareTaskInput(double& dTaskPercent,
 boolean KWClassifierEvaluationTask::MasterAggregateResults()
 {
 	boolean bOk;
-	ObjectArray* oaInstanceEvaluationSample;
+	int nPredictor;
+	KWConfusionMatrixEvaluation* masterConfMatrixEvaluation;
+	KWClassifierEvaluation* classifierEvaluation;
+	ObjectArray* oaScoreHistograms;
+
+	require(output_oaConfusionMatrices->GetObjectArray()->GetSize() == GetPredictorNumber());
+	require(output_dvCompressionRates.GetSize() == GetPredictorNumber());
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::MasterAggregateResults();
 
-	// Ajout des evaluations du esclave au celui du maitre
-	masterConfMatrixEvaluation->AddEvaluatedMatrix(output_confusionMatrix.GetDataGridStats());
-	classifierEvaluation->dCompressionRate += output_dCompressionRate;
+	// Ajout des evaluations du esclave au celui du maitre, par classifieur
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		masterConfMatrixEvaluation =
+		    cast(KWConfusionMatrixEvaluation*, oaMasterConfMatrixEvaluations.GetAt(nPredictor));
+		masterConfMatrixEvaluation->AddEvaluatedMatrix(
+		    cast(KWDataGridStats*, output_oaConfusionMatrices->GetObjectArray()->GetAt(nPredictor)));
+		classifierEvaluation = cast(KWClassifierEvaluation*, GetPredictorEvaluationAt(nPredictor));
+		classifierEvaluation->dCompressionRate += output_dvCompressionRates.GetAt(nPredictor);
+	}
+	output_oaConfusionMatrices->GetObjectArray()->DeleteAll();
 
 	// Cas de l'evaluation du AUC
 	if (bIsAucEvaluated)
 	{
-		// On transfert les instances d'evaluation de l'esclave en cours au tableau des echantillons
-		// Memoire: Responsabilite transferee au tableau d'achantillons du maitre
-		assert(oaAllInstanceEvaluationSamples.GetAt(GetTaskIndex()) == NULL);
-		assert(lvSeenInstanceEvaluationNumberPerSample.GetAt(GetTaskIndex()) == -1);
-		oaInstanceEvaluationSample = new ObjectArray;
-		oaInstanceEvaluationSample->CopyFrom(output_oaInstanceEvaluationSample->GetObjectArray());
-		oaAllInstanceEvaluationSamples.SetAt(GetTaskIndex(), oaInstanceEvaluationSample);
-		lvSeenInstanceEvaluationNumberPerSample.SetAt(GetTaskIndex(), output_lSeenInstanceEvaluationNumber);
-		output_oaInstanceEvaluationSample->GetObjectArray()->RemoveAll();
-
-		// Echantillonnage d'instances d'evaluation du tableau d'echantillons au sampler du maitre
+		// On transfert les histogrammes de l'esclave en cours au tableau des histogrammes des esclaves
+		// Memoire: Responsabilite transferee au tableau des histogrammes des esclaves du maitre
+		assert(oaAllSlaveScoreHistograms.GetAt(GetTaskIndex()) == NULL);
+		assert(output_oaScoreHistograms->GetObjectArray()->GetSize() == GetTotalTargetValueNumber());
+		oaScoreHistograms = new ObjectArray;
+		oaScoreHistograms->CopyFrom(output_oaScoreHistograms->GetObjectArray());
+		oaAllSlaveScoreHistograms.SetAt(GetTaskIndex(), oaScoreHistograms);
+		output_oaScoreHistograms->GetObjectArray()->RemoveAll();
+
+		// Fusion des histogrammes des esclaves avec ceux du maitre
 		// Ceci se fait en respectant l'ordre ou les esclaves ont ete expedies
-		// Memoire: Responsabilite transferee vers masterInstanceSampler
-		while (nCurrentSample < oaAllInstanceEvaluationSamples.GetSize())
+		while (nCurrentSlaveScoreHistograms < oaAllSlaveScoreHistograms.GetSize())
 		{
-			// Si le prochain echantillon a traiter est NULL => il n'est pas pret => on pause le
-			// echantillonnage
-			if (oaAllInstanceEvaluationSamples.GetAt(nCurrentSample) == NULL)
+			// Si les prochains histogrammes a traiter sont NULL => ils ne sont pas prets => on
+			// suspend la fusion
+			if (oaAllSlaveScoreHistograms.GetAt(nCurrentSlaveScoreHistograms) == NULL)
 				break;
-			// Sinon on met a jour l'echantillon
+			// Sinon on les fusionne
 			else
 			{
-				MasterAggregateResultsUpdateSampler();
-				nCurrentSample++;
+				MasterAggregateResultsMergeScoreHistograms();
+				nCurrentSlaveScoreHistograms++;
 			}
 		}
 	}
@@ -366,103 +480,73 @@ boolean KWClassifierEvaluationTask::MasterAggregateResults()
 	return bOk;
 }
 
-void KWClassifierEvaluationTask::MasterAggregateResultsUpdateSampler()
+void KWClassifierEvaluationTask::MasterAggregateResultsMergeScoreHistograms()
 {
-	ObjectArray* oaCurrentInstanceEvaluationSample;
-	longint lCurrentSampleSeenObjectNumber;
-	int nMasterSampleSize;
-	double dSlaveSamplingProb;
-	double dMasterResamplingProb;
-	int nExpectedMasterResampleSize;
-
-	require(oaAllInstanceEvaluationSamples.GetAt(nCurrentSample) != NULL);
-	require(lvSeenInstanceEvaluationNumberPerSample.GetAt(nCurrentSample) >= 0);
-	require(0 <= dMasterSamplingProb and dMasterSamplingProb <= 1.0);
+	ObjectArray* oaCurrentScoreHistograms;
+	KWScoreHistogram* masterHistogram;
+	int nTargetValue;
 
-	// Acces a l'echantillon courant, le nombre d'objets vus et la taille de l'echantillon du maitre
-	oaCurrentInstanceEvaluationSample = cast(ObjectArray*, oaAllInstanceEvaluationSamples.GetAt(nCurrentSample));
-	lCurrentSampleSeenObjectNumber = lvSeenInstanceEvaluationNumberPerSample.GetAt(nCurrentSample);
-	nMasterSampleSize = masterInstanceEvaluationSampler->GetSampleSize();
+	require(oaAllSlaveScoreHistograms.GetAt(nCurrentSlaveScoreHistograms) != NULL);
+	require(oaMasterScoreHistograms.GetSize() == GetTotalTargetValueNumber());
 
-	// Calcul de la proba d'echantillonage de l'echantillon a traiter
-	if ((longint)oaCurrentInstanceEvaluationSample->GetSize() == lCurrentSampleSeenObjectNumber)
-		dSlaveSamplingProb = 1.0;
-	else
-		dSlaveSamplingProb =
-		    (1.0 * oaCurrentInstanceEvaluationSample->GetSize()) / lCurrentSampleSeenObjectNumber;
+	// Acces aux histogrammes courants
+	oaCurrentScoreHistograms = cast(ObjectArray*, oaAllSlaveScoreHistograms.GetAt(nCurrentSlaveScoreHistograms));
+	assert(oaCurrentScoreHistograms->GetSize() == GetTotalTargetValueNumber());
 
-	// Cas simple de l'echantillon vide:
-	//  - Mise a jour la proba d'echantillonage du maitre si celle du esclave est plus petite
-	//  - Ajout l'echantillon complet
-	if (nMasterSampleSize == 0)
+	// Fusion par valeur cible, en bornant le nombre de bins
+	for (nTargetValue = 0; nTargetValue < oaMasterScoreHistograms.GetSize(); nTargetValue++)
 	{
-		assert(dMasterSamplingProb == 1);
-		if (dSlaveSamplingProb < dMasterSamplingProb)
-			dMasterSamplingProb = dSlaveSamplingProb;
-		masterInstanceEvaluationSampler->AddArray(oaCurrentInstanceEvaluationSample);
+		masterHistogram = cast(KWScoreHistogram*, oaMasterScoreHistograms.GetAt(nTargetValue));
+		masterHistogram->Merge(cast(KWScoreHistogram*, oaCurrentScoreHistograms->GetAt(nTargetValue)));
+		masterHistogram->Reduce(nMasterMaxScoreBinNumber);
 	}
-	// Cas general
-	else
-	{
-		// Si la proba d'echantilonnage du esclave est plus petite que celle du maitre :
-		//  - Mise-a-jour de diminution de la proba du maitre pour l'ajuster a celle de l'esclave
-		// Voir details ci-dessous
-		if (dSlaveSamplingProb < dMasterSamplingProb)
-		{
-			// Calcul de la proba de reechantillonnage et de la taille esperee du reechantillon
-			// Le reechantillonage avec proba dSlaveSamplingProb / dMasterSamplingProb est necessaire pour
-			// diminuer la proba d'echantillonage du maitre de dMasterSamplingProb a dSlaveSamplingProb
-			dMasterResamplingProb = dSlaveSamplingProb / dMasterSamplingProb;
-			nExpectedMasterResampleSize = int(ceil((dMasterResamplingProb * nMasterSampleSize)));
-
-			// Si le reechantillonnage diminue la taille esperee de l'echantillon, reechantillonnage de
-			// reservoir
-			if (nExpectedMasterResampleSize < nMasterSampleSize)
-				masterInstanceEvaluationSampler->Resample(dMasterResamplingProb);
-
-			// Mise a jour de la proba du maitre
-			dMasterSamplingProb = dSlaveSamplingProb;
-
-			// Ajout complet de l'echantillon du esclave, ce qui ne pose pas de probleme puisque
-			// le maitre et l'esclave ont des echantillons a la meme proba
-			masterInstanceEvaluationSampler->AddArray(oaCurrentInstanceEvaluationSample);
-		}
-		// Si la proba d'echantillonage du esclave est plus grande que celle du maitre :
-		//   - Ajout avec une proba de reechantillonage dMasterSamplingProb / dSlaveSamplingProb.
-		// Cette probabilite de reechantillonage permet de preserver proba d'echantillonage du maitre
-		// lors de l'ajout de l'echantillon courant.
-		// NB: Le cas le plus courant rentre ici (ie. dMasterSamplingProb == dSlaveSamplingProb == 1.0)
-		else
-		{
-			dMasterResamplingProb = dMasterSamplingProb / dSlaveSamplingProb;
-			masterInstanceEvaluationSampler->AddArrayWithProb(oaCurrentInstanceEvaluationSample,
-									  dMasterResamplingProb);
-		}
-	}
-	// Nettoyage
-	oaCurrentInstanceEvaluationSample->RemoveAll();
 
-	ensure(0 <= dMasterSamplingProb and dMasterSamplingProb <= 1.0);
-	ensure(oaCurrentInstanceEvaluationSample->GetSize() == 0);
+	// Nettoyage des histogrammes de l'esclave, en gardant un tableau vide non NULL pour marquer leur traitement
+	oaCurrentScoreHistograms->DeleteAll();
+	ensure(oaCurrentScoreHistograms->GetSize() == 0);
 }
 
 boolean KWClassifierEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly)
 {
 	const int nPartileNumber = 1000;
 	boolean bOk;
+	int nPredictor;
+	KWClassifierEvaluation* classifierEvaluation;
+	KWConfusionMatrixEvaluation* masterConfMatrixEvaluation;
+	KWAucEvaluation masterAucEvaluation;
+	ObjectArray oaPredictorScoreHistograms;
+	int nTargetValueNumber;
 	int nLiftCurve;
 	int nPredictorTarget;
 	DoubleVector* dvLiftCurveValues;
-	int nSample;
-	longint lSeenInstanceEvaluationNumber;
+	int nTargetValue;
+	KWScoreHistogram* scoreHistogram;
+	int nMaxBinNumber;
 	ALString sTmp;
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::MasterFinalize(bProcessEndedCorrectly);
 
-	// Calcul des criteres si ok
-	if (bOk)
+	// Calcul des criteres si ok, par classifieur
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
 	{
+		if (not bOk)
+			break;
+
+		classifierEvaluation = cast(KWClassifierEvaluation*, GetPredictorEvaluationAt(nPredictor));
+		masterConfMatrixEvaluation =
+		    cast(KWConfusionMatrixEvaluation*, oaMasterConfMatrixEvaluations.GetAt(nPredictor));
+		nTargetValueNumber = shared_ivTargetValueNumbers.GetAt(nPredictor);
+
+		// Histogrammes de scores du classifieur
+		oaPredictorScoreHistograms.SetSize(0);
+		if (bIsAucEvaluated)
+		{
+			for (nTargetValue = 0; nTargetValue < nTargetValueNumber; nTargetValue++)
+				oaPredictorScoreHistograms.Add(oaMasterScoreHistograms.GetAt(
+				    ivTargetValueOffsets.GetAt(nPredictor) + nTargetValue));
+		}
+
 		// Memorisation de la matrice de confusion
 		assert(masterConfMatrixEvaluation->Check());
 		masterConfMatrixEvaluation->ExportDataGridStats(&classifierEvaluation->dgsConfusionMatrix);
@@ -476,7 +560,7 @@ boolean KWClassifierEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectl
 		classifierEvaluation->dTargetEntropy = masterConfMatrixEvaluation->ComputeTargetEntropy();
 
 		// Calcul et memorisation du taux de compression
-		if (shared_livProbAttributes.GetSize() > 0 and classifierEvaluation->lInstanceEvaluationNumber > 0)
+		if (nTargetValueNumber > 0 and classifierEvaluation->lInstanceEvaluationNumber > 0)
 		{
 			// Normalisation par rapport a l'entropie cible
 			if (classifierEvaluation->dTargetEntropy > 0)
@@ -498,12 +582,13 @@ boolean KWClassifierEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectl
 		}
 
 		// Calcul de l'AUC s'il y y a des instances en evaluation
-		if (bIsAucEvaluated and masterInstanceEvaluationSampler->GetSampledObjects()->GetSize() > 0)
+		if (oaPredictorScoreHistograms.GetSize() > 0 and
+		    cast(KWScoreHistogram*, oaPredictorScoreHistograms.GetAt(0))->GetTotalFrequency() > 0)
 		{
-			masterAucEvaluation->SetInstanceEvaluations(
-			    masterInstanceEvaluationSampler->GetSampledObjects());
-			if (shared_livProbAttributes.GetSize() > 0 and masterAucEvaluation->GetTargetValueNumber() > 0)
-				classifierEvaluation->dAUC = masterAucEvaluation->ComputeGlobalAUCValue();
+			masterAucEvaluation.Initialize();
+			masterAucEvaluation.SetTargetValueNumber(nTargetValueNumber);
+			masterAucEvaluation.SetScoreHistograms(&oaPredictorScoreHistograms);
+			classifierEvaluation->dAUC = masterAucEvaluation.ComputeGlobalAUCValue();
 
 			// Calcul des courbes de lift
 			for (nLiftCurve = 0; nLiftCurve < classifierEvaluation->oaAllLiftCurveValues.GetSize();
@@ -514,43 +599,44 @@ boolean KWClassifierEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectl
 
 				// L'index de lift de la modalite est celui de la modalite directement, sauf si la
 				// derniere courbe memorise la courbe pour la modalite cible principale
-				nPredictorTarget = GetPredictorTargetIndexAtLiftCurveIndex(nLiftCurve);
+				nPredictorTarget =
+				    GetPredictorTargetIndexAtLiftCurveIndex(classifierEvaluation, nLiftCurve);
 
 				// Si l'on a avant la modalite cible est au debut
-				masterAucEvaluation->ComputeLiftCurveAt(nPredictorTarget, nPartileNumber,
-									dvLiftCurveValues);
+				masterAucEvaluation.ComputeLiftCurveAt(nPredictorTarget, nPartileNumber,
+								       dvLiftCurveValues);
 			}
 		}
-	}
-
-	// Warning si du sampling a ete utilise
-	if (bOk)
-	{
-		lSeenInstanceEvaluationNumber = 0;
-		for (nSample = 0; nSample < lvSeenInstanceEvaluationNumberPerSample.GetSize(); nSample++)
-			lSeenInstanceEvaluationNumber += lvSeenInstanceEvaluationNumberPerSample.GetAt(nSample);
 
-		if ((longint)masterInstanceEvaluationSampler->GetSampleSize() < lSeenInstanceEvaluationNumber)
+		// Warning si des histogrammes ont du etre reduits
+		nMaxBinNumber = 0;
+		for (nTargetValue = 0; nTargetValue < oaPredictorScoreHistograms.GetSize(); nTargetValue++)
 		{
-			AddWarning(
-			    sTmp +
-			    "Not enough memory to compute the exact AUC: estimation made on a sub-sample of size " +
-			    IntToString(masterInstanceEvaluationSampler->GetSampleSize()) + " taken from " +
-			    LongintToString(lSeenInstanceEvaluationNumber));
+			scoreHistogram = cast(KWScoreHistogram*, oaPredictorScoreHistograms.GetAt(nTargetValue));
+			if (not scoreHistogram->IsExact())
+				nMaxBinNumber = max(nMaxBinNumber, scoreHistogram->GetBinNumber());
+		}
+		if (nMaxBinNumber > 0)
+		{
+			classifierEvaluation->AddWarning(
+			    sTmp + "Not enough memory to compute the exact AUC: estimation made using score histograms "
+				   "reduced to " +
+			    IntToString(nMaxBinNumber) + " bins, for " +
+			    LongintToString(classifierEvaluation->lInstanceEvaluationNumber) + " instances");
 		}
 	}
 
 	// Nettoyage
-	classifierEvaluation = NULL;
-	delete masterConfMatrixEvaluation;
-	masterConfMatrixEvaluation = NULL;
-	delete masterAucEvaluation;
-	masterAucEvaluation = NULL;
-	delete masterInstanceEvaluationSampler;
-	masterInstanceEvaluationSampler = NULL;
-	dMasterSamplingProb = -1.0;
-	nCurrentSample = -1;
-	oaAllInstanceEvaluationSamples.DeleteAll();
+	oaMasterConfMatrixEvaluations.DeleteAll();
+	oaMasterScoreHistograms.DeleteAll();
+	nMasterMaxScoreBinNumber = 0;
+	nCurrentSlaveScoreHistograms = -1;
+	for (nTargetValue = 0; nTargetValue < oaAllSlaveScoreHistograms.GetSize(); nTargetValue++)
+	{
+		if (oaAllSlaveScoreHistograms.GetAt(nTargetValue) != NULL)
+			cast(ObjectArray*, oaAllSlaveScoreHistograms.GetAt(nTargetValue))->DeleteAll();
+	}
+	oaAllSlaveScoreHistograms.DeleteAll();
 
 	return bOk;
 }
@@ -558,53 +644,73 @@ boolean KWClassifierEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectl
 boolean KWClassifierEvaluationTask::SlaveInitialize()
 {
 	boolean bOk;
+	int nPredictor;
+	int nTargetValue;
 
-	require(slaveConfusionMatrixEvaluation == NULL);
-	require(slaveInstanceEvaluationSampler == NULL);
+	require(oaSlaveConfMatrixEvaluations.GetSize() == 0);
+	require(oaSlaveScoreHistograms.GetSize() == 0);
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::SlaveInitialize();
 
-	// Initialisation des objets de travail de l'esclave
-	slaveInstanceEvaluationSampler = new KWReservoirSampler;
-	slaveConfusionMatrixEvaluation = new KWConfusionMatrixEvaluation;
+	// Index des valeurs cibles de chaque classifieur
+	ComputeTargetValueOffsets();
 
-	// Dimensionnement de la capacite du vecteur de score de l'esclave
-	slaveInstanceEvaluationSampler->SetCapacity(shared_nSlaveInstanceEvaluationCapacity);
+	// Initialisation des objets de travail de l'esclave
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		oaSlaveConfMatrixEvaluations.Add(new KWConfusionMatrixEvaluation);
+	dvSlaveCompressionRates.SetSize(GetPredictorNumber());
 
+	// Initialisation des buffers de scores
+	for (nTargetValue = 0; nTargetValue < GetTotalTargetValueNumber(); nTargetValue++)
+	{
+		oaSlavePositiveScores.Add(new ContinuousVector);
+		oaSlaveNegativeScores.Add(new ContinuousVector);
+	}
+	nSlaveBufferedScoreNumber = 0;
 	return bOk;
 }
 
 boolean KWClassifierEvaluationTask::SlaveProcessExploitDatabase()
 {
 	boolean bOk;
-	int nInstanceEvaluation;
-	KWClassifierInstanceEvaluation* instanceEvaluation;
+	int nPredictor;
+	KWDataGridStats* dgsConfusionMatrix;
+	int nTargetValue;
 
-	require(slaveInstanceEvaluationSampler != NULL);
-	require(slaveInstanceEvaluationSampler->GetSampleSize() == 0);
+	require(oaSlaveScoreHistograms.GetSize() == 0);
+	require(nSlaveBufferedScoreNumber == 0);
 
 	// Initialisation des resultats de l'esclave
-	output_dCompressionRate = 0;
-	slaveConfusionMatrixEvaluation->Initialize();
+	dvSlaveCompressionRates.Initialize();
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		cast(KWConfusionMatrixEvaluation*, oaSlaveConfMatrixEvaluations.GetAt(nPredictor))->Initialize();
+	if (input_bIsAucEvaluated)
+	{
+		for (nTargetValue = 0; nTargetValue < GetTotalTargetValueNumber(); nTargetValue++)
+			oaSlaveScoreHistograms.Add(new KWScoreHistogram);
+	}
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::SlaveProcessExploitDatabase();
 
 	// Remplisement des sorties de l'esclave
-	slaveConfusionMatrixEvaluation->ExportDataGridStats(output_confusionMatrix.GetDataGridStats());
-	for (nInstanceEvaluation = 0; nInstanceEvaluation < slaveInstanceEvaluationSampler->GetSampleSize();
-	     nInstanceEvaluation++)
+	// Memoire: les histogrammes de l'esclave sont transferes au tableau de sortie
+	output_oaConfusionMatrices->GetObjectArray()->DeleteAll();
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
 	{
-		instanceEvaluation = cast(KWClassifierInstanceEvaluation*,
-					  slaveInstanceEvaluationSampler->GetSampledObjectAt(nInstanceEvaluation));
-		output_oaInstanceEvaluationSample->GetObjectArray()->Add(instanceEvaluation);
+		dgsConfusionMatrix = new KWDataGridStats;
+		cast(KWConfusionMatrixEvaluation*, oaSlaveConfMatrixEvaluations.GetAt(nPredictor))
+		    ->ExportDataGridStats(dgsConfusionMatrix);
+		output_oaConfusionMatrices->GetObjectArray()->Add(dgsConfusionMatrix);
+	}
+	output_dvCompressionRates.GetDoubleVector()->CopyFrom(&dvSlaveCompressionRates);
+	if (input_bIsAucEvaluated)
+	{
+		SlaveFlushScoreBuffers();
+		output_oaScoreHistograms->GetObjectArray()->CopyFrom(&oaSlaveScoreHistograms);
+		oaSlaveScoreHistograms.RemoveAll();
 	}
-	output_lSeenInstanceEvaluationNumber = slaveInstanceEvaluationSampler->GetSeenObjectNumber();
-
-	// Remise a zero de l'echantillonneur
-	slaveInstanceEvaluationSampler->RemoveAll();
-
 	return bOk;
 }
 
@@ -612,87 +718,102 @@ boolean KWClassifierEvaluationTask::SlaveProcessExploitDatabaseObject(const KWOb
 {
 	const Continuous cEpsilon = (Continuous)1e-6;
 	boolean bOk;
+	int nPredictor;
+	int nTargetValueNumber;
+	int nTargetValueOffset;
 	int nActualValue;
 	int nTargetValue;
 	Symbol sActualTargetValue;
 	Symbol sPredictedTargetValue;
 	Continuous cActualTargetValueProb;
-	KWClassifierInstanceEvaluation* instanceEvaluation;
+	Continuous cScore;
 
 	require(kwoObject != NULL);
 	require(shared_liTargetAttribute.GetValue().IsValid());
-	require(shared_liPredictionAttribute.GetValue().IsValid());
 
 	// Appel de la methode ancetre
 	bOk = KWPredictorEvaluationTask::SlaveProcessExploitDatabaseObject(kwoObject);
 
-	// Acces aux modalites predites et effectives
+	// Acces a la modalite effective
 	sActualTargetValue = kwoObject->GetSymbolValueAt(shared_liTargetAttribute.GetValue());
-	sPredictedTargetValue = kwoObject->GetSymbolValueAt(shared_liPredictionAttribute.GetValue());
-
-	// Mise a jour de la matrice de confusion
-	slaveConfusionMatrixEvaluation->AddInstanceEvaluation(sPredictedTargetValue, sActualTargetValue);
 
-	// Recherche de l'index en apprentissage de la modalite effective
-	// Par defaut: le nombre de modalites cible en apprentissage
-	// (signifie valeur cible inconnue en apprentissage)
-	nActualValue = shared_nTargetValueNumber;
-	if (shared_livProbAttributes.GetSize() > 0)
+	// Evaluation de l'instance pour chaque classifieur
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
 	{
-		for (nTargetValue = 0; nTargetValue < shared_nTargetValueNumber; nTargetValue++)
+		assert(shared_livPredictionAttributes.GetAt(nPredictor).IsValid());
+		nTargetValueNumber = shared_ivTargetValueNumbers.GetAt(nPredictor);
+		nTargetValueOffset = ivTargetValueOffsets.GetAt(nPredictor);
+
+		// Acces a la modalite predite
+		sPredictedTargetValue = kwoObject->GetSymbolValueAt(shared_livPredictionAttributes.GetAt(nPredictor));
+
+		// Mise a jour de la matrice de confusion
+		cast(KWConfusionMatrixEvaluation*, oaSlaveConfMatrixEvaluations.GetAt(nPredictor))
+		    ->AddInstanceEvaluation(sPredictedTargetValue, sActualTargetValue);
+
+		// Recherche de l'index en apprentissage de la modalite effective
+		// Par defaut: le nombre de modalites cible en apprentissage
+		// (signifie valeur cible inconnue en apprentissage)
+		nActualValue = nTargetValueNumber;
+		for (nTargetValue = 0; nTargetValue < nTargetValueNumber; nTargetValue++)
 		{
-			if (shared_svPredictedModalities.GetAt(nTargetValue) == sActualTargetValue)
+			if (shared_svPredictedModalities.GetAt(nTargetValueOffset + nTargetValue) == sActualTargetValue)
 			{
 				nActualValue = nTargetValue;
 				break;
 			}
 		}
-	}
 
-	// Mise a jour du taux de compression si pertinente
-	if (shared_livProbAttributes.GetSize() > 0)
-	{
-		// Recherche de la probabilite predite pour la valeur cible reelle
-		cActualTargetValueProb = 0;
-		if (nActualValue < shared_livProbAttributes.GetSize())
+		// Mise a jour du taux de compression si pertinente
+		if (nTargetValueNumber > 0)
 		{
-			assert(kwoObject->GetSymbolValueAt(shared_liTargetAttribute.GetValue()) ==
-			       shared_svPredictedModalities.GetAt(nActualValue));
-			cActualTargetValueProb =
-			    kwoObject->GetContinuousValueAt(shared_livProbAttributes.GetAt(nActualValue));
-
-			// On projete sur [0, 1] pour avoir une probabilite quoi qu'il arrive
-			if (cActualTargetValueProb < cEpsilon)
+			// Recherche de la probabilite predite pour la valeur cible reelle
+			cActualTargetValueProb = 0;
+			if (nActualValue < nTargetValueNumber)
+			{
+				cActualTargetValueProb = kwoObject->GetContinuousValueAt(
+				    shared_livProbAttributes.GetAt(nTargetValueOffset + nActualValue));
+
+				// On projete sur [0, 1] pour avoir une probabilite quoi qu'il arrive
+				if (cActualTargetValueProb < cEpsilon)
+					cActualTargetValueProb = cEpsilon;
+				if (cActualTargetValueProb > 1)
+					cActualTargetValueProb = 1;
+			}
+			// Si la valeur etait inconnue en apprentissage, on lui associe une probabilite minimale
+			else
 				cActualTargetValueProb = cEpsilon;
-			if (cActualTargetValueProb > 1)
-				cActualTargetValueProb = 1;
+
+			// Ajout du log negatif de cette probabilite a l'evaluation des scores
+			dvSlaveCompressionRates.UpgradeAt(nPredictor, -log(cActualTargetValueProb));
 		}
-		// Si la valeur etait inconnue en apprentissage, on lui associe une probabilite minimale
-		else
-			cActualTargetValueProb = cEpsilon;
 
-		// Ajout du log negatif de cette probabilite a l'evaluation des scores
-		output_dCompressionRate -= log(cActualTargetValueProb);
+		// Collecte des informations necessaires a l'estimation de l'AUC et aux courbes de lift
+		if (input_bIsAucEvaluated)
+		{
+			// Ajout du score de chaque valeur cible dans le buffer des instances positives ou negatives
+			for (nTargetValue = 0; nTargetValue < nTargetValueNumber; nTargetValue++)
+			{
+				cScore = kwoObject->GetContinuousValueAt(
+				    shared_livProbAttributes.GetAt(nTargetValueOffset + nTargetValue));
+				if (nTargetValue == nActualValue)
+					cast(ContinuousVector*,
+					     oaSlavePositiveScores.GetAt(nTargetValueOffset + nTargetValue))
+					    ->Add(cScore);
+				else
+					cast(ContinuousVector*,
+					     oaSlaveNegativeScores.GetAt(nTargetValueOffset + nTargetValue))
+					    ->Add(cScore);
+			}
+		}
 	}
 
-	// Collecte des informations necessaires a l'estimation de l'AUC et aux courbes de lift
+	// Compactage des buffers s'ils sont pleins
 	if (input_bIsAucEvaluated)
 	{
-		// Initialisation du RNG de l'echantillonneur avec l'index de creation du premier objet de la sous-tache
-		if (slaveInstanceEvaluationSampler->GetSampleSize() == 0)
-			slaveInstanceEvaluationSampler->SetSamplerRandomSeed(kwoObject->GetCreationIndex());
-
-		// Ajout de l'evaluation de l'instance
-		instanceEvaluation = new KWClassifierInstanceEvaluation;
-		instanceEvaluation->SetTargetValueNumber(shared_nTargetValueNumber);
-		instanceEvaluation->SetActualTargetIndex(nActualValue);
-		for (nTargetValue = 0; nTargetValue < shared_nTargetValueNumber; nTargetValue++)
-		{
-			instanceEvaluation->SetTargetProbAt(
-			    nTargetValue,
-			    kwoObject->GetContinuousValueAt(shared_livProbAttributes.GetAt(nTargetValue)));
-		}
-		slaveInstanceEvaluationSampler->Add(instanceEvaluation);
+		nSlaveBufferedScoreNumber++;
+		if (nSlaveBufferedScoreNumber >= shared_nSlaveScoreBufferCapacity)
+			SlaveFlushScoreBuffers();
 	}
 
 	return bOk;
@@ -702,109 +823,179 @@ boolean KWClassifierEvaluationTask::SlaveFinalize(boolean bProcessEndedCorrectly
 {
 	boolean bOk;
 
-	require(slaveInstanceEvaluationSampler != NULL);
-	require(slaveConfusionMatrixEvaluation != NULL);
-
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::SlaveFinalize(bProcessEndedCorrectly);
 
 	// Nettoyage
-	delete slaveInstanceEvaluationSampler;
-	slaveInstanceEvaluationSampler = NULL;
-	delete slaveConfusionMatrixEvaluation;
-	slaveConfusionMatrixEvaluation = NULL;
+	oaSlaveConfMatrixEvaluations.DeleteAll();
+	dvSlaveCompressionRates.SetSize(0);
+	oaSlaveScoreHistograms.DeleteAll();
+	oaSlavePositiveScores.DeleteAll();
+	oaSlaveNegativeScores.DeleteAll();
+	nSlaveBufferedScoreNumber = 0;
 	return bOk;
 }
 
-void KWClassifierEvaluationTask::InitializePredictorSharedVariables(KWPredictor* predictor)
+void KWClassifierEvaluationTask::SlaveFlushScoreBuffers()
+{
+	KWScoreHistogram bufferHistogram;
+	KWScoreHistogram* scoreHistogram;
+	ContinuousVector* cvPositiveScores;
+	ContinuousVector* cvNegativeScores;
+	int nTargetValue;
+
+	require(oaSlaveScoreHistograms.GetSize() == GetTotalTargetValueNumber());
+
+	// Compactage des buffers de chaque valeur cible dans un histogramme, fusionne avec celui de la sous-tache
+	if (nSlaveBufferedScoreNumber > 0)
+	{
+		for (nTargetValue = 0; nTargetValue < oaSlaveScoreHistograms.GetSize(); nTargetValue++)
+		{
+			cvPositiveScores = cast(ContinuousVector*, oaSlavePositiveScores.GetAt(nTargetValue));
+			cvNegativeScores = cast(ContinuousVector*, oaSlaveNegativeScores.GetAt(nTargetValue));
+			scoreHistogram = cast(KWScoreHistogram*, oaSlaveScoreHistograms.GetAt(nTargetValue));
+			bufferHistogram.BuildFromScores(cvPositiveScores, cvNegativeScores);
+			scoreHistogram->Merge(&bufferHistogram);
+			scoreHistogram->Reduce(shared_nSlaveMaxScoreBinNumber);
+			cvPositiveScores->SetSize(0);
+			cvNegativeScores->SetSize(0);
+		}
+		nSlaveBufferedScoreNumber = 0;
+	}
+}
+
+void KWClassifierEvaluationTask::InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor)
 {
 	int nTargetIndex;
+	int nTargetValueNumber;
 	KWTrainedClassifier* classifier;
 	KWLoadIndex liTarget;
-	KWLoadIndex liPrediction;
-	KWLoadIndex liProbAttribute;
 	ALString sTmp;
 
+	require(shared_livPredictionAttributes.GetSize() == nPredictor);
+
 	// Informations du predicteur necessaires pour l'evaluation: Globalement des LoadIndex
 	classifier = predictor->GetTrainedClassifier();
-	liTarget = GetLoadIndex(classifier->GetTargetAttribute());
-	liPrediction = GetLoadIndex(classifier->GetPredictionAttribute());
+	liTarget = GetLoadIndex(nPredictor, classifier->GetTargetAttribute());
+	assert(nPredictor == 0 or liTarget == shared_liTargetAttribute.GetValue());
 	shared_liTargetAttribute.SetValue(liTarget);
-	shared_liPredictionAttribute.SetValue(liPrediction);
-	shared_nTargetValueNumber = classifier->GetTargetValueNumber();
-	shared_livProbAttributes.GetLoadIndexVector()->SetSize(shared_nTargetValueNumber);
-	for (nTargetIndex = 0; nTargetIndex < shared_livProbAttributes.GetSize(); nTargetIndex++)
+	shared_livPredictionAttributes.GetLoadIndexVector()->Add(
+	    GetLoadIndex(nPredictor, classifier->GetPredictionAttribute()));
+	nTargetValueNumber = classifier->GetTargetValueNumber();
+	shared_ivTargetValueNumbers.Add(nTargetValueNumber);
+	for (nTargetIndex = 0; nTargetIndex < nTargetValueNumber; nTargetIndex++)
 	{
-		liProbAttribute = GetLoadIndex(classifier->GetProbAttributeAt(nTargetIndex));
-		shared_livProbAttributes.SetAt(nTargetIndex, liProbAttribute);
+		shared_livProbAttributes.GetLoadIndexVector()->Add(
+		    GetLoadIndex(nPredictor, classifier->GetProbAttributeAt(nTargetIndex)));
 		shared_svPredictedModalities.Add(classifier->GetTargetValueAt(nTargetIndex));
 	}
 
-	// La capacite de l'echantillonneur du esclave est initialisee dans MasterInitialize apres dimensionnement
-	shared_nSlaveInstanceEvaluationCapacity = 0;
+	// Le dimensionnement des histogrammes et buffers de scores de l'esclave est initialise dans MasterInitialize
+	shared_nSlaveMaxScoreBinNumber = 0;
+	shared_nSlaveScoreBufferCapacity = 0;
 
 	// Warning s'il n'y a pas de modalites cibles specifiees
-	if (shared_nTargetValueNumber == 0)
-		AddWarning(sTmp + "The AUC value will not be evaluated as the target value probabilities are not "
-				  "available from the predictor");
+	if (nTargetValueNumber == 0)
+		GetPredictorEvaluationAt(nPredictor)->AddWarning(
+		    sTmp + "The AUC value will not be evaluated as the target value probabilities are not "
+			   "available from the predictor");
 }
 
 void KWClassifierEvaluationTask::CleanPredictorSharedVariables()
 {
 	// Reinitialisation des index des attributs necessaires a l'evaluation
 	shared_liTargetAttribute.GetValue().Reset();
-	shared_liPredictionAttribute.GetValue().Reset();
-	shared_livProbAttributes.GetLoadIndexVector()->SetSize(0);
+	shared_livPredictionAttributes.SetSize(0);
+	shared_livProbAttributes.SetSize(0);
+	shared_ivTargetValueNumbers.GetIntVector()->SetSize(0);
 	shared_svPredictedModalities.GetSymbolVector()->SetSize(0);
+	ivTargetValueOffsets.SetSize(0);
 }
 
-int KWClassifierEvaluationTask::GetMainTargetModalityLiftIndex() const
+void KWClassifierEvaluationTask::ComputeTargetValueOffsets()
 {
-	require(classifierEvaluation != NULL);
+	int nPredictor;
+
+	require(shared_ivTargetValueNumbers.GetSize() == GetPredictorNumber());
+
+	ivTargetValueOffsets.SetSize(GetPredictorNumber() + 1);
+	ivTargetValueOffsets.SetAt(0, 0);
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		ivTargetValueOffsets.SetAt(nPredictor + 1, ivTargetValueOffsets.GetAt(nPredictor) +
+							       shared_ivTargetValueNumbers.GetAt(nPredictor));
+	ensure(ivTargetValueOffsets.GetAt(GetPredictorNumber()) == GetTotalTargetValueNumber());
+	ensure(shared_livProbAttributes.GetSize() == GetTotalTargetValueNumber());
+}
 
-	if (classifierEvaluation->GetMainTargetModalityIndex() == -1)
+int KWClassifierEvaluationTask::GetMainTargetModalityLiftIndex(const KWClassifierEvaluation* evaluation) const
+{
+	require(evaluation != NULL);
+
+	if (evaluation->GetMainTargetModalityIndex() == -1)
 		return -1;
 	else
 	{
 		// Si la modalite cible principale a un index dans les premiere courbe de lift
-		if (classifierEvaluation->GetMainTargetModalityIndex() <
-		    classifierEvaluation->oaAllLiftCurveValues.GetSize())
-			return classifierEvaluation->GetMainTargetModalityIndex();
+		if (evaluation->GetMainTargetModalityIndex() < evaluation->oaAllLiftCurveValues.GetSize())
+			return evaluation->GetMainTargetModalityIndex();
 		// Sinon, c'est la derniere courbe de lift memorisee
 		else
-			return classifierEvaluation->oaAllLiftCurveValues.GetSize() - 1;
+			return evaluation->oaAllLiftCurveValues.GetSize() - 1;
 	}
 }
 
-int KWClassifierEvaluationTask::GetComputedLiftCurveNumber() const
+int KWClassifierEvaluationTask::GetComputedLiftCurveNumber(const KWClassifierEvaluation* evaluation) const
 {
-	require(classifierEvaluation != NULL);
-	return classifierEvaluation->oaAllLiftCurveValues.GetSize();
+	require(evaluation != NULL);
+	return evaluation->oaAllLiftCurveValues.GetSize();
 }
 
-int KWClassifierEvaluationTask::GetPredictorTargetIndexAtLiftCurveIndex(int nLiftCurve) const
+int KWClassifierEvaluationTask::GetPredictorTargetIndexAtLiftCurveIndex(const KWClassifierEvaluation* evaluation,
+									int nLiftCurve) const
 {
-	require(classifierEvaluation != NULL);
-	require(0 <= nLiftCurve and nLiftCurve < GetComputedLiftCurveNumber());
+	require(evaluation != NULL);
+	require(0 <= nLiftCurve and nLiftCurve < GetComputedLiftCurveNumber(evaluation));
 
-	if (nLiftCurve == classifierEvaluation->oaAllLiftCurveValues.GetSize() - 1 and
-	    GetMainTargetModalityLiftIndex() == classifierEvaluation->oaAllLiftCurveValues.GetSize() - 1)
-		return classifierEvaluation->GetMainTargetModalityIndex();
+	if (nLiftCurve == evaluation->oaAllLiftCurveValues.GetSize() - 1 and
+	    GetMainTargetModalityLiftIndex(evaluation) == evaluation->oaAllLiftCurveValues.GetSize() - 1)
+		return evaluation->GetMainTargetModalityIndex();
 	else
 		return nLiftCurve;
 }
 
-int KWClassifierEvaluationTask::ComputeSamplerCapacity(longint lMemory, int nTargetValueNumber) const
+int KWClassifierEvaluationTask::ComputeMaxScoreBinNumber(longint lMemory, int nTargetValueNumber) const
+{
+	int nMaxBinNumber;
+	longint lBinSize;
+
+	require(lMemory >= 0);
+	require(nTargetValueNumber >= 0);
+
+	// Taille des bins de l'ensemble des histogrammes
+	lBinSize = max(1, nTargetValueNumber) * KWScoreHistogram::GetBinUsedMemory();
+
+	// On garde au moins deux bins, pour distinguer les scores extremes
+	if (lMemory / lBinSize < INT_MAX)
+		nMaxBinNumber = (int)max((longint)2, lMemory / lBinSize);
+	else
+		nMaxBinNumber = INT_MAX;
+	return nMaxBinNumber;
+}
+
+int KWClassifierEvaluationTask::ComputeScoreBufferCapacity(longint lMemory, int nTargetValueNumber) const
 {
 	int nCapacity;
-	longint lInstanceEvaluationSize;
+	longint lInstanceScoresSize;
+
+	require(lMemory >= 0);
+	require(nTargetValueNumber >= 0);
 
-	lInstanceEvaluationSize = ComputeInstanceEvaluationNecessaryMemory(nTargetValueNumber);
-	if (lMemory / lInstanceEvaluationSize < INT_MAX)
-		nCapacity = (int)(lMemory / lInstanceEvaluationSize);
+	// Taille des scores d'une instance dans les buffers
+	lInstanceScoresSize = max(1, nTargetValueNumber) * (longint)sizeof(Continuous);
+	if (lMemory / lInstanceScoresSize < INT_MAX)
+		nCapacity = (int)max((longint)1, lMemory / lInstanceScoresSize);
 	else
 		nCapacity = INT_MAX;
-
 	return nCapacity;
 }
 
@@ -856,8 +1047,7 @@ longint KWClassifierEvaluationTask::ComputeTaskSelfMemory(longint lTaskGrantedMe
 
 longint KWClassifierEvaluationTask::ComputeInstanceEvaluationNecessaryMemory(int nTargetValueNumber) const
 {
-	return (longint)sizeof(KWClassifierInstanceEvaluation) + sizeof(KWClassifierInstanceEvaluation*) +
-	       (longint)nTargetValueNumber * sizeof(Continuous);
+	return (longint)nTargetValueNumber * KWScoreHistogram::GetBinUsedMemory();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -865,34 +1055,40 @@ longint KWClassifierEvaluationTask::ComputeInstanceEvaluationNecessaryMemory(int
 
 KWRegressorEvaluationTask::KWRegressorEvaluationTask()
 {
-	regressorEvaluation = NULL;
-
 	// Initialisation des variables du maitre
 	bIsRecCurveCalculated = true;
 	nMasterErrorVectorMaxCapacity = 0;
 	nSlaveErrorVectorMaxCapacity = 0;
 
+	// Initialisation des variables de l'esclave
+	nSlaveRankAbsoluteErrorNumber = 0;
+
 	// Declaration des variables partagees
 	DeclareSharedParameter(&shared_liTargetAttribute);
-	DeclareSharedParameter(&shared_liMeanAttribute);
-	DeclareSharedParameter(&shared_liDensityAttribute);
-	DeclareSharedParameter(&shared_liTargetRankAttribute);
-	DeclareSharedParameter(&shared_liMeanRankAttribute);
-	DeclareSharedParameter(&shared_liRankDensityAttribute);
+	DeclareSharedParameter(&shared_livMeanAttributes);
+	DeclareSharedParameter(&shared_livDensityAttributes);
+	DeclareSharedParameter(&shared_livTargetRankAttributes);
+	DeclareSharedParameter(&shared_livMeanRankAttributes);
+	DeclareSharedParameter(&shared_livRankDensityAttributes);
 	DeclareTaskInput(&input_bIsRecCurveCalculated);
-	DeclareTaskOutput(&output_nTargetMissingValueNumber);
-	DeclareTaskOutput(&output_dRMSE);
-	DeclareTaskOutput(&output_dMAE);
-	DeclareTaskOutput(&output_dNLPD);
-	DeclareTaskOutput(&output_dRankRMSE);
-	DeclareTaskOutput(&output_dRankMAE);
-	DeclareTaskOutput(&output_dRankNLPD);
+	DeclareTaskOutput(&output_ivTargetMissingValueNumbers);
+	DeclareTaskOutput(&output_dvRMSE);
+	DeclareTaskOutput(&output_dvMAE);
+	DeclareTaskOutput(&output_dvNLPD);
+	DeclareTaskOutput(&output_dvRankRMSE);
+	DeclareTaskOutput(&output_dvRankMAE);
+	DeclareTaskOutput(&output_dvRankNLPD);
 	DeclareTaskOutput(&output_dvRankAbsoluteErrors);
+	DeclareTaskOutput(&output_ivRankAbsoluteErrorNumbers);
 	DeclareTaskOutput(&output_bIsRecCurveVectorOverflowed);
 	DeclareTaskOutput(&output_nSlaveCapacityOverflowSize);
 }
 
-KWRegressorEvaluationTask::~KWRegressorEvaluationTask() {}
+KWRegressorEvaluationTask::~KWRegressorEvaluationTask()
+{
+	assert(oaMasterRankAbsoluteErrors.GetSize() == 0);
+	assert(oaSlaveRankAbsoluteErrors.GetSize() == 0);
+}
 
 const ALString KWRegressorEvaluationTask::GetTaskName() const
 {
@@ -919,8 +1115,8 @@ boolean KWRegressorEvaluationTask::ComputeResourceRequirements()
 	lEstimatedTotalObjectNumber =
 	    shared_sourceDatabase.GetPLDatabase()->GetDatabase()->GetSampleEstimatedObjectNumber();
 
-	// Estimation de la memoire totale necessaire pour le calcul de la courbe de REC
-	lMaxRequiredEvaluationMemory = lEstimatedTotalObjectNumber * sizeof(double) + lMB / 2;
+	// Estimation de la memoire totale necessaire pour le calcul des courbes de REC de tous les regresseurs
+	lMaxRequiredEvaluationMemory = lEstimatedTotalObjectNumber * sizeof(double) * GetPredictorNumber() + lMB / 2;
 
 	// Estimation de la memoire total restante pour en donner au max la moitie au maitre
 	lRemainingMemory = RMResourceManager::GetRemainingAvailableMemory();
@@ -953,18 +1149,21 @@ boolean KWRegressorEvaluationTask::ComputeResourceRequirements()
 boolean KWRegressorEvaluationTask::MasterInitialize()
 {
 	boolean bOk;
+	int nPredictor;
 	longint lGrantedMemory;
 
-	require(predictorEvaluation != NULL);
+	require(oaPredictorEvaluations.GetSize() == GetPredictorNumber());
+	require(oaMasterRankAbsoluteErrors.GetSize() == 0);
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::MasterInitialize();
 
-	// Memorisation de la specialisation du rapport d'evaluation demandeur
-	regressorEvaluation = cast(KWRegressorEvaluation*, predictorEvaluation);
+	// Initialisation des vecteurs d'erreurs par regresseur
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		oaMasterRankAbsoluteErrors.Add(new DoubleVector);
 	bIsRecCurveCalculated = true;
 
-	// Dimensionnement du vecteur des predictions du regresseur cote maitre
+	// Dimensionnement des vecteurs des predictions des regresseurs cote maitre
 	lGrantedMemory = GetMasterResourceGrant()->GetMemory();
 	if (lGrantedMemory / sizeof(double) < INT_MAX)
 		nMasterErrorVectorMaxCapacity = (int)(lGrantedMemory / sizeof(double));
@@ -988,20 +1187,30 @@ boolean KWRegressorEvaluationTask::MasterPrepareTaskInput(double& dTaskPercent,
 boolean KWRegressorEvaluationTask::MasterAggregateResults()
 {
 	boolean bOk;
+	int nPredictor;
+	KWRegressorEvaluation* regressorEvaluation;
+	DoubleVector* dvRankAbsoluteErrors;
 	int nMasterCapacityOverflowSize;
 	int nRankAbsoluteError;
+	int nSlaveRankAbsoluteError;
+
+	require(output_dvRMSE.GetSize() == GetPredictorNumber());
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::MasterAggregateResults();
 
-	// Mise a jour des criteres d'evaluation
-	regressorEvaluation->lTargetMissingValueNumber += output_nTargetMissingValueNumber;
-	regressorEvaluation->dRMSE += output_dRMSE;
-	regressorEvaluation->dMAE += output_dMAE;
-	regressorEvaluation->dNLPD += output_dNLPD;
-	regressorEvaluation->dRankRMSE += output_dRankRMSE;
-	regressorEvaluation->dRankMAE += output_dRankMAE;
-	regressorEvaluation->dRankNLPD += output_dRankNLPD;
+	// Mise a jour des criteres d'evaluation de chaque regresseur
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		regressorEvaluation = cast(KWRegressorEvaluation*, GetPredictorEvaluationAt(nPredictor));
+		regressorEvaluation->lTargetMissingValueNumber += output_ivTargetMissingValueNumbers.GetAt(nPredictor);
+		regressorEvaluation->dRMSE += output_dvRMSE.GetAt(nPredictor);
+		regressorEvaluation->dMAE += output_dvMAE.GetAt(nPredictor);
+		regressorEvaluation->dNLPD += output_dvNLPD.GetAt(nPredictor);
+		regressorEvaluation->dRankRMSE += output_dvRankRMSE.GetAt(nPredictor);
+		regressorEvaluation->dRankMAE += output_dvRankMAE.GetAt(nPredictor);
+		regressorEvaluation->dRankNLPD += output_dvRankNLPD.GetAt(nPredictor);
+	}
 
 	// Si les esclaves overflowent, la courbe de REC n'est plus evaluee
 	// On nettoie les donnees collectees et on emet un warning a l'utilisateur
@@ -1009,40 +1218,58 @@ boolean KWRegressorEvaluationTask::MasterAggregateResults()
 	{
 		// Nettoyage des donnees collectees en cours
 		bIsRecCurveCalculated = false;
-		dvRankAbsoluteErrors.SetSize(0);
+		for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+			cast(DoubleVector*, oaMasterRankAbsoluteErrors.GetAt(nPredictor))->SetSize(0);
 
 		// Warning utilisateur (les autres criteres sont toujours calcules)
-		AddWarning("Not enough memory in slave to compute REC curve (needs extra " +
-			   RMResourceManager::ActualMemoryToString((longint)output_nSlaveCapacityOverflowSize *
-								   sizeof(double)) +
-			   ")");
+		for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+			GetPredictorEvaluationAt(nPredictor)->AddWarning(
+			    "Not enough memory in slave to compute REC curve (needs extra " +
+			    RMResourceManager::ActualMemoryToString((longint)output_nSlaveCapacityOverflowSize *
+								    sizeof(double)) +
+			    ")");
 	}
 
-	// Collecte des erreurs de prediction pour la courbe de REC
+	// Collecte des erreurs de prediction pour les courbes de REC
 	if (bIsRecCurveCalculated)
 	{
-		// Test de depassement de capacite du vecteur d'erreurs
-		nMasterCapacityOverflowSize = dvRankAbsoluteErrors.GetSize() + output_dvRankAbsoluteErrors.GetSize() -
-					      nMasterErrorVectorMaxCapacity;
+		// Test de depassement de capacite des vecteurs d'erreurs
+		assert(output_ivRankAbsoluteErrorNumbers.GetSize() == GetPredictorNumber());
+		nMasterCapacityOverflowSize = GetTotalRankAbsoluteErrorNumber(&oaMasterRankAbsoluteErrors) +
+					      output_dvRankAbsoluteErrors.GetSize() - nMasterErrorVectorMaxCapacity;
 		nMasterCapacityOverflowSize = max(nMasterCapacityOverflowSize, 0);
 		if (nMasterCapacityOverflowSize > 0)
 		{
 			// Warning utilisteur (les autres criteres sont toujours calcules)
-			AddWarning("Not enough memory in master to compute REC curve (needs extra " +
-				   RMResourceManager::ActualMemoryToString((longint)nMasterCapacityOverflowSize *
-									   sizeof(double)) +
-				   ")");
+			for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+				GetPredictorEvaluationAt(nPredictor)->AddWarning(
+				    "Not enough memory in master to compute REC curve (needs extra " +
+				    RMResourceManager::ActualMemoryToString((longint)nMasterCapacityOverflowSize *
+									    sizeof(double)) +
+				    ")");
 
 			// Nettoyage
-			dvRankAbsoluteErrors.SetSize(0);
+			for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+				cast(DoubleVector*, oaMasterRankAbsoluteErrors.GetAt(nPredictor))->SetSize(0);
 			bIsRecCurveCalculated = false;
 		}
-		// Collecte des erreur veannt de l'esclave
+		// Collecte des erreur venant de l'esclave, concatenees par regresseur
 		else
 		{
-			for (nRankAbsoluteError = 0; nRankAbsoluteError < output_dvRankAbsoluteErrors.GetSize();
-			     nRankAbsoluteError++)
-				dvRankAbsoluteErrors.Add(output_dvRankAbsoluteErrors.GetAt(nRankAbsoluteError));
+			nSlaveRankAbsoluteError = 0;
+			for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+			{
+				dvRankAbsoluteErrors = cast(DoubleVector*, oaMasterRankAbsoluteErrors.GetAt(nPredictor));
+				for (nRankAbsoluteError = 0;
+				     nRankAbsoluteError < output_ivRankAbsoluteErrorNumbers.GetAt(nPredictor);
+				     nRankAbsoluteError++)
+				{
+					dvRankAbsoluteErrors->Add(
+					    output_dvRankAbsoluteErrors.GetAt(nSlaveRankAbsoluteError));
+					nSlaveRankAbsoluteError++;
+				}
+			}
+			assert(nSlaveRankAbsoluteError == output_dvRankAbsoluteErrors.GetSize());
 		}
 	}
 	return bOk;
@@ -1052,6 +1279,9 @@ boolean KWRegressorEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly
 {
 	const int nRankRECPartileNumber = 1000;
 	boolean bOk;
+	int nPredictor;
+	KWRegressorEvaluation* regressorEvaluation;
+	DoubleVector* dvRankAbsoluteErrors;
 	int nRankAbsoluteError;
 	int nPartile;
 	double dRankAbsoluteErrorThreshold;
@@ -1061,9 +1291,14 @@ boolean KWRegressorEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::MasterFinalize(bProcessEndedCorrectly);
 
-	// Finalisation du calcul si ok
-	if (bOk)
+	// Finalisation du calcul si ok, par regresseur
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
 	{
+		if (not bOk)
+			break;
+
+		regressorEvaluation = cast(KWRegressorEvaluation*, GetPredictorEvaluationAt(nPredictor));
+		dvRankAbsoluteErrors = cast(DoubleVector*, oaMasterRankAbsoluteErrors.GetAt(nPredictor));
 		if (regressorEvaluation->lInstanceEvaluationNumber > 0)
 		{
 			// Calcul du nombre d'instances utilisable pour le calcul des criteres sur les valeurs
@@ -1075,7 +1310,7 @@ boolean KWRegressorEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly
 			{
 				sMessage = "Evaluation criteria cannot be computed, since all records have a missing "
 					   "target value";
-				AddWarning(sMessage);
+				regressorEvaluation->AddWarning(sMessage);
 			}
 			else if (regressorEvaluation->lTargetMissingValueNumber > 0)
 			{
@@ -1086,7 +1321,7 @@ boolean KWRegressorEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly
 				sMessage += sTmp +
 					    LongintToReadableString(regressorEvaluation->lTargetMissingValueNumber) +
 					    " missing target values";
-				AddWarning(sMessage);
+				regressorEvaluation->AddWarning(sMessage);
 			}
 
 			// Criteres, evalue uniquement en l'absence de valeurs manquantes
@@ -1102,11 +1337,11 @@ boolean KWRegressorEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly
 				regressorEvaluation->dRankNLPD /= regressorEvaluation->lInstanceEvaluationNumber;
 
 				// Calcul de la courbe de REC
-				if (bIsRecCurveCalculated and dvRankAbsoluteErrors.GetSize() > 0)
+				if (bIsRecCurveCalculated and dvRankAbsoluteErrors->GetSize() > 0)
 				{
-					assert(dvRankAbsoluteErrors.GetSize() ==
+					assert(dvRankAbsoluteErrors->GetSize() ==
 					       regressorEvaluation->lInstanceEvaluationNumber);
-					dvRankAbsoluteErrors.Sort();
+					dvRankAbsoluteErrors->Sort();
 					regressorEvaluation->dvRankRECCurveValues.SetSize(nRankRECPartileNumber + 1);
 					nRankAbsoluteError = 0;
 					for (nPartile = 1; nPartile <= nRankRECPartileNumber; nPartile++)
@@ -1114,36 +1349,49 @@ boolean KWRegressorEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly
 						dRankAbsoluteErrorThreshold = nPartile * 1.0 / nRankRECPartileNumber;
 
 						// Calcul du nombre d'instance ayant une erreur inferieure au seuil
-						while (nRankAbsoluteError < dvRankAbsoluteErrors.GetSize() and
-						       dvRankAbsoluteErrors.GetAt(nRankAbsoluteError) <=
+						while (nRankAbsoluteError < dvRankAbsoluteErrors->GetSize() and
+						       dvRankAbsoluteErrors->GetAt(nRankAbsoluteError) <=
 							   dRankAbsoluteErrorThreshold)
 							nRankAbsoluteError++;
 
 						// Memorisation de la valeur de la courbe de REC
 						regressorEvaluation->dvRankRECCurveValues.SetAt(
 						    nPartile,
-						    (1.0 * nRankAbsoluteError) / dvRankAbsoluteErrors.GetSize());
+						    (1.0 * nRankAbsoluteError) / dvRankAbsoluteErrors->GetSize());
 					}
 				}
 			}
-
-			// Nettoyage
-			dvRankAbsoluteErrors.SetSize(0);
-			nMasterErrorVectorMaxCapacity = 0;
-			regressorEvaluation = NULL;
 		}
 	}
+
+	// Nettoyage
+	oaMasterRankAbsoluteErrors.DeleteAll();
+	nMasterErrorVectorMaxCapacity = 0;
 	return bOk;
 }
 
 boolean KWRegressorEvaluationTask::SlaveInitialize()
 {
 	boolean bOk;
+	int nPredictor;
 	longint lGrantedMemory;
 
+	require(oaSlaveRankAbsoluteErrors.GetSize() == 0);
+
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::SlaveInitialize();
 
+	// Initialisation des criteres et des vecteurs d'erreurs par regresseur
+	ivSlaveTargetMissingValueNumbers.SetSize(GetPredictorNumber());
+	dvSlaveRMSE.SetSize(GetPredictorNumber());
+	dvSlaveMAE.SetSize(GetPredictorNumber());
+	dvSlaveNLPD.SetSize(GetPredictorNumber());
+	dvSlaveRankRMSE.SetSize(GetPredictorNumber());
+	dvSlaveRankMAE.SetSize(GetPredictorNumber());
+	dvSlaveRankNLPD.SetSize(GetPredictorNumber());
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		oaSlaveRankAbsoluteErrors.Add(new DoubleVector);
+
 	// Dimensionnement du vecteur des predictions du regresseur cote maitre
 	lGrantedMemory =
 	    ComputeSlaveGrantedMemory(GetSlaveResourceRequirement(), GetSlaveResourceGrant()->GetMemory(), false);
@@ -1157,26 +1405,53 @@ boolean KWRegressorEvaluationTask::SlaveInitialize()
 boolean KWRegressorEvaluationTask::SlaveProcessExploitDatabase()
 {
 	boolean bOk;
+	int nPredictor;
+	DoubleVector* dvRankAbsoluteErrors;
+	int nRankAbsoluteError;
 	longint lCapacityOverflowSize;
 
 	// Initialisation des resultats de l'esclave
-	output_nTargetMissingValueNumber = 0;
-	output_dRMSE = 0;
-	output_dMAE = 0;
-	output_dNLPD = 0;
-	output_dRankRMSE = 0;
-	output_dRankMAE = 0;
-	output_dRankNLPD = 0;
+	ivSlaveTargetMissingValueNumbers.Initialize();
+	dvSlaveRMSE.Initialize();
+	dvSlaveMAE.Initialize();
+	dvSlaveNLPD.Initialize();
+	dvSlaveRankRMSE.Initialize();
+	dvSlaveRankMAE.Initialize();
+	dvSlaveRankNLPD.Initialize();
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		cast(DoubleVector*, oaSlaveRankAbsoluteErrors.GetAt(nPredictor))->SetSize(0);
+	nSlaveRankAbsoluteErrorNumber = 0;
 	output_bIsRecCurveVectorOverflowed = false;
 	output_nSlaveCapacityOverflowSize = 0;
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::SlaveProcessExploitDatabase();
 
+	// Remplissage des sorties de l'esclave
+	output_ivTargetMissingValueNumbers.GetIntVector()->CopyFrom(&ivSlaveTargetMissingValueNumbers);
+	output_dvRMSE.GetDoubleVector()->CopyFrom(&dvSlaveRMSE);
+	output_dvMAE.GetDoubleVector()->CopyFrom(&dvSlaveMAE);
+	output_dvNLPD.GetDoubleVector()->CopyFrom(&dvSlaveNLPD);
+	output_dvRankRMSE.GetDoubleVector()->CopyFrom(&dvSlaveRankRMSE);
+	output_dvRankMAE.GetDoubleVector()->CopyFrom(&dvSlaveRankMAE);
+	output_dvRankNLPD.GetDoubleVector()->CopyFrom(&dvSlaveRankNLPD);
+
+	// Concatenation des erreurs de rang des regresseurs
+	output_dvRankAbsoluteErrors.GetDoubleVector()->SetSize(0);
+	output_ivRankAbsoluteErrorNumbers.GetIntVector()->SetSize(0);
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		dvRankAbsoluteErrors = cast(DoubleVector*, oaSlaveRankAbsoluteErrors.GetAt(nPredictor));
+		output_ivRankAbsoluteErrorNumbers.Add(dvRankAbsoluteErrors->GetSize());
+		for (nRankAbsoluteError = 0; nRankAbsoluteError < dvRankAbsoluteErrors->GetSize(); nRankAbsoluteError++)
+			output_dvRankAbsoluteErrors.Add(dvRankAbsoluteErrors->GetAt(nRankAbsoluteError));
+		dvRankAbsoluteErrors->SetSize(0);
+	}
+
 	// En cas d'overflow, on calcule sa taille pour la renvoyer au maitre
 	if (output_bIsRecCurveVectorOverflowed)
 	{
-		lCapacityOverflowSize = output_lReadObjects - nSlaveErrorVectorMaxCapacity;
+		lCapacityOverflowSize = output_lReadObjects * GetPredictorNumber() - nSlaveErrorVectorMaxCapacity;
 		if (lCapacityOverflowSize > INT_MAX)
 			output_nSlaveCapacityOverflowSize = INT_MAX;
 		else
@@ -1190,89 +1465,105 @@ boolean KWRegressorEvaluationTask::SlaveProcessExploitDatabaseObject(const KWObj
 {
 	const double dEpsilonMin = DBL_MIN;
 	boolean bOk;
+	int nPredictor;
 	Continuous cTargetActualValue;
 	Continuous cTargetPredictedValue;
 	double dDiff;
 	double dDensity;
 	boolean bMissingValue;
+	int nRankPredictor;
 
 	require(kwoObject != NULL);
 
 	// Appel a la methode ancetre
 	bOk = KWPredictorEvaluationTask::SlaveProcessExploitDatabaseObject(kwoObject);
 
-	// Evaluation des criteres sur les valeurs
-	bMissingValue = false;
-	if (shared_liTargetAttribute.GetValue().IsValid() and shared_liMeanAttribute.GetValue().IsValid())
+	// Evaluation de l'instance pour chaque regresseur
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
 	{
-		// Acces aux valeurs cibles reelle et predite
-		cTargetActualValue = kwoObject->GetContinuousValueAt(shared_liTargetAttribute.GetValue());
-		cTargetPredictedValue = kwoObject->GetContinuousValueAt(shared_liMeanAttribute.GetValue());
-
-		// Detection de presence de valeur manquante
-		if (cTargetActualValue == KWContinuous::GetMissingValue())
+		// Evaluation des criteres sur les valeurs
+		bMissingValue = false;
+		if (shared_liTargetAttribute.GetValue().IsValid() and
+		    shared_livMeanAttributes.GetAt(nPredictor).IsValid())
 		{
-			output_nTargetMissingValueNumber += 1;
-			bMissingValue = true;
-		}
-		if (cTargetPredictedValue == KWContinuous::GetMissingValue())
-			bMissingValue = true;
+			// Acces aux valeurs cibles reelle et predite
+			cTargetActualValue = kwoObject->GetContinuousValueAt(shared_liTargetAttribute.GetValue());
+			cTargetPredictedValue =
+			    kwoObject->GetContinuousValueAt(shared_livMeanAttributes.GetAt(nPredictor));
 
-		// Mise a jour des crieres sur les valeur si possible
-		if (not bMissingValue)
-		{
-			// Calcul de la difference de valeur
-			dDiff = cTargetPredictedValue - cTargetActualValue;
+			// Detection de presence de valeur manquante
+			if (cTargetActualValue == KWContinuous::GetMissingValue())
+			{
+				ivSlaveTargetMissingValueNumbers.UpgradeAt(nPredictor, 1);
+				bMissingValue = true;
+			}
+			if (cTargetPredictedValue == KWContinuous::GetMissingValue())
+				bMissingValue = true;
+
+			// Mise a jour des crieres sur les valeur si possible
+			if (not bMissingValue)
+			{
+				// Calcul de la difference de valeur
+				dDiff = cTargetPredictedValue - cTargetActualValue;
 
-			// Mise a jour du RMSE et du MAE
-			output_dRMSE += dDiff * dDiff;
-			output_dMAE += fabs(dDiff);
+				// Mise a jour du RMSE et du MAE
+				dvSlaveRMSE.UpgradeAt(nPredictor, dDiff * dDiff);
+				dvSlaveMAE.UpgradeAt(nPredictor, fabs(dDiff));
+			}
 		}
-	}
 
-	// Mise a jour de la somme des densites de valeurs
-	if (shared_liDensityAttribute.GetValue().IsValid() and not bMissingValue)
-	{
-		dDensity = kwoObject->GetContinuousValueAt(shared_liDensityAttribute.GetValue());
-		if (dDensity < dEpsilonMin)
-			dDensity = dEpsilonMin;
-		output_dNLPD -= log(dDensity);
-	}
+		// Mise a jour de la somme des densites de valeurs
+		if (shared_livDensityAttributes.GetAt(nPredictor).IsValid() and not bMissingValue)
+		{
+			dDensity = kwoObject->GetContinuousValueAt(shared_livDensityAttributes.GetAt(nPredictor));
+			if (dDensity < dEpsilonMin)
+				dDensity = dEpsilonMin;
+			dvSlaveNLPD.UpgradeAt(nPredictor, -log(dDensity));
+		}
 
-	// Evaluation des criteres sur les rangs
-	if (shared_liTargetRankAttribute.GetValue().IsValid() and shared_liMeanRankAttribute.GetValue().IsValid() and
-	    not bMissingValue)
-	{
-		// Calcul de la difference de rang
-		dDiff = kwoObject->GetContinuousValueAt(shared_liMeanRankAttribute.GetValue()) -
-			kwoObject->GetContinuousValueAt(shared_liTargetRankAttribute.GetValue());
+		// Evaluation des criteres sur les rangs
+		if (shared_livTargetRankAttributes.GetAt(nPredictor).IsValid() and
+		    shared_livMeanRankAttributes.GetAt(nPredictor).IsValid() and not bMissingValue)
+		{
+			// Calcul de la difference de rang
+			dDiff = kwoObject->GetContinuousValueAt(shared_livMeanRankAttributes.GetAt(nPredictor)) -
+				kwoObject->GetContinuousValueAt(shared_livTargetRankAttributes.GetAt(nPredictor));
 
-		// Mise a jour du RankRMSE et du RankMAE
-		output_dRankRMSE += dDiff * dDiff;
-		output_dRankMAE += fabs(dDiff);
+			// Mise a jour du RankRMSE et du RankMAE
+			dvSlaveRankRMSE.UpgradeAt(nPredictor, dDiff * dDiff);
+			dvSlaveRankMAE.UpgradeAt(nPredictor, fabs(dDiff));
 
-		// Ajout d'une valeur dans le vecteur des difference de rangs
-		if (input_bIsRecCurveCalculated and not output_bIsRecCurveVectorOverflowed)
-		{
-			// On arrete tout si l'on a va depasser la capacite de l'esclave
-			if (output_dvRankAbsoluteErrors.GetSize() == nSlaveErrorVectorMaxCapacity)
+			// Ajout d'une valeur dans le vecteur des difference de rangs
+			if (input_bIsRecCurveCalculated and not output_bIsRecCurveVectorOverflowed)
 			{
-				output_dvRankAbsoluteErrors.GetDoubleVector()->SetSize(0);
-				output_bIsRecCurveVectorOverflowed = true;
+				// On arrete tout si l'on a va depasser la capacite de l'esclave, partagee entre
+				// les regresseurs
+				if (nSlaveRankAbsoluteErrorNumber == nSlaveErrorVectorMaxCapacity)
+				{
+					for (nRankPredictor = 0; nRankPredictor < GetPredictorNumber(); nRankPredictor++)
+						cast(DoubleVector*, oaSlaveRankAbsoluteErrors.GetAt(nRankPredictor))
+						    ->SetSize(0);
+					nSlaveRankAbsoluteErrorNumber = 0;
+					output_bIsRecCurveVectorOverflowed = true;
+				}
+				// Sinon, on ajoute l'erreur
+				else
+				{
+					cast(DoubleVector*, oaSlaveRankAbsoluteErrors.GetAt(nPredictor))
+					    ->Add(fabs(dDiff));
+					nSlaveRankAbsoluteErrorNumber++;
+				}
 			}
-			// Sinon, on ajoute l'erreur
-			else
-				output_dvRankAbsoluteErrors.Add(fabs(dDiff));
 		}
-	}
 
-	// Mise a jour de la somme des densites de rang
-	if (shared_liRankDensityAttribute.GetValue().IsValid() and not bMissingValue)
-	{
-		dDensity = kwoObject->GetContinuousValueAt(shared_liRankDensityAttribute.GetValue());
-		if (dDensity < dEpsilonMin)
-			dDensity = dEpsilonMin;
-		output_dRankNLPD -= log(dDensity);
+		// Mise a jour de la somme des densites de rang
+		if (shared_livRankDensityAttributes.GetAt(nPredictor).IsValid() and not bMissingValue)
+		{
+			dDensity = kwoObject->GetContinuousValueAt(shared_livRankDensityAttributes.GetAt(nPredictor));
+			if (dDensity < dEpsilonMin)
+				dDensity = dEpsilonMin;
+			dvSlaveRankNLPD.UpgradeAt(nPredictor, -log(dDensity));
+		}
 	}
 
 	return bOk;
@@ -1286,31 +1577,55 @@ boolean KWRegressorEvaluationTask::SlaveFinalize(boolean bProcessEndedCorrectly)
 	bOk = KWPredictorEvaluationTask::SlaveFinalize(bProcessEndedCorrectly);
 
 	// Nettoyage
+	oaSlaveRankAbsoluteErrors.DeleteAll();
+	nSlaveRankAbsoluteErrorNumber = 0;
 	nSlaveErrorVectorMaxCapacity = 0;
 	return bOk;
 }
 
-void KWRegressorEvaluationTask::InitializePredictorSharedVariables(KWPredictor* predictor)
+void KWRegressorEvaluationTask::InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor)
 {
 	KWTrainedRegressor* trainedRegressor;
 
+	require(shared_livMeanAttributes.GetSize() == nPredictor);
+
 	trainedRegressor = predictor->GetTrainedRegressor();
-	shared_liTargetAttribute.SetValue(GetLoadIndex(trainedRegressor->GetTargetAttribute()));
-	shared_liMeanAttribute.SetValue(GetLoadIndex(trainedRegressor->GetMeanAttribute()));
-	shared_liDensityAttribute.SetValue(GetLoadIndex(trainedRegressor->GetDensityAttribute()));
-	shared_liTargetRankAttribute.SetValue(GetLoadIndex(trainedRegressor->GetTargetAttributeRank()));
-	shared_liMeanRankAttribute.SetValue(GetLoadIndex(trainedRegressor->GetMeanRankAttribute()));
-	shared_liRankDensityAttribute.SetValue(GetLoadIndex(trainedRegressor->GetDensityRankAttribute()));
+	assert(nPredictor == 0 or GetLoadIndex(nPredictor, trainedRegressor->GetTargetAttribute()) ==
+				      shared_liTargetAttribute.GetValue());
+	shared_liTargetAttribute.SetValue(GetLoadIndex(nPredictor, trainedRegressor->GetTargetAttribute()));
+	shared_livMeanAttributes.GetLoadIndexVector()->Add(
+	    GetLoadIndex(nPredictor, trainedRegressor->GetMeanAttribute()));
+	shared_livDensityAttributes.GetLoadIndexVector()->Add(
+	    GetLoadIndex(nPredictor, trainedRegressor->GetDensityAttribute()));
+	shared_livTargetRankAttributes.GetLoadIndexVector()->Add(
+	    GetLoadIndex(nPredictor, trainedRegressor->GetTargetAttributeRank()));
+	shared_livMeanRankAttributes.GetLoadIndexVector()->Add(
+	    GetLoadIndex(nPredictor, trainedRegressor->GetMeanRankAttribute()));
+	shared_livRankDensityAttributes.GetLoadIndexVector()->Add(
+	    GetLoadIndex(nPredictor, trainedRegressor->GetDensityRankAttribute()));
 }
 
 void KWRegressorEvaluationTask::CleanPredictorSharedVariables()
 {
 	shared_liTargetAttribute.GetValue().Reset();
-	shared_liMeanAttribute.GetValue().Reset();
-	shared_liDensityAttribute.GetValue().Reset();
-	shared_liTargetRankAttribute.GetValue().Reset();
-	shared_liMeanRankAttribute.GetValue().Reset();
-	shared_liRankDensityAttribute.GetValue().Reset();
+	shared_livMeanAttributes.SetSize(0);
+	shared_livDensityAttributes.SetSize(0);
+	shared_livTargetRankAttributes.SetSize(0);
+	shared_livMeanRankAttributes.SetSize(0);
+	shared_livRankDensityAttributes.SetSize(0);
+}
+
+int KWRegressorEvaluationTask::GetTotalRankAbsoluteErrorNumber(const ObjectArray* oaRankAbsoluteErrors) const
+{
+	int nTotal;
+	int nPredictor;
+
+	require(oaRankAbsoluteErrors != NULL);
+
+	nTotal = 0;
+	for (nPredictor = 0; nPredictor < oaRankAbsoluteErrors->GetSize(); nPredictor++)
+		nTotal += cast(DoubleVector*, oaRankAbsoluteErrors->GetAt(nPredictor))->GetSize();
+	return nTotal;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1877,28 +2192,10 @@ int KWConfusionMatrixEvaluation::ComputeCumulatedPredictedFrequencyAt(const Symb
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 // Classe KWAucEvaluation
 
-int KWClassifierInstanceEvaluationCompare(const void* elem1, const void* elem2)
-{
-	KWClassifierInstanceEvaluation* instanceA;
-	KWClassifierInstanceEvaluation* instanceB;
-
-	instanceA = cast(KWClassifierInstanceEvaluation*, *(Object**)elem1);
-	instanceB = cast(KWClassifierInstanceEvaluation*, *(Object**)elem2);
-
-	assert(instanceA != NULL and instanceB != NULL);
-
-	return KWContinuous::Compare(instanceA->GetSortValue(), instanceB->GetSortValue());
-}
-
-// On utilise un epsilon = 0 pour gerer les egalites score de la courbe de ROC,
-// calculee selon la methode des trapezes.
-// Des differences non nulles (e.g 1e-5) menent a une sous-estimation parfois importante de l'AUC
-double KWAucEvaluation::dEpsilon = 0;
-
 KWAucEvaluation::KWAucEvaluation()
 {
 	nTargetValueNumber = 0;
-	oaInstanceEvaluations = NULL;
+	oaScoreHistograms = NULL;
 }
 
 KWAucEvaluation::~KWAucEvaluation() {}
@@ -1906,27 +2203,30 @@ KWAucEvaluation::~KWAucEvaluation() {}
 void KWAucEvaluation::Initialize()
 {
 	nTargetValueNumber = 0;
-	oaInstanceEvaluations = NULL;
+	oaScoreHistograms = NULL;
 }
 
-void KWAucEvaluation::SetInstanceEvaluations(ObjectArray* instances)
+void KWAucEvaluation::SetScoreHistograms(const ObjectArray* oaHistograms)
 {
-	oaInstanceEvaluations = instances;
+	oaScoreHistograms = oaHistograms;
 }
 
 double KWAucEvaluation::ComputeGlobalAUCValue()
 {
 	double dEvaluation;
 	int nTargetValue;
-	IntVector ivTargetValueFrequencies;
-	int nUnknownTargetValue;
-	KWClassifierInstanceEvaluation* instanceEvaluation;
-	int nInstance;
+	longint lTotalFrequency;
+	longint lUnknownTargetValueFrequency;
+
+	require(oaScoreHistograms != NULL);
+	require(oaScoreHistograms->GetSize() == GetTargetValueNumber());
+	require(GetTargetValueNumber() > 0);
 
-	require(oaInstanceEvaluations != NULL);
+	// Chaque histogramme porte sur l'ensemble des instances
+	lTotalFrequency = GetScoreHistogramAt(0)->GetTotalFrequency();
 
 	// Calcul de l'evaluation globale en ponderant par les frequences de modalites cibles
-	if (oaInstanceEvaluations->GetSize() == 0)
+	if (lTotalFrequency == 0)
 		dEvaluation = 1;
 	// Cas general: ponderation des evaluations par les frequences des modalites cibles
 	// On ne gere pas le cas particulier de deux valeurs cibles (le calcul de l'AUC n'est pas tout
@@ -1935,31 +2235,22 @@ double KWAucEvaluation::ComputeGlobalAUCValue()
 	// Les modalite cibles non vues en apprentissage comptent pour une AUC de 0.5
 	else
 	{
-		// Calcul des effectifs par valeurs cible
-		// Le dernier effectif du vecteur (surnumeraire) sert a gerer les modalites cibles en test
-		// non vues en apprentissage
-		ivTargetValueFrequencies.SetSize(GetTargetValueNumber() + 1);
-		nUnknownTargetValue = GetTargetValueNumber();
-		for (nInstance = 0; nInstance < oaInstanceEvaluations->GetSize(); nInstance++)
+		// L'effectif d'une valeur cible est celui des instances positives de son histogramme, et les
+		// instances restantes correspondent aux modalites cibles en test non vues en apprentissage
+		dEvaluation = 0;
+		lUnknownTargetValueFrequency = lTotalFrequency;
+		for (nTargetValue = 0; nTargetValue < GetTargetValueNumber(); nTargetValue++)
 		{
-			instanceEvaluation =
-			    cast(KWClassifierInstanceEvaluation*, oaInstanceEvaluations->GetAt(nInstance));
-			nTargetValue = instanceEvaluation->GetActualTargetIndex();
-			assert(0 <= nTargetValue and nTargetValue <= GetTargetValueNumber());
-
-			// On ignore les instances des classes non vues en apprentissage
-			if (nTargetValue < GetTargetValueNumber())
-				ivTargetValueFrequencies.UpgradeAt(nTargetValue, 1);
-			else
-				ivTargetValueFrequencies.UpgradeAt(nUnknownTargetValue, 1);
+			assert(GetScoreHistogramAt(nTargetValue)->GetTotalFrequency() == lTotalFrequency);
+			dEvaluation += GetScoreHistogramAt(nTargetValue)->GetTotalPositiveFrequency() *
+				       ComputeAUCValueAt(nTargetValue);
+			lUnknownTargetValueFrequency -= GetScoreHistogramAt(nTargetValue)->GetTotalPositiveFrequency();
 		}
+		assert(lUnknownTargetValueFrequency >= 0);
 
 		// Evaluation: On table sur une AUC de 0.5 pour les valeurs cibles inconnues
-		dEvaluation = 0;
-		for (nTargetValue = 0; nTargetValue < GetTargetValueNumber(); nTargetValue++)
-			dEvaluation += ivTargetValueFrequencies.GetAt(nTargetValue) * ComputeAUCValueAt(nTargetValue);
-		dEvaluation += ivTargetValueFrequencies.GetAt(nUnknownTargetValue) * 0.5;
-		dEvaluation /= oaInstanceEvaluations->GetSize();
+		dEvaluation += lUnknownTargetValueFrequency * 0.5;
+		dEvaluation /= lTotalFrequency;
 	}
 	return dEvaluation;
 }
@@ -1967,97 +2258,58 @@ double KWAucEvaluation::ComputeGlobalAUCValue()
 double KWAucEvaluation::ComputeAUCValueAt(int nTargetValueIndex)
 {
 	boolean bDisplay = false;
-	KWClassifierInstanceEvaluation* instanceEvaluation;
+	const KWScoreHistogram* scoreHistogram;
 	double dEvaluation;
-	int nInstance;
-	Continuous cBlockScore;
+	int nBin;
 	double dBlockROCCurveArea;
 	double dObservedROCCurveArea;
-	Continuous cScore;
-	int nModalityIndex;
-	int nTruePositive;
-	int nFalsePositive;
-	int nPreviousTruePositive;
-	int nPreviousFalsePositive;
+	longint lTruePositive;
+	longint lFalsePositive;
+	longint lPreviousTruePositive;
+	longint lPreviousFalsePositive;
 
-	require(oaInstanceEvaluations != NULL);
+	require(oaScoreHistograms != NULL);
 	require(0 <= nTargetValueIndex and nTargetValueIndex < GetTargetValueNumber());
 
-	// Tri des scores pour cette modalite
-	SortInstanceEvaluationsAt(nTargetValueIndex);
+	// Acces a l'histogramme des scores pour cette modalite, par scores decroissants
+	scoreHistogram = GetScoreHistogramAt(nTargetValueIndex);
 
 	// Entete de la trace
 	if (bDisplay)
-		cout << "Instance\tScore\tTP\tFP\tROC area\tTotal AUC" << endl;
+		cout << "Bin\tScore\tTP\tFP\tROC area\tTotal AUC" << endl;
 
 	// Calcul de la surface de la courbe de ROC observee
+	// Toutes les instances d'un meme bin (ayant meme score) sont traitees en bloc, de
+	// facon a ne pas dependre de leur ordre, aleatoire
 	dObservedROCCurveArea = 0;
-	nTruePositive = 0;
-	nFalsePositive = 0;
-	nPreviousTruePositive = 0;
-	nPreviousFalsePositive = 0;
-	cBlockScore = 0;
-	for (nInstance = 0; nInstance < oaInstanceEvaluations->GetSize(); nInstance++)
-	{
-		instanceEvaluation = cast(KWClassifierInstanceEvaluation*, oaInstanceEvaluations->GetAt(nInstance));
-
-		// Acces aux valeurs
-		cScore = instanceEvaluation->GetTargetProbAt(nTargetValueIndex);
-		nModalityIndex = instanceEvaluation->GetActualTargetIndex();
-
-		// Memorisation de la premiere valeur de lift
-		if (nInstance == 0)
-			cBlockScore = cScore;
-
-		// Contribution a l'aire si changement de bloc
-		assert(cScore <= cBlockScore);
-		if (fabs(cScore - cBlockScore) > dEpsilon)
+	lTruePositive = 0;
+	lFalsePositive = 0;
+	for (nBin = 0; nBin < scoreHistogram->GetBinNumber(); nBin++)
+	{
+		// Incrementation du nombre d'instances positive ou negative
+		lPreviousTruePositive = lTruePositive;
+		lPreviousFalsePositive = lFalsePositive;
+		lTruePositive += scoreHistogram->GetPositiveFrequencyAt(nBin);
+		lFalsePositive += scoreHistogram->GetFrequencyAt(nBin) - scoreHistogram->GetPositiveFrequencyAt(nBin);
+
+		// Mise a jour de la valeur de la surface
+		dBlockROCCurveArea =
+		    (lFalsePositive - lPreviousFalsePositive) * 1.0 * (lTruePositive + lPreviousTruePositive) / 2.0;
+		dObservedROCCurveArea += dBlockROCCurveArea;
+
+		// Trace
+		if (bDisplay)
 		{
-			// Mise a jour de la valeur de la surface
-			// Toutes les instances ayant meme score sont traitees en bloc, de
-			// facon a ne pas dependre de leur ordre, aleatoire
-			dBlockROCCurveArea = (nFalsePositive - nPreviousFalsePositive) * 1.0 *
-					     (nTruePositive + nPreviousTruePositive) / 2.0;
-			dObservedROCCurveArea += dBlockROCCurveArea;
-
-			// Trace
-			if (bDisplay)
-			{
-				cout << nInstance << "\t" << cBlockScore << "\t" << nTruePositive << "\t"
-				     << nFalsePositive << "\t" << dBlockROCCurveArea << "\t" << dObservedROCCurveArea
-				     << endl;
-			}
-
-			// Initialisation d'un nouveau bloc
-			nPreviousTruePositive = nTruePositive;
-			nPreviousFalsePositive = nFalsePositive;
-			cBlockScore = cScore;
+			cout << nBin << "\t" << scoreHistogram->GetScoreAt(nBin) << "\t" << lTruePositive << "\t"
+			     << lFalsePositive << "\t" << dBlockROCCurveArea << "\t" << dObservedROCCurveArea << endl;
 		}
-
-		// Incrementation du nombre d'instances positive ou negative
-		if (nModalityIndex == nTargetValueIndex)
-			nTruePositive++;
-		else
-			nFalsePositive++;
-	}
-
-	// Prise en compte du dernier block
-	dBlockROCCurveArea =
-	    (nFalsePositive - nPreviousFalsePositive) * 1.0 * (nTruePositive + nPreviousTruePositive) / 2.0;
-	dObservedROCCurveArea += dBlockROCCurveArea;
-
-	// Trace du dernier bloc
-	if (bDisplay)
-	{
-		cout << nInstance << "\t" << cBlockScore << "\t" << nTruePositive << "\t" << nFalsePositive << "\t"
-		     << dBlockROCCurveArea << "\t" << dObservedROCCurveArea << endl;
 	}
 
 	// Normalisation dans el cas general
 	if (dObservedROCCurveArea > 0)
-		dObservedROCCurveArea /= nFalsePositive * 1.0 * nTruePositive;
+		dObservedROCCurveArea /= lFalsePositive * 1.0 * lTruePositive;
 	// Cas particulier ou il n'y a aucun faux-positif
-	else if (nFalsePositive == 0)
+	else if (lFalsePositive == 0)
 		dObservedROCCurveArea = 1;
 	dEvaluation = dObservedROCCurveArea;
 
@@ -2070,23 +2322,21 @@ double KWAucEvaluation::ComputeAUCValueAt(int nTargetValueIndex)
 
 void KWAucEvaluation::ComputeLiftCurveAt(int nTargetValueIndex, int nPartileNumber, DoubleVector* dvLiftValues)
 {
-	KWClassifierInstanceEvaluation* instanceEvaluation;
-	int nTarget;
+	const KWScoreHistogram* scoreHistogram;
 	double dSizeStep;
 	int nFirstStep;
 	int nLastStep;
 	int nStep;
-	int nInstance;
-	int nTargetValueFrequency;
-	int nCorrectInstanceNumber;
-	int nBlockTrueInstanceNumber;
-	int nBlockFirstInstanceIndex;
-	Continuous cBlockScore;
-	int nModalityIndex;
-	Continuous cScore;
+	int nBin;
+	longint lTotalFrequency;
+	longint lTargetValueFrequency;
+	longint lCorrectInstanceNumber;
+	longint lBlockTrueInstanceNumber;
+	longint lBlockFirstInstanceIndex;
+	longint lBlockLastInstanceIndex;
 	double dLiftValue;
 
-	require(oaInstanceEvaluations != NULL);
+	require(oaScoreHistograms != NULL);
 	require(0 <= nTargetValueIndex and nTargetValueIndex < nTargetValueNumber);
 	require(nPartileNumber > 0);
 
@@ -2094,22 +2344,15 @@ void KWAucEvaluation::ComputeLiftCurveAt(int nTargetValueIndex, int nPartileNumb
 	dSizeStep = 1.0 / nPartileNumber;
 	dvLiftValues->SetSize(nPartileNumber + 1);
 
-	// Tri des scores pour cette modalite
-	SortInstanceEvaluationsAt(nTargetValueIndex);
+	// Acces a l'histogramme des scores pour cette modalite, par scores decroissants
+	scoreHistogram = GetScoreHistogramAt(nTargetValueIndex);
+	lTotalFrequency = scoreHistogram->GetTotalFrequency();
 
 	// Memorisation du nombre d'instances correspondant a cette modalite cible
-	nTargetValueFrequency = 0;
-	for (nInstance = 0; nInstance < oaInstanceEvaluations->GetSize(); nInstance++)
-	{
-		instanceEvaluation = cast(KWClassifierInstanceEvaluation*, oaInstanceEvaluations->GetAt(nInstance));
-		nTarget = instanceEvaluation->GetActualTargetIndex();
-		assert(0 <= nTargetValueIndex and nTargetValueIndex <= GetTargetValueNumber());
-		if (nTarget == nTargetValueIndex)
-			nTargetValueFrequency++;
-	}
+	lTargetValueFrequency = scoreHistogram->GetTotalPositiveFrequency();
 
 	// Cas particulier d'une modalite de frequence nulle
-	if (nTargetValueFrequency == 0)
+	if (lTargetValueFrequency == 0)
 	{
 		for (nStep = 1; nStep < dvLiftValues->GetSize(); nStep++)
 			dvLiftValues->SetAt(nStep, 1);
@@ -2117,82 +2360,55 @@ void KWAucEvaluation::ComputeLiftCurveAt(int nTargetValueIndex, int nPartileNumb
 	// Cas standard
 	else
 	{
-		// Parcours des instances
+		// Parcours des bins, chacun correspondant a un bloc d'instances de meme score
 		// On tiens compte des scores a egalite, pour lisser la courbe de lift et
 		// la rendre independante de l'ordre de presentation des exemples
-		nCorrectInstanceNumber = 0;
-		nBlockTrueInstanceNumber = 0;
-		nBlockFirstInstanceIndex = 0;
-		cBlockScore = 0;
-		for (nInstance = 0; nInstance < oaInstanceEvaluations->GetSize(); nInstance++)
+		lCorrectInstanceNumber = 0;
+		lBlockTrueInstanceNumber = scoreHistogram->GetPositiveFrequencyAt(0);
+		lBlockFirstInstanceIndex = 0;
+		lBlockLastInstanceIndex = scoreHistogram->GetFrequencyAt(0);
+		for (nBin = 1; nBin < scoreHistogram->GetBinNumber(); nBin++)
 		{
-			instanceEvaluation =
-			    cast(KWClassifierInstanceEvaluation*, oaInstanceEvaluations->GetAt(nInstance));
-
-			// Acces aux valeurs
-			cScore = instanceEvaluation->GetTargetProbAt(nTargetValueIndex);
-			nModalityIndex = instanceEvaluation->GetActualTargetIndex();
-
-			// Memorisation de la premiere valeur de lift
-			if (nInstance == 0)
-				cBlockScore = cScore;
+			// Calcul des bornes des index de la courbe de lift inclus dans le bloc precedent
+			nFirstStep = (int)floor((lBlockFirstInstanceIndex * 1.0 / lTotalFrequency) / dSizeStep);
+			nLastStep = (int)ceil((lBlockLastInstanceIndex * 1.0 / lTotalFrequency) / dSizeStep);
 
-			// Test si meme valeur de lift
-			if (cScore == cBlockScore)
-			{
-				// Incrementation du nombre d'instances correctes du bloc
-				if (nModalityIndex == nTargetValueIndex)
-					nBlockTrueInstanceNumber++;
-			}
-			// Sinon, changement de bloc
-			else
+			// Calcul du lift pour les index inclus dans le bloc
+			for (nStep = nFirstStep; nStep <= nLastStep; nStep++)
 			{
-				// Calcul des bornes des index de la courbe de lift inclus dans le bloc
-				nFirstStep = (int)floor(
-				    (nBlockFirstInstanceIndex * 1.0 / oaInstanceEvaluations->GetSize()) / dSizeStep);
-				nLastStep = (int)ceil((nInstance * 1.0 / oaInstanceEvaluations->GetSize()) / dSizeStep);
-
-				// Calcul du lift pour les index inclus dans le bloc
-				for (nStep = nFirstStep; nStep <= nLastStep; nStep++)
+				// Calcul si index completement inclus dans le bloc
+				if (lBlockFirstInstanceIndex <= nStep * dSizeStep * lTotalFrequency and
+				    nStep * dSizeStep * lTotalFrequency <= lBlockLastInstanceIndex)
 				{
-					// Calcul si index completement inclus dans le bloc
-					if (nBlockFirstInstanceIndex <=
-						nStep * dSizeStep * oaInstanceEvaluations->GetSize() and
-					    nStep * dSizeStep * oaInstanceEvaluations->GetSize() <= nInstance)
-					{
-						dLiftValue = (nCorrectInstanceNumber +
-							      (nStep * dSizeStep * oaInstanceEvaluations->GetSize() -
-							       nBlockFirstInstanceIndex) *
-								  nBlockTrueInstanceNumber /
-								  (nInstance - nBlockFirstInstanceIndex)) /
-							     nTargetValueFrequency;
-						assert(0 <= dLiftValue and dLiftValue <= 1);
-						dvLiftValues->SetAt(nStep, dLiftValue);
-					}
+					dLiftValue = (lCorrectInstanceNumber +
+						      (nStep * dSizeStep * lTotalFrequency - lBlockFirstInstanceIndex) *
+							  lBlockTrueInstanceNumber /
+							  (lBlockLastInstanceIndex - lBlockFirstInstanceIndex)) /
+						     lTargetValueFrequency;
+					assert(0 <= dLiftValue and dLiftValue <= 1);
+					dvLiftValues->SetAt(nStep, dLiftValue);
 				}
-
-				// Initialisation d'un nouveau bloc
-				nCorrectInstanceNumber += nBlockTrueInstanceNumber;
-				nBlockTrueInstanceNumber = 0;
-				if (nModalityIndex == nTargetValueIndex)
-					nBlockTrueInstanceNumber++;
-				nBlockFirstInstanceIndex = nInstance;
-				cBlockScore = cScore;
 			}
+
+			// Initialisation d'un nouveau bloc
+			lCorrectInstanceNumber += lBlockTrueInstanceNumber;
+			lBlockTrueInstanceNumber = scoreHistogram->GetPositiveFrequencyAt(nBin);
+			lBlockFirstInstanceIndex = lBlockLastInstanceIndex;
+			lBlockLastInstanceIndex += scoreHistogram->GetFrequencyAt(nBin);
 		}
+		assert(lBlockLastInstanceIndex == lTotalFrequency);
 
 		// Prise en compte de la fin de la courbe de lift, en partant de la fin
 		nStep = nPartileNumber;
 		while (nStep >= 0)
 		{
 			// Calcul si index completement inclus dans le bloc
-			if (nBlockFirstInstanceIndex <= nStep * dSizeStep * oaInstanceEvaluations->GetSize())
+			if (lBlockFirstInstanceIndex <= nStep * dSizeStep * lTotalFrequency)
 			{
-				dLiftValue =
-				    (nCorrectInstanceNumber +
-				     (nStep * dSizeStep * oaInstanceEvaluations->GetSize() - nBlockFirstInstanceIndex) *
-					 nBlockTrueInstanceNumber / (nInstance - nBlockFirstInstanceIndex)) /
-				    nTargetValueFrequency;
+				dLiftValue = (lCorrectInstanceNumber +
+					      (nStep * dSizeStep * lTotalFrequency - lBlockFirstInstanceIndex) *
+						  lBlockTrueInstanceNumber / (lTotalFrequency - lBlockFirstInstanceIndex)) /
+					     lTargetValueFrequency;
 				assert(0 <= dLiftValue and dLiftValue <= 1);
 				dvLiftValues->SetAt(nStep, dLiftValue);
 			}
@@ -2211,278 +2427,423 @@ void KWAucEvaluation::ComputeLiftCurveAt(int nTargetValueIndex, int nPartileNumb
 	}
 }
 
-void KWAucEvaluation::SortInstanceEvaluationsAt(int nTargetValueIndex)
+const KWScoreHistogram* KWAucEvaluation::GetScoreHistogramAt(int nTargetValueIndex) const
 {
-	KWClassifierInstanceEvaluation* instance;
-	int nInstanceIndex;
-
-	require(oaInstanceEvaluations != NULL);
-	require(0 <= nTargetValueIndex and nTargetValueIndex < GetTargetValueNumber());
-
-	// On attribue l'oppose de la proba a la valeur de tri des instances pour un tri decroissant
-	for (nInstanceIndex = 0; nInstanceIndex < oaInstanceEvaluations->GetSize(); nInstanceIndex++)
-	{
-		instance = cast(KWClassifierInstanceEvaluation*, oaInstanceEvaluations->GetAt(nInstanceIndex));
-		instance->SetSortValue(-instance->GetTargetProbAt(nTargetValueIndex));
-	}
-	oaInstanceEvaluations->SetCompareFunction(KWClassifierInstanceEvaluationCompare);
-	oaInstanceEvaluations->Sort();
+	require(oaScoreHistograms != NULL);
+	require(0 <= nTargetValueIndex and nTargetValueIndex < oaScoreHistograms->GetSize());
+	return cast(const KWScoreHistogram*, oaScoreHistograms->GetAt(nTargetValueIndex));
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
-// Classe KWReservoirSampler
+// Classe KWScoreHistogram
 
-KWReservoirSampler::KWReservoirSampler()
+KWScoreHistogram::KWScoreHistogram()
 {
-	lRandomSeed = 0;
-	nCapacity = 0;
-	lSeenObjectNumber = 0;
+	lTotalFrequency = 0;
+	lTotalPositiveFrequency = 0;
+	bIsExact = true;
 }
 
-KWReservoirSampler::~KWReservoirSampler()
-{
-	oaSampledObjects.DeleteAll();
-}
+KWScoreHistogram::~KWScoreHistogram() {}
 
-void KWReservoirSampler::SetCapacity(int nSampleSize)
+void KWScoreHistogram::Initialize()
 {
-	require(nSampleSize >= 0);
-	nCapacity = nSampleSize;
+	cvScores.SetSize(0);
+	lvFrequencies.SetSize(0);
+	lvPositiveFrequencies.SetSize(0);
+	lTotalFrequency = 0;
+	lTotalPositiveFrequency = 0;
+	bIsExact = true;
 }
 
-int KWReservoirSampler::GetCapacity()
+void KWScoreHistogram::BuildFromScores(ContinuousVector* cvPositiveScores, ContinuousVector* cvNegativeScores)
 {
-	return nCapacity;
-}
+	int nPositive;
+	int nNegative;
+	Continuous cPositiveScore;
+	Continuous cNegativeScore;
 
-void KWReservoirSampler::SetSamplerRandomSeed(longint lSomeRandomState)
-{
-	require(lSomeRandomState >= 0);
-	lRandomSeed = lSomeRandomState;
-}
+	require(cvPositiveScores != NULL);
+	require(cvNegativeScores != NULL);
 
-longint KWReservoirSampler::GetSamplerRandomSeed() const
-{
-	return lRandomSeed;
+	// Tri des scores par valeur croissante
+	cvPositiveScores->Sort();
+	cvNegativeScores->Sort();
+
+	// Fusion des deux listes de scores en partant de la fin, pour obtenir des scores decroissants
+	Initialize();
+	nPositive = cvPositiveScores->GetSize() - 1;
+	nNegative = cvNegativeScores->GetSize() - 1;
+	while (nPositive >= 0 or nNegative >= 0)
+	{
+		if (nPositive >= 0)
+			cPositiveScore = cvPositiveScores->GetAt(nPositive);
+		if (nNegative >= 0)
+			cNegativeScore = cvNegativeScores->GetAt(nNegative);
+
+		// Ajout du plus grand score, en privilegiant les positifs en cas d'egalite
+		// (les deux instances sont de toute facon dans le meme bin)
+		if (nNegative < 0 or (nPositive >= 0 and cPositiveScore >= cNegativeScore))
+		{
+			AddBin(cPositiveScore, 1, 1);
+			nPositive--;
+		}
+		else
+		{
+			AddBin(cNegativeScore, 1, 0);
+			nNegative--;
+		}
+	}
+	ensure(Check());
+	ensure(lTotalFrequency == (longint)cvPositiveScores->GetSize() + cvNegativeScores->GetSize());
 }
 
-longint KWReservoirSampler::RandomLongint(longint lMax)
+void KWScoreHistogram::Merge(const KWScoreHistogram* otherHistogram)
 {
-	longint lRightBound;
-	longint lRemainder;
-	longint lRandom;
+	KWScoreHistogram mergedHistogram;
+	int nBin;
+	int nOtherBin;
 
-	require(lMax >= 0);
+	require(otherHistogram != NULL);
+	require(otherHistogram != this);
+	require(Check());
+	require(otherHistogram->Check());
 
-	// Echantillonnage non-biase dans le rang [0, lMax]
-	lRightBound = lMax + 1;
-	lRemainder = LLONG_MAX % lRightBound;
-	lRandom = IthRandomLongint(lRandomSeed++);
-	if (lRandom < 0)
-		lRandom = -lRandom;
-	while (lRandom >= LLONG_MAX - lRemainder)
+	// Cas particulier d'un histogramme vide
+	if (otherHistogram->GetBinNumber() == 0)
+		bIsExact = bIsExact and otherHistogram->bIsExact;
+	else if (GetBinNumber() == 0)
 	{
-		lRandom = IthRandomLongint(lRandomSeed++);
-		if (lRandom < 0)
-			lRandom = -lRandom;
+		bIsExact = bIsExact and otherHistogram->bIsExact;
+		cvScores.CopyFrom(&otherHistogram->cvScores);
+		lvFrequencies.CopyFrom(&otherHistogram->lvFrequencies);
+		lvPositiveFrequencies.CopyFrom(&otherHistogram->lvPositiveFrequencies);
+		lTotalFrequency = otherHistogram->lTotalFrequency;
+		lTotalPositiveFrequency = otherHistogram->lTotalPositiveFrequency;
 	}
-
-	return lRandom % lRightBound;
-}
-
-int KWReservoirSampler::GetSampleSize() const
-{
-	return oaSampledObjects.GetSize();
+	// Cas general: fusion des bins par score decroissant
+	else
+	{
+		nBin = 0;
+		nOtherBin = 0;
+		while (nBin < GetBinNumber() or nOtherBin < otherHistogram->GetBinNumber())
+		{
+			if (nOtherBin == otherHistogram->GetBinNumber() or
+			    (nBin < GetBinNumber() and GetScoreAt(nBin) >= otherHistogram->GetScoreAt(nOtherBin)))
+			{
+				mergedHistogram.AddBin(GetScoreAt(nBin), GetFrequencyAt(nBin),
+						       GetPositiveFrequencyAt(nBin));
+				nBin++;
+			}
+			else
+			{
+				mergedHistogram.AddBin(otherHistogram->GetScoreAt(nOtherBin),
+						       otherHistogram->GetFrequencyAt(nOtherBin),
+						       otherHistogram->GetPositiveFrequencyAt(nOtherBin));
+				nOtherBin++;
+			}
+		}
+		mergedHistogram.bIsExact = bIsExact and otherHistogram->bIsExact;
+		CopyFrom(&mergedHistogram);
+	}
+	ensure(Check());
 }
 
-longint KWReservoirSampler::GetSeenObjectNumber() const
+void KWScoreHistogram::Reduce(int nMaxBinNumber)
 {
-	return lSeenObjectNumber;
-}
+	KWScoreHistogram reducedHistogram;
+	double dMaxBinFrequency;
+	int nBin;
+	int nReducedBin;
+	longint lBinFrequency;
+	longint lBinPositiveFrequency;
 
-Object* KWReservoirSampler::GetSampledObjectAt(int nIndex) const
-{
-	return oaSampledObjects.GetAt(nIndex);
-}
+	require(nMaxBinNumber >= 2);
+	require(Check());
 
-ObjectArray* KWReservoirSampler::GetSampledObjects()
-{
-	return &oaSampledObjects;
+	// Reduction si necessaire
+	if (GetBinNumber() > nMaxBinNumber)
+	{
+		// Effectif max d'un bin fusionne: avec deux fois l'effectif moyen, deux bins fusionnes consecutifs
+		// ont un effectif cumule superieur a ce max, ce qui garantit un nombre de bins d'au plus nMaxBinNumber
+		dMaxBinFrequency = 2.0 * lTotalFrequency / nMaxBinNumber;
+
+		// Fusion des bins adjacents tant que l'effectif cumule ne depasse pas le max
+		// Le score d'un bin fusionne est celui de son premier bin, le plus grand
+		nReducedBin = -1;
+		for (nBin = 0; nBin < GetBinNumber(); nBin++)
+		{
+			lBinFrequency = GetFrequencyAt(nBin);
+			lBinPositiveFrequency = GetPositiveFrequencyAt(nBin);
+			if (nReducedBin >= 0 and
+			    reducedHistogram.lvFrequencies.GetAt(nReducedBin) + lBinFrequency <= dMaxBinFrequency)
+			{
+				reducedHistogram.lvFrequencies.UpgradeAt(nReducedBin, lBinFrequency);
+				reducedHistogram.lvPositiveFrequencies.UpgradeAt(nReducedBin, lBinPositiveFrequency);
+				reducedHistogram.lTotalFrequency += lBinFrequency;
+				reducedHistogram.lTotalPositiveFrequency += lBinPositiveFrequency;
+			}
+			else
+			{
+				reducedHistogram.AddBin(GetScoreAt(nBin), lBinFrequency, lBinPositiveFrequency);
+				nReducedBin++;
+			}
+		}
+		assert(reducedHistogram.GetBinNumber() <= nMaxBinNumber);
+		reducedHistogram.bIsExact = false;
+		CopyFrom(&reducedHistogram);
+	}
+	ensure(GetBinNumber() <= nMaxBinNumber);
+	ensure(Check());
 }
 
-void KWReservoirSampler::Add(Object* object)
+void KWScoreHistogram::AddBin(Continuous cScore, longint lFrequency, longint lPositiveFrequency)
 {
-	longint lRandomIndex;
+	int nLastBin;
 
-	require(object != NULL);
-	require(nCapacity > 0);
-	require(oaSampledObjects.GetSize() <= nCapacity);
-
-	lSeenObjectNumber++;
+	require(lFrequency > 0);
+	require(0 <= lPositiveFrequency and lPositiveFrequency <= lFrequency);
+	require(GetBinNumber() == 0 or cScore <= GetScoreAt(GetBinNumber() - 1));
 
-	// 1) si le reservoir n'est pas rempli, on ajoute une evaluation (nValueIndex == Size)
-	if (oaSampledObjects.GetSize() < nCapacity)
-		oaSampledObjects.Add(object);
-	// 2) sinon, on tire au hasard une position d'insertion (RandomIndex) de la valeur
+	// Mise a jour du dernier bin en cas de score identique
+	nLastBin = GetBinNumber() - 1;
+	if (nLastBin >= 0 and cScore == cvScores.GetAt(nLastBin))
+	{
+		lvFrequencies.UpgradeAt(nLastBin, lFrequency);
+		lvPositiveFrequencies.UpgradeAt(nLastBin, lPositiveFrequency);
+	}
+	// Ajout d'un nouveau bin sinon
 	else
 	{
-		lRandomIndex = RandomLongint(lSeenObjectNumber - 1);
-
-		// 2.a) on memorise l'evaluation si l'index est valide pour le tableau
-		if (lRandomIndex < (longint)nCapacity)
-		{
-			delete oaSampledObjects.GetAt((int)lRandomIndex);
-			oaSampledObjects.SetAt((int)lRandomIndex, object);
-		}
-		// 2.b) sinon, on l'efface
-		else
-			delete object;
+		cvScores.Add(cScore);
+		lvFrequencies.Add(lFrequency);
+		lvPositiveFrequencies.Add(lPositiveFrequency);
 	}
-
-	ensure(oaSampledObjects.GetSize() <= nCapacity);
+	lTotalFrequency += lFrequency;
+	lTotalPositiveFrequency += lPositiveFrequency;
 }
 
-void KWReservoirSampler::AddWithProb(Object* object, double dProb)
+void KWScoreHistogram::CopyFrom(const KWScoreHistogram* sourceHistogram)
 {
-	require(0 <= dProb and dProb <= 1);
+	require(sourceHistogram != NULL);
 
-	if (RandomDouble() <= dProb)
-		Add(object);
+	cvScores.CopyFrom(&sourceHistogram->cvScores);
+	lvFrequencies.CopyFrom(&sourceHistogram->lvFrequencies);
+	lvPositiveFrequencies.CopyFrom(&sourceHistogram->lvPositiveFrequencies);
+	lTotalFrequency = sourceHistogram->lTotalFrequency;
+	lTotalPositiveFrequency = sourceHistogram->lTotalPositiveFrequency;
+	bIsExact = sourceHistogram->bIsExact;
 }
 
-void KWReservoirSampler::AddArray(const ObjectArray* oaObjects)
+longint KWScoreHistogram::GetBinUsedMemory()
 {
-	int nObject;
-
-	require(oaObjects != NULL);
-	require(nCapacity > 0);
-
-	for (nObject = 0; nObject < oaObjects->GetSize(); nObject++)
-		Add(oaObjects->GetAt(nObject));
+	return (longint)sizeof(Continuous) + 2 * sizeof(longint);
 }
 
-void KWReservoirSampler::AddArrayWithProb(const ObjectArray* oaObjects, double dProb)
+boolean KWScoreHistogram::Check() const
 {
-	int nObject;
-
-	require(oaObjects != NULL);
-	require(0.0 <= dProb and dProb <= 1.0);
-	require(nCapacity > 0);
-
-	if (dProb == 1.0)
-		AddArray(oaObjects);
-	else
+	boolean bOk = true;
+	int nBin;
+	longint lCheckedFrequency;
+	longint lCheckedPositiveFrequency;
+
+	// Verification de la coherence des bins
+	bOk = bOk and lvFrequencies.GetSize() == cvScores.GetSize();
+	bOk = bOk and lvPositiveFrequencies.GetSize() == cvScores.GetSize();
+	lCheckedFrequency = 0;
+	lCheckedPositiveFrequency = 0;
+	for (nBin = 0; nBin < cvScores.GetSize() and bOk; nBin++)
 	{
-		for (nObject = 0; nObject < oaObjects->GetSize(); nObject++)
-			AddWithProb(oaObjects->GetAt(nObject), dProb);
+		bOk = bOk and (nBin == 0 or cvScores.GetAt(nBin) < cvScores.GetAt(nBin - 1));
+		bOk = bOk and lvFrequencies.GetAt(nBin) > 0;
+		bOk = bOk and 0 <= lvPositiveFrequencies.GetAt(nBin) and
+		      lvPositiveFrequencies.GetAt(nBin) <= lvFrequencies.GetAt(nBin);
+		lCheckedFrequency += lvFrequencies.GetAt(nBin);
+		lCheckedPositiveFrequency += lvPositiveFrequencies.GetAt(nBin);
 	}
+	bOk = bOk and lCheckedFrequency == lTotalFrequency;
+	bOk = bOk and lCheckedPositiveFrequency == lTotalPositiveFrequency;
+	return bOk;
 }
 
-void KWReservoirSampler::Resample(double dProb)
+longint KWScoreHistogram::GetUsedMemory() const
 {
-	int nRandomSeed;
-	int nObject;
-	Object* object;
-	int nNewSampleSize;
+	return sizeof(KWScoreHistogram) + cvScores.GetUsedMemory() - sizeof(ContinuousVector) +
+	       lvFrequencies.GetUsedMemory() - sizeof(LongintVector) + lvPositiveFrequencies.GetUsedMemory() -
+	       sizeof(LongintVector);
+}
 
-	require(0.0 <= dProb and dProb <= 1.0);
+void KWScoreHistogram::Write(ostream& ost) const
+{
+	int nBin;
 
-	// On n'agit que dans les cas non triviaux
-	if (GetSampleSize() > 0 and dProb < 1.0)
+	ost << GetClassLabel() << "\t" << GetTotalFrequency() << "\t" << GetTotalPositiveFrequency() << "\t"
+	    << (IsExact() ? "exact" : "reduced") << "\n";
+	ost << "Score\tFrequency\tPositive\n";
+	for (nBin = 0; nBin < GetBinNumber(); nBin++)
+		ost << GetScoreAt(nBin) << "\t" << GetFrequencyAt(nBin) << "\t" << GetPositiveFrequencyAt(nBin) << "\n";
+}
+
+const ALString KWScoreHistogram::GetClassLabel() const
+{
+	return "Score histogram";
+}
+
+void KWScoreHistogram::Test()
+{
+	const int nInstanceNumber = 2000;
+	const int nScoreValueNumber = 50;
+	const int nPartNumber = 4;
+	ContinuousVector cvAllScores;
+	IntVector ivAllPositives;
+	ContinuousVector cvPositiveScores;
+	ContinuousVector cvNegativeScores;
+	KWScoreHistogram globalHistogram;
+	KWScoreHistogram mergedHistogram;
+	KWScoreHistogram partHistogram;
+	ObjectArray oaHistograms;
+	KWAucEvaluation aucEvaluation;
+	DoubleVector dvLiftValues;
+	double dPairScore;
+	longint lPairNumber;
+	int nInstance;
+	int nOtherInstance;
+	int nPart;
+	int nMaxBinNumber;
+
+	// Creation d'instances ayant des scores avec beaucoup d'ex-aequo, et une cible
+	// d'autant plus souvent positive que le score est eleve
+	SetRandomSeed(1);
+	for (nInstance = 0; nInstance < nInstanceNumber; nInstance++)
 	{
-		// Estimation de la taille esperee apres echantillonnage
-		nNewSampleSize = int(ceil(dProb * GetSampleSize()));
+		cvAllScores.Add((Continuous)RandomInt(nScoreValueNumber - 1) / nScoreValueNumber);
+		ivAllPositives.Add(RandomDouble() < cvAllScores.GetAt(nInstance) ? 1 : 0);
+	}
 
-		// Si la taille espere est plus petite alors on procede au reechantillonnage
-		if (nNewSampleSize < GetSampleSize())
+	// Calcul de reference de l'AUC par comptage des paires (positive, negative) bien ordonnees,
+	// les ex-aequo comptant pour moitie
+	dPairScore = 0;
+	lPairNumber = 0;
+	for (nInstance = 0; nInstance < nInstanceNumber; nInstance++)
+	{
+		if (ivAllPositives.GetAt(nInstance) == 1)
 		{
-			// Randomisation de l'echantillon
-			nRandomSeed = GetRandomSeed();
-			SetRandomSeed(int(GetSamplerRandomSeed() % INT_MAX));
-			oaSampledObjects.Shuffle();
-			SetRandomSeed(nRandomSeed);
-
-			// Retaillage du tableau d'echantillonnage a la taille esperee
-			for (nObject = nNewSampleSize; nObject < GetSampleSize(); nObject++)
+			for (nOtherInstance = 0; nOtherInstance < nInstanceNumber; nOtherInstance++)
 			{
-				object = oaSampledObjects.GetAt(nObject);
-				delete object;
+				if (ivAllPositives.GetAt(nOtherInstance) == 0)
+				{
+					lPairNumber++;
+					if (cvAllScores.GetAt(nInstance) > cvAllScores.GetAt(nOtherInstance))
+						dPairScore += 1;
+					else if (cvAllScores.GetAt(nInstance) == cvAllScores.GetAt(nOtherInstance))
+						dPairScore += 0.5;
+				}
 			}
-			oaSampledObjects.SetSize(nNewSampleSize);
 		}
 	}
-}
+	cout << "Reference AUC\t" << dPairScore / lPairNumber << endl;
 
-void KWReservoirSampler::RemoveAll()
-{
-	oaSampledObjects.RemoveAll();
-	lSeenObjectNumber = 0;
-}
-
-void KWReservoirSampler::DeleteAll()
-{
-	oaSampledObjects.DeleteAll();
-	lSeenObjectNumber = 0;
-}
+	// Histogramme global
+	for (nInstance = 0; nInstance < nInstanceNumber; nInstance++)
+	{
+		if (ivAllPositives.GetAt(nInstance) == 1)
+			cvPositiveScores.Add(cvAllScores.GetAt(nInstance));
+		else
+			cvNegativeScores.Add(cvAllScores.GetAt(nInstance));
+	}
+	globalHistogram.BuildFromScores(&cvPositiveScores, &cvNegativeScores);
+	cout << "Global histogram bins\t" << globalHistogram.GetBinNumber() << endl;
 
-boolean KWReservoirSampler::IsOverflowed()
-{
-	return (lSeenObjectNumber > (longint)nCapacity);
-}
+	// Histogramme obtenu par fusion d'histogrammes construits sur des parties des instances
+	for (nPart = 0; nPart < nPartNumber; nPart++)
+	{
+		cvPositiveScores.SetSize(0);
+		cvNegativeScores.SetSize(0);
+		for (nInstance = nPart; nInstance < nInstanceNumber; nInstance += nPartNumber)
+		{
+			if (ivAllPositives.GetAt(nInstance) == 1)
+				cvPositiveScores.Add(cvAllScores.GetAt(nInstance));
+			else
+				cvNegativeScores.Add(cvAllScores.GetAt(nInstance));
+		}
+		partHistogram.BuildFromScores(&cvPositiveScores, &cvNegativeScores);
+		mergedHistogram.Merge(&partHistogram);
+	}
+	cout << "Merged histogram bins\t" << mergedHistogram.GetBinNumber() << endl;
 
-const ALString KWReservoirSampler::GetClassLabel() const
-{
-	return "Reservoir Sampler";
+	// Calcul de l'AUC et du lift a partir de l'histogramme fusionne, puis avec des histogrammes reduits
+	oaHistograms.Add(&mergedHistogram);
+	aucEvaluation.SetTargetValueNumber(1);
+	aucEvaluation.SetScoreHistograms(&oaHistograms);
+	for (nMaxBinNumber = 64; nMaxBinNumber >= 2; nMaxBinNumber /= 4)
+	{
+		mergedHistogram.Reduce(nMaxBinNumber);
+		aucEvaluation.ComputeLiftCurveAt(0, 10, &dvLiftValues);
+		cout << "Max bins\t" << nMaxBinNumber << "\tBins\t" << mergedHistogram.GetBinNumber() << "\tExact\t"
+		     << BooleanToString(mergedHistogram.IsExact()) << "\tAUC\t" << aucEvaluation.ComputeAUCValueAt(0)
+		     << "\tLift at 10%\t" << dvLiftValues.GetAt(1) << "\tLift at 50%\t" << dvLiftValues.GetAt(5)
+		     << endl;
+	}
+	cout << mergedHistogram << endl;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
-// Classe PLShared_ClassifierInstanceEvaluation
+// Classe PLShared_ScoreHistogram
+
+PLShared_ScoreHistogram::PLShared_ScoreHistogram() {}
 
-PLShared_ClassifierInstanceEvaluation::PLShared_ClassifierInstanceEvaluation() {}
+PLShared_ScoreHistogram::~PLShared_ScoreHistogram() {}
 
-PLShared_ClassifierInstanceEvaluation::~PLShared_ClassifierInstanceEvaluation() {}
-void PLShared_ClassifierInstanceEvaluation::SetClassifierInstanceEvaluation(KWClassifierInstanceEvaluation* evaluation)
+void PLShared_ScoreHistogram::SetScoreHistogram(KWScoreHistogram* histogram)
 {
-	require(evaluation != NULL);
-	SetObject(evaluation);
+	require(histogram != NULL);
+	SetObject(histogram);
 }
 
-KWClassifierInstanceEvaluation* PLShared_ClassifierInstanceEvaluation::GetClassifierInstanceEvaluation()
+KWScoreHistogram* PLShared_ScoreHistogram::GetScoreHistogram()
 {
-	return cast(KWClassifierInstanceEvaluation*, GetObject());
+	return cast(KWScoreHistogram*, GetObject());
 }
 
-void PLShared_ClassifierInstanceEvaluation::SerializeObject(PLSerializer* serializer, const Object* object) const
+void PLShared_ScoreHistogram::SerializeObject(PLSerializer* serializer, const Object* object) const
 {
-	KWClassifierInstanceEvaluation* evaluation;
-	PLShared_ContinuousVector scvHelper;
+	KWScoreHistogram* histogram;
+	PLShared_ContinuousVector sharedVector;
 
 	require(serializer != NULL);
 	require(serializer->IsOpenForWrite());
 	require(object != NULL);
 
-	// Serialisation du nombre de modalites cibles, l'index de la reelle et les probas de chacune
-	evaluation = cast(KWClassifierInstanceEvaluation*, object);
-	scvHelper.SerializeObject(serializer, &(evaluation->cvTargetProbs));
-	serializer->PutInt(evaluation->GetActualTargetIndex());
+	// Serialisation des bins et des effectifs totaux
+	histogram = cast(KWScoreHistogram*, object);
+	sharedVector.SerializeObject(serializer, &histogram->cvScores);
+	serializer->PutLongintVector(&histogram->lvFrequencies);
+	serializer->PutLongintVector(&histogram->lvPositiveFrequencies);
+	serializer->PutLongint(histogram->lTotalFrequency);
+	serializer->PutLongint(histogram->lTotalPositiveFrequency);
+	serializer->PutBoolean(histogram->bIsExact);
 }
 
-void PLShared_ClassifierInstanceEvaluation::DeserializeObject(PLSerializer* serializer, Object* oObject) const
+void PLShared_ScoreHistogram::DeserializeObject(PLSerializer* serializer, Object* object) const
 {
-	KWClassifierInstanceEvaluation* evaluation;
-	PLShared_ContinuousVector scvHelper;
+	KWScoreHistogram* histogram;
+	PLShared_ContinuousVector sharedVector;
 
 	require(serializer != NULL);
 	require(serializer->IsOpenForRead());
-	require(oObject != NULL);
+	require(object != NULL);
 
-	// Deserialisation du nombre de modalites cibles, l'index de la reelle et les probas de chacune
-	evaluation = cast(KWClassifierInstanceEvaluation*, oObject);
-	scvHelper.DeserializeObject(serializer, &(evaluation->cvTargetProbs));
-	evaluation->SetActualTargetIndex(serializer->GetInt());
+	// Deserialisation des bins et des effectifs totaux
+	histogram = cast(KWScoreHistogram*, object);
+	sharedVector.DeserializeObject(serializer, &histogram->cvScores);
+	serializer->GetLongintVector(&histogram->lvFrequencies);
+	serializer->GetLongintVector(&histogram->lvPositiveFrequencies);
+	histogram->lTotalFrequency = serializer->GetLongint();
+	histogram->lTotalPositiveFrequency = serializer->GetLongint();
+	histogram->bIsExact = serializer->GetBoolean();
 }
 
-Object* PLShared_ClassifierInstanceEvaluation::Create() const
+Object* PLShared_ScoreHistogram::Create() const
 {
-	return new KWClassifierInstanceEvaluation;
+	return new KWScoreHistogram;
 }
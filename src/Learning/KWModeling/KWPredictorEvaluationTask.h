@@ -9,9 +9,8 @@ class KWClassifierEvaluationTask;
 class KWRegressorEvaluationTask;
 class KWConfusionMatrixEvaluation;
 class KWAucEvaluation;
-class KWClassifierInstanceEvaluation;
-class KWReservoirSampler;
-class PLShared_ClassifierInstanceEvaluation;
+class KWScoreHistogram;
+class PLShared_ScoreHistogram;
 
 #include "KWPredictor.h"
 #include "KWPredictorEvaluation.h"
@@ -19,9 +18,13 @@ class PLShared_ClassifierInstanceEvaluation;
 #include "KWDatabaseTask.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
-// Tache parallele d'evaluation d'un predicteur sur une base de donnees
+// Tache parallele d'evaluation d'un ou plusieurs predicteurs sur une base de donnees
 // Classe algorithmique de service, dont les resultats sont destine a alimenter
 // un rapports d'evaluation (cf hierarchie de classe de KWPredictorEvaluation)
+//
+// Plusieurs predicteurs peuvent etre evalues en une seule lecture de la base, a partir d'une classe
+// d'evaluation comportant les attributs de tous les predicteurs: chaque enregistrement lu est
+// alors evalue pour tous les predicteurs, dont les resultats sont accumules separement
 class KWPredictorEvaluationTask : public KWDatabaseTask
 {
 public:
@@ -34,6 +37,14 @@ public:
 	virtual boolean Evaluate(KWPredictor* predictor, KWDatabase* database,
 				 KWPredictorEvaluation* predictorEvaluation);
 
+	// Evaluation de plusieurs predicteurs sur une base, en une seule lecture de la base
+	// La base est parametree par une classe d'evaluation du domaine courant, comportant les attributs de
+	// tous les predicteurs: les attributs natifs y sont communs, et les attributs derives de chaque
+	// predicteur y sont renommes avec le prefixe associe au predicteur (vide pour le premier)
+	// Stockage des resultats sur les objets mandataires KWPredictorEvaluation, un par predicteur
+	virtual boolean EvaluatePredictors(const ObjectArray* oaPredictors, const StringVector* svAttributePrefixes,
+					   KWDatabase* database, const ObjectArray* oaEvaluations);
+
 	// Libelles
 	const ALString GetClassLabel() const override;
 	const ALString GetObjectLabel() const override;
@@ -41,14 +52,21 @@ public:
 	//////////////////////////////////////////////////////////////////////////////
 	///// Implementation
 protected:
-	// Initialisation et nettoyage des informations du predicteurs necessaires pour l'evaluation
+	// Initialisation et nettoyage des informations des predicteurs necessaires pour l'evaluation
+	// L'initialisation est appelee successivement pour chaque predicteur, dans l'ordre des predicteurs
 	// Cettes variables sont partagees entre le maitre et les esclaves
-	virtual void InitializePredictorSharedVariables(KWPredictor* predictor);
+	virtual void InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor);
 	virtual void CleanPredictorSharedVariables();
 
-	// Calcul de l'index de chargement (LoadIndex) d'un attribut
+	// Nombre de predicteurs evalues, accessible dans le maitre et dans les esclaves
+	int GetPredictorNumber() const;
+
+	// Acces a l'objet d'evaluation d'un predicteur, dans le maitre
+	KWPredictorEvaluation* GetPredictorEvaluationAt(int nPredictor) const;
+
+	// Calcul de l'index de chargement (LoadIndex) d'un attribut d'un predicteur dans la classe d'evaluation
 	// Renvoie un index invalide si l'attribut est NULL (non obligatoire)
-	KWLoadIndex GetLoadIndex(KWAttribute* predictionAttribute) const;
+	KWLoadIndex GetLoadIndex(int nPredictor, const KWAttribute* predictionAttribute) const;
 
 	// Reimplementation des etapes du DatabaseTask (methodes virtuelles)
 	const ALString GetTaskName() const override;
@@ -56,12 +74,22 @@ protected:
 	boolean MasterAggregateResults() override;
 	boolean MasterFinalize(boolean bProcessEndedCorrectly) override;
 
-	// Objet d'evaluation demandeur de la tache et ou l'on stocke les resultats
-	KWPredictorEvaluation* predictorEvaluation;
+	// Objets d'evaluation demandeurs de la tache et ou l'on stocke les resultats, un par predicteur
+	ObjectArray oaPredictorEvaluations;
+
+	// Classe d'evaluation, et prefixes des attributs derives de chaque predicteur dans cette classe
+	const KWClass* kwcEvaluationClass;
+	StringVector svPredictorAttributePrefixes;
+
+	// Nombre de predicteurs evalues
+	PLShared_Int shared_nPredictorNumber;
+
+	// Acces au nom de la tache, pour regrouper les predicteurs evaluables par la meme tache
+	friend class KWPredictorEvaluation;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
-// Tache parallele d'evaluation d'un classifieur sur une base de donnees
+// Tache parallele d'evaluation d'un ou plusieurs classifieurs sur une base de donnees
 class KWClassifierEvaluationTask : public KWPredictorEvaluationTask
 {
 public:
@@ -82,27 +110,29 @@ protected:
 	// ses versions locaux a chaque esclave et ensuite les aggreger dans le maitre.
 	// Dans la finalisation la plupart des indicateurs s'en deduissent de la matrice de confusion.
 	//
-	// Pour l'AUC et les courbes de lift, la situation est un peu plus delicate car il faut avoir
-	// l'integralite des evaluation d'instances pour pouvoir la calculer.
-	// Si la base de donnes a une grande taille cela peut entrainer des soucis de memoire
-	// et donc la paralellisation n'est pas trivial comme dans les cas precedantes.
+	// Pour l'AUC et les courbes de lift, il faut en principe disposer de l'integralite des evaluations
+	// d'instances, triees par score. Plutot que de collecter ces evaluations, on exploite le fait que
+	// l'AUC et les courbes de lift ne dependent que de l'histogramme des scores de chaque valeur cible,
+	// avec par score distinct son effectif d'instances et son effectif d'instances positives (cf. KWScoreHistogram).
+	// Ces histogrammes sont fusionnables de facon exacte, comme la matrice de confusion.
 	//
-	// Donc, pour calculer l'AUC et les courbes dans chaque esclave on utilise un reservoir sampler et
-	// dans chaque sous-tache on reenvoie:
-	//    - L'echantillon de KWClassifierEvaluationInstance
-	//    - Le nombre d'objets vus et la taille de l'echantillon
-	// Le reservoir est reintialise a chaque sous-tache
+	// Dans chaque esclave, on collecte dans des buffers les scores des instances positives et negatives
+	// de chaque valeur cible. Quand les buffers sont pleins, ils sont compactes en histogrammes, fusionnes
+	// avec ceux de la sous-tache. Dans chaque sous-tache, on renvoie un histogramme par valeur cible.
 	//
-	// Le maitre pour sa part a egalement un reservoir sampler, mais aussi un taux d'echantillonnage.
-	// Ce taux est intialement a 1 et :
-	//   - Si l'esclave a echantillonne avec un taux plus petit que celui du maitre alors il
-	//     reechantillone avec proba (proba esclave)/(proba maitre) et il rajoute l'integralite de
-	//     l'echantillon de l'esclave
-	//   - Si l'esclave a echantillonne avec un taux plus grande que celui du maitre alors il ajoute
-	//     l'echantillon de l'esclave avec proba (proba maitre)/(proba esclave)
+	// Le maitre fusionne les histogrammes des esclaves dans l'ordre des sous-taches, pour obtenir
+	// des resultats identiques en sequentiel et en parallele.
 	//
-	// A la fin, la collection (echantillonne ou non) de KWClassifierEvaluationInstance s'utilise pour
-	// estimer l'AUC et les courbes de lift du classifieur
+	// Le nombre de bins des histogrammes est borne en fonction de la memoire disponible. En cas de
+	// depassement, des bins adjacents sont fusionnes: leurs instances sont alors traitees comme des
+	// ex-aequo, ce qui donne une approximation de l'AUC et des courbes de lift. Sinon, le calcul est exact,
+	// sur l'ensemble des instances.
+	//
+	// En cas d'evaluation de plusieurs classifieurs, chacun dispose de sa matrice de confusion et de
+	// son taux de compression. Les valeurs cibles de tous les classifieurs sont concatenees: les probabilites,
+	// buffers de scores et histogrammes sont indexes globalement, a partir de l'index de la premiere valeur
+	// cible de chaque classifieur (cf. ivTargetValueOffsets). La memoire des histogrammes et des buffers
+	// est repartie selon le nombre total de valeurs cibles.
 
 	// Reimplementation des methodes virtuelles (en gros les etapes) de DatabaseTask
 	const ALString GetTaskName() const override;
@@ -117,75 +147,79 @@ protected:
 	boolean SlaveProcessExploitDatabaseObject(const KWObject* kwoObject) override;
 	boolean SlaveFinalize(boolean bProcessEndedCorrectly) override;
 
-	// Initialisation des variables de travail lies au predicteur
-	void InitializePredictorSharedVariables(KWPredictor* predictor) override;
+	// Initialisation des variables de travail lies a un predicteur
+	void InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor) override;
 
-	// Nettoyage des variables de travail lies au predicteur
+	// Nettoyage des variables de travail lies aux predicteurs
 	void CleanPredictorSharedVariables() override;
 
+	// Calcul des index de la premiere valeur cible de chaque classifieur, a partir des variables partagees
+	void ComputeTargetValueOffsets();
+
+	// Nombre total de valeurs cibles, sur l'ensemble des classifieurs
+	int GetTotalTargetValueNumber() const;
+
 	// Index de la courbe de lift de la modalite cible principale dans le tableau des courbes de lift
 	// TODO: Elle est necessaire, mais je soupconne que ca peut se simplifier
-	int GetMainTargetModalityLiftIndex() const;
+	int GetMainTargetModalityLiftIndex(const KWClassifierEvaluation* evaluation) const;
 
 	// Nombre de valeurs cibles pour lequelles la courbe de lift a ete calculee
 	// La modalite cible principale si specifiee est toujours calculee
-	int GetComputedLiftCurveNumber() const;
+	int GetComputedLiftCurveNumber(const KWClassifierEvaluation* evaluation) const;
 
 	// Index de valeur cible du predicteur pour un index de courbe de lift
-	int GetPredictorTargetIndexAtLiftCurveIndex(int nLiftCurveIndex) const;
+	int GetPredictorTargetIndexAtLiftCurveIndex(const KWClassifierEvaluation* evaluation,
+						    int nLiftCurveIndex) const;
+
+	// Calcul du nombre max de bins par histogramme de scores en fonction de la memoire disponible
+	int ComputeMaxScoreBinNumber(longint lMemory, int nTargetValueNumber) const;
 
-	// Calcul de la capacite d'un echantillonneur en fonction de la memoire disponible
-	int ComputeSamplerCapacity(longint lMemory, int nTargetValueNumber) const;
+	// Calcul de la capacite des buffers de scores d'un esclave en fonction de la memoire disponible
+	int ComputeScoreBufferCapacity(longint lMemory, int nTargetValueNumber) const;
 
 	// Calcul de la memoire attribuee exclusivement a la tache (exclue celle de la classe ancetre)
 	longint ComputeTaskSelfMemory(longint lTaskGrantedMemory, RMPhysicalResource* taskMemoryRequirement,
 				      RMPhysicalResource* parentTaskMemoryRequirement) const;
 
-	// Calcul de la taille memoire d'une evaluation d'instance
+	// Calcul de la taille memoire des histogrammes de scores par instance, dans le pire cas ou tous les
+	// scores sont distincts
 	longint ComputeInstanceEvaluationNecessaryMemory(int nTargetValueNumber) const;
 
-	// Mise a jour de l'echantillonneur du maitre
-	void MasterAggregateResultsUpdateSampler();
+	// Fusion des histogrammes de scores d'une sous-tache avec ceux du maitre
+	void MasterAggregateResultsMergeScoreHistograms();
+
+	// Compactage des buffers de scores de l'esclave dans ses histogrammes de scores
+	void SlaveFlushScoreBuffers();
 
 	// Nombre max de valeurs cible pour lesquelles on evalue la courbe de lift
 	static const int nMaxLiftEvaluationNumber = 100;
 
-	// Reference a l'objet mandataire de l'evaluation: les resultats sont stockes ici
-	KWClassifierEvaluation* classifierEvaluation;
+	// Index de la premiere valeur cible de chaque classifieur dans les tableaux indexes globalement
+	// par valeur cible, avec en derniere position le nombre total de valeurs cibles
+	IntVector ivTargetValueOffsets;
 
 	//////////////////////////////////////////////////////////////////////////////
 	// Variables du maitre
 
-	// Service d'evaluation des matrices de confusion du maitre (global)
-	KWConfusionMatrixEvaluation* masterConfMatrixEvaluation;
-
-	// Services d'evaluation de l'AUC et des courbes de lift
-	KWAucEvaluation* masterAucEvaluation;
+	// Services d'evaluation des matrices de confusion du maitre (global), par classifieur
+	ObjectArray oaMasterConfMatrixEvaluations;
 
-	// Echantilloneur d'instances d'evaluation du maitre (pour le calcul de l'AUC)
-	// Attention, la taille du reservoir (Capacity) est correcte, mais le nombre d'objet traites (SeenObjectNumber)
-	// peut etre inferieur au nombre total d'objet vues par les esclaves, si un de ceux-ci a sature
-	KWReservoirSampler* masterInstanceEvaluationSampler;
+	// Histogrammes de scores du maitre, par valeur cible (pour le calcul de l'AUC)
+	ObjectArray oaMasterScoreHistograms;
 
-	// Probabilite d'echantillonnage utilise dans le reservoir du maitre, qui peut etre struictement inferieure a 1
-	// si un esclave passe etait sature, et que le maitre l'a integre sans toutefois remplir entierement son
-	// propre reservoir: il garde alors une proba strictement inferieure a 1, bien que n'etant pas plein
-	double dMasterSamplingProb;
-
-	// Tableau des echantillons des esclaves (contiennent des tableaux de KWClassifierInstanceEvaluation).
+	// Tableau des histogrammes de scores des esclaves (contient des tableaux de KWScoreHistogram).
 	// Il est indexe par le index de sous-tache (GetTaskIndex()). Il est necessaire pour parcourir les
 	// sorties de sous-taches dans le meme ordre en sequentiel et ainsi qu'en parallele. Pour ce-faire
-	// on accumule les echantillons des esclaves de maniere provisoire dans ce tableau (dans la
-	// position donnee par GetTaskIndex()) et on les ajoute a l'echantillon du maitre au fur et a
+	// on accumule les histogrammes des esclaves de maniere provisoire dans ce tableau (dans la
+	// position donnee par GetTaskIndex()) et on les fusionne avec ceux du maitre au fur et a
 	// mesure que l'on peut faire dans l'ordre de sous-taches.
-	// NB: La probabilite que ce tableau soit rempli est negligeable (eg. la sous-tache 0 ne retourne jamais)
-	ObjectArray oaAllInstanceEvaluationSamples;
+	ObjectArray oaAllSlaveScoreHistograms;
 
-	// Nombre total d'objets vus pour la constitution des echantillons de chaque esclave
-	LongintVector lvSeenInstanceEvaluationNumberPerSample;
+	// Indice des prochains histogrammes issus d'un esclave a fusionner avec ceux du maitre
+	int nCurrentSlaveScoreHistograms;
 
-	// Indice du prochain echantillon issu d'un esclave a ajouter a l'echantillon du maitre
-	int nCurrentSample;
+	// Nombre max de bins des histogrammes de scores du maitre
+	int nMasterMaxScoreBinNumber;
 
 	// Indique si la tache calcule l'AUC
 	boolean bIsAucEvaluated;
@@ -197,11 +231,22 @@ protected:
 	//////////////////////////////////////////////////////////////////////////////
 	// Variables de l'esclave
 
-	// Echantilloneur d'instances d'evaluation du esclaves (pour le calcul de l'AUC)
-	KWReservoirSampler* slaveInstanceEvaluationSampler;
+	// Histogrammes de scores de l'esclave pour la sous-tache en cours, par valeur cible
+	ObjectArray oaSlaveScoreHistograms;
+
+	// Buffers des scores des instances positives et negatives de l'esclave, par valeur cible
+	// (tableaux de ContinuousVector)
+	ObjectArray oaSlavePositiveScores;
+	ObjectArray oaSlaveNegativeScores;
+
+	// Nombre d'instances dont les scores sont dans les buffers
+	int nSlaveBufferedScoreNumber;
+
+	// Services d'evaluation des matrices de confusion des esclaves (local), par classifieur
+	ObjectArray oaSlaveConfMatrixEvaluations;
 
-	// Service d'evaluation des matrices de confusion des esclaves (local)
-	KWConfusionMatrixEvaluation* slaveConfusionMatrixEvaluation;
+	// Taux de compression de l'esclave pour la sous-tache en cours, par classifieur
+	DoubleVector dvSlaveCompressionRates;
 
 	//////////////////////////////////////////////////////////////////////////////
 	// Inputs et outputs des esclaves
@@ -209,42 +254,42 @@ protected:
 	// Signale a l'esclave s'il doit collecter les evaluation d'instances pour le calcul d'AUC
 	PLShared_Boolean input_bIsAucEvaluated;
 
-	// Matrice de confusion de sortie d'un esclave sous forme de DataGridStat
-	PLShared_DataGridStats output_confusionMatrix;
+	// Matrices de confusion de sortie d'un esclave sous forme de DataGridStat, par classifieur
+	PLShared_ObjectArray* output_oaConfusionMatrices;
 
-	// Ratio de compression de sortie d'un esclave
-	PLShared_Double output_dCompressionRate;
+	// Ratios de compression de sortie d'un esclave, par classifieur
+	PLShared_DoubleVector output_dvCompressionRates;
 
-	// Instances d'evaluation de l'esclave. Potentiellement sous-echantillonees
-	PLShared_ObjectArray* output_oaInstanceEvaluationSample;
-
-	// Nombre d'instances d'evaluation vus par l'esclave dans la sous-tache
-	PLShared_Longint output_lSeenInstanceEvaluationNumber;
+	// Histogrammes de scores de l'esclave, par valeur cible
+	PLShared_ObjectArray* output_oaScoreHistograms;
 
 	//////////////////////////////////////////////////////////////////////////////
 	// Variables partagees
 
-	// Index de chargement du attribut cible
+	// Index de chargement du attribut cible, commun a tous les classifieurs
 	PLShared_LoadIndex shared_liTargetAttribute;
 
-	// Index de chargement du attribut de prediction
-	PLShared_LoadIndex shared_liPredictionAttribute;
+	// Index de chargement des attributs de prediction, par classifieur
+	PLShared_LoadIndexVector shared_livPredictionAttributes;
 
-	// Index de chargement des probabilites
+	// Index de chargement des probabilites, par valeur cible
 	PLShared_LoadIndexVector shared_livProbAttributes;
 
-	// Nombre de valeurs/modalites predites du attribut cible
-	PLShared_Int shared_nTargetValueNumber;
+	// Nombre de valeurs/modalites predites du attribut cible, par classifieur
+	PLShared_IntVector shared_ivTargetValueNumbers;
 
-	// Modalites predites du attribut cible
+	// Modalites predites du attribut cible, par valeur cible
 	PLShared_SymbolVector shared_svPredictedModalities;
 
-	// Taille maximale du tableau d'instances d'evaluation du esclave
-	PLShared_Int shared_nSlaveInstanceEvaluationCapacity;
+	// Nombre max de bins des histogrammes de scores de l'esclave
+	PLShared_Int shared_nSlaveMaxScoreBinNumber;
+
+	// Capacite des buffers de scores de l'esclave, en nombre d'instances
+	PLShared_Int shared_nSlaveScoreBufferCapacity;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
-// Tache parallele d'evaluation d'un regresseur sur une base de donnees
+// Tache parallele d'evaluation d'un ou plusieurs regresseurs sur une base de donnees
 class KWRegressorEvaluationTask : public KWPredictorEvaluationTask
 {
 public:
@@ -262,6 +307,9 @@ protected:
 	// Le seul critere non associatif est la courbe de REC. Pour la calculer on prends
 	// une mesure plus simple que pour le calcul d'AUC d'un classifieur :
 	// Si on depasse la capacite on ne la calcule pas.
+	//
+	// En cas d'evaluation de plusieurs regresseurs, les criteres sont accumules par regresseur, et
+	// la capacite de collecte des erreurs pour les courbes de REC est partagee entre les regresseurs.
 
 	// Implementation des methodes virtuelles de DatabaseTask
 	const ALString GetTaskName() const override;
@@ -276,12 +324,12 @@ protected:
 	boolean SlaveProcessExploitDatabaseObject(const KWObject* kwoObject) override;
 	boolean SlaveFinalize(boolean bProcessEndedCorrectly) override;
 
-	// Initialisation et nettoyage des variables de travail liees au prediteur
-	void InitializePredictorSharedVariables(KWPredictor* predictor) override;
+	// Initialisation et nettoyage des variables de travail liees aux predicteurs
+	void InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor) override;
 	void CleanPredictorSharedVariables() override;
 
-	// Objet mandataire de la tache
-	KWRegressorEvaluation* regressorEvaluation;
+	// Nombre total d'erreurs de rang collectees dans un tableau de DoubleVector
+	int GetTotalRankAbsoluteErrorNumber(const ObjectArray* oaRankAbsoluteErrors) const;
 
 	/////////////////////////////////////////////////////////
 	// Variables du maitre
@@ -289,31 +337,52 @@ protected:
 	// Indique si la tache calcule la courbe de REC
 	boolean bIsRecCurveCalculated;
 
-	// Vecteur d'erreurs du maitre
-	DoubleVector dvRankAbsoluteErrors;
+	// Vecteurs d'erreurs du maitre, par regresseur
+	ObjectArray oaMasterRankAbsoluteErrors;
 
 	// Capacite maximale du vecteur d'erreurs, cote maitre et cote esclave
 	int nMasterErrorVectorMaxCapacity;
 	int nSlaveErrorVectorMaxCapacity;
 
-	// Parametres partages
-	PLShared_LoadIndex shared_liTargetAttribute;
-	PLShared_LoadIndex shared_liMeanAttribute;
-	PLShared_LoadIndex shared_liDensityAttribute;
-	PLShared_LoadIndex shared_liTargetRankAttribute;
-	PLShared_LoadIndex shared_liMeanRankAttribute;
-	PLShared_LoadIndex shared_liRankDensityAttribute;
+	/////////////////////////////////////////////////////////
+	// Variables de l'esclave
+
+	// Criteres de l'esclave pour la sous-tache en cours, par regresseur
+	IntVector ivSlaveTargetMissingValueNumbers;
+	DoubleVector dvSlaveRMSE;
+	DoubleVector dvSlaveMAE;
+	DoubleVector dvSlaveNLPD;
+	DoubleVector dvSlaveRankRMSE;
+	DoubleVector dvSlaveRankMAE;
+	DoubleVector dvSlaveRankNLPD;
+
+	// Vecteurs d'erreurs de l'esclave pour la sous-tache en cours, par regresseur
+	ObjectArray oaSlaveRankAbsoluteErrors;
 
-	// Variables en entre et sortie des esclaves
+	// Nombre total d'erreurs collectees par l'esclave pour la sous-tache en cours
+	int nSlaveRankAbsoluteErrorNumber;
+
+	// Parametres partages: index de chargement de l'attribut cible, commun a tous les regresseurs,
+	// et des attributs de prediction, par regresseur
+	PLShared_LoadIndex shared_liTargetAttribute;
+	PLShared_LoadIndexVector shared_livMeanAttributes;
+	PLShared_LoadIndexVector shared_livDensityAttributes;
+	PLShared_LoadIndexVector shared_livTargetRankAttributes;
+	PLShared_LoadIndexVector shared_livMeanRankAttributes;
+	PLShared_LoadIndexVector shared_livRankDensityAttributes;
+
+	// Variables en entre et sortie des esclaves, les criteres etant par regresseur
+	// Les erreurs de rang de tous les regresseurs sont concatenees, avec leur nombre par regresseur
 	PLShared_Boolean input_bIsRecCurveCalculated;
-	PLShared_Int output_nTargetMissingValueNumber;
-	PLShared_Double output_dRMSE;
-	PLShared_Double output_dMAE;
-	PLShared_Double output_dNLPD;
-	PLShared_Double output_dRankRMSE;
-	PLShared_Double output_dRankMAE;
-	PLShared_Double output_dRankNLPD;
+	PLShared_IntVector output_ivTargetMissingValueNumbers;
+	PLShared_DoubleVector output_dvRMSE;
+	PLShared_DoubleVector output_dvMAE;
+	PLShared_DoubleVector output_dvNLPD;
+	PLShared_DoubleVector output_dvRankRMSE;
+	PLShared_DoubleVector output_dvRankMAE;
+	PLShared_DoubleVector output_dvRankNLPD;
 	PLShared_DoubleVector output_dvRankAbsoluteErrors;
+	PLShared_IntVector output_ivRankAbsoluteErrorNumbers;
 	PLShared_Boolean output_bIsRecCurveVectorOverflowed;
 	PLShared_Int output_nSlaveCapacityOverflowSize;
 };
@@ -416,9 +485,9 @@ public:
 	// Acces au nombre de valeurs cibles
 	int GetTargetValueNumber() const;
 
-	// Memorisation de l'addresse du tableau d'instances d'evaluation
+	// Memorisation de l'addresse du tableau des histogrammes de scores (KWScoreHistogram), par valeur cible
 	// Memoire: Responsabilite de l'appelant
-	void SetInstanceEvaluations(ObjectArray* oaEvaluations);
+	void SetScoreHistograms(const ObjectArray* oaHistograms);
 
 	// Evaluation globale de l'AUC du predicteur sur l'ensemble des modalites
 	// Utilisation de la methode precedante en ponderant par la frequence de chaque modalite cible
@@ -427,7 +496,6 @@ public:
 	double ComputeGlobalAUCValue();
 
 	// Evaluation du predicteur par la surface sous la courbe de ROC
-	// En effet de bord, le tableau des scores est trie
 	double ComputeAUCValueAt(int nTargetValueIndex);
 
 	// Calcul de la courbe de lift pour une modalite cible donnee
@@ -439,180 +507,136 @@ public:
 	//////////////////////////////////////////////////////////////////////////////
 	//// Implementation
 protected:
-	// Tri des evaluations selon les score d'une modalites cible
-	void SortInstanceEvaluationsAt(int nTargetValueIndex);
+	// Acces a l'histogramme des scores d'une valeur cible
+	const KWScoreHistogram* GetScoreHistogramAt(int nTargetValueIndex) const;
 
 	// Nombre de valeurs cible
 	int nTargetValueNumber;
 
-	// Tableau d'evaluations (KWClassifierEvaluationInstance)
-	ObjectArray* oaInstanceEvaluations;
-
-	// Epsilon pour gerer le probleme de precision numerique
-	static double dEpsilon;
+	// Tableau des histogrammes de scores (KWScoreHistogram)
+	const ObjectArray* oaScoreHistograms;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
-// Evaluation d'une instance
-// Contient la classe reelle et le vecteur de probas conditionnelles aux classes
-class KWClassifierInstanceEvaluation : public Object
+// Histogramme des scores d'une valeur cible, pour le calcul de l'AUC et des courbes de lift
+// Chaque bin correspond a un score distinct, avec son effectif d'instances et son effectif d'instances
+// positives (dont la valeur cible reelle est celle du score). Les bins sont tries par score decroissant.
+// Les histogrammes sont fusionnables: l'histogramme d'un ensemble d'instances s'obtient exactement par
+// fusion des histogrammes de ses parties, quel que soit leur decoupage.
+// Pour borner la memoire, on peut reduire le nombre de bins en fusionnant des bins adjacents. Les instances
+// d'un bin fusionne sont alors traitees comme des ex-aequo, comme celles de meme score
+class KWScoreHistogram : public Object
 {
 public:
 	// Constructeur
-	KWClassifierInstanceEvaluation();
-	~KWClassifierInstanceEvaluation();
-
-	// Parametrage du nombre de valeurs/modalites cibles (et reinitialisation)
-	void SetTargetValueNumber(int nValue);
-	int GetTargetValueNumber() const;
-
-	// Parametrage d'un index de valeur cible "reel"
-	// On parametre une valeur non vue en apprentissage en utilisant TargetValueNumber comme index
-	void SetActualTargetIndex(int nActualTargetIndex);
-	int GetActualTargetIndex();
-
-	// Parametrage d'une probabilite de valeur cible
-	// ccepte un score non necessairement compris entre 0 et 1 pour ranker les instances
-	void SetTargetProbAt(int nTargetIndex, Continuous cProb);
-	Continuous GetTargetProbAt(int nTargetIndex) const;
+	KWScoreHistogram();
+	~KWScoreHistogram();
 
-	// Parametrage d'une valeur de tri
-	void SetSortValue(Continuous cValue);
-	Continuous GetSortValue() const;
-
-protected:
-	// Index de la valeur cible reel
-	int nActualTargetIndex;
-
-	// Vecteur des probabilites des valeurs de la cible
-	ContinuousVector cvTargetProbs;
-
-	// Valeur de tri
-	Continuous cSortValue;
-
-	// La version partagee de cette classe est completement liee a l'implementation
-	friend class PLShared_ClassifierInstanceEvaluation;
-
-	// Fonction auxilier pour trier des tableaux d'evaluations d'instances
-	friend int KWClassifierInstanceEvaluationCompare(const void* elem1, const void* elem2);
-};
-
-/////////////////////////////////////////////////////////////////////////////////////////////////////
-// Echantillonneur uniforme en ligne d'objets avec taille maximale
-// Implementation via la methode de "Reservoir Sampling" (Vitter, 1985)
-class KWReservoirSampler : public Object
-{
-public:
-	// Constructeur
-	KWReservoirSampler();
-	~KWReservoirSampler();
+	// Reinitialisation a un histogramme vide et exact
+	void Initialize();
 
-	// Parametrage de la capacite maximale de l'echantillon
-	void SetCapacity(int nCapacity);
-	int GetCapacity();
+	// Construction a partir des scores des instances positives et negatives
+	// Les vecteurs en parametre sont tries en effet de bord
+	void BuildFromScores(ContinuousVector* cvPositiveScores, ContinuousVector* cvNegativeScores);
 
-	// Parametrage de la graine du RNG
-	void SetSamplerRandomSeed(longint lNewRandomSeed);
-	longint GetSamplerRandomSeed() const;
+	// Fusion avec un autre histogramme
+	void Merge(const KWScoreHistogram* otherHistogram);
 
-	// Nombre d'objets echantillonnes
-	int GetSampleSize() const;
+	// Reduction du nombre de bins a un nombre maximum, par fusion de bins adjacents d'effectifs cumules
+	// au plus egaux a deux fois l'effectif moyen d'un bin (ou a un seul bin initial)
+	// Sans effet si le nombre de bins ne depasse pas le max
+	void Reduce(int nMaxBinNumber);
 
-	// Nombre d'objets vus
-	longint GetSeenObjectNumber() const;
+	// Indique si l'histogramme est exact, c'est a dire sans reduction de bins, y compris
+	// pour les histogrammes fusionnes
+	boolean IsExact() const;
 
-	// Acces aux objets echantillonees
-	// Memoire: Responsabilite de l'appele
-	Object* GetSampledObjectAt(int nIndex) const;
-	ObjectArray* GetSampledObjects();
+	// Acces aux bins, par score decroissant
+	int GetBinNumber() const;
+	Continuous GetScoreAt(int nBin) const;
+	longint GetFrequencyAt(int nBin) const;
+	longint GetPositiveFrequencyAt(int nBin) const;
 
-	// Ajout d'un objet a l'echantillon
-	// Si l'echantillon est sature alors l'objet est ajoute au hasard de facon que
-	// la collection finale est un echantillon uniforme et independant des objets vus
-	// Dans le cas que l'objet n'est pas ajoute alors il est detruit
-	// Memoire: Responsabilite de l'appele
-	void Add(Object* object);
-	void AddWithProb(Object* object, double dProb);
+	// Effectifs totaux
+	longint GetTotalFrequency() const;
+	longint GetTotalPositiveFrequency() const;
 
-	// Ajout d'un tableau d'objets a l'echantillon
-	// Memoire: Responsabilite de l'appele (objets potentiellement detruits)
-	void AddArray(const ObjectArray* objects);
-	void AddArrayWithProb(const ObjectArray* objects, double dProb);
+	// Copie
+	void CopyFrom(const KWScoreHistogram* sourceHistogram);
 
-	// Reechantillonnage de l'echantillon avec une probabilite donnee
-	void Resample(double dProb);
+	// Memoire utilisee par bin
+	static longint GetBinUsedMemory();
 
-	// Elimination de toutes les references aux objets echantillones (ne libere pas la memoire)
-	void RemoveAll();
+	// Verification de l'integrite
+	boolean Check() const override;
 
-	// Destruction de tous les objets echantillones
-	void DeleteAll();
+	// Memoire utilisee
+	longint GetUsedMemory() const override;
 
-	// Status d'overflow du reservoir: true si l'on a vu plus d'objets que la capacite maximale
-	boolean IsOverflowed();
+	// Affichage
+	void Write(ostream& ost) const override;
 
 	// Libelle de la classe
 	const ALString GetClassLabel() const override;
 
+	// Methode de test
+	static void Test();
+
 	//////////////////////////////////////////////////////////////////////////////
 	//// Implementation
 protected:
-	// Longint pseudo-aleatoire entre 0 et lMax
-	longint RandomLongint(longint lMax);
+	// Ajout d'un bin en fin d'histogramme, ou mise a jour du dernier bin s'il a le meme score
+	void AddBin(Continuous cScore, longint lFrequency, longint lPositiveFrequency);
 
-	// Nombre maximal d'objects dans le tableau
-	int nCapacity;
+	// Bins de l'histogramme
+	ContinuousVector cvScores;
+	LongintVector lvFrequencies;
+	LongintVector lvPositiveFrequencies;
 
-	// Graine du RNG
-	longint lRandomSeed;
+	// Effectifs totaux
+	longint lTotalFrequency;
+	longint lTotalPositiveFrequency;
 
-	// Nombre total d'objets vus
-	longint lSeenObjectNumber;
+	// Indicateur d'histogramme exact
+	boolean bIsExact;
 
-	// Echantillon
-	ObjectArray oaSampledObjects;
+	// La version partagee de cette classe est completement liee a l'implementation
+	friend class PLShared_ScoreHistogram;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
-// Classe PLShared_ClassifierInstanceEvaluation
-// Serialisation de la classe KWClassifierEvaluationInstance
-class PLShared_ClassifierInstanceEvaluation : public PLSharedObject
+// Classe PLShared_ScoreHistogram
+// Serialisation de la classe KWScoreHistogram
+class PLShared_ScoreHistogram : public PLSharedObject
 {
 public:
 	// Constructor
-	PLShared_ClassifierInstanceEvaluation();
-	~PLShared_ClassifierInstanceEvaluation();
+	PLShared_ScoreHistogram();
+	~PLShared_ScoreHistogram();
 
-	// Sauvegarde d'un ClassifierEvaluationInstance
-	void SetClassifierInstanceEvaluation(KWClassifierInstanceEvaluation* evaluation);
+	// Acces a l'histogramme
+	void SetScoreHistogram(KWScoreHistogram* histogram);
+	KWScoreHistogram* GetScoreHistogram();
 
-	// Obtient le CleanPredictorSharedVariables enveloppe
-	KWClassifierInstanceEvaluation* GetClassifierInstanceEvaluation();
-
-	// Serialisation d'un ClassifierEvaluationInstance (reimplementation)
+	// Reimplementation des methodes virtuelles
 	void SerializeObject(PLSerializer* serializer, const Object* o) const override;
-
-	// Deserialisation d'un ClassifierEvaluationInstance (reimplementation)
 	void DeserializeObject(PLSerializer* serializer, Object* o) const override;
 
 protected:
-	// Wrapper generique du constructeur de ClassifierEvaluationInstance
 	Object* Create() const override;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 // Methodes en inline
 
-inline KWLoadIndex KWPredictorEvaluationTask::GetLoadIndex(KWAttribute* attribute) const
+inline int KWPredictorEvaluationTask::GetPredictorNumber() const
 {
-	KWLoadIndex liInvalid;
-
-	require(attribute == NULL or (attribute->GetLoaded() and attribute->GetLoadIndex().IsValid()));
+	return shared_nPredictorNumber;
+}
 
-	if (attribute != NULL)
-		return attribute->GetLoadIndex();
-	else
-		return liInvalid;
+inline int KWClassifierEvaluationTask::GetTotalTargetValueNumber() const
+{
+	return shared_svPredictedModalities.GetSize();
 }
 
 inline void KWAucEvaluation::SetTargetValueNumber(int nValue)
@@ -626,55 +650,37 @@ inline int KWAucEvaluation::GetTargetValueNumber() const
 	return nTargetValueNumber;
 }
 
-inline KWClassifierInstanceEvaluation::KWClassifierInstanceEvaluation()
-{
-	cSortValue = 0;
-	nActualTargetIndex = 0;
-}
-
-inline KWClassifierInstanceEvaluation::~KWClassifierInstanceEvaluation() {}
-
-inline void KWClassifierInstanceEvaluation::SetTargetValueNumber(int nValue)
-{
-	require(nValue >= 0);
-	cvTargetProbs.SetSize(nValue);
-	cvTargetProbs.Initialize();
-	nActualTargetIndex = 0;
-}
-
-inline int KWClassifierInstanceEvaluation::GetTargetValueNumber() const
+inline boolean KWScoreHistogram::IsExact() const
 {
-	return cvTargetProbs.GetSize();
+	return bIsExact;
 }
 
-inline void KWClassifierInstanceEvaluation::SetActualTargetIndex(int nTargetIndex)
+inline int KWScoreHistogram::GetBinNumber() const
 {
-	require(0 <= nTargetIndex and nTargetIndex < GetTargetValueNumber() + 1);
-	nActualTargetIndex = nTargetIndex;
+	return cvScores.GetSize();
 }
 
-inline int KWClassifierInstanceEvaluation::GetActualTargetIndex()
+inline Continuous KWScoreHistogram::GetScoreAt(int nBin) const
 {
-	return nActualTargetIndex;
+	return cvScores.GetAt(nBin);
 }
 
-inline void KWClassifierInstanceEvaluation::SetTargetProbAt(int nTargetIndex, Continuous cProb)
+inline longint KWScoreHistogram::GetFrequencyAt(int nBin) const
 {
-	require(0 <= nTargetIndex and nTargetIndex < GetTargetValueNumber());
-	cvTargetProbs.SetAt(nTargetIndex, cProb);
+	return lvFrequencies.GetAt(nBin);
 }
 
-inline Continuous KWClassifierInstanceEvaluation::GetTargetProbAt(int nTargetIndex) const
+inline longint KWScoreHistogram::GetPositiveFrequencyAt(int nBin) const
 {
-	return cvTargetProbs.GetAt(nTargetIndex);
+	return lvPositiveFrequencies.GetAt(nBin);
 }
 
-inline void KWClassifierInstanceEvaluation::SetSortValue(Continuous cValue)
+inline longint KWScoreHistogram::GetTotalFrequency() const
 {
-	cSortValue = cValue;
+	return lTotalFrequency;
 }
 
-inline Continuous KWClassifierInstanceEvaluation::GetSortValue() const
+inline longint KWScoreHistogram::GetTotalPositiveFrequency() const
 {
-	return cSortValue;
+	return lTotalPositiveFrequency;
 }
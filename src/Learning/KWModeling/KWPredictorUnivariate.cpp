@@ -85,12 +85,11 @@ const ALString& KWPredictorUnivariate::GetAttributeName() const
 	return sAttributeName;
 }
 
-KWPredictorEvaluation* KWPredictorUnivariate::Evaluate(KWDatabase* database)
+KWPredictorEvaluation* KWPredictorUnivariate::CreatePredictorEvaluation() const
 {
 	KWPredictorEvaluation* predictorEvaluation;
 
 	require(IsTrained());
-	require(database != NULL);
 
 	// Creation des resultats d'evaluation selon le type de predicteur
 	if (GetTargetAttributeType() == KWType::Symbol)
@@ -106,9 +105,6 @@ KWPredictorEvaluation* KWPredictorUnivariate::Evaluate(KWDatabase* database)
 		assert(GetTargetAttributeType() == KWType::None);
 		predictorEvaluation = new KWPredictorEvaluation;
 	}
-
-	// Evaluation
-	predictorEvaluation->Evaluate(this, database);
 	return predictorEvaluation;
 }
 
@@ -439,7 +435,7 @@ void KWClassifierUnivariateEvaluation::InitializeCriteria()
 	dgsEvaluationResults.DeleteAll();
 }
 
-void KWClassifierUnivariateEvaluation::Evaluate(KWPredictor* predictor, KWDatabase* database)
+void KWClassifierUnivariateEvaluation::PrepareEvaluation(KWPredictor* predictor, KWDatabase* database)
 {
 	KWPredictorUnivariate* univariatePredictor;
 
@@ -451,7 +447,7 @@ void KWClassifierUnivariateEvaluation::Evaluate(KWPredictor* predictor, KWDataba
 	dgsEvaluationResults.InitializeEvaluation(univariatePredictor);
 
 	// Appel a la methode ancetre
-	KWClassifierEvaluation::Evaluate(predictor, database);
+	KWClassifierEvaluation::PrepareEvaluation(predictor, database);
 }
 
 KWDataGridStats* KWClassifierUnivariateEvaluation::GetEvaluatedDataGridStats()
@@ -505,7 +501,7 @@ void KWRegressorUnivariateEvaluation::InitializeCriteria()
 	dgsEvaluationResults.DeleteAll();
 }
 
-void KWRegressorUnivariateEvaluation::Evaluate(KWPredictor* predictor, KWDatabase* database)
+void KWRegressorUnivariateEvaluation::PrepareEvaluation(KWPredictor* predictor, KWDatabase* database)
 {
 	KWPredictorUnivariate* univariatePredictor;
 
@@ -517,7 +513,7 @@ void KWRegressorUnivariateEvaluation::Evaluate(KWPredictor* predictor, KWDatabas
 	dgsEvaluationResults.InitializeEvaluation(univariatePredictor);
 
 	// Appel a la methode ancetre
-	KWRegressorEvaluation::Evaluate(predictor, database);
+	KWRegressorEvaluation::PrepareEvaluation(predictor, database);
 }
 
 KWDataGridStats* KWRegressorUnivariateEvaluation::GetEvaluatedDataGridStats()
@@ -955,15 +951,24 @@ boolean KWEvaluatedDataGrid::Check() const
 
 KWClassifierUnivariateEvaluationTask::KWClassifierUnivariateEvaluationTask()
 {
-	classifierUnivariateEvaluation = NULL;
-
 	// Declaration des variables partagees
-	DeclareTaskOutput(&output_slaveDataGridEvaluation);
+	output_oaSlaveDataGridEvaluations = new PLShared_ObjectArray(new PLShared_DataGridStats);
+	DeclareTaskOutput(output_oaSlaveDataGridEvaluations);
 	DeclareSharedParameter(&shared_livDataGridAttributes);
-	DeclareSharedParameter(&shared_classifierDataGridStats);
+	DeclareSharedParameter(&shared_ivDataGridAttributeNumbers);
+	shared_oaClassifierDataGridStats = new PLShared_ObjectArray(new PLShared_DataGridStats);
+	DeclareSharedParameter(shared_oaClassifierDataGridStats);
 }
 
-KWClassifierUnivariateEvaluationTask::~KWClassifierUnivariateEvaluationTask() {}
+KWClassifierUnivariateEvaluationTask::~KWClassifierUnivariateEvaluationTask()
+{
+	assert(oaMasterDataGridEvaluations.GetSize() == 0);
+	assert(oaSlaveDataGridEvaluations.GetSize() == 0);
+
+	// Nettoyage des tableaux partages (forces a etre en reference)
+	delete output_oaSlaveDataGridEvaluations;
+	delete shared_oaClassifierDataGridStats;
+}
 
 const ALString KWClassifierUnivariateEvaluationTask::GetTaskName() const
 {
@@ -979,17 +984,26 @@ boolean KWClassifierUnivariateEvaluationTask::ComputeResourceRequirements()
 {
 	boolean bOk;
 	longint lMemory;
+	KWDataGridStats* dataGridStats;
 	KWDataGrid dgHelper;
+	int nPredictor;
 
-	require(shared_classifierDataGridStats.GetDataGridStats() != NULL);
+	require(shared_oaClassifierDataGridStats->GetObjectArray()->GetSize() == GetPredictorNumber());
 
 	// Appel a la methode ancetre
 	bOk = KWClassifierEvaluationTask::ComputeResourceRequirements();
 
-	// A partir de la grille du regresseur on estime les tailles des grilles de travail et de message
-	dgHelper.ImportDataGridStats(shared_classifierDataGridStats.GetDataGridStats());
-	lMemory = shared_classifierDataGridStats.GetDataGridStats()->GetUsedMemory();
-	lMemory += dgHelper.GetUsedMemory();
+	// A partir des grilles des predicteurs on estime les tailles des grilles de travail et de message
+	lMemory = 0;
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		dataGridStats =
+		    cast(KWDataGridStats*, shared_oaClassifierDataGridStats->GetObjectArray()->GetAt(nPredictor));
+		dgHelper.ImportDataGridStats(dataGridStats);
+		lMemory += dataGridStats->GetUsedMemory();
+		lMemory += dgHelper.GetUsedMemory();
+		dgHelper.DeleteAll();
+	}
 
 	// On ajoute une de chacune au maitre es esclave
 	GetResourceRequirements()->GetMasterRequirement()->GetMemory()->UpgradeMin(lMemory);
@@ -1002,89 +1016,152 @@ boolean KWClassifierUnivariateEvaluationTask::ComputeResourceRequirements()
 boolean KWClassifierUnivariateEvaluationTask::MasterInitialize()
 {
 	boolean bOk;
+	int nPredictor;
+	KWDataGridEvaluation* masterDataGridEvaluation;
 
-	require(predictorEvaluation != NULL);
-	require(classifierUnivariateEvaluation == NULL);
+	require(oaPredictorEvaluations.GetSize() == GetPredictorNumber());
+	require(oaMasterDataGridEvaluations.GetSize() == 0);
 
 	// Appel a la methode ancetre
 	bOk = KWClassifierEvaluationTask::MasterInitialize();
 
-	// Vue de KWClassifierUnivariateEvaluation du rapport d'evaluation demandeur
-	classifierUnivariateEvaluation = cast(KWClassifierUnivariateEvaluation*, predictorEvaluation);
-
-	// Initialisation du service d'evaluation via DataGrid du maitre
-	masterDataGridEvaluation.SetPredictorDataGridStats(shared_classifierDataGridStats.GetDataGridStats());
-	masterDataGridEvaluation.SetDataGridAttributeLoadIndexes(
-	    shared_livDataGridAttributes.GetConstLoadIndexVector());
-	masterDataGridEvaluation.Initialize();
+	// Initialisation des services d'evaluation via DataGrid du maitre
+	BuildDataGridAttributeLoadIndexes(&oaMasterDataGridAttributeLoadIndexes);
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		masterDataGridEvaluation = new KWDataGridEvaluation;
+		masterDataGridEvaluation->SetPredictorDataGridStats(
+		    cast(KWDataGridStats*, shared_oaClassifierDataGridStats->GetObjectArray()->GetAt(nPredictor)));
+		masterDataGridEvaluation->SetDataGridAttributeLoadIndexes(
+		    cast(KWLoadIndexVector*, oaMasterDataGridAttributeLoadIndexes.GetAt(nPredictor)));
+		masterDataGridEvaluation->Initialize();
+		oaMasterDataGridEvaluations.Add(masterDataGridEvaluation);
+	}
 	return bOk;
 }
 
 boolean KWClassifierUnivariateEvaluationTask::MasterAggregateResults()
 {
 	boolean bOk;
+	int nPredictor;
+
+	require(output_oaSlaveDataGridEvaluations->GetObjectArray()->GetSize() == GetPredictorNumber());
 
 	// Appel a la methode ancetre
 	bOk = KWClassifierEvaluationTask::MasterAggregateResults();
 
-	masterDataGridEvaluation.AddEvaluatedDataGridStats(output_slaveDataGridEvaluation.GetDataGridStats());
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		cast(KWDataGridEvaluation*, oaMasterDataGridEvaluations.GetAt(nPredictor))
+		    ->AddEvaluatedDataGridStats(
+			cast(KWDataGridStats*, output_oaSlaveDataGridEvaluations->GetObjectArray()->GetAt(nPredictor)));
+	output_oaSlaveDataGridEvaluations->GetObjectArray()->DeleteAll();
 	return bOk;
 }
 
 boolean KWClassifierUnivariateEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly)
 {
 	boolean bOk;
+	int nPredictor;
+	KWDataGridEvaluation* masterDataGridEvaluation;
+	KWClassifierUnivariateEvaluation* classifierUnivariateEvaluation;
 
 	// Appel a la methode ancetre
 	bOk = KWClassifierEvaluationTask::MasterFinalize(bProcessEndedCorrectly);
 
-	// Finalisation et trasfert de l'evaluation a l'objet du rapport
-	masterDataGridEvaluation.Finalize();
-	classifierUnivariateEvaluation->dgsEvaluationResults.CopyFrom(
-	    masterDataGridEvaluation.GetEvaluatedDataGridStats());
+	// Finalisation et transfert des evaluations aux objets du rapport
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		masterDataGridEvaluation = cast(KWDataGridEvaluation*, oaMasterDataGridEvaluations.GetAt(nPredictor));
+		classifierUnivariateEvaluation =
+		    cast(KWClassifierUnivariateEvaluation*, GetPredictorEvaluationAt(nPredictor));
+		masterDataGridEvaluation->Finalize();
+		classifierUnivariateEvaluation->dgsEvaluationResults.CopyFrom(
+		    masterDataGridEvaluation->GetEvaluatedDataGridStats());
+	}
+
+	// Nettoyage
+	oaMasterDataGridEvaluations.DeleteAll();
+	oaMasterDataGridAttributeLoadIndexes.DeleteAll();
 	return bOk;
 }
 
 boolean KWClassifierUnivariateEvaluationTask::SlaveInitialize()
 {
 	boolean bOk;
+	int nPredictor;
+	KWDataGridEvaluation* slaveDataGridEvaluation;
+
+	require(oaSlaveDataGridEvaluations.GetSize() == 0);
 
 	// Appel a la methode ancetre
 	bOk = KWClassifierEvaluationTask::SlaveInitialize();
 
-	slaveDataGridEvaluation.SetPredictorDataGridStats(shared_classifierDataGridStats.GetDataGridStats());
-	slaveDataGridEvaluation.SetDataGridAttributeLoadIndexes(shared_livDataGridAttributes.GetConstLoadIndexVector());
+	// Initialisation des services d'evaluation via DataGrid de l'esclave
+	BuildDataGridAttributeLoadIndexes(&oaSlaveDataGridAttributeLoadIndexes);
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		slaveDataGridEvaluation = new KWDataGridEvaluation;
+		slaveDataGridEvaluation->SetPredictorDataGridStats(
+		    cast(KWDataGridStats*, shared_oaClassifierDataGridStats->GetObjectArray()->GetAt(nPredictor)));
+		slaveDataGridEvaluation->SetDataGridAttributeLoadIndexes(
+		    cast(KWLoadIndexVector*, oaSlaveDataGridAttributeLoadIndexes.GetAt(nPredictor)));
+		oaSlaveDataGridEvaluations.Add(slaveDataGridEvaluation);
+	}
 	return bOk;
 }
 
 boolean KWClassifierUnivariateEvaluationTask::SlaveProcessExploitDatabase()
 {
 	boolean bOk;
+	int nPredictor;
+	KWDataGridEvaluation* slaveDataGridEvaluation;
+	KWDataGridStats* slaveDataGridStats;
 
-	output_slaveDataGridEvaluation.GetDataGridStats()->DeleteAllCells();
-	slaveDataGridEvaluation.Initialize();
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		cast(KWDataGridEvaluation*, oaSlaveDataGridEvaluations.GetAt(nPredictor))->Initialize();
 
 	// Appel a la methode ancetre
 	bOk = KWClassifierEvaluationTask::SlaveProcessExploitDatabase();
 
-	slaveDataGridEvaluation.Finalize();
-	output_slaveDataGridEvaluation.GetDataGridStats()->CopyFrom(
-	    slaveDataGridEvaluation.GetEvaluatedDataGridStats());
+	output_oaSlaveDataGridEvaluations->GetObjectArray()->DeleteAll();
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		slaveDataGridEvaluation = cast(KWDataGridEvaluation*, oaSlaveDataGridEvaluations.GetAt(nPredictor));
+		slaveDataGridEvaluation->Finalize();
+		slaveDataGridStats = new KWDataGridStats;
+		slaveDataGridStats->CopyFrom(slaveDataGridEvaluation->GetEvaluatedDataGridStats());
+		output_oaSlaveDataGridEvaluations->GetObjectArray()->Add(slaveDataGridStats);
+	}
 	return bOk;
 }
 
 boolean KWClassifierUnivariateEvaluationTask::SlaveProcessExploitDatabaseObject(const KWObject* databaseObject)
 {
 	boolean bOk;
+	int nPredictor;
 
+	// Appel a la methode ancetre
 	bOk = KWClassifierEvaluationTask::SlaveProcessExploitDatabaseObject(databaseObject);
 
-	slaveDataGridEvaluation.AddInstance(databaseObject);
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		cast(KWDataGridEvaluation*, oaSlaveDataGridEvaluations.GetAt(nPredictor))->AddInstance(databaseObject);
+	return bOk;
+}
 
+boolean KWClassifierUnivariateEvaluationTask::SlaveFinalize(boolean bProcessEndedCorrectly)
+{
+	boolean bOk;
+
+	// Appel a la methode ancetre
+	bOk = KWClassifierEvaluationTask::SlaveFinalize(bProcessEndedCorrectly);
+
+	// Nettoyage
+	oaSlaveDataGridEvaluations.DeleteAll();
+	oaSlaveDataGridAttributeLoadIndexes.DeleteAll();
 	return bOk;
 }
 
-void KWClassifierUnivariateEvaluationTask::InitializePredictorSharedVariables(KWPredictor* predictor)
+void KWClassifierUnivariateEvaluationTask::InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor)
 {
 	int i;
 	KWPredictorUnivariate* predictorUnivariate;
@@ -1092,34 +1169,66 @@ void KWClassifierUnivariateEvaluationTask::InitializePredictorSharedVariables(KW
 	KWClass* predictorClass;
 	KWAttribute* predictorAttribute;
 
+	require(shared_ivDataGridAttributeNumbers.GetSize() == nPredictor);
+
 	// Appel a la methode ancetre
-	KWClassifierEvaluationTask::InitializePredictorSharedVariables(predictor);
+	KWClassifierEvaluationTask::InitializePredictorSharedVariables(nPredictor, predictor);
 
 	// Vue de KWPredictorUnivariate du predicteur demandeur
 	predictorUnivariate = cast(KWPredictorUnivariate*, predictor);
 	predictorDataGridStats = predictorUnivariate->GetTrainDataGridStats();
 	predictorClass = predictorUnivariate->GetTrainedPredictor()->GetPredictorClass();
 
-	// Sauvegarde des indices de chargement des attributes du predicteur
-	shared_livDataGridAttributes.SetSize(predictorDataGridStats->GetAttributeNumber());
+	// Sauvegarde des indices de chargement des attributes du predicteur dans la classe d'evaluation
+	shared_ivDataGridAttributeNumbers.Add(predictorDataGridStats->GetAttributeNumber());
 	for (i = 0; i < predictorDataGridStats->GetAttributeNumber(); i++)
 	{
-		// Recherche de l'index de l'attribut dans le dictionnaire du predicteur
+		// Recherche de l'attribut dans le dictionnaire du predicteur
 		predictorAttribute =
 		    predictorClass->LookupAttribute(predictorDataGridStats->GetAttributeAt(i)->GetAttributeName());
 		assert(predictorAttribute != NULL);
-		assert(predictorAttribute->GetLoadIndex().IsValid());
-		shared_livDataGridAttributes.SetAt(i, predictorAttribute->GetLoadIndex());
+		shared_livDataGridAttributes.GetLoadIndexVector()->Add(GetLoadIndex(nPredictor, predictorAttribute));
 	}
 
 	// Sauvegarde de la grille des donnees d'apprentissage du predicteur
-	shared_classifierDataGridStats.SetDataGridStats(predictorUnivariate->GetTrainDataGridStats()->Clone());
+	shared_oaClassifierDataGridStats->GetObjectArray()->Add(predictorDataGridStats->Clone());
 }
 
 void KWClassifierUnivariateEvaluationTask::CleanPredictorSharedVariables()
 {
+	// Appel a la methode ancetre
+	KWClassifierEvaluationTask::CleanPredictorSharedVariables();
+
 	shared_livDataGridAttributes.SetSize(0);
-	shared_classifierDataGridStats.GetDataGridStats()->DeleteAll();
+	shared_ivDataGridAttributeNumbers.GetIntVector()->SetSize(0);
+	shared_oaClassifierDataGridStats->GetObjectArray()->DeleteAll();
+}
+
+void KWClassifierUnivariateEvaluationTask::BuildDataGridAttributeLoadIndexes(
+    ObjectArray* oaDataGridAttributeLoadIndexes) const
+{
+	int nPredictor;
+	int nAttribute;
+	int nDataGridAttribute;
+	KWLoadIndexVector* livAttributes;
+
+	require(oaDataGridAttributeLoadIndexes != NULL);
+	require(oaDataGridAttributeLoadIndexes->GetSize() == 0);
+	require(shared_ivDataGridAttributeNumbers.GetSize() == GetPredictorNumber());
+
+	// Decoupage des index concatenes, par predicteur
+	nDataGridAttribute = 0;
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		livAttributes = new KWLoadIndexVector;
+		for (nAttribute = 0; nAttribute < shared_ivDataGridAttributeNumbers.GetAt(nPredictor); nAttribute++)
+		{
+			livAttributes->Add(shared_livDataGridAttributes.GetAt(nDataGridAttribute));
+			nDataGridAttribute++;
+		}
+		oaDataGridAttributeLoadIndexes->Add(livAttributes);
+	}
+	ensure(nDataGridAttribute == shared_livDataGridAttributes.GetSize());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1127,15 +1236,24 @@ void KWClassifierUnivariateEvaluationTask::CleanPredictorSharedVariables()
 
 KWRegressorUnivariateEvaluationTask::KWRegressorUnivariateEvaluationTask()
 {
-	regressorUnivariateEvaluation = NULL;
-
 	// Declaration des variables partagees
-	DeclareTaskOutput(&output_slaveDataGridEvaluation);
+	output_oaSlaveDataGridEvaluations = new PLShared_ObjectArray(new PLShared_DataGridStats);
+	DeclareTaskOutput(output_oaSlaveDataGridEvaluations);
 	DeclareSharedParameter(&shared_livDataGridAttributes);
-	DeclareSharedParameter(&shared_regressorDataGridStats);
+	DeclareSharedParameter(&shared_ivDataGridAttributeNumbers);
+	shared_oaRegressorDataGridStats = new PLShared_ObjectArray(new PLShared_DataGridStats);
+	DeclareSharedParameter(shared_oaRegressorDataGridStats);
 }
 
-KWRegressorUnivariateEvaluationTask::~KWRegressorUnivariateEvaluationTask() {}
+KWRegressorUnivariateEvaluationTask::~KWRegressorUnivariateEvaluationTask()
+{
+	assert(oaMasterDataGridEvaluations.GetSize() == 0);
+	assert(oaSlaveDataGridEvaluations.GetSize() == 0);
+
+	// Nettoyage des tableaux partages (forces a etre en reference)
+	delete output_oaSlaveDataGridEvaluations;
+	delete shared_oaRegressorDataGridStats;
+}
 
 const ALString KWRegressorUnivariateEvaluationTask::GetTaskName() const
 {
@@ -1151,17 +1269,26 @@ boolean KWRegressorUnivariateEvaluationTask::ComputeResourceRequirements()
 {
 	boolean bOk;
 	longint lMemory;
+	KWDataGridStats* dataGridStats;
 	KWDataGrid dgHelper;
+	int nPredictor;
 
-	require(shared_regressorDataGridStats.GetDataGridStats() != NULL);
+	require(shared_oaRegressorDataGridStats->GetObjectArray()->GetSize() == GetPredictorNumber());
 
 	// Appel a la methode ancetre
 	bOk = KWRegressorEvaluationTask::ComputeResourceRequirements();
 
-	// A partir de la grille du regresseur on estime les tailles des grilles de travail et de message
-	dgHelper.ImportDataGridStats(shared_regressorDataGridStats.GetDataGridStats());
-	lMemory = 2 * shared_regressorDataGridStats.GetDataGridStats()->GetUsedMemory();
-	lMemory += dgHelper.GetUsedMemory();
+	// A partir des grilles des predicteurs on estime les tailles des grilles de travail et de message
+	lMemory = 0;
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		dataGridStats =
+		    cast(KWDataGridStats*, shared_oaRegressorDataGridStats->GetObjectArray()->GetAt(nPredictor));
+		dgHelper.ImportDataGridStats(dataGridStats);
+		lMemory += 2 * dataGridStats->GetUsedMemory();
+		lMemory += dgHelper.GetUsedMemory();
+		dgHelper.DeleteAll();
+	}
 
 	// On ajoute une de chacune au maitre es esclave
 	GetResourceRequirements()->GetMasterRequirement()->GetMemory()->UpgradeMin(lMemory);
@@ -1174,88 +1301,152 @@ boolean KWRegressorUnivariateEvaluationTask::ComputeResourceRequirements()
 boolean KWRegressorUnivariateEvaluationTask::MasterInitialize()
 {
 	boolean bOk;
+	int nPredictor;
+	KWDataGridEvaluation* masterDataGridEvaluation;
 
-	require(predictorEvaluation != NULL);
-	require(regressorUnivariateEvaluation == NULL);
+	require(oaPredictorEvaluations.GetSize() == GetPredictorNumber());
+	require(oaMasterDataGridEvaluations.GetSize() == 0);
 
 	// Appel a la methode ancetre
 	bOk = KWRegressorEvaluationTask::MasterInitialize();
 
-	// Vue de KWRegressorUnivariateEvaluation du predicteur demandeur
-	regressorUnivariateEvaluation = cast(KWRegressorUnivariateEvaluation*, predictorEvaluation);
-
-	// Initialisation du service d'evaluation via DataGrid du maitre
-	masterDataGridEvaluation.SetPredictorDataGridStats(shared_regressorDataGridStats.GetDataGridStats());
-	masterDataGridEvaluation.SetDataGridAttributeLoadIndexes(
-	    shared_livDataGridAttributes.GetConstLoadIndexVector());
-	masterDataGridEvaluation.Initialize();
+	// Initialisation des services d'evaluation via DataGrid du maitre
+	BuildDataGridAttributeLoadIndexes(&oaMasterDataGridAttributeLoadIndexes);
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		masterDataGridEvaluation = new KWDataGridEvaluation;
+		masterDataGridEvaluation->SetPredictorDataGridStats(
+		    cast(KWDataGridStats*, shared_oaRegressorDataGridStats->GetObjectArray()->GetAt(nPredictor)));
+		masterDataGridEvaluation->SetDataGridAttributeLoadIndexes(
+		    cast(KWLoadIndexVector*, oaMasterDataGridAttributeLoadIndexes.GetAt(nPredictor)));
+		masterDataGridEvaluation->Initialize();
+		oaMasterDataGridEvaluations.Add(masterDataGridEvaluation);
+	}
 	return bOk;
 }
 
 boolean KWRegressorUnivariateEvaluationTask::MasterAggregateResults()
 {
 	boolean bOk;
+	int nPredictor;
+
+	require(output_oaSlaveDataGridEvaluations->GetObjectArray()->GetSize() == GetPredictorNumber());
 
 	// Appel a la methode ancetre
 	bOk = KWRegressorEvaluationTask::MasterAggregateResults();
 
-	masterDataGridEvaluation.AddEvaluatedDataGridStats(output_slaveDataGridEvaluation.GetDataGridStats());
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		cast(KWDataGridEvaluation*, oaMasterDataGridEvaluations.GetAt(nPredictor))
+		    ->AddEvaluatedDataGridStats(
+			cast(KWDataGridStats*, output_oaSlaveDataGridEvaluations->GetObjectArray()->GetAt(nPredictor)));
+	output_oaSlaveDataGridEvaluations->GetObjectArray()->DeleteAll();
 	return bOk;
 }
 
 boolean KWRegressorUnivariateEvaluationTask::MasterFinalize(boolean bProcessEndedCorrectly)
 {
 	boolean bOk;
+	int nPredictor;
+	KWDataGridEvaluation* masterDataGridEvaluation;
+	KWRegressorUnivariateEvaluation* regressorUnivariateEvaluation;
 
 	// Appel a la methode ancetre
 	bOk = KWRegressorEvaluationTask::MasterFinalize(bProcessEndedCorrectly);
 
-	masterDataGridEvaluation.Finalize();
-	regressorUnivariateEvaluation->dgsEvaluationResults.CopyFrom(
-	    masterDataGridEvaluation.GetEvaluatedDataGridStats());
+	// Finalisation et transfert des evaluations aux objets du rapport
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		masterDataGridEvaluation = cast(KWDataGridEvaluation*, oaMasterDataGridEvaluations.GetAt(nPredictor));
+		regressorUnivariateEvaluation =
+		    cast(KWRegressorUnivariateEvaluation*, GetPredictorEvaluationAt(nPredictor));
+		masterDataGridEvaluation->Finalize();
+		regressorUnivariateEvaluation->dgsEvaluationResults.CopyFrom(
+		    masterDataGridEvaluation->GetEvaluatedDataGridStats());
+	}
+
+	// Nettoyage
+	oaMasterDataGridEvaluations.DeleteAll();
+	oaMasterDataGridAttributeLoadIndexes.DeleteAll();
 	return bOk;
 }
 
 boolean KWRegressorUnivariateEvaluationTask::SlaveInitialize()
 {
 	boolean bOk;
+	int nPredictor;
+	KWDataGridEvaluation* slaveDataGridEvaluation;
+
+	require(oaSlaveDataGridEvaluations.GetSize() == 0);
 
 	// Appel a la methode ancetre
 	bOk = KWRegressorEvaluationTask::SlaveInitialize();
 
-	slaveDataGridEvaluation.SetPredictorDataGridStats(shared_regressorDataGridStats.GetDataGridStats());
-	slaveDataGridEvaluation.SetDataGridAttributeLoadIndexes(shared_livDataGridAttributes.GetConstLoadIndexVector());
+	// Initialisation des services d'evaluation via DataGrid de l'esclave
+	BuildDataGridAttributeLoadIndexes(&oaSlaveDataGridAttributeLoadIndexes);
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		slaveDataGridEvaluation = new KWDataGridEvaluation;
+		slaveDataGridEvaluation->SetPredictorDataGridStats(
+		    cast(KWDataGridStats*, shared_oaRegressorDataGridStats->GetObjectArray()->GetAt(nPredictor)));
+		slaveDataGridEvaluation->SetDataGridAttributeLoadIndexes(
+		    cast(KWLoadIndexVector*, oaSlaveDataGridAttributeLoadIndexes.GetAt(nPredictor)));
+		oaSlaveDataGridEvaluations.Add(slaveDataGridEvaluation);
+	}
 	return bOk;
 }
 
 boolean KWRegressorUnivariateEvaluationTask::SlaveProcessExploitDatabase()
 {
 	boolean bOk;
+	int nPredictor;
+	KWDataGridEvaluation* slaveDataGridEvaluation;
+	KWDataGridStats* slaveDataGridStats;
 
-	output_slaveDataGridEvaluation.GetDataGridStats()->DeleteAllCells();
-	slaveDataGridEvaluation.Initialize();
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		cast(KWDataGridEvaluation*, oaSlaveDataGridEvaluations.GetAt(nPredictor))->Initialize();
 
 	// Appel a la methode ancetre
 	bOk = KWRegressorEvaluationTask::SlaveProcessExploitDatabase();
 
-	slaveDataGridEvaluation.Finalize();
-	output_slaveDataGridEvaluation.GetDataGridStats()->CopyFrom(
-	    slaveDataGridEvaluation.GetEvaluatedDataGridStats());
+	output_oaSlaveDataGridEvaluations->GetObjectArray()->DeleteAll();
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		slaveDataGridEvaluation = cast(KWDataGridEvaluation*, oaSlaveDataGridEvaluations.GetAt(nPredictor));
+		slaveDataGridEvaluation->Finalize();
+		slaveDataGridStats = new KWDataGridStats;
+		slaveDataGridStats->CopyFrom(slaveDataGridEvaluation->GetEvaluatedDataGridStats());
+		output_oaSlaveDataGridEvaluations->GetObjectArray()->Add(slaveDataGridStats);
+	}
 	return bOk;
 }
 
 boolean KWRegressorUnivariateEvaluationTask::SlaveProcessExploitDatabaseObject(const KWObject* databaseObject)
 {
 	boolean bOk;
+	int nPredictor;
 
 	// Appel a la methode ancetre
 	bOk = KWRegressorEvaluationTask::SlaveProcessExploitDatabaseObject(databaseObject);
 
-	slaveDataGridEvaluation.AddInstance(databaseObject);
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+		cast(KWDataGridEvaluation*, oaSlaveDataGridEvaluations.GetAt(nPredictor))->AddInstance(databaseObject);
 	return bOk;
 }
 
-void KWRegressorUnivariateEvaluationTask::InitializePredictorSharedVariables(KWPredictor* predictor)
+boolean KWRegressorUnivariateEvaluationTask::SlaveFinalize(boolean bProcessEndedCorrectly)
+{
+	boolean bOk;
+
+	// Appel a la methode ancetre
+	bOk = KWRegressorEvaluationTask::SlaveFinalize(bProcessEndedCorrectly);
+
+	// Nettoyage
+	oaSlaveDataGridEvaluations.DeleteAll();
+	oaSlaveDataGridAttributeLoadIndexes.DeleteAll();
+	return bOk;
+}
+
+void KWRegressorUnivariateEvaluationTask::InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor)
 {
 	int i;
 	KWPredictorUnivariate* predictorUnivariate;
@@ -1263,22 +1454,64 @@ void KWRegressorUnivariateEvaluationTask::InitializePredictorSharedVariables(KWP
 	KWClass* predictorClass;
 	KWAttribute* predictorAttribute;
 
+	require(shared_ivDataGridAttributeNumbers.GetSize() == nPredictor);
+
 	// Appel a la methode ancetre
-	KWRegressorEvaluationTask::InitializePredictorSharedVariables(predictor);
+	KWRegressorEvaluationTask::InitializePredictorSharedVariables(nPredictor, predictor);
 
+	// Vue de KWPredictorUnivariate du predicteur demandeur
 	predictorUnivariate = cast(KWPredictorUnivariate*, predictor);
 	predictorDataGridStats = predictorUnivariate->GetTrainDataGridStats();
 	predictorClass = predictorUnivariate->GetTrainedPredictor()->GetPredictorClass();
 
-	shared_livDataGridAttributes.SetSize(predictorDataGridStats->GetAttributeNumber());
+	// Sauvegarde des indices de chargement des attributes du predicteur dans la classe d'evaluation
+	shared_ivDataGridAttributeNumbers.Add(predictorDataGridStats->GetAttributeNumber());
 	for (i = 0; i < predictorDataGridStats->GetAttributeNumber(); i++)
 	{
-		// Recherche de l'index de l'attribut dans le dictionnaire du predicteur
+		// Recherche de l'attribut dans le dictionnaire du predicteur
 		predictorAttribute =
 		    predictorClass->LookupAttribute(predictorDataGridStats->GetAttributeAt(i)->GetAttributeName());
 		assert(predictorAttribute != NULL);
-		assert(predictorAttribute->GetLoadIndex().IsValid());
-		shared_livDataGridAttributes.SetAt(i, predictorAttribute->GetLoadIndex());
+		shared_livDataGridAttributes.GetLoadIndexVector()->Add(GetLoadIndex(nPredictor, predictorAttribute));
+	}
+
+	// Sauvegarde de la grille des donnees d'apprentissage du predicteur
+	shared_oaRegressorDataGridStats->GetObjectArray()->Add(predictorDataGridStats->Clone());
+}
+
+void KWRegressorUnivariateEvaluationTask::CleanPredictorSharedVariables()
+{
+	// Appel a la methode ancetre
+	KWRegressorEvaluationTask::CleanPredictorSharedVariables();
+
+	shared_livDataGridAttributes.SetSize(0);
+	shared_ivDataGridAttributeNumbers.GetIntVector()->SetSize(0);
+	shared_oaRegressorDataGridStats->GetObjectArray()->DeleteAll();
+}
+
+void KWRegressorUnivariateEvaluationTask::BuildDataGridAttributeLoadIndexes(
+    ObjectArray* oaDataGridAttributeLoadIndexes) const
+{
+	int nPredictor;
+	int nAttribute;
+	int nDataGridAttribute;
+	KWLoadIndexVector* livAttributes;
+
+	require(oaDataGridAttributeLoadIndexes != NULL);
+	require(oaDataGridAttributeLoadIndexes->GetSize() == 0);
+	require(shared_ivDataGridAttributeNumbers.GetSize() == GetPredictorNumber());
+
+	// Decoupage des index concatenes, par predicteur
+	nDataGridAttribute = 0;
+	for (nPredictor = 0; nPredictor < GetPredictorNumber(); nPredictor++)
+	{
+		livAttributes = new KWLoadIndexVector;
+		for (nAttribute = 0; nAttribute < shared_ivDataGridAttributeNumbers.GetAt(nPredictor); nAttribute++)
+		{
+			livAttributes->Add(shared_livDataGridAttributes.GetAt(nDataGridAttribute));
+			nDataGridAttribute++;
+		}
+		oaDataGridAttributeLoadIndexes->Add(livAttributes);
 	}
-	shared_regressorDataGridStats.SetDataGridStats(predictorUnivariate->GetTrainDataGridStats()->Clone());
+	ensure(nDataGridAttribute == shared_livDataGridAttributes.GetSize());
 }
@@ -64,15 +64,15 @@ public:
 
 	//////////////////////////////////////////////////////////////////////////////
 	// Acces au resultats apres apprentissage
-	// La methode Evaluate(database) a ete reimplementee et renvoie un
+	// La methode CreatePredictorEvaluation a ete reimplementee et renvoie un
 	// objet KWPredictorClusterEvaluation permettant de comparer les tables
 	// de contingences en apprentissage et test selon different criteres
 
-	// Evaluation du predicteur sur une base de donnees
+	// Creation d'un objet d'evaluation du predicteur
 	// Redefinition de la methode ancetre pour renvoyer un objet
 	// KWUnivariateClassifierEvaluation ou KWRegressorUnivariateEvaluation,
 	// comportant une grille d'evaluation
-	KWPredictorEvaluation* Evaluate(KWDatabase* database) override;
+	KWPredictorEvaluation* CreatePredictorEvaluation() const override;
 
 	// Attribut source pour le predicteur (si apprentissage reussi)
 	const ALString& GetSourceAttributeName() const;
@@ -159,9 +159,6 @@ public:
 	// Initialization des resultats d'evaluation
 	void InitializeCriteria() override;
 
-	// Methode principal pour declencher l'evaluation
-	void Evaluate(KWPredictor* predictor, KWDatabase* database) override;
-
 	// Acces a la grille evaluee (grille vide si aucune evaluation n'a eu lieu)
 	KWDataGridStats* GetEvaluatedDataGridStats();
 
@@ -180,6 +177,9 @@ protected:
 	// Expedition de l'evaluation en parallele
 	KWPredictorEvaluationTask* CreatePredictorEvaluationTask() override;
 
+	// Preparation de l'evaluation, avec parametrage de la grille resultat d'evaluation
+	void PrepareEvaluation(KWPredictor* predictor, KWDatabase* database) override;
+
 	// Resultat de l'evaluation
 	KWEvaluatedDataGridStats dgsEvaluationResults;
 
@@ -200,9 +200,6 @@ public:
 	// Initialisation (additionelle) du DataGridStats de l'evaluation univariaree
 	void InitializeCriteria() override;
 
-	// Methode principal pour declencher l'evaluation
-	void Evaluate(KWPredictor* predictor, KWDatabase* database) override;
-
 	// Acces a la grille evaluee
 	KWDataGridStats* GetEvaluatedDataGridStats();
 
@@ -221,6 +218,9 @@ protected:
 	// Evaluation du regresseur en parallel
 	KWPredictorEvaluationTask* CreatePredictorEvaluationTask() override;
 
+	// Preparation de l'evaluation, avec parametrage de la grille resultat d'evaluation
+	void PrepareEvaluation(KWPredictor* predictor, KWDatabase* database) override;
+
 	// Service d'evaluation de grille
 	KWEvaluatedDataGridStats dgsEvaluationResults;
 
@@ -326,28 +326,34 @@ protected:
 	boolean SlaveInitialize() override;
 	boolean SlaveProcessExploitDatabase() override;
 	boolean SlaveProcessExploitDatabaseObject(const KWObject* kwoObject) override;
+	boolean SlaveFinalize(boolean bProcessEndedCorrectly) override;
 
-	// Initialisation et nettoyage des variables de travail lies au predicteur
-	void InitializePredictorSharedVariables(KWPredictor* predictor) override;
+	// Initialisation et nettoyage des variables de travail lies aux predicteurs
+	void InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor) override;
 	void CleanPredictorSharedVariables() override;
 
-	// Service d'evaluation via DataGrid du maitre
-	KWDataGridEvaluation masterDataGridEvaluation;
+	// Construction des vecteurs d'index de chargement des attributs des grilles, par predicteur
+	// Memoire: les vecteurs sont a detruire par l'appelant
+	void BuildDataGridAttributeLoadIndexes(ObjectArray* oaDataGridAttributeLoadIndexes) const;
 
-	// Service d'evaluation via DataGrid des esclaves
-	KWDataGridEvaluation slaveDataGridEvaluation;
+	// Services d'evaluation via DataGrid du maitre, par predicteur
+	ObjectArray oaMasterDataGridEvaluations;
+	ObjectArray oaMasterDataGridAttributeLoadIndexes;
 
-	// Service d'evaluation demandeur
-	KWClassifierUnivariateEvaluation* classifierUnivariateEvaluation;
+	// Services d'evaluation via DataGrid des esclaves, par predicteur
+	ObjectArray oaSlaveDataGridEvaluations;
+	ObjectArray oaSlaveDataGridAttributeLoadIndexes;
 
-	// Resultats de l'evaluation via DataGrid des esclaves. Sous forme de DataGridStats
-	PLShared_DataGridStats output_slaveDataGridEvaluation;
+	// Resultats de l'evaluation via DataGrid des esclaves, par predicteur. Sous forme de DataGridStats
+	PLShared_ObjectArray* output_oaSlaveDataGridEvaluations;
 
-	// Indices des attributs necessaires a l'evaluation de la grille
+	// Indices des attributs necessaires a l'evaluation des grilles, concatenes pour tous les predicteurs,
+	// avec leur nombre par predicteur
 	PLShared_LoadIndexVector shared_livDataGridAttributes;
+	PLShared_IntVector shared_ivDataGridAttributeNumbers;
 
-	// DataGrid du classifieur univarie
-	PLShared_DataGridStats shared_classifierDataGridStats;
+	// DataGrid des classifieurs univaries
+	PLShared_ObjectArray* shared_oaClassifierDataGridStats;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -374,25 +380,32 @@ protected:
 	boolean SlaveInitialize() override;
 	boolean SlaveProcessExploitDatabase() override;
 	boolean SlaveProcessExploitDatabaseObject(const KWObject* kwoObject) override;
+	boolean SlaveFinalize(boolean bProcessEndedCorrectly) override;
 
-	// Initialisation et nettoyage des variables de travail lies au predicteur
-	void InitializePredictorSharedVariables(KWPredictor* predictor) override;
+	// Initialisation et nettoyage des variables de travail lies aux predicteurs
+	void InitializePredictorSharedVariables(int nPredictor, KWPredictor* predictor) override;
+	void CleanPredictorSharedVariables() override;
 
-	// Service d'evaluation via DataGrid du maitre
-	KWDataGridEvaluation masterDataGridEvaluation;
+	// Construction des vecteurs d'index de chargement des attributs des grilles, par predicteur
+	// Memoire: les vecteurs sont a detruire par l'appelant
+	void BuildDataGridAttributeLoadIndexes(ObjectArray* oaDataGridAttributeLoadIndexes) const;
 
-	// Service d'evaluation via DataGrid des esclaves
-	KWDataGridEvaluation slaveDataGridEvaluation;
+	// Services d'evaluation via DataGrid du maitre, par predicteur
+	ObjectArray oaMasterDataGridEvaluations;
+	ObjectArray oaMasterDataGridAttributeLoadIndexes;
 
-	// Service d'evaluation demandeur
-	KWRegressorUnivariateEvaluation* regressorUnivariateEvaluation;
+	// Services d'evaluation via DataGrid des esclaves, par predicteur
+	ObjectArray oaSlaveDataGridEvaluations;
+	ObjectArray oaSlaveDataGridAttributeLoadIndexes;
 
-	// Resultats de l'evaluation via DataGrid des esclaves. Sous forme de DataGridStats
-	PLShared_DataGridStats output_slaveDataGridEvaluation;
+	// Resultats de l'evaluation via DataGrid des esclaves, par predicteur. Sous forme de DataGridStats
+	PLShared_ObjectArray* output_oaSlaveDataGridEvaluations;
 
-	// Indices des attributs necessaires a l'evaluation de la grille
+	// Indices des attributs necessaires a l'evaluation des grilles, concatenes pour tous les predicteurs,
+	// avec leur nombre par predicteur
 	PLShared_LoadIndexVector shared_livDataGridAttributes;
+	PLShared_IntVector shared_ivDataGridAttributeNumbers;
 
-	// DataGrid du classifieur univarie
-	PLShared_DataGridStats shared_regressorDataGridStats;
+	// DataGrid des regresseurs univaries
+	PLShared_ObjectArray* shared_oaRegressorDataGridStats;
 };
@@ -300,6 +300,8 @@ boolean KWPredictorEvaluator::EvaluatePredictors(ObjectArray* oaPredictors, KWDa
 	ALString sLowerEvaluationLabel;
 	KWPredictor* predictor;
 	KWPredictorEvaluation* predictorEvaluation;
+	ObjectArray oaTrainedPredictors;
+	ObjectArray oaPredictorEvaluations;
 	int i;
 	boolean bComputeEvaluation;
 	ALString sTmp;
@@ -333,32 +335,43 @@ boolean KWPredictorEvaluator::EvaluatePredictors(ObjectArray* oaPredictors, KWDa
 		TaskProgression::DisplayMainLabel(sEvaluationLabel + " evaluation on database " +
 						  database->GetDatabaseName());
 
-		// Evaluation des predicteurs
+		// Collecte des predicteurs a evaluer
 		for (i = 0; i < oaPredictors->GetSize(); i++)
 		{
 			predictor = cast(KWPredictor*, oaPredictors->GetAt(i));
-
-			// Evaluation
-			predictorEvaluation = NULL;
 			if (predictor->IsTrained())
 			{
-				predictorEvaluation = EvaluatePredictor(predictor, database, sEvaluationLabel);
-				if (not TaskProgression::IsInterruptionRequested() and predictorEvaluation != NULL)
-					oaOutputPredictorEvaluations->Add(predictorEvaluation);
-				else
-				{
-					bOk = false;
-					if (predictorEvaluation != NULL)
-						delete predictorEvaluation;
-				}
+				oaTrainedPredictors.Add(predictor);
+
+				// Message
+				AddSimpleMessage(sEvaluationLabel + " evaluation of " + predictor->GetObjectLabel() +
+						 " on database " + database->GetDatabaseName());
 			}
+		}
 
-			// Suivi de progression
-			TaskProgression::DisplayProgression(((i + 1) * 100) / oaPredictors->GetSize());
-			bOk = bOk and not TaskProgression::IsInterruptionRequested();
-			if (not bOk)
-				break;
+		// Evaluation de tous les predicteurs, en factorisant les lectures de la base
+		if (oaTrainedPredictors.GetSize() > 0)
+			KWPredictorEvaluation::EvaluatePredictors(&oaTrainedPredictors, database,
+								  &oaPredictorEvaluations);
+
+		// Memorisation des evaluations si non interrompues ou incorrectes
+		for (i = 0; i < oaPredictorEvaluations.GetSize(); i++)
+		{
+			predictorEvaluation = cast(KWPredictorEvaluation*, oaPredictorEvaluations.GetAt(i));
+			if (not TaskProgression::IsInterruptionRequested() and predictorEvaluation->IsStatsComputed())
+				oaOutputPredictorEvaluations->Add(predictorEvaluation);
+			else
+			{
+				bOk = false;
+				delete predictorEvaluation;
+			}
 		}
+		bOk = bOk and oaPredictorEvaluations.GetSize() == oaTrainedPredictors.GetSize();
+
+		// Suivi de progression
+		TaskProgression::DisplayProgression(100);
+		bOk = bOk and not TaskProgression::IsInterruptionRequested();
+
 		assert(oaPredictors->GetSize() >= oaOutputPredictorEvaluations->GetSize());
 
 		// Suivi de tache, avec libelle de fin pertinent en cas de fichier de suivi des taches (option -t de la
@@ -464,38 +477,6 @@ void KWPredictorEvaluator::WriteJSONEvaluationReport(const ALString& sEvaluation
 	}
 }
 
-KWPredictorEvaluation* KWPredictorEvaluator::EvaluatePredictor(KWPredictor* predictor, KWDatabase* database,
-							       const ALString& sEvaluationLabel)
-{
-	KWPredictorEvaluation* predictorEvaluation = NULL;
-
-	require(predictor != NULL);
-	require(database != NULL);
-	require(database->Check());
-
-	// Evaluation
-	if (predictor->IsTrained() and not TaskProgression::IsInterruptionRequested())
-	{
-		// Libelle de tache
-		TaskProgression::DisplayLabel(predictor->GetName());
-
-		// Message
-		AddSimpleMessage(sEvaluationLabel + " evaluation of " + predictor->GetObjectLabel() + " on database " +
-				 database->GetDatabaseName());
-
-		// Evaluation
-		predictorEvaluation = predictor->Evaluate(database);
-
-		// Memorisation de l'evaluation si non interrompue ou incorrecte
-		if (TaskProgression::IsInterruptionRequested() or not predictorEvaluation->IsStatsComputed())
-		{
-			delete predictorEvaluation;
-			predictorEvaluation = NULL;
-		}
-	}
-	return predictorEvaluation;
-}
-
 const ALString KWPredictorEvaluator::GetClassLabel() const
 {
 	return "Evaluate model";
@@ -107,12 +107,6 @@ public:
 	void WriteJSONEvaluationReport(const ALString& sEvaluationReportName, const ALString& sEvaluationLabel,
 				       ObjectArray* oaPredictorEvaluations);
 
-	// Evaluation d'un predicteurs
-	// Retourne NULL si probleme d'evaluation
-	// Memoire: l'objet retourne est a liberer par l'appelant
-	KWPredictorEvaluation* EvaluatePredictor(KWPredictor* predictor, KWDatabase* database,
-						 const ALString& sEvaluationLabel);
-
 	// Libelles utilisateur
 	const ALString GetClassLabel() const override;
 
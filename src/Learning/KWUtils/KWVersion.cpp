@@ -445,6 +445,25 @@ boolean GetPreparationTraceMode()
 	return bPreparationTraceMode;
 }
 
+const ALString& GetPreparationCacheDirectory()
+{
+	static boolean bIsInitialized = false;
+	static ALString sPreparationCacheDirectory;
+
+	// Determination du repertoire au premier appel
+	if (not bIsInitialized)
+	{
+		// Recherche des variables d'environnement
+		sPreparationCacheDirectory = p_getenv("KhiopsPreparationCacheDirectory");
+		sPreparationCacheDirectory.TrimLeft();
+		sPreparationCacheDirectory.TrimRight();
+
+		// Memorisation du flag d'initialisation
+		bIsInitialized = true;
+	}
+	return sPreparationCacheDirectory;
+}
+
 boolean GetIOTraceMode()
 {
 	static boolean bIsInitialized = false;
@@ -470,6 +489,31 @@ boolean GetIOTraceMode()
 	return bIOTraceMode;
 }
 
+boolean GetTmpFileCompressionMode()
+{
+	static boolean bIsInitialized = false;
+	static boolean bTmpFileCompressionMode = false;
+	ALString sTmpFileCompressionMode;
+
+	// Determination du mode expert au premier appel
+	if (not bIsInitialized)
+	{
+		// Recherche des variables d'environnement
+		sTmpFileCompressionMode = p_getenv("KhiopsTmpFileCompression");
+		sTmpFileCompressionMode.MakeLower();
+
+		// Determination du mode expert
+		if (sTmpFileCompressionMode == "true")
+			bTmpFileCompressionMode = true;
+		else if (sTmpFileCompressionMode == "false")
+			bTmpFileCompressionMode = false;
+
+		// Memorisation du flag d'initialisation
+		bIsInitialized = true;
+	}
+	return bTmpFileCompressionMode;
+}
+
 boolean GetForestExpertMode()
 {
 	static boolean bIsInitialized = false;
@@ -612,6 +656,73 @@ int GetParallelTraceMode()
 	return nParallelTraceMode;
 }
 
+const ALString& GetParallelTimelineFileName()
+{
+	static boolean bIsInitialized = false;
+	static ALString sParallelTimelineFileName;
+
+	// Determination du nom du fichier au premier appel
+	if (not bIsInitialized)
+	{
+		// Recherche des variables d'environnement
+		sParallelTimelineFileName = p_getenv("KhiopsParallelTimelineFileName");
+		sParallelTimelineFileName.TrimLeft();
+		sParallelTimelineFileName.TrimRight();
+
+		// Memorisation du flag d'initialisation
+		bIsInitialized = true;
+	}
+	return sParallelTimelineFileName;
+}
+
+const ALString& GetParallelMemoryCalibrationFileName()
+{
+	static boolean bIsInitialized = false;
+	static ALString sParallelMemoryCalibrationFileName;
+
+	// Determination du nom du fichier au premier appel
+	if (not bIsInitialized)
+	{
+		// Recherche des variables d'environnement
+		sParallelMemoryCalibrationFileName = p_getenv("KhiopsParallelMemoryCalibrationFileName");
+		sParallelMemoryCalibrationFileName.TrimLeft();
+		sParallelMemoryCalibrationFileName.TrimRight();
+
+		// Memorisation du flag d'initialisation
+		bIsInitialized = true;
+	}
+	return sParallelMemoryCalibrationFileName;
+}
+
+double GetParallelMemoryCalibrationMargin()
+{
+	static boolean bIsInitialized = false;
+	static double dParallelMemoryCalibrationMargin = -1;
+	ALString sParallelMemoryCalibrationMargin;
+	double dValue;
+
+	// Determination de la marge au premier appel
+	if (not bIsInitialized)
+	{
+		// Recherche des variables d'environnement
+		sParallelMemoryCalibrationMargin = p_getenv("KhiopsParallelMemoryCalibrationMargin");
+		sParallelMemoryCalibrationMargin.TrimLeft();
+		sParallelMemoryCalibrationMargin.TrimRight();
+
+		// Transformation en reel positif, la valeur devant commencer par un chiffre
+		if (sParallelMemoryCalibrationMargin != "" and isdigit(sParallelMemoryCalibrationMargin.GetAt(0)))
+		{
+			dValue = StringToDouble(sParallelMemoryCalibrationMargin);
+			if (dValue >= 0)
+				dParallelMemoryCalibrationMargin = dValue;
+		}
+
+		// Memorisation du flag d'initialisation
+		bIsInitialized = true;
+	}
+	return dParallelMemoryCalibrationMargin;
+}
+
 boolean GetFileServerActivated()
 {
 	static boolean bIsInitialized = false;
@@ -142,10 +142,19 @@ boolean GetLearningFastExitMode();
 // Ce mode expert est controlable par la variable d'environnement KhiopsPreparationTraceMode a true ou false
 boolean GetPreparationTraceMode();
 
+// Repertoire du cache des resultats de preparation des donnees (cf. KWDataPreparationCache)
+// Ce parametre expert est controlable par la variable d'environnement KhiopsPreparationCacheDirectory
+// Renvoie vide si pas de cache
+const ALString& GetPreparationCacheDirectory();
+
 // Indicateur du mode trace des acces IO
 // Ce mode expert est controlable par la variable d'environnement KhiopsIOTraceMode a true ou false
 boolean GetIOTraceMode();
 
+// Indicateur du mode de compression des fichiers temporaires de tri (cf. KWFileSorter::SetChunkCompression)
+// Ce mode expert est controlable par la variable d'environnement KhiopsTmpFileCompression a true ou false
+boolean GetTmpFileCompressionMode();
+
 // Indicateur du mode expert pour la creation des forets d'arbres
 // Ce mode expert est controlable par la variable d'environnement KhiopsForestExpertMode a true ou false
 boolean GetForestExpertMode();
@@ -171,6 +180,21 @@ boolean GetParallelExpertMode();
 // aux methodes de PLParallelTask)
 int GetParallelTraceMode();
 
+// Nom du fichier de ligne de temps des taches paralleles, au format Chrome trace-event (cf. PLParallelTask)
+// Ce parametre expert est controlable par la variable d'environnement KhiopsParallelTimelineFileName
+// Renvoie vide si pas de ligne de temps
+const ALString& GetParallelTimelineFileName();
+
+// Nom du fichier de profil de calibration des exigences memoire des taches paralleles (cf. RMTaskMemoryCalibration)
+// Ce parametre expert est controlable par la variable d'environnement KhiopsParallelMemoryCalibrationFileName
+// Renvoie vide si pas de calibration
+const ALString& GetParallelMemoryCalibrationFileName();
+
+// Marge de securite de la calibration des exigences memoire des taches paralleles
+// Ce parametre expert est controlable par la variable d'environnement KhiopsParallelMemoryCalibrationMargin
+// Renvoie -1 si la variable n'est pas specifiee ou invalide (marge par defaut)
+double GetParallelMemoryCalibrationMargin();
+
 // Indicateur du lancement d'un serveur de fichier sur un systeme mono-machine. Les serveurs sont normalement instancies sur
 // un cluster de machine. Cet indicateur permet de tester le driver de fichier distant sans cluster.
 boolean GetFileServerActivated();
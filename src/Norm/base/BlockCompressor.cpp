@@ -0,0 +1,328 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#include "BlockCompressor.h"
+
+int BlockCompressor::Compress(const char* sSource, int nSourceSize, char* sDest, int nMaxDestSize)
+{
+	int nHashTable[nHashSize];
+	const unsigned char* sBase;
+	const unsigned char* sEnd;
+	const unsigned char* sMatchLimit;
+	const unsigned char* sPos;
+	const unsigned char* sAnchor;
+	const unsigned char* sRef;
+	unsigned char* sOut;
+	unsigned char* sOutEnd;
+	unsigned char* sToken;
+	unsigned int nSequence;
+	int nHash;
+	int nRef;
+	int nMissNumber;
+	int nLiteralLength;
+	int nMatchLength;
+	int nOffset;
+	int i;
+
+	require(sSource != NULL or nSourceSize == 0);
+	require(0 <= nSourceSize and nSourceSize <= nMaxBlockSize);
+	require(sDest != NULL);
+	require(nMaxDestSize >= 0);
+
+	// Initialisation
+	sBase = (const unsigned char*)sSource;
+	sEnd = sBase + nSourceSize;
+	sMatchLimit = sEnd - nLastLiteralLength;
+	sPos = sBase;
+	sAnchor = sBase;
+	sOut = (unsigned char*)sDest;
+	sOutEnd = sOut + nMaxDestSize;
+	for (i = 0; i < nHashSize; i++)
+		nHashTable[i] = -1;
+
+	// Recherche des repetitions, uniquement si le bloc est assez grand
+	nMissNumber = 0;
+	while (nSourceSize >= nMatchStartLimit and sPos <= sEnd - nMatchStartLimit)
+	{
+		// Recherche d'une sequence identique precedente, via la table de hashage
+		nSequence = Read32(sPos);
+		nHash = Hash32(nSequence);
+		nRef = nHashTable[nHash];
+		nHashTable[nHash] = (int)(sPos - sBase);
+		if (nRef < 0 or (sPos - sBase) - nRef > 65535 or Read32(sBase + nRef) != nSequence)
+		{
+			// On accelere la progression dans les zones sans repetition
+			sPos += 1 + (nMissNumber >> 6);
+			nMissNumber++;
+			continue;
+		}
+		sRef = sBase + nRef;
+		nMissNumber = 0;
+
+		// Extension de la repetition vers l'arriere, puis vers l'avant
+		while (sPos > sAnchor and sRef > sBase and sPos[-1] == sRef[-1])
+		{
+			sPos--;
+			sRef--;
+		}
+		nMatchLength = nMinMatchLength;
+		while (sPos + nMatchLength < sMatchLimit and sPos[nMatchLength] == sRef[nMatchLength])
+			nMatchLength++;
+
+		// Verification de la place disponible pour la sequence
+		nLiteralLength = (int)(sPos - sAnchor);
+		if (sOut + 1 + nLiteralLength + nLiteralLength / 255 + 1 + 2 + nMatchLength / 255 + 1 > sOutEnd)
+			return 0;
+
+		// Ecriture des litteraux
+		sToken = sOut++;
+		if (nLiteralLength >= 15)
+		{
+			*sToken = 15 << 4;
+			sOut = WriteLength(sOut, nLiteralLength - 15);
+		}
+		else
+			*sToken = (unsigned char)(nLiteralLength << 4);
+		memcpy(sOut, sAnchor, nLiteralLength);
+		sOut += nLiteralLength;
+
+		// Ecriture de la reference arriere
+		nOffset = (int)(sPos - sRef);
+		assert(0 < nOffset and nOffset <= 65535);
+		*sOut++ = (unsigned char)(nOffset & 255);
+		*sOut++ = (unsigned char)(nOffset >> 8);
+		if (nMatchLength - nMinMatchLength >= 15)
+		{
+			*sToken |= 15;
+			sOut = WriteLength(sOut, nMatchLength - nMinMatchLength - 15);
+		}
+		else
+			*sToken |= (unsigned char)(nMatchLength - nMinMatchLength);
+
+		// Passage a la suite, en memorisant une position de la fin de la repetition
+		sPos += nMatchLength;
+		sAnchor = sPos;
+		nHashTable[Hash32(Read32(sPos - 2))] = (int)(sPos - 2 - sBase);
+	}
+
+	// Ecriture des derniers litteraux
+	nLiteralLength = (int)(sEnd - sAnchor);
+	if (sOut + 1 + nLiteralLength + nLiteralLength / 255 + 1 > sOutEnd)
+		return 0;
+	sToken = sOut++;
+	if (nLiteralLength >= 15)
+	{
+		*sToken = 15 << 4;
+		sOut = WriteLength(sOut, nLiteralLength - 15);
+	}
+	else
+		*sToken = (unsigned char)(nLiteralLength << 4);
+	memcpy(sOut, sAnchor, nLiteralLength);
+	sOut += nLiteralLength;
+	ensure(sOut - (unsigned char*)sDest <= GetMaxCompressedSize(nSourceSize));
+	return (int)(sOut - (unsigned char*)sDest);
+}
+
+int BlockCompressor::Decompress(const char* sSource, int nSourceSize, char* sDest, int nMaxDestSize)
+{
+	const unsigned char* sPos;
+	const unsigned char* sEnd;
+	unsigned char* sOut;
+	unsigned char* sOutEnd;
+	const unsigned char* sRef;
+	unsigned char cToken;
+	int nLength;
+	int nOffset;
+	unsigned char c;
+
+	require(sSource != NULL);
+	require(nSourceSize >= 0);
+	require(sDest != NULL);
+	require(nMaxDestSize >= 0);
+
+	// Initialisation
+	sPos = (const unsigned char*)sSource;
+	sEnd = sPos + nSourceSize;
+	sOut = (unsigned char*)sDest;
+	sOutEnd = sOut + nMaxDestSize;
+
+	// Parcours des sequences, avec controle systematique des bornes
+	while (sPos < sEnd)
+	{
+		cToken = *sPos++;
+
+		// Litteraux
+		nLength = cToken >> 4;
+		if (nLength == 15)
+		{
+			do
+			{
+				if (sPos >= sEnd)
+					return -1;
+				c = *sPos++;
+				nLength += c;
+			} while (c == 255);
+		}
+		if (nLength > sEnd - sPos or nLength > sOutEnd - sOut)
+			return -1;
+		memcpy(sOut, sPos, nLength);
+		sPos += nLength;
+		sOut += nLength;
+
+		// La derniere sequence ne comporte que des litteraux
+		if (sPos == sEnd)
+			break;
+
+		// Reference arriere
+		if (sEnd - sPos < 2)
+			return -1;
+		nOffset = sPos[0] | (sPos[1] << 8);
+		sPos += 2;
+		if (nOffset == 0 or nOffset > sOut - (unsigned char*)sDest)
+			return -1;
+		nLength = cToken & 15;
+		if (nLength == 15)
+		{
+			do
+			{
+				if (sPos >= sEnd)
+					return -1;
+				c = *sPos++;
+				nLength += c;
+			} while (c == 255);
+		}
+		nLength += nMinMatchLength;
+		if (nLength > sOutEnd - sOut)
+			return -1;
+
+		// Recopie caractere par caractere si la repetition chevauche sa source
+		sRef = sOut - nOffset;
+		if (nOffset >= nLength)
+		{
+			memcpy(sOut, sRef, nLength);
+			sOut += nLength;
+		}
+		else
+		{
+			while (nLength > 0)
+			{
+				*sOut++ = *sRef++;
+				nLength--;
+			}
+		}
+	}
+	return (int)(sOut - (unsigned char*)sDest);
+}
+
+void BlockCompressor::Test()
+{
+	const int nTestNumber = 6;
+	const char* sTestLabels[nTestNumber] = {"Empty",  "Short",        "Text",
+						"Random", "Long repeats", "Random incompressible"};
+	char* sSource;
+	char* sCompressed;
+	char* sDecompressed;
+	int nSourceSize;
+	int nCompressedSize;
+	int nDecompressedSize;
+	unsigned int nRandom;
+	int nTest;
+	int i;
+	ALString sLine;
+
+	// Allocation des buffers
+	sSource = NewCharArray(nMaxBlockSize);
+	sCompressed = NewCharArray(GetMaxCompressedSize(nMaxBlockSize));
+	sDecompressed = NewCharArray(nMaxBlockSize);
+
+	// Tests de compression et decompression sur differents types de blocs
+	cout << "Block\tSize\tCompressed\tRaw compressed\tIdentical" << endl;
+	nRandom = 1;
+	for (nTest = 0; nTest < nTestNumber; nTest++)
+	{
+		// Construction du bloc source
+		nSourceSize = 0;
+		if (nTest == 1)
+		{
+			strcpy(sSource, "abcabcabc");
+			nSourceSize = (int)strlen(sSource);
+		}
+		else if (nTest == 2)
+		{
+			// Lignes de texte tabule, typiques des fichiers temporaires
+			i = 0;
+			while (nSourceSize + 100 < nMaxBlockSize)
+			{
+				sLine = "";
+				sLine += IntToString(i);
+				sLine += "\tvalue_";
+				sLine += IntToString(i % 17);
+				sLine += "\t";
+				sLine += DoubleToString(i * 0.25);
+				sLine += "\tClass";
+				sLine += IntToString(i % 3);
+				sLine += "\n";
+				memcpy(&sSource[nSourceSize], (const char*)sLine, sLine.GetLength());
+				nSourceSize += sLine.GetLength();
+				i++;
+			}
+		}
+		else if (nTest == 3 or nTest == 5)
+		{
+			// Caracteres pseudo-aleatoires, issus d'un petit alphabet ou non
+			nSourceSize = nMaxBlockSize;
+			for (i = 0; i < nSourceSize; i++)
+			{
+				nRandom = nRandom * 1103515245 + 12345;
+				if (nTest == 3)
+					sSource[i] = (char)('a' + (nRandom >> 16) % 4);
+				else
+					sSource[i] = (char)(nRandom >> 16);
+			}
+		}
+		else if (nTest == 4)
+		{
+			// Longues repetitions, avec longueurs codees sur plusieurs octets
+			nSourceSize = nMaxBlockSize;
+			for (i = 0; i < nSourceSize; i++)
+				sSource[i] = (char)('A' + (i / 1000) % 3);
+		}
+
+		// Compression, puis compression dans la taille du bloc source pour les blocs incompressibles
+		nCompressedSize = Compress(sSource, nSourceSize, sCompressed, GetMaxCompressedSize(nSourceSize));
+		cout << sTestLabels[nTest] << "\t" << nSourceSize << "\t" << nCompressedSize << "\t"
+		     << Compress(sSource, nSourceSize, sDecompressed, nSourceSize);
+
+		// Decompression et verification
+		nDecompressedSize = Decompress(sCompressed, nCompressedSize, sDecompressed, nMaxBlockSize);
+		cout << "\t"
+		     << BooleanToString(nDecompressedSize == nSourceSize and
+					memcmp(sSource, sDecompressed, nSourceSize) == 0)
+		     << endl;
+	}
+
+	// Decompression de blocs incorrects: tronque, et avec une taille destination insuffisante
+	nCompressedSize = Compress(sSource, 1000, sCompressed, GetMaxCompressedSize(1000));
+	cout << "Truncated block\t" << Decompress(sCompressed, nCompressedSize / 2, sDecompressed, nMaxBlockSize)
+	     << endl;
+	cout << "Too small destination\t" << Decompress(sCompressed, nCompressedSize, sDecompressed, 999) << endl;
+
+	// Nettoyage
+	DeleteCharArray(sSource);
+	DeleteCharArray(sCompressed);
+	DeleteCharArray(sDecompressed);
+}
+
+unsigned char* BlockCompressor::WriteLength(unsigned char* sDest, int nLength)
+{
+	require(nLength >= 0);
+
+	while (nLength >= 255)
+	{
+		*sDest++ = 255;
+		nLength -= 255;
+	}
+	*sDest++ = (unsigned char)nLength;
+	return sDest;
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#pragma once
+
+#include "Object.h"
+
+//////////////////////////////////////////////////////////
+// Classe BlockCompressor
+// Compression rapide de blocs de caracteres, de la famille LZ77, au format de bloc LZ4
+// (sequences de litteraux et de references arriere vers des repetitions d'au moins 4 caracteres)
+// La compression privilegie la vitesse au taux de compression: elle est destinee aux fichiers
+// temporaires, pour lesquels le debit disque est le facteur limitant.
+// Les blocs sont compresses independamment les uns des autres, ce qui permet de les decompresser
+// dans n'importe quel ordre.
+class BlockCompressor : public Object
+{
+public:
+	// Taille max d'un bloc a compresser
+	// Les references arriere sont codees sur 16 bits, ce qui limite leur portee a un bloc de cette taille
+	static const int nMaxBlockSize = 65536;
+
+	// Taille max du resultat de la compression d'un bloc, dans le cas le pire d'un bloc incompressible
+	static int GetMaxCompressedSize(int nBlockSize);
+
+	// Compression d'un bloc source dans un bloc destination de taille max donnee
+	// Renvoie la taille compressee, ou 0 si le resultat ne tient pas dans le bloc destination
+	// En pratique, un bloc incompressible est a stocker tel quel si la compression renvoie 0
+	// pour une taille max egale a la taille du bloc source
+	static int Compress(const char* sSource, int nSourceSize, char* sDest, int nMaxDestSize);
+
+	// Decompression d'un bloc compresse dans un bloc destination de taille max donnee
+	// Renvoie la taille decompressee, ou -1 si le bloc compresse est incorrect ou si la taille
+	// destination est insuffisante
+	static int Decompress(const char* sSource, int nSourceSize, char* sDest, int nMaxDestSize);
+
+	// Methode de test
+	static void Test();
+
+	///////////////////////////////////////////////////////////////////////////////
+	///// Implementation
+protected:
+	// Parametres du format
+	// Taille minimale d'une repetition, nombre de litteraux obligatoires en fin de bloc,
+	// et distance min a la fin du bloc pour commencer une repetition
+	static const int nMinMatchLength = 4;
+	static const int nLastLiteralLength = 5;
+	static const int nMatchStartLimit = 12;
+
+	// Taille de la table de hashage des sequences de 4 caracteres
+	static const int nHashLog = 12;
+	static const int nHashSize = 1 << nHashLog;
+
+	// Lecture de 4 caracteres et hashage
+	static unsigned int Read32(const unsigned char* sPos);
+	static int Hash32(unsigned int nSequence);
+
+	// Ecriture d'une longueur dans le format de codage (suite de 255 terminee par un octet inferieur a 255)
+	static unsigned char* WriteLength(unsigned char* sDest, int nLength);
+};
+
+///////////////////////
+/// Methodes en inline
+
+inline int BlockCompressor::GetMaxCompressedSize(int nBlockSize)
+{
+	require(0 <= nBlockSize and nBlockSize <= nMaxBlockSize);
+	return nBlockSize + nBlockSize / 255 + 16;
+}
+
+inline unsigned int BlockCompressor::Read32(const unsigned char* sPos)
+{
+	return (unsigned int)sPos[0] | ((unsigned int)sPos[1] << 8) | ((unsigned int)sPos[2] << 16) |
+	       ((unsigned int)sPos[3] << 24);
+}
+
+inline int BlockCompressor::Hash32(unsigned int nSequence)
+{
+	return (int)((nSequence * 2654435761U) >> (32 - nHashLog));
+}
@@ -19,6 +19,7 @@ BufferedFile::BufferedFile()
 	nPreferredBufferSize = 0;
 	bOpenOnDemandMode = false;
 	bSilentMode = false;
+	bBlockCompression = false;
 }
 
 BufferedFile::~BufferedFile(void)
@@ -39,6 +40,7 @@ void BufferedFile::CopyFrom(const BufferedFile* bufferedFile)
 	fileHandle = NULL;
 	bIsOpened = false;
 	bSilentMode = bufferedFile->bSilentMode;
+	bBlockCompression = bufferedFile->bBlockCompression;
 }
 
 void BufferedFile::SetFileName(const ALString& sValue)
@@ -169,6 +171,55 @@ void BufferedFile::ResetBuffer()
 	nCurrentBufferSize = 0;
 }
 
+longint BufferedFile::GetMaxBlockCompressedSize(longint lSize)
+{
+	require(lSize >= 0);
+
+	// Par bloc: une entree d'index, plus une entree et une fin de session pour le dernier bloc, partiel,
+	// de chaque session
+	return lSize + (lSize / nCompressedBlockSize + 1) *
+			   (2 * nCompressionIndexEntrySize + (longint)nCompressionTrailerSize);
+}
+
+void BufferedFile::EncodeLittleEndian(char* sBuffer, longint lValue, int nByteNumber)
+{
+	int i;
+
+	require(sBuffer != NULL);
+	require(0 < nByteNumber and nByteNumber <= 8);
+
+	for (i = 0; i < nByteNumber; i++)
+	{
+		sBuffer[i] = (char)(lValue & 255);
+		lValue >>= 8;
+	}
+}
+
+longint BufferedFile::DecodeLittleEndian(const char* sBuffer, int nByteNumber)
+{
+	longint lValue;
+	int i;
+
+	require(sBuffer != NULL);
+	require(0 < nByteNumber and nByteNumber <= 8);
+
+	lValue = 0;
+	for (i = nByteNumber - 1; i >= 0; i--)
+		lValue = (lValue << 8) | (unsigned char)sBuffer[i];
+	return lValue;
+}
+
+char* BufferedFile::GetSegmentBuffer(const CharVector* cv, int nSegmentIndex)
+{
+	require(cv != NULL);
+	require(0 <= nSegmentIndex and nSegmentIndex <= (cv->GetSize() - 1) / CharVector::InternalGetBlockSize());
+
+	if (cv->InternalGetAllocSize() <= CharVector::InternalGetBlockSize())
+		return cv->InternalGetMonoBlockBuffer();
+	else
+		return cv->InternalGetMultiBlockBuffer(nSegmentIndex);
+}
+
 void BufferedFile::MoveLastSegmentsToHead(CharVector* cv, int nSegmentIndex)
 {
 	int nBlockNumber;
@@ -61,6 +61,20 @@ public:
 	// Taille du contenu du buffer
 	int GetCurrentBufferSize() const;
 
+	// Compression par blocs du contenu du fichier (defaut: false)
+	// Reservee aux fichiers temporaires, ecrits puis relus par l'outil: un fichier ecrit en mode compresse
+	// doit etre relu en mode compresse. En lecture, la taille du fichier (GetFileSize) et les positions
+	// sont celles du contenu decompresse, ce qui permet des lectures a une position quelconque
+	// Les tailles sur disque (FileService::GetFileSize) sont celles des fichiers compresses
+	// Parametrage a effectuer avant l'ouverture du fichier
+	void SetBlockCompression(boolean bValue);
+	boolean GetBlockCompression() const;
+
+	// Taille max sur disque d'un contenu ecrit en mode compression par blocs
+	// Les blocs incompressibles etant stockes tels quels, seuls l'index des blocs et les fins de session
+	// s'ajoutent au contenu dans le cas le pire, en supposant des sessions d'ecriture d'au moins un bloc
+	static longint GetMaxBlockCompressedSize(longint lSize);
+
 	// Taille preferee du buffer de fichier (cf. PLRemoteFileService)
 	// Taiile reactualise des que le nom de fichier est specifie (0 si non specifie)
 	// Cette taille est utilisee si possible pour les lectures/ecritures physiques dans le fichier
@@ -111,6 +125,38 @@ protected:
 	// Reinitialisation du buffer a vide
 	void ResetBuffer();
 
+	///////////////////////////////////////////////////////////////////////////////
+	// Format des fichiers compresses par blocs
+	// Un fichier compresse est une suite de sessions d'ecriture, une par ouverture du fichier en ecriture
+	// (Open ou OpenForAppend). Chaque session comporte:
+	//  - les blocs compresses, chacun correspondant a un segment du buffer d'au plus nCompressedBlockSize
+	//    caracteres; un bloc incompressible est stocke tel quel, avec une taille stockee egale a sa taille
+	//  - l'index des blocs de la session: pour chaque bloc, sa taille et sa taille stockee (4 octets chacune)
+	//  - une fin de session: nombre de blocs (4 octets), version du format (4 octets), taille totale
+	//    de la session (8 octets) et marqueur de format (8 octets)
+	// Les entiers sont stockes en little-endian
+	// On peut ainsi ajouter des sessions en fin de fichier sans relire le fichier, et reconstruire en lecture
+	// l'index de tous les blocs en parcourant les fins de session depuis la fin du fichier
+
+	// Taille des blocs, alignee sur les segments du buffer
+	static const int nCompressedBlockSize = (int)MemSegmentByteSize;
+
+	// Tailles d'une entree d'index et d'une fin de session
+	static const int nCompressionIndexEntrySize = 8;
+	static const int nCompressionTrailerSize = 24;
+
+	// Version du format et marqueur de fin de session
+	static const int nCompressionVersion = 1;
+	static const longint lCompressionMagic = 0x314B4C425A484B00;
+
+	// Codage et decodage d'un entier en little-endian sur un nombre d'octets donne
+	static void EncodeLittleEndian(char* sBuffer, longint lValue, int nByteNumber);
+	static longint DecodeLittleEndian(const char* sBuffer, int nByteNumber);
+
+	// Acces direct a un segment d'un vecteur de caracteres, de taille InternalGetBlockSize
+	// (ou a son unique bloc s'il n'est pas segmente)
+	static char* GetSegmentBuffer(const CharVector* cv, int nSegmentIndex);
+
 	// Deplace tous les segments a partir de nSegmentIndex vers le debut
 	// Les segments qui etaient au debut sont copies a la fin pour que toutes les adresses soient valides
 	void MoveLastSegmentsToHead(CharVector* cv, int nSegmentIndex);
@@ -156,6 +202,9 @@ protected:
 	// Separateur de champ
 	char cFieldSeparator;
 
+	// Compression par blocs
+	boolean bBlockCompression;
+
 	// Methodes privees tres techniques
 	// Mise a disposition des attributs protected aux classes friends
 	int InternalGetAllocSize() const;
@@ -251,6 +300,17 @@ inline int BufferedFile::InternalGetBufferSize() const
 	return fcCache.InternalGetBufferSize();
 }
 
+inline void BufferedFile::SetBlockCompression(boolean bValue)
+{
+	require(not IsOpened());
+	bBlockCompression = bValue;
+}
+
+inline boolean BufferedFile::GetBlockCompression() const
+{
+	return bBlockCompression;
+}
+
 inline int BufferedFile::GetCurrentBufferSize() const
 {
 	return nCurrentBufferSize;
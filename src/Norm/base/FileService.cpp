@@ -111,6 +111,33 @@ longint FileService::GetFileSize(const ALString& sFilePathName)
 	return lFileSize;
 }
 
+longint FileService::GetFileModificationTime(const ALString& sFilePathName)
+{
+	longint lModificationTime;
+	int nError;
+
+	p_SetMachineLocale();
+
+	// Meme API que pour la taille des fichiers
+#ifdef _WIN32
+	struct __stat64 fileStat;
+	nError = _stat64(sFilePathName, &fileStat);
+#elif defined(__APPLE__)
+	struct stat fileStat;
+	nError = stat(sFilePathName, &fileStat);
+#else
+	struct stat64 fileStat;
+	nError = stat64(sFilePathName, &fileStat);
+#endif
+
+	p_SetApplicationLocale();
+	if (nError != 0)
+		lModificationTime = 0;
+	else
+		lModificationTime = (longint)fileStat.st_mtime;
+	return lModificationTime;
+}
+
 boolean FileService::CreateEmptyFile(const ALString& sFilePathName)
 {
 	FILE* fFile;
@@ -385,6 +412,92 @@ boolean FileService::ReserveExtraSize(FILE* fFile, longint lSize)
 	return bOk;
 }
 
+boolean FileService::AppendBinaryFileContent(const ALString& sOutputFilePathName, FILE* fOutputFile,
+					      const ALString& sInputFilePathName)
+{
+	const int nBufferSize = 1024 * 1024;
+	boolean bOk;
+	FILE* fInputFile;
+	longint lRemainingSize;
+	longint lCopiedSize;
+	char* sBuffer;
+
+	require(fOutputFile != NULL);
+
+	// Ouverture du fichier a copier
+	bOk = OpenInputBinaryFile(sInputFilePathName, fInputFile);
+	if (bOk)
+	{
+		lRemainingSize = GetFileSize(sInputFilePathName);
+
+#ifdef __linux__
+		// Vidage prealable du buffer d'ecriture, pour ecrire directement via le descripteur du fichier
+		fflush(fOutputFile);
+		bOk = (ferror(fOutputFile) == 0);
+		if (not bOk)
+			Global::AddError("File", sOutputFilePathName,
+					 "Physical error when writing data to file " + GetLastSystemIOErrorMessage());
+
+		// Copie dans le noyau, par tranches d'au plus 1 Go
+		// On s'arrete sans erreur au premier echec (copie non supportee entre les deux systemes de
+		// fichiers par exemple), la suite etant traitee par la copie bufferisee
+		if (bOk and lRemainingSize > 0)
+		{
+			while (lRemainingSize > 0)
+			{
+				lCopiedSize = copy_file_range(fileno(fInputFile), NULL, fileno(fOutputFile), NULL,
+							      (size_t)min(lRemainingSize, (longint)lGB), 0);
+				if (lCopiedSize <= 0)
+					break;
+				lRemainingSize -= lCopiedSize;
+			}
+
+			// Resynchronisation des positions des fichiers avec celles de leur descripteur
+			bOk = SystemSeekPositionInBinaryFile(fOutputFile, lseek(fileno(fOutputFile), 0, SEEK_CUR),
+							     SEEK_SET);
+			if (bOk and lRemainingSize > 0)
+				bOk = SystemSeekPositionInBinaryFile(fInputFile, lseek(fileno(fInputFile), 0, SEEK_CUR),
+								     SEEK_SET);
+		}
+#endif // __linux__
+
+		// Copie bufferisee de ce qui reste a copier
+		if (bOk and lRemainingSize > 0)
+		{
+			sBuffer = NewCharArray(nBufferSize);
+			while (lRemainingSize > 0)
+			{
+				lCopiedSize = (longint)fread(sBuffer, sizeof(char),
+							     (size_t)min(lRemainingSize, (longint)nBufferSize),
+							     fInputFile);
+				if (lCopiedSize <= 0)
+				{
+					Global::AddError("File", sInputFilePathName,
+							 "Unable to read data from file " +
+							     GetLastSystemIOErrorMessage());
+					bOk = false;
+					break;
+				}
+				if ((longint)fwrite(sBuffer, sizeof(char), (size_t)lCopiedSize, fOutputFile) !=
+				    lCopiedSize)
+				{
+					Global::AddError("File", sOutputFilePathName,
+							 "Unable to write data to file " +
+							     GetLastSystemIOErrorMessage());
+					bOk = false;
+					break;
+				}
+				lRemainingSize -= lCopiedSize;
+			}
+			DeleteCharArray(sBuffer);
+		}
+
+		// Fermeture du fichier copie
+		bOk = CloseInputBinaryFile(sInputFilePathName, fInputFile) and bOk;
+	}
+	return bOk;
+}
+
 const ALString& FileService::GetEOL()
 {
 #ifdef _WIN32
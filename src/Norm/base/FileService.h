@@ -38,6 +38,10 @@ public:
 	// Renvoie 0 si probleme d'acces au fichier
 	static longint GetFileSize(const ALString& sFilePathName);
 
+	// Date de derniere modification d'un fichier, en secondes depuis le debut de l'epoque Unix
+	// Renvoie 0 si probleme d'acces au fichier
+	static longint GetFileModificationTime(const ALString& sFilePathName);
+
 	// Creation d'un fichier vide, ecrasement eventuellement si fichier existant
 	static boolean CreateEmptyFile(const ALString& sFilePathName);
 
@@ -81,6 +85,15 @@ public:
 	// Renvoie true si pas d'erreur, false sinon (avec message d'erreur technique)
 	static boolean ReserveExtraSize(FILE* fFile, longint lSize);
 
+	// Ajout du contenu complet d'un fichier binaire local a la position courante d'un fichier binaire
+	// ouvert en ecriture
+	// Sous Linux, la copie est effectuee dans le noyau (copy_file_range), sans transiter par la memoire
+	// du processus et en partageant si possible les blocs disque (reflink selon le systeme de fichier)
+	// Si la copie noyau n'est pas disponible, elle est terminee par une copie bufferisee standard
+	// Renvoie true si pas d'erreur, false sinon (avec message d'erreur)
+	static boolean AppendBinaryFileContent(const ALString& sOutputFilePathName, FILE* fOutputFile,
+					       const ALString& sInputFilePathName);
+
 	// Caractere fin de ligne
 	static const ALString& GetEOL();
 
@@ -5,12 +5,14 @@
 #include "InputBufferedFile.h"
 #include "SystemFileDriver.h"
 #include "HugeBuffer.h"
+#include "TimelineTracer.h"
 
 const unsigned char InputBufferedFile::cUTF8Bom[nUTF8BomSize] = {0xEF, 0xBB, 0xBF};
 int InputBufferedFile::nMaxLineLength = 8 * lMB;
 
 InputBufferedFile::InputBufferedFile()
 {
+	sDecompressedBlock = NULL;
 	Reset();
 	bUTF8BomManagement = true;
 	bCacheOn = true;
@@ -48,6 +50,7 @@ boolean InputBufferedFile::Open()
 	Reset();
 	lTotalPhysicalReadCalls = 0;
 	lTotalPhysicalReadBytes = 0;
+	timerPhysicalRead.Reset();
 	bOk = true;
 	fileHandle = new SystemFile;
 
@@ -76,6 +79,23 @@ boolean InputBufferedFile::Open()
 		}
 	}
 
+	// En mode compression par blocs, lecture de l'index des blocs, qui fournit la taille decompressee
+	if (bOk and bBlockCompression)
+	{
+		if (GetOpenOnDemandMode())
+		{
+			bOk = fileHandle->OpenInputFile(sLocalFileName);
+			if (not bOk)
+				AddError("Unable to open file (" + fileHandle->GetLastErrorMessage() + ")");
+		}
+		if (bOk)
+		{
+			bOk = ReadCompressionIndex(lFileSize);
+			if (GetOpenOnDemandMode() or not bOk)
+				fileHandle->CloseInputFile(sLocalFileName);
+		}
+	}
+
 	if (not bOk and fileHandle != NULL)
 	{
 		delete fileHandle;
@@ -1228,6 +1248,11 @@ longint InputBufferedFile::GetUsedMemory() const
 
 	lUsedMemory = BufferedFile::GetUsedMemory();
 	lUsedMemory += sizeof(InputBufferedFile) - sizeof(BufferedFile);
+	lUsedMemory += lvCompressedBlockEndPositions.GetUsedMemory() - sizeof(LongintVector);
+	lUsedMemory += lvCompressedBlockStoredPositions.GetUsedMemory() - sizeof(LongintVector);
+	lUsedMemory += ivCompressedBlockStoredSizes.GetUsedMemory() - sizeof(IntVector);
+	if (sDecompressedBlock != NULL)
+		lUsedMemory += nCompressedBlockSize;
 	return lUsedMemory;
 }
 
@@ -1360,6 +1385,11 @@ longint InputBufferedFile::GetTotalPhysicalReadBytes() const
 	return lTotalPhysicalReadBytes;
 }
 
+double InputBufferedFile::GetTotalPhysicalReadTime() const
+{
+	return timerPhysicalRead.GetElapsedTime();
+}
+
 boolean InputBufferedFile::Test(int nFileType)
 {
 	boolean bOk = true;
@@ -2308,6 +2338,120 @@ boolean InputBufferedFile::TestReadWrite(const ALString& sLabel, int nFileSize,
 	return bOk;
 }
 
+void InputBufferedFile::TestBlockCompression()
+{
+	const int nChunkSizeNumber = 4;
+	const int nChunkSizes[nChunkSizeNumber] = {1000, 65536, 100003, 1 * lMB};
+	boolean bOk;
+	boolean bSame;
+	OutputBufferedFile obFile;
+	InputBufferedFile ibFile;
+	CharVector cvContent;
+	ALString sFileName;
+	ALString sLine;
+	longint lFilePos;
+	unsigned int nRandom;
+	int nSession;
+	int nLineNumber;
+	int nLine;
+	int nChunk;
+	int nReadSize;
+	int nBackward;
+	int i;
+
+	// Ecriture en trois sessions: ouverture standard, puis ajouts en mode ouverture a la demande,
+	// dont un ajout vide. Des lignes pseudo-aleatoires produisent des blocs peu compressibles
+	sFileName = FileService::BuildFilePathName(FileService::GetTmpDir(), "KhiopsTestBlockCompression.txt");
+	obFile.SetFileName(sFileName);
+	obFile.SetBlockCompression(true);
+	obFile.SetBufferSize(256 * lKB);
+	nRandom = 1;
+	bOk = true;
+	cout << "Session\tSize" << endl;
+	for (nSession = 0; bOk and nSession < 3; nSession++)
+	{
+		obFile.SetOpenOnDemandMode(nSession > 0);
+		if (nSession == 0)
+			bOk = obFile.Open();
+		else
+			bOk = obFile.OpenForAppend();
+		if (bOk)
+		{
+			nLineNumber = (2 - nSession) * 10000;
+			for (nLine = 0; nLine < nLineNumber; nLine++)
+			{
+				sLine = IntToString(nLine);
+				sLine += "\tvalue_";
+				sLine += IntToString(nLine % 13);
+				sLine += "\t";
+				for (i = 0; nLine % 50 < 10 and i < 200; i++)
+				{
+					nRandom = nRandom * 1103515245 + 12345;
+					sLine += (char)('0' + (nRandom >> 16) % 64);
+				}
+				sLine += "\n";
+				obFile.Write(sLine);
+				for (i = 0; i < sLine.GetLength(); i++)
+					cvContent.Add(sLine.GetAt(i));
+			}
+			bOk = obFile.Close();
+		}
+		cout << nSession << "\t" << cvContent.GetSize() << endl;
+	}
+
+	// Le fichier doit etre plus petit sur disque
+	if (bOk)
+		cout << "Compressed\t" << BooleanToString(FileService::GetFileSize(sFileName) < cvContent.GetSize())
+		     << endl;
+
+	// Relecture par morceaux, non alignes sur les blocs, vers l'avant puis vers l'arriere
+	ibFile.SetFileName(sFileName);
+	ibFile.SetBlockCompression(true);
+	cout << "Chunk size\tDirection\tFile size\tIdentical" << endl;
+	for (nChunk = 0; bOk and nChunk < nChunkSizeNumber; nChunk++)
+	{
+		for (nBackward = 0; nBackward < 2; nBackward++)
+		{
+			ibFile.SetOpenOnDemandMode(nBackward == 1);
+			ibFile.SetBufferSize(nChunkSizes[nChunk]);
+			bSame = ibFile.Open();
+			bSame = bSame and ibFile.GetFileSize() == cvContent.GetSize();
+			if (bSame)
+			{
+				if (nBackward == 0)
+					lFilePos = 0;
+				else
+					lFilePos = max((longint)0, ibFile.GetFileSize() - nChunkSizes[nChunk]);
+				while (bSame and lFilePos < ibFile.GetFileSize())
+				{
+					nReadSize =
+					    (int)min((longint)nChunkSizes[nChunk], ibFile.GetFileSize() - lFilePos);
+					bSame = ibFile.InternalRawFillBytes(lFilePos, nReadSize);
+					for (i = 0; bSame and i < ibFile.GetCurrentBufferSize(); i++)
+						bSame = ibFile.fcCache.GetAt(ibFile.GetBufferStartInCache() + i) ==
+							cvContent.GetAt(lFilePos + i);
+
+					// Position du morceau suivant
+					if (nBackward == 0)
+						lFilePos += ibFile.GetCurrentBufferSize();
+					else if (lFilePos == 0)
+						lFilePos = ibFile.GetFileSize();
+					else
+						lFilePos = max((longint)0, lFilePos - nChunkSizes[nChunk]);
+				}
+			}
+			if (ibFile.IsOpened())
+				ibFile.Close();
+			cout << nChunkSizes[nChunk] << "\t" << (nBackward == 0 ? "forward" : "backward") << "\t"
+			     << cvContent.GetSize() << "\t" << BooleanToString(bSame) << endl;
+			bOk = bOk and bSame;
+		}
+	}
+
+	// Nettoyage
+	FileService::RemoveFile(sFileName);
+}
+
 void InputBufferedFile::Reset()
 {
 	ResetBuffer();
@@ -2324,6 +2468,13 @@ void InputBufferedFile::Reset()
 	nAllocatedBufferSize = 0;
 	nCacheSize = 0;
 	nUTF8BomSkippedCharNumber = 0;
+	lvCompressedBlockEndPositions.SetSize(0);
+	lvCompressedBlockStoredPositions.SetSize(0);
+	ivCompressedBlockStoredSizes.SetSize(0);
+	if (sDecompressedBlock != NULL)
+		DeleteCharArray(sDecompressedBlock);
+	sDecompressedBlock = NULL;
+	nDecompressedBlockIndex = -1;
 }
 
 boolean InputBufferedFile::InternalFillBytes(longint& lBeginPos, int nSizeToFill)
@@ -2570,6 +2721,8 @@ boolean InputBufferedFile::FillCache(longint lFilePos, int nSizeToCopy, int nPos
 	int nSizeToRead;
 	int nHugeBufferSize;
 	int nHugeReadSize;
+	longint lReadAheadPosition;
+	int nReadAheadSize;
 
 	require(0 <= lFilePos and lFilePos <= lFileSize);
 	assert(nSizeToCopy > 0);
@@ -2581,6 +2734,10 @@ boolean InputBufferedFile::FillCache(longint lFilePos, int nSizeToCopy, int nPos
 	// On ne copie pas plus que la taille du fichier
 	nSizeToCopy = (int)min((longint)nSizeToCopy, lFileSize - lFilePos);
 
+	// Cas du mode compression par blocs
+	if (bBlockCompression)
+		return FillCompressedCache(lFilePos, nSizeToCopy, nPosToCopy);
+
 	if (GetOpenOnDemandMode())
 		bOk = fileHandle->OpenInputFile(sLocalFileName);
 
@@ -2628,7 +2785,13 @@ boolean InputBufferedFile::FillCache(longint lFilePos, int nSizeToCopy, int nPos
 			nHugeReadSize = (nHugeBufferSize / GetPreferredBufferSize()) * GetPreferredBufferSize();
 			assert(nHugeReadSize > 0);
 
+			// Memorisation de la portion suivante du fichier, de meme taille, qui sera a priori lue ensuite
+			lReadAheadPosition = lFilePos + nSizeToCopy;
+			nReadAheadSize = (int)min((longint)nSizeToCopy, lFileSize - lReadAheadPosition);
+
 			// Boucle de lecture
+			TimelineTracer::Begin("InputBufferedFile read");
+			timerPhysicalRead.Start();
 			bOk = fileHandle->SeekPositionInFile(lFilePos);
 			if (not bOk)
 				AddError("Problem with seek in file (" + fileHandle->GetLastErrorMessage() + ")");
@@ -2651,6 +2814,14 @@ boolean InputBufferedFile::FillCache(longint lFilePos, int nSizeToCopy, int nPos
 					AddError("Unable to read file (" + fileHandle->GetLastErrorMessage() + ")");
 				}
 			}
+			timerPhysicalRead.Stop();
+
+			// Demande de lecture anticipee de la portion suivante, qui pourra etre chargee par le
+			// systeme pendant l'exploitation de la portion courante
+			if (bOk and nReadAheadSize > 0)
+				fileHandle->ReadAhead(lReadAheadPosition, nReadAheadSize);
+			TimelineTracer::End("InputBufferedFile read");
+			TimelineTracer::Counter("InputBufferedFile read bytes", lTotalPhysicalReadBytes);
 
 			// Ajout de stats memoire
 			if (FileService::LogIOStats())
@@ -2666,6 +2837,311 @@ boolean InputBufferedFile::FillCache(longint lFilePos, int nSizeToCopy, int nPos
 	return bOk;
 }
 
+boolean InputBufferedFile::FillCompressedCache(longint lFilePos, int nSizeToCopy, int nPosToCopy)
+{
+	boolean bOk = true;
+	char* sBuffer;
+	int nHugeBufferSize;
+	longint lFillEndPos;
+	int nBlock;
+	int nBlockSize;
+	int nBlockOffset;
+	int nCopySize;
+	int nDecompressedSize;
+	int nRunFirstBlock;
+	int nRunEndBlock;
+	int nRunSize;
+	const char* sStoredBlock;
+	longint lRunOffset;
+	longint lReadAheadPosition;
+	int nReadAheadSize;
+
+	require(bBlockCompression);
+	require(0 <= lFilePos and lFilePos < lFileSize);
+	require(0 < nSizeToCopy and lFilePos + nSizeToCopy <= lFileSize);
+	require(nPosToCopy >= 0);
+
+	if (GetOpenOnDemandMode())
+		bOk = fileHandle->OpenInputFile(sLocalFileName);
+
+	if (bOk)
+	{
+		// Ajout de stats memoire
+		if (FileService::LogIOStats())
+			MemoryStatsManager::AddLog(GetClassLabel() + " BasicFill Begin");
+
+		// Reallocation du buffer selon la taille demandee
+		nCacheSize = nSizeToCopy + nPosToCopy;
+		nAllocatedBufferSize = nCacheSize;
+		bOk = AllocateBuffer();
+		if (bOk)
+		{
+			if (sDecompressedBlock == NULL)
+				sDecompressedBlock = NewCharArray(nCompressedBlockSize);
+
+			// Les blocs compresses sont lus dans le buffer de lecture, qui peut en contenir au moins un
+			sBuffer = GetHugeBuffer(max(GetPreferredBufferSize(), (int)nCompressedBlockSize));
+			nHugeBufferSize = GetHugeBufferSize();
+
+			// Parcours des blocs a partir de celui contenant la position de depart
+			TimelineTracer::Begin("InputBufferedFile read");
+			lFillEndPos = lFilePos + nSizeToCopy;
+			nBlock = SearchCompressedBlock(lFilePos);
+			nRunFirstBlock = nBlock;
+			nRunEndBlock = nBlock;
+			lReadAheadPosition = 0;
+			nReadAheadSize = 0;
+			while (bOk and nSizeToCopy > 0)
+			{
+				nBlockSize = (int)(lvCompressedBlockEndPositions.GetAt(nBlock) -
+						   GetCompressedBlockStartPosition(nBlock));
+
+				// Decompression du bloc, sauf s'il l'a deja ete lors du remplissage precedent
+				if (nBlock != nDecompressedBlockIndex)
+				{
+					// Lecture en une seule fois des blocs suivants necessaires et contigus
+					if (nBlock >= nRunEndBlock)
+					{
+						nRunFirstBlock = nBlock;
+						nRunEndBlock = nBlock;
+						nRunSize = 0;
+						while (nRunEndBlock < lvCompressedBlockEndPositions.GetSize() and
+						       GetCompressedBlockStartPosition(nRunEndBlock) < lFillEndPos and
+						       lvCompressedBlockStoredPositions.GetAt(nRunEndBlock) ==
+							   lvCompressedBlockStoredPositions.GetAt(nBlock) + nRunSize and
+						       nRunSize + ivCompressedBlockStoredSizes.GetAt(nRunEndBlock) <=
+							   nHugeBufferSize)
+						{
+							nRunSize += ivCompressedBlockStoredSizes.GetAt(nRunEndBlock);
+							nRunEndBlock++;
+						}
+						assert(nRunEndBlock > nBlock);
+						bOk = ReadCompressedBytes(lvCompressedBlockStoredPositions.GetAt(nBlock),
+									  nRunSize, sBuffer);
+
+						// Memorisation de la portion suivante du fichier, de meme taille
+						lReadAheadPosition =
+						    lvCompressedBlockStoredPositions.GetAt(nBlock) + nRunSize;
+						nReadAheadSize = nRunSize;
+					}
+
+					// Decompression, ou simple copie pour un bloc stocke tel quel
+					if (bOk)
+					{
+						lRunOffset = lvCompressedBlockStoredPositions.GetAt(nBlock) -
+							     lvCompressedBlockStoredPositions.GetAt(nRunFirstBlock);
+						sStoredBlock = &sBuffer[lRunOffset];
+						if (ivCompressedBlockStoredSizes.GetAt(nBlock) == nBlockSize)
+						{
+							memcpy(sDecompressedBlock, sStoredBlock, nBlockSize);
+							nDecompressedSize = nBlockSize;
+						}
+						else
+							nDecompressedSize = BlockCompressor::Decompress(
+							    sStoredBlock, ivCompressedBlockStoredSizes.GetAt(nBlock),
+							    sDecompressedBlock, nBlockSize);
+						bOk = nDecompressedSize == nBlockSize;
+						if (bOk)
+							nDecompressedBlockIndex = nBlock;
+						else
+						{
+							nDecompressedBlockIndex = -1;
+							AddError("Unable to read file (corrupted compressed block)");
+						}
+					}
+				}
+
+				// Copie de la partie utile du bloc dans le cache
+				if (bOk)
+				{
+					nBlockOffset = (int)(lFilePos - GetCompressedBlockStartPosition(nBlock));
+					nCopySize = min(nSizeToCopy, nBlockSize - nBlockOffset);
+					fcCache.cvBuffer.ImportBuffer(nPosToCopy, nCopySize,
+								      &sDecompressedBlock[nBlockOffset]);
+					lFilePos += nCopySize;
+					nSizeToCopy -= nCopySize;
+					nPosToCopy += nCopySize;
+					nBlock++;
+				}
+			}
+
+			// Demande de lecture anticipee de la portion suivante
+			if (bOk and nReadAheadSize > 0)
+				fileHandle->ReadAhead(lReadAheadPosition, nReadAheadSize);
+			TimelineTracer::End("InputBufferedFile read");
+			TimelineTracer::Counter("InputBufferedFile read bytes", lTotalPhysicalReadBytes);
+
+			// Ajout de stats memoire
+			if (FileService::LogIOStats())
+				MemoryStatsManager::AddLog(GetClassLabel() + " BasicFill End");
+		}
+		if (GetOpenOnDemandMode())
+		{
+			bOk = fileHandle->CloseInputFile(sLocalFileName) and bOk;
+			if (not bOk)
+				AddError("Unable to read file (" + fileHandle->GetLastErrorMessage() + ")");
+		}
+	}
+	return bOk;
+}
+
+boolean InputBufferedFile::ReadCompressionIndex(longint lPhysicalFileSize)
+{
+	boolean bOk = true;
+	boolean bFormatOk = true;
+	LongintVector lvSessionEndPositions;
+	IntVector ivSessionBlockNumbers;
+	char sTrailer[nCompressionTrailerSize];
+	char* sIndex;
+	longint lSessionEnd;
+	longint lSessionSize;
+	longint lIndexPosition;
+	longint lStoredPosition;
+	longint lEndPosition;
+	int nBlockNumber;
+	int nSession;
+	int nBlockSize;
+	int nStoredSize;
+	int i;
+
+	require(bBlockCompression);
+	require(lPhysicalFileSize >= 0);
+
+	// Parcours des fins de session depuis la fin du fichier
+	lSessionEnd = lPhysicalFileSize;
+	while (bOk and bFormatOk and lSessionEnd > 0)
+	{
+		bFormatOk = lSessionEnd >= nCompressionTrailerSize;
+		if (bFormatOk)
+			bOk = ReadCompressedBytes(lSessionEnd - nCompressionTrailerSize, nCompressionTrailerSize,
+						  sTrailer);
+		if (bOk and bFormatOk)
+		{
+			nBlockNumber = (int)DecodeLittleEndian(sTrailer, 4);
+			lSessionSize = DecodeLittleEndian(&sTrailer[8], 8);
+			bFormatOk = DecodeLittleEndian(&sTrailer[16], 8) == lCompressionMagic and
+				    DecodeLittleEndian(&sTrailer[4], 4) == nCompressionVersion and nBlockNumber >= 0 and
+				    lSessionSize >= nCompressionTrailerSize +
+						       (longint)nBlockNumber * nCompressionIndexEntrySize and
+				    lSessionSize <= lSessionEnd;
+			if (bFormatOk)
+			{
+				lvSessionEndPositions.Add(lSessionEnd);
+				ivSessionBlockNumbers.Add(nBlockNumber);
+				lSessionEnd -= lSessionSize;
+			}
+		}
+	}
+
+	// Lecture des index de chaque session, dans l'ordre du fichier
+	lEndPosition = 0;
+	for (nSession = lvSessionEndPositions.GetSize() - 1; bOk and bFormatOk and nSession >= 0; nSession--)
+	{
+		nBlockNumber = ivSessionBlockNumbers.GetAt(nSession);
+		lIndexPosition = lvSessionEndPositions.GetAt(nSession) - nCompressionTrailerSize -
+				 (longint)nBlockNumber * nCompressionIndexEntrySize;
+		if (nSession == lvSessionEndPositions.GetSize() - 1)
+			lStoredPosition = 0;
+		else
+			lStoredPosition = lvSessionEndPositions.GetAt(nSession + 1);
+		if (nBlockNumber > 0)
+		{
+			sIndex = GetHugeBuffer(nBlockNumber * nCompressionIndexEntrySize);
+			bOk = ReadCompressedBytes(lIndexPosition, nBlockNumber * nCompressionIndexEntrySize, sIndex);
+			for (i = 0; bOk and bFormatOk and i < nBlockNumber; i++)
+			{
+				nBlockSize = (int)DecodeLittleEndian(&sIndex[i * nCompressionIndexEntrySize], 4);
+				nStoredSize = (int)DecodeLittleEndian(&sIndex[i * nCompressionIndexEntrySize + 4], 4);
+				bFormatOk = 0 < nBlockSize and nBlockSize <= nCompressedBlockSize and 0 < nStoredSize and
+					    nStoredSize <= nBlockSize;
+				lEndPosition += nBlockSize;
+				lvCompressedBlockEndPositions.Add(lEndPosition);
+				lvCompressedBlockStoredPositions.Add(lStoredPosition);
+				ivCompressedBlockStoredSizes.Add(nStoredSize);
+				lStoredPosition += nStoredSize;
+			}
+		}
+
+		// Les blocs doivent occuper exactement la session, avant son index
+		bFormatOk = bFormatOk and lStoredPosition == lIndexPosition;
+	}
+
+	// Taille du fichier decompresse
+	if (bOk and not bFormatOk)
+	{
+		bOk = false;
+		AddError("Unable to read file (incorrect block compressed format)");
+	}
+	if (bOk)
+		lFileSize = lEndPosition;
+	return bOk;
+}
+
+boolean InputBufferedFile::ReadCompressedBytes(longint lPos, int nSize, char* sBytes)
+{
+	boolean bOk;
+	int nLocalRead;
+	int nTotalRead;
+
+	require(bBlockCompression);
+	require(lPos >= 0);
+	require(nSize > 0);
+	require(sBytes != NULL);
+
+	timerPhysicalRead.Start();
+	bOk = fileHandle->SeekPositionInFile(lPos);
+	if (not bOk)
+		AddError("Problem with seek in file (" + fileHandle->GetLastErrorMessage() + ")");
+	nTotalRead = 0;
+	while (bOk and nTotalRead < nSize)
+	{
+		nLocalRead = (int)fileHandle->Read(&sBytes[nTotalRead], sizeof(char), (size_t)(nSize - nTotalRead));
+		lTotalPhysicalReadCalls++;
+		lTotalPhysicalReadBytes += nLocalRead;
+		bOk = nLocalRead != 0;
+		if (bOk)
+			nTotalRead += nLocalRead;
+		else
+			AddError("Unable to read file (" + fileHandle->GetLastErrorMessage() + ")");
+	}
+	timerPhysicalRead.Stop();
+	return bOk;
+}
+
+int InputBufferedFile::SearchCompressedBlock(longint lPos) const
+{
+	int nLower;
+	int nUpper;
+	int nMiddle;
+
+	require(0 <= lPos and lPos < lFileSize);
+	require(lvCompressedBlockEndPositions.GetSize() > 0);
+
+	// Recherche dichotomique du premier bloc se terminant apres la position
+	nLower = 0;
+	nUpper = lvCompressedBlockEndPositions.GetSize() - 1;
+	while (nLower < nUpper)
+	{
+		nMiddle = (nLower + nUpper) / 2;
+		if (lvCompressedBlockEndPositions.GetAt(nMiddle) <= lPos)
+			nLower = nMiddle + 1;
+		else
+			nUpper = nMiddle;
+	}
+	ensure(GetCompressedBlockStartPosition(nLower) <= lPos and lPos < lvCompressedBlockEndPositions.GetAt(nLower));
+	return nLower;
+}
+
+longint InputBufferedFile::GetCompressedBlockStartPosition(int nBlock) const
+{
+	require(0 <= nBlock and nBlock < lvCompressedBlockEndPositions.GetSize());
+
+	if (nBlock == 0)
+		return 0;
+	else
+		return lvCompressedBlockEndPositions.GetAt(nBlock - 1);
+}
+
 boolean InputBufferedFile::DetectUTF8Bom() const
 {
 	require(GetPositionInFile() == 0);
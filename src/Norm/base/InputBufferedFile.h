@@ -5,6 +5,7 @@
 #pragma once
 
 #include "BufferedFile.h"
+#include "BlockCompressor.h"
 #include "Timer.h"
 #include "Vector.h"
 #include "PLRemoteFileService.h"
@@ -331,6 +332,9 @@ public:
 	// Nombre total d'octets lus
 	longint GetTotalPhysicalReadBytes() const;
 
+	// Temps total passe en attente des lectures physiques (en secondes)
+	double GetTotalPhysicalReadTime() const;
+
 	///////////////////////////////////////////////////////////////////////////////////////////
 	// Test de la classe
 
@@ -394,6 +398,10 @@ public:
 	// de nombreux parametres de lecture
 	static boolean TestCountExtensive();
 
+	// Test du mode compression par blocs: ecriture d'un fichier en plusieurs sessions, puis relecture
+	// par morceaux de tailles variees, vers l'avant et vers l'arriere
+	static void TestBlockCompression();
+
 	///////////////////////////////////////////////////////////////////////////////
 	///// Implementation
 
@@ -450,6 +458,23 @@ protected:
 	// Le contenu du fichier copie est situe a lFilePos et est d'une taille de nSizeToCopy
 	boolean FillCache(longint lFilePos, int nSizeToCopy, int nPosToCopy);
 
+	// Variante de FillCache en mode compression par blocs
+	// Les blocs compresses contigus sont lus en une fois, puis decompresses dans le cache
+	boolean FillCompressedCache(longint lFilePos, int nSizeToCopy, int nPosToCopy);
+
+	// Lecture de l'index des blocs d'un fichier compresse, a partir des fins de session
+	// Le fichier doit etre physiquement ouvert; la taille du fichier est alors la taille decompressee
+	boolean ReadCompressionIndex(longint lPhysicalFileSize);
+
+	// Lecture physique d'une portion de fichier dans un tableau de caracteres, en mode compression par blocs
+	boolean ReadCompressedBytes(longint lPos, int nSize, char* sBytes);
+
+	// Index du bloc compresse contenant une position du fichier decompresse
+	int SearchCompressedBlock(longint lPos) const;
+
+	// Position de debut d'un bloc compresse dans le fichier decompresse
+	longint GetCompressedBlockStartPosition(int nBlock) const;
+
 	// Detection de la presence de BOM UTF8
 	boolean DetectUTF8Bom() const;
 
@@ -525,6 +550,24 @@ protected:
 	// Nombre total d'octets lus
 	longint lTotalPhysicalReadBytes;
 
+	// Temps passe en attente des lectures physiques
+	Timer timerPhysicalRead;
+
+	///////////////////////////////////////////
+	// Index des blocs en mode compression
+
+	// Position de fin de chaque bloc dans le fichier decompresse
+	LongintVector lvCompressedBlockEndPositions;
+
+	// Position de debut et taille de chaque bloc dans le fichier physique
+	LongintVector lvCompressedBlockStoredPositions;
+	IntVector ivCompressedBlockStoredSizes;
+
+	// Dernier bloc decompresse, conserve pour le remplissage suivant du cache qui commence souvent
+	// dans ce meme bloc (-1 si aucun)
+	char* sDecompressedBlock;
+	int nDecompressedBlockIndex;
+
 	// Classes friend pour permettre a la librairie Parallel de gerer les fichiers distants
 	friend class PLMPIFileServerSlave; // Serialisation des attributs InputBuffer pour les servers de fichiers
 					   // (methode GetCache())
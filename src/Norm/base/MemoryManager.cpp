@@ -32,6 +32,7 @@ static const longint MemHeapInitialSystemMemory =
     4194304; // Taille systeme initiale estimee, au lancement d'un programme
 static longint MemHeapMemory = MemHeapInitialSystemMemory;               // Taille de heap courante
 static longint MemHeapMaxRequestedMemory = MemHeapInitialSystemMemory;   // Taille de heap max
+static longint MemHeapPeakMemory = MemHeapInitialSystemMemory;           // Taille de heap max depuis reinitialisation
 static longint MemHeapTotalRequestedMemory = MemHeapInitialSystemMemory; // Total des allocations sur la heap
 static longint MemHeapCurrentSegmentNumber = 0; // Nombre courant de segments systemes alloues sur la heap
 
@@ -67,6 +68,8 @@ inline boolean MemHeapUpdateAlloc(size_t nSize)
 		MemHeapMemory += nSize;
 		if (MemHeapMemory > MemHeapMaxRequestedMemory)
 			MemHeapMaxRequestedMemory = MemHeapMemory;
+		if (MemHeapMemory > MemHeapPeakMemory)
+			MemHeapPeakMemory = MemHeapMemory;
 		MemHeapTotalRequestedMemory += nSize;
 
 		// On indique que l'allocation est possible
@@ -2471,6 +2474,22 @@ longint MemGetMaxHeapRequestedMemory()
 #endif // RELEASENEWMEM
 }
 
+longint MemGetHeapPeakMemory()
+{
+#ifdef RELEASENEWMEM
+	return MemHeapPeakMemory;
+#else
+	return 0;
+#endif // RELEASENEWMEM
+}
+
+void MemResetHeapPeakMemory()
+{
+#ifdef RELEASENEWMEM
+	MemHeapPeakMemory = MemHeapMemory;
+#endif // RELEASENEWMEM
+}
+
 longint MemGetTotalHeapRequestedMemory()
 {
 #ifdef RELEASENEWMEM
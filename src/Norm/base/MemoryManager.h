@@ -227,6 +227,13 @@ longint MemGetHeapMemory();
 // Taille approximative de la memoire max alloue dans la heap depuis le debut du programme
 longint MemGetMaxHeapRequestedMemory();
 
+// Pic de la memoire alloue dans la heap depuis sa derniere reinitialisation
+// Permet de mesurer la memoire utilisee pendant un traitement, par difference avec la taille
+// de la heap (MemGetHeapMemory) au debut du traitement
+// La reinitialisation ramene le pic a la taille courante de la heap
+longint MemGetHeapPeakMemory();
+void MemResetHeapPeakMemory();
+
 // Taille approximative de la memoire totale demandee dans la heap depuis le debut du programme
 longint MemGetTotalHeapRequestedMemory();
 
@@ -11,6 +11,8 @@ OutputBufferedFile::OutputBufferedFile()
 	bNextOpenOnAppend = false;
 	lTotalPhysicalWriteCalls = 0;
 	lTotalPhysicalWriteBytes = 0;
+	timerPhysicalWrite.Reset();
+	lCompressedSessionSize = 0;
 }
 
 OutputBufferedFile::~OutputBufferedFile()
@@ -43,6 +45,10 @@ boolean OutputBufferedFile::Open()
 	bNextOpenOnAppend = false;
 	lTotalPhysicalWriteCalls = 0;
 	lTotalPhysicalWriteBytes = 0;
+	timerPhysicalWrite.Reset();
+	ivCompressedBlockSizes.SetSize(0);
+	ivCompressedBlockStoredSizes.SetSize(0);
+	lCompressedSessionSize = 0;
 
 	// Ouverture du fichier
 	if (bOk)
@@ -80,6 +86,10 @@ boolean OutputBufferedFile::OpenForAppend()
 	bOk = AllocateBuffer();
 	lTotalPhysicalWriteCalls = 0;
 	lTotalPhysicalWriteBytes = 0;
+	timerPhysicalWrite.Reset();
+	ivCompressedBlockSizes.SetSize(0);
+	ivCompressedBlockStoredSizes.SetSize(0);
+	lCompressedSessionSize = 0;
 
 	// Ouverture du fichier
 	if (bOk)
@@ -109,9 +119,11 @@ boolean OutputBufferedFile::Close()
 	require(IsOpened());
 	assert(fileHandle != NULL);
 
-	// Ecriture du contenu du buffer
+	// Ecriture du contenu du buffer, suivi de l'index des blocs en mode compression
 	if (not bIsError)
 		WriteToFile(nCurrentBufferSize);
+	if (bBlockCompression and not bIsError)
+		WriteCompressionIndex();
 	bOk = not bIsError;
 
 	// Fermeture du fichier
@@ -129,6 +141,8 @@ boolean OutputBufferedFile::Close()
 	bIsError = false;
 	nCurrentBufferSize = 0;
 	bNextOpenOnAppend = false;
+	ivCompressedBlockSizes.SetSize(0);
+	ivCompressedBlockStoredSizes.SetSize(0);
 	ResetBuffer();
 
 	ensure(fileHandle == NULL);
@@ -141,6 +155,8 @@ longint OutputBufferedFile::GetUsedMemory() const
 
 	lUsedMemory = BufferedFile::GetUsedMemory();
 	lUsedMemory += sizeof(OutputBufferedFile) - sizeof(BufferedFile);
+	lUsedMemory += ivCompressedBlockSizes.GetUsedMemory() - sizeof(IntVector);
+	lUsedMemory += ivCompressedBlockStoredSizes.GetUsedMemory() - sizeof(IntVector);
 	return lUsedMemory;
 }
 
@@ -154,6 +170,10 @@ void OutputBufferedFile::ReserveExtraSize(longint lSize)
 	if (GetOpenOnDemandMode())
 		return;
 
+	// En mode compression par blocs, la place reservee ne serait pas entierement ecrite
+	if (bBlockCompression)
+		return;
+
 	// On reserve de la taille que si necessaire par rapport a la taille de buffer courante geree par rapport au
 	// flush et que l'on s'apprete a consommer plus de un buffer
 	if (GetCurrentBufferSize() + lSize > 2 * GetBufferSize())
@@ -170,6 +190,11 @@ longint OutputBufferedFile::GetTotalPhysicalWriteBytes() const
 	return lTotalPhysicalWriteBytes;
 }
 
+double OutputBufferedFile::GetTotalPhysicalWriteTime() const
+{
+	return timerPhysicalWrite.GetElapsedTime();
+}
+
 void OutputBufferedFile::TestWriteFile(const ALString& sInputFileName, const ALString& sOutputFileName,
 				       boolean bOpenOnDemand)
 {
@@ -453,6 +478,10 @@ boolean OutputBufferedFile::WriteToFile(int nSizeToWrite)
 
 	assert(fileHandle != NULL);
 
+	// Cas du mode compression par blocs
+	if (bBlockCompression)
+		return WriteCompressedToFile(nSizeToWrite);
+
 	if (nSizeToWrite > 0)
 	{
 		if (not bIsPhysicalOpen)
@@ -490,7 +519,9 @@ boolean OutputBufferedFile::WriteToFile(int nSizeToWrite)
 				nLocalWrite = min(nHugeWriteSize, nSizeToWrite);
 				fcCache.cvBuffer.ExportBuffer(nSizeWritten, nLocalWrite, sBuffer);
 				nSizeWritten += nLocalWrite;
+				timerPhysicalWrite.Start();
 				lWrittenNumber = fileHandle->Write(sBuffer, sizeof(char), nLocalWrite);
+				timerPhysicalWrite.Stop();
 				assert(lWrittenNumber == 0 or lWrittenNumber == nLocalWrite);
 				lTotalPhysicalWriteCalls++;
 				lTotalPhysicalWriteBytes += nLocalWrite;
@@ -518,6 +549,152 @@ boolean OutputBufferedFile::WriteToFile(int nSizeToWrite)
 	return not bIsError;
 }
 
+boolean OutputBufferedFile::WriteCompressedToFile(int nSizeToWrite)
+{
+	boolean bOk = true;
+	int nHugeBufferSize;
+	char* sBuffer;
+	int nBufferUsed;
+	int nBlockNumber;
+	int nBlock;
+	int nBlockSize;
+	int nStoredSize;
+	char* sBlock;
+
+	require(bBlockCompression);
+	require(0 <= nSizeToWrite and nSizeToWrite <= nCurrentBufferSize);
+	require(nCompressedBlockSize == InternalGetBlockSize());
+	assert(fileHandle != NULL);
+
+	if (nSizeToWrite > 0)
+	{
+		if (not bIsPhysicalOpen)
+		{
+			assert(GetOpenOnDemandMode());
+			bOk = PhysicalOpen();
+		}
+		if (bOk)
+		{
+			// Les blocs compresses sont accumules dans le buffer d'ecriture, assez grand pour contenir
+			// au moins deux blocs incompressibles
+			nHugeBufferSize = max(GetPreferredBufferSize(), 2 * nCompressedBlockSize);
+			sBuffer = GetHugeBuffer(nHugeBufferSize);
+			nHugeBufferSize = GetHugeBufferSize();
+			nBufferUsed = 0;
+
+			// Compression de chaque segment du buffer, le dernier pouvant etre partiel
+			nBlockNumber = (nSizeToWrite + nCompressedBlockSize - 1) / nCompressedBlockSize;
+			for (nBlock = 0; nBlock < nBlockNumber; nBlock++)
+			{
+				nBlockSize =
+				    min((int)nCompressedBlockSize, nSizeToWrite - nBlock * nCompressedBlockSize);
+				sBlock = GetSegmentBuffer(&fcCache.cvBuffer, nBlock);
+
+				// Compression, le bloc etant stocke tel quel s'il est incompressible
+				nStoredSize =
+				    BlockCompressor::Compress(sBlock, nBlockSize, &sBuffer[nBufferUsed], nBlockSize - 1);
+				if (nStoredSize == 0)
+				{
+					memcpy(&sBuffer[nBufferUsed], sBlock, nBlockSize);
+					nStoredSize = nBlockSize;
+				}
+				nBufferUsed += nStoredSize;
+				ivCompressedBlockSizes.Add(nBlockSize);
+				ivCompressedBlockStoredSizes.Add(nStoredSize);
+
+				// Ecriture si le buffer ne peut plus contenir un bloc
+				if (nBufferUsed > nHugeBufferSize - nCompressedBlockSize or nBlock == nBlockNumber - 1)
+				{
+					bOk = WriteCompressedBytes(sBuffer, nBufferUsed);
+					nBufferUsed = 0;
+					if (not bOk)
+						break;
+				}
+			}
+
+			// On decale ce qui reste au debut du cache : ca sera ecrit lors du prochain Flush
+			if (bOk)
+			{
+				nCurrentBufferSize -= nSizeToWrite;
+				if (nCurrentBufferSize > 0)
+				{
+					assert(nSizeToWrite % nCompressedBlockSize == 0);
+					MoveLastSegmentsToHead(&fcCache.cvBuffer, nSizeToWrite / nCompressedBlockSize);
+				}
+			}
+		}
+	}
+	bIsError = not bOk;
+	return not bIsError;
+}
+
+boolean OutputBufferedFile::WriteCompressionIndex()
+{
+	boolean bOk = true;
+	int nIndexSize;
+	char* sBuffer;
+	int i;
+
+	require(bBlockCompression);
+	require(ivCompressedBlockSizes.GetSize() == ivCompressedBlockStoredSizes.GetSize());
+	assert(fileHandle != NULL);
+
+	// Ouverture si necessaire, y compris pour une session vide
+	if (not bIsPhysicalOpen)
+	{
+		assert(GetOpenOnDemandMode());
+		bOk = PhysicalOpen();
+	}
+
+	// Ecriture de l'index des blocs, suivi de la fin de session
+	if (bOk)
+	{
+		nIndexSize = ivCompressedBlockSizes.GetSize() * nCompressionIndexEntrySize + nCompressionTrailerSize;
+		sBuffer = GetHugeBuffer(nIndexSize);
+		for (i = 0; i < ivCompressedBlockSizes.GetSize(); i++)
+		{
+			EncodeLittleEndian(&sBuffer[i * nCompressionIndexEntrySize], ivCompressedBlockSizes.GetAt(i), 4);
+			EncodeLittleEndian(&sBuffer[i * nCompressionIndexEntrySize + 4],
+					   ivCompressedBlockStoredSizes.GetAt(i), 4);
+		}
+		i = ivCompressedBlockSizes.GetSize() * nCompressionIndexEntrySize;
+		EncodeLittleEndian(&sBuffer[i], ivCompressedBlockSizes.GetSize(), 4);
+		EncodeLittleEndian(&sBuffer[i + 4], nCompressionVersion, 4);
+		EncodeLittleEndian(&sBuffer[i + 8], lCompressedSessionSize + nIndexSize, 8);
+		EncodeLittleEndian(&sBuffer[i + 16], lCompressionMagic, 8);
+		bOk = WriteCompressedBytes(sBuffer, nIndexSize);
+	}
+	bIsError = not bOk;
+	return not bIsError;
+}
+
+boolean OutputBufferedFile::WriteCompressedBytes(const char* sBytes, int nSize)
+{
+	longint lWrittenNumber;
+
+	require(bBlockCompression);
+	require(bIsPhysicalOpen);
+	require(sBytes != NULL);
+	require(nSize > 0);
+
+	// Reserve de la taille qui va etre ecrite, pour garder la coherence de la gestion des reserves du fichier
+	fileHandle->ReserveExtraSize(nSize);
+
+	timerPhysicalWrite.Start();
+	lWrittenNumber = fileHandle->Write(sBytes, sizeof(char), nSize);
+	timerPhysicalWrite.Stop();
+	assert(lWrittenNumber == 0 or lWrittenNumber == nSize);
+	lTotalPhysicalWriteCalls++;
+	lTotalPhysicalWriteBytes += nSize;
+	lCompressedSessionSize += nSize;
+	if (lWrittenNumber == 0)
+	{
+		AddError("Unable to write file (" + fileHandle->GetLastErrorMessage() + ")");
+		return false;
+	}
+	return true;
+}
+
 boolean OutputBufferedFile::FlushCache()
 {
 	boolean bOk = true;
@@ -535,9 +712,18 @@ boolean OutputBufferedFile::FlushCache()
 
 	if (bOk)
 	{
+		// En mode compression, ecriture d'un multiple de la taille des blocs compresses, sauf dans le
+		// cas particulier ou le buffer est plus petit qu'un bloc
+		if (bBlockCompression)
+		{
+			if (nBufferSize > nCompressedBlockSize)
+				nSizeToWrite = (nCurrentBufferSize / nCompressedBlockSize) * nCompressedBlockSize;
+			else
+				nSizeToWrite = nCurrentBufferSize;
+		}
 		// Ecriture d'un multiple de  GetPreferredBufferSize() sauf dans la cas particulier ou
 		// le buffer est plus petit que GetPreferredBufferSize
-		if (nBufferSize > GetPreferredBufferSize())
+		else if (nBufferSize > GetPreferredBufferSize())
 			nSizeToWrite = (nCurrentBufferSize / GetPreferredBufferSize()) * GetPreferredBufferSize();
 		else
 			nSizeToWrite = nCurrentBufferSize;
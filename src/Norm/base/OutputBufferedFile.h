@@ -5,8 +5,10 @@
 #pragma once
 
 #include "BufferedFile.h"
+#include "BlockCompressor.h"
 #include "PLRemoteFileService.h"
 #include "Timer.h"
+#include "Vector.h"
 
 // Classe qui permet d'ecrire dans un fichier.
 // Les donnees sont bufferisees avant ecriture pour minimiser l'acces au fichier.
@@ -49,6 +51,7 @@ public:
 
 	// Methode technique, reserve un espace sur le dique pour le fichier ouvert ce qui permet
 	// d'eviter de la fragmentation lors de l'ecriture de ce fichier
+	// Sans effet en mode compression par blocs, la taille ecrite n'etant pas connue a l'avance
 	void ReserveExtraSize(longint lSize);
 
 	////////////////////////////////////////////////////////////////////////
@@ -62,6 +65,9 @@ public:
 	// Nombre total d'octets lus
 	longint GetTotalPhysicalWriteBytes() const;
 
+	// Temps total passe en attente des ecritures physiques (en secondes)
+	double GetTotalPhysicalWriteTime() const;
+
 	///////////////////////////////////////////////////////////////////////////////////////////
 	// Test de la classe
 
@@ -89,6 +95,16 @@ protected:
 	// Met a jour bIsError en cas d'erreur
 	boolean WriteToFile(int nSizeToWrite);
 
+	// Variante de WriteToFile en mode compression par blocs
+	// Chaque segment du buffer est compresse en un bloc
+	boolean WriteCompressedToFile(int nSizeToWrite);
+
+	// Ecriture de l'index des blocs compresses de la session, a la fermeture du fichier
+	boolean WriteCompressionIndex();
+
+	// Ecriture physique d'un tableau de caracteres en mode compression par blocs
+	boolean WriteCompressedBytes(const char* sBytes, int nSize);
+
 	// Espace non rempli dans le buffer
 	int GetAvailableSpace();
 
@@ -107,6 +123,12 @@ protected:
 	// On commence avec bNextOpenOnAppend=false, il passe a true dans le PhysycalOpen et dans le OpenForAppend
 	boolean bNextOpenOnAppend;
 
+	// Mode compression par blocs: tailles initiales et stockees des blocs ecrits depuis l'ouverture,
+	// et taille ecrite sur disque depuis l'ouverture
+	IntVector ivCompressedBlockSizes;
+	IntVector ivCompressedBlockStoredSizes;
+	longint lCompressedSessionSize;
+
 	///////////////////////////////////////////
 	// Statistiques sur les ecritures physiques
 
@@ -115,6 +137,9 @@ protected:
 
 	// Nombre total d'octets lus
 	longint lTotalPhysicalWriteBytes;
+
+	// Temps passe en attente des ecritures physiques
+	Timer timerPhysicalWrite;
 };
 
 ///////////////////////
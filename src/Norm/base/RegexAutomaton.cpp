@@ -0,0 +1,1624 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#include "RegexAutomaton.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexAutomaton
+
+RegexAutomaton::RegexAutomaton()
+{
+	nParsePosition = 0;
+	bParseError = false;
+	nCaptureNumber = 0;
+	bExactCaptures = false;
+	forwardProgram = NULL;
+	reverseProgram = NULL;
+	matchDFA = NULL;
+	searchDFA = NULL;
+	reverseSearchDFA = NULL;
+	currentThreads = NULL;
+	nextThreads = NULL;
+	nSearchedLength = 0;
+}
+
+RegexAutomaton::~RegexAutomaton()
+{
+	Compile(NULL);
+}
+
+boolean RegexAutomaton::Compile(const char* sRegexValue)
+{
+	boolean bOk;
+	RegexNode* rootNode;
+
+	// Nettoyage prealable
+	if (forwardProgram != NULL)
+		delete forwardProgram;
+	if (reverseProgram != NULL)
+		delete reverseProgram;
+	if (matchDFA != NULL)
+		delete matchDFA;
+	if (searchDFA != NULL)
+		delete searchDFA;
+	if (reverseSearchDFA != NULL)
+		delete reverseSearchDFA;
+	if (currentThreads != NULL)
+		delete currentThreads;
+	if (nextThreads != NULL)
+		delete nextThreads;
+	forwardProgram = NULL;
+	reverseProgram = NULL;
+	matchDFA = NULL;
+	searchDFA = NULL;
+	reverseSearchDFA = NULL;
+	currentThreads = NULL;
+	nextThreads = NULL;
+	nCaptureNumber = 0;
+	sRegex = "";
+	if (sRegexValue == NULL)
+		return false;
+
+	// Analyse syntaxique, le groupe 0 correspondant a l'expression entiere
+	sRegex = sRegexValue;
+	nParsePosition = 0;
+	bParseError = false;
+	nCaptureNumber = 1;
+	rootNode = NULL;
+	if (sRegex.GetLength() > 0)
+		rootNode = ParseAlternative();
+	bOk = rootNode != NULL and not bParseError and nParsePosition == sRegex.GetLength();
+
+	// Compilation des programmes
+	if (bOk)
+	{
+		forwardProgram = new RegexProgram;
+		reverseProgram = new RegexProgram;
+		bOk = forwardProgram->Compile(rootNode, false, nMaxProgramSize) and
+		      reverseProgram->Compile(rootNode, true, nMaxProgramSize);
+		if (not bOk)
+		{
+			delete forwardProgram;
+			delete reverseProgram;
+			forwardProgram = NULL;
+			reverseProgram = NULL;
+		}
+	}
+	if (bOk)
+		bExactCaptures = CheckExactCaptures(rootNode);
+	if (rootNode != NULL)
+		delete rootNode;
+
+	// Initialisation des automates d'execution
+	if (bOk)
+	{
+		matchDFA = new RegexDFA;
+		matchDFA->Initialize(forwardProgram, false);
+		searchDFA = new RegexDFA;
+		searchDFA->Initialize(forwardProgram, true);
+		reverseSearchDFA = new RegexDFA;
+		reverseSearchDFA->Initialize(reverseProgram, true);
+		currentThreads = new RegexThreadList;
+		currentThreads->Initialize(forwardProgram->GetSize(), 2 * nCaptureNumber);
+		nextThreads = new RegexThreadList;
+		nextThreads->Initialize(forwardProgram->GetSize(), 2 * nCaptureNumber);
+	}
+	else
+		nCaptureNumber = 0;
+	ensure(bOk == IsCompiled());
+	return bOk;
+}
+
+boolean RegexAutomaton::Match(const char* sValue, int nLength)
+{
+	RegexDFAState* state;
+	int i;
+
+	require(IsCompiled());
+	require(sValue != NULL and nLength >= 0);
+
+	// Parcours de la chaine par l'automate deterministe ancre en debut
+	state = matchDFA->GetStartState();
+	for (i = 0; i < nLength; i++)
+	{
+		if (state->bDead)
+			return false;
+		state = matchDFA->GetNextState(state, (unsigned char)sValue[i]);
+	}
+	return state->bMatchAtEnd;
+}
+
+int RegexAutomaton::Find(const char* sValue, int nLength)
+{
+	RegexDFAState* state;
+	boolean bFound;
+	int nPosition;
+	int i;
+
+	require(IsCompiled());
+	require(sValue != NULL and nLength >= 0);
+
+	// Recherche rapide de l'existence d'une occurrence, en s'arretant a la premiere fin d'occurrence
+	bFound = false;
+	state = searchDFA->GetStartState();
+	for (i = 0; i <= nLength; i++)
+	{
+		if (state->bMatch or (i == nLength and state->bMatchAtEnd))
+		{
+			bFound = true;
+			break;
+		}
+		if (i == nLength or state->bDead)
+			break;
+		state = searchDFA->GetNextState(state, (unsigned char)sValue[i]);
+	}
+
+	// Recherche de la position de debut la plus a gauche, par un parcours en sens inverse:
+	// une position est un debut d'occurrence si l'automate inverse y trouve une occurrence
+	nPosition = -1;
+	if (bFound)
+	{
+		state = reverseSearchDFA->GetStartState();
+		for (i = nLength; i >= 0; i--)
+		{
+			if (state->bMatch or (i == 0 and state->bMatchAtEnd))
+				nPosition = i;
+			if (i == 0 or state->bDead)
+				break;
+			state = reverseSearchDFA->GetNextState(state, (unsigned char)sValue[i - 1]);
+		}
+		assert(nPosition >= 0);
+	}
+	return nPosition;
+}
+
+boolean RegexAutomaton::Search(const char* sValue, int nLength, int nStart, boolean bContinuousNotNull,
+			       IntVector* ivCaptures)
+{
+	boolean bFound;
+	RegexThreadList* swapThreads;
+	int nSlot;
+	int nPos;
+	int nThread;
+	int nPc;
+
+	require(IsCompiled());
+	require(sValue != NULL and nLength >= 0);
+	require(0 <= nStart and nStart <= nLength);
+	require(ivCaptures != NULL);
+
+	// Initialisation
+	nSearchedLength = nLength;
+	ivWorkingCaptures.SetSize(2 * nCaptureNumber);
+	currentThreads->Clear();
+
+	// Simulation de l'automate non deterministe, les threads etant ordonnes par priorite decroissante
+	bFound = false;
+	for (nPos = nStart; nPos <= nLength; nPos++)
+	{
+		// Ajout d'un thread demarrant a la position courante, de plus faible priorite,
+		// tant qu'aucune occurrence n'a ete trouvee
+		if (not bFound and (nPos == nStart or not bContinuousNotNull))
+		{
+			for (nSlot = 0; nSlot < ivWorkingCaptures.GetSize(); nSlot++)
+				ivWorkingCaptures.SetAt(nSlot, -1);
+			AddThread(currentThreads, 0, nPos, &ivWorkingCaptures);
+		}
+
+		// Arret si plus aucun thread ne peut aboutir a une meilleure occurrence
+		if (currentThreads->GetThreadNumber() == 0 and (bFound or bContinuousNotNull))
+			break;
+
+		// Traitement des threads par ordre de priorite
+		nextThreads->Clear();
+		for (nThread = 0; nThread < currentThreads->GetThreadNumber(); nThread++)
+		{
+			nPc = currentThreads->GetPcAt(nThread);
+			if (forwardProgram->GetOpcodeAt(nPc) == RegexProgram::MatchFound)
+			{
+				// On ignore les occurrences vides si necessaire
+				if (bContinuousNotNull and currentThreads->GetCaptureAt(nThread, 0) == nPos)
+					continue;
+
+				// Memorisation de l'occurrence, et abandon des threads de priorite inferieure
+				currentThreads->ExportCaptures(nThread, ivCaptures);
+				bFound = true;
+				break;
+			}
+			else if (nPos < nLength and forwardProgram->ReadCharAt(nPc, (unsigned char)sValue[nPos]))
+			{
+				currentThreads->ExportCaptures(nThread, &ivWorkingCaptures);
+				AddThread(nextThreads, nPc + 1, nPos + 1, &ivWorkingCaptures);
+			}
+		}
+
+		// Echange des listes de threads
+		swapThreads = currentThreads;
+		currentThreads = nextThreads;
+		nextThreads = swapThreads;
+	}
+	return bFound;
+}
+
+void RegexAutomaton::ReplaceAll(const char* sValue, int nLength, const char* sReplace, ALString& sResult)
+{
+	IntVector ivCaptures;
+	RegexDFAState* state;
+	boolean bFound;
+	int nPrefixStart;
+	int nMatchEnd;
+	int i;
+
+	require(IsCompiled());
+	require(sValue != NULL and nLength >= 0);
+	require(sReplace != NULL);
+
+	sResult = "";
+
+	// Recherche rapide de l'existence d'une occurrence
+	bFound = false;
+	state = searchDFA->GetStartState();
+	for (i = 0; i <= nLength; i++)
+	{
+		if (state->bMatch or (i == nLength and state->bMatchAtEnd))
+		{
+			bFound = true;
+			break;
+		}
+		if (i == nLength or state->bDead)
+			break;
+		state = searchDFA->GetNextState(state, (unsigned char)sValue[i]);
+	}
+
+	// Enchainement des occurrences selon la semantique de std::regex_iterator: apres une occurrence vide,
+	// on cherche une occurrence non vide demarrant a la meme position, puis on avance d'un caractere
+	nPrefixStart = 0;
+	if (bFound)
+		bFound = Search(sValue, nLength, 0, false, &ivCaptures);
+	while (bFound)
+	{
+		// Ajout du prefixe et du remplacement de l'occurrence
+		AppendRange(sValue, nPrefixStart, ivCaptures.GetAt(0), sResult);
+		AppendFormat(sValue, nLength, nPrefixStart, &ivCaptures, sReplace, sResult);
+		nPrefixStart = ivCaptures.GetAt(1);
+
+		// Recherche de l'occurrence suivante
+		nMatchEnd = ivCaptures.GetAt(1);
+		if (ivCaptures.GetAt(0) == nMatchEnd)
+		{
+			if (nMatchEnd == nLength)
+				break;
+			bFound = Search(sValue, nLength, nMatchEnd, true, &ivCaptures);
+			if (not bFound)
+				bFound = Search(sValue, nLength, nMatchEnd + 1, false, &ivCaptures);
+		}
+		else
+			bFound = Search(sValue, nLength, nMatchEnd, false, &ivCaptures);
+	}
+
+	// Ajout du suffixe
+	AppendRange(sValue, nPrefixStart, nLength, sResult);
+}
+
+longint RegexAutomaton::GetUsedMemory() const
+{
+	longint lUsedMemory;
+
+	lUsedMemory = sizeof(RegexAutomaton);
+	lUsedMemory += sRegex.GetLength();
+	lUsedMemory += ivWorkingCaptures.GetUsedMemory() - sizeof(IntVector);
+	if (forwardProgram != NULL)
+		lUsedMemory += forwardProgram->GetUsedMemory();
+	if (reverseProgram != NULL)
+		lUsedMemory += reverseProgram->GetUsedMemory();
+	if (matchDFA != NULL)
+		lUsedMemory += matchDFA->GetUsedMemory();
+	if (searchDFA != NULL)
+		lUsedMemory += searchDFA->GetUsedMemory();
+	if (reverseSearchDFA != NULL)
+		lUsedMemory += reverseSearchDFA->GetUsedMemory();
+	if (currentThreads != NULL)
+		lUsedMemory += 2 * currentThreads->GetUsedMemory();
+	return lUsedMemory;
+}
+
+const ALString RegexAutomaton::GetClassLabel() const
+{
+	return "Regex automaton";
+}
+
+RegexNode* RegexAutomaton::ParseAlternative()
+{
+	RegexNode* alternativeNode;
+	RegexNode* node;
+
+	// Premiere branche
+	node = ParseConcatenation();
+	if (node == NULL)
+		return NULL;
+	if (nParsePosition == sRegex.GetLength() or sRegex.GetAt(nParsePosition) != '|')
+		return node;
+
+	// Branches suivantes
+	alternativeNode = new RegexNode;
+	alternativeNode->nType = RegexNode::Alternative;
+	alternativeNode->oaChildren.Add(node);
+	while (nParsePosition < sRegex.GetLength() and sRegex.GetAt(nParsePosition) == '|')
+	{
+		nParsePosition++;
+		node = ParseConcatenation();
+		if (node == NULL)
+		{
+			delete alternativeNode;
+			return NULL;
+		}
+		alternativeNode->oaChildren.Add(node);
+	}
+	return alternativeNode;
+}
+
+RegexNode* RegexAutomaton::ParseConcatenation()
+{
+	RegexNode* concatenationNode;
+	RegexNode* node;
+	char c;
+
+	concatenationNode = new RegexNode;
+	concatenationNode->nType = RegexNode::Concatenation;
+	while (nParsePosition < sRegex.GetLength())
+	{
+		c = sRegex.GetAt(nParsePosition);
+		if (c == '|' or c == ')')
+			break;
+
+		// Analyse d'un atome, suivi eventuellement d'un quantificateur
+		node = ParseAtom();
+		if (node != NULL and nParsePosition < sRegex.GetLength())
+		{
+			c = sRegex.GetAt(nParsePosition);
+			if (c == '*' or c == '+' or c == '?' or c == '{')
+				node = ParseQuantifier(node);
+		}
+		if (node == NULL)
+		{
+			delete concatenationNode;
+			return NULL;
+		}
+		concatenationNode->oaChildren.Add(node);
+	}
+
+	// Les branches vides ne sont pas gerees
+	if (concatenationNode->oaChildren.GetSize() == 0)
+	{
+		delete concatenationNode;
+		return NULL;
+	}
+	// Simplification dans le cas d'un seul element
+	else if (concatenationNode->oaChildren.GetSize() == 1)
+	{
+		node = cast(RegexNode*, concatenationNode->oaChildren.GetAt(0));
+		concatenationNode->oaChildren.RemoveAll();
+		delete concatenationNode;
+		return node;
+	}
+	else
+		return concatenationNode;
+}
+
+RegexNode* RegexAutomaton::ParseAtom()
+{
+	RegexNode* node;
+	RegexNode* childNode;
+	RegexCharSet* charSet;
+	int nCaptureIndex;
+	int nChar;
+	char c;
+
+	require(nParsePosition < sRegex.GetLength());
+
+	c = sRegex.GetAt(nParsePosition);
+	node = NULL;
+
+	// Groupe
+	if (c == '(')
+	{
+		nParsePosition++;
+		nCaptureIndex = -1;
+		if (nParsePosition < sRegex.GetLength() and sRegex.GetAt(nParsePosition) == '?')
+		{
+			// Seuls les groupes non capturants sont geres, pas les assertions (?=...) ou (?!...)
+			if (nParsePosition + 1 < sRegex.GetLength() and sRegex.GetAt(nParsePosition + 1) == ':')
+				nParsePosition += 2;
+			else
+				return NULL;
+		}
+		else
+		{
+			nCaptureIndex = nCaptureNumber;
+			nCaptureNumber++;
+		}
+
+		// Analyse du contenu du groupe
+		if (nParsePosition == sRegex.GetLength() or sRegex.GetAt(nParsePosition) == ')')
+			return NULL;
+		childNode = ParseAlternative();
+		if (childNode == NULL)
+			return NULL;
+		if (nParsePosition == sRegex.GetLength() or sRegex.GetAt(nParsePosition) != ')')
+		{
+			delete childNode;
+			return NULL;
+		}
+		nParsePosition++;
+		node = new RegexNode;
+		node->nType = RegexNode::Group;
+		node->nCaptureIndex = nCaptureIndex;
+		node->oaChildren.Add(childNode);
+	}
+	// Classe de caracteres
+	else if (c == '[')
+	{
+		nParsePosition++;
+		charSet = ParseCharSet();
+		if (charSet != NULL)
+		{
+			node = new RegexNode;
+			node->nType = RegexNode::CharSet;
+			node->charSet = charSet;
+		}
+	}
+	// Caractere quelconque, hors fins de ligne
+	else if (c == '.')
+	{
+		nParsePosition++;
+		node = new RegexNode;
+		node->nType = RegexNode::CharSet;
+		node->charSet = new RegexCharSet;
+		node->charSet->AddAnyChar();
+	}
+	// Ancres
+	else if (c == '^' or c == '$')
+	{
+		nParsePosition++;
+		node = new RegexNode;
+		node->nType = (c == '^') ? RegexNode::BeginAssertion : RegexNode::EndAssertion;
+
+		// Les ancres ne peuvent etre quantifiees
+		if (nParsePosition < sRegex.GetLength())
+		{
+			c = sRegex.GetAt(nParsePosition);
+			if (c == '*' or c == '+' or c == '?' or c == '{')
+			{
+				delete node;
+				node = NULL;
+			}
+		}
+	}
+	// Caractere echappe
+	else if (c == '\\')
+	{
+		nParsePosition++;
+		charSet = NULL;
+		if (ParseEscapedChar(false, nChar, charSet))
+		{
+			if (charSet == NULL)
+			{
+				charSet = new RegexCharSet;
+				charSet->AddChar(nChar);
+			}
+			node = new RegexNode;
+			node->nType = RegexNode::CharSet;
+			node->charSet = charSet;
+		}
+	}
+	// Caracteres speciaux isoles, non geres
+	else if (c == '*' or c == '+' or c == '?' or c == '{' or c == '}' or c == ']')
+		node = NULL;
+	// Caractere standard
+	else
+	{
+		nParsePosition++;
+		node = new RegexNode;
+		node->nType = RegexNode::CharSet;
+		node->charSet = new RegexCharSet;
+		node->charSet->AddChar((unsigned char)c);
+	}
+	return node;
+}
+
+RegexNode* RegexAutomaton::ParseQuantifier(RegexNode* atomNode)
+{
+	RegexNode* node;
+	int nMin;
+	int nMax;
+	char c;
+
+	require(atomNode != NULL);
+	require(nParsePosition < sRegex.GetLength());
+
+	// Analyse des bornes du quantificateur
+	c = sRegex.GetAt(nParsePosition);
+	nParsePosition++;
+	nMin = 0;
+	nMax = -1;
+	if (c == '+')
+		nMin = 1;
+	else if (c == '?')
+		nMax = 1;
+	else if (c == '{')
+	{
+		if (not ParseInteger(nMin))
+		{
+			delete atomNode;
+			return NULL;
+		}
+		if (nParsePosition < sRegex.GetLength() and sRegex.GetAt(nParsePosition) == '}')
+			nMax = nMin;
+		else if (nParsePosition < sRegex.GetLength() and sRegex.GetAt(nParsePosition) == ',')
+		{
+			nParsePosition++;
+			if (nParsePosition < sRegex.GetLength() and sRegex.GetAt(nParsePosition) != '}')
+			{
+				if (not ParseInteger(nMax) or nMax < nMin)
+				{
+					delete atomNode;
+					return NULL;
+				}
+			}
+		}
+		if (nParsePosition == sRegex.GetLength() or sRegex.GetAt(nParsePosition) != '}')
+		{
+			delete atomNode;
+			return NULL;
+		}
+		nParsePosition++;
+	}
+
+	// Creation du noeud de repetition
+	node = new RegexNode;
+	node->nType = RegexNode::Repetition;
+	node->nMinRepetition = nMin;
+	node->nMaxRepetition = nMax;
+	node->oaChildren.Add(atomNode);
+
+	// Quantificateur non glouton
+	if (nParsePosition < sRegex.GetLength() and sRegex.GetAt(nParsePosition) == '?')
+	{
+		node->bGreedy = false;
+		nParsePosition++;
+	}
+
+	// Les quantificateurs enchaines ne sont pas geres
+	if (nParsePosition < sRegex.GetLength())
+	{
+		c = sRegex.GetAt(nParsePosition);
+		if (c == '*' or c == '+' or c == '?' or c == '{')
+		{
+			delete node;
+			return NULL;
+		}
+	}
+	return node;
+}
+
+boolean RegexAutomaton::ParseInteger(int& nValue)
+{
+	int nDigitNumber;
+	char c;
+
+	nValue = 0;
+	nDigitNumber = 0;
+	while (nParsePosition < sRegex.GetLength())
+	{
+		c = sRegex.GetAt(nParsePosition);
+		if (c < '0' or c > '9')
+			break;
+		nValue = nValue * 10 + c - '0';
+		nDigitNumber++;
+		nParsePosition++;
+		if (nValue > nMaxRepetitionNumber)
+			return false;
+	}
+	return nDigitNumber > 0;
+}
+
+RegexCharSet* RegexAutomaton::ParseCharSet()
+{
+	RegexCharSet* charSet;
+	RegexCharSet* elementCharSet;
+	boolean bNegate;
+	boolean bOk;
+	int nFirstPosition;
+	int nChar;
+	int nLastChar;
+	char c;
+
+	// Negation
+	bNegate = false;
+	if (nParsePosition < sRegex.GetLength() and sRegex.GetAt(nParsePosition) == '^')
+	{
+		bNegate = true;
+		nParsePosition++;
+	}
+	nFirstPosition = nParsePosition;
+
+	// Analyse des elements de la classe
+	charSet = new RegexCharSet;
+	bOk = true;
+	while (bOk)
+	{
+		// Fin de classe, qui doit etre non vide
+		if (nParsePosition == sRegex.GetLength())
+		{
+			bOk = false;
+			break;
+		}
+		c = sRegex.GetAt(nParsePosition);
+		if (c == ']')
+		{
+			bOk = nParsePosition > nFirstPosition;
+			nParsePosition++;
+			break;
+		}
+
+		// Analyse d'un element
+		elementCharSet = NULL;
+		nChar = (unsigned char)c;
+		nParsePosition++;
+		if (c == '\\')
+			bOk = ParseEscapedChar(true, nChar, elementCharSet);
+		// Les classes imbriquees ([:alpha:]...) ne sont pas gerees
+		else if (c == '[')
+			bOk = false;
+		// Le tiret n'est gere qu'en debut ou fin de classe
+		else if (c == '-')
+			bOk = nParsePosition - 1 == nFirstPosition or
+			      (nParsePosition < sRegex.GetLength() and sRegex.GetAt(nParsePosition) == ']');
+		if (not bOk)
+			break;
+
+		// Cas d'un intervalle
+		if (nParsePosition + 1 < sRegex.GetLength() and sRegex.GetAt(nParsePosition) == '-' and
+		    sRegex.GetAt(nParsePosition + 1) != ']')
+		{
+			// Seuls les intervalles entre caracteres ascii sont geres
+			nParsePosition++;
+			c = sRegex.GetAt(nParsePosition);
+			nLastChar = (unsigned char)c;
+			nParsePosition++;
+			if (elementCharSet != NULL or nChar == '-' or nChar >= 128)
+				bOk = false;
+			else if (c == '\\')
+			{
+				bOk = ParseEscapedChar(true, nLastChar, elementCharSet);
+				if (elementCharSet != NULL)
+					bOk = false;
+			}
+			else if (c == '[' or c == '-')
+				bOk = false;
+			if (bOk and (nLastChar >= 128 or nLastChar < nChar))
+				bOk = false;
+			if (bOk)
+				charSet->AddRange(nChar, nLastChar);
+		}
+		// Cas d'une classe predefinie
+		else if (elementCharSet != NULL)
+			charSet->AddCharSet(elementCharSet);
+		// Cas d'un caractere
+		else
+			charSet->AddChar(nChar);
+		if (elementCharSet != NULL)
+			delete elementCharSet;
+	}
+
+	// Finalisation
+	if (not bOk)
+	{
+		delete charSet;
+		return NULL;
+	}
+	if (bNegate)
+		charSet->Negate();
+	return charSet;
+}
+
+boolean RegexAutomaton::ParseEscapedChar(boolean bInCharSet, int& nChar, RegexCharSet*& charSet)
+{
+	int nDigit;
+	int i;
+	char c;
+
+	require(charSet == NULL);
+
+	if (nParsePosition == sRegex.GetLength())
+		return false;
+	c = sRegex.GetAt(nParsePosition);
+	nParsePosition++;
+	nChar = (unsigned char)c;
+
+	// Classes predefinies
+	if (c == 'd' or c == 'D' or c == 'w' or c == 'W' or c == 's' or c == 'S')
+	{
+		charSet = new RegexCharSet;
+		if (c == 'd' or c == 'D')
+			charSet->AddDigits();
+		else if (c == 'w' or c == 'W')
+			charSet->AddWordChars();
+		else
+			charSet->AddSpaces();
+		if (c == 'D' or c == 'W' or c == 'S')
+			charSet->Negate();
+		return true;
+	}
+	// Caracteres de controle
+	else if (c == 't')
+		nChar = '\t';
+	else if (c == 'n')
+		nChar = '\n';
+	else if (c == 'v')
+		nChar = '\v';
+	else if (c == 'f')
+		nChar = '\f';
+	else if (c == 'r')
+		nChar = '\r';
+	// Caractere en hexadecimal, avec exactement deux chiffres
+	else if (c == 'x')
+	{
+		nChar = 0;
+		for (i = 0; i < 2; i++)
+		{
+			if (nParsePosition == sRegex.GetLength())
+				return false;
+			c = sRegex.GetAt(nParsePosition);
+			nParsePosition++;
+			if (c >= '0' and c <= '9')
+				nDigit = c - '0';
+			else if (c >= 'a' and c <= 'f')
+				nDigit = c - 'a' + 10;
+			else if (c >= 'A' and c <= 'F')
+				nDigit = c - 'A' + 10;
+			else
+				return false;
+			nChar = nChar * 16 + nDigit;
+		}
+		if (nChar == 0)
+			return false;
+	}
+	// Ponctuation ascii echappee (les autres echappements, comme \b, \B, \c, \u ou les references
+	// arriere ne sont pas geres)
+	else if (nChar >= 128 or not ispunct(nChar))
+		return false;
+	return true;
+}
+
+boolean RegexAutomaton::CheckExactCaptures(const RegexNode* node) const
+{
+	const RegexNode* childNode;
+	int nChild;
+
+	require(node != NULL);
+
+	// Cas d'une repetition dont une iteration peut etre vide et memorise des sous-expressions
+	if (node->nType == RegexNode::Repetition)
+	{
+		childNode = cast(const RegexNode*, node->oaChildren.GetAt(0));
+		if (childNode->IsNullable() and childNode->ContainsCapture())
+			return false;
+	}
+
+	// Verification des sous-noeuds
+	for (nChild = 0; nChild < node->oaChildren.GetSize(); nChild++)
+	{
+		if (not CheckExactCaptures(cast(const RegexNode*, node->oaChildren.GetAt(nChild))))
+			return false;
+	}
+	return true;
+}
+
+void RegexAutomaton::AppendFormat(const char* sValue, int nLength, int nPrefixStart, const IntVector* ivCaptures,
+				  const char* sReplace, ALString& sResult) const
+{
+	const char* sFormat;
+	int nGroup;
+
+	require(sValue != NULL);
+	require(ivCaptures != NULL and ivCaptures->GetSize() == 2 * nCaptureNumber);
+	require(sReplace != NULL);
+
+	// Analyse du format, en reproduisant le comportement de std::match_results::format
+	sFormat = sReplace;
+	while (*sFormat != '\0')
+	{
+		if (*sFormat != '$')
+		{
+			sResult += *sFormat;
+			sFormat++;
+			continue;
+		}
+		sFormat++;
+
+		// Traitement des sequences commencant par '$'
+		if (*sFormat == '\0' or *sFormat == '$')
+		{
+			sResult += '$';
+			if (*sFormat == '$')
+				sFormat++;
+		}
+		else if (*sFormat == '&')
+		{
+			AppendRange(sValue, ivCaptures->GetAt(0), ivCaptures->GetAt(1), sResult);
+			sFormat++;
+		}
+		else if (*sFormat == '`')
+		{
+			AppendRange(sValue, nPrefixStart, ivCaptures->GetAt(0), sResult);
+			sFormat++;
+		}
+		else if (*sFormat == '\'')
+		{
+			AppendRange(sValue, ivCaptures->GetAt(1), nLength, sResult);
+			sFormat++;
+		}
+		else if (*sFormat >= '0' and *sFormat <= '9')
+		{
+			// Index de groupe sur un ou deux chiffres
+			nGroup = *sFormat - '0';
+			sFormat++;
+			if (*sFormat >= '0' and *sFormat <= '9')
+			{
+				nGroup = nGroup * 10 + *sFormat - '0';
+				sFormat++;
+			}
+			if (nGroup < nCaptureNumber and ivCaptures->GetAt(2 * nGroup) >= 0)
+				AppendRange(sValue, ivCaptures->GetAt(2 * nGroup), ivCaptures->GetAt(2 * nGroup + 1),
+					    sResult);
+		}
+		else
+			sResult += '$';
+	}
+}
+
+void RegexAutomaton::AppendRange(const char* sValue, int nBegin, int nEnd, ALString& sResult) const
+{
+	int i;
+
+	require(sValue != NULL);
+	require(0 <= nBegin and nBegin <= nEnd);
+
+	for (i = nBegin; i < nEnd; i++)
+		sResult += sValue[i];
+}
+
+void RegexAutomaton::AddThread(RegexThreadList* threadList, int nPc, int nPos, IntVector* ivThreadCaptures)
+{
+	int nSlot;
+	int nOldValue;
+
+	require(threadList != NULL);
+	require(ivThreadCaptures != NULL);
+
+	// Arret si instruction deja traitee, par un thread de plus forte priorite
+	if (not threadList->Mark(nPc))
+		return;
+
+	// Parcours des transitions sans lecture de caractere
+	switch (forwardProgram->GetOpcodeAt(nPc))
+	{
+	case RegexProgram::Jump:
+		AddThread(threadList, forwardProgram->GetArg1At(nPc), nPos, ivThreadCaptures);
+		break;
+	case RegexProgram::Split:
+		AddThread(threadList, forwardProgram->GetArg1At(nPc), nPos, ivThreadCaptures);
+		AddThread(threadList, forwardProgram->GetArg2At(nPc), nPos, ivThreadCaptures);
+		break;
+	case RegexProgram::Save:
+		nSlot = forwardProgram->GetArg1At(nPc);
+		nOldValue = ivThreadCaptures->GetAt(nSlot);
+		ivThreadCaptures->SetAt(nSlot, nPos);
+		AddThread(threadList, nPc + 1, nPos, ivThreadCaptures);
+		ivThreadCaptures->SetAt(nSlot, nOldValue);
+		break;
+	case RegexProgram::AssertBegin:
+		if (nPos == 0)
+			AddThread(threadList, nPc + 1, nPos, ivThreadCaptures);
+		break;
+	case RegexProgram::AssertEnd:
+		if (nPos == nSearchedLength)
+			AddThread(threadList, nPc + 1, nPos, ivThreadCaptures);
+		break;
+	default:
+		threadList->AddThread(nPc, ivThreadCaptures);
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexCharSet
+
+RegexCharSet::RegexCharSet()
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+		nBits[i] = 0;
+}
+
+RegexCharSet::~RegexCharSet() {}
+
+void RegexCharSet::AddChar(int nChar)
+{
+	require(0 <= nChar and nChar < 256);
+	nBits[nChar >> 5] |= 1u << (nChar & 31);
+}
+
+void RegexCharSet::AddRange(int nFirstChar, int nLastChar)
+{
+	int nChar;
+
+	require(0 <= nFirstChar and nFirstChar <= nLastChar and nLastChar < 256);
+	for (nChar = nFirstChar; nChar <= nLastChar; nChar++)
+		AddChar(nChar);
+}
+
+void RegexCharSet::AddCharSet(const RegexCharSet* charSet)
+{
+	int i;
+
+	require(charSet != NULL);
+	for (i = 0; i < 8; i++)
+		nBits[i] |= charSet->nBits[i];
+}
+
+void RegexCharSet::Negate()
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+		nBits[i] = ~nBits[i];
+}
+
+void RegexCharSet::AddDigits()
+{
+	AddRange('0', '9');
+}
+
+void RegexCharSet::AddWordChars()
+{
+	AddRange('a', 'z');
+	AddRange('A', 'Z');
+	AddRange('0', '9');
+	AddChar('_');
+}
+
+void RegexCharSet::AddSpaces()
+{
+	AddChar(' ');
+	AddChar('\t');
+	AddChar('\n');
+	AddChar('\v');
+	AddChar('\f');
+	AddChar('\r');
+}
+
+void RegexCharSet::AddAnyChar()
+{
+	AddRange(0, 255);
+	nBits['\n' >> 5] &= ~(1u << ('\n' & 31));
+	nBits['\r' >> 5] &= ~(1u << ('\r' & 31));
+}
+
+RegexCharSet* RegexCharSet::Clone() const
+{
+	RegexCharSet* cloneCharSet;
+
+	cloneCharSet = new RegexCharSet;
+	cloneCharSet->AddCharSet(this);
+	return cloneCharSet;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexNode
+
+RegexNode::RegexNode()
+{
+	nType = Empty;
+	charSet = NULL;
+	nMinRepetition = 1;
+	nMaxRepetition = 1;
+	bGreedy = true;
+	nCaptureIndex = -1;
+}
+
+RegexNode::~RegexNode()
+{
+	if (charSet != NULL)
+		delete charSet;
+	oaChildren.DeleteAll();
+}
+
+boolean RegexNode::IsNullable() const
+{
+	int nChild;
+
+	switch (nType)
+	{
+	case CharSet:
+		return false;
+	case Concatenation:
+		for (nChild = 0; nChild < oaChildren.GetSize(); nChild++)
+		{
+			if (not cast(RegexNode*, oaChildren.GetAt(nChild))->IsNullable())
+				return false;
+		}
+		return true;
+	case Alternative:
+		for (nChild = 0; nChild < oaChildren.GetSize(); nChild++)
+		{
+			if (cast(RegexNode*, oaChildren.GetAt(nChild))->IsNullable())
+				return true;
+		}
+		return false;
+	case Repetition:
+		return nMinRepetition == 0 or cast(RegexNode*, oaChildren.GetAt(0))->IsNullable();
+	case Group:
+		return cast(RegexNode*, oaChildren.GetAt(0))->IsNullable();
+	default:
+		return true;
+	}
+}
+
+boolean RegexNode::ContainsCapture() const
+{
+	int nChild;
+
+	if (nType == Group and nCaptureIndex >= 0)
+		return true;
+	for (nChild = 0; nChild < oaChildren.GetSize(); nChild++)
+	{
+		if (cast(RegexNode*, oaChildren.GetAt(nChild))->ContainsCapture())
+			return true;
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexProgram
+
+RegexProgram::RegexProgram()
+{
+	int i;
+
+	for (i = 0; i < 256; i++)
+		nByteClasses[i] = 0;
+	nByteClassNumber = 1;
+	nMaxProgramSize = 0;
+}
+
+RegexProgram::~RegexProgram()
+{
+	oaCharSets.DeleteAll();
+}
+
+boolean RegexProgram::Compile(const RegexNode* rootNode, boolean bReverse, int nMaxSize)
+{
+	require(rootNode != NULL);
+	require(nMaxSize > 0);
+	require(GetSize() == 0);
+
+	// Compilation, avec memorisation de l'occurrence globale dans le sens de lecture
+	nMaxProgramSize = nMaxSize;
+	if (not bReverse)
+		AddInstruction(Save, 0, 0);
+	CompileNode(rootNode, bReverse);
+	if (not bReverse)
+		AddInstruction(Save, 1, 0);
+	AddInstruction(MatchFound, 0, 0);
+
+	// Calcul des classes de caracteres si la compilation a reussi
+	if (GetSize() > nMaxProgramSize)
+		return false;
+	ComputeByteClasses();
+	return true;
+}
+
+longint RegexProgram::GetUsedMemory() const
+{
+	longint lUsedMemory;
+
+	lUsedMemory = sizeof(RegexProgram);
+	lUsedMemory += ivOpcodes.GetUsedMemory() - sizeof(IntVector);
+	lUsedMemory += ivArgs1.GetUsedMemory() - sizeof(IntVector);
+	lUsedMemory += ivArgs2.GetUsedMemory() - sizeof(IntVector);
+	lUsedMemory += oaCharSets.GetUsedMemory() - sizeof(ObjectArray);
+	lUsedMemory += oaCharSets.GetSize() * sizeof(RegexCharSet);
+	return lUsedMemory;
+}
+
+void RegexProgram::CompileNode(const RegexNode* node, boolean bReverse)
+{
+	IntVector ivPatches;
+	int nChild;
+	int nIndex;
+	int nCopy;
+	int nCopyStart;
+	int nSplit;
+	int nPatch;
+
+	require(node != NULL);
+
+	// Arret si la taille max est depassee
+	if (GetSize() > nMaxProgramSize)
+		return;
+
+	switch (node->nType)
+	{
+	case RegexNode::CharSet:
+		AddInstruction(ReadChar, oaCharSets.GetSize(), 0);
+		oaCharSets.Add(node->charSet->Clone());
+		break;
+	case RegexNode::Concatenation:
+		for (nChild = 0; nChild < node->oaChildren.GetSize(); nChild++)
+		{
+			nIndex = bReverse ? node->oaChildren.GetSize() - 1 - nChild : nChild;
+			CompileNode(cast(RegexNode*, node->oaChildren.GetAt(nIndex)), bReverse);
+		}
+		break;
+	case RegexNode::Alternative:
+		// Chaque branche, sauf la derniere, est precedee d'un branchement vers la branche suivante
+		// et suivie d'un saut vers la fin
+		for (nChild = 0; nChild < node->oaChildren.GetSize(); nChild++)
+		{
+			if (nChild < node->oaChildren.GetSize() - 1)
+			{
+				nSplit = AddInstruction(Split, GetSize() + 1, -1);
+				CompileNode(cast(RegexNode*, node->oaChildren.GetAt(nChild)), bReverse);
+				ivPatches.Add(AddInstruction(Jump, -1, 0));
+				SetArg2At(nSplit, GetSize());
+			}
+			else
+				CompileNode(cast(RegexNode*, node->oaChildren.GetAt(nChild)), bReverse);
+		}
+		for (nPatch = 0; nPatch < ivPatches.GetSize(); nPatch++)
+			SetArg1At(ivPatches.GetAt(nPatch), GetSize());
+		break;
+	case RegexNode::Repetition:
+		// Copies obligatoires
+		nCopyStart = GetSize();
+		for (nCopy = 0; nCopy < node->nMinRepetition; nCopy++)
+		{
+			nCopyStart = GetSize();
+			CompileNode(cast(RegexNode*, node->oaChildren.GetAt(0)), bReverse);
+		}
+
+		// Repetition illimitee: boucle sur la derniere copie, ou boucle complete si pas de copie obligatoire
+		if (node->nMaxRepetition == -1)
+		{
+			if (node->nMinRepetition > 0)
+			{
+				if (node->bGreedy)
+					AddInstruction(Split, nCopyStart, GetSize() + 1);
+				else
+					AddInstruction(Split, GetSize() + 1, nCopyStart);
+			}
+			else
+			{
+				nSplit = AddInstruction(Split, -1, -1);
+				CompileNode(cast(RegexNode*, node->oaChildren.GetAt(0)), bReverse);
+				AddInstruction(Jump, nSplit, 0);
+				if (node->bGreedy)
+				{
+					SetArg1At(nSplit, nSplit + 1);
+					SetArg2At(nSplit, GetSize());
+				}
+				else
+				{
+					SetArg1At(nSplit, GetSize());
+					SetArg2At(nSplit, nSplit + 1);
+				}
+			}
+		}
+		// Repetition bornee: copies optionnelles, avec sortie vers la fin des que l'une d'elle est evitee
+		else
+		{
+			for (nCopy = node->nMinRepetition; nCopy < node->nMaxRepetition; nCopy++)
+			{
+				ivPatches.Add(AddInstruction(Split, -1, -1));
+				CompileNode(cast(RegexNode*, node->oaChildren.GetAt(0)), bReverse);
+			}
+			for (nPatch = 0; nPatch < ivPatches.GetSize(); nPatch++)
+			{
+				nSplit = ivPatches.GetAt(nPatch);
+				if (node->bGreedy)
+				{
+					SetArg1At(nSplit, nSplit + 1);
+					SetArg2At(nSplit, GetSize());
+				}
+				else
+				{
+					SetArg1At(nSplit, GetSize());
+					SetArg2At(nSplit, nSplit + 1);
+				}
+			}
+		}
+		break;
+	case RegexNode::Group:
+		// Memorisation des sous-expressions uniquement dans le sens de lecture
+		if (node->nCaptureIndex >= 0 and not bReverse)
+			AddInstruction(Save, 2 * node->nCaptureIndex, 0);
+		CompileNode(cast(RegexNode*, node->oaChildren.GetAt(0)), bReverse);
+		if (node->nCaptureIndex >= 0 and not bReverse)
+			AddInstruction(Save, 2 * node->nCaptureIndex + 1, 0);
+		break;
+	case RegexNode::BeginAssertion:
+		AddInstruction(bReverse ? AssertEnd : AssertBegin, 0, 0);
+		break;
+	case RegexNode::EndAssertion:
+		AddInstruction(bReverse ? AssertBegin : AssertEnd, 0, 0);
+		break;
+	default:
+		break;
+	}
+}
+
+void RegexProgram::SetArg1At(int nPc, int nValue)
+{
+	ivArgs1.SetAt(nPc, nValue);
+}
+
+void RegexProgram::SetArg2At(int nPc, int nValue)
+{
+	ivArgs2.SetAt(nPc, nValue);
+}
+
+int RegexProgram::AddInstruction(int nOpcode, int nArg1, int nArg2)
+{
+	ivOpcodes.Add(nOpcode);
+	ivArgs1.Add(nArg1);
+	ivArgs2.Add(nArg2);
+	return ivOpcodes.GetSize() - 1;
+}
+
+void RegexProgram::ComputeByteClasses()
+{
+	int nNewClasses[512];
+	const RegexCharSet* charSet;
+	int nCharSet;
+	int nChar;
+	int nIndex;
+	int nNewClassNumber;
+
+	// Initialisation avec une seule classe
+	for (nChar = 0; nChar < 256; nChar++)
+		nByteClasses[nChar] = 0;
+	nByteClassNumber = 1;
+
+	// Raffinement successif de la partition par chaque ensemble de caracteres
+	for (nCharSet = 0; nCharSet < oaCharSets.GetSize(); nCharSet++)
+	{
+		charSet = cast(const RegexCharSet*, oaCharSets.GetAt(nCharSet));
+		for (nIndex = 0; nIndex < 2 * nByteClassNumber; nIndex++)
+			nNewClasses[nIndex] = -1;
+		nNewClassNumber = 0;
+		for (nChar = 0; nChar < 256; nChar++)
+		{
+			nIndex = 2 * nByteClasses[nChar] + (charSet->Contains(nChar) ? 1 : 0);
+			if (nNewClasses[nIndex] == -1)
+			{
+				nNewClasses[nIndex] = nNewClassNumber;
+				nNewClassNumber++;
+			}
+			nByteClasses[nChar] = nNewClasses[nIndex];
+		}
+		nByteClassNumber = nNewClassNumber;
+	}
+	ensure(1 <= nByteClassNumber and nByteClassNumber <= 256);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexDFA
+
+RegexDFA::RegexDFA()
+{
+	program = NULL;
+	bSearch = false;
+	startState = NULL;
+	nCurrentMark = 0;
+}
+
+RegexDFA::~RegexDFA()
+{
+	RemoveAllStates();
+}
+
+void RegexDFA::Initialize(const RegexProgram* regexProgram, boolean bSearchMode)
+{
+	require(regexProgram != NULL);
+
+	RemoveAllStates();
+	program = regexProgram;
+	bSearch = bSearchMode;
+	ivMarks.SetSize(program->GetSize());
+	ivMarks.Initialize();
+	nCurrentMark = 0;
+}
+
+RegexDFAState* RegexDFA::GetStartState()
+{
+	require(program != NULL);
+
+	if (startState == NULL)
+	{
+		ivNextPcs.SetSize(0);
+		NewMark();
+		AddClosure(0, true, false, &ivNextPcs);
+		startState = LookupState(&ivNextPcs, true);
+	}
+	return startState;
+}
+
+longint RegexDFA::GetUsedMemory() const
+{
+	longint lUsedMemory;
+	RegexDFAState* state;
+	int nState;
+
+	lUsedMemory = sizeof(RegexDFA);
+	lUsedMemory += ivMarks.GetUsedMemory() + ivStack.GetUsedMemory() - 2 * sizeof(IntVector);
+	lUsedMemory += ivNextPcs.GetUsedMemory() + ivEndPcs.GetUsedMemory() - 2 * sizeof(IntVector);
+	lUsedMemory += oaStates.GetUsedMemory() - sizeof(ObjectArray);
+	lUsedMemory += odStates.GetUsedMemory() - sizeof(ObjectDictionary);
+	for (nState = 0; nState < oaStates.GetSize(); nState++)
+	{
+		state = cast(RegexDFAState*, oaStates.GetAt(nState));
+		lUsedMemory += sizeof(RegexDFAState) + state->ivPcs.GetUsedMemory() - sizeof(IntVector);
+		lUsedMemory += program->GetByteClassNumber() * sizeof(RegexDFAState*);
+	}
+	return lUsedMemory;
+}
+
+RegexDFAState* RegexDFA::ComputeNextState(RegexDFAState* state, int nChar)
+{
+	RegexDFAState* nextState;
+	int i;
+	int nPc;
+
+	require(state != NULL);
+	require(state->nextStates[program->GetByteClassAt(nChar)] == NULL);
+
+	// Calcul de l'ensemble des instructions atteintes apres lecture du caractere
+	ivNextPcs.SetSize(0);
+	NewMark();
+	for (i = 0; i < state->ivPcs.GetSize(); i++)
+	{
+		nPc = state->ivPcs.GetAt(i);
+		if (program->GetOpcodeAt(nPc) == RegexProgram::ReadChar and program->ReadCharAt(nPc, nChar))
+			AddClosure(nPc + 1, false, false, &ivNextPcs);
+	}
+
+	// En mode recherche, une nouvelle occurrence peut demarrer a chaque position
+	if (bSearch)
+		AddClosure(0, false, false, &ivNextPcs);
+
+	// Vidage du cache si necessaire: l'etat courant est alors detruit, et la transition n'est pas memorisee
+	if (oaStates.GetSize() >= nMaxStateNumber)
+	{
+		RemoveAllStates();
+		nextState = LookupState(&ivNextPcs, false);
+	}
+	else
+	{
+		nextState = LookupState(&ivNextPcs, false);
+		state->nextStates[program->GetByteClassAt(nChar)] = nextState;
+	}
+	return nextState;
+}
+
+RegexDFAState* RegexDFA::LookupState(IntVector* ivPcs, boolean bAtBegin)
+{
+	RegexDFAState* state;
+	ALString sKey;
+	int i;
+	int nPc;
+
+	require(ivPcs != NULL);
+
+	// Construction de la cle de l'ensemble d'instructions
+	ivPcs->Sort();
+	if (bAtBegin)
+		sKey = "^";
+	for (i = 0; i < ivPcs->GetSize(); i++)
+	{
+		sKey += IntToString(ivPcs->GetAt(i));
+		sKey += ',';
+	}
+
+	// Recherche de l'etat
+	state = cast(RegexDFAState*, odStates.Lookup(sKey));
+
+	// Creation si necessaire
+	if (state == NULL)
+	{
+		state = new RegexDFAState(program->GetByteClassNumber());
+		state->ivPcs.CopyFrom(ivPcs);
+		state->bDead = ivPcs->GetSize() == 0;
+
+		// Recherche des occurrences trouvees, et des fins de chaine en attente
+		ivEndPcs.SetSize(0);
+		NewMark();
+		for (i = 0; i < ivPcs->GetSize(); i++)
+		{
+			nPc = ivPcs->GetAt(i);
+			if (program->GetOpcodeAt(nPc) == RegexProgram::MatchFound)
+				state->bMatch = true;
+			else if (program->GetOpcodeAt(nPc) == RegexProgram::AssertEnd)
+				AddClosure(nPc + 1, bAtBegin, true, &ivEndPcs);
+		}
+		state->bMatchAtEnd = state->bMatch;
+		for (i = 0; i < ivEndPcs.GetSize(); i++)
+		{
+			if (program->GetOpcodeAt(ivEndPcs.GetAt(i)) == RegexProgram::MatchFound)
+				state->bMatchAtEnd = true;
+		}
+
+		// Memorisation
+		oaStates.Add(state);
+		odStates.SetAt(sKey, state);
+	}
+	return state;
+}
+
+void RegexDFA::NewMark()
+{
+	nCurrentMark++;
+}
+
+void RegexDFA::AddClosure(int nPc, boolean bAtBegin, boolean bAtEnd, IntVector* ivPcs)
+{
+	int nCurrentPc;
+
+	require(ivPcs != NULL);
+
+	// Parcours en profondeur des transitions sans lecture de caractere
+	ivStack.SetSize(0);
+	ivStack.Add(nPc);
+	while (ivStack.GetSize() > 0)
+	{
+		nCurrentPc = ivStack.GetAt(ivStack.GetSize() - 1);
+		ivStack.SetSize(ivStack.GetSize() - 1);
+		if (ivMarks.GetAt(nCurrentPc) == nCurrentMark)
+			continue;
+		ivMarks.SetAt(nCurrentPc, nCurrentMark);
+
+		switch (program->GetOpcodeAt(nCurrentPc))
+		{
+		case RegexProgram::Jump:
+			ivStack.Add(program->GetArg1At(nCurrentPc));
+			break;
+		case RegexProgram::Split:
+			ivStack.Add(program->GetArg2At(nCurrentPc));
+			ivStack.Add(program->GetArg1At(nCurrentPc));
+			break;
+		case RegexProgram::Save:
+			ivStack.Add(nCurrentPc + 1);
+			break;
+		case RegexProgram::AssertBegin:
+			if (bAtBegin)
+				ivStack.Add(nCurrentPc + 1);
+			break;
+		case RegexProgram::AssertEnd:
+			// Fin de chaine en attente si la position n'est pas connue
+			if (bAtEnd)
+				ivStack.Add(nCurrentPc + 1);
+			else
+				ivPcs->Add(nCurrentPc);
+			break;
+		default:
+			ivPcs->Add(nCurrentPc);
+			break;
+		}
+	}
+}
+
+void RegexDFA::RemoveAllStates()
+{
+	oaStates.DeleteAll();
+	odStates.RemoveAll();
+	startState = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexDFAState
+
+RegexDFAState::RegexDFAState(int nByteClassNumber)
+{
+	int i;
+
+	require(nByteClassNumber > 0);
+
+	nextStates = new RegexDFAState*[nByteClassNumber];
+	for (i = 0; i < nByteClassNumber; i++)
+		nextStates[i] = NULL;
+	bMatch = false;
+	bMatchAtEnd = false;
+	bDead = false;
+}
+
+RegexDFAState::~RegexDFAState()
+{
+	delete[] nextStates;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexThreadList
+
+RegexThreadList::RegexThreadList()
+{
+	nCurrentMark = 0;
+	nThreadNumber = 0;
+	nSlotNumber = 0;
+}
+
+RegexThreadList::~RegexThreadList() {}
+
+void RegexThreadList::Initialize(int nProgramSize, int nCaptureSlotNumber)
+{
+	require(nProgramSize > 0);
+	require(nCaptureSlotNumber >= 2);
+
+	ivMarks.SetSize(nProgramSize);
+	ivMarks.Initialize();
+	ivPcs.SetSize(0);
+	ivCaptures.SetSize(0);
+	nCurrentMark = 0;
+	nThreadNumber = 0;
+	nSlotNumber = nCaptureSlotNumber;
+}
+
+void RegexThreadList::Clear()
+{
+	nCurrentMark++;
+	nThreadNumber = 0;
+}
+
+void RegexThreadList::AddThread(int nPc, const IntVector* ivThreadCaptures)
+{
+	int nSlot;
+	int nOffset;
+
+	require(ivThreadCaptures != NULL and ivThreadCaptures->GetSize() == nSlotNumber);
+
+	// Agrandissement si necessaire, le nombre de threads etant borne par la taille du programme
+	if (nThreadNumber == ivPcs.GetSize())
+	{
+		ivPcs.SetSize(2 * nThreadNumber + 1);
+		ivCaptures.SetSize(ivPcs.GetSize() * nSlotNumber);
+	}
+
+	// Ajout du thread
+	ivPcs.SetAt(nThreadNumber, nPc);
+	nOffset = nThreadNumber * nSlotNumber;
+	for (nSlot = 0; nSlot < nSlotNumber; nSlot++)
+		ivCaptures.SetAt(nOffset + nSlot, ivThreadCaptures->GetAt(nSlot));
+	nThreadNumber++;
+}
+
+void RegexThreadList::ExportCaptures(int nThread, IntVector* ivThreadCaptures) const
+{
+	int nSlot;
+	int nOffset;
+
+	require(0 <= nThread and nThread < nThreadNumber);
+	require(ivThreadCaptures != NULL);
+
+	ivThreadCaptures->SetSize(nSlotNumber);
+	nOffset = nThread * nSlotNumber;
+	for (nSlot = 0; nSlot < nSlotNumber; nSlot++)
+		ivThreadCaptures->SetAt(nSlot, ivCaptures.GetAt(nOffset + nSlot));
+}
+
+longint RegexThreadList::GetUsedMemory() const
+{
+	return sizeof(RegexThreadList) + ivPcs.GetUsedMemory() + ivCaptures.GetUsedMemory() +
+	       ivMarks.GetUsedMemory() - 3 * sizeof(IntVector);
+}
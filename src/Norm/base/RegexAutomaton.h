@@ -0,0 +1,538 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#pragma once
+
+#include "Object.h"
+#include "Vector.h"
+#include "ALString.h"
+
+class RegexAutomaton;
+class RegexCharSet;
+class RegexNode;
+class RegexProgram;
+class RegexDFA;
+class RegexDFAState;
+class RegexThreadList;
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexAutomaton
+// Moteur d'expressions regulieres a temps de traitement lineaire en la longueur des chaines traitees,
+// pour un sous-ensemble de la syntaxe ECMAScript:
+//  . caracteres, eventuellement echappes (\t, \n, \v, \f, \r, \xHH, caracteres speciaux)
+//  . caractere quelconque '.', classes de caracteres [...] et [^...], classes \d, \w, \s et leur negation
+//  . groupes capturants (...) ou non capturants (?:...), alternatives |
+//  . quantificateurs gloutons ou non: *, +, ?, {n}, {n,}, {n,m}
+//  . ancres ^ et $ de debut et fin de chaine
+// Les autres constructions (references arriere, assertions \b ou (?=...), classes POSIX...) ne sont pas
+// gerees: la compilation echoue alors, et l'appelant doit utiliser une autre implementation.
+//
+// L'expression est compilee en un programme d'automate non deterministe (NFA de Thompson), exploite:
+//  . via des automates deterministes (DFA) construits a la demande et caches, pour les tests de correspondance
+//    et la recherche de position
+//  . via une simulation du NFA avec memorisation des sous-expressions (Pike VM) pour les remplacements, en
+//    respectant la priorite entre alternatives et quantificateurs de la syntaxe ECMAScript
+// Les chaines sont traitees comme des suites d'octets
+class RegexAutomaton : public Object
+{
+public:
+	// Constructeur
+	RegexAutomaton();
+	~RegexAutomaton();
+
+	// Compilation d'une expression reguliere
+	// Renvoie false si l'expression n'est pas valide ou utilise des constructions non gerees
+	boolean Compile(const char* sRegexValue);
+
+	// Indique si une expression a ete compilee avec succes
+	boolean IsCompiled() const;
+
+	// Nombre de sous-expressions capturantes, plus un pour l'expression entiere
+	int GetCaptureNumber() const;
+
+	// Indique si les sous-expressions capturantes sont calculees exactement comme dans std::regex
+	// Ce n'est pas le cas pour les sous-expressions d'une repetition dont une iteration peut etre vide,
+	// comme dans "(a*)*", pour lesquelles std::regex memorise une derniere iteration vide
+	boolean HasExactCaptures() const;
+
+	// Test de correspondance de l'expression avec toute la chaine
+	boolean Match(const char* sValue, int nLength);
+
+	// Position de debut de la premiere occurrence de l'expression dans la chaine, -1 si non trouvee
+	int Find(const char* sValue, int nLength);
+
+	// Recherche de la premiere occurrence a partir d'une position de depart, selon la semantique ECMAScript
+	// Les positions de debut et fin de l'occurrence et de chaque sous-expression sont rangees dans un vecteur
+	// de taille 2*GetCaptureNumber(), avec -1 pour les sous-expressions non utilisees
+	// En mode bContinuousNotNull, l'occurrence doit commencer a la position de depart et etre non vide
+	boolean Search(const char* sValue, int nLength, int nStart, boolean bContinuousNotNull,
+		       IntVector* ivCaptures);
+
+	// Remplacement de toutes les occurrences, en utilisant le format de remplacement ECMAScript
+	// ($&, $`, $', $$, $n et $nn), avec le meme enchainement des occurrences que std::regex_replace
+	void ReplaceAll(const char* sValue, int nLength, const char* sReplace, ALString& sResult);
+
+	// Memoire utilisee
+	longint GetUsedMemory() const override;
+
+	// Libelle de la classe
+	const ALString GetClassLabel() const override;
+
+	////////////////////////////////////////////////////////////////////
+	///// Implementation
+protected:
+	// Analyse syntaxique de l'expression, renvoyant NULL en cas d'echec
+	// L'analyse suit la grammaire: alternative := concatenation ('|' concatenation)*
+	//                              concatenation := (atom quantifier?)*
+	RegexNode* ParseAlternative();
+	RegexNode* ParseConcatenation();
+	RegexNode* ParseAtom();
+	RegexNode* ParseQuantifier(RegexNode* atomNode);
+	boolean ParseInteger(int& nValue);
+	RegexCharSet* ParseCharSet();
+	boolean ParseEscapedChar(boolean bInCharSet, int& nChar, RegexCharSet*& charSet);
+
+	// Verification recursive de l'exactitude des sous-expressions capturantes
+	boolean CheckExactCaptures(const RegexNode* node) const;
+
+	// Ajout du format de remplacement d'une occurrence trouvee, le prefixe de l'occurrence commencant
+	// a la position nPrefixStart
+	void AppendFormat(const char* sValue, int nLength, int nPrefixStart, const IntVector* ivCaptures,
+			  const char* sReplace, ALString& sResult) const;
+
+	// Ajout d'une portion de chaine
+	void AppendRange(const char* sValue, int nBegin, int nEnd, ALString& sResult) const;
+
+	// Ajout d'un thread a une liste de threads de la Pike VM, en suivant les transitions sans consommation
+	// de caractere
+	void AddThread(RegexThreadList* threadList, int nPc, int nPos, IntVector* ivThreadCaptures);
+
+	// Valeur de l'expression et position courante lors de l'analyse syntaxique
+	ALString sRegex;
+	int nParsePosition;
+	boolean bParseError;
+
+	// Nombre de sous-expressions capturantes, plus un
+	int nCaptureNumber;
+	boolean bExactCaptures;
+
+	// Programmes compiles, dans le sens de lecture et en sens inverse
+	RegexProgram* forwardProgram;
+	RegexProgram* reverseProgram;
+
+	// Automates deterministes pour la correspondance, la recherche et la recherche inverse
+	RegexDFA* matchDFA;
+	RegexDFA* searchDFA;
+	RegexDFA* reverseSearchDFA;
+
+	// Listes de threads de la Pike VM, et longueur de la chaine en cours de traitement
+	RegexThreadList* currentThreads;
+	RegexThreadList* nextThreads;
+	IntVector ivWorkingCaptures;
+	int nSearchedLength;
+
+	// Nombre max d'instructions d'un programme et de repetitions d'un quantificateur
+	static const int nMaxProgramSize = 5000;
+	static const int nMaxRepetitionNumber = 1000;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexCharSet
+// Ensemble de caracteres (octets) pour les expressions regulieres
+class RegexCharSet : public Object
+{
+public:
+	// Constructeur
+	RegexCharSet();
+	~RegexCharSet();
+
+	// Ajout d'un caractere ou d'un intervalle de caracteres
+	void AddChar(int nChar);
+	void AddRange(int nFirstChar, int nLastChar);
+
+	// Ajout de tous les caracteres d'un autre ensemble
+	void AddCharSet(const RegexCharSet* charSet);
+
+	// Complementaire de l'ensemble
+	void Negate();
+
+	// Test d'appartenance
+	boolean Contains(int nChar) const;
+
+	// Ensembles predefinis
+	void AddDigits();
+	void AddWordChars();
+	void AddSpaces();
+	void AddAnyChar();
+
+	// Duplication
+	RegexCharSet* Clone() const;
+
+	///// Implementation
+protected:
+	UINT nBits[8];
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexNode
+// Noeud de l'arbre syntaxique d'une expression reguliere
+class RegexNode : public Object
+{
+public:
+	// Constructeur
+	RegexNode();
+	~RegexNode();
+
+	// Types de noeud
+	enum
+	{
+		Empty,
+		CharSet,
+		Concatenation,
+		Alternative,
+		Repetition,
+		Group,
+		BeginAssertion,
+		EndAssertion
+	};
+
+	// Type du noeud
+	int nType;
+
+	// Ensemble de caracteres, pour un noeud de type CharSet (appartient au noeud)
+	RegexCharSet* charSet;
+
+	// Sous-noeuds (appartiennent au noeud)
+	ObjectArray oaChildren;
+
+	// Nombre min et max de repetitions (-1 si illimite), et repetition gloutonne ou non
+	int nMinRepetition;
+	int nMaxRepetition;
+	boolean bGreedy;
+
+	// Index de la sous-expression pour un groupe capturant, -1 sinon
+	int nCaptureIndex;
+
+	// Indique si le noeud peut correspondre a une chaine vide
+	boolean IsNullable() const;
+
+	// Indique si le noeud contient un groupe capturant
+	boolean ContainsCapture() const;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexProgram
+// Programme d'un automate non deterministe, compile a partir d'un arbre syntaxique
+class RegexProgram : public Object
+{
+public:
+	// Constructeur
+	RegexProgram();
+	~RegexProgram();
+
+	// Codes des instructions
+	enum
+	{
+		ReadChar,        // Lecture d'un caractere de l'ensemble d'index Arg1
+		Split,           // Branchement vers Arg1 (prioritaire) et Arg2
+		Jump,            // Branchement vers Arg1
+		Save,            // Memorisation de la position courante dans la sous-expression Arg1
+		AssertBegin,     // Debut de chaine
+		AssertEnd,       // Fin de chaine
+		MatchFound       // Occurrence trouvee
+	};
+
+	// Compilation d'un arbre syntaxique, avec ou sans les instructions de memorisation des sous-expressions,
+	// dans le sens de lecture ou en sens inverse
+	// Renvoie false si le programme depasse la taille max
+	boolean Compile(const RegexNode* rootNode, boolean bReverse, int nMaxSize);
+
+	// Taille du programme
+	int GetSize() const;
+
+	// Acces aux instructions
+	int GetOpcodeAt(int nPc) const;
+	int GetArg1At(int nPc) const;
+	int GetArg2At(int nPc) const;
+
+	// Test d'appartenance d'un caractere a l'ensemble lu par une instruction de lecture
+	boolean ReadCharAt(int nPc, int nChar) const;
+
+	// Partition des caracteres en classes d'equivalence: deux caracteres d'une meme classe
+	// sont acceptes par exactement les memes instructions de lecture
+	int GetByteClassNumber() const;
+	int GetByteClassAt(int nChar) const;
+
+	// Memoire utilisee
+	longint GetUsedMemory() const override;
+
+	///// Implementation
+protected:
+	// Compilation recursive d'un noeud
+	// La compilation s'arrete des que la taille max est depassee
+	void CompileNode(const RegexNode* node, boolean bReverse);
+
+	// Patch de l'argument d'une instruction de branchement
+	void SetArg1At(int nPc, int nValue);
+	void SetArg2At(int nPc, int nValue);
+
+	// Ajout d'une instruction, renvoyant son index
+	int AddInstruction(int nOpcode, int nArg1, int nArg2);
+
+	// Calcul des classes d'equivalence des caracteres
+	void ComputeByteClasses();
+
+	// Instructions, stockees par colonne
+	IntVector ivOpcodes;
+	IntVector ivArgs1;
+	IntVector ivArgs2;
+
+	// Ensembles de caracteres des instructions de lecture
+	ObjectArray oaCharSets;
+
+	// Classes d'equivalence des caracteres
+	int nByteClasses[256];
+	int nByteClassNumber;
+
+	// Taille max du programme en cours de compilation
+	int nMaxProgramSize;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexDFA
+// Automate deterministe construit a la demande a partir du programme d'un automate non deterministe
+// Chaque etat correspond a un ensemble d'instructions du programme. Les etats et leurs transitions sont
+// caches au fur et a mesure de leur utilisation. Au dela d'un nombre max d'etats, le cache est vide.
+// En mode recherche, l'instruction de debut du programme est ajoutee apres chaque transition, ce qui
+// revient a chercher une occurrence demarrant a n'importe quelle position
+class RegexDFA : public Object
+{
+public:
+	// Constructeur
+	RegexDFA();
+	~RegexDFA();
+
+	// Initialisation a partir d'un programme (qui n'appartient pas a l'automate), en mode recherche ou non
+	void Initialize(const RegexProgram* regexProgram, boolean bSearchMode);
+
+	// Etat initial, pour une position de debut de chaine
+	RegexDFAState* GetStartState();
+
+	// Etat suivant apres lecture d'un caractere
+	RegexDFAState* GetNextState(RegexDFAState* state, int nChar);
+
+	// Nombre d'etats
+	int GetStateNumber() const;
+
+	// Memoire utilisee
+	longint GetUsedMemory() const override;
+
+	///// Implementation
+protected:
+	// Calcul de l'etat suivant
+	RegexDFAState* ComputeNextState(RegexDFAState* state, int nChar);
+
+	// Recherche ou creation de l'etat correspondant a un ensemble d'instructions, pour une position
+	// en debut de chaine ou non
+	RegexDFAState* LookupState(IntVector* ivPcs, boolean bAtBegin);
+
+	// Ajout a un ensemble d'instructions de la fermeture d'une instruction par les transitions sans lecture
+	// Les instructions deja marquees sont ignorees: il faut appeler NewMark avant chaque nouvel ensemble
+	void NewMark();
+	void AddClosure(int nPc, boolean bAtBegin, boolean bAtEnd, IntVector* ivPcs);
+
+	// Vidage du cache d'etats
+	void RemoveAllStates();
+
+	// Programme
+	const RegexProgram* program;
+	boolean bSearch;
+
+	// Etats, et dictionnaire des etats par ensemble d'instructions
+	ObjectArray oaStates;
+	ObjectDictionary odStates;
+	RegexDFAState* startState;
+
+	// Marquage des instructions deja traitees lors du calcul des fermetures
+	IntVector ivMarks;
+	int nCurrentMark;
+	IntVector ivStack;
+
+	// Ensembles d'instructions de travail
+	IntVector ivNextPcs;
+	IntVector ivEndPcs;
+
+	// Nombre max d'etats du cache
+	static const int nMaxStateNumber = 1000;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexDFAState
+// Etat d'un automate deterministe
+class RegexDFAState : public Object
+{
+public:
+	// Constructeur
+	RegexDFAState(int nByteClassNumber);
+	~RegexDFAState();
+
+	// Instructions de l'etat (lectures, fins de chaine et occurrences trouvees), triees par index
+	IntVector ivPcs;
+
+	// Transitions par classe de caracteres, NULL si non encore calculees
+	RegexDFAState** nextStates;
+
+	// Indique si une occurrence est trouvee, et si une occurrence est trouvee en fin de chaine
+	boolean bMatch;
+	boolean bMatchAtEnd;
+
+	// Indique si l'etat est un etat mort, sans aucune instruction
+	boolean bDead;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Classe RegexThreadList
+// Liste ordonnee par priorite des threads de la Pike VM, avec leurs positions de sous-expressions
+class RegexThreadList : public Object
+{
+public:
+	// Constructeur
+	RegexThreadList();
+	~RegexThreadList();
+
+	// Initialisation pour un programme et un nombre de positions de sous-expressions
+	void Initialize(int nProgramSize, int nCaptureSlotNumber);
+
+	// Vidage de la liste
+	void Clear();
+
+	// Marquage d'une instruction, renvoyant false si elle etait deja marquee
+	boolean Mark(int nPc);
+
+	// Ajout d'un thread
+	void AddThread(int nPc, const IntVector* ivCaptures);
+
+	// Acces aux threads
+	int GetThreadNumber() const;
+	int GetPcAt(int nThread) const;
+	int GetCaptureAt(int nThread, int nSlot) const;
+	void ExportCaptures(int nThread, IntVector* ivCaptures) const;
+
+	// Memoire utilisee
+	longint GetUsedMemory() const override;
+
+	///// Implementation
+protected:
+	IntVector ivPcs;
+	IntVector ivCaptures;
+	IntVector ivMarks;
+	int nCurrentMark;
+	int nThreadNumber;
+	int nSlotNumber;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Methodes en inline
+
+inline boolean RegexAutomaton::IsCompiled() const
+{
+	return forwardProgram != NULL;
+}
+
+inline int RegexAutomaton::GetCaptureNumber() const
+{
+	return nCaptureNumber;
+}
+
+inline boolean RegexCharSet::Contains(int nChar) const
+{
+	require(0 <= nChar and nChar < 256);
+	return (nBits[nChar >> 5] & (1u << (nChar & 31))) != 0;
+}
+
+inline int RegexProgram::GetSize() const
+{
+	return ivOpcodes.GetSize();
+}
+
+inline int RegexProgram::GetOpcodeAt(int nPc) const
+{
+	return ivOpcodes.GetAt(nPc);
+}
+
+inline int RegexProgram::GetArg1At(int nPc) const
+{
+	return ivArgs1.GetAt(nPc);
+}
+
+inline int RegexProgram::GetArg2At(int nPc) const
+{
+	return ivArgs2.GetAt(nPc);
+}
+
+inline boolean RegexProgram::ReadCharAt(int nPc, int nChar) const
+{
+	require(GetOpcodeAt(nPc) == ReadChar);
+	return cast(const RegexCharSet*, oaCharSets.GetAt(ivArgs1.GetAt(nPc)))->Contains(nChar);
+}
+
+inline int RegexProgram::GetByteClassNumber() const
+{
+	return nByteClassNumber;
+}
+
+inline int RegexProgram::GetByteClassAt(int nChar) const
+{
+	require(0 <= nChar and nChar < 256);
+	return nByteClasses[nChar];
+}
+
+inline boolean RegexAutomaton::HasExactCaptures() const
+{
+	require(IsCompiled());
+	return bExactCaptures;
+}
+
+inline RegexDFAState* RegexDFA::GetNextState(RegexDFAState* state, int nChar)
+{
+	RegexDFAState* nextState;
+
+	require(state != NULL);
+
+	nextState = state->nextStates[program->GetByteClassAt(nChar)];
+	if (nextState == NULL)
+		nextState = ComputeNextState(state, nChar);
+	return nextState;
+}
+
+inline int RegexDFA::GetStateNumber() const
+{
+	return oaStates.GetSize();
+}
+
+inline boolean RegexThreadList::Mark(int nPc)
+{
+	if (ivMarks.GetAt(nPc) == nCurrentMark)
+		return false;
+	ivMarks.SetAt(nPc, nCurrentMark);
+	return true;
+}
+
+inline int RegexThreadList::GetThreadNumber() const
+{
+	return nThreadNumber;
+}
+
+inline int RegexThreadList::GetPcAt(int nThread) const
+{
+	require(0 <= nThread and nThread < nThreadNumber);
+	return ivPcs.GetAt(nThread);
+}
+
+inline int RegexThreadList::GetCaptureAt(int nThread, int nSlot) const
+{
+	require(0 <= nThread and nThread < nThreadNumber);
+	require(0 <= nSlot and nSlot < nSlotNumber);
+	return ivCaptures.GetAt(nThread * nSlotNumber + nSlot);
+}
@@ -16,10 +16,14 @@
 Regex::Regex()
 {
 	regexObject = NULL;
+	regexAutomaton = NULL;
+	bUseAutomaton = true;
 }
 
 Regex::~Regex()
 {
+	if (regexAutomaton != NULL)
+		delete regexAutomaton;
 #ifdef __REGEX__
 	if (regexObject != NULL)
 	{
@@ -36,6 +40,11 @@ boolean Regex::Initialize(const char* sRegexValue, const Object* errorSender)
 	require(sRegexValue != NULL);
 
 	// Initialisation a vide
+	if (regexAutomaton != NULL)
+	{
+		delete regexAutomaton;
+		regexAutomaton = NULL;
+	}
 #ifdef __REGEX__
 	if (regexObject != NULL)
 	{
@@ -66,8 +75,15 @@ boolean Regex::Initialize(const char* sRegexValue, const Object* errorSender)
 		if (errorSender != NULL)
 			errorSender->AddError(sTmp + "Regex library not available not available on current platform");
 	}
+	// Sinon, on tente d'abord de compiler l'expression dans un automate, en se contentant de l'automate
+	// si ses sous-expressions capturantes sont exactes
+	else if (bUseAutomaton and CompileAutomaton() and regexAutomaton->HasExactCaptures())
+	{
+		assert(regexAutomaton != NULL);
+	}
 #ifdef __REGEX__
-	// Sinon, on tente de cree un objet regex
+	// Sinon, on tente de cree un objet regex, utilise pour tous les traitements, ou uniquement
+	// pour les remplacements si l'automate est disponible
 	else
 	{
 		try
@@ -93,7 +109,7 @@ boolean Regex::Initialize(const char* sRegexValue, const Object* errorSender)
 		}
 	}
 #endif // __REGEX__
-	return regexObject != NULL;
+	return IsValid();
 }
 
 const ALString& Regex::GetRegex() const
@@ -103,7 +119,7 @@ const ALString& Regex::GetRegex() const
 
 boolean Regex::IsValid() const
 {
-	return regexObject != NULL;
+	return regexObject != NULL or regexAutomaton != NULL;
 }
 
 boolean Regex::Match(const char* sValue)
@@ -113,6 +129,10 @@ boolean Regex::Match(const char* sValue)
 
 	require(sValue != NULL);
 
+	// Utilisation de l'automate si possible
+	if (regexAutomaton != NULL)
+		return regexAutomaton->Match(sValue, (int)strlen(sValue));
+
 #ifdef __REGEX__
 	// Recherche uniquement si la regex est valide
 	if (IsValid())
@@ -141,6 +161,10 @@ int Regex::Find(const char* sValue)
 
 	require(sValue != NULL);
 
+	// Utilisation de l'automate si possible
+	if (regexAutomaton != NULL)
+		return regexAutomaton->Find(sValue, (int)strlen(sValue));
+
 #ifdef __REGEX__
 	// Recherche uniquement si la regex est valide
 	if (IsValid())
@@ -178,9 +202,29 @@ ALString Regex::Replace(const char* sValue, const char* sReplace)
 	require(sValue != NULL);
 	require(sReplace != NULL);
 
+	// Utilisation de l'automate si possible
+	// Comme pour std::regex, le remplacement est effectue en appliquant un remplacement global
+	// a la sous-chaine de la premiere occurrence trouvee
+	if (regexAutomaton != NULL and regexObject == NULL)
+	{
+		IntVector ivCaptures;
+		ALString sReplacedMatch;
+		int nLength;
+
+		nLength = (int)strlen(sValue);
+		if (regexAutomaton->Search(sValue, nLength, 0, false, &ivCaptures))
+		{
+			regexAutomaton->ReplaceAll(sValue + ivCaptures.GetAt(0),
+						   ivCaptures.GetAt(1) - ivCaptures.GetAt(0), sReplace, sReplacedMatch);
+			sReplacedString = ALString(sValue, ivCaptures.GetAt(0));
+			sReplacedString += sReplacedMatch;
+			sReplacedString += sValue + ivCaptures.GetAt(1);
+			bReplaced = true;
+		}
+	}
 #ifdef __REGEX__
 	// Recherche uniquement si la regex est valide
-	if (IsValid())
+	else if (IsValid())
 	{
 		// Recherche de la regex pour remplacer sa premiere occurrence
 		try
@@ -228,9 +272,15 @@ ALString Regex::ReplaceAll(const char* sValue, const char* sReplace)
 	require(sValue != NULL);
 	require(sReplace != NULL);
 
+	// Utilisation de l'automate si possible
+	if (regexAutomaton != NULL and regexObject == NULL)
+	{
+		regexAutomaton->ReplaceAll(sValue, (int)strlen(sValue), sReplace, sReplacedString);
+		bReplaced = true;
+	}
 #ifdef __REGEX__
 	// Recherche uniquement si la regex est valide
-	if (IsValid())
+	else if (IsValid())
 	{
 		// Recherche de la regex pour remplacer toutes ses occurrences
 		// On passe ici std::back_inserter qui est plus efficace dans sa gestion memoire, en evitant de passer
@@ -274,6 +324,8 @@ longint Regex::GetUsedMemory() const
 	// grammaire de la regex)
 	if (regexObject != NULL)
 		lUsedMemory += sRegex.GetLength() * 10 * sizeof(void*);
+	if (regexAutomaton != NULL)
+		lUsedMemory += regexAutomaton->GetUsedMemory();
 	return lUsedMemory;
 }
 
@@ -368,6 +420,133 @@ void Regex::Test()
 		sTest.SetAt(i, 'A');
 	sTest = regexObject.ReplaceAll(sTest, sReplace);
 	cout << sTest.Left(10) << "...: " << sTest.GetLength() << endl;
+
+	// Test de l'automate, avec comparaison des resultats a ceux de std::regex
+	TestAutomaton();
+}
+
+void Regex::TestAutomaton()
+{
+	const int nPathologicalStringLength = 100000;
+	Regex regexObject;
+	Regex regexReference;
+	StringVector svRegex;
+	StringVector svReplace;
+	StringVector svTestStrings;
+	int nRegex;
+	int nTest;
+	int nReplace;
+	int nComparisonNumber;
+	int nDifferenceNumber;
+	ALString sRegex;
+	ALString sTest;
+	int i;
+
+	// Expressions, dont les dernieres ne sont pas gerees par l'automate
+	svRegex.Add("a|ab");
+	svRegex.Add("(a|ab)(c|bcd)(d*)");
+	svRegex.Add("a*");
+	svRegex.Add("a*?");
+	svRegex.Add("(a+)(b*)");
+	svRegex.Add("^a");
+	svRegex.Add("b$");
+	svRegex.Add("^$");
+	svRegex.Add("[a-c]+");
+	svRegex.Add("[^a-c ]+");
+	svRegex.Add("\\d+\\.\\d*");
+	svRegex.Add("(\\w+)@(\\w+)\\.com");
+	svRegex.Add("(\\s*)(\\S+)");
+	svRegex.Add(".{2,3}");
+	svRegex.Add("(a{2})*");
+	svRegex.Add("(?:ab)+?");
+	svRegex.Add("a(b|c)?d");
+	svRegex.Add("[-M]r?");
+	svRegex.Add("\\x41+");
+	svRegex.Add("(a*)*");
+	svRegex.Add("(a|b)*c");
+	svRegex.Add("\\(\\d\\)");
+	svRegex.Add("(a)\\1");
+	svRegex.Add("\\bMr");
+	svRegex.Add("[[:digit:]]+");
+
+	// Valeurs de remplacement
+	svReplace.Add("[$&]");
+	svReplace.Add("<$1|$2>");
+	svReplace.Add("$`");
+	svReplace.Add("$'");
+	svReplace.Add("$$");
+	svReplace.Add("$9x$");
+	svReplace.Add("$x");
+
+	// Chaines traitees
+	svTestStrings.Add("");
+	svTestStrings.Add("a");
+	svTestStrings.Add("ab");
+	svTestStrings.Add("abcd");
+	svTestStrings.Add("aab aaab");
+	svTestStrings.Add("Bonjour Mr Dupond");
+	svTestStrings.Add(" 12.5 x@y.com ");
+	svTestStrings.Add("bab(1)AAxacd");
+
+	// Comparaison systematique des resultats
+	nComparisonNumber = 0;
+	nDifferenceNumber = 0;
+	regexReference.bUseAutomaton = false;
+	for (nRegex = 0; nRegex < svRegex.GetSize(); nRegex++)
+	{
+		sRegex = svRegex.GetAt(nRegex);
+		regexObject.Initialize(sRegex, NULL);
+		regexReference.Initialize(sRegex, NULL);
+		cout << sRegex << "\t" << (regexObject.regexAutomaton != NULL) << "\t"
+		     << (regexObject.regexObject == NULL) << "\t"
+		     << regexObject.ReplaceAll("aab aaab Mr Dupond bab(1) 12.5", "[$&]") << endl;
+		if (regexObject.IsValid() and regexReference.IsValid())
+		{
+			for (nTest = 0; nTest < svTestStrings.GetSize(); nTest++)
+			{
+				sTest = svTestStrings.GetAt(nTest);
+				nComparisonNumber++;
+				if (regexObject.Match(sTest) != regexReference.Match(sTest) or
+				    regexObject.Find(sTest) != regexReference.Find(sTest))
+					nDifferenceNumber++;
+				for (nReplace = 0; nReplace < svReplace.GetSize(); nReplace++)
+				{
+					nComparisonNumber++;
+					if (regexObject.Replace(sTest, svReplace.GetAt(nReplace)) !=
+						regexReference.Replace(sTest, svReplace.GetAt(nReplace)) or
+					    regexObject.ReplaceAll(sTest, svReplace.GetAt(nReplace)) !=
+						regexReference.ReplaceAll(sTest, svReplace.GetAt(nReplace)))
+						nDifferenceNumber++;
+				}
+			}
+		}
+	}
+	cout << "Comparisons with std::regex: " << nComparisonNumber << ", differences: " << nDifferenceNumber
+	     << endl;
+
+	// Expressions pathologiques, en temps exponentiel pour un moteur a retour arriere
+	sTest.GetBufferSetLength(nPathologicalStringLength);
+	for (i = 0; i < sTest.GetLength(); i++)
+		sTest.SetAt(i, 'a');
+	regexObject.Initialize("(?:a*)*b", NULL);
+	cout << regexObject.GetRegex() << "\t" << regexObject.Match(sTest) << "\t" << regexObject.Find(sTest)
+	     << "\t" << regexObject.ReplaceAll(sTest, "").GetLength() << endl;
+	regexObject.Initialize("(a|aa)+$", NULL);
+	cout << regexObject.GetRegex() << "\t" << regexObject.Match(sTest) << "\t" << regexObject.Find(sTest)
+	     << "\t" << regexObject.ReplaceAll(sTest, "$1").GetLength() << endl;
+}
+
+boolean Regex::CompileAutomaton()
+{
+	require(regexAutomaton == NULL);
+
+	regexAutomaton = new RegexAutomaton;
+	if (not regexAutomaton->Compile(sRegex))
+	{
+		delete regexAutomaton;
+		regexAutomaton = NULL;
+	}
+	return regexAutomaton != NULL;
 }
 
 const ALString Regex::GetShortValue(const ALString& sValue) const
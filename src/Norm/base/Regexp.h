@@ -7,6 +7,7 @@
 #include "ALString.h"
 #include "Object.h"
 #include "Ermgt.h"
+#include "RegexAutomaton.h"
 
 ////////////////////////////////////////////////////////////////////////////
 // Classe Regex
@@ -79,8 +80,19 @@ protected:
 	// Renvoie une version courte d'une chaine de caractere en entree
 	const ALString GetShortValue(const ALString& sValue) const;
 
+	// Test de l'automate
+	static void TestAutomaton();
+
+	// Tentative de compilation de l'expression en cours dans un automate
+	// Renvoie false si l'expression utilise des constructions non gerees par l'automate
+	boolean CompileAutomaton();
+
 	////////////////////////////////////////////////////////////////////
-	// L'implementation exploite la librairie regex du C++ 11, en passant au maximum
+	// L'implementation exploite en priorite un automate dedie (cf. RegexAutomaton), dont le temps de
+	// traitement est lineaire en la longueur des chaines, y compris pour les expressions pathologiques
+	// comme "(a*)*b" qui provoquent un temps exponentiel ou un debordement de pile dans std::regex
+	// Pour les expressions utilisant des constructions non gerees par l'automate, on se rabat
+	// sur la librairie regex du C++ 11, en passant au maximum
 	// par les variantes exploitant les const char* plutot que les string du C++.
 	// Cela permet de reutiliser au maximum les objets ALString, qui sont
 	// plus efficaces et beaucoup plus parcimonieux que les string
@@ -94,4 +106,10 @@ protected:
 	// Object generique pour stocker un objet de gestion de la regex
 	// Cela permet de gerer les plate-forme ne supportant pas les regex
 	void* regexObject;
+
+	// Automate utilise en priorite, NULL si l'expression n'est pas geree par l'automate
+	RegexAutomaton* regexAutomaton;
+
+	// Indique si l'automate doit etre utilise (true par defaut, false uniquement pour les tests)
+	boolean bUseAutomaton;
 };
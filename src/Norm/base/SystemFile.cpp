@@ -223,6 +223,17 @@ longint SystemFile::Read(void* pBuffer, size_t size, size_t count)
 	return lRes;
 }
 
+void SystemFile::ReadAhead(longint lPosition, longint lSize)
+{
+	require(fileDriver != NULL);
+	require(fileHandle != NULL);
+	require(bIsOpenForRead);
+	require(lPosition >= 0);
+	require(lSize >= 0);
+
+	fileDriver->ReadAhead(lPosition, lSize, fileHandle);
+}
+
 boolean SystemFile::SeekPositionInFile(longint lPosition)
 {
 	boolean bRes;
@@ -38,6 +38,10 @@ public:
 	// Positionnement dans un fichier ouvert en lecture
 	boolean SeekPositionInFile(longint lPosition);
 
+	// Indication qu'une portion du fichier ouvert en lecture va etre lue prochainement,
+	// pour qu'elle soit chargee en arriere plan si le driver le permet
+	void ReadAhead(longint lPosition, longint lSize);
+
 	// Renvoie le nombre d'octets ecrits, 0 si il y a eu une erreur
 	longint Write(const void* pBuffer, size_t size, size_t count);
 
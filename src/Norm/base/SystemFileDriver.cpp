@@ -80,6 +80,8 @@ boolean SystemFileDriver::ReserveExtraSize(longint lSize, void* stream)
 	return true;
 }
 
+void SystemFileDriver::ReadAhead(longint lPosition, longint lSize, void* stream) {}
+
 boolean SystemFileDriver::CopyFileFromLocal(const char* sSourceFilePathName, const char* sDestFilePathName)
 {
 	FILE* fSource;
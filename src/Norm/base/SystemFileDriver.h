@@ -65,6 +65,11 @@ public:
 	// Positionnement dans un fichier ouvert en lecture
 	virtual boolean SeekPositionInFile(longint lPosition, void* stream) = 0;
 
+	// Indication qu'une portion d'un fichier ouvert en lecture va etre lue prochainement, pour
+	// permettre au systeme de la charger en arriere plan pendant le traitement des donnees courantes
+	// Methode avancee optionnelle (ne fait rien par defaut), sans effet sur le resultat des lectures
+	virtual void ReadAhead(longint lPosition, longint lSize, void* stream);
+
 	// Copie du systeme de fichier courant vers le systeme de fichier standard
 	// L'implementation par defaut utilise Fread et Fwrite
 	virtual boolean CopyFileToLocal(const char* sSourceFilePathName, const char* sDestFilePathName);
@@ -4,6 +4,10 @@
 
 #include "SystemFileDriverANSI.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#endif // __linux__
+
 SystemFileDriverANSI::SystemFileDriverANSI() {}
 
 SystemFileDriverANSI::~SystemFileDriverANSI() {}
@@ -131,6 +135,17 @@ boolean SystemFileDriverANSI::SeekPositionInFile(longint lPosition, void* stream
 	return FileService::SeekPositionInBinaryFile((FILE*)stream, lPosition);
 }
 
+void SystemFileDriverANSI::ReadAhead(longint lPosition, longint lSize, void* stream)
+{
+	require(lPosition >= 0);
+	require(lSize >= 0);
+
+	// Demande de lecture anticipee asynchrone dans le cache du systeme (sans effet ailleurs que sous Linux)
+#ifdef __linux__
+	posix_fadvise(fileno((FILE*)stream), lPosition, lSize, POSIX_FADV_WILLNEED);
+#endif // __linux__
+}
+
 const char* SystemFileDriverANSI::GetLastErrorMessage() const
 {
 	return strerror(errno);
@@ -33,6 +33,7 @@ public:
 	boolean Close(void* stream) override;
 	longint Fread(void* ptr, size_t size, size_t count, void* stream) override;
 	boolean SeekPositionInFile(longint lPosition, void* stream) override;
+	void ReadAhead(longint lPosition, longint lSize, void* stream) override;
 	const char* GetLastErrorMessage() const override;
 	longint Fwrite(const void* ptr, size_t size, size_t count, void* stream) override;
 	boolean Flush(void* stream) override;
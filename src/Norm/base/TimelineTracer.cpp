@@ -0,0 +1,391 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#include "TimelineTracer.h"
+
+#include "PLRemoteFileService.h"
+#include "FileService.h"
+
+TimelineTracer::TimelineEvent* TimelineTracer::events = NULL;
+int TimelineTracer::nEventCapacity = 0;
+int TimelineTracer::nFirstEventIndex = 0;
+int TimelineTracer::nEventNumber = 0;
+longint TimelineTracer::lLostEventNumber = 0;
+double TimelineTracer::dStartAbsoluteTime = 0;
+Timer TimelineTracer::timer;
+
+void TimelineTracer::Start(int nCapacity)
+{
+	require(nCapacity > 0);
+
+	// Reinitialisation si necessaire
+	Stop();
+
+	// Allocation du buffer
+	events = new TimelineEvent[nCapacity];
+	nEventCapacity = nCapacity;
+	nFirstEventIndex = 0;
+	nEventNumber = 0;
+	lLostEventNumber = 0;
+
+	// Temps de depart
+	dStartAbsoluteTime = Timer::GetAbsoluteTime();
+	timer.Reset();
+	timer.Start();
+}
+
+void TimelineTracer::Stop()
+{
+	if (IsStarted())
+	{
+		delete[] events;
+		events = NULL;
+		nEventCapacity = 0;
+		nFirstEventIndex = 0;
+		nEventNumber = 0;
+		lLostEventNumber = 0;
+		dStartAbsoluteTime = 0;
+		timer.Stop();
+		timer.Reset();
+	}
+}
+
+int TimelineTracer::GetEventNumber()
+{
+	return nEventNumber;
+}
+
+longint TimelineTracer::GetLostEventNumber()
+{
+	return lLostEventNumber;
+}
+
+void TimelineTracer::ExportTrace(TimelineTrace* trace)
+{
+	int i;
+	TimelineEvent* event;
+	NumericKeyDictionary nkdNames;
+	StringObject* soName;
+
+	require(trace != NULL);
+
+	// Initialisation de la trace
+	trace->Clean();
+	trace->SetRank(GetProcessId());
+	trace->SetStartAbsoluteTime(dStartAbsoluteTime);
+	trace->SetLostEventNumber(lLostEventNumber);
+
+	// Export des evenements dans l'ordre chronologique
+	// Les libelles etant des chaines constantes, on passe par un dictionnaire indexe par leur adresse
+	// pour ne construire qu'une seule fois chaque ALString
+	for (i = 0; i < nEventNumber; i++)
+	{
+		event = &events[(nFirstEventIndex + i) % nEventCapacity];
+		soName = cast(StringObject*, nkdNames.Lookup(event->sName));
+		if (soName == NULL)
+		{
+			soName = new StringObject;
+			soName->SetString(event->sName);
+			nkdNames.SetAt(event->sName, soName);
+		}
+		trace->AddEvent(event->cType, soName->GetString(), event->lTime, event->lValue);
+	}
+	nkdNames.DeleteAll();
+
+	// Vidage du buffer
+	nFirstEventIndex = 0;
+	nEventNumber = 0;
+	lLostEventNumber = 0;
+}
+
+boolean TimelineTracer::WriteChromeTraceFile(const ALString& sFileName, const ObjectArray* oaTraces)
+{
+	boolean bOk;
+	fstream fst;
+	ALString sLocalFileName;
+	ALString sTmp;
+	const TimelineTrace* trace;
+	double dMinStartAbsoluteTime;
+	longint lTimeOffset;
+	boolean bFirstEvent;
+	int nTrace;
+	int i;
+
+	require(sFileName != "");
+	require(oaTraces != NULL);
+
+	// Recherche du temps de depart minimum, pour recaler toutes les traces sur une origine commune
+	dMinStartAbsoluteTime = 0;
+	for (nTrace = 0; nTrace < oaTraces->GetSize(); nTrace++)
+	{
+		trace = cast(const TimelineTrace*, oaTraces->GetAt(nTrace));
+		if (nTrace == 0 or trace->GetStartAbsoluteTime() < dMinStartAbsoluteTime)
+			dMinStartAbsoluteTime = trace->GetStartAbsoluteTime();
+	}
+
+	// Creation si necessaire des repertoires intermediaires
+	PLRemoteFileService::MakeDirectories(FileService::GetPathName(sFileName));
+
+	// Preparation de la copie sur HDFS si necessaire
+	bOk = PLRemoteFileService::BuildOutputWorkingFile(sFileName, sLocalFileName);
+
+	// Ouverture du fichier en ecriture
+	if (bOk)
+		bOk = FileService::OpenOutputFile(sLocalFileName, fst);
+	if (bOk)
+	{
+		fst << "{\"traceEvents\":[\n";
+		bFirstEvent = true;
+		for (nTrace = 0; nTrace < oaTraces->GetSize(); nTrace++)
+		{
+			trace = cast(const TimelineTrace*, oaTraces->GetAt(nTrace));
+			lTimeOffset = longint(floor((trace->GetStartAbsoluteTime() - dMinStartAbsoluteTime) * 1000000));
+
+			// Libelle du processus
+			if (not bFirstEvent)
+				fst << ",\n";
+			bFirstEvent = false;
+			fst << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << trace->GetRank()
+			    << ",\"tid\":0,\"args\":{\"name\":";
+			if (trace->GetRank() == 0)
+				WriteJSONString(fst, "Master");
+			else
+				WriteJSONString(fst, sTmp + "Slave " + IntToString(trace->GetRank()));
+			fst << "}}";
+
+			// Ordre d'affichage des processus selon leur rang
+			fst << ",\n{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":" << trace->GetRank()
+			    << ",\"tid\":0,\"args\":{\"sort_index\":" << trace->GetRank() << "}}";
+
+			// Evenements de la trace
+			for (i = 0; i < trace->GetEventNumber(); i++)
+			{
+				fst << ",\n{\"name\":";
+				WriteJSONString(fst, trace->GetEventNameAt(i));
+				fst << ",\"ph\":\"" << trace->GetEventTypeAt(i) << "\",\"ts\":"
+				    << trace->GetEventTimeAt(i) + lTimeOffset << ",\"pid\":" << trace->GetRank()
+				    << ",\"tid\":0";
+				if (trace->GetEventTypeAt(i) == cCounterType)
+					fst << ",\"args\":{\"value\":" << trace->GetEventValueAt(i) << "}";
+				fst << "}";
+			}
+
+			// Signalement des evenements perdus, sous forme d'un evenement instantane en debut de trace
+			if (trace->GetLostEventNumber() > 0)
+			{
+				fst << ",\n{\"name\":\"lost events\",\"ph\":\"i\",\"s\":\"p\",\"ts\":" << lTimeOffset
+				    << ",\"pid\":" << trace->GetRank() << ",\"tid\":0,\"args\":{\"number\":"
+				    << trace->GetLostEventNumber() << "}}";
+			}
+		}
+		fst << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+		// Fermeture du fichier
+		bOk = FileService::CloseOutputFile(sLocalFileName, fst);
+
+		// Copie vers HDFS si necessaire
+		if (bOk)
+			bOk = PLRemoteFileService::CleanOutputWorkingFile(sFileName, sLocalFileName);
+	}
+	return bOk;
+}
+
+void TimelineTracer::Test()
+{
+	TimelineTrace trace;
+	int i;
+	int nEvent;
+
+	// Collecte de quelques evenements
+	Start(8);
+	Begin("Phase");
+	Counter("Counter", 1);
+	Begin("Sub-phase");
+	End("Sub-phase");
+	Counter("Counter", 2);
+	End("Phase");
+	cout << "Collected events: " << GetEventNumber() << endl;
+	cout << "Lost events: " << GetLostEventNumber() << endl;
+
+	// Export et affichage
+	ExportTrace(&trace);
+	cout << "Exported events: " << trace.GetEventNumber() << endl;
+	for (i = 0; i < trace.GetEventNumber(); i++)
+	{
+		cout << "\t" << trace.GetEventTypeAt(i) << "\t" << trace.GetEventNameAt(i) << "\t"
+		     << trace.GetEventValueAt(i);
+		if (i > 0 and trace.GetEventTimeAt(i) < trace.GetEventTimeAt(i - 1))
+			cout << "\tnon monotonic time";
+		cout << endl;
+	}
+	cout << "Remaining events: " << GetEventNumber() << endl;
+
+	// Debordement du buffer circulaire
+	for (nEvent = 0; nEvent < 20; nEvent++)
+		Counter("Overflow", nEvent);
+	cout << "Collected events: " << GetEventNumber() << endl;
+	cout << "Lost events: " << GetLostEventNumber() << endl;
+	ExportTrace(&trace);
+	cout << "Exported events:";
+	for (i = 0; i < trace.GetEventNumber(); i++)
+		cout << " " << trace.GetEventValueAt(i);
+	cout << endl;
+	cout << "Exported lost events: " << trace.GetLostEventNumber() << endl;
+	Stop();
+	cout << "Started: " << BooleanToString(IsStarted()) << endl;
+}
+
+void TimelineTracer::AddEvent(char cType, const char* sName, longint lValue)
+{
+	TimelineEvent* event;
+
+	require(IsStarted());
+	require(sName != NULL);
+
+	// Ajout en fin de buffer s'il reste de la place
+	if (nEventNumber < nEventCapacity)
+	{
+		event = &events[(nFirstEventIndex + nEventNumber) % nEventCapacity];
+		nEventNumber++;
+	}
+	// Sinon, on ecrase l'evenement le plus ancien
+	else
+	{
+		event = &events[nFirstEventIndex];
+		nFirstEventIndex = (nFirstEventIndex + 1) % nEventCapacity;
+		lLostEventNumber++;
+	}
+	event->lTime = longint(timer.GetElapsedTime() * 1000000);
+	event->sName = sName;
+	event->lValue = lValue;
+	event->cType = cType;
+}
+
+void TimelineTracer::WriteJSONString(ostream& ost, const char* sValue)
+{
+	const char* sChar;
+
+	require(sValue != NULL);
+
+	ost << '"';
+	for (sChar = sValue; *sChar != '\0'; sChar++)
+	{
+		if (*sChar == '"' or *sChar == '\\')
+			ost << '\\' << *sChar;
+		else if ((unsigned char)*sChar < ' ')
+			ost << ' ';
+		else
+			ost << *sChar;
+	}
+	ost << '"';
+}
+
+//////////////////////////////////////////////////////////
+// Classe TimelineTrace
+
+TimelineTrace::TimelineTrace()
+{
+	nRank = 0;
+	dStartAbsoluteTime = 0;
+	lLostEventNumber = 0;
+}
+
+TimelineTrace::~TimelineTrace()
+{
+	odNameIndexes.DeleteAll();
+}
+
+void TimelineTrace::SetRank(int nValue)
+{
+	require(nValue >= 0);
+	nRank = nValue;
+}
+
+int TimelineTrace::GetRank() const
+{
+	return nRank;
+}
+
+void TimelineTrace::SetStartAbsoluteTime(double dValue)
+{
+	require(dValue >= 0);
+	dStartAbsoluteTime = dValue;
+}
+
+double TimelineTrace::GetStartAbsoluteTime() const
+{
+	return dStartAbsoluteTime;
+}
+
+void TimelineTrace::SetLostEventNumber(longint lValue)
+{
+	require(lValue >= 0);
+	lLostEventNumber = lValue;
+}
+
+longint TimelineTrace::GetLostEventNumber() const
+{
+	return lLostEventNumber;
+}
+
+void TimelineTrace::AddEvent(char cType, const ALString& sName, longint lTime, longint lValue)
+{
+	cvEventTypes.Add(cType);
+	ivEventNameIndexes.Add(InternName(sName));
+	lvEventTimes.Add(lTime);
+	lvEventValues.Add(lValue);
+}
+
+void TimelineTrace::Clean()
+{
+	nRank = 0;
+	dStartAbsoluteTime = 0;
+	lLostEventNumber = 0;
+	svNames.SetSize(0);
+	odNameIndexes.DeleteAll();
+	cvEventTypes.SetSize(0);
+	ivEventNameIndexes.SetSize(0);
+	lvEventTimes.SetSize(0);
+	lvEventValues.SetSize(0);
+}
+
+longint TimelineTrace::GetUsedMemory() const
+{
+	longint lUsedMemory;
+
+	lUsedMemory = sizeof(TimelineTrace);
+	lUsedMemory += svNames.GetUsedMemory() - sizeof(StringVector);
+	lUsedMemory += odNameIndexes.GetUsedMemory() - sizeof(ObjectDictionary);
+	lUsedMemory += odNameIndexes.GetCount() * sizeof(IntObject);
+	lUsedMemory += cvEventTypes.GetUsedMemory() - sizeof(CharVector);
+	lUsedMemory += ivEventNameIndexes.GetUsedMemory() - sizeof(IntVector);
+	lUsedMemory += lvEventTimes.GetUsedMemory() - sizeof(LongintVector);
+	lUsedMemory += lvEventValues.GetUsedMemory() - sizeof(LongintVector);
+	return lUsedMemory;
+}
+
+const ALString TimelineTrace::GetClassLabel() const
+{
+	return "Timeline trace";
+}
+
+const ALString TimelineTrace::GetObjectLabel() const
+{
+	return IntToString(nRank);
+}
+
+int TimelineTrace::InternName(const ALString& sName)
+{
+	IntObject* ioIndex;
+
+	ioIndex = cast(IntObject*, odNameIndexes.Lookup(sName));
+	if (ioIndex == NULL)
+	{
+		ioIndex = new IntObject;
+		ioIndex->SetInt(svNames.GetSize());
+		odNameIndexes.SetAt(sName, ioIndex);
+		svNames.Add(sName);
+	}
+	return ioIndex->GetInt();
+}
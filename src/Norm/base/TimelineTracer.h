@@ -0,0 +1,222 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#pragma once
+
+#include "Object.h"
+#include "Vector.h"
+#include "CharVector.h"
+#include "Timer.h"
+
+class TimelineTracer;
+class TimelineTrace;
+
+//////////////////////////////////////////////////////////
+// Classe TimelineTracer
+// Collecte a faible cout d'evenements horodates pour construire la ligne de temps d'une execution:
+// debut et fin de phases, et valeurs de compteurs
+// Les evenements sont memorises dans un buffer circulaire de taille fixe, alloue au demarrage de la collecte,
+// sans aucune allocation lors de la collecte. En cas de debordement, les evenements les plus anciens
+// sont ecrases.
+// Les horodatages sont monotones, en micro-secondes depuis le demarrage de la collecte. Le temps absolu
+// de demarrage est memorise pour pouvoir recaler entre elles les traces collectees dans des processus differents.
+//
+// Les traces exportees (une par processus) peuvent etre ecrites au format JSON "Chrome trace-event",
+// exploitable par les outils chrome://tracing ou https://ui.perfetto.dev
+class TimelineTracer : public Object
+{
+public:
+	// Demarrage de la collecte, en precisant le nombre max d'evenements memorises
+	// Les evenements precedents sont perdus
+	static void Start(int nCapacity);
+
+	// Arret de la collecte et liberation du buffer d'evenements
+	// Methode toujours appelable, mais sans effet si la collecte n'est pas demarree
+	static void Stop();
+
+	// Indique si la collecte est en cours
+	static boolean IsStarted();
+
+	// Nombre d'evenements memorises par defaut
+	static const int nDefaultCapacity = 1 << 16;
+
+	// Collecte des debuts et fins de phase, et des valeurs de compteurs
+	// Methodes sans effet si la collecte n'est pas demarree
+	// Les libelles ne sont pas recopies: il doivent etre des chaines constantes (typiquement des litteraux)
+	static void Begin(const char* sName);
+	static void End(const char* sName);
+	static void Counter(const char* sName, longint lValue);
+
+	// Nombre d'evenements actuellement memorises
+	static int GetEventNumber();
+
+	// Nombre d'evenements perdus suite a un debordement du buffer depuis le dernier export
+	static longint GetLostEventNumber();
+
+	// Export des evenements memorises dans une trace, et vidage du buffer
+	// La collecte continue si elle etait en cours
+	// Le rang de la trace est le ProcessId courant
+	static void ExportTrace(TimelineTrace* trace);
+
+	// Ecriture d'un ensemble de traces dans un fichier au format Chrome trace-event JSON
+	// Chaque trace est associee a un processus (pid) de la ligne de temps, d'apres son rang
+	// Les traces sont recalees entre elles selon leur temps absolu de demarrage
+	static boolean WriteChromeTraceFile(const ALString& sFileName, const ObjectArray* oaTraces);
+
+	// Methode de test
+	static void Test();
+
+	///////////////////////////////////////////////////////////
+	///// Implementation
+protected:
+	// Ajout d'un evenement, sans test de collecte en cours
+	static void AddEvent(char cType, const char* sName, longint lValue);
+
+	// Ecriture d'une chaine de caractere JSON, avec ses caracteres speciaux
+	static void WriteJSONString(ostream& ost, const char* sValue);
+
+	// Type d'evenement, selon les conventions du format Chrome trace-event
+	static const char cBeginType = 'B';
+	static const char cEndType = 'E';
+	static const char cCounterType = 'C';
+
+	// Evenement memorise dans le buffer circulaire
+	struct TimelineEvent
+	{
+		longint lTime;
+		const char* sName;
+		longint lValue;
+		char cType;
+	};
+
+	// Buffer circulaire des evenements
+	static TimelineEvent* events;
+	static int nEventCapacity;
+	static int nFirstEventIndex;
+	static int nEventNumber;
+	static longint lLostEventNumber;
+
+	// Temps absolu de demarrage de la collecte, et timer pour les horodatages relatifs
+	static double dStartAbsoluteTime;
+	static Timer timer;
+};
+
+//////////////////////////////////////////////////////////
+// Classe TimelineTrace
+// Evenements collectes par un TimelineTracer dans un processus
+// Contrairement au buffer du tracer, les libelles des evenements sont stockes dans la trace,
+// ce qui permet de la serialiser pour la transmettre a un autre processus
+class TimelineTrace : public Object
+{
+public:
+	// Constructeur
+	TimelineTrace();
+	~TimelineTrace();
+
+	// Rang du processus ayant collecte les evenements
+	void SetRank(int nValue);
+	int GetRank() const;
+
+	// Temps absolu de demarrage de la collecte, en secondes
+	void SetStartAbsoluteTime(double dValue);
+	double GetStartAbsoluteTime() const;
+
+	// Nombre d'evenements perdus lors de la collecte
+	void SetLostEventNumber(longint lValue);
+	longint GetLostEventNumber() const;
+
+	// Ajout d'un evenement
+	void AddEvent(char cType, const ALString& sName, longint lTime, longint lValue);
+
+	// Acces aux evenements
+	int GetEventNumber() const;
+	char GetEventTypeAt(int nIndex) const;
+	const ALString& GetEventNameAt(int nIndex) const;
+	longint GetEventTimeAt(int nIndex) const;
+	longint GetEventValueAt(int nIndex) const;
+
+	// Reinitialisation
+	void Clean();
+
+	// Memoire utilisee
+	longint GetUsedMemory() const override;
+
+	// Libelles utilisateur
+	const ALString GetClassLabel() const override;
+	const ALString GetObjectLabel() const override;
+
+	///////////////////////////////////////////////////////////
+	///// Implementation
+protected:
+	// Recherche de l'index d'un libelle, en l'ajoutant s'il est nouveau
+	int InternName(const ALString& sName);
+
+	// Caracteristiques de la trace
+	int nRank;
+	double dStartAbsoluteTime;
+	longint lLostEventNumber;
+
+	// Libelles distincts des evenements, et dictionnaire d'acces a leur index (de type IntObject)
+	StringVector svNames;
+	ObjectDictionary odNameIndexes;
+
+	// Evenements, stockes par colonne
+	CharVector cvEventTypes;
+	IntVector ivEventNameIndexes;
+	LongintVector lvEventTimes;
+	LongintVector lvEventValues;
+
+	friend class PLShared_TimelineTrace;
+};
+
+//////////////////////////////////////////////////////////
+// Implementations inline
+
+inline boolean TimelineTracer::IsStarted()
+{
+	return events != NULL;
+}
+
+inline void TimelineTracer::Begin(const char* sName)
+{
+	if (events != NULL)
+		AddEvent(cBeginType, sName, 0);
+}
+
+inline void TimelineTracer::End(const char* sName)
+{
+	if (events != NULL)
+		AddEvent(cEndType, sName, 0);
+}
+
+inline void TimelineTracer::Counter(const char* sName, longint lValue)
+{
+	if (events != NULL)
+		AddEvent(cCounterType, sName, lValue);
+}
+
+inline int TimelineTrace::GetEventNumber() const
+{
+	return cvEventTypes.GetSize();
+}
+
+inline char TimelineTrace::GetEventTypeAt(int nIndex) const
+{
+	return cvEventTypes.GetAt(nIndex);
+}
+
+inline const ALString& TimelineTrace::GetEventNameAt(int nIndex) const
+{
+	return svNames.GetAt(ivEventNameIndexes.GetAt(nIndex));
+}
+
+inline longint TimelineTrace::GetEventTimeAt(int nIndex) const
+{
+	return lvEventTimes.GetAt(nIndex);
+}
+
+inline longint TimelineTrace::GetEventValueAt(int nIndex) const
+{
+	return lvEventValues.GetAt(nIndex);
+}
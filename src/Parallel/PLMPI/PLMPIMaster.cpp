@@ -496,7 +496,9 @@ boolean PLMPIMaster::Process()
 	TaskProgression::EndTask();
 
 	// A partir d'ici on est sur que les esclaves n'enverront plus de messages
+	TimelineTracer::Begin("MPI_Barrier");
 	MPI_Barrier(*PLMPITaskDriver::GetTaskComm()); // BARRIER MSG
+	TimelineTracer::End("MPI_Barrier");
 
 	// Il peut rester des messages de type warning
 	while (CheckNewMessage(MPI_ANY_SOURCE, MPI_COMM_WORLD, receivedStatus, MPI_ANY_TAG))
@@ -524,7 +526,9 @@ boolean PLMPIMaster::Process()
 	}
 
 	// Tout les messages on ete traites par les esclaves, on peut continuer
+	TimelineTracer::Begin("MPI_Barrier");
 	MPI_Barrier(*PLMPITaskDriver::GetTaskComm()); // BARRIER MSG 2
+	TimelineTracer::End("MPI_Barrier");
 
 	// Affichage des derniers messages utilisateur
 	messageManager.PrintMessages();
@@ -555,6 +559,9 @@ int PLMPIMaster::ReceiveAndProcessMessage(int nAnyTag, int nAnySource)
 	PLSerializer serializer;
 	PLShared_ObjectArray shared_oa(new PLSharedErrorWithIndex);
 	PLSharedErrorWithIndex shared_error;
+	PLShared_TimelineTrace shared_timelineTrace;
+	TimelineTrace* timelineTrace;
+	longint lSlaveMemory;
 	Error* fataleError;
 	PLMPIMsgContext context;
 	State nProgressionSlaveState;
@@ -788,6 +795,19 @@ int PLMPIMaster::ReceiveAndProcessMessage(int nAnyTag, int nAnySource)
 		// Message de terminaison
 		// envoye par les esclaves apres le SlaveFinalize: TOUT est fini
 		bFinalizeOk = serializer.GetBoolean();
+
+		// Reception de la memoire utilisee par l'esclave, dont on garde le max
+		lSlaveMemory = serializer.GetLongint();
+		if (lSlaveMemory > GetTask()->lMaxSlaveObservedMemory)
+			GetTask()->lMaxSlaveObservedMemory = lSlaveMemory;
+
+		// Reception de la ligne de temps de l'esclave
+		if (GetTask()->shared_bTimeline)
+		{
+			timelineTrace = new TimelineTrace;
+			shared_timelineTrace.DeserializeObject(&serializer, timelineTrace);
+			GetTask()->oaTimelineTraces.Add(timelineTrace);
+		}
 		serializer.Close();
 		if (GetTracerMPI()->GetActiveMode())
 			GetTracerMPI()->AddRecv(context.GetRank(), context.GetTag());
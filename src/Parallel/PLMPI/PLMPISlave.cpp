@@ -19,6 +19,7 @@ PLMPISlave::PLMPISlave(PLParallelTask* t)
 
 	bBoostedMode = false;
 	bIsWorking = false;
+	lTaskStartHeapMemory = 0;
 	color = MPI_UNDEFINED;
 	task = t;
 	assert(task->oaUserMessages == NULL);
@@ -134,10 +135,26 @@ void PLMPISlave::NotifyDone(boolean bOk)
 {
 	PLMPIMsgContext context;
 	PLSerializer serializer;
+	TimelineTrace timelineTrace;
+	PLShared_TimelineTrace shared_timelineTrace;
+	longint lTaskMemory;
 
 	context.Send(MPI_COMM_WORLD, 0, SLAVE_DONE);
 	serializer.OpenForWrite(&context);
 	serializer.PutBoolean(bOk);
+
+	// Envoi de la memoire utilisee pendant la tache (pic de la heap depuis le debut de la tache)
+	lTaskMemory = MemGetHeapPeakMemory() - lTaskStartHeapMemory;
+	if (lTaskMemory < 0)
+		lTaskMemory = 0;
+	serializer.PutLongint(lTaskMemory);
+
+	// Envoi de la ligne de temps collectee pendant la tache
+	if (GetTask()->shared_bTimeline)
+	{
+		TimelineTracer::ExportTrace(&timelineTrace);
+		shared_timelineTrace.SerializeObject(&serializer, &timelineTrace);
+	}
 	serializer.Close();
 	if (GetTracerMPI()->GetActiveMode())
 		GetTracerMPI()->AddSend(0, SLAVE_DONE);
@@ -584,6 +601,10 @@ void PLMPISlave::Run()
 	PLParallelTask::GetDriver()->GetIOReadingStats()->Reset();
 	PLParallelTask::GetDriver()->GetIORemoteReadingStats()->Reset();
 
+	// Debut de la mesure de la memoire utilisee par la tache
+	MemResetHeapPeakMemory();
+	lTaskStartHeapMemory = MemGetHeapMemory();
+
 	// Affectation des droits des shared variables
 	task->SetSharedVariablesRO(&task->oaInputVariables);
 	task->SetSharedVariablesRW(&task->oaSharedParameters);
@@ -604,6 +625,10 @@ void PLMPISlave::Run()
 	// Activation du mode boost
 	bBoostedMode = GetTask()->shared_bBoostedMode;
 
+	// Demarrage de la collecte de la ligne de temps si elle est demandee par le maitre
+	if (GetTask()->shared_bTimeline)
+		TimelineTracer::Start(TimelineTracer::nDefaultCapacity);
+
 	// Mise a jour du nom de l'application
 	task->SetTaskUserLabel(task->shared_sTaskUserLabel.GetValue());
 
@@ -636,6 +661,9 @@ void PLMPISlave::Run()
 		NotifyDone(bFinalizeOk);
 	}
 
+	// Arret de la collecte de la ligne de temps, envoyee au maitre avec la notification de fin de traitement
+	TimelineTracer::Stop();
+
 	// Nettoyage du HugeBuffer pour eviter qu'il soit alloue tout le reste du programe
 	DeleteHugeBuffer();
 
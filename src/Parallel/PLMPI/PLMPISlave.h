@@ -127,6 +127,9 @@ private:
 	// Pas de SystemSleep et pas de Probe
 	boolean bBoostedMode;
 
+	// Taille de la heap au debut de la tache, pour mesurer la memoire utilisee par l'esclave
+	longint lTaskStartHeapMemory;
+
 	// Tableau qui pour chaque type d'erreur, indique aux esclaves qu'il est
 	// inutile d'envoyer de nouveaux messages i.e. quand IsMaxErrorFlowReachedPerGravity == true
 	static IntVector* ivGravityReached;
@@ -281,6 +281,7 @@ longint PLMPISystemFileDriverRemote::Fread(void* ptr, size_t size, size_t count,
 	{
 		// Envoi du nom du fichier, de la position et de la taille du buffer
 		// On envoie egalement la taille du bloc : le buffer resultat n'est pas envoye en entier mais par blocs
+		TimelineTracer::Begin("Remote read");
 		context.Send(MPI_COMM_WORLD, PLMPITaskDriver::GetDriver()->nFileServerRank, FILE_SERVER_FREAD);
 		serializer.OpenForWrite(&context);
 		serializer.PutString(FileService::GetURIFilePathName(file->sFileName));
@@ -313,6 +314,8 @@ longint PLMPISystemFileDriverRemote::Fread(void* ptr, size_t size, size_t count,
 			nSizeToRecv -= nLocalSize;
 		}
 
+		TimelineTracer::End("Remote read");
+
 		// Mise a jour de la position courante
 		file->lPos += lRes;
 	}
@@ -176,8 +176,10 @@ void PLMPITaskDriver::BCastBlock(PLSerializer* serializer, PLMsgContext* context
 	mpiContext = cast(PLMPIMsgContext*, context);
 	require(mpiContext->GetCommunicator() != MPI_COMM_NULL);
 	require(mpiContext->nMsgType == MSGTYPE::BCAST);
+	TimelineTracer::Begin("MPI_Bcast");
 	MPI_Bcast(serializer->InternalGetMonoBlockBuffer(), serializer->InternalGetBlockSize(), MPI_CHAR, 0,
 		  mpiContext->GetCommunicator());
+	TimelineTracer::End("MPI_Bcast");
 }
 
 PLTaskDriver* PLMPITaskDriver::Clone() const
@@ -214,11 +214,13 @@ inline void PLMPITaskDriver::RecvBlock(PLSerializer* serializer, PLMsgContext* c
 	if (mpiContext->nMsgType != MSGTYPE::BCAST)
 	{
 		tRecv.Start();
+		TimelineTracer::Begin("MPI_Recv");
 		// on n'utilise pas MPI_Probe pour avoir la taille d'abord car ca ralenti et on a ABORT pour le
 		// MPI_Rsend qui est en face En outre ca ne sert a rien car on connait la taille max qui est celle d'un
 		// bloc
 		MPI_Recv(serializer->InternalGetMonoBlockBuffer(), serializer->InternalGetBlockSize(), MPI_CHAR,
 			 mpiContext->GetRank(), mpiContext->GetTag(), mpiContext->GetCommunicator(), &status);
+		TimelineTracer::End("MPI_Recv");
 		tRecv.Stop();
 
 		// Mise a jour du rang et du tag en cas de reception avce ANY_RANK ou ANY_TAG
@@ -13,6 +13,7 @@ PLFileConcatenater::PLFileConcatenater()
 	cSep = '\t';
 	bDisplayProgression = false;
 	bVerbose = false;
+	bInputBlockCompression = false;
 }
 
 PLFileConcatenater::~PLFileConcatenater() {}
@@ -84,6 +85,16 @@ boolean PLFileConcatenater::GetVerbose() const
 	return bVerbose;
 }
 
+void PLFileConcatenater::SetInputBlockCompression(boolean bValue)
+{
+	bInputBlockCompression = bValue;
+}
+
+boolean PLFileConcatenater::GetInputBlockCompression() const
+{
+	return bInputBlockCompression;
+}
+
 const ALString PLFileConcatenater::GetClassLabel() const
 {
 	return "file concatenater";
@@ -145,6 +156,7 @@ boolean PLFileConcatenater::Concatenate(const StringVector* svChunkURIs, const O
 	int nInputPreferredSize;
 	int nOutputPreferredSize;
 	longint lRemainingMemory;
+	boolean bLocalConcatenation;
 
 	require(sOutputFileName != "");
 	require(svChunkURIs != NULL);
@@ -153,6 +165,8 @@ boolean PLFileConcatenater::Concatenate(const StringVector* svChunkURIs, const O
 
 	fileHandle = NULL;
 	bOk = true;
+	// La copie directe n'est pas possible si les chunks sont a decompresser
+	bLocalConcatenation = not bInputBlockCompression and IsLocalConcatenation(svChunkURIs);
 	dTaskPercent = dProgressionEnd - dProgressionBegin;
 	nChunkIndex = 0;
 
@@ -221,73 +235,87 @@ boolean PLFileConcatenater::Concatenate(const StringVector* svChunkURIs, const O
 			outputBuffer.WriteEOL();
 		}
 
-		// TODO reserver la taille du fichier de sortie (moins ce qui est deja ecrit pdans le header)
-		// Parcours de tous les chunks
-		for (nChunkIndex = 0; nChunkIndex < svChunkURIs->GetSize(); nChunkIndex++)
+		// Copie directe des chunks si tous les fichiers sont locaux
+		if (bLocalConcatenation)
 		{
-			sChunkURI = svChunkURIs->GetAt(nChunkIndex);
-
-			// Interruption ?
-			if (not bOk or TaskProgression::IsInterruptionRequested())
-				break;
+			bOk = outputBuffer.Close();
+			if (bOk)
+				bOk = ConcatenateLocalChunks(svChunkURIs, errorSender, bRemoveChunks, nChunkIndex);
+		}
 
-			// Concatenation d'un nouveau chunk
-			if (PLRemoteFileService::FileExists(sChunkURI))
+		// Parcours de tous les chunks sinon
+		else
+		{
+			for (nChunkIndex = 0; nChunkIndex < svChunkURIs->GetSize(); nChunkIndex++)
 			{
-				inputFile.SetFileName(sChunkURI);
+				sChunkURI = svChunkURIs->GetAt(nChunkIndex);
 
-				// Ouverture du chunk en lecture (en ignorant la gestion des BOM, car on a des fichiers
-				// internes)
-				inputFile.SetUTF8BomManagement(false);
-				bOk = inputFile.Open();
-				if (bOk)
-				{
-					inputFile.SetBufferSize((int)min(lInputBufferSize, inputFile.GetFileSize()));
+				// Interruption ?
+				if (not bOk or TaskProgression::IsInterruptionRequested())
+					break;
 
-					// Lecture du chunk par blocs et ecriture dans le fichier de sortie
-					lPosition = 0;
-					while (lPosition < inputFile.GetFileSize())
+				// Concatenation d'un nouveau chunk
+				if (PLRemoteFileService::FileExists(sChunkURI))
+				{
+					inputFile.SetFileName(sChunkURI);
+
+					// Ouverture du chunk en lecture (en ignorant la gestion des BOM, car on a des
+					// fichiers internes)
+					inputFile.SetUTF8BomManagement(false);
+					inputFile.SetBlockCompression(bInputBlockCompression);
+					bOk = inputFile.Open();
+					if (bOk)
 					{
-						// Lecture efficace d'un buffer
-						bOk = inputFile.FillBytes(lPosition);
-						if (bOk)
-							outputBuffer.WriteSubPart(inputFile.GetCache(),
-										  inputFile.GetBufferStartInCache(),
-										  inputFile.GetCurrentBufferSize());
-						else
-							break;
-						lPosition += inputFile.GetCurrentBufferSize();
+						inputFile.SetBufferSize(
+						    (int)min(lInputBufferSize, inputFile.GetFileSize()));
+
+						// Lecture du chunk par blocs et ecriture dans le fichier de sortie
+						lPosition = 0;
+						while (lPosition < inputFile.GetFileSize())
+						{
+							// Lecture efficace d'un buffer
+							bOk = inputFile.FillBytes(lPosition);
+							if (bOk)
+								outputBuffer.WriteSubPart(
+								    inputFile.GetCache(),
+								    inputFile.GetBufferStartInCache(),
+								    inputFile.GetCurrentBufferSize());
+							else
+								break;
+							lPosition += inputFile.GetCurrentBufferSize();
+						}
+
+						// Fermeture du chunk
+						bOk = inputFile.Close() and bOk;
+
+						// Suppression du chunk
+						if (bRemoveChunks)
+							PLRemoteFileService::RemoveFile(sChunkURI);
+
+						// Affichage de la progression en prenant en compte la progression
+						// intiale dProgressionLevel et la portion de progression represente
+						// par la concatenation dTaskPercent
+						if (bDisplayProgression)
+							TaskProgression::DisplayProgression((int)ceil(
+							    100 * (dProgressionBegin + dTaskPercent * (nChunkIndex + 1) /
+											   svChunkURIs->GetSize())));
 					}
-
-					// Fermeture du chunk
-					bOk = inputFile.Close() and bOk;
-
-					// Suppression du chunk
-					if (bRemoveChunks)
-						PLRemoteFileService::RemoveFile(sChunkURI);
-
-					// Affichage de la progression en prenant en compte la progression intiale
-					// dProgressionLevel et la portion de progression represente par la
-					// concatenation dTaskPercent
-					if (bDisplayProgression)
-						TaskProgression::DisplayProgression((int)ceil(
-						    100 * (dProgressionBegin +
-							   dTaskPercent * (nChunkIndex + 1) / svChunkURIs->GetSize())));
 				}
-			}
-			else
-			{
-				if (errorSender != NULL)
-					errorSender->AddError("Missing chunk file : " + sChunkURI);
-				bOk = false;
-				break;
+				else
+				{
+					if (errorSender != NULL)
+						errorSender->AddError("Missing chunk file : " + sChunkURI);
+					bOk = false;
+					break;
+				}
 			}
 		}
 		if (bDisplayProgression)
 			TaskProgression::DisplayProgression((int)(100 * dProgressionEnd));
 
 		// Fermeture du fichier de sortie
-		bOk = outputBuffer.Close() and bOk;
+		if (outputBuffer.IsOpened())
+			bOk = outputBuffer.Close() and bOk;
 	}
 
 	// Nettoyage du resultat si echec ou interruption
@@ -329,3 +357,90 @@ boolean PLFileConcatenater::Concatenate(const StringVector* svChunkURIs, const O
 
 	return bOk;
 }
+
+boolean PLFileConcatenater::ConcatenateLocalChunks(const StringVector* svChunkURIs, const Object* errorSender,
+						  boolean bRemoveChunks, int& nChunkIndex) const
+{
+	boolean bOk;
+	FILE* fOutputFile;
+	ALString sChunkURI;
+	ALString sChunkFileName;
+	longint lTotalChunkSize;
+	double dTaskPercent;
+
+	require(svChunkURIs != NULL);
+	require(IsLocalConcatenation(svChunkURIs));
+
+	dTaskPercent = dProgressionEnd - dProgressionBegin;
+	nChunkIndex = 0;
+
+	// Ouverture du fichier resultat en ajout
+	bOk = FileService::OpenOutputBinaryFileForAppend(sOutputFileName, fOutputFile);
+	if (bOk)
+	{
+		// Reservation de la taille totale des chunks existants, pour limiter la fragmentation
+		lTotalChunkSize = 0;
+		for (nChunkIndex = 0; nChunkIndex < svChunkURIs->GetSize(); nChunkIndex++)
+			lTotalChunkSize +=
+			    FileService::GetFileSize(FileService::GetURIFilePathName(svChunkURIs->GetAt(nChunkIndex)));
+		nChunkIndex = 0;
+		bOk = FileService::ReserveExtraSize(fOutputFile, lTotalChunkSize);
+
+		// Parcours de tous les chunks
+		for (nChunkIndex = 0; nChunkIndex < svChunkURIs->GetSize(); nChunkIndex++)
+		{
+			sChunkURI = svChunkURIs->GetAt(nChunkIndex);
+			sChunkFileName = FileService::GetURIFilePathName(sChunkURI);
+
+			// Interruption ?
+			if (not bOk or TaskProgression::IsInterruptionRequested())
+				break;
+
+			// Concatenation d'un nouveau chunk
+			if (FileService::FileExists(sChunkFileName))
+			{
+				bOk = FileService::AppendBinaryFileContent(sOutputFileName, fOutputFile, sChunkFileName);
+
+				// Suppression du chunk
+				if (bRemoveChunks)
+					FileService::RemoveFile(sChunkFileName);
+
+				// Affichage de la progression
+				if (bDisplayProgression)
+					TaskProgression::DisplayProgression((int)ceil(
+					    100 * (dProgressionBegin +
+						   dTaskPercent * (nChunkIndex + 1) / svChunkURIs->GetSize())));
+			}
+			else
+			{
+				if (errorSender != NULL)
+					errorSender->AddError("Missing chunk file : " + sChunkURI);
+				bOk = false;
+				break;
+			}
+		}
+
+		// Fermeture du fichier resultat
+		bOk = FileService::CloseOutputBinaryFile(sOutputFileName, fOutputFile) and bOk;
+	}
+
+	return bOk;
+}
+
+boolean PLFileConcatenater::IsLocalConcatenation(const StringVector* svChunkURIs) const
+{
+	boolean bIsLocal;
+	int i;
+
+	require(svChunkURIs != NULL);
+
+	// Le fichier resultat doit etre un fichier standard et les chunks des fichiers de la machine courante
+	bIsLocal = FileService::GetURIScheme(sOutputFileName) == "";
+	for (i = 0; i < svChunkURIs->GetSize(); i++)
+	{
+		if (not bIsLocal)
+			break;
+		bIsLocal = FileService::IsLocalURI(svChunkURIs->GetAt(i));
+	}
+	return bIsLocal;
+}
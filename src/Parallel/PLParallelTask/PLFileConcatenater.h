@@ -66,12 +66,27 @@ public:
 	void SetVerbose(boolean bVerbose);
 	boolean GetVerbose() const;
 
+	// Decompression des chunks, ecrits en mode compression par blocs (cf. BufferedFile::SetBlockCompression)
+	// Le fichier resultat n'est pas compresse (par defaut: false)
+	void SetInputBlockCompression(boolean bValue);
+	boolean GetInputBlockCompression() const;
+
 	const ALString GetClassLabel() const override;
 
 	////////////////////////////////////////////////////////
 	//// Implementation
 
 protected:
+	// Concatenation des chunks en fin du fichier resultat, deja cree avec son entete, dans le cas
+	// ou tous les fichiers sont locaux: la copie se fait alors directement de fichier a fichier
+	// (cf. FileService::AppendBinaryFileContent), sans relecture par des buffers du processus
+	// En sortie, nChunkIndex contient l'index du premier chunk non traite
+	boolean ConcatenateLocalChunks(const StringVector* svChunkURIs, const Object* errorSender,
+				       boolean bRemoveChunks, int& nChunkIndex) const;
+
+	// Test si la concatenation peut se faire par copie directe entre fichiers locaux
+	boolean IsLocalConcatenation(const StringVector* svChunkURIs) const;
+
 	ALString sOutputFileName;
 	StringVector svHeaderLine;
 	char cSep;
@@ -79,4 +94,5 @@ protected:
 	double dProgressionEnd;
 	boolean bDisplayProgression;
 	boolean bVerbose;
+	boolean bInputBlockCompression;
 };
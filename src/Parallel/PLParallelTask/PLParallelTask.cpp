@@ -8,6 +8,7 @@ PLTaskDriver* PLParallelTask::currentDriver = &PLTaskDriver::driver;
 boolean PLParallelTask::bIsRunning = false;
 ObjectDictionary* PLParallelTask::odTasks = NULL;
 ALString PLParallelTask::sParallelLogFileName = "";
+ALString PLParallelTask::sTimelineFileName = "";
 boolean PLParallelTask::bParallelSimulated = false;
 int PLParallelTask::nSimulatedSlaveNumber = 8;
 PLParallelTask::Method PLParallelTask::method = Method::NONE;
@@ -54,6 +55,10 @@ PLParallelTask::PLParallelTask()
 	bSlaveInitializeErrorsOnce = true;
 	bSlaveFinalizeErrorsOnce = true;
 	bSlaveAtRestWithoutProcessing = false;
+	bTimelineStartedByTask = false;
+	lEstimatedSlaveMemory = 0;
+	lEstimatedGlobalSlaveMemory = 0;
+	lMaxSlaveObservedMemory = 0;
 
 	// Declaration des variables partagees qui contiennent les constantes systeme
 	DeclareSharedParameter(&input_bVerbose);
@@ -69,6 +74,7 @@ PLParallelTask::PLParallelTask()
 	DeclareSharedParameter(&shared_tracerMPI);
 	DeclareSharedParameter(&shared_tracerPerformance);
 	DeclareSharedParameter(&shared_tracerProtocol);
+	DeclareSharedParameter(&shared_bTimeline);
 	DeclareTaskInput(&input_bSilentMode);
 	DeclareTaskInput(&input_nTaskProcessedNumber);
 	DeclareTaskOutput(&output_statsIOReadDuration);
@@ -82,6 +88,7 @@ PLParallelTask::PLParallelTask()
 	shared_nMaxLineLength = InputBufferedFile::GetMaxLineLength();
 	shared_lMaxHeapSize = MemGetMaxHeapSize();
 	shared_bBoostedMode = false;
+	shared_bTimeline = false;
 
 	PLParallelTask::GetDriver()->GetIOReadingStats()->Reset();
 	PLParallelTask::GetDriver()->GetIORemoteReadingStats()->Reset();
@@ -90,6 +97,7 @@ PLParallelTask::PLParallelTask()
 PLParallelTask::~PLParallelTask()
 {
 	delete requirements;
+	oaTimelineTraces.DeleteAll();
 }
 
 void PLParallelTask::SetDriver(PLTaskDriver* driverValue)
@@ -313,6 +321,16 @@ const ALString& PLParallelTask::GetParallelLogFileName()
 	return sParallelLogFileName;
 }
 
+void PLParallelTask::SetTimelineFileName(const ALString& sValue)
+{
+	sTimelineFileName = sValue;
+}
+
+const ALString& PLParallelTask::GetTimelineFileName()
+{
+	return sTimelineFileName;
+}
+
 ALString PLParallelTask::MethodToString(Method nMethod)
 {
 	ALString sMethod;
@@ -495,6 +513,25 @@ boolean PLParallelTask::Run()
 		{
 			require(GetResourceRequirements()->Check());
 
+			// Memorisation des estimations memoire avant calibration
+			lEstimatedSlaveMemory = GetResourceRequirements()->GetSlaveRequirement()->GetMemory()->GetMin() +
+						GetResourceRequirements()->GetSharedRequirement()->GetMemory()->GetMin();
+			lEstimatedGlobalSlaveMemory =
+			    GetResourceRequirements()->GetGlobalSlaveRequirement()->GetMemory()->GetMin();
+			lMaxSlaveObservedMemory = 0;
+
+			// Calibration de l'exigence memoire des esclaves selon les executions precedentes
+			if (RMTaskMemoryCalibration::IsActive() and
+			    RMTaskMemoryCalibration::CalibrateRequirement(GetTaskSignature(), GetResourceRequirements()))
+			{
+				if (PLParallelTask::GetVerbose())
+					AddMessage(sTmp + "calibrated requirement for slave memory: " +
+						   LongintToHumanReadableString(GetResourceRequirements()
+										    ->GetSlaveRequirement()
+										    ->GetMemory()
+										    ->GetMin()));
+			}
+
 			bIsRunning = false;
 			RMParallelResourceDriver::grantedResources = new RMTaskResourceGrant;
 
@@ -603,6 +640,16 @@ boolean PLParallelTask::Run()
 		shared_tracerMPI.SetTracer(GetDriver()->GetTracerMPI()->Clone());
 		shared_tracerProtocol.SetTracer(GetDriver()->GetTracerProtocol()->Clone());
 		shared_tracerPerformance.SetTracer(GetDriver()->GetTracerPerformance()->Clone());
+
+		// Ligne de temps : demarrage de la collecte si necessaire, l'activation etant transmise aux esclaves
+		oaTimelineTraces.DeleteAll();
+		bTimelineStartedByTask = false;
+		shared_bTimeline = not GetTimelineFileName().IsEmpty();
+		if (shared_bTimeline and not TimelineTracer::IsStarted())
+		{
+			TimelineTracer::Start(TimelineTracer::nDefaultCapacity);
+			bTimelineStartedByTask = true;
+		}
 	}
 
 	// interdiction d'acces aux output et input variables
@@ -738,6 +785,13 @@ boolean PLParallelTask::Run()
 			// Creation et lancement du maitre
 			bOk = RunAsMaster();
 			tJob.Stop();
+
+			// Memorisation de la memoire utilisee par les esclaves pour la calibration
+			if (bOk and RMTaskMemoryCalibration::IsActive() and lMaxSlaveObservedMemory > 0)
+				RMTaskMemoryCalibration::RecordObservedMemory(
+				    GetTaskSignature(),
+				    lEstimatedSlaveMemory + lEstimatedGlobalSlaveMemory / max(1, nWorkingProcessNumber),
+				    lMaxSlaveObservedMemory);
 			if (GetDriver()->GetTracerPerformance()->GetActiveMode())
 				GetDriver()->GetTracerPerformance()->AddTrace(
 				    sTmp + "<< processing time in seconds [" + sPerformanceTaskName + "," +
@@ -780,6 +834,10 @@ boolean PLParallelTask::Run()
 			GetDriver()->GetTracerPerformance()->Clean();
 		}
 
+		// Ecriture de la ligne de temps
+		if (runningMode != SLAVE and shared_bTimeline)
+			WriteTimeline();
+
 		// Remise des variables dans l'etat initial
 		SetSharedVariablesRW(&oaSharedParameters);
 		SetSharedVariablesRW(&oaInputVariables);
@@ -810,6 +868,13 @@ boolean PLParallelTask::Run()
 	delete requirements;
 	requirements = new RMTaskResourceRequirement;
 
+	// Arret de la collecte de la ligne de temps si elle a ete demarree pour la tache
+	if (bTimelineStartedByTask)
+	{
+		TimelineTracer::Stop();
+		bTimelineStartedByTask = false;
+	}
+
 	// Recopie des informations necessaies entre les 2 drivers
 	oldDriver->GetTracerMPI()->CopyFrom(currentDriver->GetTracerMPI());
 	oldDriver->GetTracerPerformance()->CopyFrom(currentDriver->GetTracerPerformance());
@@ -1525,6 +1590,29 @@ ALString PLParallelTask::GetCurrentTaskName()
 	return sCurrentTaskName;
 }
 
+void PLParallelTask::WriteTimeline()
+{
+	TimelineTrace* masterTrace;
+	ALString sFileName;
+
+	require(not GetTimelineFileName().IsEmpty());
+	require(TimelineTracer::IsStarted());
+
+	// Ajout de la trace du maitre en tete des traces collectees aupres des esclaves
+	masterTrace = new TimelineTrace;
+	TimelineTracer::ExportTrace(masterTrace);
+	oaTimelineTraces.InsertAt(0, masterTrace);
+
+	// Ecriture dans un fichier propre a la tache
+	sFileName = FileService::BuildFilePathName(
+	    FileService::GetPathName(GetTimelineFileName()),
+	    FileService::BuildFileName(FileService::GetFilePrefix(GetTimelineFileName()) + "_" + sPerformanceTaskName,
+				       FileService::GetFileSuffix(GetTimelineFileName())));
+	if (not TimelineTracer::WriteChromeTraceFile(sFileName, &oaTimelineTraces))
+		AddWarning("Unable to write timeline file " + sFileName);
+	oaTimelineTraces.DeleteAll();
+}
+
 boolean PLParallelTask::CallSlaveInitialize()
 {
 	boolean bOk;
@@ -1566,7 +1654,9 @@ boolean PLParallelTask::CallSlaveInitialize()
 	}
 
 	// Lancement de la methode applicative
+	TimelineTracer::Begin("SlaveInitialize");
 	bOk = SlaveInitialize();
+	TimelineTracer::End("SlaveInitialize");
 
 	// On renvoie false systematiquement si il y a interruption utilisateur
 	bOk = bOk and not TaskProgression::IsInterruptionRequested();
@@ -1651,7 +1741,9 @@ boolean PLParallelTask::CallSlaveProcess()
 		}
 	}
 
+	TimelineTracer::Begin("SlaveProcess");
 	bOk = SlaveProcess();
+	TimelineTracer::End("SlaveProcess");
 
 	// On renvoie false systematiquement si il y a interruption utilisateur
 	bOk = bOk and not TaskProgression::IsInterruptionRequested();
@@ -1722,7 +1814,9 @@ boolean PLParallelTask::CallSlaveFinalize(boolean bProcessOk)
 	TaskProgression::BeginTask();
 	TaskProgression::DisplayMainLabel(GetTaskLabel());
 	TaskProgression::DisplayLabel(PROGRESSION_MSG_SLAVE_FINALIZE);
+	TimelineTracer::Begin("SlaveFinalize");
 	bOk = SlaveFinalize(bProcessOk);
+	TimelineTracer::End("SlaveFinalize");
 
 	// On renvoie false systematiquement si il y a interruption utilisateur
 	bOk = bOk and not TaskProgression::IsInterruptionRequested();
@@ -1796,7 +1890,9 @@ boolean PLParallelTask::CallMasterInitialize()
 	}
 
 	// Appel de la methode utilisateur
+	TimelineTracer::Begin("MasterInitialize");
 	bOk = MasterInitialize();
+	TimelineTracer::End("MasterInitialize");
 
 	// On renvoie false systematiquement si il y a interruption utilisateur
 	bOk = bOk and not TaskProgression::IsInterruptionRequested();
@@ -1857,7 +1953,9 @@ boolean PLParallelTask::CallMasterFinalize(boolean bProcessOk)
 	if (MemoryStatsManager::IsOpened())
 		MemoryStatsManager::AddLog("Task " + GetTaskName() + " .MasterFinalize Begin");
 	SetSharedVariablesRW(&oaSharedParameters);
+	TimelineTracer::Begin("MasterFinalize");
 	bOk = MasterFinalize(bProcessOk);
+	TimelineTracer::End("MasterFinalize");
 
 	// On renvoie false systematiquement si il y a interruption utilisateur
 	bOk = bOk and not TaskProgression::IsInterruptionRequested();
@@ -1934,7 +2032,9 @@ boolean PLParallelTask::CallMasterAggregate()
 	if (MemoryStatsManager::IsOpened())
 		MemoryStatsManager::AddLog("Task " + GetTaskName() + " .MasterAggregateResults " +
 					   IntToString(GetTaskIndex()) + " Begin");
+	TimelineTracer::Begin("MasterAggregateResults");
 	bOk = MasterAggregateResults();
+	TimelineTracer::End("MasterAggregateResults");
 
 	// On renvoie false systematiquement si il y a interruption utilisateur
 	bOk = bOk and not TaskProgression::IsInterruptionRequested();
@@ -2023,7 +2123,9 @@ boolean PLParallelTask::CallMasterPrepareTaskInput(double& dTaskPercent, boolean
 							   IntToString(GetTaskIndex()));
 	MemoryStatsManager::AddLog("Task " + GetTaskName() + " .MasterPrepareTaskInput " + IntToString(GetTaskIndex()) +
 				   " Begin");
+	TimelineTracer::Begin("MasterPrepareTaskInput");
 	bOk = MasterPrepareTaskInput(dTaskPercent, bIsTaskFinished);
+	TimelineTracer::End("MasterPrepareTaskInput");
 
 	// On renvoie false systematiquement si il y a interruption utilisateur
 	bOk = bOk and not TaskProgression::IsInterruptionRequested();
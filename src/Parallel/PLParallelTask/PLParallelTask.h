@@ -15,6 +15,7 @@
 #include "PLSlaveState.h"
 #include "PLTaskDriver.h"
 #include "PLTracer.h"
+#include "PLShared_TimelineTrace.h"
 #include "RMParallelResourceManager.h"
 #include "RMParallelResourceDriver.h"
 #include "RMTaskResourceGrant.h"
@@ -22,6 +23,7 @@
 #include "PLRemoteFileService.h"
 #include "PLErrorWithIndex.h"
 #include "MemoryStatsManager.h"
+#include "RMTaskMemoryCalibration.h"
 
 class PLTaskDriver;
 class PLMaster;
@@ -164,6 +166,14 @@ public:
 	static void SetVerbose(int bVerbose);
 	static boolean GetVerbose();
 
+	// Fichier de ligne de temps des taches, au format Chrome trace-event JSON (par defaut: vide, pas de collecte)
+	// Si le nom est specifie, les debuts et fins des methodes du maitre et des esclaves, ainsi que les acces
+	// disques et les attentes MPI, sont collectes par chaque processus pendant la tache (cf. TimelineTracer)
+	// Les traces des esclaves sont envoyees au maitre en fin de tache, qui ecrit un fichier par tache, suffixe
+	// par le numero de run et le nom de la tache
+	static void SetTimelineFileName(const ALString& sValue);
+	static const ALString& GetTimelineFileName();
+
 	// Activation des traces
 	static void SetTracerMPIActive(boolean bTracerON);
 	static boolean GetTracerMPIActive();
@@ -605,6 +615,10 @@ private:
 	// et creation du repertoire applicatif
 	void InitializeParametersFromSharedVariables();
 
+	// Ecriture de la ligne de temps de la tache, a partir de la trace du maitre et des traces collectees
+	// aupres des esclaves
+	void WriteTimeline();
+
 	// Erreur indexee  generique
 	void AddLocalGenericError(int nGravity, const ALString& sLabel, longint lLineNumber);
 
@@ -656,6 +670,20 @@ private:
 	// standard)
 	static ALString sParallelLogFileName;
 
+	// Ligne de temps
+	// La collecte est demarree par le maitre et son activation est transmise aux esclaves
+	// Le maitre memorise les traces envoyees par les esclaves en fin de tache (tableau de TimelineTrace)
+	static ALString sTimelineFileName;
+	PLShared_Boolean shared_bTimeline;
+	boolean bTimelineStartedByTask;
+	ObjectArray oaTimelineTraces;
+
+	// Calibration des exigences memoire (cf. RMTaskMemoryCalibration)
+	// Le maitre memorise les estimations avant calibration et le max de la memoire utilisee par les esclaves
+	longint lEstimatedSlaveMemory;
+	longint lEstimatedGlobalSlaveMemory;
+	longint lMaxSlaveObservedMemory;
+
 	// Mode simule uniquement : position de l'esclave acteuellement en traitement
 	int nCurrentSlavePosition;
 
@@ -134,6 +134,25 @@ boolean PLSerializer::IsOpenForWrite() const
 	return bIsOpenForWrite;
 }
 
+void PLSerializer::ExportBuffer(CharVector* cvTarget) const
+{
+	require(cvTarget != NULL);
+	require(not bIsOpenForRead and not bIsOpenForWrite);
+	require(IsStdMode());
+
+	cvTarget->CopyFrom(&cvBuffer);
+}
+
+void PLSerializer::ImportBuffer(const CharVector* cvSource)
+{
+	require(cvSource != NULL);
+	require(not bIsOpenForRead and not bIsOpenForWrite);
+	require(nBufferPosition == 0);
+
+	context = NULL;
+	cvBuffer.CopyFrom(cvSource);
+}
+
 void PLSerializer::Initialize()
 {
 	// L'utilisation de cette methode n'est pas documentee, est-elle vraiment necessaire ? a tester
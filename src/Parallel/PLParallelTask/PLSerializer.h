@@ -89,6 +89,12 @@ public:
 	void PutNullToken(boolean bIsNull);
 	boolean GetNullToken();
 
+	// Acces au contenu serialise en mode standard (sans contexte), serializer ferme
+	// Permet de stocker le resultat d'une serialisation, par exemple dans un fichier,
+	// et de le recharger ulterieurement pour une deserialisation
+	void ExportBuffer(CharVector* cvTarget) const;
+	void ImportBuffer(const CharVector* cvSource);
+
 	// Methode de test
 	static void Test();
 
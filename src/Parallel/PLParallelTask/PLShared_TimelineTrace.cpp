@@ -0,0 +1,65 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#include "PLShared_TimelineTrace.h"
+
+///////////////////////////////////////////////////////////////////////
+// Implementation de PLShared_TimelineTrace
+
+PLShared_TimelineTrace::PLShared_TimelineTrace()
+{
+	// On force bIsDeclared a true car cette classe a pour vocation a etre envoyee en dehors du schema maitre
+	// esclave classique
+	bIsDeclared = true;
+}
+
+PLShared_TimelineTrace::~PLShared_TimelineTrace() {}
+
+void PLShared_TimelineTrace::SerializeObject(PLSerializer* serializer, const Object* o) const
+{
+	const TimelineTrace* trace;
+
+	require(serializer->IsOpenForWrite());
+	require(o != NULL);
+
+	trace = cast(TimelineTrace*, o);
+	serializer->PutInt(trace->nRank);
+	serializer->PutDouble(trace->dStartAbsoluteTime);
+	serializer->PutLongint(trace->lLostEventNumber);
+	serializer->PutStringVector(&trace->svNames);
+	serializer->PutCharVector(&trace->cvEventTypes);
+	serializer->PutIntVector(&trace->ivEventNameIndexes);
+	serializer->PutLongintVector(&trace->lvEventTimes);
+	serializer->PutLongintVector(&trace->lvEventValues);
+}
+
+void PLShared_TimelineTrace::DeserializeObject(PLSerializer* serializer, Object* o) const
+{
+	TimelineTrace* trace;
+	StringVector svNames;
+	CharVector cvEventTypes;
+	IntVector ivEventNameIndexes;
+	LongintVector lvEventTimes;
+	LongintVector lvEventValues;
+	int i;
+
+	require(serializer->IsOpenForRead());
+	require(o != NULL);
+
+	trace = cast(TimelineTrace*, o);
+	trace->Clean();
+	trace->SetRank(serializer->GetInt());
+	trace->SetStartAbsoluteTime(serializer->GetDouble());
+	trace->SetLostEventNumber(serializer->GetLongint());
+	serializer->GetStringVector(&svNames);
+	serializer->GetCharVector(&cvEventTypes);
+	serializer->GetIntVector(&ivEventNameIndexes);
+	serializer->GetLongintVector(&lvEventTimes);
+	serializer->GetLongintVector(&lvEventValues);
+
+	// Reconstruction des evenements, ce qui reconstruit egalement le dictionnaire des libelles
+	for (i = 0; i < cvEventTypes.GetSize(); i++)
+		trace->AddEvent(cvEventTypes.GetAt(i), svNames.GetAt(ivEventNameIndexes.GetAt(i)),
+				lvEventTimes.GetAt(i), lvEventValues.GetAt(i));
+}
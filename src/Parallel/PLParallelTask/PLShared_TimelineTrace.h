@@ -0,0 +1,47 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#pragma once
+#include "PLSharedObject.h"
+#include "TimelineTracer.h"
+
+/////////////////////////////////////////////////////////////////////////////
+// Classe PLShared_TimelineTrace
+// Serialisation de TimelineTrace
+//
+class PLShared_TimelineTrace : public PLSharedObject
+{
+public:
+	// Constructeur
+	PLShared_TimelineTrace();
+	~PLShared_TimelineTrace();
+
+	// Acces au TimelineTrace
+	void SetTimelineTrace(TimelineTrace* trace);
+	TimelineTrace* GetTimelineTrace();
+
+	// Reimplementation des methodes virtuelles
+	void SerializeObject(PLSerializer* serializer, const Object* o) const override;
+	void DeserializeObject(PLSerializer* serializer, Object* o) const override;
+
+	//////////////////////////////////////////////////////////////////
+	///// Implementation
+protected:
+	Object* Create() const override;
+};
+
+inline void PLShared_TimelineTrace::SetTimelineTrace(TimelineTrace* trace)
+{
+	SetObject(trace);
+}
+
+inline TimelineTrace* PLShared_TimelineTrace::GetTimelineTrace()
+{
+	return cast(TimelineTrace*, GetObject());
+}
+
+inline Object* PLShared_TimelineTrace::Create() const
+{
+	return new TimelineTrace;
+}
@@ -0,0 +1,270 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#include "RMTaskMemoryCalibration.h"
+
+ObjectDictionary RMTaskMemoryCalibration::odObservedRatios;
+boolean RMTaskMemoryCalibration::bIsProfileLoaded = false;
+ALString RMTaskMemoryCalibration::sProfileFileName;
+double RMTaskMemoryCalibration::dSafetyMargin = 0.5;
+double RMTaskMemoryCalibration::dMinReductionFactor = 0.25;
+
+void RMTaskMemoryCalibration::SetProfileFileName(const ALString& sValue)
+{
+	// Les calibrations chargees sont a relire si le fichier change
+	if (sValue != sProfileFileName)
+		Reset();
+	sProfileFileName = sValue;
+}
+
+const ALString& RMTaskMemoryCalibration::GetProfileFileName()
+{
+	return sProfileFileName;
+}
+
+boolean RMTaskMemoryCalibration::IsActive()
+{
+	return not sProfileFileName.IsEmpty();
+}
+
+void RMTaskMemoryCalibration::SetSafetyMargin(double dValue)
+{
+	require(dValue >= 0);
+	dSafetyMargin = dValue;
+}
+
+double RMTaskMemoryCalibration::GetSafetyMargin()
+{
+	return dSafetyMargin;
+}
+
+void RMTaskMemoryCalibration::SetMinReductionFactor(double dValue)
+{
+	require(0 < dValue and dValue <= 1);
+	dMinReductionFactor = dValue;
+}
+
+double RMTaskMemoryCalibration::GetMinReductionFactor()
+{
+	return dMinReductionFactor;
+}
+
+double RMTaskMemoryCalibration::GetReductionFactor(const ALString& sTaskSignature)
+{
+	DoubleObject* doRatio;
+	double dFactor;
+
+	require(IsActive());
+
+	// Recherche du rapport observe pour la signature
+	LoadProfile();
+	doRatio = cast(DoubleObject*, odObservedRatios.Lookup(sTaskSignature));
+	dFactor = 1;
+	if (doRatio != NULL)
+	{
+		// Prise en compte de la marge de securite, et seuillage par le facteur de reduction minimal
+		dFactor = doRatio->GetDouble() * (1 + dSafetyMargin);
+		if (dFactor > 1)
+			dFactor = 1;
+		if (dFactor < dMinReductionFactor)
+			dFactor = dMinReductionFactor;
+	}
+	ensure(0 < dFactor and dFactor <= 1);
+	return dFactor;
+}
+
+boolean RMTaskMemoryCalibration::CalibrateRequirement(const ALString& sTaskSignature,
+						      RMTaskResourceRequirement* requirement)
+{
+	RMPhysicalResource* slaveMemory;
+	double dFactor;
+	longint lCalibratedMin;
+
+	require(IsActive());
+	require(requirement != NULL);
+	require(requirement->Check());
+
+	// Reduction de l'exigence minimale, qui reste inferieure au max
+	slaveMemory = requirement->GetSlaveRequirement()->GetMemory();
+	dFactor = GetReductionFactor(sTaskSignature);
+	lCalibratedMin = (longint)(slaveMemory->GetMin() * dFactor);
+	if (dFactor < 1 and lCalibratedMin < slaveMemory->GetMin())
+	{
+		slaveMemory->SetMin(lCalibratedMin);
+		ensure(requirement->Check());
+		return true;
+	}
+	return false;
+}
+
+void RMTaskMemoryCalibration::RecordObservedMemory(const ALString& sTaskSignature, longint lEstimatedSlaveMemory,
+						   longint lObservedSlaveMemory)
+{
+	DoubleObject* doRatio;
+	double dRatio;
+
+	require(IsActive());
+	require(lEstimatedSlaveMemory >= 0);
+	require(lObservedSlaveMemory >= 0);
+
+	// Arret si estimation trop petite pour etre significative
+	if (lEstimatedSlaveMemory < lMinCalibratedMemory)
+		return;
+
+	// Memorisation du rapport le plus eleve observe
+	LoadProfile();
+	dRatio = lObservedSlaveMemory / (double)lEstimatedSlaveMemory;
+	doRatio = cast(DoubleObject*, odObservedRatios.Lookup(sTaskSignature));
+	if (doRatio == NULL)
+	{
+		doRatio = new DoubleObject;
+		doRatio->SetDouble(dRatio);
+		odObservedRatios.SetAt(sTaskSignature, doRatio);
+	}
+	else if (dRatio > doRatio->GetDouble())
+		doRatio->SetDouble(dRatio);
+	// Pas de mise a jour du fichier si le rapport n'a pas change
+	else
+		return;
+
+	// Ecriture du profil
+	WriteProfile();
+}
+
+void RMTaskMemoryCalibration::Reset()
+{
+	odObservedRatios.DeleteAll();
+	bIsProfileLoaded = false;
+}
+
+void RMTaskMemoryCalibration::Test()
+{
+	RMTaskResourceRequirement requirement;
+	ALString sInitialProfileFileName;
+	ALString sTestProfileFileName;
+	double dInitialSafetyMargin;
+
+	// Sauvegarde du parametrage courant
+	sInitialProfileFileName = GetProfileFileName();
+	dInitialSafetyMargin = GetSafetyMargin();
+
+	// Utilisation d'un profil temporaire
+	sTestProfileFileName =
+	    FileService::BuildFilePathName(FileService::GetTmpDir(), "KhiopsTestMemoryCalibration.txt");
+	FileService::RemoveFile(sTestProfileFileName);
+	SetProfileFileName(sTestProfileFileName);
+	SetSafetyMargin(0.5);
+
+	// Signature non calibree
+	cout << "Unknown task factor\t" << GetReductionFactor("Task_1_1_1") << endl;
+
+	// Observations sur une estimation trop petite: ignorees
+	RecordObservedMemory("Task_1_1_1", lMB, lMB / 10);
+	cout << "Small estimation factor\t" << GetReductionFactor("Task_1_1_1") << endl;
+
+	// Observations successives: on garde le rapport le plus eleve
+	RecordObservedMemory("Task_1_1_1", 100 * lMB, 20 * lMB);
+	cout << "Observed 20%, factor\t" << GetReductionFactor("Task_1_1_1") << endl;
+	RecordObservedMemory("Task_1_1_1", 100 * lMB, 10 * lMB);
+	cout << "Observed 10%, factor\t" << GetReductionFactor("Task_1_1_1") << endl;
+	RecordObservedMemory("Task_1_1_1", 100 * lMB, 40 * lMB);
+	cout << "Observed 40%, factor\t" << GetReductionFactor("Task_1_1_1") << endl;
+
+	// Seuillage par le facteur de reduction minimal et par 1
+	RecordObservedMemory("Task_2_1_1", 100 * lMB, 5 * lMB);
+	cout << "Observed 5%, factor\t" << GetReductionFactor("Task_2_1_1") << endl;
+	RecordObservedMemory("Task_3_1_1", 100 * lMB, 80 * lMB);
+	cout << "Observed 80%, factor\t" << GetReductionFactor("Task_3_1_1") << endl;
+
+	// Relecture du profil
+	Reset();
+	cout << "Reloaded factor\t" << GetReductionFactor("Task_1_1_1") << endl;
+
+	// Calibration d'une exigence
+	requirement.GetSlaveRequirement()->GetMemory()->SetMin(100 * lMB);
+	requirement.GetSlaveRequirement()->GetMemory()->SetMax(200 * lMB);
+	cout << "Calibrated\t" << BooleanToString(CalibrateRequirement("Task_1_1_1", &requirement)) << endl;
+	cout << "Slave memory\t" << LongintToHumanReadableString(requirement.GetSlaveMin(MEMORY)) << "\t"
+	     << LongintToHumanReadableString(requirement.GetSlaveMax(MEMORY)) << endl;
+	cout << "Calibrated\t" << BooleanToString(CalibrateRequirement("Task_3_1_1", &requirement)) << endl;
+
+	// Restitution du parametrage initial
+	FileService::RemoveFile(sTestProfileFileName);
+	SetProfileFileName(sInitialProfileFileName);
+	SetSafetyMargin(dInitialSafetyMargin);
+}
+
+void RMTaskMemoryCalibration::LoadProfile()
+{
+	fstream fst;
+	char sBuffer[1000];
+	ALString sLine;
+	int nSeparator;
+	double dRatio;
+	DoubleObject* doRatio;
+
+	require(IsActive());
+
+	// Arret si deja charge
+	if (bIsProfileLoaded)
+		return;
+	bIsProfileLoaded = true;
+
+	// Le fichier peut ne pas encore exister: c'est le cas lors de la premiere execution
+	if (not FileService::FileExists(sProfileFileName))
+		return;
+
+	// Lecture des lignes signature et rapport, en ignorant les lignes mal formees
+	if (FileService::OpenInputFile(sProfileFileName, fst))
+	{
+		while (fst.getline(sBuffer, sizeof(sBuffer)))
+		{
+			sLine = sBuffer;
+			nSeparator = sLine.Find('\t');
+			if (nSeparator <= 0)
+				continue;
+			dRatio = StringToDouble(sLine.Mid(nSeparator + 1));
+			if (dRatio <= 0)
+				continue;
+			doRatio = new DoubleObject;
+			doRatio->SetDouble(dRatio);
+			odObservedRatios.SetAt(sLine.Left(nSeparator), doRatio);
+		}
+		FileService::CloseInputFile(sProfileFileName, fst);
+	}
+}
+
+boolean RMTaskMemoryCalibration::WriteProfile()
+{
+	boolean bOk;
+	fstream fst;
+	StringVector svSignatures;
+	POSITION position;
+	ALString sSignature;
+	Object* oElement;
+	int i;
+
+	require(IsActive());
+	require(bIsProfileLoaded);
+
+	// Tri des signatures pour un fichier stable
+	position = odObservedRatios.GetStartPosition();
+	while (position != NULL)
+	{
+		odObservedRatios.GetNextAssoc(position, sSignature, oElement);
+		svSignatures.Add(sSignature);
+	}
+	svSignatures.Sort();
+
+	// Ecriture du fichier
+	bOk = FileService::OpenOutputFile(sProfileFileName, fst);
+	if (bOk)
+	{
+		for (i = 0; i < svSignatures.GetSize(); i++)
+			fst << svSignatures.GetAt(i) << "\t"
+			    << cast(DoubleObject*, odObservedRatios.Lookup(svSignatures.GetAt(i)))->GetDouble() << "\n";
+		bOk = FileService::CloseOutputFile(sProfileFileName, fst);
+	}
+	return bOk;
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2024 Orange. All rights reserved.
+// This software is distributed under the BSD 3-Clause-clear License, the text of which is available
+// at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
+
+#pragma once
+#include "Object.h"
+#include "FileService.h"
+#include "RMTaskResourceRequirement.h"
+
+//////////////////////////////////////////////////////////////////////////
+// Classe RMTaskMemoryCalibration
+// Calibration des exigences memoire des esclaves a partir des executions precedentes
+//
+// Les exigences memoire declarees par les taches (ComputeResourceRequirements) sont des estimations
+// volontairement pessimistes. Apres chaque tache executee en parallele, on compare la memoire
+// reellement utilisee par les esclaves (pic de la heap, mesure par chaque esclave et envoye au maitre
+// avec sa notification de fin) a la memoire minimale estimee par esclave. Le rapport le plus eleve
+// observe pour chaque signature de tache est memorise dans un fichier de profil.
+// Lors des executions suivantes, si ce rapport, augmente de la marge de securite, est inferieur a 1,
+// l'exigence memoire minimale par esclave est reduite dans la meme proportion, ce qui permet au
+// gestionnaire de ressources d'allouer davantage d'esclaves.
+//
+// La calibration est inactive tant que le nom du fichier de profil n'est pas specifie
+// Seule l'exigence minimale est reduite, les exigences maximales restant inchangees
+class RMTaskMemoryCalibration : public Object
+{
+public:
+	// Fichier de profil de calibration (par defaut: vide, pas de calibration)
+	// Fichier texte, avec une ligne par signature de tache: signature et rapport memoire observe / estime
+	static void SetProfileFileName(const ALString& sValue);
+	static const ALString& GetProfileFileName();
+
+	// Indique si la calibration est active
+	static boolean IsActive();
+
+	// Marge de securite relative appliquee a la memoire observee (defaut: 0.5)
+	// Par exemple, avec une marge de 0.5, l'exigence minimale calibree vaut 1.5 fois le pic observe
+	static void SetSafetyMargin(double dValue);
+	static double GetSafetyMargin();
+
+	// Facteur de reduction minimal de l'exigence memoire (defaut: 0.25)
+	// L'exigence minimale calibree ne descend jamais en dessous de cette proportion de l'estimation
+	static void SetMinReductionFactor(double dValue);
+	static double GetMinReductionFactor();
+
+	// Facteur de reduction de l'exigence memoire minimale par esclave pour une signature de tache
+	// Renvoie 1 si la signature n'a pas ete calibree, ou si la memoire observee est proche de l'estimation
+	static double GetReductionFactor(const ALString& sTaskSignature);
+
+	// Reduction de l'exigence memoire minimale par esclave d'une tache, selon la calibration de sa signature
+	// Renvoie true si l'exigence a ete modifiee
+	static boolean CalibrateRequirement(const ALString& sTaskSignature, RMTaskResourceRequirement* requirement);
+
+	// Memorisation de la memoire observee pour une tache, et mise a jour du fichier de profil
+	// La memoire estimee est la memoire minimale par esclave, avant calibration
+	// (exigence par esclave, variables partagees et part de l'exigence globale des esclaves)
+	// Les observations sur des estimations de moins de MinCalibratedMemory sont ignorees, trop peu fiables
+	static void RecordObservedMemory(const ALString& sTaskSignature, longint lEstimatedSlaveMemory,
+					 longint lObservedSlaveMemory);
+
+	// Taille minimale des estimations prises en compte pour la calibration
+	static const longint lMinCalibratedMemory = 16 * lMB;
+
+	// Nettoyage des calibrations chargees en memoire
+	static void Reset();
+
+	// Methode de test
+	static void Test();
+
+	//////////////////////////////////////////////////////////////////
+	///// Implementation
+protected:
+	// Chargement du fichier de profil, si ce n'est deja fait
+	static void LoadProfile();
+
+	// Ecriture du fichier de profil
+	static boolean WriteProfile();
+
+	// Rapports memoire observee / estimee par signature de tache (DoubleObject)
+	static ObjectDictionary odObservedRatios;
+	static boolean bIsProfileLoaded;
+
+	// Parametres
+	static ALString sProfileFileName;
+	static double dSafetyMargin;
+	static double dMinReductionFactor;
+};
@@ -5,8 +5,10 @@
 #include "Standard.h"
 #include "KWClass.h"
 #include "KWClassDomain.h"
+#include "KWValueBlock.h"
 #include "KWProbabilityTable.h"
 #include "KWQuantileBuilder.h"
+#include "KWPredictorEvaluationTask.h"
 
 #include "TestServices.h"
 
@@ -17,9 +19,13 @@ namespace
 // Librairie KWData
 KHIOPS_TEST(KWData, KWClass, KWClass::Test);
 KHIOPS_TEST(KWData, KWClassDomain, KWClassDomain::Test);
+KHIOPS_TEST(KWData, KWContinuousValueBlock, KWContinuousValueBlock::Test);
 
 // Librairie KWDataPreparation
 KHIOPS_TEST(KWDataPreparation, KWQuantileIntervalBuilder, KWQuantileIntervalBuilder::Test);
 KHIOPS_TEST(KWDataPreparation, KWProbabilityTable, KWProbabilityTable::Test);
 
+// Librairie KWModeling
+KHIOPS_TEST(KWModeling, KWScoreHistogram, KWScoreHistogram::Test);
+
 } // namespace
@@ -13,8 +13,10 @@
 #include "CharVector.h"
 #include "InputBufferedFile.h"
 #include "OutputBufferedFile.h"
+#include "BlockCompressor.h"
 #include "Regexp.h"
 #include "MemoryTest.h"
+#include "TimelineTracer.h"
 namespace
 {
 
@@ -26,6 +28,7 @@ KHIOPS_TEST(base, FileService, FileService::Test);
 KHIOPS_TEST(base, ALString, ALString::Test);
 KHIOPS_TEST(base, Regex, Regex::Test);
 KHIOPS_TEST(base, Timer, Timer::Test);
+KHIOPS_TEST(base, TimelineTracer, TimelineTracer::Test);
 KHIOPS_TEST(base, ObjectArray, ObjectArray::Test);
 KHIOPS_TEST(base, ObjectList, ObjectList::Test);
 KHIOPS_TEST(base, SortedList, SortedList::Test);
@@ -38,6 +41,8 @@ KHIOPS_TEST(base, IntVector, IntVector::Test);
 KHIOPS_TEST(base, LongintVector, LongintVector::Test);
 KHIOPS_TEST(base, CharVector, CharVector::Test);
 KHIOPS_TEST(base, StringVector, StringVector::Test);
+KHIOPS_TEST(base, BlockCompressor, BlockCompressor::Test);
+KHIOPS_TEST(base, BlockCompressedFile, InputBufferedFile::TestBlockCompression);
 
 TEST(long, InputBufferedFile)
 {
@@ -3,9 +3,11 @@
 // at https://spdx.org/licenses/BSD-3-Clause-Clear.html or see the "LICENSE" file for more details.
 
 #include "RMParallelResourceManager.h"
+#include "RMTaskMemoryCalibration.h"
 #include "TestServices.h"
 
 namespace
 {
 KHIOPS_TEST(Parallel, RMParallelResourceManager, RMParallelResourceManager::Test);
+KHIOPS_TEST(Parallel, RMTaskMemoryCalibration, RMTaskMemoryCalibration::Test);
 } // namespace